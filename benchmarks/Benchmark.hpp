@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Shared harness of the benchmark executables
+//
+// Every case runs once to warm up and then a fixed number of repetitions;
+// the median time per operation is reported, which is far less sensitive
+// to the odd preempted run than the mean. Inputs are generated from fixed
+// seeds so that runs on the same machine are comparable. Results are
+// printed as a table and, with --json <path>, written as JSON for
+// tracking regressions between releases.
+//
+// Command line: [--json <path>] [--repetitions <n>] [--filter <text>]
+namespace Benchmark
+{
+    // Address of the last kept value, only ever written
+    inline volatile const void *keptValue = nullptr;
+
+    // Keeps the compiler from removing work whose result is otherwise unused
+    template <typename T>
+    inline void keep(const T &value)
+    {
+        keptValue = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    // Nanoseconds on the steady clock
+    inline double now()
+    {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct Result
+    {
+        std::string name;
+
+        // Unit of the three values, such as ns/op
+        std::string unit;
+
+        double median;
+        double minimum;
+        double maximum;
+
+        // Operations per repetition
+        uint64_t operations;
+    };
+
+    class Suite
+    {
+    public:
+        Suite(const char *name, int argc, char **argv) : name(name)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                bool hasValue = i + 1 < argc;
+                if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+                {
+                    jsonPath = argv[++i];
+                }
+                else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue)
+                {
+                    repetitions = std::max(1, std::atoi(argv[++i]));
+                }
+                else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+                {
+                    filter = argv[++i];
+                }
+                else
+                {
+                    std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+                    std::fprintf(stderr, "Usage: %s [--json <path>] [--repetitions <n>] [--filter <text>]\n", argv[0]);
+                    valid = false;
+                }
+            }
+
+            std::printf("%s benchmarks, median of %d repetitions\n\n", name, repetitions);
+            std::printf("%-48s %12s %12s %12s  %s\n", "Case", "Median", "Min", "Max", "Unit");
+        }
+
+        // False if the command line was malformed
+        bool isValid() const { return valid; }
+
+        // Checks a case name against --filter
+        bool isEnabled(const std::string &caseName) const
+        {
+            return filter.empty() || caseName.find(filter) != std::string::npos;
+        }
+
+        // Times body(), which performs the given number of operations, and records ns per operation
+        template <typename Body>
+        void run(const std::string &caseName, uint64_t operations, Body &&body)
+        {
+            run(caseName, operations, [] {}, body);
+        }
+
+        // Like run(), but calls setup() untimed before the warm-up and every repetition
+        template <typename Setup, typename Body>
+        void run(const std::string &caseName, uint64_t operations, Setup &&setup, Body &&body)
+        {
+            if (!valid || !isEnabled(caseName))
+            {
+                return;
+            }
+
+            setup();
+            body();
+
+            std::vector<double> samples;
+            samples.reserve(repetitions);
+            for (int repetition = 0; repetition < repetitions; ++repetition)
+            {
+                setup();
+                double start = now();
+                body();
+                double end = now();
+                samples.push_back((end - start) / static_cast<double>(std::max<uint64_t>(operations, 1)));
+            }
+            record(caseName, samples, "ns/op", operations);
+        }
+
+        // Records samples measured by the caller
+        void record(const std::string &caseName, std::vector<double> samples, const char *unit, uint64_t operations = 1)
+        {
+            if (!valid || !isEnabled(caseName) || samples.empty())
+            {
+                return;
+            }
+
+            std::sort(samples.begin(), samples.end());
+            Result result{caseName, unit, samples[samples.size() / 2], samples.front(), samples.back(), operations};
+            std::printf("%-48s %12.2f %12.2f %12.2f  %s\n", caseName.c_str(), result.median, result.minimum,
+                        result.maximum, unit);
+            results.push_back(std::move(result));
+        }
+
+        // Writes the JSON results if requested, returns the process exit code
+        int finish() const
+        {
+            if (!valid)
+            {
+                return 1;
+            }
+            if (jsonPath.empty())
+            {
+                return 0;
+            }
+
+            std::FILE *file = std::fopen(jsonPath.c_str(), "wb");
+            if (!file)
+            {
+                std::fprintf(stderr, "Failed to open %s\n", jsonPath.c_str());
+                return 1;
+            }
+
+            std::fprintf(file, "{\n  \"suite\": \"%s\",\n  \"build\": \"%s\",\n  \"compiler\": \"%s\",\n  \"repetitions\": %d,\n  \"results\": [",
+                         name, buildType(), compiler(), repetitions);
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const Result &result = results[i];
+                std::fprintf(file, "%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"median\": %.4f, \"min\": %.4f, \"max\": %.4f, \"operations\": %llu}",
+                             i == 0 ? "" : ",", result.name.c_str(), result.unit.c_str(), result.median, result.minimum,
+                             result.maximum, static_cast<unsigned long long>(result.operations));
+            }
+            std::fputs("\n  ]\n}\n", file);
+
+            bool written = std::ferror(file) == 0;
+            written = std::fclose(file) == 0 && written;
+            if (!written)
+            {
+                std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+                return 1;
+            }
+            return 0;
+        }
+
+        int getRepetitions() const { return repetitions; }
+
+    private:
+        static const char *buildType()
+        {
+#ifdef NDEBUG
+            return "release";
+#else
+            return "debug";
+#endif
+        }
+
+        static const char *compiler()
+        {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+
+        const char *name;
+        std::string jsonPath;
+        std::string filter;
+        int repetitions = 5;
+        bool valid = true;
+        std::vector<Result> results;
+    };
+}
@@ -0,0 +1,200 @@
+#include "Benchmark.hpp"
+
+#include "Engine/Core/Engine.hpp"
+#include "Engine/ECS/EntityManager.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Entity counts every case runs at
+    const size_t ENTITY_COUNTS[] = {10000, 100000, 1000000};
+
+    struct Position : public ComponentT<Position>
+    {
+        Position(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        float x, y, z;
+    };
+
+    struct Velocity : public ComponentT<Velocity>
+    {
+        Velocity(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        float x, y, z;
+    };
+
+    // Integrates velocities, split into ranges over the job system
+    class MovementSystem : public System
+    {
+    public:
+        explicit MovementSystem(::Engine::Engine &engine) : System(engine)
+        {
+            name = "Movement";
+            writes<Position>();
+            reads<Velocity>();
+        }
+
+        bool initialize() override { return true; }
+
+        void update(float deltaTime) override { updateRange(deltaTime, 0, getParallelWorkSize()); }
+
+        void shutdown() override {}
+
+        size_t getParallelWorkSize() const override { return entityManager->view<Position, Velocity>().size(); }
+
+        void updateRange(float deltaTime, size_t begin, size_t end) override
+        {
+            View<Position, Velocity> &movers = view<Position, Velocity>();
+            ComponentPool<Position> &positions = entityManager->getPool<Position>();
+            ComponentPool<Velocity> &velocities = entityManager->getPool<Velocity>();
+            const std::vector<uint32_t> &members = movers.getEntities();
+            for (size_t i = begin; i < end; ++i)
+            {
+                Position &position = *positions.get(members[i]);
+                const Velocity &velocity = *velocities.get(members[i]);
+                position.x += velocity.x * deltaTime;
+                position.y += velocity.y * deltaTime;
+                position.z += velocity.z * deltaTime;
+            }
+        }
+    };
+
+    // Creates entities with a position each, and a velocity on every other one
+    std::vector<Entity *> populate(EntityManager &manager, size_t count)
+    {
+        manager.shutdown();
+        std::vector<Entity *> entities(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            entities[i] = manager.createEntity();
+            entities[i]->addComponent<Position>(static_cast<float>(i), 0.0f, 0.0f);
+            if (i % 2 == 0)
+            {
+                entities[i]->addComponent<Velocity>(1.0f, 2.0f, 3.0f);
+            }
+        }
+        return entities;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Benchmark::Suite suite("ECS", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    Config config;
+    config.logLevel = LogLevel::Warning;
+    ::Engine::Engine engine(config);
+
+    JobSystem jobs;
+    jobs.initialize(JobSystem::getDefaultWorkerCount());
+
+    for (size_t count : ENTITY_COUNTS)
+    {
+        std::string suffix = "/" + std::to_string(count);
+        EntityManager manager(engine);
+        std::vector<Entity *> entities;
+
+        suite.run("createEntity" + suffix, count, [&]
+                  { manager.shutdown(); },
+                  [&]
+                  {
+                      for (size_t i = 0; i < count; ++i)
+                      {
+                          Benchmark::keep(manager.createEntity());
+                      }
+                  });
+
+        suite.run("addComponent" + suffix, count, [&]
+                  {
+                      manager.shutdown();
+                      entities.resize(count);
+                      for (Entity *&entity : entities)
+                      {
+                          entity = manager.createEntity();
+                      }
+                  },
+                  [&]
+                  {
+                      for (Entity *entity : entities)
+                      {
+                          entity->addComponent<Position>(1.0f, 2.0f, 3.0f);
+                      }
+                  });
+
+        entities = populate(manager, count);
+        float sum = 0.0f;
+        suite.run("getComponent/sequential" + suffix, count, [&]
+                  {
+                      for (Entity *entity : entities)
+                      {
+                          sum += entity->getComponent<Position>().x;
+                      }
+                      Benchmark::keep(sum);
+                  });
+
+        // The same lookups in a fixed shuffled order, as gameplay code tends to make them
+        std::vector<Entity *> shuffled = entities;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1234));
+        suite.run("getComponent/random" + suffix, count, [&]
+                  {
+                      for (Entity *entity : shuffled)
+                      {
+                          sum += entity->getComponent<Position>().x;
+                      }
+                      Benchmark::keep(sum);
+                  });
+
+        suite.run("tryGetComponent/miss" + suffix, count, [&]
+                  {
+                      size_t found = 0;
+                      for (Entity *entity : entities)
+                      {
+                          found += entity->tryGetComponent<Velocity>() != nullptr;
+                      }
+                      Benchmark::keep(found);
+                  });
+
+        // Half of the entities move, so the per-operation figures below are per moving entity
+        View<Position, Velocity> &movers = manager.view<Position, Velocity>();
+        suite.run("View::each" + suffix, movers.size(), [&]
+                  {
+                      movers.each([](Entity &, Position &position, Velocity &velocity)
+                                  {
+                                      position.x += velocity.x * 0.016f;
+                                      position.y += velocity.y * 0.016f;
+                                      position.z += velocity.z * 0.016f;
+                                  });
+                  });
+
+        suite.run("View::iterator" + suffix, movers.size(), [&]
+                  {
+                      for (auto [entity, position, velocity] : movers)
+                      {
+                          (void)entity;
+                          position.x += velocity.x * 0.016f;
+                      }
+                  });
+
+        // A system scheduled through the job system, including the scheduling overhead
+        manager.getScheduler().initialize(&jobs);
+        manager.addSystem<MovementSystem>();
+        suite.run("SystemScheduler::run" + suffix, movers.size(), [&]
+                  { manager.getScheduler().run(0.016f); });
+
+        manager.shutdown();
+    }
+
+    jobs.shutdown();
+    return suite.finish();
+}
@@ -0,0 +1,107 @@
+#include "Benchmark.hpp"
+
+#include "Engine/Core/Logger.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Messages per repetition, spread over the producer threads
+    const size_t MESSAGE_COUNT = 200000;
+
+    // Sink that formats nothing and writes nowhere, leaving the logger's own cost
+    class NullSink : public LogSink
+    {
+    public:
+        void write(LogLevel level, const std::string &message, const std::string &timestamp) override
+        {
+            (void)level;
+            (void)timestamp;
+            bytes += message.size();
+        }
+
+        size_t bytes = 0;
+    };
+
+    // Restarts the logger with only a null sink
+    void restart(bool async)
+    {
+        Logger::shutdown();
+
+        LoggerConfig config;
+        config.level = LogLevel::Info;
+        config.logToConsole = false;
+        config.async = async;
+        config.queueCapacity = 8192;
+        config.overflowPolicy = LogOverflowPolicy::Block;
+        Logger::init(config);
+        Logger::addSink(std::make_unique<NullSink>());
+    }
+
+    // Logs MESSAGE_COUNT messages from the given number of threads and waits until they are written
+    void produce(int threads)
+    {
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t)
+        {
+            producers.emplace_back([t, threads]
+                                   {
+                                       for (size_t i = t; i < MESSAGE_COUNT; i += threads)
+                                       {
+                                           Logger::info("Entity {} moved to ({}, {}, {})", i, 1.0f, 2.5f, -3.0f);
+                                       }
+                                   });
+        }
+        for (std::thread &producer : producers)
+        {
+            producer.join();
+        }
+        Logger::flush();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Benchmark::Suite suite("Logger", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    // Calls below the level should cost a comparison
+    restart(false);
+    suite.run("filtered/debug", MESSAGE_COUNT, []
+              {
+                  for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+                  {
+                      Logger::debug("Entity {} moved to ({}, {}, {})", i, 1.0f, 2.5f, -3.0f);
+                  }
+              });
+
+    suite.run("sync/string", MESSAGE_COUNT, []
+              {
+                  for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+                  {
+                      Logger::info("Entity " + std::to_string(i) + " moved");
+                  }
+              });
+
+    suite.run("sync/format", MESSAGE_COUNT, []
+              { produce(1); });
+
+    // Producers only encode and enqueue, the time includes draining the queue
+    restart(true);
+    for (int threads : {1, 2, 4})
+    {
+        suite.run("async/format/" + std::to_string(threads) + "-threads", MESSAGE_COUNT, [threads]
+                  { produce(threads); });
+    }
+
+    Logger::shutdown();
+    return suite.finish();
+}
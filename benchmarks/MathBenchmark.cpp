@@ -0,0 +1,265 @@
+#include "Benchmark.hpp"
+
+#include "Engine/Math/MathKernels.hpp"
+#include "Engine/Math/MathBatch.hpp"
+#include "Engine/Math/Matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Number of matrices, vectors, or quaternions per batch
+    const size_t BATCH_SIZE = 1024;
+
+    // Number of passes over each batch
+    const int ITERATIONS = 2000;
+
+    // Sink that keeps the compiler from removing the measured work
+    volatile float sink = 0.0f;
+
+    struct Inputs
+    {
+        std::vector<float> matrices;
+        std::vector<float> affines;
+        std::vector<float> quaternions;
+        std::vector<float> points;
+    };
+
+    Inputs makeInputs()
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+        Inputs inputs;
+        inputs.matrices.resize(BATCH_SIZE * 16);
+        inputs.affines.resize(BATCH_SIZE * 16);
+        inputs.quaternions.resize(BATCH_SIZE * 4);
+        inputs.points.resize(BATCH_SIZE * 3);
+
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+        {
+            float *m = &inputs.matrices[i * 16];
+            float *a = &inputs.affines[i * 16];
+            for (int k = 0; k < 16; ++k)
+            {
+                m[k] = value(rng);
+                a[k] = value(rng);
+            }
+
+            // Keep the general matrices well conditioned and the affine ones affine
+            m[0] += 4.0f, m[5] += 4.0f, m[10] += 4.0f, m[15] += 4.0f;
+            a[0] += 4.0f, a[5] += 4.0f, a[10] += 4.0f;
+            a[12] = a[13] = a[14] = 0.0f;
+            a[15] = 1.0f;
+        }
+
+        for (float &q : inputs.quaternions)
+        {
+            q = value(rng);
+        }
+        for (float &p : inputs.points)
+        {
+            p = value(rng) * 100.0f;
+        }
+
+        return inputs;
+    }
+
+    // Number of timed repetitions, set from the command line
+    int repetitions = 5;
+
+    // Runs body(i) over the batch and returns nanoseconds per call of every repetition
+    template <typename Body>
+    std::vector<double> measure(Body body, double divisor = 1.0)
+    {
+        // Warm up caches and branch predictors
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+        {
+            body(i);
+        }
+
+        std::vector<double> samples;
+        for (int repetition = 0; repetition < repetitions; ++repetition)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int iteration = 0; iteration < ITERATIONS; ++iteration)
+            {
+                for (size_t i = 0; i < BATCH_SIZE; ++i)
+                {
+                    body(i);
+                }
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+            samples.push_back(nanoseconds / (static_cast<double>(ITERATIONS) * BATCH_SIZE * divisor));
+        }
+        return samples;
+    }
+
+    // Records the scalar and SIMD variants of a kernel
+    void report(Benchmark::Suite &suite, const char *name, const std::vector<double> &scalar, const std::vector<double> &simd)
+    {
+        suite.record(std::string(name) + "/scalar", scalar, "ns/op", BATCH_SIZE * ITERATIONS);
+        suite.record(std::string(name) + "/simd", simd, "ns/op", BATCH_SIZE * ITERATIONS);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::printf("Instruction set: %s\n", MathKernels::getInstructionSet());
+    Benchmark::Suite suite("Math", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+    repetitions = suite.getRepetitions();
+
+    Inputs inputs = makeInputs();
+    std::vector<float> out(BATCH_SIZE * 16);
+    const float *m = inputs.matrices.data();
+    const float *a = inputs.affines.data();
+    const float *q = inputs.quaternions.data();
+
+
+    // Matrix products chain neighbouring matrices, like world-matrix composition
+    auto multiply = [&](auto kernel)
+    {
+        return measure([&](size_t i)
+                       {
+                           size_t j = (i + 1) % BATCH_SIZE;
+                           kernel(m + i * 16, m + j * 16, &out[i * 16]);
+                           sink = sink + out[i * 16];
+                       });
+    };
+    report(suite, "multiplyMatrix4", multiply(MathKernels::multiplyMatrix4Scalar), multiply(MathKernels::multiplyMatrix4));
+
+    auto transform = [&](auto kernel)
+    {
+        return measure([&](size_t i)
+                       {
+                           kernel(m + i * 16, q + i * 4, &out[i * 4]);
+                           sink = sink + out[i * 4];
+                       });
+    };
+    report(suite, "transformVector4", transform(MathKernels::transformVector4Scalar), transform(MathKernels::transformVector4));
+
+    // Points are transformed in one batch per matrix, as when transforming a mesh
+    auto points = [&](auto kernel)
+    {
+        std::vector<float> transformed(inputs.points.size());
+        return measure([&](size_t i)
+                       {
+                           kernel(m + i * 16, inputs.points.data(), transformed.data(), BATCH_SIZE);
+                           sink = sink + transformed[i * 3];
+                       },
+                       BATCH_SIZE);
+    };
+    report(suite, "transformPoints", points(MathKernels::transformPointsScalar), points(MathKernels::transformPoints));
+
+    auto inverse = [&](auto kernel, const float *matrices)
+    {
+        return measure([&, kernel, matrices](size_t i)
+                       {
+                           kernel(matrices + i * 16, &out[i * 16]);
+                           sink = sink + out[i * 16];
+                       });
+    };
+    report(suite, "inverseMatrix4", inverse(MathKernels::inverseMatrix4Scalar, m), inverse(MathKernels::inverseMatrix4, m));
+    report(suite, "inverseAffine", inverse(MathKernels::inverseAffineScalar, a), inverse(MathKernels::inverseAffine, a));
+
+    auto quaternionMultiply = [&](auto kernel)
+    {
+        return measure([&](size_t i)
+                       {
+                           size_t j = (i + 1) % BATCH_SIZE;
+                           kernel(q + i * 4, q + j * 4, &out[i * 4]);
+                           sink = sink + out[i * 4];
+                       });
+    };
+    report(suite, "multiplyQuaternion", quaternionMultiply(MathKernels::multiplyQuaternionScalar), quaternionMultiply(MathKernels::multiplyQuaternion));
+
+    auto slerp = [&](auto kernel)
+    {
+        return measure([&](size_t i)
+                       {
+                           size_t j = (i + 1) % BATCH_SIZE;
+                           kernel(q + i * 4, q + j * 4, 0.25f, &out[i * 4]);
+                           sink = sink + out[i * 4];
+                       });
+    };
+    report(suite, "slerpQuaternion", slerp(MathKernels::slerpQuaternionScalar), slerp(MathKernels::slerpQuaternion));
+
+    // Batched slerp over coordinate arrays against one Quaternion::slerp() per element
+    QuaternionBatch from, to, blended;
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        from.add(Quaternion(q[i * 4], q[i * 4 + 1], q[i * 4 + 2], q[i * 4 + 3]).normalized());
+        to.add(from.get((i + 1) % BATCH_SIZE));
+    }
+    blended.resize(BATCH_SIZE);
+
+    std::vector<double> perElement = measure([&](size_t i)
+                                {
+                                    Quaternion result = Quaternion::slerp(from.get(i), to.get(i), 0.25f);
+                                    sink = sink + result.getW();
+                                });
+    std::vector<double> batched = measure([&](size_t i)
+                             {
+                                 if (i == 0)
+                                 {
+                                     MathBatch::slerp(from, to, 0.25f, blended);
+                                 }
+                                 sink = sink + blended.w[i];
+                             });
+    suite.record("MathBatch::slerp/per-element", perElement, "ns/op", BATCH_SIZE * ITERATIONS);
+    suite.record("MathBatch::slerp/batched", batched, "ns/op", BATCH_SIZE * ITERATIONS);
+
+    // The class API on top of the kernels, as gameplay code uses it
+    std::vector<Matrix4> matrices(BATCH_SIZE);
+    std::vector<Quaternion> rotations(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                matrices[i].set(row, col, m[i * 16 + col * 4 + row]);
+            }
+        }
+        rotations[i] = from.get(i);
+    }
+
+    suite.record("Matrix4::operator*", measure([&](size_t i)
+                                               {
+                                                   Matrix4 result = matrices[i] * matrices[(i + 1) % BATCH_SIZE];
+                                                   sink = sink + result.get(0, 0);
+                                               }),
+                 "ns/op", BATCH_SIZE * ITERATIONS);
+    suite.record("Matrix4::inverse", measure([&](size_t i)
+                                             {
+                                                 Matrix4 result = matrices[i].inverse();
+                                                 sink = sink + result.get(0, 0);
+                                             }),
+                 "ns/op", BATCH_SIZE * ITERATIONS);
+    suite.record("Quaternion::operator*", measure([&](size_t i)
+                                                  {
+                                                      Quaternion result = rotations[i] * rotations[(i + 1) % BATCH_SIZE];
+                                                      sink = sink + result.getW();
+                                                  }),
+                 "ns/op", BATCH_SIZE * ITERATIONS);
+    suite.record("Quaternion::toMatrix4", measure([&](size_t i)
+                                                  {
+                                                      Matrix4 result = rotations[i].toMatrix4();
+                                                      sink = sink + result.get(0, 0);
+                                                  }),
+                 "ns/op", BATCH_SIZE * ITERATIONS);
+
+    return suite.finish();
+}
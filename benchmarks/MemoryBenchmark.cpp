@@ -0,0 +1,92 @@
+#include "Benchmark.hpp"
+
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/Memory.hpp"
+#include "Engine/Core/ObjectPool.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace Engine;
+using namespace Benchmark;
+
+namespace
+{
+    // Allocations per repetition
+    const size_t ALLOCATION_COUNT = 100000;
+
+    // Small object of about the size of a render command
+    struct Item
+    {
+        float transform[16];
+        void *mesh;
+        void *material;
+    };
+}
+
+int main(int argc, char **argv)
+{
+    Suite suite("Memory", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    // Per-frame scratch memory, freed all at once at the end of the frame
+    FrameArena arena(ALLOCATION_COUNT * sizeof(Item));
+    suite.run("FrameArena::create", ALLOCATION_COUNT, [&]
+              {
+                  for (size_t i = 0; i < ALLOCATION_COUNT; ++i)
+                  {
+                      keep(arena.create<Item>());
+                  }
+                  arena.reset();
+              });
+
+    std::vector<std::unique_ptr<Item>> owned(ALLOCATION_COUNT);
+    suite.run("new+delete/frame", ALLOCATION_COUNT, [&]
+              {
+                  for (size_t i = 0; i < ALLOCATION_COUNT; ++i)
+                  {
+                      owned[i] = std::make_unique<Item>();
+                  }
+                  for (auto &item : owned)
+                  {
+                      item.reset();
+                  }
+              });
+
+    // Objects with individual lifetimes, as entities have
+    ObjectPool<Item> pool;
+    std::vector<Item *> pooled(ALLOCATION_COUNT);
+    suite.run("ObjectPool::create+destroy", ALLOCATION_COUNT, [&]
+              {
+                  for (size_t i = 0; i < ALLOCATION_COUNT; ++i)
+                  {
+                      pooled[i] = pool.create();
+                  }
+                  for (Item *item : pooled)
+                  {
+                      pool.destroy(item);
+                  }
+              });
+
+    // Once the pool and the arena have grown, further rounds take nothing from the heap
+    Memory::beginFrame();
+    for (size_t i = 0; i < ALLOCATION_COUNT; ++i)
+    {
+        pooled[i] = pool.create();
+        keep(arena.create<Item>());
+    }
+    for (Item *item : pooled)
+    {
+        pool.destroy(item);
+    }
+    arena.reset();
+    std::printf("  steady state: %llu allocations%s\n",
+                static_cast<unsigned long long>(Memory::getFrameAllocationCount()),
+                Memory::isTrackingHeap() ? "" : " (engine allocators only, build with ENGINE_TRACK_ALLOCATIONS to count operator new)");
+
+    return suite.finish();
+}
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderQueue.hpp"
+#include "Engine/Renderer/RenderSnapshot.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Headless stand-ins for the OpenGL backend
+//
+// They keep the CPU side of every call, such as copying uploaded data and
+// sorting and walking the render queue, and skip the driver. Benchmarks
+// measure the engine's own overhead with them, without a window or GPU.
+namespace Benchmark
+{
+    using namespace Engine;
+
+    // Shader that hands out a location per uniform name and ignores the values
+    class MockShader : public Shader
+    {
+    public:
+        explicit MockShader(const std::string &name) : Shader(name) {}
+
+        bool compile(const std::string &vertexSource, const std::string &fragmentSource) override
+        {
+            source = vertexSource + fragmentSource;
+            ++revision;
+            return true;
+        }
+
+        void bind() const override {}
+        void unbind() const override {}
+
+        void setInt(const std::string &name, int value) override { setInt(getUniformLocation(name), value); }
+        void setFloat(const std::string &name, float value) override { setFloat(getUniformLocation(name), value); }
+        void setVector2(const std::string &name, const Vector2 &value) override { setVector2(getUniformLocation(name), value); }
+        void setVector3(const std::string &name, const Vector3 &value) override { setVector3(getUniformLocation(name), value); }
+        void setVector4(const std::string &name, const Vector4 &value) override { setVector4(getUniformLocation(name), value); }
+        void setMatrix3(const std::string &name, const Matrix3 &value) override { setMatrix3(getUniformLocation(name), value); }
+        void setMatrix4(const std::string &name, const Matrix4 &value) override { setMatrix4(getUniformLocation(name), value); }
+
+        int getUniformLocation(const std::string &name) override
+        {
+            auto inserted = locations.emplace(name, static_cast<int>(locations.size()));
+            return inserted.first->second;
+        }
+
+        void setInt(int location, int value) override { (void)location, (void)value, ++uniformWrites; }
+        void setFloat(int location, float value) override { (void)location, (void)value, ++uniformWrites; }
+        void setVector2(int location, const Vector2 &value) override { (void)location, (void)value, ++uniformWrites; }
+        void setVector3(int location, const Vector3 &value) override { (void)location, (void)value, ++uniformWrites; }
+        void setVector4(int location, const Vector4 &value) override { (void)location, (void)value, ++uniformWrites; }
+        void setMatrix3(int location, const Matrix3 &value) override { (void)location, (void)value, ++uniformWrites; }
+        void setMatrix4(int location, const Matrix4 &value) override { (void)location, (void)value, ++uniformWrites; }
+
+        // Uniform values written so far
+        uint64_t uniformWrites = 0;
+
+    private:
+        std::string source;
+        std::unordered_map<std::string, int> locations;
+    };
+
+    // Mesh that keeps a copy of its data in place of the GPU buffers
+    class MockMesh : public Mesh
+    {
+    public:
+        explicit MockMesh(const std::string &name) : Mesh(name) {}
+
+        void setVertices(const std::vector<Vertex> &vertices) override { this->vertices = vertices; }
+        void setIndices(const std::vector<uint32_t> &indices) override { this->indices = indices; }
+        void setVertices(Span<const Vertex> vertices) override { this->vertices.assign(vertices.begin(), vertices.end()); }
+        void setIndices(Span<const uint32_t> indices) override { this->indices.assign(indices.begin(), indices.end()); }
+
+        bool createDynamic(size_t vertexCapacity, size_t indexCapacity) override
+        {
+            vertices.assign(vertexCapacity, Vertex());
+            indices.assign(indexCapacity, 0);
+            vertexCount = 0;
+            indexCount = 0;
+            dynamic = true;
+            return vertexCapacity > 0;
+        }
+
+        bool updateVertices(Span<const Vertex> data, size_t first) override
+        {
+            if (!dynamic || first + data.size() > vertices.size())
+            {
+                return false;
+            }
+            std::copy(data.begin(), data.end(), vertices.begin() + first);
+            return true;
+        }
+
+        bool updateIndices(Span<const uint32_t> data, size_t first) override
+        {
+            if (!dynamic || first + data.size() > indices.size())
+            {
+                return false;
+            }
+            std::copy(data.begin(), data.end(), indices.begin() + first);
+            return true;
+        }
+
+        bool setDrawCount(size_t vertexCount, size_t indexCount) override
+        {
+            if (!dynamic || vertexCount > vertices.size() || indexCount > indices.size())
+            {
+                return false;
+            }
+            this->vertexCount = vertexCount;
+            this->indexCount = indexCount;
+            return true;
+        }
+
+        bool build() override
+        {
+            if (vertices.empty())
+            {
+                return false;
+            }
+            computeBounds(vertices.data(), vertices.size());
+            vertexCount = vertices.size();
+            indexCount = indices.size();
+            return true;
+        }
+
+        bool build(const MeshData &data) override
+        {
+            if ((!data.vertices && !data.packedVertices) || data.vertexCount == 0)
+            {
+                return false;
+            }
+
+            // Packed vertices are only counted, there is no Vertex copy to keep
+            if (data.packedVertices)
+            {
+                vertices.clear();
+                vertexLayout = data.packedLayout;
+            }
+            else
+            {
+                vertices.assign(data.vertices, data.vertices + data.vertexCount);
+            }
+
+            if (data.shortIndices)
+            {
+                indices.assign(data.shortIndices, data.shortIndices + data.indexCount);
+            }
+            else
+            {
+                indices.assign(data.indices, data.indices ? data.indices + data.indexCount : data.indices);
+            }
+            indexType = VertexLayout::selectIndexType(data.vertexCount);
+
+            if (data.bounds.isEmpty() && data.packedVertices)
+            {
+                computeBounds(data.packedVertices, data.packedLayout, data.vertexCount);
+            }
+            else if (data.bounds.isEmpty())
+            {
+                computeBounds(data.vertices, data.vertexCount);
+            }
+            else
+            {
+                bounds = data.bounds;
+                boundingSphere = data.boundingSphere;
+            }
+            vertexCount = data.vertexCount;
+            indexCount = indices.size();
+            return true;
+        }
+
+        void bind() const override {}
+        void unbind() const override {}
+        void draw(uint32_t lod = 0) const override { (void)lod; }
+        void drawInstanced(uint32_t instanceCount, uint32_t lod = 0) const override
+        {
+            (void)instanceCount;
+            (void)lod;
+        }
+
+    private:
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // Texture that keeps a copy of its levels in place of the GPU storage
+    class MockTexture : public Texture
+    {
+    public:
+        bool load(const std::string &filepath) override
+        {
+            (void)filepath;
+            return false;
+        }
+
+        bool create(int width, int height, unsigned char *data, TextureFormat format) override
+        {
+            if (!allocate(width, height, format, 1))
+            {
+                return false;
+            }
+            return !data || uploadMip(0, data, getTextureLevelSize(format, width, height));
+        }
+
+        void bind(int unit) const override { (void)unit; }
+        void unbind(int unit) const override { (void)unit; }
+        void setFilter(TextureFilter filterMin, TextureFilter filterMag) override { (void)filterMin, (void)filterMag; }
+        void setWrap(TextureWrap wrapS, TextureWrap wrapT) override { (void)wrapS, (void)wrapT; }
+        void generateMipmaps() override {}
+
+        bool allocate(int width, int height, TextureFormat format, int mipCount) override
+        {
+            this->width = width;
+            this->height = height;
+            this->format = format;
+            this->mipCount = std::max(1, std::min(mipCount, getMipLevelCount(width, height)));
+            this->residentMip = this->mipCount;
+            levels.assign(this->mipCount, {});
+            return true;
+        }
+
+        bool uploadMip(int level, const unsigned char *data, size_t size) override
+        {
+            // Levels arrive from the smallest up, like in the OpenGL texture
+            if (level != residentMip - 1)
+            {
+                return false;
+            }
+            levels[level].assign(data, data + size);
+            residentMip = level;
+            return true;
+        }
+
+        void dropMips(int level) override
+        {
+            level = std::min(level, mipCount - 1);
+            for (; residentMip < level; ++residentMip)
+            {
+                std::vector<unsigned char>().swap(levels[residentMip]);
+            }
+        }
+
+    private:
+        std::vector<std::vector<unsigned char>> levels;
+    };
+
+    // Resource manager that creates the mock resources
+    class MockResourceManager : public ResourceManager
+    {
+    protected:
+        std::unique_ptr<Texture> createTexture() override { return std::make_unique<MockTexture>(); }
+        std::unique_ptr<Mesh> createMesh(const std::string &name) override { return std::make_unique<MockMesh>(name); }
+        std::unique_ptr<Shader> createShader(const std::string &name) override { return std::make_unique<MockShader>(name); }
+    };
+
+    // Renderer that sorts and walks its queue like the OpenGL renderer, without drawing
+    class MockRenderer : public Renderer
+    {
+    public:
+        explicit MockRenderer(const RendererConfig &config = RendererConfig()) : Renderer(config) {}
+
+        bool initialize(int width, int height, const std::string &title) override
+        {
+            (void)width, (void)height, (void)title;
+            defaultShader = std::make_unique<MockShader>("Phong");
+            return true;
+        }
+
+        void shutdown() override { defaultShader.reset(); }
+
+        void beginFrame() override { frameStats.reset(); }
+
+        void endFrame() override
+        {
+            flushQueue();
+            lastFrameStats = frameStats;
+        }
+
+        void drawMesh(Mesh *mesh, Material *material, const Matrix4 &transform) override
+        {
+            if (mesh && material && material->getShader())
+            {
+                renderQueue.submit(mesh, material, transform, transform.get(2, 3), Vector4::One);
+            }
+        }
+
+        void renderSnapshot(const RenderSnapshot &snapshot) override
+        {
+            frameStats.objectsVisible += static_cast<uint32_t>(snapshot.items.size());
+            frameStats.objectsCulled += snapshot.culledCount;
+            for (const RenderItem &item : snapshot.items)
+            {
+                drawMesh(item.mesh, item.material, item.transform);
+            }
+            flushQueue();
+        }
+
+        void setCamera(CameraComponent *camera) override { this->camera = camera; }
+        CameraComponent *getCamera() const override { return camera; }
+
+        Shader *getDefaultShader(const std::string &name) const override
+        {
+            return name == "Phong" ? defaultShader.get() : nullptr;
+        }
+
+        Window *getWindow() const override { return nullptr; }
+        bool shouldClose() const override { return false; }
+        const RenderStats &getStats() const override { return lastFrameStats; }
+        const std::vector<GpuPassTiming> &getGpuTimings() const override { return gpuTimings; }
+
+    private:
+        // Applies the state changes the OpenGL renderer would make, in sorted order
+        void flushQueue()
+        {
+            renderQueue.sort();
+
+            Shader *boundShader = nullptr;
+            Material *boundMaterial = nullptr;
+            Mesh *boundMesh = nullptr;
+            int modelLocation = -1;
+            for (size_t i = 0; i < renderQueue.size(); ++i)
+            {
+                const RenderCommand &command = renderQueue.getSorted(i);
+                Shader *shader = command.material->getShader();
+                if (shader != boundShader)
+                {
+                    shader->bind();
+                    modelLocation = shader->getUniformLocation("model");
+                    boundShader = shader;
+                    boundMaterial = nullptr;
+                    ++frameStats.shaderChanges;
+                }
+                if (command.material != boundMaterial)
+                {
+                    frameStats.textureBinds += command.material->applyParameters(*shader);
+                    boundMaterial = command.material;
+                    ++frameStats.materialChanges;
+                }
+                if (command.mesh != boundMesh)
+                {
+                    command.mesh->bind();
+                    boundMesh = command.mesh;
+                    ++frameStats.meshChanges;
+                }
+
+                shader->setMatrix4(modelLocation, command.transform);
+                command.mesh->draw();
+                ++frameStats.drawCalls;
+                frameStats.vertices += command.mesh->getVertexCount();
+                frameStats.triangles += command.mesh->getIndexCount() / 3;
+            }
+
+            renderQueue.clear();
+        }
+
+        std::unique_ptr<MockShader> defaultShader;
+        CameraComponent *camera = nullptr;
+        RenderQueue renderQueue;
+        RenderStats frameStats;
+        RenderStats lastFrameStats;
+        std::vector<GpuPassTiming> gpuTimings;
+    };
+}
@@ -0,0 +1,163 @@
+#include "Benchmark.hpp"
+#include "MockRenderer.hpp"
+
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/RenderSnapshot.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+using namespace Benchmark;
+
+namespace
+{
+    // Draws per frame every submission case runs at
+    const size_t DRAW_COUNTS[] = {1000, 10000, 100000};
+
+    // Distinct materials and meshes the draws are spread over
+    const size_t MATERIAL_COUNT = 64;
+    const size_t MESH_COUNT = 16;
+
+    // Number of Material::bind() calls per repetition
+    const size_t BIND_COUNT = 100000;
+
+    // Materials and meshes shared by every case
+    struct Assets
+    {
+        std::vector<std::unique_ptr<MockShader>> shaders;
+        std::vector<std::unique_ptr<MockTexture>> textures;
+        std::vector<std::unique_ptr<Material>> materials;
+        std::vector<std::unique_ptr<MockMesh>> meshes;
+    };
+
+    Assets makeAssets()
+    {
+        Assets assets;
+        for (int i = 0; i < 4; ++i)
+        {
+            assets.shaders.push_back(std::make_unique<MockShader>("Shader" + std::to_string(i)));
+        }
+
+        unsigned char white[4] = {255, 255, 255, 255};
+        for (size_t i = 0; i < MATERIAL_COUNT; ++i)
+        {
+            auto texture = std::make_unique<MockTexture>();
+            texture->create(1, 1, white, TextureFormat::RGBA);
+
+            auto material = std::make_unique<Material>("Material" + std::to_string(i),
+                                                       assets.shaders[i % assets.shaders.size()].get());
+            material->setVector3("objectColor", Vector3(1.0f, 0.5f, 0.25f));
+            material->setFloat("ambientStrength", 0.1f);
+            material->setFloat("specularStrength", 0.5f);
+            material->setFloat("shininess", 32.0f);
+            material->setTexture("diffuseTexture", TextureRef(texture.get()), 0);
+
+            assets.textures.push_back(std::move(texture));
+            assets.materials.push_back(std::move(material));
+        }
+
+        // A quad per mesh is enough, the mock renderer never touches the vertices
+        std::vector<Vertex> vertices(4);
+        std::vector<uint32_t> indices = {0, 1, 2, 2, 3, 0};
+        vertices[1].position = Vector3(1.0f, 0.0f, 0.0f);
+        vertices[2].position = Vector3(1.0f, 1.0f, 0.0f);
+        vertices[3].position = Vector3(0.0f, 1.0f, 0.0f);
+        for (size_t i = 0; i < MESH_COUNT; ++i)
+        {
+            auto mesh = std::make_unique<MockMesh>("Mesh" + std::to_string(i));
+            mesh->setVertices(vertices);
+            mesh->setIndices(indices);
+            mesh->build();
+            assets.meshes.push_back(std::move(mesh));
+        }
+
+        return assets;
+    }
+
+    // Random draws over the shared assets, the same list on every run
+    std::vector<RenderItem> makeItems(const Assets &assets, size_t count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<size_t> material(0, MATERIAL_COUNT - 1);
+        std::uniform_int_distribution<size_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+        std::vector<RenderItem> items(count);
+        for (RenderItem &item : items)
+        {
+            item.mesh = assets.meshes[mesh(rng)].get();
+            item.material = assets.materials[material(rng)].get();
+            item.transform = Matrix4::translation(position(rng), position(rng), position(rng));
+        }
+        return items;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Suite suite("Render", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    Assets assets = makeAssets();
+    MockRenderer renderer;
+    renderer.initialize(1280, 720, "Benchmark");
+
+    // Switching between materials packs nothing new after the first time
+    suite.run("Material::bind", BIND_COUNT, [&]
+              {
+                  for (size_t i = 0; i < BIND_COUNT; ++i)
+                  {
+                      assets.materials[i % MATERIAL_COUNT]->bind();
+                  }
+              });
+
+    // Every change bumps the material version, so the next bind applies all parameters again
+    suite.run("Material::bind/changed", BIND_COUNT, [&]
+              {
+                  for (size_t i = 0; i < BIND_COUNT; ++i)
+                  {
+                      Material &material = *assets.materials[i % MATERIAL_COUNT];
+                      material.setFloat("shininess", static_cast<float>(i % 64));
+                      material.bind();
+                  }
+              });
+
+    for (size_t count : DRAW_COUNTS)
+    {
+        std::string suffix = "/" + std::to_string(count);
+        std::vector<RenderItem> items = makeItems(assets, count);
+
+        suite.run("drawMesh+endFrame" + suffix, count, [&]
+                  {
+                      renderer.beginFrame();
+                      for (const RenderItem &item : items)
+                      {
+                          renderer.drawMesh(item.mesh, item.material, item.transform);
+                      }
+                      renderer.endFrame();
+                  });
+
+        RenderSnapshot snapshot;
+        snapshot.hasCamera = true;
+        snapshot.items = items;
+        suite.run("renderSnapshot" + suffix, count, [&]
+                  {
+                      renderer.beginFrame();
+                      renderer.renderSnapshot(snapshot);
+                      renderer.endFrame();
+                  });
+
+        const RenderStats &stats = renderer.getStats();
+        std::printf("  %zu draws: %u shader, %u material, %u mesh changes\n", count, stats.shaderChanges,
+                    stats.materialChanges, stats.meshChanges);
+    }
+
+    renderer.shutdown();
+    return suite.finish();
+}
@@ -0,0 +1,167 @@
+#include "Benchmark.hpp"
+#include "MockRenderer.hpp"
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Resources/MeshCooker.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+using namespace Benchmark;
+
+namespace
+{
+    // Grid sizes of the cooked meshes, in vertices per side
+    const int MESH_SIDES[] = {32, 256, 1024};
+
+    // Size of the BC1 test texture
+    const int TEXTURE_SIZE = 2048;
+
+    // Number of meshes loaded in one async batch
+    const size_t ASYNC_BATCH = 64;
+
+    // Cooks a flat grid of side x side vertices
+    bool cookGrid(const std::string &path, int side)
+    {
+        std::vector<Vertex> vertices(static_cast<size_t>(side) * side);
+        for (int y = 0; y < side; ++y)
+        {
+            for (int x = 0; x < side; ++x)
+            {
+                Vertex &vertex = vertices[static_cast<size_t>(y) * side + x];
+                vertex.position = Vector3(static_cast<float>(x), std::sin(x * 0.1f) * std::cos(y * 0.1f), static_cast<float>(y));
+                vertex.normal = Vector3(0.0f, 1.0f, 0.0f);
+                vertex.texCoord = Vector2(x / static_cast<float>(side), y / static_cast<float>(side));
+            }
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve(static_cast<size_t>(side - 1) * (side - 1) * 6);
+        for (int y = 0; y + 1 < side; ++y)
+        {
+            for (int x = 0; x + 1 < side; ++x)
+            {
+                uint32_t corner = static_cast<uint32_t>(y * side + x);
+                indices.insert(indices.end(), {corner, corner + side, corner + 1, corner + 1, corner + side, corner + side + 1});
+            }
+        }
+        return MeshCooker::cook(path, vertices, indices);
+    }
+
+    // Writes a DDS file with a full BC1 mip chain of zero blocks
+    bool writeDDS(const std::string &path, int size)
+    {
+        int levels = getMipLevelCount(size, size);
+        unsigned char header[128] = {};
+        auto write32 = [&header](size_t offset, uint32_t value)
+        { std::memcpy(header + offset, &value, sizeof(value)); };
+        std::memcpy(header, "DDS ", 4);
+        write32(4, 124);
+        write32(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+        write32(12, static_cast<uint32_t>(size));
+        write32(16, static_cast<uint32_t>(size));
+        write32(28, static_cast<uint32_t>(levels));
+        write32(76, 32);
+        write32(80, 0x4);
+        std::memcpy(header + 84, "DXT1", 4);
+        write32(108, 0x1000 | 0x400000 | 0x8);
+
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+        std::fwrite(header, 1, sizeof(header), file);
+        for (int level = 0; level < levels; ++level)
+        {
+            int levelSize = std::max(1, size >> level);
+            std::vector<unsigned char> blocks(getTextureLevelSize(TextureFormat::BC1, levelSize, levelSize));
+            std::fwrite(blocks.data(), 1, blocks.size(), file);
+        }
+        bool written = std::ferror(file) == 0;
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Gives the manager a clean slate and points it at the test files
+    void reset(MockResourceManager &manager, JobSystem *jobs, const std::string &directory)
+    {
+        manager.shutdown();
+        manager.initialize(jobs);
+        manager.setResourcesPath(directory);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Suite suite("Resources", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    // Keep the per-load info messages out of the measurements
+    Logger::init(LogLevel::Warning);
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "engine-benchmarks";
+    std::filesystem::create_directories(directory);
+    for (int side : MESH_SIDES)
+    {
+        if (!cookGrid((directory / ("grid" + std::to_string(side) + ".mesh")).string(), side))
+        {
+            std::fprintf(stderr, "Failed to write the test meshes to %s\n", directory.string().c_str());
+            return 1;
+        }
+    }
+    if (!writeDDS((directory / "texture.dds").string(), TEXTURE_SIZE))
+    {
+        std::fprintf(stderr, "Failed to write the test texture to %s\n", directory.string().c_str());
+        return 1;
+    }
+
+    JobSystem jobs;
+    jobs.initialize(JobSystem::getDefaultWorkerCount());
+    MockResourceManager manager;
+
+    for (int side : MESH_SIDES)
+    {
+        std::string file = "grid" + std::to_string(side) + ".mesh";
+        suite.run("loadMesh/" + std::to_string(side * side) + "-vertices", 1, [&]
+                  { reset(manager, nullptr, directory.string()); },
+                  [&]
+                  { keep(manager.loadMesh("Grid", file)); });
+    }
+
+    // Container textures upload from the streaming start size; the rest of the chain streams in later
+    suite.run("loadTexture/dds-" + std::to_string(TEXTURE_SIZE), 1, [&]
+              { reset(manager, nullptr, directory.string()); },
+              [&]
+              { keep(manager.loadTexture("Texture", "texture.dds")); });
+
+    // The same mesh under many names, decoded on the workers and uploaded without a budget
+    suite.run("loadMeshAsync/batch-" + std::to_string(ASYNC_BATCH), ASYNC_BATCH, [&]
+              { reset(manager, &jobs, directory.string()); },
+              [&]
+              {
+                  for (size_t i = 0; i < ASYNC_BATCH; ++i)
+                  {
+                      manager.loadMeshAsync("Grid" + std::to_string(i), "grid256.mesh");
+                  }
+                  while (manager.getPendingLoadCount() > 0)
+                  {
+                      manager.processUploads(1000.0f);
+                      manager.update();
+                  }
+              });
+
+    manager.shutdown();
+    jobs.shutdown();
+    std::filesystem::remove_all(directory);
+    Logger::shutdown();
+    return suite.finish();
+}
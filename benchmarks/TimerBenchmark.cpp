@@ -0,0 +1,106 @@
+#include "Benchmark.hpp"
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+using namespace Benchmark;
+
+namespace
+{
+    // Timers scheduled in every case
+    const size_t TIMER_COUNT = 100000;
+
+    // Delay of timers that must not expire while measuring
+    const float FAR_DELAY = 1.0e6f;
+
+    // Replaces the timers with TIMER_COUNT new ones
+    std::vector<TimerId> schedule(std::unique_ptr<Time> &time, float delay, bool repeat, bool parallel,
+                                  std::atomic<uint64_t> &fired, JobSystem *jobs = nullptr)
+    {
+        time = std::make_unique<Time>();
+        time->setJobSystem(jobs);
+
+        std::vector<TimerId> ids(TIMER_COUNT);
+        for (TimerId &id : ids)
+        {
+            id = time->createTimer([&fired]
+                                   { fired.fetch_add(1, std::memory_order_relaxed); },
+                                   delay, repeat, parallel);
+        }
+        return ids;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Suite suite("Timers", argc, argv);
+    if (!suite.isValid())
+    {
+        return suite.finish();
+    }
+
+    Logger::init(LogLevel::Warning);
+
+    JobSystem jobs;
+    jobs.initialize(JobSystem::getDefaultWorkerCount());
+
+    std::unique_ptr<Time> time;
+    std::atomic<uint64_t> fired(0);
+    std::vector<TimerId> ids;
+
+    suite.run("createTimer", TIMER_COUNT, [&]
+              { time = std::make_unique<Time>(); },
+              [&]
+              {
+                  for (size_t i = 0; i < TIMER_COUNT; ++i)
+                  {
+                      keep(time->createTimer([&fired]
+                                             { fired.fetch_add(1, std::memory_order_relaxed); },
+                                             FAR_DELAY));
+                  }
+              });
+
+    suite.run("cancelTimer", TIMER_COUNT, [&]
+              { ids = schedule(time, FAR_DELAY, false, false, fired); },
+              [&]
+              {
+                  for (TimerId id : ids)
+                  {
+                      keep(time->cancelTimer(id));
+                  }
+              });
+
+    // Nothing expires, so an update should not depend on the number of timers
+    schedule(time, FAR_DELAY, false, false, fired);
+    suite.run("update/idle-" + std::to_string(TIMER_COUNT), 1, [&]
+              { time->update(); });
+
+    // Zero-delay timers all expire at the next update
+    suite.run("update/expire", TIMER_COUNT, [&]
+              { schedule(time, 0.0f, false, false, fired); },
+              [&]
+              { time->update(); });
+
+    suite.run("update/expire-parallel", TIMER_COUNT, [&]
+              { schedule(time, 0.0f, false, true, fired, &jobs); },
+              [&]
+              { time->update(); });
+
+    // Repeating timers are rescheduled in the same update that runs them
+    schedule(time, 0.0f, true, false, fired);
+    suite.run("update/repeat", TIMER_COUNT, [&]
+              { time->update(); });
+
+    time.reset();
+    jobs.shutdown();
+    keep(fired.load());
+    Logger::shutdown();
+    return suite.finish();
+}
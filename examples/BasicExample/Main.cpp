@@ -26,12 +26,24 @@ public:
     {
         name = "PlayerSystem";
 
-        // Register required components
-        requiredComponents.insert(std::type_index(typeid(PlayerComponent)));
+        // Declare data access so the scheduler can run other systems alongside
+        reads<PlayerComponent>();
+        writes<Transform>();
     }
 
     bool initialize() override
     {
+        // Cache the view of all player entities
+        players = &view<PlayerComponent>();
+
+        // Register the actions once and keep their IDs, so update() never looks up a name
+        auto &mapping = engine.getInputManager().getMapping();
+        moveForward = registerAction(mapping, "MoveForward", Key::W);
+        moveBack = registerAction(mapping, "MoveBack", Key::S);
+        moveLeft = registerAction(mapping, "MoveLeft", Key::A);
+        moveRight = registerAction(mapping, "MoveRight", Key::D);
+        turnLeft = registerAction(mapping, "TurnLeft", Key::Q);
+        turnRight = registerAction(mapping, "TurnRight", Key::E);
         return true;
     }
 
@@ -39,30 +51,15 @@ public:
     {
         auto &input = engine.getInputManager();
 
-        for (auto entity : entities)
+        for (auto [entity, player] : *players)
         {
-            auto &player = entity->getComponent<PlayerComponent>();
-            auto &transform = entity->getTransform();
+            auto &transform = entity.getTransform();
 
             // Handle movement
             Vector3 movement;
 
-            if (input.isKeyPressed(Key::W))
-            {
-                movement.z += 1.0f;
-            }
-            if (input.isKeyPressed(Key::S))
-            {
-                movement.z -= 1.0f;
-            }
-            if (input.isKeyPressed(Key::A))
-            {
-                movement.x -= 1.0f;
-            }
-            if (input.isKeyPressed(Key::D))
-            {
-                movement.x += 1.0f;
-            }
+            movement.z += input.getActionValue(moveForward) - input.getActionValue(moveBack);
+            movement.x += input.getActionValue(moveRight) - input.getActionValue(moveLeft);
 
             // Normalize and apply movement
             if (movement.lengthSquared() > 0.0f)
@@ -75,14 +72,7 @@ public:
             // Handle rotation
             Vector3 rotation;
 
-            if (input.isKeyPressed(Key::Q))
-            {
-                rotation.y -= 1.0f;
-            }
-            if (input.isKeyPressed(Key::E))
-            {
-                rotation.y += 1.0f;
-            }
+            rotation.y += input.getActionValue(turnRight) - input.getActionValue(turnLeft);
 
             // Apply rotation
             if (rotation.lengthSquared() > 0.0f)
@@ -97,6 +87,27 @@ public:
     {
         // Nothing to clean up
     }
+
+private:
+    static ActionId registerAction(InputMapping &mapping, const std::string &name, Key key)
+    {
+        ActionId id = mapping.registerAction(name, true);
+        if (id == InvalidAction)
+        {
+            id = mapping.getActionId(name);
+        }
+        mapping.bindKey(name, key);
+        return id;
+    }
+
+    View<PlayerComponent> *players = nullptr;
+
+    ActionId moveForward = InvalidAction;
+    ActionId moveBack = InvalidAction;
+    ActionId moveLeft = InvalidAction;
+    ActionId moveRight = InvalidAction;
+    ActionId turnLeft = InvalidAction;
+    ActionId turnRight = InvalidAction;
 };
 
 int main()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "Engine/Core/Logger.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
@@ -26,6 +27,9 @@ namespace Engine
 
         /**
          * @brief Maximum number of substeps per frame
+         *
+         * Also limits the number of fixed simulation steps the engine runs
+         * per frame; time beyond that is dropped.
          */
         int maxSubsteps = 10;
 
@@ -130,9 +134,67 @@ namespace Engine
         int maxCacheSize = 1024;
 
         /**
-         * @brief Automatic resource reloading
+         * @brief Reload textures, meshes, and shaders when their files under the resources path change
          */
         bool autoReload = false;
+
+        /**
+         * @brief Time per frame spent uploading async loads to the GPU, in milliseconds
+         */
+        float uploadBudget = 2.0f;
+
+        /**
+         * @brief Asset archives to mount, relative to the working directory; later ones override earlier ones
+         */
+        std::vector<std::string> archives;
+
+        /**
+         * @brief Load assets missing from the archives from the resources directory
+         */
+        bool looseFiles = true;
+
+        /**
+         * @brief Texture memory in bytes above which unused textures are evicted, 0 for unlimited
+         */
+        size_t textureBudget = 0;
+
+        /**
+         * @brief Mesh memory in bytes above which unused meshes are evicted, 0 for unlimited
+         */
+        size_t meshBudget = 0;
+
+        /**
+         * @brief Largest dimension of the mip levels uploaded when a KTX2 or DDS texture loads, 0 to upload every level
+         */
+        int textureStreamingStartSize = 64;
+    };
+
+    /**
+     * @brief Job system configuration
+     */
+    struct JobConfig
+    {
+        /**
+         * @brief Number of worker threads
+         *
+         * -1 uses one worker per hardware thread minus the main thread, 0 runs
+         * every job on the thread that submits it.
+         */
+        int workerCount = -1;
+    };
+
+    /**
+     * @brief Memory configuration
+     */
+    struct MemoryConfig
+    {
+        /**
+         * @brief Initial size in bytes of the frame arena of every thread
+         *
+         * Arenas grow to the largest frame they have seen, so this only
+         * avoids the growth during the first frames.
+         */
+        size_t frameArenaSize = 1024 * 1024;
     };
 
     /**
@@ -160,6 +222,11 @@ namespace Engine
          */
         LogLevel logLevel = LogLevel::Info;
 
+        /**
+         * @brief Logger sinks and asynchronous mode; the level is taken from logLevel
+         */
+        LoggerConfig logger;
+
         /**
          * @brief Renderer configuration
          */
@@ -180,6 +247,26 @@ namespace Engine
          */
         ResourceConfig resource;
 
+        /**
+         * @brief Job system configuration
+         */
+        JobConfig jobs;
+
+        /**
+         * @brief Memory configuration
+         */
+        MemoryConfig memory;
+
+        /**
+         * @brief Record a profiler capture from initialization to shutdown
+         */
+        bool profile = false;
+
+        /**
+         * @brief Chrome trace file the capture is written to at shutdown
+         */
+        std::string profileOutputPath = "profile.json";
+
         /**
          * @brief Target frame rate (0 for uncapped)
          */
@@ -187,6 +274,10 @@ namespace Engine
 
         /**
          * @brief Fixed update rate for gameplay logic
+         *
+         * Timestep in seconds of System::fixedUpdate and of the physics step.
+         * Rendering interpolates between the last two steps, so the
+         * simulation can run at a low rate while frames render uncapped.
          */
         float fixedUpdateRate = 1.0f / 60.0f;
 
@@ -8,7 +8,12 @@
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/Logger.hpp"
 #include "Engine/Core/Config.hpp"
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/Memory.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/FramePipeline.hpp"
 #include "Engine/Input/InputManager.hpp"
 #include "Engine/Physics/PhysicsWorld.hpp"
 #include "Engine/Audio/AudioManager.hpp"
@@ -55,12 +60,30 @@ namespace Engine
          */
         void shutdown();
 
+        /**
+         * @brief Gets the job system shared by all subsystems
+         * @return Reference to the job system
+         */
+        JobSystem &getJobSystem() { return *jobSystem; }
+
+        /**
+         * @brief Gets the per-thread frame arenas, reset at the start of every frame
+         * @return Reference to the frame allocator
+         */
+        FrameAllocator &getFrameAllocator() { return frameAllocator; }
+
         /**
          * @brief Gets the renderer subsystem
          * @return Reference to the renderer
          */
         Renderer &getRenderer() { return *renderer; }
 
+        /**
+         * @brief Gets the frame pipeline
+         * @return Pointer to the frame pipeline, or nullptr if rendering is not pipelined
+         */
+        FramePipeline *getFramePipeline() { return framePipeline.get(); }
+
         /**
          * @brief Gets the input manager subsystem
          * @return Reference to the input manager
@@ -118,11 +141,26 @@ namespace Engine
          */
         Time time;
 
+        /**
+         * @brief Job system
+         */
+        std::unique_ptr<JobSystem> jobSystem;
+
+        /**
+         * @brief Frame arenas of the main thread and the job system workers
+         */
+        FrameAllocator frameAllocator;
+
         /**
          * @brief Renderer subsystem
          */
         std::unique_ptr<Renderer> renderer;
 
+        /**
+         * @brief Render thread and snapshot ring (only in pipelined mode)
+         */
+        std::unique_ptr<FramePipeline> framePipeline;
+
         /**
          * @brief Input manager subsystem
          */
@@ -161,7 +199,9 @@ namespace Engine
                                            config(config),
                                            time()
     {
-        Logger::init(config.logLevel);
+        LoggerConfig loggerConfig = config.logger;
+        loggerConfig.level = config.logLevel;
+        Logger::init(loggerConfig);
         Logger::info("Engine created");
     }
 
@@ -172,20 +212,75 @@ namespace Engine
             shutdown();
         }
         Logger::info("Engine destroyed");
+
+        // Write out whatever the asynchronous logger still holds
+        Logger::shutdown();
     }
 
     bool Engine::initialize()
     {
         Logger::info("Initializing engine...");
 
+        Profiler::setThreadName("Main");
+        if (config.profile)
+        {
+            Profiler::start();
+        }
+
+        // Create the job system first so every subsystem can use it
+        uint32_t workerCount = config.jobs.workerCount < 0
+                                   ? JobSystem::getDefaultWorkerCount()
+                                   : static_cast<uint32_t>(config.jobs.workerCount);
+        jobSystem = std::make_unique<JobSystem>();
+        if (!jobSystem->initialize(workerCount))
+        {
+            Logger::error("Failed to initialize job system");
+            return false;
+        }
+
+        if (!frameAllocator.initialize(jobSystem.get(), config.memory.frameArenaSize))
+        {
+            Logger::error("Failed to initialize frame allocator");
+            return false;
+        }
+
+        time.setJobSystem(jobSystem.get());
+
         // Create subsystems
         resourceManager = std::make_unique<ResourceManager>();
-        if (!resourceManager->initialize())
+        if (!resourceManager->initialize(jobSystem.get()))
         {
             Logger::error("Failed to initialize resource manager");
             return false;
         }
 
+        resourceManager->setResourcesPath(config.resource.resourcesPath);
+        resourceManager->setTextureBudget(config.resource.textureBudget);
+        resourceManager->setMeshBudget(config.resource.meshBudget);
+        resourceManager->setTextureStreamingStartSize(config.resource.textureStreamingStartSize);
+
+        // A missing archive is not fatal while loose files can stand in for it
+        resourceManager->setLooseFilesEnabled(config.resource.looseFiles);
+        for (const std::string &archive : config.resource.archives)
+        {
+            if (!resourceManager->mountArchive(archive) && !config.resource.looseFiles)
+            {
+                return false;
+            }
+        }
+
+        // Changed files are only picked up from the loose resources directory
+        if (config.resource.autoReload && config.resource.looseFiles)
+        {
+            resourceManager->setAutoReload(true);
+        }
+
+        // Shader binaries live next to the other resources unless configured elsewhere
+        if (config.renderer.shaderBinaryCache && config.renderer.shaderCachePath.empty())
+        {
+            config.renderer.shaderCachePath = config.resource.resourcesPath + "/shadercache";
+        }
+
         renderer = std::make_unique<Renderer>(config.renderer);
         if (!renderer->initialize(config.windowWidth, config.windowHeight, config.windowTitle))
         {
@@ -193,6 +288,12 @@ namespace Engine
             return false;
         }
 
+        if (!resourceManager->createPlaceholders(renderer->getDefaultShader("Phong")))
+        {
+            Logger::error("Failed to create placeholder resources");
+            return false;
+        }
+
         inputManager = std::make_unique<InputManager>();
         if (!inputManager->initialize(renderer->getWindow()))
         {
@@ -221,13 +322,28 @@ namespace Engine
             return false;
         }
 
+        // Hand the graphics context to the render thread last, after every
+        // subsystem that needs it during initialization
+        if (config.renderer.pipelined)
+        {
+            framePipeline = std::make_unique<FramePipeline>(*renderer);
+            if (!framePipeline->initialize(config.renderer.framesInFlight))
+            {
+                Logger::error("Failed to initialize frame pipeline");
+                return false;
+            }
+
+            // Queued snapshots keep drawing resources after they are evicted
+            resourceManager->setFramesInFlight(framePipeline->getFramesInFlight());
+        }
+
         Logger::info("Engine initialized successfully");
         return true;
     }
 
     int Engine::run()
     {
-        if (!renderer || !inputManager || !physicsWorld || !audioManager || !resourceManager || !sceneManager)
+        if (!jobSystem || !renderer || !inputManager || !physicsWorld || !audioManager || !resourceManager || !sceneManager)
         {
             Logger::error("Cannot run engine: Not all subsystems are initialized");
             return -1;
@@ -236,8 +352,10 @@ namespace Engine
         running = true;
         Logger::info("Starting main loop");
 
-        // Reset the timer
+        // Reset the timer and set up the fixed simulation rate
         time.reset();
+        time.setFixedTimestep(config.fixedUpdateRate);
+        time.setMaxFixedSteps(config.physics.maxSubsteps);
 
         // Main game loop
         while (running)
@@ -257,25 +375,96 @@ namespace Engine
 
     void Engine::processFrame()
     {
+        ENGINE_PROFILE_SCOPE("Frame");
+
+        // Nothing allocated from the frame arenas outlives its frame, and the
+        // render thread never reads frame memory
+        Memory::beginFrame();
+        frameAllocator.reset();
+
         // Update time
         time.update();
 
         // Process input
-        inputManager->update();
+        {
+            ENGINE_PROFILE_SCOPE("Input");
+            MemoryScope memoryScope(MemoryTag::Input);
+            inputManager->update();
+        }
+
+        // Hand finished background loads to the game
+        {
+            ENGINE_PROFILE_SCOPE("Resources");
+            MemoryScope memoryScope(MemoryTag::Resources);
+            resourceManager->update();
+        }
+
+        // Advance the simulation in fixed steps so that it behaves the same
+        // at any frame rate
+        float fixedDeltaTime = time.getFixedTimestep();
+        for (int step = 0; step < time.getFixedStepCount(); ++step)
+        {
+            ENGINE_PROFILE_SCOPE("Fixed step");
+            {
+                ENGINE_PROFILE_SCOPE("Scene fixed update");
+                MemoryScope memoryScope(MemoryTag::Scene);
+                sceneManager->fixedUpdate(fixedDeltaTime);
+            }
+            {
+                ENGINE_PROFILE_SCOPE("Physics");
+                MemoryScope memoryScope(MemoryTag::Physics);
+                physicsWorld->update(fixedDeltaTime);
+            }
+        }
 
         // Update scene (this will update all entities and systems)
-        sceneManager->update(time.getDeltaTime());
+        {
+            ENGINE_PROFILE_SCOPE("Scene update");
+            MemoryScope memoryScope(MemoryTag::Scene);
+            sceneManager->update(time.getDeltaTime());
+        }
 
-        // Update physics
-        physicsWorld->update(time.getDeltaTime());
+        // Draw the state between the last two fixed steps
+        float alpha = time.getInterpolationAlpha();
 
         // Render frame
-        renderer->beginFrame();
-        sceneManager->render();
-        renderer->endFrame();
+        if (framePipeline)
+        {
+            ENGINE_PROFILE_SCOPE("Render snapshot");
+            MemoryScope memoryScope(MemoryTag::Renderer);
+
+            // Capture the frame and let the render thread draw it while the
+            // next frame is simulated
+            if (resourceManager->hasPendingUploads())
+            {
+                float budget = config.resource.uploadBudget;
+                ResourceManager *resources = resourceManager.get();
+                framePipeline->runOnRenderThread([resources, budget]()
+                                                 { resources->processUploads(budget); });
+            }
+
+            RenderSnapshot &snapshot = framePipeline->beginSnapshot();
+            sceneManager->buildRenderSnapshot(snapshot, alpha);
+            framePipeline->submitSnapshot();
+        }
+        else
+        {
+            ENGINE_PROFILE_SCOPE("Render");
+            MemoryScope memoryScope(MemoryTag::Renderer);
+
+            resourceManager->processUploads(config.resource.uploadBudget);
+
+            renderer->beginFrame();
+            sceneManager->render(alpha);
+            renderer->endFrame();
+        }
 
         // Update audio
-        audioManager->update();
+        {
+            ENGINE_PROFILE_SCOPE("Audio");
+            MemoryScope memoryScope(MemoryTag::Audio);
+            audioManager->update();
+        }
     }
 
     void Engine::shutdown()
@@ -283,6 +472,17 @@ namespace Engine
         Logger::info("Shutting down engine...");
 
         // Shutdown subsystems in reverse order of initialization
+        if (framePipeline)
+        {
+            // Finish in-flight frames before anything they reference goes away
+            framePipeline->shutdown();
+            framePipeline.reset();
+            if (resourceManager)
+            {
+                resourceManager->setFramesInFlight(0);
+            }
+        }
+
         if (sceneManager)
         {
             sceneManager->shutdown();
@@ -319,7 +519,24 @@ namespace Engine
             resourceManager.reset();
         }
 
+        time.setJobSystem(nullptr);
+        frameAllocator.shutdown();
+
+        if (jobSystem)
+        {
+            jobSystem->shutdown();
+            jobSystem.reset();
+        }
+
         running = false;
+
+        // Every thread has finished its zones once the subsystems are gone
+        if (Profiler::isRecording())
+        {
+            Profiler::stop();
+            Profiler::writeChromeTrace(config.profileOutputPath);
+        }
+
         Logger::info("Engine shut down successfully");
     }
 
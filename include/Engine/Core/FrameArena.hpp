@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Memory.hpp"
+
+namespace Engine
+{
+
+    class JobSystem;
+
+    /**
+     * @brief Linear allocator whose memory is released all at once
+     *
+     * Allocation bumps an offset into a block, and reset() makes the whole
+     * block available again without touching the heap. When a frame needs
+     * more than the block holds, extra blocks are taken from the heap and
+     * merged into one larger block at the next reset(), so the arena grows
+     * to the high-water mark of its frames and then stops allocating.
+     *
+     * Destructors are never run, so only trivially destructible objects may
+     * be created in an arena. An arena is not thread-safe; FrameAllocator
+     * gives every thread its own.
+     */
+    class FrameArena
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity Size in bytes of the initial block, 0 to allocate on first use
+         * @param tag Tag the blocks are counted against
+         */
+        explicit FrameArena(size_t capacity = 0, MemoryTag tag = MemoryTag::Frame);
+
+        /**
+         * @brief Destructor
+         */
+        ~FrameArena();
+
+        FrameArena(const FrameArena &) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+
+        /**
+         * @brief Allocates uninitialized memory valid until the next reset()
+         * @param size Size in bytes
+         * @param alignment Alignment in bytes, a power of two
+         * @return Pointer to the memory, or nullptr if the heap is exhausted
+         */
+        void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Constructs an object valid until the next reset()
+         * @tparam T Object type, must be trivially destructible
+         * @tparam Args Constructor argument types
+         * @param args Constructor arguments
+         * @return Pointer to the object, or nullptr if the heap is exhausted
+         */
+        template <typename T, typename... Args>
+        T *create(Args &&...args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+
+            void *memory = allocate(sizeof(T), alignof(T));
+            return memory ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        /**
+         * @brief Allocates a value-initialized array valid until the next reset()
+         * @tparam T Element type, must be trivially destructible
+         * @param count Number of elements
+         * @return Pointer to the first element, or nullptr if the heap is exhausted
+         */
+        template <typename T>
+        T *allocateArray(size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+
+            T *elements = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+            if (elements)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    new (elements + i) T();
+                }
+            }
+            return elements;
+        }
+
+        /**
+         * @brief Releases every allocation at once
+         *
+         * Merges the blocks of a frame that overflowed into one block large
+         * enough for the whole frame.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the number of bytes allocated since the last reset
+         * @return Used bytes, including alignment padding
+         */
+        size_t getUsed() const { return used; }
+
+        /**
+         * @brief Gets the total size of the blocks
+         * @return Capacity in bytes
+         */
+        size_t getCapacity() const { return capacity; }
+
+        /**
+         * @brief Gets the largest number of bytes used in one frame
+         * @return Peak used bytes
+         */
+        size_t getPeak() const { return peak; }
+
+    private:
+        /**
+         * @brief One block of arena memory
+         */
+        struct Block
+        {
+            /**
+             * @brief Start of the block
+             */
+            unsigned char *data;
+
+            /**
+             * @brief Size of the block in bytes
+             */
+            size_t size;
+        };
+
+        /**
+         * @brief Adds a block that holds at least an allocation of the given size
+         * @param size Size in bytes of the allocation
+         * @param alignment Alignment of the allocation
+         * @return True if the block was allocated
+         */
+        bool grow(size_t size, size_t alignment);
+
+        /**
+         * @brief Frees every block
+         */
+        void release();
+
+        /**
+         * @brief Blocks of the arena, allocations are served from the last one
+         */
+        std::vector<Block> blocks;
+
+        /**
+         * @brief Offset of the next allocation in the last block
+         */
+        size_t offset;
+
+        /**
+         * @brief Bytes allocated since the last reset
+         */
+        size_t used;
+
+        /**
+         * @brief Total size of the blocks
+         */
+        size_t capacity;
+
+        /**
+         * @brief Largest number of bytes used in one frame
+         */
+        size_t peak;
+
+        /**
+         * @brief Tag the blocks are counted against
+         */
+        MemoryTag tag;
+    };
+
+    /**
+     * @brief One frame arena per thread, reset once per frame
+     *
+     * The thread that initializes the allocator and every worker of its job
+     * system get their own arena, so jobs can allocate frame memory without
+     * locking. The engine resets all arenas at the start of a frame, after
+     * the jobs of the previous frame have finished.
+     */
+    class FrameAllocator
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        FrameAllocator();
+
+        /**
+         * @brief Creates the arenas
+         * @param jobSystem Job system whose workers get an arena, may be nullptr
+         * @param capacityPerThread Initial size in bytes of every arena
+         * @return True if initialization succeeded, false otherwise
+         */
+        bool initialize(JobSystem *jobSystem, size_t capacityPerThread);
+
+        /**
+         * @brief Frees the arenas
+         */
+        void shutdown();
+
+        /**
+         * @brief Resets every arena
+         *
+         * No thread may use frame memory while the arenas are reset.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the arena of the calling thread
+         * @return Arena of the thread, or nullptr if the thread is neither the
+         *         owning thread nor a worker of the job system
+         */
+        FrameArena *getThreadArena();
+
+        /**
+         * @brief Gets the number of bytes allocated in all arenas since the last reset
+         * @return Used bytes
+         */
+        size_t getUsed() const;
+
+        /**
+         * @brief Gets the total size of all arenas
+         * @return Capacity in bytes
+         */
+        size_t getCapacity() const;
+
+    private:
+        /**
+         * @brief Job system whose workers own arenas 1 and up
+         */
+        JobSystem *jobs;
+
+        /**
+         * @brief Thread that owns arena 0
+         */
+        std::thread::id owner;
+
+        /**
+         * @brief Arena of the owning thread followed by one per worker
+         */
+        std::vector<std::unique_ptr<FrameArena>> arenas;
+    };
+
+} // namespace Engine
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Engine
+{
+
+    template <typename Signature, size_t Capacity = 48>
+    class InplaceFunction;
+
+    /**
+     * @brief Move-only callable wrapper that never allocates
+     * @tparam R Return type
+     * @tparam Args Argument types
+     * @tparam Capacity Size in bytes of the inline storage
+     *
+     * Works like std::function, but the callable is always stored inside the
+     * wrapper. Callables larger than Capacity are rejected at compile time
+     * instead of falling back to the heap.
+     */
+    template <typename R, typename... Args, size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        /**
+         * @brief Constructs an empty function
+         */
+        InplaceFunction() noexcept : ops(nullptr) {}
+
+        /**
+         * @brief Constructs an empty function
+         */
+        InplaceFunction(std::nullptr_t) noexcept : ops(nullptr) {}
+
+        /**
+         * @brief Stores a callable
+         * @tparam F Callable type
+         * @param function Callable to store
+         */
+        template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InplaceFunction>::value>>
+        InplaceFunction(F &&function) : ops(&Table<std::decay_t<F>>::ops)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(sizeof(Callable) <= Capacity, "Callable is too large for this InplaceFunction");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned");
+
+            new (storage) Callable(std::forward<F>(function));
+        }
+
+        /**
+         * @brief Move constructor
+         * @param other Function to move from, left empty
+         */
+        InplaceFunction(InplaceFunction &&other) noexcept : ops(other.ops)
+        {
+            if (ops)
+            {
+                ops->move(storage, other.storage);
+                other.reset();
+            }
+        }
+
+        /**
+         * @brief Move assignment
+         * @param other Function to move from, left empty
+         * @return Reference to this function
+         */
+        InplaceFunction &operator=(InplaceFunction &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.ops)
+                {
+                    ops = other.ops;
+                    ops->move(storage, other.storage);
+                    other.reset();
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroys the stored callable
+         */
+        ~InplaceFunction()
+        {
+            reset();
+        }
+
+        InplaceFunction(const InplaceFunction &) = delete;
+        InplaceFunction &operator=(const InplaceFunction &) = delete;
+
+        /**
+         * @brief Calls the stored callable
+         * @param args Call arguments
+         * @return Result of the call
+         * @throws std::bad_function_call if the function is empty
+         */
+        R operator()(Args... args) const
+        {
+            if (!ops)
+            {
+                throw std::bad_function_call();
+            }
+            return ops->invoke(storage, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Checks if a callable is stored
+         * @return True if the function is not empty
+         */
+        explicit operator bool() const noexcept { return ops != nullptr; }
+
+        /**
+         * @brief Destroys the stored callable and leaves the function empty
+         */
+        void reset() noexcept
+        {
+            if (ops)
+            {
+                ops->destroy(storage);
+                ops = nullptr;
+            }
+        }
+
+    private:
+        /**
+         * @brief Type-erased operations on the stored callable
+         */
+        struct Ops
+        {
+            R (*invoke)(void *, Args &&...);
+            void (*move)(void *, void *);
+            void (*destroy)(void *);
+        };
+
+        /**
+         * @brief Operations for one callable type
+         * @tparam Callable Stored callable type
+         */
+        template <typename Callable>
+        struct Table
+        {
+            static R invoke(void *callable, Args &&...args)
+            {
+                return (*static_cast<Callable *>(callable))(std::forward<Args>(args)...);
+            }
+
+            static void move(void *target, void *source)
+            {
+                new (target) Callable(std::move(*static_cast<Callable *>(source)));
+            }
+
+            static void destroy(void *callable)
+            {
+                static_cast<Callable *>(callable)->~Callable();
+            }
+
+            static constexpr Ops ops = {&invoke, &move, &destroy};
+        };
+
+        /**
+         * @brief Inline storage of the callable
+         */
+        alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+
+        /**
+         * @brief Operations of the stored callable, nullptr if empty
+         */
+        const Ops *ops;
+    };
+
+} // namespace Engine
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+
+    class JobSystem;
+
+    /**
+     * @brief Counts outstanding jobs so that a caller can wait for them
+     *
+     * A counter also acts as a dependency: jobs submitted with
+     * JobSystem::submitAfter are held back until the counter reaches zero.
+     */
+    class JobCounter
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        JobCounter() : value(0), releasing(0) {}
+
+        /**
+         * @brief Checks if all counted jobs have finished
+         * @return True if no counted job is outstanding
+         *
+         * Once this returns true no job system thread touches the counter any
+         * more, so it may be destroyed.
+         */
+        bool isDone() const
+        {
+            return value.load(std::memory_order_acquire) == 0 &&
+                   releasing.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+
+        /**
+         * @brief Job held back until the counter reaches zero
+         */
+        struct Continuation
+        {
+            /**
+             * @brief Job to run
+             */
+            std::function<void()> job;
+
+            /**
+             * @brief Counter of the held back job
+             */
+            JobCounter *counter;
+        };
+
+        /**
+         * @brief Number of outstanding jobs
+         */
+        std::atomic<uint32_t> value;
+
+        /**
+         * @brief Number of threads still inside JobSystem::release
+         */
+        std::atomic<uint32_t> releasing;
+
+        /**
+         * @brief Mutex protecting the continuations
+         */
+        std::mutex mutex;
+
+        /**
+         * @brief Jobs waiting for this counter
+         */
+        std::vector<Continuation> continuations;
+    };
+
+    /**
+     * @brief Work-stealing thread pool
+     *
+     * Every worker owns a deque: it pushes and pops its own jobs at the back
+     * and idle workers steal from the front of other deques. Jobs submitted
+     * from outside the pool go to a shared injection queue. Waiting on a
+     * counter executes other jobs instead of blocking, so jobs may submit and
+     * wait for nested jobs.
+     *
+     * With zero workers every job runs inline on the submitting thread, which
+     * gives a deterministic single-threaded fallback.
+     */
+    class JobSystem
+    {
+    public:
+        /**
+         * @brief Job function type
+         */
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Constructor
+         */
+        JobSystem();
+
+        /**
+         * @brief Destructor
+         */
+        ~JobSystem();
+
+        /**
+         * @brief Starts the worker threads
+         * @param workerCount Number of worker threads (0 runs jobs inline)
+         * @return True if initialization succeeded, false otherwise
+         */
+        bool initialize(uint32_t workerCount);
+
+        /**
+         * @brief Stops and joins all worker threads
+         */
+        void shutdown();
+
+        /**
+         * @brief Submits a job
+         * @param job Job to run
+         * @param counter Optional counter incremented now and decremented when the job finishes
+         */
+        void submit(Job job, JobCounter *counter = nullptr);
+
+        /**
+         * @brief Submits a job that starts once another counter reaches zero
+         * @param dependency Counter the job depends on
+         * @param job Job to run
+         * @param counter Optional counter incremented now and decremented when the job finishes
+         *
+         * Waiting on counter also covers the time the job is held back.
+         */
+        void submitAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+
+        /**
+         * @brief Waits until all jobs of a counter have finished
+         * @param counter Counter to wait for
+         *
+         * The calling thread runs pending jobs while it waits.
+         */
+        void wait(const JobCounter &counter);
+
+        /**
+         * @brief Splits a range into chunks and processes them in parallel
+         * @tparam Func Callable taking (size_t begin, size_t end)
+         * @param count Number of items
+         * @param chunkSize Maximum number of items per chunk
+         * @param func Function called once per chunk
+         *
+         * Returns when every chunk has been processed.
+         */
+        template <typename Func>
+        void parallelFor(size_t count, size_t chunkSize, Func &&func)
+        {
+            chunkSize = std::max<size_t>(chunkSize, 1);
+            if (workers.empty() || count <= chunkSize)
+            {
+                if (count > 0)
+                {
+                    func(size_t(0), count);
+                }
+                return;
+            }
+
+            JobCounter counter;
+            for (size_t begin = 0; begin < count; begin += chunkSize)
+            {
+                size_t end = std::min(begin + chunkSize, count);
+                submit([&func, begin, end]()
+                       { func(begin, end); },
+                       &counter);
+            }
+
+            wait(counter);
+        }
+
+        /**
+         * @brief Processes a range in parallel with an automatic chunk size
+         * @tparam Func Callable taking (size_t begin, size_t end)
+         * @param count Number of items
+         * @param func Function called once per chunk
+         *
+         * Uses about four chunks per thread so that stealing can balance
+         * uneven chunks.
+         */
+        template <typename Func>
+        void parallelFor(size_t count, Func &&func)
+        {
+            size_t threads = workers.size() + 1;
+            parallelFor(count, (count + threads * 4 - 1) / (threads * 4), std::forward<Func>(func));
+        }
+
+        /**
+         * @brief Gets the number of worker threads
+         * @return Number of worker threads
+         */
+        uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+        /**
+         * @brief Gets a sensible default worker count for this machine
+         * @return Hardware thread count minus one for the main thread
+         */
+        static uint32_t getDefaultWorkerCount();
+
+        /**
+         * @brief Gets the worker index of the calling thread in this pool
+         * @return Worker index, or -1 if the thread is not a worker of this pool
+         */
+        int currentWorker() const;
+
+    private:
+        /**
+         * @brief Queued job
+         */
+        struct Task
+        {
+            /**
+             * @brief Job to run
+             */
+            Job job;
+
+            /**
+             * @brief Counter to decrement when the job finishes
+             */
+            JobCounter *counter;
+        };
+
+        /**
+         * @brief Worker thread state
+         */
+        struct Worker
+        {
+            /**
+             * @brief Mutex protecting the deque
+             */
+            std::mutex mutex;
+
+            /**
+             * @brief Jobs owned by the worker
+             */
+            std::deque<Task> tasks;
+
+            /**
+             * @brief Worker thread
+             */
+            std::thread thread;
+        };
+
+        /**
+         * @brief Queues a job whose counter has already been incremented
+         * @param task Job to queue
+         */
+        void enqueue(Task task);
+
+        /**
+         * @brief Main loop of a worker thread
+         * @param index Worker index
+         */
+        void workerLoop(uint32_t index);
+
+        /**
+         * @brief Takes one queued job and runs it
+         * @return True if a job was run, false if all queues were empty
+         */
+        bool runOne();
+
+        /**
+         * @brief Takes a job from the own deque, the injection queue or a victim
+         * @param task Receives the job
+         * @return True if a job was taken
+         */
+        bool takeTask(Task &task);
+
+        /**
+         * @brief Runs a job and signals its counter
+         * @param task Job to run
+         */
+        void execute(Task &task);
+
+        /**
+         * @brief Decrements a counter and releases its continuations at zero
+         * @param counter Counter to decrement
+         */
+        void release(JobCounter &counter);
+
+        /**
+         * @brief Worker threads
+         */
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        /**
+         * @brief Mutex protecting the injection queue
+         */
+        std::mutex injectMutex;
+
+        /**
+         * @brief Jobs submitted from threads outside the pool
+         */
+        std::deque<Task> injected;
+
+        /**
+         * @brief Mutex used to put idle workers to sleep
+         */
+        std::mutex sleepMutex;
+
+        /**
+         * @brief Signalled when jobs are queued or the pool stops
+         */
+        std::condition_variable wakeCondition;
+
+        /**
+         * @brief Number of queued jobs not yet taken by a thread
+         */
+        std::atomic<size_t> queuedCount;
+
+        /**
+         * @brief Flag that indicates if the workers should keep running
+         */
+        std::atomic<bool> running;
+    };
+
+} // namespace Engine
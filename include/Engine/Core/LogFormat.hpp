@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Engine
+{
+
+    /**
+     * @brief Type tag in front of every encoded log argument
+     */
+    enum class LogArgumentType : uint8_t
+    {
+        Bool,
+        Char,
+        Int,
+        UInt,
+        Float,
+        String,
+        Pointer
+    };
+
+    /**
+     * @brief Magic number at the start of a binary log file ("ELOG")
+     */
+    constexpr uint32_t LogFileMagic = 0x474F4C45u;
+
+    /**
+     * @brief Version of the binary log file layout
+     */
+    constexpr uint32_t LogFileVersion = 1;
+
+    /**
+     * @brief Kind of a record in a binary log file
+     *
+     * A Format record is written the first time a format string is used:
+     * uint32 id, uint32 length, then the characters. A Message record
+     * follows every log call: uint8 level, int64 microseconds since the
+     * epoch, uint32 format id, uint32 argument size, then the arguments as
+     * encoded by LogFormat::encode(). All values are little-endian.
+     */
+    enum class LogRecordKind : uint8_t
+    {
+        Format,
+        Message
+    };
+
+    /**
+     * @brief Encoding and formatting of log arguments
+     *
+     * Format strings use {} for the next argument and {{ and }} for literal
+     * braces. Arguments are first encoded into a compact byte string with a
+     * type tag each, which only copies them; the text is produced later by
+     * format(), on the writer thread or by offline tools reading a binary
+     * log.
+     */
+    namespace LogFormat
+    {
+        /**
+         * @brief Helper for static_assert in discarded if constexpr branches
+         */
+        template <typename>
+        inline constexpr bool AlwaysFalse = false;
+
+        /**
+         * @brief Appends a type tag and a fixed size value
+         * @param out Encoded arguments
+         * @param type Type tag
+         * @param value Value to append
+         */
+        template <typename T>
+        void appendScalar(std::string &out, LogArgumentType type, T value)
+        {
+            char bytes[1 + sizeof(T)];
+            bytes[0] = static_cast<char>(type);
+            std::memcpy(bytes + 1, &value, sizeof(T));
+            out.append(bytes, sizeof(bytes));
+        }
+
+        /**
+         * @brief Appends a string argument
+         * @param out Encoded arguments
+         * @param value String to append
+         */
+        inline void appendString(std::string &out, std::string_view value)
+        {
+            appendScalar(out, LogArgumentType::String, static_cast<uint32_t>(value.size()));
+            out.append(value.data(), value.size());
+        }
+
+        /**
+         * @brief Encodes one argument
+         * @param out Encoded arguments to append to
+         * @param value Argument: a number, bool, char, enum, string, or pointer
+         */
+        template <typename T>
+        void encode(std::string &out, const T &value)
+        {
+            using Decayed = std::decay_t<T>;
+            if constexpr (std::is_same_v<Decayed, bool>)
+            {
+                appendScalar(out, LogArgumentType::Bool, static_cast<uint8_t>(value));
+            }
+            else if constexpr (std::is_same_v<Decayed, char>)
+            {
+                appendScalar(out, LogArgumentType::Char, value);
+            }
+            else if constexpr (std::is_enum_v<Decayed>)
+            {
+                encode(out, static_cast<std::underlying_type_t<Decayed>>(value));
+            }
+            else if constexpr (std::is_integral_v<Decayed> && std::is_signed_v<Decayed>)
+            {
+                appendScalar(out, LogArgumentType::Int, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<Decayed>)
+            {
+                appendScalar(out, LogArgumentType::UInt, static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_floating_point_v<Decayed>)
+            {
+                appendScalar(out, LogArgumentType::Float, static_cast<double>(value));
+            }
+            else if constexpr ((std::is_same_v<Decayed, const char *> || std::is_same_v<Decayed, char *>) &&
+                               !std::is_array_v<T>)
+            {
+                appendString(out, value ? std::string_view(value) : std::string_view("(null)"));
+            }
+            else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+            {
+                appendString(out, std::string_view(value));
+            }
+            else if constexpr (std::is_pointer_v<Decayed>)
+            {
+                appendScalar(out, LogArgumentType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+            }
+            else
+            {
+                static_assert(AlwaysFalse<T>, "Log arguments must be numbers, strings, enums, or pointers");
+            }
+        }
+
+        /**
+         * @brief Formats a message from a format string and encoded arguments
+         * @param out Receives the message, appended to what it holds
+         * @param format Format string
+         * @param arguments Arguments encoded by encode()
+         * @return True if the arguments could be decoded, false if they are malformed
+         *
+         * Placeholders without an argument are kept as {}, and arguments
+         * without a placeholder are ignored.
+         */
+        bool format(std::string &out, const char *format, const std::string &arguments);
+    }
+
+} // namespace Engine
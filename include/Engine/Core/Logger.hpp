@@ -7,6 +7,29 @@
 #include <fstream>
 #include <mutex>
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+#include <unordered_map>
+
+#include "Engine/Core/LogFormat.hpp"
+#include "Engine/Core/MPSCQueue.hpp"
+
+/**
+ * @brief Lowest log level compiled in, from 0 (Trace) to 5 (Fatal)
+ *
+ * Logging calls below it compile to nothing. Defaults to Info in release
+ * builds, so Trace and Debug calls cost nothing there.
+ */
+#ifndef ENGINE_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define ENGINE_LOG_MIN_LEVEL 2
+#else
+#define ENGINE_LOG_MIN_LEVEL 0
+#endif
+#endif
 
 namespace Engine
 {
@@ -24,15 +47,71 @@ namespace Engine
         Fatal
     };
 
+    /**
+     * @brief What an asynchronous logger does when its queue is full
+     */
+    enum class LogOverflowPolicy
+    {
+        /**
+         * @brief Discard the message and report the number of dropped messages later
+         */
+        Drop,
+
+        /**
+         * @brief Wait until the writer thread has made room
+         */
+        Block
+    };
+
     /**
      * @brief Logger configuration
      */
     struct LoggerConfig
     {
-        LogLevel level;
-        bool logToConsole;
-        bool logToFile;
-        std::string logFilePath;
+        /**
+         * @brief Minimum log level
+         */
+        LogLevel level = LogLevel::Info;
+
+        /**
+         * @brief Write messages to the console
+         */
+        bool logToConsole = true;
+
+        /**
+         * @brief Write messages to logFilePath
+         */
+        bool logToFile = false;
+
+        /**
+         * @brief Path to the log file
+         */
+        std::string logFilePath = "engine.log";
+
+        /**
+         * @brief Write unformatted messages to binaryLogFilePath, for the LogDecoder tool
+         */
+        bool logToBinaryFile = false;
+
+        /**
+         * @brief Path to the binary log file
+         */
+        std::string binaryLogFilePath = "engine.binlog";
+
+        /**
+         * @brief Hand messages to a background writer thread instead of writing them on the calling thread
+         */
+        bool async = false;
+
+        /**
+         * @brief Number of messages the asynchronous queue holds, rounded up to a power of two
+         */
+        size_t queueCapacity = 8192;
+
+        /**
+         * @brief What to do with messages logged while the asynchronous queue is full
+         */
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block;
     };
 
     /**
@@ -55,6 +134,33 @@ namespace Engine
          * @param timestamp Timestamp
          */
         virtual void write(LogLevel level, const std::string &message, const std::string &timestamp) = 0;
+
+        /**
+         * @brief Checks if the sink takes unformatted messages through writeStructured()
+         * @return True for structured sinks, which never get write() calls
+         */
+        virtual bool isStructured() const { return false; }
+
+        /**
+         * @brief Writes an unformatted log message to the sink
+         * @param level Log level
+         * @param time Time the message was logged
+         * @param format Format string, a string literal that stays valid
+         * @param arguments Arguments encoded by LogFormat::encode()
+         */
+        virtual void writeStructured(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                                     const std::string &arguments)
+        {
+            (void)level;
+            (void)time;
+            (void)format;
+            (void)arguments;
+        }
+
+        /**
+         * @brief Writes buffered messages through to the destination
+         */
+        virtual void flush() {}
     };
 
     /**
@@ -75,6 +181,11 @@ namespace Engine
          * @param timestamp Timestamp
          */
         void write(LogLevel level, const std::string &message, const std::string &timestamp) override;
+
+        /**
+         * @brief Flushes the console output
+         */
+        void flush() override;
     };
 
     /**
@@ -102,17 +213,95 @@ namespace Engine
          */
         void write(LogLevel level, const std::string &message, const std::string &timestamp) override;
 
+        /**
+         * @brief Flushes the file
+         */
+        void flush() override;
+
+    private:
+        /**
+         * @brief Log file
+         */
+        std::ofstream file;
+    };
+
+    /**
+     * @brief Binary log sink
+     *
+     * Writes the format string and the encoded arguments of every message
+     * instead of its text, each format string once, in the layout described
+     * at LogRecordKind. Nothing is formatted while the engine runs; the
+     * LogDecoder tool turns the file into text.
+     */
+    class BinaryFileSink : public LogSink
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param filePath Path to the log file, which is overwritten
+         */
+        explicit BinaryFileSink(const std::string &filePath);
+
+        /**
+         * @brief Writes a formatted message as a message with the format "{}"
+         * @param level Log level
+         * @param message Log message
+         * @param timestamp Timestamp
+         */
+        void write(LogLevel level, const std::string &message, const std::string &timestamp) override;
+
+        /**
+         * @brief Structured sinks get every message through writeStructured()
+         * @return True
+         */
+        bool isStructured() const override { return true; }
+
+        /**
+         * @brief Writes a message record, and a format record for a new format string
+         * @param level Log level
+         * @param time Time the message was logged
+         * @param format Format string
+         * @param arguments Encoded arguments
+         */
+        void writeStructured(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                             const std::string &arguments) override;
+
+        /**
+         * @brief Flushes the file
+         */
+        void flush() override;
+
     private:
         /**
          * @brief Log file
          */
         std::ofstream file;
+
+        /**
+         * @brief Id of every format string written so far, by address
+         */
+        std::unordered_map<const char *, uint32_t> formatIds;
     };
 
     /**
      * @brief Static logger class
      *
      * The logger class provides static methods for logging messages at different levels.
+     *
+     * By default every message is formatted and written on the calling
+     * thread while holding a lock. In asynchronous mode, messages below the
+     * minimum level are filtered without any locking or formatting, and the
+     * rest are pushed into a lock-free queue that a background thread drains
+     * in batches, flushing the sinks once per batch. Sinks are only ever
+     * called with the sink lock held, so they do not need to be thread-safe,
+     * and they must not log themselves.
+     *
+     * The overloads taking a format string and arguments, such as
+     * info("Loaded texture: {}", name), check the level before doing
+     * anything and only copy the arguments into a thread-local buffer; the
+     * message is formatted once, by whoever writes it to the sinks. Format
+     * strings must be string literals, since the asynchronous queue and the
+     * binary sink keep their address.
      */
     class Logger
     {
@@ -131,9 +320,17 @@ namespace Engine
 
         /**
          * @brief Shuts down the logger
+         *
+         * Writes every queued message, flushes the sinks, and stops the
+         * writer thread.
          */
         static void shutdown();
 
+        /**
+         * @brief Waits until every message logged so far is written and flushes the sinks
+         */
+        static void flush();
+
         /**
          * @brief Sets the minimum log level
          * @param level Minimum log level
@@ -152,41 +349,177 @@ namespace Engine
          */
         static void addSink(std::unique_ptr<LogSink> sink);
 
+        /**
+         * @brief Checks if a level is compiled in
+         * @param level Log level
+         * @return True if the level is at least ENGINE_LOG_MIN_LEVEL
+         */
+        static constexpr bool isCompiledIn(LogLevel level) { return static_cast<int>(level) >= ENGINE_LOG_MIN_LEVEL; }
+
         /**
          * @brief Logs a trace message
          * @param message Message to log
          */
-        static void trace(const std::string &message);
+        static void trace(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Trace))
+            {
+                log(LogLevel::Trace, message);
+            }
+        }
+
+        /**
+         * @brief Logs a trace message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void trace(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Trace))
+            {
+                log(LogLevel::Trace, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs a debug message
          * @param message Message to log
          */
-        static void debug(const std::string &message);
+        static void debug(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Debug))
+            {
+                log(LogLevel::Debug, message);
+            }
+        }
+
+        /**
+         * @brief Logs a debug message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void debug(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Debug))
+            {
+                log(LogLevel::Debug, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs an info message
          * @param message Message to log
          */
-        static void info(const std::string &message);
+        static void info(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Info))
+            {
+                log(LogLevel::Info, message);
+            }
+        }
+
+        /**
+         * @brief Logs an info message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void info(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Info))
+            {
+                log(LogLevel::Info, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs a warning message
          * @param message Message to log
          */
-        static void warning(const std::string &message);
+        static void warning(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Warning))
+            {
+                log(LogLevel::Warning, message);
+            }
+        }
+
+        /**
+         * @brief Logs a warning message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void warning(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Warning))
+            {
+                log(LogLevel::Warning, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs an error message
          * @param message Message to log
          */
-        static void error(const std::string &message);
+        static void error(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Error))
+            {
+                log(LogLevel::Error, message);
+            }
+        }
+
+        /**
+         * @brief Logs an error message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void error(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Error))
+            {
+                log(LogLevel::Error, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs a fatal message
          * @param message Message to log
+         *
+         * Fatal messages are flushed before the call returns, also in
+         * asynchronous mode.
+         */
+        static void fatal(const std::string &message)
+        {
+            if constexpr (isCompiledIn(LogLevel::Fatal))
+            {
+                log(LogLevel::Fatal, message);
+            }
+        }
+
+        /**
+         * @brief Logs a fatal message from a format string
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
          */
-        static void fatal(const std::string &message);
+        template <typename Arg, typename... Args>
+        static void fatal(const char *format, const Arg &arg, const Args &...args)
+        {
+            if constexpr (isCompiledIn(LogLevel::Fatal))
+            {
+                log(LogLevel::Fatal, format, arg, args...);
+            }
+        }
 
         /**
          * @brief Logs a message with a specific level
@@ -195,7 +528,28 @@ namespace Engine
          */
         static void log(LogLevel level, const std::string &message);
 
-    private:
+        /**
+         * @brief Logs a message with a specific level from a format string
+         * @param level Log level
+         * @param format Format string with a {} per argument
+         * @param arg First argument
+         * @param args Other arguments
+         */
+        template <typename Arg, typename... Args>
+        static void log(LogLevel level, const char *format, const Arg &arg, const Args &...args)
+        {
+            if (!isCompiledIn(level) || level < minLevel.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            std::string &arguments = getArgumentBuffer();
+            arguments.clear();
+            LogFormat::encode(arguments, arg);
+            (LogFormat::encode(arguments, args), ...);
+            logStructured(level, format, arguments);
+        }
+
         /**
          * @brief Gets the string representation of a log level
          * @param level Log level
@@ -203,16 +557,111 @@ namespace Engine
          */
         static std::string levelToString(LogLevel level);
 
+    private:
+        /**
+         * @brief Message waiting in the asynchronous queue
+         */
+        struct Record
+        {
+            /**
+             * @brief Log level
+             */
+            LogLevel level = LogLevel::Info;
+
+            /**
+             * @brief Time the message was logged
+             */
+            std::chrono::system_clock::time_point time;
+
+            /**
+             * @brief Format string, nullptr if message is formatted already
+             */
+            const char *format = nullptr;
+
+            /**
+             * @brief Log message, or the encoded arguments of format
+             */
+            std::string message;
+        };
+
+        /**
+         * @brief Number of records the writer thread takes from the queue at once
+         */
+        static constexpr size_t BatchSize = 256;
+
+        /**
+         * @brief Gets the calling thread's buffer for encoded arguments
+         * @return Buffer, which keeps its capacity between calls
+         */
+        static std::string &getArgumentBuffer();
+
+        /**
+         * @brief Logs a message from a format string and encoded arguments
+         * @param level Log level, already checked against the minimum
+         * @param format Format string
+         * @param arguments Encoded arguments
+         */
+        static void logStructured(LogLevel level, const char *format, const std::string &arguments);
+
+        /**
+         * @brief Writes a message directly or pushes it into the asynchronous queue
+         * @param level Log level
+         * @param format Format string, nullptr if message is formatted already
+         * @param message Log message, or the encoded arguments of format
+         */
+        static void dispatch(LogLevel level, const char *format, const std::string &message);
+
+        /**
+         * @brief Pushes a message into the asynchronous queue
+         * @param level Log level
+         * @param time Time the message was logged
+         * @param format Format string, nullptr if message is formatted already
+         * @param message Log message, or the encoded arguments of format
+         */
+        static void enqueue(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                            const std::string &message);
+
+        /**
+         * @brief Writes a message to every sink, called with the mutex held
+         * @param level Log level
+         * @param time Time the message was logged
+         * @param format Format string, nullptr if message is formatted already
+         * @param message Log message, or the encoded arguments of format
+         */
+        static void writeToSinks(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                                 const std::string &message);
+
         /**
-         * @brief Gets the current timestamp
-         * @return Current timestamp
+         * @brief Flushes every sink, called with the mutex held
          */
-        static std::string getTimestamp();
+        static void flushSinks();
+
+        /**
+         * @brief Writes a warning if messages were dropped, called with the mutex held
+         */
+        static void reportDropped();
+
+        /**
+         * @brief Wakes the writer thread
+         */
+        static void wakeWriter();
+
+        /**
+         * @brief Main loop of the writer thread
+         */
+        static void writerMain();
+
+        /**
+         * @brief Formats a timestamp, called with the mutex held
+         * @param time Time to format
+         * @return Timestamp as YYYY-MM-DD HH:MM:SS.mmm
+         */
+        static std::string formatTimestamp(std::chrono::system_clock::time_point time);
 
         /**
          * @brief Minimum log level
          */
-        static LogLevel minLevel;
+        static std::atomic<LogLevel> minLevel;
 
         /**
          * @brief List of sinks
@@ -220,14 +669,77 @@ namespace Engine
         static std::vector<std::unique_ptr<LogSink>> sinks;
 
         /**
-         * @brief Mutex for thread-safe logging
+         * @brief Mutex guarding the sinks
          */
         static std::mutex mutex;
 
+        /**
+         * @brief Mutex serializing init() and shutdown()
+         */
+        static std::mutex stateMutex;
+
         /**
          * @brief Flag indicating if the logger is initialized
          */
-        static bool initialized;
+        static std::atomic<bool> initialized;
+
+        /**
+         * @brief Flag indicating if messages go through the queue
+         */
+        static std::atomic<bool> asyncEnabled;
+
+        /**
+         * @brief Overflow policy of the queue
+         */
+        static LogOverflowPolicy overflowPolicy;
+
+        /**
+         * @brief Queue of messages for the writer thread
+         *
+         * Kept alive after shutdown(), so a thread that is still logging
+         * while the logger shuts down cannot touch a freed queue.
+         */
+        static std::unique_ptr<MPSCQueue<Record>> queue;
+
+        /**
+         * @brief Writer thread
+         */
+        static std::thread writerThread;
+
+        /**
+         * @brief Flag keeping the writer thread running
+         */
+        static std::atomic<bool> writerRunning;
+
+        /**
+         * @brief Flag set while the writer thread waits for messages
+         */
+        static std::atomic<bool> writerSleeping;
+
+        /**
+         * @brief Mutex for the writer and flush conditions
+         */
+        static std::mutex wakeMutex;
+
+        /**
+         * @brief Condition the writer thread waits on for new messages
+         */
+        static std::condition_variable wakeCondition;
+
+        /**
+         * @brief Condition flush() waits on for written messages
+         */
+        static std::condition_variable flushCondition;
+
+        /**
+         * @brief Number of records the writer thread has written, guarded by wakeMutex
+         */
+        static uint64_t writtenCount;
+
+        /**
+         * @brief Number of messages dropped since the last report
+         */
+        static std::atomic<uint64_t> droppedCount;
     };
 
 } // namespace Engine
\ No newline at end of file
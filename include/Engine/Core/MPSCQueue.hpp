@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Engine
+{
+
+    /**
+     * @brief Bounded lock-free queue with many producers and one consumer
+     *
+     * A ring of cells that each carry a sequence number, after Dmitry
+     * Vyukov's bounded queue. Producers claim a cell with one compare and
+     * swap on the enqueue position and publish it by advancing its sequence;
+     * the consumer only ever touches the cell at its own position, so it
+     * needs no atomic read-modify-write at all. Neither side blocks or
+     * allocates: a full queue makes tryPush() fail and leaves the choice of
+     * retrying or dropping to the caller.
+     *
+     * @tparam T Element type, must be default constructible and movable
+     */
+    template <typename T>
+    class MPSCQueue
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity Number of elements, rounded up to a power of two
+         */
+        explicit MPSCQueue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+
+            cells.reset(new Cell[size]);
+            mask = size - 1;
+            for (size_t i = 0; i < size; ++i)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            enqueuePosition.store(0, std::memory_order_relaxed);
+        }
+
+        MPSCQueue(const MPSCQueue &) = delete;
+        MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+        /**
+         * @brief Appends an element, callable from any thread
+         * @param value Element, only moved from if the push succeeds
+         * @return True if the element was queued, false if the queue is full
+         */
+        bool tryPush(T &&value)
+        {
+            return tryPushWith([&value](T &cell)
+                               { cell = std::move(value); });
+        }
+
+        /**
+         * @brief Appends an element by filling a cell in place, callable from any thread
+         * @param fill Called with the claimed cell, which still holds an element popped earlier
+         * @return True if the element was queued, false if the queue is full
+         *
+         * Assigning into the old element instead of moving a new one in lets
+         * elements that own buffers reuse them.
+         */
+        template <typename Fill>
+        bool tryPushWith(Fill &&fill)
+        {
+            Cell *cell;
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &cells[position & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (difference == 0)
+                {
+                    // The cell is free for this position, try to claim it
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The consumer has not freed the cell of the last lap yet
+                    return false;
+                }
+                else
+                {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(cell->value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest element, callable from the consumer thread only
+         * @param value Receives the element; its old contents are swapped into the cell for tryPushWith() to reuse
+         * @return True if an element was removed, false if the queue is empty
+         */
+        bool tryPop(T &value)
+        {
+            Cell &cell = cells[dequeuePosition & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+            {
+                return false;
+            }
+
+            using std::swap;
+            swap(value, cell.value);
+            cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+            ++dequeuePosition;
+            return true;
+        }
+
+        /**
+         * @brief Checks if the next element is ready, callable from the consumer thread only
+         * @return True if tryPop() would fail
+         */
+        bool isEmpty() const
+        {
+            return cells[dequeuePosition & mask].sequence.load(std::memory_order_acquire) != dequeuePosition + 1;
+        }
+
+        /**
+         * @brief Gets the number of elements the queue holds
+         * @return Capacity
+         */
+        size_t getCapacity() const { return mask + 1; }
+
+        /**
+         * @brief Gets the number of successful pushes so far
+         * @return Pushes, including ones that are not published yet
+         *
+         * Elements are popped in the order their pushes were counted, so once
+         * the consumer has popped this many elements every push made before
+         * the call has been consumed.
+         */
+        uint64_t getPushCount() const { return enqueuePosition.load(std::memory_order_acquire); }
+
+    private:
+        /**
+         * @brief Ring cell
+         */
+        struct Cell
+        {
+            /**
+             * @brief Position the cell is ready for; position + 1 once it holds that position's element
+             */
+            std::atomic<size_t> sequence;
+
+            /**
+             * @brief Element
+             */
+            T value;
+        };
+
+        /**
+         * @brief Ring of cells
+         */
+        std::unique_ptr<Cell[]> cells;
+
+        /**
+         * @brief Capacity minus one
+         */
+        size_t mask = 0;
+
+        /**
+         * @brief Next position to push, shared by the producers
+         */
+        alignas(64) std::atomic<size_t> enqueuePosition;
+
+        /**
+         * @brief Next position to pop, owned by the consumer
+         */
+        alignas(64) size_t dequeuePosition = 0;
+    };
+
+} // namespace Engine
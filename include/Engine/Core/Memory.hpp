@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine
+{
+
+    /**
+     * @brief Subsystem an allocation is counted against
+     */
+    enum class MemoryTag : uint8_t
+    {
+        General,
+        Frame,
+        ECS,
+        Scene,
+        Renderer,
+        Resources,
+        Physics,
+        Audio,
+        Input,
+        Logger,
+        Count
+    };
+
+    /**
+     * @brief Allocation counters of one memory tag
+     */
+    struct MemoryTagStats
+    {
+        /**
+         * @brief Number of allocations
+         */
+        uint64_t allocations = 0;
+
+        /**
+         * @brief Number of frees
+         */
+        uint64_t frees = 0;
+
+        /**
+         * @brief Total number of bytes allocated
+         */
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief Heap allocation entry point and per-subsystem allocation counters
+     *
+     * The engine allocators (FrameArena, ObjectPool, the component pool pages)
+     * take their blocks from allocate() and count them against their own tag.
+     * When the engine is built with ENGINE_TRACK_ALLOCATIONS, every call of the
+     * global operator new is counted as well, against the tag of the innermost
+     * MemoryScope on the calling thread. A frame in steady state should then
+     * show no allocations at all in getFrameStats().
+     */
+    class Memory
+    {
+    public:
+        /**
+         * @brief Allocates memory counted against a tag
+         * @param size Size in bytes
+         * @param alignment Alignment in bytes, a power of two
+         * @param tag Tag to count the allocation against
+         * @return Pointer to the memory, or nullptr if the allocation failed
+         */
+        static void *allocate(size_t size, size_t alignment, MemoryTag tag);
+
+        /**
+         * @brief Frees memory returned by allocate()
+         * @param pointer Pointer to the memory, may be nullptr
+         * @param tag Tag the memory was allocated with
+         */
+        static void deallocate(void *pointer, MemoryTag tag);
+
+        /**
+         * @brief Counts an allocation made outside allocate()
+         * @param tag Tag to count the allocation against
+         * @param size Size in bytes
+         */
+        static void recordAllocation(MemoryTag tag, size_t size);
+
+        /**
+         * @brief Counts a free made outside deallocate()
+         * @param tag Tag the memory was counted against
+         */
+        static void recordFree(MemoryTag tag);
+
+        /**
+         * @brief Gets the counters of a tag since the program started
+         * @param tag Memory tag
+         * @return Counters of the tag
+         */
+        static MemoryTagStats getStats(MemoryTag tag);
+
+        /**
+         * @brief Gets the counters of a tag since the last beginFrame()
+         * @param tag Memory tag
+         * @return Counters of the tag in the current frame
+         */
+        static MemoryTagStats getFrameStats(MemoryTag tag);
+
+        /**
+         * @brief Gets the number of allocations of every tag since the last beginFrame()
+         * @return Number of allocations in the current frame
+         */
+        static uint64_t getFrameAllocationCount();
+
+        /**
+         * @brief Starts counting a new frame
+         *
+         * Called by the engine at the start of every frame, from the main thread.
+         */
+        static void beginFrame();
+
+        /**
+         * @brief Gets the tag allocations of the calling thread are counted against
+         * @return Current tag of the calling thread
+         */
+        static MemoryTag getCurrentTag();
+
+        /**
+         * @brief Sets the tag allocations of the calling thread are counted against
+         * @param tag New tag
+         * @return Previous tag
+         */
+        static MemoryTag setCurrentTag(MemoryTag tag);
+
+        /**
+         * @brief Checks if global operator new calls are counted
+         * @return True if the engine was built with ENGINE_TRACK_ALLOCATIONS
+         */
+        static bool isTrackingHeap();
+
+        /**
+         * @brief Gets the display name of a tag
+         * @param tag Memory tag
+         * @return Name of the tag
+         */
+        static const char *getTagName(MemoryTag tag);
+
+    private:
+        /**
+         * @brief Live counters of one tag
+         */
+        struct Counters
+        {
+            std::atomic<uint64_t> allocations{0};
+            std::atomic<uint64_t> frees{0};
+            std::atomic<uint64_t> bytes{0};
+        };
+
+        /**
+         * @brief Counters of every tag
+         */
+        static Counters counters[static_cast<size_t>(MemoryTag::Count)];
+
+        /**
+         * @brief Counter values at the last beginFrame()
+         */
+        static MemoryTagStats frameStart[static_cast<size_t>(MemoryTag::Count)];
+    };
+
+    /**
+     * @brief Counts the allocations of the calling thread against a tag while in scope
+     *
+     * Scopes nest; the previous tag is restored when the scope ends.
+     */
+    class MemoryScope
+    {
+    public:
+        /**
+         * @brief Makes a tag the current one of the calling thread
+         * @param tag Tag to count allocations against
+         */
+        explicit MemoryScope(MemoryTag tag) : previous(Memory::setCurrentTag(tag)) {}
+
+        /**
+         * @brief Restores the previous tag
+         */
+        ~MemoryScope() { Memory::setCurrentTag(previous); }
+
+        MemoryScope(const MemoryScope &) = delete;
+        MemoryScope &operator=(const MemoryScope &) = delete;
+
+    private:
+        /**
+         * @brief Tag that was current before this scope
+         */
+        MemoryTag previous;
+    };
+
+} // namespace Engine
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Memory.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Fixed-size allocator for objects of one type
+     * @tparam T Object type
+     *
+     * Objects live in chunks of ChunkSize slots that are never moved, and
+     * destroyed slots are kept on a free list for the next create(), so a
+     * pool that has reached its working size no longer touches the heap.
+     * The pool is not thread-safe.
+     */
+    template <typename T>
+    class ObjectPool
+    {
+    public:
+        /**
+         * @brief Number of objects per chunk
+         */
+        static constexpr size_t ChunkSize = 256;
+
+        /**
+         * @brief Constructor
+         * @param tag Tag the chunks are counted against
+         */
+        explicit ObjectPool(MemoryTag tag = MemoryTag::General)
+            : freeList(nullptr),
+              liveCount(0),
+              tag(tag)
+        {
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Frees the chunks without destroying objects that are still alive.
+         */
+        ~ObjectPool()
+        {
+            clear();
+        }
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        /**
+         * @brief Constructs an object in a free slot
+         * @tparam Args Constructor argument types
+         * @param args Constructor arguments
+         * @return Pointer to the object, or nullptr if the heap is exhausted
+         */
+        template <typename... Args>
+        T *create(Args &&...args)
+        {
+            if (!freeList && !grow())
+            {
+                return nullptr;
+            }
+
+            Slot *slot = freeList;
+            freeList = slot->next;
+
+            T *object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++liveCount;
+            return object;
+        }
+
+        /**
+         * @brief Destroys an object and returns its slot to the pool
+         * @param object Object created by this pool, may be nullptr
+         */
+        void destroy(T *object)
+        {
+            if (!object)
+            {
+                return;
+            }
+
+            object->~T();
+
+            Slot *slot = reinterpret_cast<Slot *>(object);
+            slot->next = freeList;
+            freeList = slot;
+            --liveCount;
+        }
+
+        /**
+         * @brief Frees every chunk
+         *
+         * Objects that are still alive are not destroyed; destroy them first.
+         */
+        void clear()
+        {
+            for (Slot *chunk : chunks)
+            {
+                Memory::deallocate(chunk, tag);
+            }
+
+            chunks.clear();
+            freeList = nullptr;
+            liveCount = 0;
+        }
+
+        /**
+         * @brief Gets the number of live objects
+         * @return Number of objects
+         */
+        size_t size() const { return liveCount; }
+
+        /**
+         * @brief Gets the number of slots in all chunks
+         * @return Number of slots
+         */
+        size_t capacity() const { return chunks.size() * ChunkSize; }
+
+    private:
+        /**
+         * @brief Storage for one object, or the link to the next free slot
+         */
+        union Slot
+        {
+            Slot *next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        /**
+         * @brief Allocates a chunk and puts its slots on the free list
+         * @return True if the chunk was allocated
+         */
+        bool grow()
+        {
+            Slot *chunk = static_cast<Slot *>(Memory::allocate(sizeof(Slot) * ChunkSize, alignof(Slot), tag));
+            if (!chunk)
+            {
+                return false;
+            }
+
+            // Link the slots in address order so new objects fill the chunk front to back
+            for (size_t i = ChunkSize; i-- > 0;)
+            {
+                chunk[i].next = freeList;
+                freeList = &chunk[i];
+            }
+
+            chunks.push_back(chunk);
+            return true;
+        }
+
+        /**
+         * @brief Chunks of ChunkSize slots
+         */
+        std::vector<Slot *> chunks;
+
+        /**
+         * @brief First free slot
+         */
+        Slot *freeList;
+
+        /**
+         * @brief Number of live objects
+         */
+        size_t liveCount;
+
+        /**
+         * @brief Tag the chunks are counted against
+         */
+        MemoryTag tag;
+    };
+
+} // namespace Engine
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Records a profiler zone from here to the end of the enclosing scope
+ *
+ * Takes a string literal, or a std::string that is interned while a
+ * capture is running. Compiles to nothing with ENGINE_NO_PROFILER.
+ */
+#ifndef ENGINE_NO_PROFILER
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+#define ENGINE_PROFILE_SCOPE(name) ::Engine::ProfileScope ENGINE_PROFILE_CONCAT(profileScope, __COUNTER__)(name)
+#else
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+/**
+ * @brief Records a profiler zone named after the enclosing function
+ */
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+
+namespace Engine
+{
+
+    /**
+     * @brief Hierarchical CPU profiler
+     *
+     * While a capture runs, every ENGINE_PROFILE_SCOPE records a zone with
+     * its start time, end time, and nesting depth into a buffer owned by the
+     * calling thread. Recording takes no locks: the owner appends to its
+     * buffer and publishes the new event count, which the exporter can read
+     * at any time. Outside a capture a zone costs one relaxed atomic load.
+     *
+     * Captures are written in the Chrome trace event format, which
+     * chrome://tracing and Perfetto open directly and Tracy reads through its
+     * import-chrome tool. Zone names must live as long as the profiler: use
+     * string literals, or pass a std::string to have it interned.
+     */
+    class Profiler
+    {
+    public:
+        /**
+         * @brief Starts a capture, discarding the events of the previous one
+         */
+        static void start();
+
+        /**
+         * @brief Stops the capture, keeping its events for export
+         */
+        static void stop();
+
+        /**
+         * @brief Checks if a capture is running
+         * @return True while zones are being recorded
+         */
+        static bool isRecording() { return recording.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Names the calling thread in exported traces
+         * @param name Thread name
+         */
+        static void setThreadName(const std::string &name);
+
+        /**
+         * @brief Gets a copy of a name that stays valid until the program exits
+         * @param name Zone name
+         * @return Interned name, the same pointer for equal names
+         */
+        static const char *intern(const std::string &name);
+
+        /**
+         * @brief Writes the events of the last capture as a Chrome trace
+         * @param filepath Path to the JSON file
+         * @return True if the file was written, false otherwise
+         *
+         * May be called during a capture, but not concurrently with start().
+         */
+        static bool writeChromeTrace(const std::string &filepath);
+
+        /**
+         * @brief Gets the number of events recorded in the current or last capture
+         * @return Number of events over all threads
+         */
+        static size_t getEventCount();
+
+        /**
+         * @brief Records a zone that was timed elsewhere, such as on the GPU
+         * @param track Name of the track the zone is shown on, a string literal
+         * @param name Zone name, a string literal
+         * @param start Start time in nanoseconds on the clock of now()
+         * @param end End time in nanoseconds on the clock of now()
+         *
+         * Each track is its own timeline in exported traces. A track must
+         * only be recorded from one thread at a time.
+         */
+        static void recordZone(const char *track, const char *name, uint64_t start, uint64_t end);
+
+        /**
+         * @brief Gets the current time
+         * @return Nanoseconds on the steady clock
+         */
+        static uint64_t now();
+
+    private:
+        friend class ProfileScope;
+
+        /**
+         * @brief Event buffer of one thread
+         */
+        struct ThreadBuffer;
+
+        /**
+         * @brief Gets the calling thread's buffer, registering it on first use
+         * @return Thread buffer
+         */
+        static ThreadBuffer &getThreadBuffer();
+
+        /**
+         * @brief Resets a buffer the first time it records in a capture
+         * @param buffer Buffer of the calling thread or track
+         * @param current Number of the running capture
+         */
+        static void prepareBuffer(ThreadBuffer &buffer, uint32_t current);
+
+        /**
+         * @brief Appends a zone to a buffer, dropping it if the buffer is full
+         * @param buffer Buffer of the calling thread or track
+         * @param name Zone name
+         * @param start Start time in nanoseconds
+         * @param end End time in nanoseconds
+         * @param depth Nesting depth
+         */
+        static void append(ThreadBuffer &buffer, const char *name, uint64_t start, uint64_t end, uint32_t depth);
+
+        /**
+         * @brief Flag set while a capture runs
+         */
+        static std::atomic<bool> recording;
+
+        /**
+         * @brief Number of the current capture, bumped by start()
+         */
+        static std::atomic<uint32_t> generation;
+
+        /**
+         * @brief Time the current capture started
+         */
+        static std::atomic<uint64_t> startTime;
+
+        /**
+         * @brief Buffers of every thread that recorded a zone, kept until exit
+         */
+        static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        /**
+         * @brief Interned names
+         */
+        static std::unordered_set<std::string> names;
+
+        /**
+         * @brief Buffers of the tracks recorded through recordZone(), by track name
+         */
+        static std::unordered_map<std::string, ThreadBuffer *> tracks;
+
+        /**
+         * @brief Mutex guarding the buffer list, thread names, tracks, and interned names
+         */
+        static std::mutex mutex;
+    };
+
+    /**
+     * @brief Zone recorded from construction to destruction
+     *
+     * Use through ENGINE_PROFILE_SCOPE rather than directly.
+     */
+    class ProfileScope
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param name Zone name, a string literal
+         */
+        explicit ProfileScope(const char *name) : name(name)
+        {
+            if (Profiler::isRecording())
+            {
+                begin();
+            }
+        }
+
+        /**
+         * @brief Constructor
+         * @param name Zone name, interned if a capture is running
+         */
+        explicit ProfileScope(const std::string &name) : name(nullptr)
+        {
+            if (Profiler::isRecording())
+            {
+                this->name = Profiler::intern(name);
+                begin();
+            }
+        }
+
+        /**
+         * @brief Destructor, records the zone
+         */
+        ~ProfileScope()
+        {
+            if (buffer)
+            {
+                end();
+            }
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        /**
+         * @brief Starts the zone
+         */
+        void begin();
+
+        /**
+         * @brief Ends the zone and appends it to the thread's buffer
+         */
+        void end();
+
+        /**
+         * @brief Zone name
+         */
+        const char *name;
+
+        /**
+         * @brief Buffer of the thread, nullptr if the zone is not recorded
+         */
+        Profiler::ThreadBuffer *buffer = nullptr;
+
+        /**
+         * @brief Start time in nanoseconds
+         */
+        uint64_t startTime = 0;
+
+        /**
+         * @brief Capture the zone started in
+         */
+        uint32_t generation = 0;
+
+        /**
+         * @brief Nesting depth of the zone
+         */
+        uint32_t depth = 0;
+    };
+
+} // namespace Engine
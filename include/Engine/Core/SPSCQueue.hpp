@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Engine
+{
+
+    /**
+     * @brief Bounded lock-free queue with one producer and one consumer
+     *
+     * A ring indexed by two ever-increasing positions. Each side owns one of
+     * them and only reads the other, so a push or pop is a load and a store
+     * without any read-modify-write. Each side also keeps a cached copy of
+     * the other side's position and only reloads it when the ring looks full
+     * or empty, which keeps the two cache lines from bouncing on every call.
+     * Neither side blocks or allocates; a full queue makes tryPush() fail.
+     *
+     * @tparam T Element type, must be default constructible and movable
+     */
+    template <typename T>
+    class SPSCQueue
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity Number of elements, rounded up to a power of two
+         */
+        explicit SPSCQueue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+
+            elements.reset(new T[size]);
+            mask = size - 1;
+        }
+
+        SPSCQueue(const SPSCQueue &) = delete;
+        SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+        /**
+         * @brief Appends an element, callable from the producer thread only
+         * @param value Element, only moved from if the push succeeds
+         * @return True if the element was queued, false if the queue is full
+         */
+        bool tryPush(T &&value)
+        {
+            size_t position = writePosition.load(std::memory_order_relaxed);
+            if (position - cachedReadPosition > mask)
+            {
+                cachedReadPosition = readPosition.load(std::memory_order_acquire);
+                if (position - cachedReadPosition > mask)
+                {
+                    return false;
+                }
+            }
+
+            elements[position & mask] = std::move(value);
+            writePosition.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Appends a copy of an element, callable from the producer thread only
+         * @param value Element
+         * @return True if the element was queued, false if the queue is full
+         */
+        bool tryPush(const T &value)
+        {
+            T copy = value;
+            return tryPush(std::move(copy));
+        }
+
+        /**
+         * @brief Removes the oldest element, callable from the consumer thread only
+         * @param value Receives the element
+         * @return True if an element was removed, false if the queue is empty
+         */
+        bool tryPop(T &value)
+        {
+            size_t position = readPosition.load(std::memory_order_relaxed);
+            if (position == cachedWritePosition)
+            {
+                cachedWritePosition = writePosition.load(std::memory_order_acquire);
+                if (position == cachedWritePosition)
+                {
+                    return false;
+                }
+            }
+
+            value = std::move(elements[position & mask]);
+            readPosition.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks if the queue holds no element, callable from the consumer thread only
+         * @return True if tryPop() would fail
+         */
+        bool isEmpty() const
+        {
+            return readPosition.load(std::memory_order_relaxed) == writePosition.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Gets the number of elements the queue holds
+         * @return Capacity
+         */
+        size_t getCapacity() const { return mask + 1; }
+
+    private:
+        /**
+         * @brief Ring of elements
+         */
+        std::unique_ptr<T[]> elements;
+
+        /**
+         * @brief Capacity minus one
+         */
+        size_t mask = 0;
+
+        /**
+         * @brief Next position to push, written by the producer
+         */
+        alignas(64) std::atomic<size_t> writePosition{0};
+
+        /**
+         * @brief Producer's copy of readPosition
+         */
+        size_t cachedReadPosition = 0;
+
+        /**
+         * @brief Next position to pop, written by the consumer
+         */
+        alignas(64) std::atomic<size_t> readPosition{0};
+
+        /**
+         * @brief Consumer's copy of writePosition
+         */
+        size_t cachedWritePosition = 0;
+    };
+
+} // namespace Engine
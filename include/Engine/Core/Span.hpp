@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Non-owning view of a contiguous range of elements
+     *
+     * A subset of C++20 std::span, so functions can take vectors, arrays, or
+     * pointer and count pairs without copying them into a vector first. The
+     * viewed memory has to outlive the span.
+     *
+     * @tparam T Element type, const for a read-only view
+     */
+    template <typename T>
+    class Span
+    {
+    public:
+        /**
+         * @brief Constructor, creates an empty span
+         */
+        Span() : pointer(nullptr), count(0) {}
+
+        /**
+         * @brief Constructor
+         * @param data First element
+         * @param size Number of elements
+         */
+        Span(T *data, size_t size) : pointer(data), count(size) {}
+
+        /**
+         * @brief Constructor, views the elements of a vector
+         * @param vector Vector to view
+         */
+        Span(std::vector<std::remove_const_t<T>> &vector) : pointer(vector.data()), count(vector.size()) {}
+
+        /**
+         * @brief Constructor, views the elements of a vector as read-only
+         * @param vector Vector to view
+         */
+        template <typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+        Span(const std::vector<std::remove_const_t<T>> &vector) : pointer(vector.data()), count(vector.size())
+        {
+        }
+
+        /**
+         * @brief Constructor, views the elements of an array
+         * @param array Array to view
+         */
+        template <size_t N>
+        Span(T (&array)[N]) : pointer(array), count(N)
+        {
+        }
+
+        /**
+         * @brief Gets the first element
+         * @return Pointer to the elements, nullptr if the span is empty
+         */
+        T *data() const { return pointer; }
+
+        /**
+         * @brief Gets the number of elements
+         * @return Number of elements
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the span has no elements
+         * @return True if the size is 0
+         */
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Gets an element
+         * @param index Index of the element, less than size()
+         * @return Reference to the element
+         */
+        T &operator[](size_t index) const { return pointer[index]; }
+
+        /**
+         * @brief Iterators over the elements
+         */
+        T *begin() const { return pointer; }
+        T *end() const { return pointer + count; }
+
+        /**
+         * @brief Gets a part of the span
+         * @param offset First element of the part
+         * @param size Number of elements in the part
+         * @return Span over the part, clamped to this span
+         */
+        Span subspan(size_t offset, size_t size) const
+        {
+            offset = offset < count ? offset : count;
+            return Span(pointer + offset, size < count - offset ? size : count - offset);
+        }
+
+    private:
+        /**
+         * @brief First element
+         */
+        T *pointer;
+
+        /**
+         * @brief Number of elements
+         */
+        size_t count;
+    };
+
+} // namespace Engine
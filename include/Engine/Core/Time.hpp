@@ -1,12 +1,26 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <vector>
-#include <functional>
+
+#include "Engine/Core/InplaceFunction.hpp"
 
 namespace Engine
 {
 
+    class JobSystem;
+
+    /**
+     * @brief Callback of a timer, stored inside the timer without allocating
+     */
+    using TimerCallback = InplaceFunction<void()>;
+
+    /**
+     * @brief Handle of a timer, 0 is never a valid timer
+     */
+    using TimerId = uint64_t;
+
     /**
      * @brief Time management class
      *
@@ -60,41 +74,219 @@ namespace Engine
          */
         float getFPS() const { return fps; }
 
+        /**
+         * @brief Sets the fixed simulation timestep
+         * @param step Timestep in seconds
+         */
+        void setFixedTimestep(float step);
+
+        /**
+         * @brief Gets the fixed simulation timestep
+         * @return Timestep in seconds
+         */
+        float getFixedTimestep() const { return fixedTimestep; }
+
+        /**
+         * @brief Sets the maximum number of fixed steps per frame
+         * @param steps Maximum step count
+         *
+         * Time beyond this many steps is dropped, so a slow frame slows the
+         * simulation down instead of making the next frame even slower.
+         */
+        void setMaxFixedSteps(int steps) { maxFixedSteps = steps > 0 ? steps : 1; }
+
+        /**
+         * @brief Gets the number of fixed steps to run this frame
+         * @return Fixed step count determined by the last update
+         */
+        int getFixedStepCount() const { return fixedStepCount; }
+
+        /**
+         * @brief Gets how far the frame is between the last two fixed steps
+         * @return Interpolation factor (0.0 to 1.0)
+         */
+        float getInterpolationAlpha() const { return fixedAccumulator / fixedTimestep; }
+
         /**
          * @brief Creates a timer that executes a callback after a specified time
          * @param callback Function to call when the timer expires
          * @param delay Delay in seconds
          * @param repeat True if the timer should repeat, false otherwise
-         * @return Timer ID
+         * @param parallel True to run the callback on the job system together
+         *                 with the other parallel timers that expire in the same update
+         * @return Timer ID, or 0 if the callback is empty
+         *
+         * A timer expires at the first update after its delay has passed, never
+         * in the update that runs the callback creating it. Parallel callbacks
+         * may run on any thread and must not create or cancel timers.
          */
-        uint32_t createTimer(std::function<void()> callback, float delay, bool repeat = false);
+        TimerId createTimer(TimerCallback callback, float delay, bool repeat = false, bool parallel = false);
 
         /**
          * @brief Cancels a timer
          * @param id Timer ID
          * @return True if the timer was cancelled, false if it doesn't exist
          */
-        bool cancelTimer(uint32_t id);
+        bool cancelTimer(TimerId id);
+
+        /**
+         * @brief Checks if a timer is still scheduled
+         * @param id Timer ID
+         * @return True if the timer has neither expired nor been cancelled
+         */
+        bool isTimerActive(TimerId id) const;
+
+        /**
+         * @brief Gets the number of scheduled timers
+         * @return Number of timers
+         */
+        size_t getTimerCount() const { return activeTimerCount; }
+
+        /**
+         * @brief Sets the job system parallel timers run on
+         * @param jobSystem Job system, or nullptr to run every timer on the updating thread
+         */
+        void setJobSystem(JobSystem *jobSystem) { jobs = jobSystem; }
 
     private:
         /**
-         * @brief Timer structure
+         * @brief State of one timer slot
+         */
+        struct TimerSlot
+        {
+            /**
+             * @brief Callback, moved out while the timer fires
+             */
+            TimerCallback callback;
+
+            /**
+             * @brief Delay and repeat interval in seconds
+             */
+            double interval = 0.0;
+
+            /**
+             * @brief Generation of the slot, part of the timer ID
+             */
+            uint32_t generation = 1;
+
+            /**
+             * @brief True while the slot holds a timer
+             */
+            bool active = false;
+
+            /**
+             * @brief True if the timer repeats
+             */
+            bool repeat = false;
+
+            /**
+             * @brief True if the callback runs on the job system
+             */
+            bool parallel = false;
+        };
+
+        /**
+         * @brief Scheduled expiry of a timer in the heap
          */
-        struct Timer
+        struct TimerEntry
         {
-            uint32_t id;
-            float delay;
-            float timeLeft;
-            bool repeat;
-            std::function<void()> callback;
+            /**
+             * @brief Timer time at which the timer expires
+             */
+            double expiry;
+
+            /**
+             * @brief Order of scheduling, breaks ties between equal expiries
+             */
+            uint64_t sequence;
+
+            /**
+             * @brief Timer slot index
+             */
+            uint32_t slot;
+
+            /**
+             * @brief Slot generation the entry was scheduled for; stale once it differs
+             */
+            uint32_t generation;
         };
 
         /**
-         * @brief Updates all timers
+         * @brief Timer that expired in the current update
+         */
+        struct DueTimer
+        {
+            /**
+             * @brief Callback taken from the slot
+             */
+            TimerCallback callback;
+
+            /**
+             * @brief Timer time at which the timer expired
+             */
+            double expiry;
+
+            /**
+             * @brief Timer slot index
+             */
+            uint32_t slot;
+
+            /**
+             * @brief Slot generation when the timer expired
+             */
+            uint32_t generation;
+        };
+
+        /**
+         * @brief Runs the callbacks of all expired timers
          * @param deltaTime Time elapsed since the last update
+         *
+         * Only timers at the top of the heap are looked at, so the cost depends
+         * on the number of expired timers rather than on the number of timers.
          */
         void updateTimers(float deltaTime);
 
+        /**
+         * @brief Schedules a timer slot
+         * @param slot Timer slot index
+         * @param expiry Timer time at which the timer expires
+         */
+        void scheduleTimer(uint32_t slot, double expiry);
+
+        /**
+         * @brief Calls the callback of an expired timer and logs exceptions
+         * @param timer Expired timer
+         */
+        static void runTimer(DueTimer &timer);
+
+        /**
+         * @brief Reschedules a repeating timer after it fired, or frees its slot
+         * @param timer Timer that fired
+         */
+        void finishTimer(DueTimer &timer);
+
+        /**
+         * @brief Frees a timer slot and invalidates its ID
+         * @param slot Timer slot index
+         */
+        void releaseTimer(uint32_t slot);
+
+        /**
+         * @brief Checks if an expired or scheduled timer still refers to a live timer
+         * @param slot Timer slot index
+         * @param generation Generation the timer was scheduled with
+         * @return True if the timer was not cancelled
+         */
+        bool isCurrent(uint32_t slot, uint32_t generation) const;
+
+        /**
+         * @brief Orders the heap so the earliest expiry is at the front
+         * @param a First entry
+         * @param b Second entry
+         * @return True if a expires after b
+         */
+        static bool expiresLater(const TimerEntry &a, const TimerEntry &b);
+
         /**
          * @brief Clock type
          */
@@ -146,14 +338,69 @@ namespace Engine
         uint32_t fpsFrameAccumulator;
 
         /**
-         * @brief List of active timers
+         * @brief Fixed simulation timestep in seconds
+         */
+        float fixedTimestep;
+
+        /**
+         * @brief Frame time not yet consumed by fixed steps
+         */
+        float fixedAccumulator;
+
+        /**
+         * @brief Maximum number of fixed steps per frame
+         */
+        int maxFixedSteps;
+
+        /**
+         * @brief Number of fixed steps to run this frame
+         */
+        int fixedStepCount;
+
+        /**
+         * @brief Timer slots indexed by the low half of the timer ID
+         */
+        std::vector<TimerSlot> timerSlots;
+
+        /**
+         * @brief Indices of free timer slots
+         */
+        std::vector<uint32_t> freeTimerSlots;
+
+        /**
+         * @brief Min-heap of scheduled expiries, cancelled timers leave stale entries
+         */
+        std::vector<TimerEntry> timerHeap;
+
+        /**
+         * @brief Expired timers of the current update that run on the updating thread
+         */
+        std::vector<DueTimer> dueTimers;
+
+        /**
+         * @brief Expired timers of the current update that run on the job system
+         */
+        std::vector<DueTimer> dueParallelTimers;
+
+        /**
+         * @brief Sum of all delta times passed to the timers
+         */
+        double timerTime;
+
+        /**
+         * @brief Next scheduling sequence number
+         */
+        uint64_t timerSequence;
+
+        /**
+         * @brief Number of scheduled timers
          */
-        std::vector<Timer> timers;
+        size_t activeTimerCount;
 
         /**
-         * @brief Next timer ID
+         * @brief Job system parallel timers run on, may be nullptr
          */
-        uint32_t nextTimerId;
+        JobSystem *jobs;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Engine
+{
+
+    /**
+     * @brief Dense identifier of a type within a TypeIds family
+     */
+    using TypeId = uint32_t;
+
+    /**
+     * @brief Numbers types without RTTI
+     *
+     * Every type gets the next free id of the family the first time get() is
+     * called for it, so ids are small and consecutive and can index arrays
+     * directly instead of hashing std::type_index. Ids depend on the order of
+     * first use, which can differ between runs, so they are never saved or
+     * compared across processes.
+     *
+     * @tparam Family Tag type; each family numbers its types from 0
+     */
+    template <typename Family>
+    class TypeIds
+    {
+    public:
+        /**
+         * @brief Marker for ids that name no type
+         */
+        static constexpr TypeId Invalid = 0xFFFFFFFFu;
+
+        /**
+         * @brief Gets the id of a type
+         * @tparam T Type to identify
+         * @return Id of T, the same on every call
+         */
+        template <typename T>
+        static TypeId get()
+        {
+            static const TypeId id = counter().fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+
+        /**
+         * @brief Gets the number of ids handed out so far
+         * @return One past the largest id
+         */
+        static TypeId count() { return counter().load(std::memory_order_relaxed); }
+
+    private:
+        /**
+         * @brief Next free id of the family
+         */
+        static std::atomic<TypeId> &counter()
+        {
+            static std::atomic<TypeId> next{0};
+            return next;
+        }
+    };
+
+} // namespace Engine
@@ -1,8 +1,7 @@
 // include/Engine/ECS/Component.hpp
 #pragma once
 
-#include <typeindex>
-#include <typeinfo>
+#include "Engine/Core/TypeId.hpp"
 
 namespace Engine
 {
@@ -30,9 +29,9 @@ namespace Engine
 
         /**
          * @brief Gets the component type
-         * @return Type index of the component
+         * @return Type id of the component, see getComponentTypeId()
          */
-        virtual std::type_index getType() const = 0;
+        virtual TypeId getType() const = 0;
 
         /**
          * @brief Gets the owner entity
@@ -53,6 +52,17 @@ namespace Engine
         Entity *owner;
     };
 
+    /**
+     * @brief Gets the id of a component type
+     * @tparam T Component type, or any other type systems declare access to
+     * @return Dense id indexing the component pools
+     */
+    template <typename T>
+    TypeId getComponentTypeId()
+    {
+        return TypeIds<Component>::get<T>();
+    }
+
     /**
      * @brief Templated component class
      * @tparam T Component type
@@ -63,20 +73,20 @@ namespace Engine
     public:
         /**
          * @brief Gets the component type
-         * @return Type index of the component
+         * @return Type id of the component
          */
-        std::type_index getType() const override
+        TypeId getType() const override
         {
-            return std::type_index(typeid(T));
+            return getComponentTypeId<T>();
         }
 
         /**
          * @brief Static method to get the component type
-         * @return Type index of the component
+         * @return Type id of the component
          */
-        static std::type_index staticType()
+        static TypeId staticType()
         {
-            return std::type_index(typeid(T));
+            return getComponentTypeId<T>();
         }
     };
 
@@ -85,12 +95,11 @@ namespace Engine
 // include/Engine/ECS/Entity.hpp
 #pragma once
 
-#include <memory>
-#include <unordered_map>
-#include <typeindex>
+#include <cstdint>
 #include <string>
 
 #include "Engine/ECS/Component.hpp"
+#include "Engine/ECS/EntityHandle.hpp"
 #include "Engine/Math/Transform.hpp"
 
 namespace Engine
@@ -108,7 +117,9 @@ namespace Engine
     {
     public:
         /**
-         * @brief Default constructor
+         * @brief Constructor
+         * @param manager Entity manager that owns the entity
+         * @param id Packed generational handle of the entity
          */
         Entity(EntityManager *manager, uint32_t id);
 
@@ -165,28 +176,12 @@ namespace Engine
          * @tparam Args Component constructor argument types
          * @param args Component constructor arguments
          * @return Reference to the added component
+         *
+         * The component is stored in the entity manager's pool for T. The
+         * reference stays valid until a component of type T is removed.
          */
         template <typename T, typename... Args>
-        T &addComponent(Args &&...args)
-        {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-
-            // Check if component already exists
-            auto type = std::type_index(typeid(T));
-            if (components.find(type) != components.end())
-            {
-                throw std::runtime_error("Component already exists");
-            }
-
-            // Create component
-            T *component = new T(std::forward<Args>(args)...);
-            component->setOwner(this);
-
-            // Store component
-            components[type] = std::unique_ptr<Component>(component);
-
-            return *component;
-        }
+        T &addComponent(Args &&...args);
 
         /**
          * @brief Gets a component from the entity
@@ -195,20 +190,15 @@ namespace Engine
          * @throws std::runtime_error if the component doesn't exist
          */
         template <typename T>
-        T &getComponent()
-        {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        T &getComponent();
 
-            // Check if component exists
-            auto type = std::type_index(typeid(T));
-            auto it = components.find(type);
-            if (it == components.end())
-            {
-                throw std::runtime_error("Component does not exist");
-            }
-
-            return *static_cast<T *>(it->second.get());
-        }
+        /**
+         * @brief Gets a component from the entity if it exists
+         * @tparam T Component type
+         * @return Pointer to the component, or nullptr if it doesn't exist
+         */
+        template <typename T>
+        T *tryGetComponent();
 
         /**
          * @brief Checks if the entity has a component
@@ -216,13 +206,14 @@ namespace Engine
          * @return True if the entity has the component, false otherwise
          */
         template <typename T>
-        bool hasComponent() const
-        {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        bool hasComponent() const;
 
-            auto type = std::type_index(typeid(T));
-            return components.find(type) != components.end();
-        }
+        /**
+         * @brief Checks if the entity has a component of a runtime type
+         * @param type Component type
+         * @return True if the entity has the component, false otherwise
+         */
+        bool hasComponent(TypeId type) const;
 
         /**
          * @brief Removes a component from the entity
@@ -230,20 +221,19 @@ namespace Engine
          * @return True if the component was removed, false if it didn't exist
          */
         template <typename T>
-        bool removeComponent()
-        {
-            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        bool removeComponent();
 
-            auto type = std::type_index(typeid(T));
-            auto it = components.find(type);
-            if (it == components.end())
-            {
-                return false;
-            }
+        /**
+         * @brief Gets the generational handle of the entity
+         * @return Entity handle
+         */
+        EntityHandle getHandle() const { return EntityHandle(id); }
 
-            components.erase(it);
-            return true;
-        }
+        /**
+         * @brief Gets the slot index of the entity
+         * @return Slot index used by the component pools
+         */
+        uint32_t getIndex() const { return EntityHandle(id).index(); }
 
     private:
         /**
@@ -252,7 +242,7 @@ namespace Engine
         EntityManager *manager;
 
         /**
-         * @brief Entity ID
+         * @brief Entity ID (packed generational handle)
          */
         uint32_t id;
 
@@ -270,11 +260,6 @@ namespace Engine
          * @brief Entity active state
          */
         bool active;
-
-        /**
-         * @brief Map of components
-         */
-        std::unordered_map<std::type_index, std::unique_ptr<Component>> components;
     };
 
 } // namespace Engine
@@ -282,16 +267,35 @@ namespace Engine
 // include/Engine/ECS/System.hpp
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <string>
-#include <unordered_set>
-#include <typeindex>
+
+#include "Engine/Core/TypeId.hpp"
+#include "Engine/ECS/Component.hpp"
 
 namespace Engine
 {
 
     class Entity;
     class Engine;
+    class EntityCommandBuffer;
+    class EntityManager;
+    class System;
+
+    template <typename... Ts>
+    class View;
+
+    /**
+     * @brief Gets the id of a system type
+     * @tparam T System type
+     * @return Dense id indexing the systems of an entity manager
+     */
+    template <typename T>
+    TypeId getSystemTypeId()
+    {
+        return TypeIds<System>::get<T>();
+    }
 
     /**
      * @brief Base class for all systems
@@ -324,11 +328,45 @@ namespace Engine
          */
         virtual void update(float deltaTime) = 0;
 
+        /**
+         * @brief Advances the simulation by one fixed step
+         * @param fixedDeltaTime Fixed timestep in seconds
+         *
+         * Called zero or more times per frame before update(), always with
+         * the same timestep. Put physics-like logic that must be frame rate
+         * independent here.
+         */
+        virtual void fixedUpdate(float fixedDeltaTime) { (void)fixedDeltaTime; }
+
         /**
          * @brief Shuts down the system
          */
         virtual void shutdown() = 0;
 
+        /**
+         * @brief Gets the number of items that can be updated in parallel chunks
+         * @return Number of items, or 0 if the system only supports update()
+         *
+         * Systems returning a non-zero count are run through updateRange()
+         * instead of update(), split into chunks over the job system.
+         */
+        virtual size_t getParallelWorkSize() const { return 0; }
+
+        /**
+         * @brief Updates a contiguous range of the system's items
+         * @param deltaTime Time since the last update
+         * @param begin First item index
+         * @param end One past the last item index
+         *
+         * May be called concurrently for disjoint ranges.
+         */
+        virtual void updateRange(float deltaTime, size_t begin, size_t end)
+        {
+            (void)deltaTime;
+            (void)begin;
+            (void)end;
+        }
+
         /**
          * @brief Adds an entity to the system
          * @param entity Pointer to the entity
@@ -347,17 +385,127 @@ namespace Engine
          */
         const std::string &getName() const { return name; }
 
+        /**
+         * @brief Sets the entity manager whose entities the system processes
+         * @param manager Pointer to the entity manager
+         *
+         * Called by the owner of the system before initialize().
+         */
+        void setEntityManager(EntityManager *manager) { entityManager = manager; }
+
+        /**
+         * @brief Gets the type of the system
+         * @return Id from getSystemTypeId(), or TypeIds<System>::Invalid before the system was added
+         */
+        TypeId getTypeId() const { return typeId; }
+
+        /**
+         * @brief Sets the type of the system
+         * @param id Id from getSystemTypeId() for the most derived type
+         *
+         * Called by the owner of the system before initialize().
+         */
+        void setTypeId(TypeId id) { typeId = id; }
+
+        /**
+         * @brief Gets the types the system reads
+         * @return Read types
+         */
+        const std::vector<TypeId> &getReads() const { return readTypes; }
+
+        /**
+         * @brief Gets the types the system writes
+         * @return Written types
+         */
+        const std::vector<TypeId> &getWrites() const { return writeTypes; }
+
+        /**
+         * @brief Gets the systems that must run before this one
+         * @return System types
+         */
+        const std::vector<TypeId> &getRunAfter() const { return runAfterTypes; }
+
+        /**
+         * @brief Gets the systems that must run after this one
+         * @return System types
+         */
+        const std::vector<TypeId> &getRunBefore() const { return runBeforeTypes; }
+
+        /**
+         * @brief Checks if the system must run alone
+         * @return True if the system declared no data access
+         *
+         * Systems that never declared reads or writes are assumed to touch
+         * anything and are never run concurrently with other systems.
+         */
+        bool isExclusive() const { return readTypes.empty() && writeTypes.empty(); }
+
     protected:
+        /**
+         * @brief Declares that the system reads a type
+         * @tparam T Component type, or any other shared type such as Transform
+         */
+        template <typename T>
+        void reads() { readTypes.push_back(getComponentTypeId<T>()); }
+
+        /**
+         * @brief Declares that the system writes a type
+         * @tparam T Component type, or any other shared type such as Transform
+         */
+        template <typename T>
+        void writes() { writeTypes.push_back(getComponentTypeId<T>()); }
+
+        /**
+         * @brief Requires another system to finish before this one starts
+         * @tparam T System type
+         */
+        template <typename T>
+        void runAfter() { runAfterTypes.push_back(getSystemTypeId<T>()); }
+
+        /**
+         * @brief Requires this system to finish before another one starts
+         * @tparam T System type
+         */
+        template <typename T>
+        void runBefore() { runBeforeTypes.push_back(getSystemTypeId<T>()); }
+
+        /**
+         * @brief Gets the cached view over all entities with the given components
+         * @tparam Ts Component types
+         * @return Reference to the view
+         */
+        template <typename... Ts>
+        View<Ts...> &view();
+
+        /**
+         * @brief Gets the command buffer of the calling thread
+         * @return Buffer played back once all systems ran, or nullptr on threads the manager does not know
+         *
+         * Entities must not be created or destroyed, nor components added or
+         * removed, while systems run; record those changes here instead.
+         */
+        EntityCommandBuffer *commands();
+
         /**
          * @brief Reference to the engine
          */
         Engine &engine;
 
+        /**
+         * @brief Entity manager whose entities the system processes
+         */
+        EntityManager *entityManager;
+
         /**
          * @brief System name
          */
         std::string name;
 
+        /**
+         * @brief Id of the most derived system type
+         */
+        TypeId typeId;
+
         /**
          * @brief List of entities processed by the system
          */
@@ -366,7 +514,27 @@ namespace Engine
         /**
          * @brief Set of component types required by the system
          */
-        std::unordered_set<std::type_index> requiredComponents;
+        std::vector<TypeId> requiredComponents;
+
+        /**
+         * @brief Types read by the system
+         */
+        std::vector<TypeId> readTypes;
+
+        /**
+         * @brief Types written by the system
+         */
+        std::vector<TypeId> writeTypes;
+
+        /**
+         * @brief Systems that must run before this one
+         */
+        std::vector<TypeId> runAfterTypes;
+
+        /**
+         * @brief Systems that must run after this one
+         */
+        std::vector<TypeId> runBeforeTypes;
 
         /**
          * @brief Checks if an entity has all required components
@@ -381,22 +549,35 @@ namespace Engine
 // include/Engine/ECS/EntityManager.hpp
 #pragma once
 
+#include <functional>
 #include <memory>
-#include <unordered_map>
+#include <thread>
 #include <vector>
 #include <queue>
+#include <stdexcept>
 
+#include "Engine/Core/ObjectPool.hpp"
 #include "Engine/ECS/Entity.hpp"
 #include "Engine/ECS/System.hpp"
+#include "Engine/ECS/ComponentPool.hpp"
+#include "Engine/ECS/View.hpp"
+#include "Engine/ECS/SystemScheduler.hpp"
+#include "Engine/Math/TransformHierarchy.hpp"
 
 namespace Engine
 {
 
+    class EntityCommandBuffer;
+
     /**
      * @brief Manager for entities and systems
      *
-     * The entity manager creates and destroys entities, and keeps track of
-     * all systems.
+     * The entity manager creates and destroys entities, owns the component
+     * storage, and keeps track of all systems. Components of one type live
+     * contiguously in a ComponentPool indexed by the entity slot index.
+     * Systems are run by a SystemScheduler according to their declared
+     * component access, and defer structural changes to per-thread
+     * EntityCommandBuffers that are played back once they finished.
      */
     class EntityManager
     {
@@ -419,11 +600,23 @@ namespace Engine
         bool initialize();
 
         /**
-         * @brief Updates all systems
+         * @brief Updates all systems through the scheduler
          * @param deltaTime Time since the last update
+         *
+         * Brings the world matrices of all entity transforms up to date afterwards.
          */
         void update(float deltaTime);
 
+        /**
+         * @brief Runs one fixed simulation step of all systems
+         * @param fixedDeltaTime Fixed timestep in seconds
+         *
+         * Stores the previous state of every entity transform first, so that
+         * rendering can interpolate between the last two steps, and brings
+         * the world matrices up to date afterwards.
+         */
+        void fixedUpdate(float fixedDeltaTime);
+
         /**
          * @brief Shuts down the entity manager
          */
@@ -435,19 +628,174 @@ namespace Engine
          */
         Entity *createEntity();
 
+        /**
+         * @brief Creates a batch of entities
+         * @param count Number of entities to create
+         * @param created Receives the created entities, appended in creation order
+         * @return Number of entities created, less than count only if the entity limit was reached
+         *
+         * Grows the slot arrays and the transform hierarchy once for the
+         * whole batch, for bulk loads.
+         */
+        size_t createEntities(size_t count, std::vector<Entity *> &created);
+
+        /**
+         * @brief Allocates storage for a number of live entities ahead of time
+         * @param count Number of live entities to hold without growing
+         *
+         * Lets a load that creates its entities in several batches grow the
+         * arrays once instead of once per batch.
+         */
+        void reserve(size_t count);
+
         /**
          * @brief Destroys an entity
          * @param entity Pointer to the entity
          */
         void destroyEntity(Entity *entity);
 
+        /**
+         * @brief Sets the function called with every entity just before it is destroyed
+         * @param callback Function to call, or nullptr for none
+         *
+         * Lets the owner drop its own references, such as names, whether the
+         * entity is destroyed directly or by a command buffer.
+         */
+        void setDestroyCallback(std::function<void(Entity *)> callback) { destroyCallback = std::move(callback); }
+
+        /**
+         * @brief Gets the command buffer of the calling thread
+         * @return Buffer of the main thread or of a job system worker, nullptr on any other thread
+         *
+         * Every thread records into its own buffer, so systems running in
+         * parallel can defer structural changes without locking.
+         */
+        EntityCommandBuffer *getCommandBuffer();
+
+        /**
+         * @brief Applies and clears the changes recorded in all command buffers
+         *
+         * Runs after the systems in update() and fixedUpdate(); call it
+         * directly only on the main thread while no system runs. Creations
+         * come first, then component additions and removals one component
+         * type at a time, then destructions. Within each step changes are
+         * ordered by sort key or entity index rather than by recording
+         * thread, so the result does not depend on scheduling.
+         */
+        void playbackCommands();
+
         /**
          * @brief Gets an entity by ID
          * @param id Entity ID
-         * @return Pointer to the entity, or nullptr if not found
+         * @return Pointer to the entity, or nullptr if not found or stale
          */
         Entity *getEntity(uint32_t id);
 
+        /**
+         * @brief Gets an entity by handle
+         * @param handle Entity handle
+         * @return Pointer to the entity, or nullptr if not found or stale
+         */
+        Entity *getEntity(EntityHandle handle) { return getEntity(handle.value); }
+
+        /**
+         * @brief Gets an entity by slot index, ignoring the generation
+         * @param index Entity slot index
+         * @return Pointer to the entity, or nullptr if the slot is free
+         */
+        Entity *getEntityByIndex(uint32_t index)
+        {
+            return index < entities.size() ? entities[index] : nullptr;
+        }
+
+        /**
+         * @brief Gets the entities by slot index
+         * @return Entity of every slot, null for free slots
+         */
+        const std::vector<Entity *> &getEntities() const { return entities; }
+
+        /**
+         * @brief Gets the number of live entities
+         * @return Number of live entities
+         */
+        size_t getEntityCount() const { return entityCount; }
+
+        /**
+         * @brief Gets the pool for a component type, creating it if needed
+         * @tparam T Component type
+         * @return Reference to the pool
+         */
+        template <typename T>
+        ComponentPool<T> &getPool()
+        {
+            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+            TypeId type = getComponentTypeId<T>();
+            if (type >= componentPools.size())
+            {
+                componentPools.resize(type + 1);
+            }
+
+            auto &pool = componentPools[type];
+            if (!pool)
+            {
+                pool = std::make_unique<ComponentPool<T>>();
+            }
+
+            return static_cast<ComponentPool<T> &>(*pool);
+        }
+
+        /**
+         * @brief Gets the pool for a component type if it exists
+         * @tparam T Component type
+         * @return Pointer to the pool, or nullptr if no component of T was ever added
+         */
+        template <typename T>
+        ComponentPool<T> *findPool() const
+        {
+            return static_cast<ComponentPool<T> *>(findPool(getComponentTypeId<T>()));
+        }
+
+        /**
+         * @brief Gets the pool for a runtime component type if it exists
+         * @param type Component type id
+         * @return Pointer to the pool, or nullptr if it doesn't exist
+         */
+        ComponentPoolBase *findPool(TypeId type) const
+        {
+            return type < componentPools.size() ? componentPools[type].get() : nullptr;
+        }
+
+        /**
+         * @brief Gets the cached view over all entities with the given components
+         * @tparam Ts Component types
+         * @return Reference to the view, valid for the lifetime of the manager
+         *
+         * The view is created on first use and then kept up to date as
+         * components are added and removed, so repeated calls never rescan.
+         * Systems should keep the returned reference rather than calling this
+         * every frame.
+         */
+        template <typename... Ts>
+        View<Ts...> &view()
+        {
+            TypeId type = TypeIds<ViewBase>::get<View<Ts...>>();
+            if (type >= views.size())
+            {
+                views.resize(type + 1);
+            }
+
+            auto &cached = views[type];
+            if (!cached)
+            {
+                auto created = std::make_unique<View<Ts...>>(entities, getPool<Ts>()...);
+                (getPool<Ts>().addListener(created.get()), ...);
+                cached = std::move(created);
+            }
+
+            return static_cast<View<Ts...> &>(*cached);
+        }
+
         /**
          * @brief Adds a system to the entity manager
          * @tparam T System type
@@ -463,6 +811,9 @@ namespace Engine
             // Create system
             auto system = std::make_unique<T>(engine, std::forward<Args>(args)...);
             T &systemRef = *system;
+            TypeId type = getSystemTypeId<T>();
+            system->setEntityManager(this);
+            system->setTypeId(type);
 
             // Initialize system
             if (!system->initialize())
@@ -470,32 +821,47 @@ namespace Engine
                 throw std::runtime_error("Failed to initialize system");
             }
 
-            // Add system to the list
+            // Add system to the list, the type table, and the schedule
+            if (type >= systemsByType.size())
+            {
+                systemsByType.resize(type + 1, nullptr);
+            }
+            if (!systemsByType[type])
+            {
+                systemsByType[type] = system.get();
+            }
+            scheduler.addSystem(system.get());
             systems.push_back(std::move(system));
 
             return systemRef;
         }
 
+        /**
+         * @brief Gets the system scheduler
+         * @return Reference to the scheduler
+         */
+        SystemScheduler &getScheduler() { return scheduler; }
+
+        /**
+         * @brief Gets the hierarchy of all entity transforms
+         * @return Reference to the transform hierarchy
+         */
+        const TransformHierarchy &getTransformHierarchy() const { return transformHierarchy; }
+
         /**
          * @brief Gets a system by type
-         * @tparam T System type
-         * @return Pointer to the system, or nullptr if not found
+         * @tparam T System type, as passed to addSystem()
+         * @return Pointer to the first system added as T, or nullptr if not found
+         *
+         * Looks the type up by id, so a base class of the added type does not match.
          */
         template <typename T>
         T *getSystem()
         {
             static_assert(std::is_base_of<System, T>::value, "T must derive from System");
 
-            for (auto &system : systems)
-            {
-                T *typedSystem = dynamic_cast<T *>(system.get());
-                if (typedSystem)
-                {
-                    return typedSystem;
-                }
-            }
-
-            return nullptr;
+            TypeId type = getSystemTypeId<T>();
+            return type < systemsByType.size() ? static_cast<T *>(systemsByType[type]) : nullptr;
         }
 
     private:
@@ -505,24 +871,140 @@ namespace Engine
         Engine &engine;
 
         /**
-         * @brief Map of entities
+         * @brief Storage of all entities
          */
-        std::unordered_map<uint32_t, std::unique_ptr<Entity>> entities;
+        ObjectPool<Entity> entityPool;
 
         /**
-         * @brief List of systems
+         * @brief Entities indexed by slot index (null for free slots)
+         */
+        std::vector<Entity *> entities;
+
+        /**
+         * @brief Current generation of every slot
+         */
+        std::vector<uint32_t> generations;
+
+        /**
+         * @brief Component pools by component type id, null for types without a pool
+         */
+        std::vector<std::unique_ptr<ComponentPoolBase>> componentPools;
+
+        /**
+         * @brief Cached views by view type id
+         */
+        std::vector<std::unique_ptr<ViewBase>> views;
+
+        /**
+         * @brief List of systems in the order they were added
          */
         std::vector<std::unique_ptr<System>> systems;
 
         /**
-         * @brief Queue of entity IDs to be reused
+         * @brief First system added of every type, by system type id
+         */
+        std::vector<System *> systemsByType;
+
+        /**
+         * @brief Scheduler running the systems
+         */
+        SystemScheduler scheduler;
+
+        /**
+         * @brief World matrix storage and update order of the entity transforms
+         */
+        TransformHierarchy transformHierarchy;
+
+        /**
+         * @brief Queue of entity slot indices to be reused
          */
         std::queue<uint32_t> freeIds;
 
         /**
-         * @brief Next entity ID
+         * @brief Number of live entities
          */
-        uint32_t nextId;
+        size_t entityCount;
+
+        /**
+         * @brief Command buffer of the main thread, followed by one per job system worker
+         */
+        std::vector<std::unique_ptr<EntityCommandBuffer>> commandBuffers;
+
+        /**
+         * @brief Thread that initialized the manager, owning the first command buffer
+         */
+        std::thread::id ownerThread;
+
+        /**
+         * @brief Called with every entity just before it is destroyed
+         */
+        std::function<void(Entity *)> destroyCallback;
     };
 
-} // namespace Engine
\ No newline at end of file
+    // Entity component accessors and System::view need the complete EntityManager type
+
+    template <typename... Ts>
+    View<Ts...> &System::view()
+    {
+        return entityManager->view<Ts...>();
+    }
+
+    template <typename T, typename... Args>
+    T &Entity::addComponent(Args &&...args)
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+        // Check if component already exists
+        ComponentPool<T> &pool = manager->getPool<T>();
+        if (pool.contains(getIndex()))
+        {
+            throw std::runtime_error("Component already exists");
+        }
+
+        // Create component in place
+        T &component = pool.emplace(getIndex(), std::forward<Args>(args)...);
+        component.setOwner(this);
+
+        return component;
+    }
+
+    template <typename T>
+    T &Entity::getComponent()
+    {
+        T *component = tryGetComponent<T>();
+        if (!component)
+        {
+            throw std::runtime_error("Component does not exist");
+        }
+
+        return *component;
+    }
+
+    template <typename T>
+    T *Entity::tryGetComponent()
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+        ComponentPool<T> *pool = manager->findPool<T>();
+        return pool ? pool->get(getIndex()) : nullptr;
+    }
+
+    template <typename T>
+    bool Entity::hasComponent() const
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+        ComponentPool<T> *pool = manager->findPool<T>();
+        return pool && pool->contains(getIndex());
+    }
+
+    template <typename T>
+    bool Entity::removeComponent()
+    {
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+
+        ComponentPool<T> *pool = manager->findPool<T>();
+        return pool && pool->remove(getIndex());
+    }
+
+} // namespace Engine
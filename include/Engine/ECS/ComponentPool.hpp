@@ -0,0 +1,365 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/Memory.hpp"
+#include "Engine/ECS/Component.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Interface for objects that track pool membership changes
+     *
+     * Views register themselves as listeners so that their cached membership
+     * can be updated incrementally instead of being rebuilt by scanning.
+     */
+    class ComponentPoolListener
+    {
+    public:
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~ComponentPoolListener() = default;
+
+        /**
+         * @brief Called after a component was added to an entity
+         * @param entityIndex Entity slot index
+         */
+        virtual void onComponentAdded(uint32_t entityIndex) = 0;
+
+        /**
+         * @brief Called before a component is removed from an entity
+         * @param entityIndex Entity slot index
+         */
+        virtual void onComponentRemoved(uint32_t entityIndex) = 0;
+    };
+
+    /**
+     * @brief Type-erased base of a component pool
+     *
+     * Pools are sparse sets: a sparse array maps an entity slot index to a
+     * position in the dense array, and the dense array lists the owning entity
+     * of every stored component. Membership tests are therefore two array reads
+     * and never touch the components themselves.
+     */
+    class ComponentPoolBase
+    {
+    public:
+        /**
+         * @brief Marker for sparse entries without a component
+         */
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~ComponentPoolBase() = default;
+
+        /**
+         * @brief Checks if an entity has a component in this pool
+         * @param entityIndex Entity slot index
+         * @return True if the entity has a component in this pool
+         */
+        bool contains(uint32_t entityIndex) const
+        {
+            return entityIndex < sparse.size() && sparse[entityIndex] != InvalidIndex;
+        }
+
+        /**
+         * @brief Gets the dense index of an entity's component
+         * @param entityIndex Entity slot index (must be contained in the pool)
+         * @return Position of the component in the dense array
+         */
+        uint32_t indexOf(uint32_t entityIndex) const { return sparse[entityIndex]; }
+
+        /**
+         * @brief Gets the number of stored components
+         * @return Number of components
+         */
+        size_t size() const { return dense.size(); }
+
+        /**
+         * @brief Gets the entity slot indices in dense order
+         * @return Dense array of entity slot indices
+         */
+        const std::vector<uint32_t> &getEntities() const { return dense; }
+
+        /**
+         * @brief Registers a listener for membership changes
+         * @param listener Listener to register
+         */
+        void addListener(ComponentPoolListener *listener) { listeners.push_back(listener); }
+
+        /**
+         * @brief Removes the component of an entity
+         * @param entityIndex Entity slot index
+         * @return True if a component was removed, false if there was none
+         */
+        virtual bool remove(uint32_t entityIndex) = 0;
+
+        /**
+         * @brief Gets the component of an entity through the base class
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if there is none
+         */
+        virtual Component *getBase(uint32_t entityIndex) = 0;
+
+        /**
+         * @brief Destroys all components in the pool
+         */
+        virtual void clear() = 0;
+
+    protected:
+        /**
+         * @brief Notifies listeners that a component was added
+         * @param entityIndex Entity slot index
+         */
+        void notifyAdded(uint32_t entityIndex)
+        {
+            for (ComponentPoolListener *listener : listeners)
+            {
+                listener->onComponentAdded(entityIndex);
+            }
+        }
+
+        /**
+         * @brief Notifies listeners that a component is about to be removed
+         * @param entityIndex Entity slot index
+         */
+        void notifyRemoved(uint32_t entityIndex)
+        {
+            for (ComponentPoolListener *listener : listeners)
+            {
+                listener->onComponentRemoved(entityIndex);
+            }
+        }
+
+        /**
+         * @brief Listeners notified on membership changes
+         */
+        std::vector<ComponentPoolListener *> listeners;
+
+        /**
+         * @brief Entity slot index to dense index
+         */
+        std::vector<uint32_t> sparse;
+
+        /**
+         * @brief Dense index to entity slot index
+         */
+        std::vector<uint32_t> dense;
+    };
+
+    /**
+     * @brief Contiguous storage for all components of one type
+     * @tparam T Component type
+     *
+     * Components are stored by value in fixed-size pages, so growing the pool
+     * never moves existing components. Pages are kept until the pool is
+     * cleared and counted against MemoryTag::ECS. Removing a component moves the last
+     * component of the pool into the freed slot to keep storage dense; that is
+     * the only operation that invalidates references into the pool.
+     */
+    template <typename T>
+    class ComponentPool : public ComponentPoolBase
+    {
+    public:
+        /**
+         * @brief Number of components per page
+         */
+        static constexpr size_t PageSize = 1024;
+
+        /**
+         * @brief Destructor
+         */
+        ~ComponentPool() override
+        {
+            clear();
+        }
+
+        /**
+         * @brief Constructs a component for an entity
+         * @tparam Args Component constructor argument types
+         * @param entityIndex Entity slot index
+         * @param args Component constructor arguments
+         * @return Reference to the constructed component
+         */
+        template <typename... Args>
+        T &emplace(uint32_t entityIndex, Args &&...args)
+        {
+            if (entityIndex >= sparse.size())
+            {
+                sparse.resize(entityIndex + 1, InvalidIndex);
+            }
+
+            uint32_t denseIndex = static_cast<uint32_t>(dense.size());
+            if (denseIndex / PageSize >= pages.size())
+            {
+                void *page = Memory::allocate(sizeof(Page), alignof(Page), MemoryTag::ECS);
+                if (!page)
+                {
+                    throw std::bad_alloc();
+                }
+                pages.push_back(static_cast<Page *>(page));
+            }
+
+            T *component = new (rawSlot(denseIndex)) T(std::forward<Args>(args)...);
+            dense.push_back(entityIndex);
+            sparse[entityIndex] = denseIndex;
+
+            notifyAdded(entityIndex);
+
+            return *component;
+        }
+
+        /**
+         * @brief Allocates storage for a number of components ahead of time
+         * @param count Number of components the pool should hold without allocating
+         *
+         * Lets bulk loads emplace a whole batch without growing the arrays
+         * or allocating pages one at a time.
+         */
+        void reserve(size_t count)
+        {
+            dense.reserve(count);
+            while (pages.size() * PageSize < count)
+            {
+                void *page = Memory::allocate(sizeof(Page), alignof(Page), MemoryTag::ECS);
+                if (!page)
+                {
+                    throw std::bad_alloc();
+                }
+                pages.push_back(static_cast<Page *>(page));
+            }
+        }
+
+        /**
+         * @brief Removes the component of an entity
+         * @param entityIndex Entity slot index
+         * @return True if a component was removed, false if there was none
+         */
+        bool remove(uint32_t entityIndex) override
+        {
+            if (!contains(entityIndex))
+            {
+                return false;
+            }
+
+            notifyRemoved(entityIndex);
+
+            uint32_t denseIndex = sparse[entityIndex];
+            uint32_t lastIndex = static_cast<uint32_t>(dense.size() - 1);
+
+            // Move the last component into the hole to keep storage dense
+            if (denseIndex != lastIndex)
+            {
+                *slot(denseIndex) = std::move(*slot(lastIndex));
+                dense[denseIndex] = dense[lastIndex];
+                sparse[dense[denseIndex]] = denseIndex;
+            }
+
+            slot(lastIndex)->~T();
+            dense.pop_back();
+            sparse[entityIndex] = InvalidIndex;
+
+            return true;
+        }
+
+        /**
+         * @brief Gets the component of an entity
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if there is none
+         */
+        T *get(uint32_t entityIndex)
+        {
+            return contains(entityIndex) ? slot(sparse[entityIndex]) : nullptr;
+        }
+
+        /**
+         * @brief Gets the component of an entity (const)
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if there is none
+         */
+        const T *get(uint32_t entityIndex) const
+        {
+            return contains(entityIndex) ? slot(sparse[entityIndex]) : nullptr;
+        }
+
+        /**
+         * @brief Gets a component by its position in the dense array
+         * @param denseIndex Dense index
+         * @return Reference to the component
+         */
+        T &at(size_t denseIndex) { return *slot(denseIndex); }
+
+        /**
+         * @brief Gets the component of an entity through the base class
+         * @param entityIndex Entity slot index
+         * @return Pointer to the component, or nullptr if there is none
+         */
+        Component *getBase(uint32_t entityIndex) override
+        {
+            return get(entityIndex);
+        }
+
+        /**
+         * @brief Destroys all components in the pool
+         */
+        void clear() override
+        {
+            for (size_t i = 0; i < dense.size(); ++i)
+            {
+                slot(i)->~T();
+            }
+
+            for (Page *page : pages)
+            {
+                Memory::deallocate(page, MemoryTag::ECS);
+            }
+
+            dense.clear();
+            sparse.clear();
+            pages.clear();
+        }
+
+    private:
+        /**
+         * @brief Raw storage for one page of components
+         */
+        struct Page
+        {
+            alignas(T) unsigned char storage[sizeof(T) * PageSize];
+        };
+
+        /**
+         * @brief Gets the raw storage for a dense index
+         * @param denseIndex Dense index
+         * @return Pointer to the uninitialized storage
+         */
+        void *rawSlot(size_t denseIndex) const
+        {
+            return pages[denseIndex / PageSize]->storage + (denseIndex % PageSize) * sizeof(T);
+        }
+
+        /**
+         * @brief Gets the constructed component for a dense index
+         * @param denseIndex Dense index
+         * @return Pointer to the component
+         */
+        T *slot(size_t denseIndex) const
+        {
+            return std::launder(reinterpret_cast<T *>(rawSlot(denseIndex)));
+        }
+
+        /**
+         * @brief Component pages
+         */
+        std::vector<Page *> pages;
+    };
+
+} // namespace Engine
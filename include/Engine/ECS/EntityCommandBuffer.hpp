@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Engine/ECS/EntityManager.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Entity recorded for creation in an EntityCommandBuffer
+     *
+     * Only valid with the buffer that returned it, until the buffer is played
+     * back.
+     */
+    struct PendingEntity
+    {
+        /**
+         * @brief Position among the creations of the buffer
+         */
+        uint32_t index;
+    };
+
+    /**
+     * @brief Records structural changes to apply to an entity manager later
+     *
+     * Creating and destroying entities and adding and removing components
+     * change containers that systems iterate, so they cannot happen while
+     * systems run. A command buffer stores the changes instead, and
+     * EntityManager::playbackCommands() applies those of all threads at once
+     * after the systems finished. Added components are constructed when they
+     * are recorded and moved into their pool on playback, grouped by type and
+     * sorted by entity, so each pool grows once per frame.
+     *
+     * Changes to the same component type of one entity apply in the order
+     * they were recorded, and those of different buffers in buffer order, so
+     * removing a component and adding it again replaces it. Adding a
+     * component an entity already has keeps the existing one. Changes to
+     * entities that were destroyed in the meantime are dropped.
+     *
+     * Get a buffer with EntityManager::getCommandBuffer() or
+     * System::commands(); a buffer is used by one thread only.
+     */
+    class EntityCommandBuffer
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        EntityCommandBuffer() = default;
+
+        EntityCommandBuffer(const EntityCommandBuffer &) = delete;
+        EntityCommandBuffer &operator=(const EntityCommandBuffer &) = delete;
+
+        /**
+         * @brief Records the creation of an entity
+         * @param sortKey Position of the entity among all creations of the frame
+         * @return Reference for adding components to the entity
+         *
+         * Entities are created in the order of their sort keys, so slot
+         * indices do not depend on which thread recorded them. Pass something
+         * stable, such as the index of the item that spawns the entity;
+         * creations with equal keys are ordered by buffer.
+         */
+        PendingEntity createEntity(uint32_t sortKey = 0);
+
+        /**
+         * @brief Records the destruction of an entity
+         * @param entity Entity to destroy
+         */
+        void destroyEntity(Entity *entity);
+
+        /**
+         * @brief Records the addition of a component to an entity
+         * @tparam T Component type, move constructible
+         * @tparam Args Component constructor argument types
+         * @param entity Entity to add to
+         * @param args Component constructor arguments
+         */
+        template <typename T, typename... Args>
+        void addComponent(Entity *entity, Args &&...args)
+        {
+            if (entity)
+            {
+                addComponent<T>(Target{entity->getId(), false}, std::forward<Args>(args)...);
+            }
+        }
+
+        /**
+         * @brief Records the addition of a component to an entity created by this buffer
+         * @tparam T Component type, move constructible
+         * @tparam Args Component constructor argument types
+         * @param entity Entity returned by createEntity()
+         * @param args Component constructor arguments
+         */
+        template <typename T, typename... Args>
+        void addComponent(PendingEntity entity, Args &&...args)
+        {
+            addComponent<T>(Target{entity.index, true}, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Records the removal of a component from an entity
+         * @tparam T Component type
+         * @param entity Entity to remove from
+         */
+        template <typename T>
+        void removeComponent(Entity *entity)
+        {
+            if (entity)
+            {
+                getList<T>().changes.push_back(Change{Target{entity->getId(), false}, Change::Removal});
+                ++commandCount;
+            }
+        }
+
+        /**
+         * @brief Checks if the buffer holds no changes
+         * @return True if nothing was recorded since the last playback
+         */
+        bool isEmpty() const { return commandCount == 0; }
+
+        /**
+         * @brief Gets the number of recorded changes
+         * @return Number of changes since the last playback
+         */
+        size_t getCommandCount() const { return commandCount; }
+
+        /**
+         * @brief Drops all recorded changes, keeping the memory for the next frame
+         */
+        void clear();
+
+    private:
+        friend class EntityManager;
+
+        /**
+         * @brief Entity a change applies to
+         */
+        struct Target
+        {
+            /**
+             * @brief Entity ID, or position among the creations of the buffer
+             */
+            uint32_t id;
+
+            /**
+             * @brief True if id refers to a creation of the buffer
+             */
+            bool pending;
+        };
+
+        /**
+         * @brief Addition or removal of one component
+         */
+        struct Change
+        {
+            /**
+             * @brief Item marking a removal
+             */
+            static constexpr uint32_t Removal = 0xFFFFFFFFu;
+
+            /**
+             * @brief Entity the change applies to
+             */
+            Target target;
+
+            /**
+             * @brief Position of the added component in the list's values, or Removal
+             */
+            uint32_t item;
+        };
+
+        /**
+         * @brief Changes to the components of one type
+         */
+        class CommandList
+        {
+        public:
+            /**
+             * @brief Virtual destructor
+             */
+            virtual ~CommandList() = default;
+
+            /**
+             * @brief Makes room in the pool for a number of additions
+             * @param manager Manager owning the pool
+             * @param count Number of components about to be added
+             */
+            virtual void reserve(EntityManager &manager, size_t count) = 0;
+
+            /**
+             * @brief Moves a recorded component into its pool
+             * @param manager Manager owning the pool
+             * @param item Position of the added component in the list's values
+             * @param entity Entity to add to
+             */
+            virtual void add(EntityManager &manager, size_t item, Entity *entity) = 0;
+
+            /**
+             * @brief Drops the recorded changes
+             */
+            virtual void clear()
+            {
+                changes.clear();
+            }
+
+            /**
+             * @brief Additions and removals in the order they were recorded
+             */
+            std::vector<Change> changes;
+        };
+
+        /**
+         * @brief Changes to the components of type T
+         * @tparam T Component type
+         */
+        template <typename T>
+        class TypedCommandList : public CommandList
+        {
+        public:
+            void reserve(EntityManager &manager, size_t count) override
+            {
+                ComponentPool<T> &pool = manager.getPool<T>();
+                pool.reserve(pool.size() + count);
+            }
+
+            void add(EntityManager &manager, size_t item, Entity *entity) override
+            {
+                ComponentPool<T> &pool = manager.getPool<T>();
+                if (!pool.contains(entity->getIndex()))
+                {
+                    pool.emplace(entity->getIndex(), std::move(values[item])).setOwner(entity);
+                }
+            }
+
+            void clear() override
+            {
+                CommandList::clear();
+                values.clear();
+            }
+
+            /**
+             * @brief Component of every recorded addition
+             */
+            std::vector<T> values;
+        };
+
+        /**
+         * @brief Records the addition of a component
+         * @tparam T Component type
+         * @tparam Args Component constructor argument types
+         * @param target Entity to add to
+         * @param args Component constructor arguments
+         */
+        template <typename T, typename... Args>
+        void addComponent(Target target, Args &&...args)
+        {
+            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+            static_assert(std::is_move_constructible<T>::value, "Deferred components must be move constructible");
+
+            TypedCommandList<T> &list = getList<T>();
+            list.changes.push_back(Change{target, static_cast<uint32_t>(list.values.size())});
+            list.values.emplace_back(std::forward<Args>(args)...);
+            ++commandCount;
+        }
+
+        /**
+         * @brief Gets the changes to one component type, creating the list if needed
+         * @tparam T Component type
+         * @return Reference to the list
+         */
+        template <typename T>
+        TypedCommandList<T> &getList()
+        {
+            TypeId type = getComponentTypeId<T>();
+            if (type >= lists.size())
+            {
+                lists.resize(type + 1);
+            }
+            if (!lists[type])
+            {
+                lists[type] = std::make_unique<TypedCommandList<T>>();
+            }
+
+            return static_cast<TypedCommandList<T> &>(*lists[type]);
+        }
+
+        /**
+         * @brief Gets the changes to one component type if any were recorded
+         * @param type Component type id
+         * @return Pointer to the list, or nullptr if the type was never used
+         */
+        CommandList *findList(TypeId type) const
+        {
+            return type < lists.size() ? lists[type].get() : nullptr;
+        }
+
+        /**
+         * @brief Sort key of every recorded creation
+         */
+        std::vector<uint32_t> createKeys;
+
+        /**
+         * @brief Entity of every recorded destruction
+         */
+        std::vector<Target> destroyTargets;
+
+        /**
+         * @brief Changes by component type id, null for types never used with this buffer
+         */
+        std::vector<std::unique_ptr<CommandList>> lists;
+
+        /**
+         * @brief Number of recorded changes
+         */
+        size_t commandCount = 0;
+    };
+
+} // namespace Engine
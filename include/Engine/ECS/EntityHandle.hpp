@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+
+    /**
+     * @brief Generational entity handle
+     *
+     * A handle packs a slot index and a generation counter into 32 bits. The
+     * generation is bumped every time a slot is recycled, so a handle to a
+     * destroyed entity never resolves to the entity that later reuses its slot.
+     */
+    struct EntityHandle
+    {
+        /**
+         * @brief Number of bits used for the slot index
+         */
+        static constexpr uint32_t IndexBits = 22;
+
+        /**
+         * @brief Number of bits used for the generation
+         */
+        static constexpr uint32_t GenerationBits = 32 - IndexBits;
+
+        /**
+         * @brief Mask for the slot index, one past the largest index handed out
+         */
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+
+        /**
+         * @brief Mask for the generation
+         */
+        static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+
+        /**
+         * @brief Value of an invalid handle
+         */
+        static constexpr uint32_t InvalidValue = 0xFFFFFFFFu;
+
+        /**
+         * @brief Packed handle value
+         */
+        uint32_t value = InvalidValue;
+
+        /**
+         * @brief Default constructor (invalid handle)
+         */
+        constexpr EntityHandle() = default;
+
+        /**
+         * @brief Constructor from a packed value
+         * @param value Packed handle value
+         */
+        constexpr explicit EntityHandle(uint32_t value) : value(value) {}
+
+        /**
+         * @brief Creates a handle from an index and a generation
+         * @param index Slot index
+         * @param generation Slot generation
+         * @return Packed handle
+         */
+        static constexpr EntityHandle make(uint32_t index, uint32_t generation)
+        {
+            return EntityHandle(((generation & GenerationMask) << IndexBits) | (index & IndexMask));
+        }
+
+        /**
+         * @brief Gets the slot index
+         * @return Slot index
+         */
+        constexpr uint32_t index() const { return value & IndexMask; }
+
+        /**
+         * @brief Gets the generation
+         * @return Generation
+         */
+        constexpr uint32_t generation() const { return (value >> IndexBits) & GenerationMask; }
+
+        /**
+         * @brief Checks if the handle is valid
+         * @return True if the handle is not the invalid handle
+         */
+        constexpr bool isValid() const { return value != InvalidValue; }
+
+        /**
+         * @brief Equality operator
+         * @param other Handle to compare with
+         * @return True if the handles are equal
+         */
+        constexpr bool operator==(const EntityHandle &other) const { return value == other.value; }
+
+        /**
+         * @brief Inequality operator
+         * @param other Handle to compare with
+         * @return True if the handles are not equal
+         */
+        constexpr bool operator!=(const EntityHandle &other) const { return value != other.value; }
+    };
+
+} // namespace Engine
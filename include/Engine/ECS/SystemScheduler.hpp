@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine/ECS/System.hpp"
+#include "Engine/Core/JobSystem.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Execution mode of the system scheduler
+     */
+    enum class ScheduleMode
+    {
+        Parallel,
+        SingleThreaded
+    };
+
+    /**
+     * @brief System callback run by the scheduler
+     */
+    enum class SystemPhase
+    {
+        Update,
+        FixedUpdate
+    };
+
+    /**
+     * @brief Runs systems as a dependency graph over the job system
+     *
+     * Two systems conflict if one writes a type that the other reads or writes,
+     * or if either of them declared no access at all. Conflicting systems run
+     * in the order in which they were added unless explicit runAfter/runBefore
+     * constraints require otherwise. Systems without a path between them in
+     * the resulting graph run concurrently, and systems that report a parallel
+     * work size are split into chunks.
+     *
+     * The single-threaded mode runs the same graph in its topological order on
+     * the calling thread.
+     */
+    class SystemScheduler
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        SystemScheduler();
+
+        /**
+         * @brief Destructor
+         */
+        ~SystemScheduler();
+
+        /**
+         * @brief Initializes the scheduler
+         * @param jobSystem Job system to run systems on (nullptr to always run single-threaded)
+         * @return True if initialization succeeded, false otherwise
+         */
+        bool initialize(JobSystem *jobSystem);
+
+        /**
+         * @brief Shuts down the scheduler
+         */
+        void shutdown();
+
+        /**
+         * @brief Adds a system to the schedule
+         * @param system Pointer to the system (not owned)
+         *
+         * runAfter/runBefore constraints find systems by System::getTypeId(),
+         * which EntityManager::addSystem() sets.
+         */
+        void addSystem(System *system);
+
+        /**
+         * @brief Removes all systems from the schedule
+         */
+        void clear();
+
+        /**
+         * @brief Runs every system once
+         * @param deltaTime Time since the last update, or the fixed timestep
+         * @param phase Callback to run on each system
+         *
+         * Only the update phase is split into chunks.
+         */
+        void run(float deltaTime, SystemPhase phase = SystemPhase::Update);
+
+        /**
+         * @brief Sets the execution mode
+         * @param mode Execution mode
+         */
+        void setMode(ScheduleMode mode) { this->mode = mode; }
+
+        /**
+         * @brief Gets the execution mode
+         * @return Execution mode
+         */
+        ScheduleMode getMode() const { return mode; }
+
+        /**
+         * @brief Sets the number of items per chunk for chunked systems
+         * @param size Items per chunk
+         */
+        void setChunkSize(size_t size) { chunkSize = size > 0 ? size : 1; }
+
+        /**
+         * @brief Gets the number of items per chunk for chunked systems
+         * @return Items per chunk
+         */
+        size_t getChunkSize() const { return chunkSize; }
+
+        /**
+         * @brief Gets the topological execution order
+         * @return Systems in the order they run in single-threaded mode
+         */
+        const std::vector<System *> &getExecutionOrder();
+
+    private:
+        /**
+         * @brief Node of the system graph
+         */
+        struct Node
+        {
+            /**
+             * @brief Scheduled system
+             */
+            System *system = nullptr;
+
+            /**
+             * @brief Indices of nodes that wait for this one
+             */
+            std::vector<uint32_t> successors;
+
+            /**
+             * @brief Number of nodes this one waits for
+             */
+            uint32_t predecessorCount = 0;
+        };
+
+        /**
+         * @brief Rebuilds the graph and the execution order if systems changed
+         */
+        void buildGraph();
+
+        /**
+         * @brief Checks if two systems may not run concurrently
+         * @param a First system
+         * @param b Second system
+         * @return True if the systems conflict
+         */
+        static bool conflicts(const System &a, const System &b);
+
+        /**
+         * @brief Runs a single system, chunking it if it supports that
+         * @param system System to run
+         * @param deltaTime Time since the last update
+         * @param phase Callback to run
+         * @param parallel True to spread chunks over the job system
+         */
+        void runSystem(System &system, float deltaTime, SystemPhase phase, bool parallel);
+
+        /**
+         * @brief Submits the job for a node
+         * @param index Node index
+         * @param deltaTime Time since the last update
+         * @param phase Callback to run
+         * @param counter Counter tracking the whole frame
+         */
+        void submitNode(uint32_t index, float deltaTime, SystemPhase phase, JobCounter &counter);
+
+        /**
+         * @brief Scheduled systems in the order they were added
+         */
+        std::vector<System *> systems;
+
+        /**
+         * @brief Graph nodes, one per system
+         */
+        std::vector<Node> nodes;
+
+        /**
+         * @brief Predecessors still running, per node, for the current run
+         */
+        std::unique_ptr<std::atomic<uint32_t>[]> remaining;
+
+        /**
+         * @brief Systems in topological order
+         */
+        std::vector<System *> executionOrder;
+
+        /**
+         * @brief Flag that indicates if the graph must be rebuilt
+         */
+        bool dirty;
+
+        /**
+         * @brief Flag that indicates if the graph contains a cycle
+         */
+        bool cyclic;
+
+        /**
+         * @brief Execution mode
+         */
+        ScheduleMode mode;
+
+        /**
+         * @brief Items per chunk for chunked systems
+         */
+        size_t chunkSize;
+
+        /**
+         * @brief Job system to run systems on
+         */
+        JobSystem *jobs;
+    };
+
+} // namespace Engine
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "Engine/ECS/ComponentPool.hpp"
+#include "Engine/ECS/Entity.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Type-erased base of a view
+     *
+     * A view caches the slot indices of all entities that have a given set of
+     * components. Membership is kept as a sparse set, just like the component
+     * pools, and is updated by the pools as components are added or removed.
+     */
+    class ViewBase : public ComponentPoolListener
+    {
+    public:
+        /**
+         * @brief Marker for sparse entries that are not members
+         */
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        /**
+         * @brief Gets the number of matching entities
+         * @return Number of matching entities
+         */
+        size_t size() const { return members.size(); }
+
+        /**
+         * @brief Checks if the view has no matching entities
+         * @return True if the view is empty
+         */
+        bool empty() const { return members.empty(); }
+
+        /**
+         * @brief Checks if an entity is a member of the view
+         * @param entityIndex Entity slot index
+         * @return True if the entity matches the view
+         */
+        bool contains(uint32_t entityIndex) const
+        {
+            return entityIndex < positions.size() && positions[entityIndex] != InvalidIndex;
+        }
+
+        /**
+         * @brief Gets the slot indices of all matching entities
+         * @return Dense array of entity slot indices
+         */
+        const std::vector<uint32_t> &getEntities() const { return members; }
+
+    protected:
+        /**
+         * @brief Adds an entity to the membership list
+         * @param entityIndex Entity slot index
+         */
+        void insert(uint32_t entityIndex)
+        {
+            if (entityIndex >= positions.size())
+            {
+                positions.resize(entityIndex + 1, InvalidIndex);
+            }
+
+            positions[entityIndex] = static_cast<uint32_t>(members.size());
+            members.push_back(entityIndex);
+        }
+
+        /**
+         * @brief Removes an entity from the membership list
+         * @param entityIndex Entity slot index
+         */
+        void erase(uint32_t entityIndex)
+        {
+            uint32_t position = positions[entityIndex];
+            uint32_t last = members.back();
+
+            // Swap with the last member to keep the list dense
+            members[position] = last;
+            positions[last] = position;
+            members.pop_back();
+            positions[entityIndex] = InvalidIndex;
+        }
+
+        /**
+         * @brief Entity slot indices of all matching entities
+         */
+        std::vector<uint32_t> members;
+
+        /**
+         * @brief Entity slot index to position in the membership list
+         */
+        std::vector<uint32_t> positions;
+    };
+
+    /**
+     * @brief Cached query over all entities that have every component in Ts
+     * @tparam Ts Component types
+     *
+     * Views are created and owned by the EntityManager and stay valid for its
+     * lifetime, so systems can keep a reference instead of looking them up every
+     * frame. Iteration yields a tuple of the entity and references to its
+     * components:
+     *
+     * @code
+     * for (auto [entity, position, velocity] : manager.view<PositionC, VelocityC>())
+     * {
+     *     position.value += velocity.value * deltaTime;
+     * }
+     * @endcode
+     *
+     * Adding or removing components of the viewed types while iterating
+     * invalidates the iteration.
+     */
+    template <typename... Ts>
+    class View : public ViewBase
+    {
+        static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    public:
+        /**
+         * @brief Tuple yielded for each matching entity
+         */
+        using Row = std::tuple<Entity &, Ts &...>;
+
+        /**
+         * @brief Forward iterator over the matching entities
+         */
+        class Iterator
+        {
+        public:
+            /**
+             * @brief Constructor
+             * @param view View being iterated
+             * @param position Position in the membership list
+             */
+            Iterator(const View *view, size_t position) : view(view), position(position) {}
+
+            /**
+             * @brief Gets the current row
+             * @return Tuple of the entity and its components
+             */
+            Row operator*() const { return view->row(view->members[position]); }
+
+            /**
+             * @brief Advances to the next matching entity
+             * @return Reference to this iterator
+             */
+            Iterator &operator++()
+            {
+                ++position;
+                return *this;
+            }
+
+            /**
+             * @brief Equality operator
+             * @param other Iterator to compare with
+             * @return True if both iterators point to the same position
+             */
+            bool operator==(const Iterator &other) const { return position == other.position; }
+
+            /**
+             * @brief Inequality operator
+             * @param other Iterator to compare with
+             * @return True if the iterators point to different positions
+             */
+            bool operator!=(const Iterator &other) const { return position != other.position; }
+
+        private:
+            /**
+             * @brief View being iterated
+             */
+            const View *view;
+
+            /**
+             * @brief Position in the membership list
+             */
+            size_t position;
+        };
+
+        /**
+         * @brief Constructor
+         * @param entities Entity slots of the owning manager
+         * @param pools Pools of the viewed component types
+         *
+         * The initial membership is built once by scanning the smallest pool;
+         * afterwards it is only updated incrementally.
+         */
+        View(const std::vector<Entity *> &entities, ComponentPool<Ts> &...pools)
+            : entities(entities),
+              pools(&pools...)
+        {
+            const ComponentPoolBase *candidates[] = {&pools...};
+            const ComponentPoolBase *smallest = candidates[0];
+            for (const ComponentPoolBase *pool : candidates)
+            {
+                if (pool->size() < smallest->size())
+                {
+                    smallest = pool;
+                }
+            }
+
+            for (uint32_t entityIndex : smallest->getEntities())
+            {
+                if (matches(entityIndex))
+                {
+                    insert(entityIndex);
+                }
+            }
+        }
+
+        /**
+         * @brief Gets an iterator to the first matching entity
+         * @return Begin iterator
+         */
+        Iterator begin() const { return Iterator(this, 0); }
+
+        /**
+         * @brief Gets an iterator past the last matching entity
+         * @return End iterator
+         */
+        Iterator end() const { return Iterator(this, members.size()); }
+
+        /**
+         * @brief Calls a function for every matching entity
+         * @tparam Func Callable taking (Entity &, Ts &...)
+         * @param func Function to call
+         */
+        template <typename Func>
+        void each(Func &&func) const
+        {
+            for (uint32_t entityIndex : members)
+            {
+                func(*entities[entityIndex], std::get<ComponentPool<Ts> *>(pools)->at(denseIndex<Ts>(entityIndex))...);
+            }
+        }
+
+        /**
+         * @brief Called after a component was added to an entity
+         * @param entityIndex Entity slot index
+         */
+        void onComponentAdded(uint32_t entityIndex) override
+        {
+            if (!ViewBase::contains(entityIndex) && matches(entityIndex))
+            {
+                insert(entityIndex);
+            }
+        }
+
+        /**
+         * @brief Called before a component is removed from an entity
+         * @param entityIndex Entity slot index
+         */
+        void onComponentRemoved(uint32_t entityIndex) override
+        {
+            if (ViewBase::contains(entityIndex))
+            {
+                erase(entityIndex);
+            }
+        }
+
+    private:
+        /**
+         * @brief Checks if an entity has every viewed component
+         * @param entityIndex Entity slot index
+         * @return True if the entity matches the view
+         */
+        bool matches(uint32_t entityIndex) const
+        {
+            return (std::get<ComponentPool<Ts> *>(pools)->contains(entityIndex) && ...);
+        }
+
+        /**
+         * @brief Gets the dense index of a member's component
+         * @tparam T Component type
+         * @param entityIndex Entity slot index of a member
+         * @return Dense index in the pool of T
+         */
+        template <typename T>
+        size_t denseIndex(uint32_t entityIndex) const
+        {
+            return std::get<ComponentPool<T> *>(pools)->indexOf(entityIndex);
+        }
+
+        /**
+         * @brief Builds the row for a member
+         * @param entityIndex Entity slot index of a member
+         * @return Tuple of the entity and its components
+         */
+        Row row(uint32_t entityIndex) const
+        {
+            return Row(*entities[entityIndex], std::get<ComponentPool<Ts> *>(pools)->at(denseIndex<Ts>(entityIndex))...);
+        }
+
+        /**
+         * @brief Entity slots of the owning manager
+         */
+        const std::vector<Entity *> &entities;
+
+        /**
+         * @brief Pools of the viewed component types
+         */
+        std::tuple<ComponentPool<Ts> *...> pools;
+    };
+
+} // namespace Engine
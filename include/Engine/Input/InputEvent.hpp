@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Engine/Core/SPSCQueue.hpp"
+#include "Engine/Input/InputMapping.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Kind of an input event
+     */
+    enum class InputEventType : uint8_t
+    {
+        Key,
+        MouseButton,
+        MouseMove,
+        MouseScroll,
+        GamepadButton,
+        GamepadAxis
+    };
+
+    /**
+     * @brief Input change reported by the window
+     */
+    struct InputEvent
+    {
+        /**
+         * @brief Kind of the event, selects the fields below that are valid
+         */
+        InputEventType type = InputEventType::Key;
+
+        /**
+         * @brief True for a press, false for a release (Key, MouseButton, GamepadButton)
+         */
+        bool pressed = false;
+
+        /**
+         * @brief Key that changed (Key)
+         */
+        Key key = Key::Unknown;
+
+        /**
+         * @brief Mouse button that changed (MouseButton)
+         */
+        MouseButton mouseButton = MouseButton::Unknown;
+
+        /**
+         * @brief Gamepad button that changed (GamepadButton)
+         */
+        GamepadButton gamepadButton = GamepadButton::Unknown;
+
+        /**
+         * @brief Gamepad axis that changed (GamepadAxis)
+         */
+        GamepadAxis gamepadAxis = GamepadAxis::Unknown;
+
+        /**
+         * @brief Cursor position (MouseMove), scroll offset (MouseScroll), or axis value in x (GamepadAxis)
+         */
+        float x = 0.0f;
+        float y = 0.0f;
+
+        /**
+         * @brief Time the window received the event, in nanoseconds on the clock of Profiler::now()
+         */
+        uint64_t timestamp = 0;
+    };
+
+    /**
+     * @brief Queue from the thread that polls the window to the input manager
+     */
+    using InputEventQueue = SPSCQueue<InputEvent>;
+
+} // namespace Engine
@@ -1,23 +1,63 @@
 // include/Engine/Input/InputManager.hpp
 #pragma once
 
-#include <unordered_map>
-#include <vector>
 #include <array>
-#include <functional>
-#include <memory>
+#include <cstdint>
+#include <vector>
 
+#include "Engine/Core/InplaceFunction.hpp"
+#include "Engine/Input/InputEvent.hpp"
 #include "Engine/Input/InputMapping.hpp"
+#include "Engine/Math/Vector.hpp"
 
 namespace Engine
 {
 
     class Window;
 
+    /**
+     * @brief Key callback, stored inline without allocating
+     */
+    using KeyCallback = InplaceFunction<void()>;
+
+    /**
+     * @brief State of an action in the current frame
+     */
+    struct ActionState
+    {
+        /**
+         * @brief True while any bound input is held or its axis is past the dead zone
+         */
+        bool down = false;
+
+        /**
+         * @brief True in the frame the action went down, even if it was released in the same frame
+         */
+        bool justPressed = false;
+
+        /**
+         * @brief True in the frame the action was released
+         */
+        bool justReleased = false;
+
+        /**
+         * @brief Strongest bound input, 1 for a held button or key, the scaled value for an axis
+         */
+        float value = 0.0f;
+
+        /**
+         * @brief Time of the newest input event that changed a bound input, on the clock of Profiler::now()
+         */
+        uint64_t timestamp = 0;
+    };
+
     /**
      * @brief Input manager class
      *
      * The input manager is responsible for tracking keyboard, mouse, and gamepad input.
+     * The window pushes input events into a lock-free queue as they arrive;
+     * update() drains the queue once per frame, fires the key callbacks and
+     * builds a snapshot of every action, which systems then read by ActionId.
      */
     class InputManager
     {
@@ -41,6 +81,8 @@ namespace Engine
 
         /**
          * @brief Updates the input manager
+         *
+         * Polls the window, applies the queued events and rebuilds the action states.
          */
         void update();
 
@@ -91,6 +133,20 @@ namespace Engine
          */
         bool isMouseButtonJustReleased(MouseButton button) const;
 
+        /**
+         * @brief Checks if a gamepad button is currently pressed
+         * @param button Gamepad button to check
+         * @return True if the gamepad button is pressed, false otherwise
+         */
+        bool isGamepadButtonPressed(GamepadButton button) const;
+
+        /**
+         * @brief Gets the value of a gamepad axis
+         * @param axis Gamepad axis
+         * @return Axis value in [-1, 1], 0 if no gamepad is connected
+         */
+        float getGamepadAxis(GamepadAxis axis) const;
+
         /**
          * @brief Gets the mouse position
          * @return Mouse position
@@ -109,14 +165,61 @@ namespace Engine
          */
         const Vector2 &getMouseScroll() const { return mouseScroll; }
 
+        /**
+         * @brief Gets the input mapping used to build the action states
+         * @return Input mapping
+         */
+        InputMapping &getMapping() { return mapping; }
+
+        /**
+         * @brief Gets the state of an action in the current frame
+         * @param id Action ID
+         * @return Action state, all false for an unknown ID
+         */
+        const ActionState &getActionState(ActionId id) const
+        {
+            return id < actionStates.size() ? actionStates[id] : emptyActionState;
+        }
+
+        /**
+         * @brief Checks if an action is held
+         * @param id Action ID
+         * @return True if the action is down, false otherwise
+         */
+        bool isActionDown(ActionId id) const { return getActionState(id).down; }
+
+        /**
+         * @brief Checks if an action was just pressed
+         * @param id Action ID
+         * @return True if the action was pressed this frame, false otherwise
+         */
+        bool isActionJustPressed(ActionId id) const { return getActionState(id).justPressed; }
+
+        /**
+         * @brief Checks if an action was just released
+         * @param id Action ID
+         * @return True if the action was released this frame, false otherwise
+         */
+        bool isActionJustReleased(ActionId id) const { return getActionState(id).justReleased; }
+
+        /**
+         * @brief Gets the value of an action
+         * @param id Action ID
+         * @return Action value, 0 if the action is not down
+         */
+        float getActionValue(ActionId id) const { return getActionState(id).value; }
+
         /**
          * @brief Registers a key callback
          * @param key Key to register
          * @param state Key state to register for
          * @param callback Callback function
          * @return Callback ID
+         *
+         * Pressed and JustPressed callbacks fire once when the key goes down,
+         * Released and JustReleased callbacks once when it goes up.
          */
-        uint32_t registerKeyCallback(Key key, KeyState state, std::function<void()> callback);
+        uint32_t registerKeyCallback(Key key, KeyState state, KeyCallback callback);
 
         /**
          * @brief Unregisters a key callback
@@ -126,30 +229,136 @@ namespace Engine
         bool unregisterKeyCallback(uint32_t id);
 
     private:
+        /**
+         * @brief State of a set of buttons
+         * @tparam Count Number of buttons
+         */
+        template <size_t Count>
+        struct ButtonStates
+        {
+            /**
+             * @brief Buttons currently held
+             */
+            std::array<bool, Count> down{};
+
+            /**
+             * @brief Buttons pressed since the last update
+             */
+            std::array<bool, Count> pressed{};
+
+            /**
+             * @brief Buttons released since the last update
+             */
+            std::array<bool, Count> released{};
+
+            /**
+             * @brief Time of the last change of each button
+             */
+            std::array<uint64_t, Count> timestamps{};
+
+            /**
+             * @brief Clears the per-frame transitions
+             */
+            void beginFrame()
+            {
+                pressed.fill(false);
+                released.fill(false);
+            }
+
+            /**
+             * @brief Applies a press or release
+             * @param index Button index
+             * @param isDown True for a press
+             * @param timestamp Time of the event
+             * @return True if the button changed state
+             */
+            bool apply(size_t index, bool isDown, uint64_t timestamp)
+            {
+                if (index >= Count || down[index] == isDown)
+                {
+                    return false;
+                }
+
+                down[index] = isDown;
+                (isDown ? pressed : released)[index] = true;
+                timestamps[index] = timestamp;
+                return true;
+            }
+        };
+
+        /**
+         * @brief Registered key callback
+         */
+        struct KeyCallbackEntry
+        {
+            uint32_t id;
+            Key key;
+
+            /**
+             * @brief True to fire on press, false to fire on release
+             */
+            bool onPress;
+
+            KeyCallback callback;
+        };
+
+        /**
+         * @brief Applies one event to the input state
+         * @param event Input event
+         */
+        void applyEvent(const InputEvent &event);
+
+        /**
+         * @brief Calls the callbacks registered for a key transition
+         * @param key Key that changed
+         * @param pressed True if the key went down
+         */
+        void dispatchKeyCallbacks(Key key, bool pressed);
+
+        /**
+         * @brief Rebuilds the action states from the bindings
+         */
+        void updateActions();
+
+        /**
+         * @brief Number of events the window can queue between two updates
+         */
+        static constexpr size_t EventQueueCapacity = 1024;
+
         /**
          * @brief Window to capture input from
          */
         Window *window;
 
         /**
-         * @brief Current keyboard state
+         * @brief Events pushed by the window, drained by update()
+         */
+        InputEventQueue events;
+
+        /**
+         * @brief Keyboard state
          */
-        std::array<bool, static_cast<size_t>(Key::Count)> keyState;
+        ButtonStates<static_cast<size_t>(Key::Count)> keys;
 
         /**
-         * @brief Previous keyboard state
+         * @brief Mouse button state
          */
-        std::array<bool, static_cast<size_t>(Key::Count)> prevKeyState;
+        ButtonStates<static_cast<size_t>(MouseButton::Count)> mouseButtons;
 
         /**
-         * @brief Current mouse button state
+         * @brief Gamepad button state
          */
-        std::array<bool, static_cast<size_t>(MouseButton::Count)> mouseButtonState;
+        ButtonStates<static_cast<size_t>(GamepadButton::Count)> gamepadButtons;
 
         /**
-         * @brief Previous mouse button state
+         * @brief Gamepad axis values
          */
-        std::array<bool, static_cast<size_t>(MouseButton::Count)> prevMouseButtonState;
+        std::array<float, static_cast<size_t>(GamepadAxis::Count)> gamepadAxes;
+
+        /**
+         * @brief Time of the last change of each gamepad axis
+         */
+        std::array<uint64_t, static_cast<size_t>(GamepadAxis::Count)> gamepadAxisTimestamps;
 
         /**
          * @brief Current mouse position
@@ -157,10 +366,15 @@ namespace Engine
         Vector2 mousePosition;
 
         /**
-         * @brief Previous mouse position
+         * @brief Mouse position at the previous update
          */
         Vector2 prevMousePosition;
 
+        /**
+         * @brief True once the window reported a cursor position
+         */
+        bool hasMousePosition;
+
         /**
          * @brief Mouse movement since the last update
          */
@@ -171,16 +385,45 @@ namespace Engine
          */
         Vector2 mouseScroll;
 
+        /**
+         * @brief Named actions and their bindings
+         */
+        InputMapping mapping;
+
+        /**
+         * @brief Action states of the current frame, indexed by ActionId
+         */
+        std::vector<ActionState> actionStates;
+
+        /**
+         * @brief State returned for unknown action IDs
+         */
+        ActionState emptyActionState;
+
         /**
          * @brief Next callback ID
          */
         uint32_t nextCallbackId;
 
         /**
-         * @brief Map of key callbacks
+         * @brief Key callbacks indexed by key
+         */
+        std::array<std::vector<KeyCallbackEntry>, static_cast<size_t>(Key::Count)> keyCallbacks;
+
+        /**
+         * @brief Callbacks registered while callbacks are running, added after dispatch
+         */
+        std::vector<KeyCallbackEntry> pendingKeyCallbacks;
+
+        /**
+         * @brief True while key callbacks are running
+         */
+        bool dispatching;
+
+        /**
+         * @brief True if a callback was unregistered during dispatch and its slot must be removed
          */
-        std::unordered_map<Key, std::vector<std::pair<uint32_t, std::function<void()>>>> keyPressedCallbacks;
-        std::unordered_map<Key, std::vector<std::pair<uint32_t, std::function<void()>>>> keyReleasedCallbacks;
+        bool hasRemovedCallbacks;
     };
 
 } // namespace Engine
@@ -188,8 +431,10 @@ namespace Engine
 // include/Engine/Input/InputMapping.hpp
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Engine
 {
@@ -339,31 +584,55 @@ namespace Engine
     };
 
     /**
-     * @brief Input action
+     * @brief Interned action identifier, indexes the per-frame action states
      */
-    struct InputAction
-    {
-        std::string name;
-        bool continuous;
-    };
+    using ActionId = uint32_t;
+
+    /**
+     * @brief ID that no action has
+     */
+    constexpr ActionId InvalidAction = 0xFFFFFFFFu;
 
     /**
      * @brief Input binding
+     *
+     * Binds one input to an action; the inputs that are not used are Unknown.
      */
     struct InputBinding
     {
-        Key key;
-        MouseButton mouseButton;
-        GamepadButton gamepadButton;
-        GamepadAxis gamepadAxis;
-        float axisDeadZone;
-        float axisScale;
+        Key key = Key::Unknown;
+        MouseButton mouseButton = MouseButton::Unknown;
+        GamepadButton gamepadButton = GamepadButton::Unknown;
+        GamepadAxis gamepadAxis = GamepadAxis::Unknown;
+        float axisDeadZone = 0.0f;
+        float axisScale = 1.0f;
+    };
+
+    /**
+     * @brief Input action
+     */
+    struct InputAction
+    {
+        std::string name;
+        bool continuous = false;
+
+        /**
+         * @brief False once the action was unregistered; its ID is never reused
+         */
+        bool registered = false;
+
+        /**
+         * @brief Inputs that trigger the action
+         */
+        std::vector<InputBinding> bindings;
     };
 
     /**
      * @brief Input mapping manager
      *
      * The input mapping manager is responsible for mapping input actions to input bindings.
+     * Action names are interned once into ActionIds, so that reading an
+     * action every frame is an array lookup instead of a string hash.
      */
     class InputMapping
     {
@@ -382,9 +651,9 @@ namespace Engine
          * @brief Registers an input action
          * @param name Action name
          * @param continuous True if the action is continuous, false if it's discrete
-         * @return True if the action was registered, false if it already exists
+         * @return ID of the action, or InvalidAction if it already exists
          */
-        bool registerAction(const std::string &name, bool continuous = false);
+        ActionId registerAction(const std::string &name, bool continuous = false);
 
         /**
          * @brief Unregisters an input action
@@ -393,6 +662,28 @@ namespace Engine
          */
         bool unregisterAction(const std::string &name);
 
+        /**
+         * @brief Gets the ID of an action
+         * @param name Action name
+         * @return ID of the action, or InvalidAction if it doesn't exist
+         *
+         * Look the ID up once, for example when a system initializes, and keep it.
+         */
+        ActionId getActionId(const std::string &name) const;
+
+        /**
+         * @brief Gets an action by ID
+         * @param id Action ID
+         * @return Pointer to the action, or nullptr if it doesn't exist
+         */
+        const InputAction *getAction(ActionId id) const;
+
+        /**
+         * @brief Gets all actions indexed by ID, including unregistered ones
+         * @return Actions
+         */
+        const std::vector<InputAction> &getActions() const { return actions; }
+
         /**
          * @brief Binds a key to an action
          * @param actionName Action name
@@ -461,14 +752,39 @@ namespace Engine
 
     private:
         /**
-         * @brief Map of input actions
+         * @brief Finds a registered action by name
+         * @param name Action name
+         * @return Pointer to the action, or nullptr if it doesn't exist
+         */
+        InputAction *findAction(const std::string &name);
+
+        /**
+         * @brief Adds a binding to an action
+         * @param actionName Action name
+         * @param binding Binding to add
+         * @return True if the binding was added, false if the action doesn't exist
+         */
+        bool addBinding(const std::string &actionName, const InputBinding &binding);
+
+        /**
+         * @brief Removes the bindings of an action that match a predicate
+         * @tparam Match Callable taking a const InputBinding &
+         * @param actionName Action name
+         * @param match Predicate selecting the bindings to remove
+         * @return True if a binding was removed
+         */
+        template <typename Match>
+        bool removeBindings(const std::string &actionName, Match match);
+
+        /**
+         * @brief Input actions indexed by ID
          */
-        std::unordered_map<std::string, InputAction> actions;
+        std::vector<InputAction> actions;
 
         /**
-         * @brief Map of input bindings
+         * @brief Action IDs by name
          */
-        std::unordered_map<std::string, std::vector<InputBinding>> bindings;
+        std::unordered_map<std::string, ActionId> actionIds;
     };
 
 } // namespace Engine
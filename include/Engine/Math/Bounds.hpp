@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Math/Matrix.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Axis-aligned bounding box
+     */
+    struct BoundingBox
+    {
+        /**
+         * @brief Minimum corner
+         */
+        Vector3 min;
+
+        /**
+         * @brief Maximum corner
+         */
+        Vector3 max;
+
+        /**
+         * @brief Constructor, creates an empty box
+         */
+        BoundingBox();
+
+        /**
+         * @brief Constructor
+         * @param min Minimum corner
+         * @param max Maximum corner
+         */
+        BoundingBox(const Vector3 &min, const Vector3 &max);
+
+        /**
+         * @brief Checks if the box contains no point
+         * @return True if nothing was added to the box
+         */
+        bool isEmpty() const { return min.x > max.x; }
+
+        /**
+         * @brief Grows the box to contain a point
+         * @param point Point to contain
+         */
+        void expand(const Vector3 &point);
+
+        /**
+         * @brief Gets the center of the box
+         * @return Center
+         */
+        Vector3 getCenter() const;
+
+        /**
+         * @brief Gets the half size of the box
+         * @return Half extents along each axis
+         */
+        Vector3 getExtents() const;
+
+        /**
+         * @brief Gets the box that contains this box after a transformation
+         * @param transform Transformation matrix
+         * @return Axis-aligned box in the transformed space
+         */
+        BoundingBox transformed(const Matrix4 &transform) const;
+
+        /**
+         * @brief Gets the box grown by the same amount on every side
+         * @param amount Distance to move every face outwards
+         * @return Grown box
+         */
+        BoundingBox expanded(float amount) const;
+
+        /**
+         * @brief Checks if another box lies completely inside this box
+         * @param other Box to check
+         * @return True if the other box is contained
+         */
+        bool contains(const BoundingBox &other) const;
+
+        /**
+         * @brief Checks if two boxes overlap
+         * @param other Box to check
+         * @return True if the boxes share at least one point
+         */
+        bool intersects(const BoundingBox &other) const;
+
+        /**
+         * @brief Gets the surface area, used as the cost of tree nodes
+         * @return Surface area
+         */
+        float getSurfaceArea() const;
+
+        /**
+         * @brief Gets the smallest box containing two boxes
+         * @param a First box
+         * @param b Second box
+         * @return Merged box
+         */
+        static BoundingBox merge(const BoundingBox &a, const BoundingBox &b);
+    };
+
+    /**
+     * @brief Bounding sphere
+     */
+    struct BoundingSphere
+    {
+        /**
+         * @brief Center
+         */
+        Vector3 center;
+
+        /**
+         * @brief Radius, negative for an empty sphere
+         */
+        float radius = -1.0f;
+
+        /**
+         * @brief Checks if the sphere contains no point
+         * @return True if the radius is negative
+         */
+        bool isEmpty() const { return radius < 0.0f; }
+
+        /**
+         * @brief Gets the sphere that contains this sphere after a transformation
+         * @param transform Transformation matrix
+         * @return Sphere in the transformed space
+         *
+         * Non-uniform scaling grows the radius by the largest axis scale.
+         */
+        BoundingSphere transformed(const Matrix4 &transform) const;
+
+        /**
+         * @brief Checks if the sphere overlaps a box
+         * @param box Box to check
+         * @return True if the sphere and box share at least one point
+         */
+        bool intersects(const BoundingBox &box) const;
+    };
+
+    /**
+     * @brief Half-line starting at an origin
+     */
+    struct Ray
+    {
+        /**
+         * @brief Start point
+         */
+        Vector3 origin;
+
+        /**
+         * @brief Direction; distances along the ray are measured in its length
+         */
+        Vector3 direction;
+
+        /**
+         * @brief Gets the point at a distance along the ray
+         * @param distance Distance in units of the direction length
+         * @return Point on the ray
+         */
+        Vector3 getPoint(float distance) const
+        {
+            return Vector3(origin.x + direction.x * distance,
+                           origin.y + direction.y * distance,
+                           origin.z + direction.z * distance);
+        }
+
+        /**
+         * @brief Intersects the ray with a box
+         * @param box Box to test
+         * @param maxDistance Ignore hits further away than this
+         * @param distance Receives the distance to the entry point, 0 if the origin is inside
+         * @return True if the ray hits the box within maxDistance
+         */
+        bool intersects(const BoundingBox &box, float maxDistance, float &distance) const;
+    };
+
+    /**
+     * @brief Bounding spheres stored as separate coordinate arrays
+     *
+     * Lets tests run on several spheres at once with SIMD instructions.
+     */
+    struct BoundingSphereBatch
+    {
+        /**
+         * @brief Center X coordinates
+         */
+        std::vector<float> x;
+
+        /**
+         * @brief Center Y coordinates
+         */
+        std::vector<float> y;
+
+        /**
+         * @brief Center Z coordinates
+         */
+        std::vector<float> z;
+
+        /**
+         * @brief Radii
+         */
+        std::vector<float> radius;
+
+        /**
+         * @brief Appends a sphere
+         * @param sphere Sphere to append
+         */
+        void add(const BoundingSphere &sphere)
+        {
+            x.push_back(sphere.center.x);
+            y.push_back(sphere.center.y);
+            z.push_back(sphere.center.z);
+            radius.push_back(sphere.radius);
+        }
+
+        /**
+         * @brief Removes all spheres, keeping the allocations
+         */
+        void clear()
+        {
+            x.clear();
+            y.clear();
+            z.clear();
+            radius.clear();
+        }
+
+        /**
+         * @brief Gets the number of spheres
+         * @return Number of spheres
+         */
+        size_t size() const { return radius.size(); }
+    };
+
+} // namespace Engine
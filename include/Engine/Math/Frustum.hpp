@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Bounds.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Plane in the form dot(normal, p) + distance = 0
+     */
+    struct Plane
+    {
+        /**
+         * @brief Unit normal, pointing to the inside
+         */
+        Vector3 normal;
+
+        /**
+         * @brief Signed distance of the origin along the normal
+         */
+        float distance = 0.0f;
+
+        /**
+         * @brief Gets the signed distance of a point
+         * @param point Point
+         * @return Distance, positive on the side the normal points to
+         */
+        float distanceTo(const Vector3 &point) const
+        {
+            return normal.x * point.x + normal.y * point.y + normal.z * point.z + distance;
+        }
+    };
+
+    /**
+     * @brief View frustum made of six inward-facing planes
+     */
+    class Frustum
+    {
+    public:
+        /**
+         * @brief Plane indices
+         */
+        enum PlaneIndex
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+
+        /**
+         * @brief Result of classifying a volume against the frustum
+         */
+        enum class Containment
+        {
+            Outside,
+            Intersecting,
+            Inside
+        };
+
+        /**
+         * @brief Constructor, creates a frustum that contains everything
+         */
+        Frustum();
+
+        /**
+         * @brief Extracts the frustum from a view-projection matrix
+         * @param viewProjection Projection matrix times view matrix (OpenGL clip space)
+         * @return Frustum in world space
+         */
+        static Frustum fromMatrix(const Matrix4 &viewProjection);
+
+        /**
+         * @brief Checks if a sphere is at least partly inside the frustum
+         * @param sphere Sphere to test
+         * @return True if the sphere may be visible
+         */
+        bool intersects(const BoundingSphere &sphere) const;
+
+        /**
+         * @brief Checks if a box is at least partly inside the frustum
+         * @param box Box to test
+         * @return True if the box may be visible
+         */
+        bool intersects(const BoundingBox &box) const;
+
+        /**
+         * @brief Classifies a box against the frustum
+         * @param box Box to classify
+         * @return Outside, Intersecting, or Inside if no plane cuts the box
+         *
+         * Lets hierarchy traversals accept whole subtrees without further tests.
+         */
+        Containment classify(const BoundingBox &box) const;
+
+        /**
+         * @brief Tests many spheres against the frustum
+         * @param spheres Spheres to test
+         * @param visible Receives 1 for every sphere that may be visible and 0 otherwise
+         *
+         * Tests four spheres per iteration where SSE is available.
+         */
+        void cullSpheres(const BoundingSphereBatch &spheres, std::vector<uint8_t> &visible) const;
+
+        /**
+         * @brief Gets a plane
+         * @param index Plane index
+         * @return Plane
+         */
+        const Plane &getPlane(PlaneIndex index) const { return planes[index]; }
+
+    private:
+        /**
+         * @brief Planes, indexed by PlaneIndex
+         */
+        Plane planes[PlaneCount];
+    };
+
+} // namespace Engine
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Quaternion.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Vectors stored as separate coordinate arrays
+     */
+    struct Vector3Batch
+    {
+        /**
+         * @brief X coordinates
+         */
+        std::vector<float> x;
+
+        /**
+         * @brief Y coordinates
+         */
+        std::vector<float> y;
+
+        /**
+         * @brief Z coordinates
+         */
+        std::vector<float> z;
+
+        /**
+         * @brief Appends a vector
+         * @param vector Vector to append
+         */
+        void add(const Vector3 &vector)
+        {
+            x.push_back(vector.x);
+            y.push_back(vector.y);
+            z.push_back(vector.z);
+        }
+
+        /**
+         * @brief Gets a vector
+         * @param index Vector index
+         * @return Vector at the index
+         */
+        Vector3 get(size_t index) const { return Vector3(x[index], y[index], z[index]); }
+
+        /**
+         * @brief Replaces a vector
+         * @param index Vector index
+         * @param vector New vector
+         */
+        void set(size_t index, const Vector3 &vector)
+        {
+            x[index] = vector.x;
+            y[index] = vector.y;
+            z[index] = vector.z;
+        }
+
+        /**
+         * @brief Resizes the batch, filling new entries with zero vectors
+         * @param count New number of vectors
+         */
+        void resize(size_t count)
+        {
+            x.resize(count);
+            y.resize(count);
+            z.resize(count);
+        }
+
+        /**
+         * @brief Removes all vectors, keeping the allocations
+         */
+        void clear()
+        {
+            x.clear();
+            y.clear();
+            z.clear();
+        }
+
+        /**
+         * @brief Gets the number of vectors
+         * @return Number of vectors
+         */
+        size_t size() const { return x.size(); }
+    };
+
+    /**
+     * @brief Quaternions stored as separate component arrays
+     */
+    struct QuaternionBatch
+    {
+        /**
+         * @brief X components
+         */
+        std::vector<float> x;
+
+        /**
+         * @brief Y components
+         */
+        std::vector<float> y;
+
+        /**
+         * @brief Z components
+         */
+        std::vector<float> z;
+
+        /**
+         * @brief W components
+         */
+        std::vector<float> w;
+
+        /**
+         * @brief Appends a quaternion
+         * @param quaternion Quaternion to append
+         */
+        void add(const Quaternion &quaternion)
+        {
+            x.push_back(quaternion.getX());
+            y.push_back(quaternion.getY());
+            z.push_back(quaternion.getZ());
+            w.push_back(quaternion.getW());
+        }
+
+        /**
+         * @brief Gets a quaternion
+         * @param index Quaternion index
+         * @return Quaternion at the index
+         */
+        Quaternion get(size_t index) const { return Quaternion(x[index], y[index], z[index], w[index]); }
+
+        /**
+         * @brief Replaces a quaternion
+         * @param index Quaternion index
+         * @param quaternion New quaternion
+         */
+        void set(size_t index, const Quaternion &quaternion)
+        {
+            x[index] = quaternion.getX();
+            y[index] = quaternion.getY();
+            z[index] = quaternion.getZ();
+            w[index] = quaternion.getW();
+        }
+
+        /**
+         * @brief Resizes the batch, filling new entries with identity rotations
+         * @param count New number of quaternions
+         */
+        void resize(size_t count)
+        {
+            x.resize(count, 0.0f);
+            y.resize(count, 0.0f);
+            z.resize(count, 0.0f);
+            w.resize(count, 1.0f);
+        }
+
+        /**
+         * @brief Removes all quaternions, keeping the allocations
+         */
+        void clear()
+        {
+            x.clear();
+            y.clear();
+            z.clear();
+            w.clear();
+        }
+
+        /**
+         * @brief Gets the number of quaternions
+         * @return Number of quaternions
+         */
+        size_t size() const { return x.size(); }
+    };
+
+    /**
+     * @brief Math over whole arrays of vectors, quaternions, and transforms
+     *
+     * Every function processes the elements in [begin, end), clamped to the
+     * size of the inputs, so callers can split one batch into chunks for
+     * JobSystem::parallelFor(). Outputs must already hold at least end
+     * elements and may be the same batch as an input. Four elements are
+     * processed at a time with SSE2 when available; elsewhere the plain
+     * loops over the coordinate arrays are left to the compiler to vectorize.
+     */
+    namespace MathBatch
+    {
+        /**
+         * @brief Marks the end of a batch
+         */
+        const size_t All = SIZE_MAX;
+
+        /**
+         * @brief Normalizes vectors in place
+         * @param vectors Vectors to normalize; zero vectors stay zero
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void normalize(Vector3Batch &vectors, size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Normalizes quaternions in place
+         * @param quaternions Quaternions to normalize; degenerate ones become the identity
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void normalize(QuaternionBatch &quaternions, size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Normalized linear interpolation along the shortest path
+         * @param from Start rotations (unit length)
+         * @param to End rotations (unit length)
+         * @param t Interpolation factor shared by all elements (clamped to 0.0 to 1.0)
+         * @param out Receives the interpolated rotations
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void nlerp(const QuaternionBatch &from, const QuaternionBatch &to, float t, QuaternionBatch &out,
+                   size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Normalized linear interpolation with one factor per element
+         * @param from Start rotations (unit length)
+         * @param to End rotations (unit length)
+         * @param t Interpolation factor per element (clamped to 0.0 to 1.0)
+         * @param out Receives the interpolated rotations
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void nlerp(const QuaternionBatch &from, const QuaternionBatch &to, const float *t, QuaternionBatch &out,
+                   size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Spherical linear interpolation along the shortest path
+         * @param from Start rotations (unit length)
+         * @param to End rotations (unit length)
+         * @param t Interpolation factor shared by all elements (clamped to 0.0 to 1.0)
+         * @param out Receives the interpolated rotations
+         * @param begin First index
+         * @param end One past the last index
+         *
+         * Evaluates the slerp weights with a polynomial instead of acos and
+         * sin, so there are no branches per element; the weights are within
+         * 1e-6 of the exact ones, which Quaternion::slerp() computes.
+         */
+        void slerp(const QuaternionBatch &from, const QuaternionBatch &to, float t, QuaternionBatch &out,
+                   size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Spherical linear interpolation with one factor per element
+         * @param from Start rotations (unit length)
+         * @param to End rotations (unit length)
+         * @param t Interpolation factor per element (clamped to 0.0 to 1.0)
+         * @param out Receives the interpolated rotations
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void slerp(const QuaternionBatch &from, const QuaternionBatch &to, const float *t, QuaternionBatch &out,
+                   size_t begin = 0, size_t end = All);
+
+        /**
+         * @brief Builds translation * rotation * scale matrices
+         * @param translations Translations
+         * @param rotations Rotations (unit length)
+         * @param scales Scale factors
+         * @param out Receives one matrix per element, indexed like the inputs
+         * @param begin First index
+         * @param end One past the last index
+         */
+        void composeTRS(const Vector3Batch &translations, const QuaternionBatch &rotations, const Vector3Batch &scales,
+                        Matrix4 *out, size_t begin = 0, size_t end = All);
+    }
+
+} // namespace Engine
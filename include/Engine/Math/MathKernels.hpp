@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+ * Instruction set selection. Exactly one of ENGINE_SIMD_SSE or
+ * ENGINE_SIMD_NEON is defined when SIMD kernels are available;
+ * ENGINE_SIMD_AVX is added on top of SSE when the compiler targets AVX.
+ * Define ENGINE_NO_SIMD to build the scalar kernels only.
+ */
+#if !defined(ENGINE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SIMD_SSE 1
+#if defined(__AVX__)
+#define ENGINE_SIMD_AVX 1
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ENGINE_SIMD_NEON 1
+#endif
+#endif
+
+namespace Engine
+{
+
+    /**
+     * @brief Low-level math kernels on raw float arrays
+     *
+     * Matrices are 16 floats in row-major order, as stored by Matrix4, and
+     * quaternions are 4 floats in (x, y, z, w) order. Every kernel has a
+     * scalar version that is always built; the unsuffixed version uses the
+     * best instruction set selected at compile time and falls back to the
+     * scalar one. Outputs may alias inputs.
+     */
+    namespace MathKernels
+    {
+        /**
+         * @brief Gets the instruction set the unsuffixed kernels use
+         * @return "AVX", "SSE2", "NEON", or "Scalar"
+         */
+        const char *getInstructionSet();
+
+        /**
+         * @brief Multiplies two 4x4 matrices
+         * @param a Left matrix
+         * @param b Right matrix
+         * @param out Receives a * b
+         */
+        void multiplyMatrix4(const float *a, const float *b, float *out);
+
+        /**
+         * @brief Scalar version of multiplyMatrix4()
+         */
+        void multiplyMatrix4Scalar(const float *a, const float *b, float *out);
+
+        /**
+         * @brief Multiplies a 4x4 matrix with a column vector
+         * @param m Matrix
+         * @param v Vector of 4 floats
+         * @param out Receives m * v
+         */
+        void transformVector4(const float *m, const float *v, float *out);
+
+        /**
+         * @brief Scalar version of transformVector4()
+         */
+        void transformVector4Scalar(const float *m, const float *v, float *out);
+
+        /**
+         * @brief Transforms points by a 4x4 matrix, assuming w = 1 and ignoring the projective row
+         * @param m Matrix
+         * @param points Points as consecutive (x, y, z) triples
+         * @param out Receives the transformed points, same layout
+         * @param count Number of points
+         */
+        void transformPoints(const float *m, const float *points, float *out, size_t count);
+
+        /**
+         * @brief Scalar version of transformPoints()
+         */
+        void transformPointsScalar(const float *m, const float *points, float *out, size_t count);
+
+        /**
+         * @brief Inverts a general 4x4 matrix
+         * @param m Matrix
+         * @param out Receives the inverse; left untouched if the matrix is singular
+         * @return False if the matrix is singular
+         */
+        bool inverseMatrix4(const float *m, float *out);
+
+        /**
+         * @brief Scalar version of inverseMatrix4()
+         */
+        bool inverseMatrix4Scalar(const float *m, float *out);
+
+        /**
+         * @brief Inverts an affine matrix whose last row is (0, 0, 0, 1)
+         * @param m Matrix
+         * @param out Receives the inverse; left untouched if the matrix is singular
+         * @return False if the 3x3 part is singular
+         *
+         * Cheaper than inverseMatrix4() for model and view matrices.
+         */
+        bool inverseAffine(const float *m, float *out);
+
+        /**
+         * @brief Scalar version of inverseAffine()
+         */
+        bool inverseAffineScalar(const float *m, float *out);
+
+        /**
+         * @brief Multiplies two quaternions (Hamilton product)
+         * @param a Left quaternion
+         * @param b Right quaternion
+         * @param out Receives a * b
+         */
+        void multiplyQuaternion(const float *a, const float *b, float *out);
+
+        /**
+         * @brief Scalar version of multiplyQuaternion()
+         */
+        void multiplyQuaternionScalar(const float *a, const float *b, float *out);
+
+        /**
+         * @brief Spherically interpolates between two rotations along the shortest path
+         * @param a Start quaternion
+         * @param b End quaternion
+         * @param t Interpolation factor, clamped to 0..1
+         * @param out Receives the normalized result
+         */
+        void slerpQuaternion(const float *a, const float *b, float t, float *out);
+
+        /**
+         * @brief Scalar version of slerpQuaternion()
+         */
+        void slerpQuaternionScalar(const float *a, const float *b, float t, float *out);
+    }
+
+} // namespace Engine
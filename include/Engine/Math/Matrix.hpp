@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <array>
+#include <cstddef>
 #include "Engine/Math/Vector.hpp"
 
 namespace Engine
@@ -302,6 +303,12 @@ namespace Engine
          */
         const float *getData() const { return data.data(); }
 
+        /**
+         * @brief Gets the matrix data for writing
+         * @return 16 elements in row-major order
+         */
+        float *getData() { return data.data(); }
+
         /**
          * @brief Gets a row of the matrix
          * @param row Row index (0-3)
@@ -362,6 +369,28 @@ namespace Engine
          */
         Vector4 operator*(const Vector4 &vec) const;
 
+        /**
+         * @brief Transforms a point, applying the translation
+         * @param point Point to transform
+         * @return Transformed point (assumes the bottom row is 0, 0, 0, 1)
+         */
+        Vector3 transformPoint(const Vector3 &point) const;
+
+        /**
+         * @brief Transforms a direction, ignoring the translation
+         * @param direction Direction to transform
+         * @return Transformed direction
+         */
+        Vector3 transformDirection(const Vector3 &direction) const;
+
+        /**
+         * @brief Transforms an array of points, applying the translation
+         * @param points Points to transform
+         * @param out Receives the transformed points; may be the same array as points
+         * @param count Number of points
+         */
+        void transformPoints(const Vector3 *points, Vector3 *out, size_t count) const;
+
         /**
          * @brief Multiplication operator (scalar)
          * @param scalar Scalar to multiply by
@@ -433,10 +462,19 @@ namespace Engine
 
         /**
          * @brief Calculates the inverse of the matrix
-         * @return Inverse matrix
+         * @return Inverse matrix, or identity if the matrix is singular
          */
         Matrix4 inverse() const;
 
+        /**
+         * @brief Calculates the inverse of an affine matrix
+         * @return Inverse matrix, or identity if the matrix is singular
+         *
+         * Cheaper than inverse() for transforms built from translation,
+         * rotation, and scale, whose bottom row is 0, 0, 0, 1.
+         */
+        Matrix4 inverseAffine() const;
+
         /**
          * @brief Calculates the transpose of the matrix
          * @return Transposed matrix
@@ -451,10 +489,10 @@ namespace Engine
 
         /**
          * @brief Creates a translation matrix
-         * @param translation Translation vector
+         * @param offset Translation vector
          * @return Translation matrix
          */
-        static Matrix4 translation(const Vector3 &translation);
+        static Matrix4 translation(const Vector3 &offset);
 
         /**
          * @brief Creates a translation matrix
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Engine/Math/Vector.hpp"
 #include "Engine/Math/Matrix.hpp"
 #include "Engine/Math/Quaternion.hpp"
@@ -7,6 +9,8 @@
 namespace Engine
 {
 
+    class TransformHierarchy;
+
     /**
      * @brief Transform class representing position, rotation, and scale
      */
@@ -26,6 +30,22 @@ namespace Engine
          */
         Transform(const Vector3 &position, const Vector3 &rotation, const Vector3 &scale);
 
+        /**
+         * @brief Copy constructor
+         * @param other Transform to copy, whose hierarchy registration is not copied
+         */
+        Transform(const Transform &other) = default;
+
+        /**
+         * @brief Copy assignment
+         * @param other Transform to copy
+         * @return Reference to this
+         *
+         * Keeps the hierarchy registration of this transform and takes the
+         * parent of the other through setParent().
+         */
+        Transform &operator=(const Transform &other);
+
         /**
          * @brief Sets the position
          * @param position Position
@@ -102,7 +122,7 @@ namespace Engine
          * @brief Gets the scale
          * @return Scale
          */
-        const Vector3 &getScale() const { return scale; }
+        const Vector3 &getScale() const { return localScale; }
 
         /**
          * @brief Translates the transform
@@ -179,12 +199,20 @@ namespace Engine
         /**
          * @brief Gets the world transformation matrix
          * @return World transformation matrix
+         *
+         * Cached, and kept up to date by the TransformHierarchy the transform
+         * belongs to. Recomputed on demand when this transform or one of its
+         * ancestors changed since then.
          */
         Matrix4 getWorldMatrix() const;
 
         /**
          * @brief Sets the parent transform
          * @param parent Parent transform
+         *
+         * A transform registered in a TransformHierarchy relinks itself
+         * there, so reparent it on the thread that owns the hierarchy and
+         * never during TransformHierarchy::update().
          */
         void setParent(Transform *parent);
 
@@ -207,7 +235,115 @@ namespace Engine
          */
         Transform lerp(const Transform &other, float t) const;
 
+        /**
+         * @brief Remembers the current position, rotation, and scale as the previous state
+         *
+         * Called before every fixed simulation step. Calling it right after
+         * teleporting a transform stops rendering from interpolating across
+         * the jump.
+         */
+        void storePreviousState();
+
+        /**
+         * @brief Enables or disables render interpolation
+         * @param enabled True to interpolate between the previous and current state
+         *
+         * Disable interpolation for transforms that are moved every frame
+         * instead of in fixed steps, such as cameras driven by update().
+         */
+        void setInterpolated(bool enabled) { interpolated = enabled; }
+
+        /**
+         * @brief Checks if render interpolation is enabled
+         * @return True if rendering interpolates this transform
+         */
+        bool isInterpolated() const { return interpolated; }
+
+        /**
+         * @brief Gets the local matrix between the previous and current state
+         * @param alpha Interpolation factor (0.0 is the previous state, 1.0 the current one)
+         * @return Interpolated local transformation matrix
+         */
+        Matrix4 getInterpolatedLocalMatrix(float alpha) const;
+
+        /**
+         * @brief Gets the world matrix between the previous and current state
+         * @param alpha Interpolation factor (0.0 is the previous state, 1.0 the current one)
+         * @return Interpolated world transformation matrix
+         */
+        Matrix4 getInterpolatedWorldMatrix(float alpha) const;
+
+        /**
+         * @brief Gets the version of the last change to the local transform or parent
+         * @return Version of the local transform
+         *
+         * Versions come from one counter shared by all transforms, so a
+         * change always gets a larger version than any earlier change of any
+         * transform.
+         */
+        uint64_t getVersion() const { return version; }
+
+        /**
+         * @brief Gets a value that changes whenever the world matrix may have changed
+         * @return Largest version of this transform and its ancestors
+         *
+         * A change anywhere in the chain, reparenting included, gets a
+         * version larger than every current one and so raises the largest.
+         * Lets caches of world-space data skip transforms that did not move.
+         */
+        uint64_t getWorldVersion() const;
+
     private:
+        friend class TransformHierarchy;
+
+        /**
+         * @brief Registration in a TransformHierarchy
+         *
+         * Copies start unregistered and assignment keeps the registration,
+         * since it belongs to the transform at this address.
+         */
+        struct HierarchyLink
+        {
+            /**
+             * @brief Default constructor (not registered)
+             */
+            HierarchyLink() = default;
+
+            /**
+             * @brief Copy constructor, not registered
+             */
+            HierarchyLink(const HierarchyLink &) {}
+
+            /**
+             * @brief Copy assignment, keeps the registration
+             * @return Reference to this
+             */
+            HierarchyLink &operator=(const HierarchyLink &) { return *this; }
+
+            /**
+             * @brief Hierarchy the transform is registered in, or nullptr
+             */
+            TransformHierarchy *hierarchy = nullptr;
+
+            /**
+             * @brief Node of the transform in the hierarchy
+             */
+            uint32_t node = 0;
+        };
+
+        /**
+         * @brief Stores a world matrix computed by the hierarchy
+         * @param matrix World transformation matrix
+         * @param matrixVersion World version the matrix was computed for
+         */
+        void storeWorldMatrix(const Matrix4 &matrix, uint64_t matrixVersion) const;
+
+        /**
+         * @brief Checks if the transform still matches its previous state
+         * @return True if nothing changed since storePreviousState()
+         */
+        bool isAtPreviousState() const;
+
         /**
          * @brief Position
          */
@@ -219,15 +355,45 @@ namespace Engine
         Vector3 rotation;
 
         /**
-         * @brief Scale
+         * @brief Scale (named apart from the scale() methods)
+         */
+        Vector3 localScale;
+
+        /**
+         * @brief Position before the last fixed step
+         */
+        Vector3 previousPosition;
+
+        /**
+         * @brief Rotation before the last fixed step (Euler angles in degrees)
+         */
+        Vector3 previousRotation;
+
+        /**
+         * @brief Scale before the last fixed step
+         */
+        Vector3 previousScale;
+
+        /**
+         * @brief Flag indicating if rendering interpolates this transform
+         */
+        bool interpolated;
+
+        /**
+         * @brief Version of the last change to the local transform or parent
          */
-        Vector3 scale;
+        uint64_t version;
 
         /**
          * @brief Parent transform
          */
         Transform *parent;
 
+        /**
+         * @brief Registration in a TransformHierarchy
+         */
+        HierarchyLink link;
+
         /**
          * @brief Flag indicating if the local matrix needs to be recalculated
          */
@@ -238,6 +404,11 @@ namespace Engine
          */
         mutable bool dirtyWorldMatrix;
 
+        /**
+         * @brief World version the cached world matrix was computed for
+         */
+        mutable uint64_t worldVersion;
+
         /**
          * @brief Cached local transformation matrix
          */
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Matrix.hpp"
+
+namespace Engine
+{
+
+    class Transform;
+    class JobSystem;
+
+    /**
+     * @brief Batched world matrix update for a set of transforms
+     *
+     * Keeps the registered transforms in arrays sorted parent before child,
+     * with every subtree stored contiguously. update() walks the arrays once,
+     * recomputes the world matrix of every transform whose local transform
+     * changed along with all of its descendants, and stores the results both
+     * in contiguous world matrix storage and in the transforms themselves, so
+     * Transform::getWorldMatrix() becomes a cache hit. Separate root subtrees
+     * are independent and are updated in parallel over the job system.
+     *
+     * Transforms must outlive their registration and stay at the same
+     * address. The hierarchy links every transform to its registered children,
+     * and Transform::setParent() updates those links, so structural changes
+     * cost time proportional to the transforms they touch. The arrays are
+     * reordered on the next update(), which keeps the cached matrices of
+     * transforms that did not move.
+     */
+    class TransformHierarchy
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        TransformHierarchy();
+
+        /**
+         * @brief Registers a transform
+         * @param transform Transform to keep up to date
+         *
+         * A transform belongs to at most one hierarchy at a time.
+         */
+        void add(Transform *transform);
+
+        /**
+         * @brief Unregisters a transform
+         * @param transform Transform to forget
+         *
+         * Registered children of the transform are detached from it, since
+         * they would otherwise keep a pointer to a transform that is about
+         * to be destroyed.
+         */
+        void remove(Transform *transform);
+
+        /**
+         * @brief Allocates storage for a number of transforms ahead of time
+         * @param count Number of transforms the hierarchy should hold without growing
+         */
+        void reserve(size_t count);
+
+        /**
+         * @brief Unregisters all transforms
+         */
+        void clear();
+
+        /**
+         * @brief Recomputes the world matrices of changed transforms
+         * @param jobSystem Job system to split root subtrees across, or nullptr to run inline
+         */
+        void update(JobSystem *jobSystem = nullptr);
+
+        /**
+         * @brief Gets the number of registered transforms
+         * @return Number of transforms
+         */
+        size_t size() const { return nodeCount; }
+
+        /**
+         * @brief Gets the transforms in update order
+         * @return Transforms sorted parent before child, valid after update()
+         */
+        const std::vector<Transform *> &getTransforms() const { return transforms; }
+
+        /**
+         * @brief Gets the world matrices in update order
+         * @return World matrix of each entry of getTransforms(), valid after update()
+         */
+        const std::vector<Matrix4> &getWorldMatrices() const { return worldMatrices; }
+
+        /**
+         * @brief Gets the number of world matrices recomputed by the last update()
+         * @return Number of recomputed transforms
+         */
+        size_t getUpdatedCount() const { return updatedCount; }
+
+    private:
+        friend class Transform;
+
+        /**
+         * @brief Registered transform with links to its parent and children
+         */
+        struct Node
+        {
+            /**
+             * @brief Transform, or nullptr while the node is free
+             */
+            Transform *transform = nullptr;
+
+            /**
+             * @brief Node of the parent, or -1 if the parent is not registered here
+             */
+            int32_t parent = -1;
+
+            /**
+             * @brief First child node, or -1 without children
+             */
+            int32_t firstChild = -1;
+
+            /**
+             * @brief Next node with the same parent, or -1
+             */
+            int32_t nextSibling = -1;
+
+            /**
+             * @brief Previous node with the same parent, or -1
+             */
+            int32_t previousSibling = -1;
+
+            /**
+             * @brief Index in update order, or -1 until the order includes the node
+             */
+            int32_t order = -1;
+
+            /**
+             * @brief Flag indicating if the parent is registered nowhere or in another hierarchy
+             */
+            bool external = false;
+        };
+
+        /**
+         * @brief Relinks a registered transform after its parent changed
+         * @param transform Transform whose parent changed
+         */
+        void onParentChanged(Transform *transform);
+
+        /**
+         * @brief Links a node to the parent of its transform
+         * @param node Node to link
+         */
+        void attach(uint32_t node);
+
+        /**
+         * @brief Links a node as a child of another node
+         * @param node Node to link
+         * @param parent Parent node
+         */
+        void attachChild(uint32_t node, uint32_t parent);
+
+        /**
+         * @brief Unlinks a node from its parent
+         * @param node Node to unlink
+         */
+        void detach(uint32_t node);
+
+        /**
+         * @brief Sorts the registered transforms parent before child
+         */
+        void rebuildOrder();
+
+        /**
+         * @brief Updates the transforms of one or more whole subtrees
+         * @param begin First index in update order
+         * @param end One past the last index in update order
+         * @return Number of recomputed world matrices
+         */
+        size_t updateRange(size_t begin, size_t end);
+
+        /**
+         * @brief Minimum number of transforms before update() uses the job system
+         */
+        static const size_t ParallelThreshold = 1024;
+
+        /**
+         * @brief Local version of entries whose matrices were never computed
+         */
+        static constexpr uint64_t NotComputed = UINT64_MAX;
+
+        /**
+         * @brief Registered transforms, indexed by Transform::HierarchyLink::node
+         */
+        std::vector<Node> nodes;
+
+        /**
+         * @brief Nodes freed by remove(), reused by add()
+         */
+        std::vector<uint32_t> freeNodes;
+
+        /**
+         * @brief Number of registered transforms
+         */
+        size_t nodeCount;
+
+        /**
+         * @brief Nodes whose parent is not registered here
+         *
+         * Checked by add(), so a parent registered after its children picks
+         * them up. Parents outside the hierarchy are rare, so a list is enough.
+         */
+        std::vector<uint32_t> externalChildren;
+
+        /**
+         * @brief Transforms in update order
+         */
+        std::vector<Transform *> transforms;
+
+        /**
+         * @brief Index of the parent in update order, or -1 for roots
+         */
+        std::vector<int32_t> parents;
+
+        /**
+         * @brief One past the last descendant in update order
+         */
+        std::vector<uint32_t> subtreeEnds;
+
+        /**
+         * @brief Local version each cached local matrix was computed for
+         */
+        std::vector<uint64_t> localVersions;
+
+        /**
+         * @brief Largest version of each transform and its ancestors
+         */
+        std::vector<uint64_t> worldVersions;
+
+        /**
+         * @brief World version of the parent each world matrix was computed for
+         */
+        std::vector<uint64_t> parentVersions;
+
+        /**
+         * @brief Whether the world matrix changed during the current update
+         */
+        std::vector<uint8_t> changed;
+
+        /**
+         * @brief Cached local matrices
+         */
+        std::vector<Matrix4> localMatrices;
+
+        /**
+         * @brief Cached world matrices
+         */
+        std::vector<Matrix4> worldMatrices;
+
+        /**
+         * @brief Roots whose parents are registered nowhere, updated on the calling thread
+         */
+        std::vector<uint32_t> externalRoots;
+
+        /**
+         * @brief Roots without parents, updated in parallel
+         */
+        std::vector<uint32_t> roots;
+
+        /**
+         * @brief Flag indicating if the update order must be rebuilt
+         */
+        bool orderDirty;
+
+        /**
+         * @brief Number of world matrices recomputed by the last update()
+         */
+        size_t updatedCount;
+    };
+
+} // namespace Engine
@@ -2,6 +2,7 @@
 
 #include "Engine/Math/Vector.hpp"
 #include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/ECS/Component.hpp"
 
 namespace Engine
@@ -51,6 +52,12 @@ namespace Engine
          */
         const Matrix4 &getViewProjectionMatrix() const { return viewProjectionMatrix; }
 
+        /**
+         * @brief Gets the view frustum in world space
+         * @return Frustum of the current view-projection matrix
+         */
+        Frustum getFrustum() const { return Frustum::fromMatrix(viewProjectionMatrix); }
+
         /**
          * @brief Updates the camera matrices
          */
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Engine/Renderer/RenderSnapshot.hpp"
+
+namespace Engine
+{
+
+    class Renderer;
+
+    /**
+     * @brief Overlaps simulation of one frame with rendering of the previous one
+     *
+     * The pipeline owns a small ring of render snapshots and a render thread
+     * that holds the graphics context. The simulation thread fills a free
+     * snapshot and submits it; the render thread draws submitted snapshots in
+     * order and returns them to the free list. When every snapshot is in
+     * flight the simulation blocks, so it can never run more than
+     * framesInFlight - 1 frames ahead of the renderer.
+     *
+     * While the pipeline runs, the graphics context is current on the render
+     * thread only. Work that needs the context (resource uploads, for example)
+     * must be queued with runOnRenderThread.
+     */
+    class FramePipeline
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param renderer Renderer that draws the snapshots
+         */
+        explicit FramePipeline(Renderer &renderer);
+
+        /**
+         * @brief Destructor
+         */
+        ~FramePipeline();
+
+        /**
+         * @brief Moves the graphics context to a new render thread
+         * @param framesInFlight Number of snapshots (clamped to 2..3)
+         * @return True if initialization succeeded, false otherwise
+         */
+        bool initialize(int framesInFlight);
+
+        /**
+         * @brief Stops the render thread and gives the context back to the caller
+         */
+        void shutdown();
+
+        /**
+         * @brief Gets a free snapshot for the next frame
+         * @return Cleared snapshot owned by the caller until submitSnapshot()
+         *
+         * Blocks while every snapshot is in flight.
+         */
+        RenderSnapshot &beginSnapshot();
+
+        /**
+         * @brief Hands the snapshot from beginSnapshot() to the render thread
+         */
+        void submitSnapshot();
+
+        /**
+         * @brief Queues work that needs the graphics context
+         * @param command Function run on the render thread before the next frame
+         */
+        void runOnRenderThread(std::function<void()> command);
+
+        /**
+         * @brief Checks if the render thread is running
+         * @return True if the pipeline is running
+         */
+        bool isRunning() const { return running; }
+
+        /**
+         * @brief Gets the number of snapshots in the ring
+         * @return Number of snapshots
+         */
+        int getFramesInFlight() const { return static_cast<int>(snapshots.size()); }
+
+        /**
+         * @brief Gets the time the simulation last waited for a free snapshot
+         * @return Wait time in seconds
+         */
+        float getLastWaitTime() const { return lastWaitTime; }
+
+    private:
+        /**
+         * @brief Main loop of the render thread
+         */
+        void renderLoop();
+
+        /**
+         * @brief Runs and clears the queued render thread commands
+         * @param commands Commands to run
+         */
+        static void runCommands(std::vector<std::function<void()>> &commands);
+
+        /**
+         * @brief Renderer that draws the snapshots
+         */
+        Renderer &renderer;
+
+        /**
+         * @brief Snapshot ring
+         */
+        std::vector<std::unique_ptr<RenderSnapshot>> snapshots;
+
+        /**
+         * @brief Indices of snapshots the simulation may fill
+         */
+        std::deque<size_t> freeSlots;
+
+        /**
+         * @brief Indices of submitted snapshots in submission order
+         */
+        std::deque<size_t> readySlots;
+
+        /**
+         * @brief Index of the snapshot being filled, or -1
+         */
+        int writeSlot;
+
+        /**
+         * @brief Commands waiting for the render thread
+         */
+        std::vector<std::function<void()>> commands;
+
+        /**
+         * @brief Mutex protecting the slot queues and commands
+         */
+        std::mutex mutex;
+
+        /**
+         * @brief Signalled when a snapshot becomes free
+         */
+        std::condition_variable freeCondition;
+
+        /**
+         * @brief Signalled when a snapshot or a command is ready or the pipeline stops
+         */
+        std::condition_variable readyCondition;
+
+        /**
+         * @brief Render thread
+         */
+        std::thread thread;
+
+        /**
+         * @brief Flag that indicates if the render thread should keep running
+         */
+        bool running;
+
+        /**
+         * @brief Index of the next simulated frame
+         */
+        uint64_t frameCounter;
+
+        /**
+         * @brief Time the simulation last waited for a free snapshot
+         */
+        float lastWaitTime;
+    };
+
+} // namespace Engine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Engine/ECS/Component.hpp"
+#include "Engine/Math/Vector.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Point light component
+     *
+     * Lights the scene from the position of the owning entity. The default
+     * shaders use the first active light of the scene.
+     */
+    class LightComponent : public ComponentT<LightComponent>
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param color Light colour
+         * @param intensity Light intensity
+         */
+        LightComponent(const Vector3 &color = Vector3::One, float intensity = 1.0f)
+            : color(color), intensity(intensity) {}
+
+        /**
+         * @brief Sets the light colour
+         * @param color Light colour
+         */
+        void setColor(const Vector3 &color) { this->color = color; }
+
+        /**
+         * @brief Gets the light colour
+         * @return Light colour
+         */
+        const Vector3 &getColor() const { return color; }
+
+        /**
+         * @brief Sets the light intensity
+         * @param intensity Factor the colour is multiplied with
+         */
+        void setIntensity(float intensity) { this->intensity = intensity; }
+
+        /**
+         * @brief Gets the light intensity
+         * @return Factor the colour is multiplied with
+         */
+        float getIntensity() const { return intensity; }
+
+    private:
+        /**
+         * @brief Light colour
+         */
+        Vector3 color;
+
+        /**
+         * @brief Light intensity
+         */
+        float intensity;
+    };
+
+} // namespace Engine
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include "Engine/Math/Vector.hpp"
+#include "Engine/Resources/ResourceRef.hpp"
 
 namespace Engine
 {
     class Shader;
     class Texture;
+    class UniformBuffer;
+    struct UniformBlockLayout;
 
     /**
      * @brief Material class
@@ -46,13 +51,54 @@ namespace Engine
          * @brief Sets the shader
          * @param shader Shader to use
          */
-        void setShader(Shader *shader) { this->shader = shader; }
+        void setShader(Shader *shader);
 
         /**
-         * @brief Binds the material
+         * @brief Gets the ID used to group draws by material
+         * @return Sort ID, unique per material
+         */
+        uint32_t getSortId() const { return sortId; }
+
+        /**
+         * @brief Binds the shader and applies the material parameters
          */
         void bind();
 
+        /**
+         * @brief Applies the parameters and textures to the already bound shader
+         *
+         * Lets a renderer that keeps the shader bound across draws switch
+         * materials without rebinding the program.
+         */
+        void applyParameters();
+
+        /**
+         * @brief Applies the parameters and textures to another bound shader
+         * @param target Shader to set the parameters on, such as an instanced variant
+         * @return Number of textures bound
+         *
+         * Parameter names are resolved to uniform locations and block
+         * offsets once per shader revision. If the target declares a
+         * MaterialData block and the material has a uniform buffer,
+         * parameters found in the block are packed into the buffer (only
+         * after they changed) and bound with one call. Other parameters are
+         * set by location, and skipped if the program still holds this
+         * material's current values.
+         */
+        uint32_t applyParameters(Shader &target);
+
+        /**
+         * @brief Gives the material a buffer for its MaterialData block
+         * @param buffer Uniform buffer, owned by the material from now on
+         */
+        void setUniformBuffer(std::unique_ptr<UniformBuffer> buffer);
+
+        /**
+         * @brief Gets the buffer for the MaterialData block
+         * @return Pointer to the uniform buffer, or nullptr if the material has none
+         */
+        UniformBuffer *getUniformBuffer() const { return uniformBuffer.get(); }
+
         /**
          * @brief Unbinds the material
          */
@@ -96,12 +142,105 @@ namespace Engine
         /**
          * @brief Sets a texture
          * @param name Texture name
-         * @param texture Texture to use
+         * @param texture Texture to use, from ResourceManager::getTextureRef()
          * @param unit Texture unit
+         *
+         * The material keeps the reference until the texture is replaced or
+         * the material is destroyed, so the texture budget cannot evict it.
          */
-        void setTexture(const std::string &name, Texture *texture, int unit = 0);
+        void setTexture(const std::string &name, TextureRef texture, int unit = 0);
 
     private:
+        /**
+         * @brief Type of a material parameter
+         */
+        enum class ParameterType : uint8_t
+        {
+            Float,
+            Int,
+            Vector2,
+            Vector3,
+            Vector4
+        };
+
+        /**
+         * @brief Parameter stored in the packed value block
+         */
+        struct Parameter
+        {
+            std::string name;
+            ParameterType type;
+            uint32_t offset;
+        };
+
+        /**
+         * @brief Texture parameter
+         */
+        struct TextureParam
+        {
+            std::string name;
+            TextureRef texture;
+            int unit;
+        };
+
+        /**
+         * @brief Parameter resolved against one shader
+         */
+        struct ParameterBinding
+        {
+            uint32_t parameter;
+            int location;
+            int32_t blockOffset;
+        };
+
+        /**
+         * @brief Parameters resolved against one shader revision
+         */
+        struct ShaderBindings
+        {
+            Shader *shader = nullptr;
+            uint32_t revision = 0;
+            bool useBlock = false;
+            std::vector<ParameterBinding> parameters;
+            std::vector<int> textureLocations;
+        };
+
+        /**
+         * @brief Stores the value of a parameter, adding the parameter if it is new
+         * @param name Parameter name
+         * @param type Parameter type
+         * @param value Pointer to the value, in floats or ints
+         */
+        void setParameter(const std::string &name, ParameterType type, const void *value);
+
+        /**
+         * @brief Gets the bindings for a shader, resolving them if needed
+         * @param target Shader to resolve the parameters against
+         * @return Bindings for the target's current revision
+         */
+        const ShaderBindings &getBindings(Shader &target);
+
+        /**
+         * @brief Resolves uniform locations and block offsets of every parameter
+         * @param target Shader to resolve the parameters against
+         * @param bindings Bindings to fill
+         */
+        void resolveBindings(Shader &target, ShaderBindings &bindings);
+
+        /**
+         * @brief Packs the parameters into the uniform buffer if they or the layout changed
+         * @param bindings Bindings of the target shader
+         * @param layout Layout of the target shader's MaterialData block
+         */
+        void updateUniformBuffer(const ShaderBindings &bindings, const UniformBlockLayout &layout);
+
+        /**
+         * @brief Gets the size of a parameter type in bytes
+         * @param type Parameter type
+         * @return Size in bytes
+         */
+        static uint32_t getParameterSize(ParameterType type);
+
         /**
          * @brief Material name
          */
@@ -113,43 +252,54 @@ namespace Engine
         Shader *shader;
 
         /**
-         * @brief Map of float parameters
+         * @brief ID used to group draws by material
          */
-        std::unordered_map<std::string, float> floatParams;
+        uint32_t sortId;
 
         /**
-         * @brief Map of int parameters
+         * @brief Parameters in the order they were first set
          */
-        std::unordered_map<std::string, int> intParams;
+        std::vector<Parameter> parameters;
 
         /**
-         * @brief Map of Vector2 parameters
+         * @brief Packed parameter values
          */
-        std::unordered_map<std::string, Vector2> vec2Params;
+        std::vector<unsigned char> values;
 
         /**
-         * @brief Map of Vector3 parameters
+         * @brief Texture parameters
          */
-        std::unordered_map<std::string, Vector3> vec3Params;
+        std::vector<TextureParam> textures;
 
         /**
-         * @brief Map of Vector4 parameters
+         * @brief Bindings per shader the material was applied to
          */
-        std::unordered_map<std::string, Vector4> vec4Params;
+        std::vector<ShaderBindings> bindings;
 
         /**
-         * @brief Structure for texture parameters
+         * @brief Incremented whenever a parameter or texture changes
          */
-        struct TextureParam
-        {
-            Texture *texture;
-            int unit;
-        };
+        uint32_t version;
+
+        /**
+         * @brief Buffer holding the MaterialData block
+         */
+        std::unique_ptr<UniformBuffer> uniformBuffer;
+
+        /**
+         * @brief CPU copy of the packed MaterialData block
+         */
+        std::vector<unsigned char> uniformData;
+
+        /**
+         * @brief Layout the uniform buffer was last packed for
+         */
+        const UniformBlockLayout *packedLayout;
 
         /**
-         * @brief Map of texture parameters
+         * @brief Parameter version the uniform buffer was last packed with
          */
-        std::unordered_map<std::string, TextureParam> textureParams;
+        uint32_t packedVersion;
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
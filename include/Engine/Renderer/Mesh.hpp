@@ -3,8 +3,13 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 
+#include "Engine/Core/Span.hpp"
 #include "Engine/Math/Vector.hpp"
+#include "Engine/Math/Bounds.hpp"
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Renderer/VertexLayout.hpp"
 
 namespace Engine
 {
@@ -21,10 +26,131 @@ namespace Engine
         Vector3 bitangent;
     };
 
+    /**
+     * @brief Range of a mesh's indices drawn with one material
+     */
+    struct SubMesh
+    {
+        /**
+         * @brief First index of the range
+         */
+        uint32_t indexOffset = 0;
+
+        /**
+         * @brief Number of indices in the range
+         */
+        uint32_t indexCount = 0;
+
+        /**
+         * @brief Material slot of the range
+         */
+        uint32_t materialIndex = 0;
+
+        /**
+         * @brief Bounding box of the range in model space
+         */
+        BoundingBox bounds;
+    };
+
+    /**
+     * @brief Range of a mesh's indices drawn at one level of detail
+     *
+     * Every level shares the vertex buffer of the mesh; coarser levels are
+     * simplified triangle lists over a subset of its vertices, stored after
+     * the full-detail indices.
+     */
+    struct MeshLod
+    {
+        /**
+         * @brief First index of the level
+         */
+        uint32_t indexOffset = 0;
+
+        /**
+         * @brief Number of indices of the level
+         */
+        uint32_t indexCount = 0;
+
+        /**
+         * @brief Projected size below which the next coarser level takes over
+         *
+         * A fraction of the screen height, as returned by Mesh::getScreenSize();
+         * 0 for the coarsest level.
+         */
+        float screenSize = 0.0f;
+    };
+
+    /**
+     * @brief Vertex and index data owned by someone else, such as a mapped file
+     */
+    struct MeshData
+    {
+        /**
+         * @brief Vertices
+         */
+        const Vertex *vertices = nullptr;
+
+        /**
+         * @brief Vertices already stored in packedLayout, used instead of vertices when set
+         */
+        const void *packedVertices = nullptr;
+
+        /**
+         * @brief Layout of packedVertices
+         */
+        VertexLayout packedLayout;
+
+        /**
+         * @brief Number of vertices
+         */
+        size_t vertexCount = 0;
+
+        /**
+         * @brief Indices, or nullptr for non-indexed meshes
+         */
+        const uint32_t *indices = nullptr;
+
+        /**
+         * @brief 16-bit indices, used instead of indices when set
+         */
+        const uint16_t *shortIndices = nullptr;
+
+        /**
+         * @brief Number of indices
+         */
+        size_t indexCount = 0;
+
+        /**
+         * @brief Precomputed bounding box, or empty to compute it from the vertices
+         */
+        BoundingBox bounds;
+
+        /**
+         * @brief Precomputed bounding sphere, used along with the box
+         */
+        BoundingSphere boundingSphere;
+    };
+
     /**
      * @brief Abstract mesh interface
      *
      * The mesh class encapsulates vertex and index data.
+     *
+     * Vertices are given as Vertex structs and stored on the GPU in the
+     * mesh's VertexLayout, which setVertexLayout() can change to a compact
+     * one; cooked meshes may also come already quantized. Static meshes use
+     * 16-bit indices whenever the vertex count allows.
+     *
+     * Static meshes may carry a chain of coarser levels of detail in the same
+     * buffers, see setLods(); the renderer draws the level picked from the
+     * object's projected size.
+     *
+     * Static meshes upload their data once in build(). Geometry that changes
+     * every frame, such as particles or debug lines, should call
+     * createDynamic() instead: the mesh then keeps a ring of buffer regions
+     * and updates write into a region the GPU is not reading, so they never
+     * wait for frames in flight. Like build(), the dynamic functions must run
+     * on the thread that owns the graphics context.
      */
     class Mesh
     {
@@ -52,12 +178,112 @@ namespace Engine
          */
         virtual void setIndices(const std::vector<uint32_t> &indices) = 0;
 
+        /**
+         * @brief Sets the vertex data from memory owned by the caller
+         * @param vertices Vertices, copied once into the mesh
+         */
+        virtual void setVertices(Span<const Vertex> vertices) = 0;
+
+        /**
+         * @brief Sets the index data from memory owned by the caller
+         * @param indices Indices, copied once into the mesh
+         */
+        virtual void setIndices(Span<const uint32_t> indices) = 0;
+
+        /**
+         * @brief Turns the mesh into a dynamic mesh
+         * @param vertexCapacity Largest number of vertices
+         * @param indexCapacity Largest number of indices, 0 for a non-indexed mesh
+         * @return True if the buffers were created, false otherwise
+         *
+         * The contents are undefined until they are written, and nothing is
+         * drawn until setDrawCount() is called. A later build() writes into
+         * the buffers when the data fits and grows them otherwise.
+         *
+         * createDynamic(), updateVertices(), updateIndices(), and
+         * setDrawCount() need the graphics context and change what frames in
+         * flight draw, so while the frame pipeline runs they must be called
+         * from commands queued with FramePipeline::runOnRenderThread(), which
+         * run between frames on the render thread.
+         */
+        virtual bool createDynamic(size_t vertexCapacity, size_t indexCapacity) = 0;
+
+        /**
+         * @brief Writes a range of vertices of a dynamic mesh
+         * @param vertices New vertices
+         * @param first Index of the first vertex to replace
+         * @return True if the range fits the capacity, false otherwise
+         *
+         * Vertices outside the range keep their values. Render thread only
+         * while the frame pipeline runs, see createDynamic().
+         */
+        virtual bool updateVertices(Span<const Vertex> vertices, size_t first = 0) = 0;
+
+        /**
+         * @brief Writes a range of indices of a dynamic mesh
+         * @param indices New indices
+         * @param first Position of the first index to replace
+         * @return True if the range fits the capacity, false otherwise
+         *
+         * Render thread only while the frame pipeline runs, see createDynamic().
+         */
+        virtual bool updateIndices(Span<const uint32_t> indices, size_t first = 0) = 0;
+
+        /**
+         * @brief Sets how much of a dynamic mesh is drawn
+         * @param vertexCount Number of vertices
+         * @param indexCount Number of indices, 0 to draw the vertices as a triangle list
+         * @return True if the counts fit the capacity, false otherwise
+         *
+         * Render thread only while the frame pipeline runs, see createDynamic().
+         */
+        virtual bool setDrawCount(size_t vertexCount, size_t indexCount) = 0;
+
+        /**
+         * @brief Checks if the mesh was created by createDynamic()
+         * @return True for a dynamic mesh
+         */
+        bool isDynamic() const { return dynamic; }
+
+        /**
+         * @brief Sets the layout Vertex data is converted to by build()
+         * @param layout Layout of the vertex buffer, must be valid
+         *
+         * Takes effect on the next build(). Dynamic meshes always use
+         * VertexLayout::standard(), and build() with packed data replaces
+         * the layout with the one of the data.
+         */
+        void setVertexLayout(const VertexLayout &layout) { vertexLayout = layout; }
+
+        /**
+         * @brief Gets the layout of the vertex buffer
+         * @return Vertex layout
+         */
+        const VertexLayout &getVertexLayout() const { return vertexLayout; }
+
+        /**
+         * @brief Gets the size of the indices in the index buffer
+         * @return Index type
+         */
+        IndexType getIndexType() const { return indexType; }
+
         /**
          * @brief Builds the mesh
          * @return True if building succeeded, false otherwise
          */
         virtual bool build() = 0;
 
+        /**
+         * @brief Builds the mesh straight from external memory
+         * @param data Vertices, indices, and optional precomputed bounds
+         * @return True if building succeeded, false otherwise
+         *
+         * Uploads without keeping a copy, so the memory only has to stay
+         * valid during the call. Data passed to setVertices() and
+         * setIndices() is left untouched.
+         */
+        virtual bool build(const MeshData &data) = 0;
+
         /**
          * @brief Binds the mesh
          */
@@ -70,8 +296,37 @@ namespace Engine
 
         /**
          * @brief Draws the mesh
+         * @param lod Level of detail, clamped to the levels the mesh has
          */
-        virtual void draw() const = 0;
+        virtual void draw(uint32_t lod = 0) const = 0;
+
+        /**
+         * @brief Draws several instances of the mesh
+         * @param instanceCount Number of instances
+         * @param lod Level of detail, clamped to the levels the mesh has
+         *
+         * Per-instance data must already be bound by the renderer.
+         */
+        virtual void drawInstanced(uint32_t instanceCount, uint32_t lod = 0) const = 0;
+
+        /**
+         * @brief Exchanges the GPU buffers and draw ranges with another mesh
+         * @param other Mesh created by the same renderer
+         *
+         * Used to replace a mesh in place when its file is reloaded, so any
+         * pointer to it stays valid. Must run on the thread that owns the
+         * graphics context; the bounds are swapped separately by swapBounds().
+         */
+        virtual void swapBuffers(Mesh &other);
+
+        /**
+         * @brief Exchanges the bounding volumes with another mesh
+         * @param other Mesh to swap with
+         *
+         * Culling and level of detail selection read the bounds and the
+         * switch sizes on the main thread, so this runs there.
+         */
+        void swapBounds(Mesh &other);
 
         /**
          * @brief Gets the mesh name
@@ -91,7 +346,116 @@ namespace Engine
          */
         size_t getIndexCount() const { return indexCount; }
 
+        /**
+         * @brief Gets the GPU memory used by the mesh
+         * @return Size of the vertex and index buffers in bytes
+         */
+        size_t getMemorySize() const { return vertexCount * vertexLayout.getStride() + indexCount * getIndexSize(indexType); }
+
+        /**
+         * @brief Gets the ID used to group draws by mesh
+         * @return Sort ID, unique per mesh
+         */
+        uint32_t getSortId() const { return sortId; }
+
+        /**
+         * @brief Gets the bounding box in model space
+         * @return Box around all vertices, empty until the mesh is built
+         */
+        const BoundingBox &getBounds() const { return bounds; }
+
+        /**
+         * @brief Gets the bounding sphere in model space
+         * @return Sphere around all vertices, empty until the mesh is built
+         */
+        const BoundingSphere &getBoundingSphere() const { return boundingSphere; }
+
+        /**
+         * @brief Sets the bounding volumes used for culling
+         * @param bounds Box in model space, the sphere is fitted around it
+         *
+         * Dynamic updates don't recompute the bounds, so meshes that move
+         * their vertices set a box that covers every frame.
+         */
+        void setBounds(const BoundingBox &bounds);
+
+        /**
+         * @brief Sets the sub-meshes
+         * @param subMeshes Index ranges with their materials
+         */
+        void setSubMeshes(std::vector<SubMesh> subMeshes) { this->subMeshes = std::move(subMeshes); }
+
+        /**
+         * @brief Gets the sub-meshes
+         * @return Index ranges with their materials, empty if the mesh is a single range
+         */
+        const std::vector<SubMesh> &getSubMeshes() const { return subMeshes; }
+
+        /**
+         * @brief Sets the levels of detail
+         * @param lods Index ranges from full detail to coarsest, empty for a single level
+         *
+         * The ranges must lie in the index buffer given to build(), which
+         * holds all levels; getIndexCount() counts them all. Sub-meshes
+         * describe level 0 only. Dynamic meshes ignore levels of detail.
+         */
+        void setLods(std::vector<MeshLod> lods);
+
+        /**
+         * @brief Gets the number of levels of detail
+         * @return Number of levels, at least 1
+         */
+        uint32_t getLodCount() const { return lods.empty() ? 1 : static_cast<uint32_t>(lods.size()); }
+
+        /**
+         * @brief Gets the index range of a level of detail
+         * @param lod Level, clamped to the levels the mesh has
+         * @return Range; the whole index buffer for a mesh without levels
+         *
+         * Read by the renderer when it draws.
+         */
+        MeshLod getLod(uint32_t lod) const;
+
+        /**
+         * @brief Picks the level of detail for a projected size
+         * @param screenSize Projected size, as returned by getScreenSize()
+         * @param current Level drawn last frame
+         * @param hysteresis Fraction the size has to pass a switch size by before the level changes
+         * @return Level to draw
+         *
+         * The margin keeps objects that hover around a switch size from
+         * flipping between two levels every frame. Pass 0 as the hysteresis
+         * to pick without a history. Runs on the main thread.
+         */
+        uint32_t selectLod(float screenSize, uint32_t current, float hysteresis) const;
+
+        /**
+         * @brief Computes the projected size of a sphere
+         * @param sphere Sphere in world space
+         * @param view View matrix
+         * @param projection Projection matrix, perspective or orthographic
+         * @return Projected diameter as a fraction of the screen height
+         */
+        static float getScreenSize(const BoundingSphere &sphere, const Matrix4 &view, const Matrix4 &projection);
+
     protected:
+        /**
+         * @brief Computes the bounding box and sphere of the vertices
+         * @param vertices Vertices of the mesh
+         * @param count Number of vertices
+         *
+         * Implementations call this from build().
+         */
+        void computeBounds(const Vertex *vertices, size_t count);
+
+        /**
+         * @brief Computes the bounding box and sphere of packed vertices
+         * @param vertices Vertices in a valid layout
+         * @param layout Layout of the vertices
+         * @param count Number of vertices
+         */
+        void computeBounds(const void *vertices, const VertexLayout &layout, size_t count);
+
         /**
          * @brief Mesh name
          */
@@ -106,6 +470,51 @@ namespace Engine
          * @brief Number of indices
          */
         size_t indexCount;
+
+        /**
+         * @brief ID used to group draws by mesh
+         */
+        uint32_t sortId;
+
+        /**
+         * @brief Bounding box in model space
+         */
+        BoundingBox bounds;
+
+        /**
+         * @brief Bounding sphere in model space
+         */
+        BoundingSphere boundingSphere;
+
+        /**
+         * @brief Index ranges with their materials
+         */
+        std::vector<SubMesh> subMeshes;
+
+        /**
+         * @brief Index ranges of the levels of detail, read when drawing
+         */
+        std::vector<MeshLod> lods;
+
+        /**
+         * @brief Switch sizes of the levels of detail, read during culling on the main thread
+         */
+        std::vector<float> lodScreenSizes;
+
+        /**
+         * @brief Layout of the vertex buffer
+         */
+        VertexLayout vertexLayout;
+
+        /**
+         * @brief Size of the indices in the index buffer
+         */
+        IndexType indexType;
+
+        /**
+         * @brief Flag indicating if the mesh was created by createDynamic()
+         */
+        bool dynamic;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <utility>
+
+#include "Engine/ECS/Component.hpp"
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Resources/ResourceRef.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Mesh renderer component
+     *
+     * Draws a mesh with a material at the transform of the owning entity.
+     * The component keeps references to both, so the resource budgets cannot
+     * evict them while it exists.
+     */
+    class MeshRendererComponent : public ComponentT<MeshRendererComponent>
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param mesh Mesh to draw, from ResourceManager::getMeshRef()
+         * @param material Material to draw with, from ResourceManager::getMaterialRef()
+         */
+        MeshRendererComponent(MeshRef mesh = MeshRef(), MaterialRef material = MaterialRef())
+            : mesh(std::move(mesh)), material(std::move(material)), color(Vector4::One), visible(true), lod(0) {}
+
+        /**
+         * @brief Sets the mesh
+         * @param mesh Mesh to draw, from ResourceManager::getMeshRef()
+         */
+        void setMesh(MeshRef mesh) { this->mesh = std::move(mesh); }
+
+        /**
+         * @brief Gets the mesh
+         * @return Mesh to draw
+         */
+        Mesh *getMesh() const { return mesh.get(); }
+
+        /**
+         * @brief Sets the material
+         * @param material Material to draw with, from ResourceManager::getMaterialRef()
+         */
+        void setMaterial(MaterialRef material) { this->material = std::move(material); }
+
+        /**
+         * @brief Gets the material
+         * @return Material to draw with
+         */
+        Material *getMaterial() const { return material.get(); }
+
+        /**
+         * @brief Sets the colour multiplied into the base colour
+         * @param color Colour (RGBA)
+         *
+         * Lets many copies of one material differ in colour while still being
+         * drawn in a single instanced call. Only shaders with an instanced
+         * variant, like the default Phong shader, use it.
+         */
+        void setColor(const Vector4 &color) { this->color = color; }
+
+        /**
+         * @brief Gets the colour multiplied into the base colour
+         * @return Colour (RGBA)
+         */
+        const Vector4 &getColor() const { return color; }
+
+        /**
+         * @brief Sets the visibility
+         * @param visible True to draw the mesh
+         */
+        void setVisible(bool visible) { this->visible = visible; }
+
+        /**
+         * @brief Checks if the mesh is drawn
+         * @return True if the mesh is drawn
+         */
+        bool isVisible() const { return visible; }
+
+        /**
+         * @brief Sets the level of detail drawn last frame
+         * @param lod Level, updated by the scene when it builds a render snapshot
+         */
+        void setLod(uint32_t lod) { this->lod = lod; }
+
+        /**
+         * @brief Gets the level of detail drawn last frame
+         * @return Level, the starting point of the next selection
+         */
+        uint32_t getLod() const { return lod; }
+
+    private:
+        /**
+         * @brief Mesh to draw
+         */
+        MeshRef mesh;
+
+        /**
+         * @brief Material to draw with
+         */
+        MaterialRef material;
+
+        /**
+         * @brief Colour multiplied into the base colour
+         */
+        Vector4 color;
+
+        /**
+         * @brief Visibility flag
+         */
+        bool visible;
+
+        /**
+         * @brief Level of detail drawn last frame
+         */
+        uint32_t lod;
+    };
+
+} // namespace Engine
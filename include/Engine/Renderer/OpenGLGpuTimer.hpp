@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Engine/Renderer/RenderStats.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Times render passes on the GPU with GL_TIME_ELAPSED queries
+     *
+     * Each frame gets its own set of queries from a small ring. A frame's
+     * results are read when its slot comes around again, FrameLatency
+     * frames later, by which time the GPU has normally finished it, so
+     * reading never stalls the pipeline. A frame whose queries are still
+     * pending at that point is skipped instead of waited for.
+     *
+     * Elapsed time queries cannot nest, so passes must not overlap.
+     */
+    class OpenGLGpuTimer
+    {
+    public:
+        /**
+         * @brief Number of frames between issuing a query and reading it
+         */
+        static constexpr uint32_t FrameLatency = 4;
+
+        /**
+         * @brief Constructor
+         */
+        OpenGLGpuTimer();
+
+        /**
+         * @brief Destructor
+         */
+        ~OpenGLGpuTimer();
+
+        OpenGLGpuTimer(const OpenGLGpuTimer &) = delete;
+        OpenGLGpuTimer &operator=(const OpenGLGpuTimer &) = delete;
+
+        /**
+         * @brief Deletes all queries
+         */
+        void shutdown();
+
+        /**
+         * @brief Starts a frame, reading back the results of the frame that used its slot
+         */
+        void beginFrame();
+
+        /**
+         * @brief Starts timing a pass
+         * @param name Pass name, a string literal
+         */
+        void beginPass(const char *name);
+
+        /**
+         * @brief Stops timing the current pass
+         */
+        void endPass();
+
+        /**
+         * @brief Gets the pass timings of the most recent frame that was read back
+         * @return Pass timings in submission order
+         */
+        const std::vector<GpuPassTiming> &getTimings() const { return timings; }
+
+    private:
+        /**
+         * @brief Pass issued in a frame
+         */
+        struct Pass
+        {
+            /**
+             * @brief Pass name
+             */
+            const char *name;
+
+            /**
+             * @brief OpenGL query ID
+             */
+            uint32_t query;
+
+            /**
+             * @brief CPU time the pass was submitted, in profiler nanoseconds
+             */
+            uint64_t submitTime;
+        };
+
+        /**
+         * @brief Queries of one frame
+         */
+        struct FrameQueries
+        {
+            /**
+             * @brief Query IDs, reused by later frames in this slot
+             */
+            std::vector<uint32_t> queries;
+
+            /**
+             * @brief Passes issued in the frame
+             */
+            std::vector<Pass> passes;
+        };
+
+        /**
+         * @brief Reads the results of a slot if they are all available
+         * @param frame Slot to read
+         * @return True if timings were updated, false if the slot was empty or still pending
+         */
+        bool readResults(FrameQueries &frame);
+
+        /**
+         * @brief Query ring, one slot per frame in flight
+         */
+        FrameQueries frames[FrameLatency];
+
+        /**
+         * @brief Slot of the current frame
+         */
+        uint32_t currentFrame;
+
+        /**
+         * @brief Whether a pass is being timed
+         */
+        bool passActive;
+
+        /**
+         * @brief Timings of the last frame read back
+         */
+        std::vector<GpuPassTiming> timings;
+    };
+
+} // namespace Engine
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Renderer/OpenGLMeshPool.hpp"
+#include "Engine/Renderer/RenderStats.hpp"
+
+namespace Engine
+{
+
+    class Mesh;
+    class Material;
+    class Shader;
+
+    /**
+     * @brief Layout of one object in the ObjectData storage buffer (std430)
+     */
+    struct IndirectObjectData
+    {
+        /**
+         * @brief Model transformation matrix, as uploaded for uniforms
+         */
+        float transform[16];
+
+        /**
+         * @brief Object colour (RGBA)
+         */
+        float color[4];
+
+        /**
+         * @brief Bounding sphere in model space: center, then radius
+         */
+        float boundingSphere[4];
+
+        /**
+         * @brief Index of the draw command of the object's mesh, then padding
+         */
+        uint32_t command[4];
+    };
+
+    /**
+     * @brief Draws static meshes with GPU culling and multi-draw indirect
+     *
+     * Submitted objects are grouped by material, mesh, and level of detail.
+     * Each mesh is copied into an OpenGLMeshPool shared with every mesh of its
+     * vertex layout, and each of its levels in use gets one
+     * DrawElementsIndirectCommand whose instance count starts at 0.
+     * A compute shader then tests every object's bounding sphere against the
+     * frustum, and for each survivor bumps the instance count of its command
+     * and writes the object's index into the command's range of the visible
+     * buffer. Finally every material draws all its meshes with one
+     * glMultiDrawElementsIndirect call. Vertex shaders read the visible
+     * buffer through an instance attribute at ObjectIndexLocation, which the
+     * command's base instance offsets, and look the object up in ObjectData.
+     *
+     * Needs GL 4.3 for compute shaders, storage buffers, and multi-draw
+     * indirect; initialize() fails on older contexts and the renderer keeps
+     * drawing every object from the CPU.
+     */
+    class OpenGLIndirectRenderer
+    {
+    public:
+        /**
+         * @brief Attribute location of the object index
+         */
+        static constexpr uint32_t ObjectIndexLocation = 13;
+
+        /**
+         * @brief Storage buffer binding of the ObjectData block
+         */
+        static constexpr uint32_t ObjectBinding = 0;
+
+        /**
+         * @brief Constructor
+         */
+        OpenGLIndirectRenderer();
+
+        /**
+         * @brief Destructor
+         */
+        ~OpenGLIndirectRenderer();
+
+        OpenGLIndirectRenderer(const OpenGLIndirectRenderer &) = delete;
+        OpenGLIndirectRenderer &operator=(const OpenGLIndirectRenderer &) = delete;
+
+        /**
+         * @brief Loads the GL 4.3 entry points and builds the culling program
+         * @param loader Returns the address of a GL function, such as glfwGetProcAddress
+         * @return True if the context supports GPU-driven drawing, false otherwise
+         */
+        bool initialize(void *(*loader)(const char *));
+
+        /**
+         * @brief Deletes the GL objects
+         */
+        void shutdown();
+
+        /**
+         * @brief Queues an object for GPU culling
+         * @param mesh Mesh to draw
+         * @param material Material to draw with
+         * @param transform Model transformation matrix
+         * @param color Object colour
+         * @param lod Level of detail to draw
+         * @return True if the object was queued, false if it has to be drawn from the CPU
+         *
+         * Takes static, indexed meshes with bounds whose material's shader
+         * has an indirect variant.
+         */
+        bool submit(Mesh *mesh, Material *material, const Matrix4 &transform, const Vector4 &color, uint32_t lod = 0);
+
+        /**
+         * @brief Checks if objects are queued
+         * @return True if flush() has nothing to draw
+         */
+        bool empty() const { return submissions.empty(); }
+
+        /**
+         * @brief Culls and draws the queued objects, then clears the queue
+         * @param view View matrix
+         * @param projection Projection matrix
+         * @param stats Counters of the frame
+         *
+         * Expects the FrameData buffer of the same view to be bound.
+         */
+        void flush(const Matrix4 &view, const Matrix4 &projection, RenderStats &stats);
+
+    private:
+        /**
+         * @brief Queued object
+         */
+        struct Submission
+        {
+            Mesh *mesh;
+            Material *material;
+            OpenGLMeshPool *pool;
+            uint32_t poolIndex;
+            uint32_t lod;
+            Matrix4 transform;
+            Vector4 color;
+        };
+
+        /**
+         * @brief Command read by glMultiDrawElementsIndirect
+         */
+        struct DrawCommand
+        {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
+        /**
+         * @brief Commands drawn with one multi-draw call
+         */
+        struct Bucket
+        {
+            OpenGLMeshPool *pool;
+            Material *material;
+            Shader *shader;
+            uint32_t firstCommand;
+            uint32_t commandCount;
+        };
+
+        /**
+         * @brief Finds or creates the pool for a mesh
+         * @param mesh Mesh to place
+         * @param index Receives the position of the pool in pools
+         * @return Pool with the mesh's vertex layout and index type
+         */
+        OpenGLMeshPool *getPool(const Mesh &mesh, uint32_t &index);
+
+        /**
+         * @brief Compute program that culls the objects
+         */
+        uint32_t cullProgram;
+
+        /**
+         * @brief Uniform locations of the culling program
+         */
+        int frustumLocation;
+        int objectCountLocation;
+
+        /**
+         * @brief Storage buffers of the objects, the draw commands, and the visible object indices
+         */
+        uint32_t objectBuffer;
+        uint32_t commandBuffer;
+        uint32_t visibleBuffer;
+
+        /**
+         * @brief Number of indices the visible buffer can hold
+         */
+        size_t visibleCapacity;
+
+        /**
+         * @brief Index of the frame being queued
+         */
+        uint64_t frame;
+
+        /**
+         * @brief Shared buffers, one per vertex layout and index type
+         */
+        std::vector<std::unique_ptr<OpenGLMeshPool>> pools;
+
+        /**
+         * @brief Objects queued for the next flush
+         */
+        std::vector<Submission> submissions;
+
+        /**
+         * @brief Sort key and submission index of every queued object
+         */
+        std::vector<std::pair<uint64_t, uint32_t>> keys;
+
+        /**
+         * @brief Data uploaded by the current flush
+         */
+        std::vector<IndirectObjectData> objects;
+        std::vector<DrawCommand> commands;
+        std::vector<Bucket> buckets;
+    };
+
+} // namespace Engine
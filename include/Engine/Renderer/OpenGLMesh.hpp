@@ -0,0 +1,348 @@
+#pragma once
+
+#include "Engine/Renderer/Mesh.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Layout of one instance in an instance buffer
+     */
+    struct InstanceData
+    {
+        /**
+         * @brief Model transformation matrix, as uploaded for uniforms
+         */
+        float transform[16];
+
+        /**
+         * @brief Instance colour (RGBA)
+         */
+        float color[4];
+    };
+
+    /**
+     * @brief OpenGL implementation of the mesh
+     *
+     * Vertex attributes use locations 0 to 4 (position, normal, texture
+     * coordinate, tangent, bitangent), described to the vertex array from
+     * the mesh's VertexLayout; attributes the layout leaves out are disabled
+     * and read as (0, 0, 0, 1). Instanced draws read the model matrix from
+     * locations 8 to 11 and the instance colour from location 12.
+     *
+     * Dynamic meshes allocate DynamicRegionCount copies of their buffers
+     * in one buffer object and draw from one region while the next is
+     * written. With GL 4.4 or GL_ARB_buffer_storage the buffers are mapped
+     * persistently and written directly; otherwise glBufferSubData is used.
+     * A fence placed when a region is left tells when the GPU is done with
+     * it, and a CPU copy of the data fills in the ranges that changed while
+     * the region was in flight.
+     */
+    class OpenGLMesh : public Mesh
+    {
+    public:
+        /**
+         * @brief First attribute location of the instance model matrix
+         */
+        static constexpr uint32_t InstanceTransformLocation = 8;
+
+        /**
+         * @brief Attribute location of the instance colour
+         */
+        static constexpr uint32_t InstanceColorLocation = 12;
+
+        /**
+         * @brief Number of buffer regions of a dynamic mesh, one more than the frames the GPU may lag behind
+         */
+        static constexpr uint32_t DynamicRegionCount = 3;
+
+        /**
+         * @brief Constructor
+         * @param name Mesh name
+         */
+        explicit OpenGLMesh(const std::string &name);
+
+        /**
+         * @brief Destructor
+         */
+        ~OpenGLMesh() override;
+
+        /**
+         * @brief Sets the vertex data
+         * @param vertices Vector of vertices
+         */
+        void setVertices(const std::vector<Vertex> &vertices) override;
+
+        /**
+         * @brief Sets the index data
+         * @param indices Vector of indices
+         */
+        void setIndices(const std::vector<uint32_t> &indices) override;
+
+        /**
+         * @brief Sets the vertex data from memory owned by the caller
+         * @param data Vertices, copied once into the mesh
+         */
+        void setVertices(Span<const Vertex> data) override;
+
+        /**
+         * @brief Sets the index data from memory owned by the caller
+         * @param data Indices, copied once into the mesh
+         */
+        void setIndices(Span<const uint32_t> data) override;
+
+        /**
+         * @brief Creates the ring of buffer regions of a dynamic mesh
+         * @param vertexCapacity Largest number of vertices
+         * @param indexCapacity Largest number of indices, 0 for a non-indexed mesh
+         * @return True if the buffers were created, false otherwise
+         */
+        bool createDynamic(size_t vertexCapacity, size_t indexCapacity) override;
+
+        /**
+         * @brief Writes a range of vertices into the current region
+         * @param data New vertices
+         * @param first Index of the first vertex to replace
+         * @return True if the range fits the capacity, false otherwise
+         */
+        bool updateVertices(Span<const Vertex> data, size_t first = 0) override;
+
+        /**
+         * @brief Writes a range of indices into the current region
+         * @param data New indices
+         * @param first Position of the first index to replace
+         * @return True if the range fits the capacity, false otherwise
+         */
+        bool updateIndices(Span<const uint32_t> data, size_t first = 0) override;
+
+        /**
+         * @brief Sets how much of the dynamic mesh is drawn
+         * @param vertexCount Number of vertices
+         * @param indexCount Number of indices
+         * @return True if the counts fit the capacity, false otherwise
+         */
+        bool setDrawCount(size_t vertexCount, size_t indexCount) override;
+
+        /**
+         * @brief Loads the optional buffer storage entry point
+         * @param loader Returns the address of a GL function, such as glfwGetProcAddress
+         *
+         * Call once the GL context is current. Without it dynamic meshes
+         * fall back to glBufferSubData.
+         */
+        static void initializeExtensions(void *(*loader)(const char *));
+
+        /**
+         * @brief Uploads the vertex and index data to the GPU
+         * @return True if building succeeded, false otherwise
+         */
+        bool build() override;
+
+        /**
+         * @brief Builds the mesh straight from external memory
+         * @param data Vertices, indices, and optional precomputed bounds
+         * @return True if building succeeded, false otherwise
+         */
+        bool build(const MeshData &data) override;
+
+        /**
+         * @brief Binds the vertex array
+         */
+        void bind() const override;
+
+        /**
+         * @brief Unbinds the vertex array
+         */
+        void unbind() const override;
+
+        /**
+         * @brief Draws the mesh
+         * @param lod Level of detail
+         */
+        void draw(uint32_t lod = 0) const override;
+
+        /**
+         * @brief Draws several instances of the mesh
+         * @param instanceCount Number of instances
+         * @param lod Level of detail
+         */
+        void drawInstanced(uint32_t instanceCount, uint32_t lod = 0) const override;
+
+        /**
+         * @brief Exchanges the OpenGL buffers and draw ranges with another mesh
+         * @param other OpenGL mesh to swap with
+         */
+        void swapBuffers(Mesh &other) override;
+
+        /**
+         * @brief Describes a vertex layout to the bound vertex array
+         * @param layout Layout of the vertex buffer bound to GL_ARRAY_BUFFER
+         */
+        static void setupVertexAttributes(const VertexLayout &layout);
+
+        /**
+         * @brief Gets the vertex buffer object
+         * @return Buffer name, 0 before the first build
+         */
+        uint32_t getVertexBufferId() const { return vbo; }
+
+        /**
+         * @brief Gets the element buffer object
+         * @return Buffer name, 0 before the first build
+         */
+        uint32_t getIndexBufferId() const { return ebo; }
+
+        /**
+         * @brief Gets the revision of the buffer contents
+         * @return ID that changes whenever the buffers are rebuilt or swapped, 0 before the first build
+         *
+         * Revisions are unique across meshes, so copies of the buffers made
+         * elsewhere can tell when they went stale.
+         */
+        uint32_t getRevision() const { return revision; }
+
+        /**
+         * @brief Points the instance attributes at a range of an instance buffer
+         * @param bufferId OpenGL buffer holding InstanceData entries
+         * @param offset Byte offset of the first instance
+         *
+         * The mesh must be bound. Does nothing if the attributes already
+         * point at this range.
+         */
+        void setInstanceBuffer(uint32_t bufferId, size_t offset);
+
+    private:
+        /**
+         * @brief Range of elements that changed since a region was last written
+         */
+        struct DirtyRange
+        {
+            size_t begin = 0;
+            size_t end = 0;
+
+            /**
+             * @brief Grows the range to cover another one
+             * @param first First element of the other range
+             * @param count Number of elements in the other range
+             */
+            void add(size_t first, size_t count);
+        };
+
+        /**
+         * @brief Buffer region of a dynamic mesh
+         */
+        struct DynamicRegion
+        {
+            /**
+             * @brief Fence placed after the last draw from the region, or nullptr
+             */
+            void *fence = nullptr;
+
+            /**
+             * @brief Vertices and indices written to other regions since this one was current
+             */
+            DirtyRange vertices;
+            DirtyRange indices;
+        };
+
+        /**
+         * @brief Gets the GL type of the indices
+         * @return GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+         */
+        uint32_t getIndexFormat() const;
+
+        /**
+         * @brief Moves to the next region if the current one was drawn from
+         */
+        void beginWrite();
+
+        /**
+         * @brief Writes bytes into the current region of a buffer
+         * @param buffer Buffer object
+         * @param mapped Persistent mapping of the buffer, or nullptr
+         * @param offset Byte offset in the buffer
+         * @param data Bytes to write
+         * @param size Number of bytes
+         */
+        void writeBuffer(uint32_t buffer, unsigned char *mapped, size_t offset, const void *data, size_t size);
+
+        /**
+         * @brief Deletes the fences and forgets the mappings of a dynamic mesh
+         */
+        void releaseDynamic();
+
+        /**
+         * @brief Vertex data
+         */
+        std::vector<Vertex> vertices;
+
+        /**
+         * @brief Index data
+         */
+        std::vector<uint32_t> indices;
+
+        /**
+         * @brief CPU copy of the contents of a dynamic mesh
+         */
+        std::vector<Vertex> dynamicVertices;
+        std::vector<uint32_t> dynamicIndices;
+
+        /**
+         * @brief Regions of a dynamic mesh
+         */
+        DynamicRegion regions[DynamicRegionCount];
+
+        /**
+         * @brief Persistent mappings of the vertex and index buffers, or nullptr
+         */
+        unsigned char *mappedVertices;
+        unsigned char *mappedIndices;
+
+        /**
+         * @brief Number of vertices and indices in one region
+         */
+        size_t vertexCapacity;
+        size_t indexCapacity;
+
+        /**
+         * @brief Region written by updates and drawn from
+         */
+        uint32_t currentRegion;
+
+        /**
+         * @brief Flag indicating if the current region was drawn from since it was written
+         */
+        mutable bool regionDrawn;
+
+        /**
+         * @brief Revision of the buffer contents
+         */
+        uint32_t revision;
+
+        /**
+         * @brief Vertex array object
+         */
+        uint32_t vao;
+
+        /**
+         * @brief Vertex buffer object
+         */
+        uint32_t vbo;
+
+        /**
+         * @brief Element buffer object
+         */
+        uint32_t ebo;
+
+        /**
+         * @brief Instance buffer the instance attributes point at, or 0
+         */
+        uint32_t instanceBufferId;
+
+        /**
+         * @brief Byte offset the instance attributes point at
+         */
+        size_t instanceOffset;
+    };
+
+} // namespace Engine
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Engine/Renderer/VertexLayout.hpp"
+
+namespace Engine
+{
+
+    class Mesh;
+    class OpenGLMesh;
+
+    /**
+     * @brief Shared vertex and index buffers holding many static meshes
+     *
+     * Meshes drawn by one multi-draw call have to share their buffers, so the
+     * pool copies each mesh it is asked for into one large vertex buffer and
+     * one large index buffer, GPU to GPU with glCopyBufferSubData. All meshes
+     * of a pool have the same vertex layout and index type. The meshes keep
+     * their own buffers for the per-object path.
+     *
+     * Copies are tracked by the mesh's buffer revision, so a mesh that is
+     * rebuilt or reloaded is copied again on its next use. Space is only
+     * reclaimed when the pool grows: meshes not used for a while are left
+     * behind then.
+     */
+    class OpenGLMeshPool
+    {
+    public:
+        /**
+         * @brief Position of a mesh in the shared buffers
+         */
+        struct Allocation
+        {
+            /**
+             * @brief First index of the mesh in the index buffer
+             */
+            uint32_t firstIndex = 0;
+
+            /**
+             * @brief Number of indices of the mesh
+             */
+            uint32_t indexCount = 0;
+
+            /**
+             * @brief First vertex of the mesh in the vertex buffer
+             */
+            int32_t baseVertex = 0;
+        };
+
+        /**
+         * @brief Frames a mesh can go unused before growing the pool drops it
+         */
+        static constexpr uint64_t RetainFrames = 120;
+
+        /**
+         * @brief Constructor
+         * @param layout Vertex layout of every mesh in the pool
+         * @param indexType Index type of every mesh in the pool
+         * @param objectIndexBuffer Buffer of per-instance object indices, bound to objectIndexLocation
+         * @param objectIndexLocation Attribute location of the object index
+         */
+        OpenGLMeshPool(const VertexLayout &layout, IndexType indexType, uint32_t objectIndexBuffer,
+                       uint32_t objectIndexLocation);
+
+        /**
+         * @brief Destructor
+         */
+        ~OpenGLMeshPool();
+
+        OpenGLMeshPool(const OpenGLMeshPool &) = delete;
+        OpenGLMeshPool &operator=(const OpenGLMeshPool &) = delete;
+
+        /**
+         * @brief Checks if a mesh can go into the pool
+         * @param mesh Static, indexed mesh
+         * @return True if the mesh has the pool's vertex layout and index type
+         */
+        bool accepts(const Mesh &mesh) const;
+
+        /**
+         * @brief Gets the position of a mesh, copying it into the pool first if needed
+         * @param mesh Mesh the pool accepts
+         * @param frame Index of the current frame
+         * @return Allocation, or nullptr if the mesh could not be copied
+         *
+         * Growing the pool moves every allocation, so pointers returned
+         * earlier in the same frame must not be kept.
+         */
+        const Allocation *acquire(const OpenGLMesh &mesh, uint64_t frame);
+
+        /**
+         * @brief Binds the vertex array of the shared buffers
+         */
+        void bind() const;
+
+        /**
+         * @brief Gets the GL type of the indices
+         * @return GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+         */
+        uint32_t getIndexFormat() const;
+
+        /**
+         * @brief Gets the size of the shared buffers in use
+         * @return Bytes of vertices and indices copied into the pool
+         */
+        size_t getMemorySize() const;
+
+    private:
+        /**
+         * @brief Copy of one mesh
+         */
+        struct Entry
+        {
+            /**
+             * @brief Buffer revision of the mesh when it was copied
+             */
+            uint32_t revision = 0;
+
+            /**
+             * @brief Number of vertices copied
+             */
+            size_t vertexCount = 0;
+
+            /**
+             * @brief Position in the shared buffers
+             */
+            Allocation allocation;
+
+            /**
+             * @brief Frame the mesh was last acquired in
+             */
+            uint64_t lastUsed = 0;
+        };
+
+        /**
+         * @brief Moves the live meshes into larger buffers
+         * @param vertexCount Vertices that have to fit in addition to the live meshes
+         * @param indexCount Indices that have to fit in addition to the live meshes
+         * @param frame Index of the current frame
+         */
+        void grow(size_t vertexCount, size_t indexCount, uint64_t frame);
+
+        /**
+         * @brief Describes the shared buffers to the vertex array
+         */
+        void setupVertexArray();
+
+        /**
+         * @brief Vertex layout of every mesh
+         */
+        VertexLayout layout;
+
+        /**
+         * @brief Index type of every mesh
+         */
+        IndexType indexType;
+
+        /**
+         * @brief Buffer of per-instance object indices and its attribute location
+         */
+        uint32_t objectIndexBuffer;
+        uint32_t objectIndexLocation;
+
+        /**
+         * @brief Vertex array, vertex buffer, and index buffer
+         */
+        uint32_t vao;
+        uint32_t vbo;
+        uint32_t ebo;
+
+        /**
+         * @brief Number of vertices and indices the buffers can hold
+         */
+        size_t vertexCapacity;
+        size_t indexCapacity;
+
+        /**
+         * @brief Number of vertices and indices written so far
+         */
+        size_t vertexUsed;
+        size_t indexUsed;
+
+        /**
+         * @brief Copies by mesh
+         */
+        std::unordered_map<const Mesh *, Entry> entries;
+    };
+
+} // namespace Engine
@@ -1,15 +1,24 @@
 #pragma once
 
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderQueue.hpp"
+#include "Engine/Renderer/OpenGLMesh.hpp"
+#include "Engine/Renderer/OpenGLUniformBuffer.hpp"
+#include "Engine/Renderer/OpenGLGpuTimer.hpp"
+#include "Engine/Renderer/OpenGLIndirectRenderer.hpp"
+#include "Engine/Math/Bounds.hpp"
+#include "Engine/Renderer/ShaderCache.hpp"
 
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 namespace Engine
 {
 
     class OpenGLWindow;
     class OpenGLShader;
+    struct RenderItem;
 
     /**
      * @brief OpenGL implementation of the renderer
@@ -55,24 +64,37 @@ namespace Engine
         void endFrame() override;
 
         /**
-         * @brief Draws a mesh
+         * @brief Queues a mesh for drawing at the end of the frame
          * @param mesh Mesh to draw
          * @param material Material to use
          * @param transform Model transformation matrix
          */
         void drawMesh(Mesh *mesh, Material *material, const Matrix4 &transform) override;
 
+        /**
+         * @brief Draws every item of a render snapshot
+         * @param snapshot Snapshot to draw, using the camera matrices it captured
+         */
+        void renderSnapshot(const RenderSnapshot &snapshot) override;
+
         /**
          * @brief Sets the active camera
          * @param camera Camera to use for rendering
          */
-        void setCamera(Camera *camera) override;
+        void setCamera(CameraComponent *camera) override;
 
         /**
          * @brief Gets the active camera
          * @return Pointer to the active camera
          */
-        Camera *getCamera() const override;
+        CameraComponent *getCamera() const override;
+
+        /**
+         * @brief Gets a built-in shader
+         * @param name Shader name ("Phong", "PhongInstanced", or "PhongIndirect" with GPU-driven rendering)
+         * @return Pointer to the shader, or nullptr if there is none with this name
+         */
+        Shader *getDefaultShader(const std::string &name) const override;
 
         /**
          * @brief Gets the window
@@ -86,13 +108,84 @@ namespace Engine
          */
         bool shouldClose() const override;
 
+        /**
+         * @brief Gets the counters of the last completed frame
+         * @return Render statistics
+         */
+        const RenderStats &getStats() const override { return lastFrameStats; }
+
+        /**
+         * @brief Gets the GPU time of each pass of the most recent frame the GPU has finished
+         * @return Pass timings in submission order
+         */
+        const std::vector<GpuPassTiming> &getGpuTimings() const override { return gpuTimer.getTimings(); }
+
+        /**
+         * @brief Checks if static meshes are culled and drawn on the GPU
+         * @return True if the context supports GPU-driven rendering and the configuration enables it
+         */
+        bool isGpuCullingEnabled() const override { return indirectRenderer != nullptr; }
+
     private:
+        /**
+         * @brief Run of sorted draws issued with one draw call
+         */
+        struct DrawBatch
+        {
+            /**
+             * @brief Position of the first draw in the sorted queue
+             */
+            size_t first;
+
+            /**
+             * @brief Number of draws in the run
+             */
+            uint32_t count;
+
+            /**
+             * @brief Index of the first instance in the instance buffer, if instanced
+             */
+            size_t instanceOffset;
+
+            /**
+             * @brief Flag that indicates if the run is drawn with the instanced shader variant
+             */
+            bool instanced;
+        };
+
         /**
          * @brief Compiles default shaders
          * @return True if compilation succeeded, false otherwise
          */
         bool compileDefaultShaders();
 
+        /**
+         * @brief Queues a mesh with its depth under the given view
+         * @param mesh Mesh to draw
+         * @param material Material to use
+         * @param transform Model transformation matrix
+         * @param view View matrix used to compute the depth
+         * @param color Per-instance colour
+         * @param lod Level of detail to draw
+         */
+        void queueMesh(Mesh *mesh, Material *material, const Matrix4 &transform, const Matrix4 &view,
+                       const Vector4 &color = Vector4::One, uint32_t lod = 0);
+
+        /**
+         * @brief Sorts and draws the queued meshes, binding only state that changes
+         *
+         * Camera and light data go to the shaders through the FrameData
+         * uniform buffer, uploaded once per flush.
+         * Consecutive draws of the same mesh, material, and level of detail
+         * whose shader has an instanced variant are drawn with one instanced
+         * draw call.
+         *
+         * @param view View matrix
+         * @param projection Projection matrix
+         * @param pass Pass name for the profiler and the GPU timer, a string literal
+         */
+        void flushQueue(const Matrix4 &view, const Matrix4 &projection, const char *pass);
+
         /**
          * @brief Pointer to the window
          */
@@ -101,7 +194,7 @@ namespace Engine
         /**
          * @brief Active camera
          */
-        Camera *activeCamera;
+        CameraComponent *activeCamera;
 
         /**
          * @brief Map of default shaders
@@ -112,6 +205,80 @@ namespace Engine
          * @brief Current frame buffer
          */
         uint32_t currentFrameBuffer;
+
+        /**
+         * @brief Uploads camera and light data into the FrameData buffer
+         * @param view View matrix
+         * @param projection Projection matrix
+         */
+        void uploadFrameUniforms(const Matrix4 &view, const Matrix4 &projection);
+
+        /**
+         * @brief Buffer holding the FrameData block
+         */
+        std::unique_ptr<OpenGLUniformBuffer> frameUniformBuffer;
+
+        /**
+         * @brief Light position of the last snapshot
+         */
+        Vector3 lightPosition;
+
+        /**
+         * @brief Light colour of the last snapshot
+         */
+        Vector3 lightColor;
+
+        /**
+         * @brief Draws waiting for the next flush
+         */
+        RenderQueue renderQueue;
+
+        /**
+         * @brief Buffer streaming the per-instance data of a flush
+         */
+        uint32_t instanceBuffer;
+
+        /**
+         * @brief Per-instance data of the current flush
+         */
+        std::vector<InstanceData> instanceData;
+
+        /**
+         * @brief Draw calls of the current flush
+         */
+        std::vector<DrawBatch> batches;
+
+        /**
+         * @brief Counters of the frame being rendered
+         */
+        RenderStats frameStats;
+
+        /**
+         * @brief Counters of the last completed frame
+         */
+        RenderStats lastFrameStats;
+
+        /**
+         * @brief GPU culling and multi-draw indirect for static meshes, nullptr on the CPU path
+         */
+        std::unique_ptr<OpenGLIndirectRenderer> indirectRenderer;
+
+        /**
+         * @brief Bounds and results of the snapshot items the GPU does not cull
+         */
+        std::vector<const RenderItem *> cpuItems;
+        BoundingSphereBatch cpuSpheres;
+        std::vector<uint8_t> cpuCullResults;
+
+        /**
+         * @brief Timer queries around the passes of each frame
+         */
+        OpenGLGpuTimer gpuTimer;
+
+        /**
+         * @brief Linked programs kept across launches
+         */
+        ShaderCache shaderCache;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -5,8 +5,13 @@
 namespace Engine
 {
 
+    class ShaderCache;
+
     /**
      * @brief OpenGL implementation of the shader
+     *
+     * Linked programs are stored in the binary cache set with setBinaryCache()
+     * and loaded from it on the next launch instead of compiling the sources.
      */
     class OpenGLShader : public Shader
     {
@@ -30,6 +35,51 @@ namespace Engine
          */
         bool compile(const std::string &vertexSource, const std::string &fragmentSource) override;
 
+        /**
+         * @brief Starts compiling the shader without waiting for the result
+         * @param vertexSource Vertex shader source code
+         * @param fragmentSource Fragment shader source code
+         *
+         * Loads the program from the binary cache if it is there. Otherwise
+         * the sources are compiled and linked; with parallel shader
+         * compilation the driver does this on its own threads, so starting
+         * several shaders before finishing the first overlaps their compiles.
+         */
+        void beginCompile(const std::string &vertexSource, const std::string &fragmentSource);
+
+        /**
+         * @brief Checks if finishCompile() would return without waiting for the driver
+         * @return True if the started compile is done, or if the driver can't tell
+         */
+        bool isCompileComplete() const;
+
+        /**
+         * @brief Waits for the compile started by beginCompile() and makes the program current
+         * @return True if compilation succeeded, false otherwise; the previous program is kept on failure
+         */
+        bool finishCompile();
+
+        /**
+         * @brief Checks if the current program was loaded from the binary cache
+         * @return True if the program was not compiled from source
+         */
+        bool isFromBinaryCache() const { return fromBinaryCache; }
+
+        /**
+         * @brief Loads the optional program binary and parallel compile entry points
+         * @param loader Returns the address of a GL function, such as glfwGetProcAddress
+         * @param parallelCompile True to let the driver compile on its own threads if it can
+         *
+         * Call once the GL context is current, before compiling shaders.
+         */
+        static void initializeExtensions(void *(*loader)(const char *), bool parallelCompile);
+
+        /**
+         * @brief Sets the cache linked programs are stored in
+         * @param cache Binary cache, or nullptr to always compile from source
+         */
+        static void setBinaryCache(ShaderCache *cache);
+
         /**
          * @brief Binds the shader
          */
@@ -89,19 +139,111 @@ namespace Engine
          */
         void setMatrix4(const std::string &name, const Matrix4 &value) override;
 
-    private:
         /**
          * @brief Gets the location of a uniform
          * @param name Uniform name
-         * @return Uniform location
+         * @return Uniform location, or -1 if the shader has no such uniform
+         */
+        int getUniformLocation(const std::string &name) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setInt(int location, int value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setFloat(int location, float value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setVector2(int location, const Vector2 &value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
          */
-        int getUniformLocation(const std::string &name);
+        void setVector3(int location, const Vector3 &value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setVector4(int location, const Vector4 &value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setMatrix3(int location, const Matrix3 &value) override;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        void setMatrix4(int location, const Matrix4 &value) override;
+
+    private:
+        /**
+         * @brief Binds the FrameData and MaterialData blocks and records their layout
+         */
+        void reflectUniformBlocks();
+
+        /**
+         * @brief Loads the pending program from the binary cache
+         * @return True if the driver accepted the cached binary
+         */
+        bool loadBinary();
+
+        /**
+         * @brief Stores the linked pending program in the binary cache
+         */
+        void storeBinary();
+
+        /**
+         * @brief Deletes the objects of a compile that was not finished
+         */
+        void discardPending();
 
         /**
          * @brief Shader program ID
          */
         uint32_t programId;
 
+        /**
+         * @brief Program and shaders of the compile started by beginCompile(), 0 if none
+         */
+        uint32_t pendingProgram;
+        uint32_t pendingVertexShader;
+        uint32_t pendingFragmentShader;
+
+        /**
+         * @brief Cache key of the pending sources
+         */
+        uint64_t pendingSourceHash;
+
+        /**
+         * @brief Flag that indicates if the pending program came from the binary cache
+         */
+        bool pendingFromCache;
+
+        /**
+         * @brief Flag that indicates if the current program came from the binary cache
+         */
+        bool fromBinaryCache;
+
         /**
          * @brief Cache of uniform locations
          */
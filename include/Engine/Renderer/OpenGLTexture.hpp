@@ -22,7 +22,7 @@ namespace Engine
 
         /**
          * @brief Loads a texture from file
-         * @param filepath Path to the texture file
+         * @param filepath Path to the texture file, an image or a KTX2 or DDS file
          * @return True if loading succeeded, false otherwise
          */
         bool load(const std::string &filepath) override;
@@ -68,6 +68,46 @@ namespace Engine
          */
         void generateMipmaps() override;
 
+        /**
+         * @brief Allocates a texture whose mip levels are uploaded one by one
+         * @param width Width of the base level
+         * @param height Height of the base level
+         * @param format Texture format
+         * @param mipCount Number of mip levels
+         * @return True if the format is supported and allocation succeeded, false otherwise
+         */
+        bool allocate(int width, int height, TextureFormat format, int mipCount) override;
+
+        /**
+         * @brief Uploads one mip level
+         * @param level Level to upload, one finer than the finest resident level
+         * @param data Pixels or blocks of the level
+         * @param size Size of the data in bytes
+         * @return True if the upload succeeded, false otherwise
+         */
+        bool uploadMip(int level, const unsigned char *data, size_t size) override;
+
+        /**
+         * @brief Frees the levels finer than a level
+         * @param level New finest resident level
+         */
+        void dropMips(int level) override;
+
+        /**
+         * @brief Exchanges the OpenGL texture and size with another texture
+         * @param other OpenGL texture to swap with
+         */
+        void swapContents(Texture &other) override;
+
+        /**
+         * @brief Checks if the GPU can sample a format
+         * @param format Texture format
+         * @return True if the format is supported by the current context
+         *
+         * Must be called on the thread that owns the graphics context.
+         */
+        static bool isFormatSupported(TextureFormat format);
+
         /**
          * @brief Gets the OpenGL texture ID
          * @return OpenGL texture ID
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine/Renderer/UniformBuffer.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief OpenGL implementation of the uniform buffer
+     */
+    class OpenGLUniformBuffer : public UniformBuffer
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        OpenGLUniformBuffer();
+
+        /**
+         * @brief Destructor
+         */
+        ~OpenGLUniformBuffer() override;
+
+        /**
+         * @brief Allocates the buffer storage
+         * @param size Size in bytes
+         * @return True if creation succeeded, false otherwise
+         */
+        bool create(size_t size) override;
+
+        /**
+         * @brief Uploads data into the buffer
+         * @param data Data to upload
+         * @param size Number of bytes to upload
+         * @param offset Byte offset in the buffer
+         */
+        void setData(const void *data, size_t size, size_t offset = 0) override;
+
+        /**
+         * @brief Binds the buffer to a binding point
+         * @param binding Binding point
+         */
+        void bind(UniformBinding binding) const override;
+
+    private:
+        /**
+         * @brief OpenGL buffer ID
+         */
+        uint32_t bufferId;
+    };
+
+} // namespace Engine
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "Engine/Renderer/Window.hpp"
 
 // Forward declarations for GLFW
@@ -47,6 +49,16 @@ namespace Engine
          */
         void swapBuffers() override;
 
+        /**
+         * @brief Makes the OpenGL context current on the calling thread
+         */
+        void makeContextCurrent() override;
+
+        /**
+         * @brief Detaches the OpenGL context from the calling thread
+         */
+        void releaseContext() override;
+
         /**
          * @brief Checks if the window should close
          * @return True if the window should close, false otherwise
@@ -72,11 +84,49 @@ namespace Engine
         GLFWwindow *getGLFWWindow() const { return window; }
 
     private:
+        /**
+         * @brief GLFW key callback
+         */
+        static void onKey(GLFWwindow *window, int key, int scancode, int action, int mods);
+
+        /**
+         * @brief GLFW mouse button callback
+         */
+        static void onMouseButton(GLFWwindow *window, int button, int action, int mods);
+
+        /**
+         * @brief GLFW cursor position callback
+         */
+        static void onCursorPosition(GLFWwindow *window, double x, double y);
+
+        /**
+         * @brief GLFW scroll callback
+         */
+        static void onScroll(GLFWwindow *window, double x, double y);
+
+        /**
+         * @brief Reports changes of the first connected gamepad as input events
+         *
+         * GLFW has no gamepad callbacks, so the state is compared with the
+         * previous poll.
+         */
+        void pollGamepad();
+
         /**
          * @brief GLFW window handle
          */
         GLFWwindow *window;
 
+        /**
+         * @brief Gamepad button state at the last poll
+         */
+        std::array<bool, static_cast<size_t>(GamepadButton::Count)> gamepadButtons{};
+
+        /**
+         * @brief Gamepad axis values at the last poll
+         */
+        std::array<float, static_cast<size_t>(GamepadAxis::Count)> gamepadAxes{};
+
         /**
          * @brief Flag indicating if GLFW is initialized
          */
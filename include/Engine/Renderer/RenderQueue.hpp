@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Vector.hpp"
+
+namespace Engine
+{
+
+    class Mesh;
+    class Material;
+
+    /**
+     * @brief Single queued draw
+     */
+    struct RenderCommand
+    {
+        /**
+         * @brief Mesh to draw
+         */
+        Mesh *mesh = nullptr;
+
+        /**
+         * @brief Material to draw with
+         */
+        Material *material = nullptr;
+
+        /**
+         * @brief Model transformation matrix
+         */
+        Matrix4 transform;
+
+        /**
+         * @brief Per-instance colour
+         */
+        Vector4 color;
+
+        /**
+         * @brief Level of detail to draw
+         */
+        uint32_t lod = 0;
+    };
+
+    /**
+     * @brief Collects draws for a frame and orders them to minimize state changes
+     *
+     * Every command gets a 64-bit sort key made of, from the most significant
+     * bits down, the shader, material, and mesh sort IDs (16 bits each) and
+     * the view depth (16 bits). Sorting by the key groups draws that share
+     * state, so the renderer only has to bind what differs from the previous
+     * draw, and draws of the same mesh and material end up next to each
+     * other where they can be instanced. Within a group draws run front to
+     * back, which also keeps draws of the same level of detail together.
+     * Commands with equal keys keep their submission order.
+     */
+    class RenderQueue
+    {
+    public:
+        /**
+         * @brief Adds a draw to the queue
+         * @param mesh Mesh to draw
+         * @param material Material to draw with (must have a shader)
+         * @param transform Model transformation matrix
+         * @param depth Distance of the object in front of the camera
+         * @param color Per-instance colour
+         * @param lod Level of detail to draw
+         */
+        void submit(Mesh *mesh, Material *material, const Matrix4 &transform, float depth,
+                    const Vector4 &color = Vector4::One, uint32_t lod = 0);
+
+        /**
+         * @brief Sorts the queued draws by their sort keys
+         */
+        void sort();
+
+        /**
+         * @brief Removes all queued draws
+         */
+        void clear();
+
+        /**
+         * @brief Gets the number of queued draws
+         * @return Number of draws
+         */
+        size_t size() const { return commands.size(); }
+
+        /**
+         * @brief Checks if the queue is empty
+         * @return True if no draw is queued
+         */
+        bool empty() const { return commands.empty(); }
+
+        /**
+         * @brief Gets a draw in sorted order
+         * @param index Position in the sorted order
+         * @return Queued draw
+         *
+         * Only valid after sort().
+         */
+        const RenderCommand &getSorted(size_t index) const { return commands[keys[index].second]; }
+
+        /**
+         * @brief Builds the sort key of a draw
+         * @param shaderId Sort ID of the shader
+         * @param materialId Sort ID of the material
+         * @param meshId Sort ID of the mesh
+         * @param depth Distance of the object in front of the camera
+         * @return Sort key
+         */
+        static uint64_t makeSortKey(uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth);
+
+    private:
+        /**
+         * @brief Queued draws in submission order
+         */
+        std::vector<RenderCommand> commands;
+
+        /**
+         * @brief Sort key and command index of every queued draw
+         */
+        std::vector<std::pair<uint64_t, uint32_t>> keys;
+    };
+
+} // namespace Engine
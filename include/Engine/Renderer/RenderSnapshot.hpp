@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/Vector.hpp"
+
+namespace Engine
+{
+
+    class Mesh;
+    class Material;
+
+    /**
+     * @brief A single draw captured by the simulation
+     */
+    struct RenderItem
+    {
+        /**
+         * @brief Mesh to draw
+         */
+        Mesh *mesh = nullptr;
+
+        /**
+         * @brief Material to draw with
+         */
+        Material *material = nullptr;
+
+        /**
+         * @brief World transformation matrix at capture time
+         */
+        Matrix4 transform;
+
+        /**
+         * @brief Colour the renderer passes to instanced shaders
+         */
+        Vector4 color = Vector4::One;
+
+        /**
+         * @brief Level of detail picked from the projected size
+         */
+        uint32_t lod = 0;
+    };
+
+    /**
+     * @brief Immutable copy of everything the renderer needs for one frame
+     *
+     * The simulation fills a snapshot at the end of its frame and never touches
+     * it again until the renderer hands it back, so a render thread can draw
+     * it while the next frame is simulated. Meshes and materials are
+     * referenced, not copied, and must not be modified or destroyed while a
+     * snapshot that references them is in flight.
+     */
+    struct RenderSnapshot
+    {
+        /**
+         * @brief Index of the simulated frame this snapshot was taken from
+         */
+        uint64_t frameIndex = 0;
+
+        /**
+         * @brief Flag that indicates if a camera was active at capture time
+         */
+        bool hasCamera = false;
+
+        /**
+         * @brief View matrix of the active camera
+         */
+        Matrix4 view;
+
+        /**
+         * @brief Projection matrix of the active camera
+         */
+        Matrix4 projection;
+
+        /**
+         * @brief Flag that indicates if a light was active at capture time
+         */
+        bool hasLight = false;
+
+        /**
+         * @brief Light position in world space
+         */
+        Vector3 lightPosition;
+
+        /**
+         * @brief Light colour scaled by intensity
+         */
+        Vector3 lightColor;
+
+        /**
+         * @brief Draws of the frame
+         */
+        std::vector<RenderItem> items;
+
+        /**
+         * @brief Number of meshes left out because they were outside the camera frustum
+         */
+        uint32_t culledCount = 0;
+
+        /**
+         * @brief Resets the snapshot for reuse, keeping its allocations
+         */
+        void clear()
+        {
+            hasCamera = false;
+            hasLight = false;
+            items.clear();
+            culledCount = 0;
+        }
+    };
+
+} // namespace Engine
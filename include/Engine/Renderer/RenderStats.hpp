@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+
+    /**
+     * @brief Per-frame rendering counters
+     */
+    struct RenderStats
+    {
+        /**
+         * @brief Number of draw calls issued
+         */
+        uint32_t drawCalls = 0;
+
+        /**
+         * @brief Number of draw calls that drew several instances
+         */
+        uint32_t instancedDrawCalls = 0;
+
+        /**
+         * @brief Number of objects drawn through instanced draw calls
+         */
+        uint32_t instances = 0;
+
+        /**
+         * @brief Number of multi-draw indirect calls, each drawing every mesh of a material
+         */
+        uint32_t indirectDrawCalls = 0;
+
+        /**
+         * @brief Number of meshes handed to GPU culling; how many survive is only known to the GPU
+         */
+        uint32_t gpuCullObjects = 0;
+
+        /**
+         * @brief Number of vertices submitted, counting every instance
+         */
+        uint64_t vertices = 0;
+
+        /**
+         * @brief Number of triangles submitted, counting every instance
+         */
+        uint64_t triangles = 0;
+
+        /**
+         * @brief Number of triangles left out because objects were drawn at a coarser level of detail
+         */
+        uint64_t trianglesSavedByLod = 0;
+
+        /**
+         * @brief Number of shader program binds
+         */
+        uint32_t shaderChanges = 0;
+
+        /**
+         * @brief Number of material parameter and texture applications
+         */
+        uint32_t materialChanges = 0;
+
+        /**
+         * @brief Number of vertex array binds
+         */
+        uint32_t meshChanges = 0;
+
+        /**
+         * @brief Number of texture binds
+         */
+        uint32_t textureBinds = 0;
+
+        /**
+         * @brief Number of bytes of instance and frame data uploaded to buffers
+         */
+        uint64_t bufferUploadBytes = 0;
+
+        /**
+         * @brief Number of shader, material, and mesh binds skipped because the state was already bound
+         */
+        uint32_t stateChangesAvoided = 0;
+
+        /**
+         * @brief Number of meshes that passed frustum culling
+         */
+        uint32_t objectsVisible = 0;
+
+        /**
+         * @brief Number of meshes skipped by frustum culling
+         */
+        uint32_t objectsCulled = 0;
+
+        /**
+         * @brief Resets all counters to zero
+         */
+        void reset() { *this = RenderStats(); }
+    };
+
+    /**
+     * @brief GPU time spent in one render pass
+     */
+    struct GpuPassTiming
+    {
+        /**
+         * @brief Pass name
+         */
+        const char *name = nullptr;
+
+        /**
+         * @brief Time the GPU spent executing the pass, in milliseconds
+         */
+        double milliseconds = 0.0;
+    };
+
+} // namespace Engine
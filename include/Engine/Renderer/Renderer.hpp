@@ -5,18 +5,19 @@
 #include <memory>
 #include <vector>
 
-#include "Engine/Core/Config.hpp"
 #include "Engine/Math/Matrix.hpp"
+#include "Engine/Renderer/RenderStats.hpp"
 
 namespace Engine
 {
 
     class Window;
-    class Camera;
+    class CameraComponent;
     class Mesh;
     class Shader;
     class Material;
     class Texture;
+    struct RenderSnapshot;
 
     struct RendererConfig
     {
@@ -24,6 +25,49 @@ namespace Engine
         bool msaa;
         int msaaSamples;
         bool hdr;
+
+        /**
+         * @brief Render on a dedicated thread while the next frame is simulated
+         */
+        bool pipelined = false;
+
+        /**
+         * @brief Number of render snapshots in pipelined mode (2 or 3)
+         *
+         * Simulation can run at most framesInFlight - 1 frames ahead of the
+         * frame being rendered, which bounds the added input latency.
+         */
+        int framesInFlight = 2;
+
+        /**
+         * @brief Store linked shader programs and load them on the next launch instead of compiling
+         */
+        bool shaderBinaryCache = true;
+
+        /**
+         * @brief Directory of the shader binary cache, filled in under the resources directory if empty
+         */
+        std::string shaderCachePath;
+
+        /**
+         * @brief Let the driver compile shaders on its own threads if it supports it
+         */
+        bool parallelShaderCompile = true;
+
+        /**
+         * @brief Cull and draw static meshes on the GPU with multi-draw indirect where GL 4.3 is available
+         */
+        bool gpuDriven = true;
+
+        /**
+         * @brief Scales projected sizes before levels of detail are picked; lower values switch to coarser levels sooner
+         */
+        float lodBias = 1.0f;
+
+        /**
+         * @brief Fraction a projected size has to pass a switch size by before an object changes its level of detail
+         */
+        float lodHysteresis = 0.1f;
     };
 
     /**
@@ -38,7 +82,7 @@ namespace Engine
          * @brief Constructor
          * @param config Renderer configuration
          */
-        explicit Renderer(const RendererConfig &config);
+        explicit Renderer(const RendererConfig &config) : config(config) {}
 
         /**
          * @brief Virtual destructor
@@ -74,20 +118,36 @@ namespace Engine
          * @param mesh Mesh to draw
          * @param material Material to use
          * @param transform Model transformation matrix
+         *
+         * Implementations may defer the draw until endFrame() to batch it
+         * with draws that share state.
          */
         virtual void drawMesh(Mesh *mesh, Material *material, const Matrix4 &transform) = 0;
 
+        /**
+         * @brief Draws every item of a render snapshot
+         * @param snapshot Snapshot to draw, using the camera matrices it captured
+         */
+        virtual void renderSnapshot(const RenderSnapshot &snapshot) = 0;
+
         /**
          * @brief Sets the active camera
          * @param camera Camera to use for rendering
          */
-        virtual void setCamera(Camera *camera) = 0;
+        virtual void setCamera(CameraComponent *camera) = 0;
 
         /**
          * @brief Gets the active camera
          * @return Pointer to the active camera
          */
-        virtual Camera *getCamera() const = 0;
+        virtual CameraComponent *getCamera() const = 0;
+
+        /**
+         * @brief Gets a built-in shader
+         * @param name Shader name, such as "Phong"
+         * @return Pointer to the shader, or nullptr if there is none with this name
+         */
+        virtual Shader *getDefaultShader(const std::string &name) const = 0;
 
         /**
          * @brief Gets the window
@@ -101,6 +161,31 @@ namespace Engine
          */
         virtual bool shouldClose() const = 0;
 
+        /**
+         * @brief Gets the counters of the last completed frame
+         * @return Render statistics
+         *
+         * Must be read on the thread that renders.
+         */
+        virtual const RenderStats &getStats() const = 0;
+
+        /**
+         * @brief Gets the GPU time of each pass of the most recent frame the GPU has finished
+         * @return Pass timings in submission order, empty if the GPU cannot time passes
+         *
+         * Timings lag a few frames behind so that reading them never waits
+         * for the GPU. Must be read on the thread that renders.
+         */
+        virtual const std::vector<GpuPassTiming> &getGpuTimings() const = 0;
+
+        /**
+         * @brief Checks if the renderer tests bounding spheres against the frustum itself
+         * @return True if snapshots may hold objects that only passed the spatial index
+         *
+         * Set once by initialize(), so it can be read from any thread afterwards.
+         */
+        virtual bool isGpuCullingEnabled() const { return false; }
+
         /**
          * @brief Gets the renderer configuration
          * @return Renderer configuration
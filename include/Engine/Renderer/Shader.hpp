@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
 #include "Engine/Math/Vector.hpp"
 #include "Engine/Math/Matrix.hpp"
+#include "Engine/Renderer/UniformBuffer.hpp"
 
 namespace Engine
 {
@@ -95,17 +97,199 @@ namespace Engine
          */
         virtual void setMatrix4(const std::string &name, const Matrix4 &value) = 0;
 
+        /**
+         * @brief Gets the location of a uniform
+         * @param name Uniform name
+         * @return Uniform location, or -1 if the shader has no such uniform
+         *
+         * Resolve locations once and use the location setters for uniforms
+         * that are set every draw.
+         */
+        virtual int getUniformLocation(const std::string &name) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setInt(int location, int value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setFloat(int location, float value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setVector2(int location, const Vector2 &value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setVector3(int location, const Vector3 &value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setVector4(int location, const Vector4 &value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setMatrix3(int location, const Matrix3 &value) = 0;
+
+        /**
+         * @brief Sets a uniform value by location
+         * @param location Uniform location from getUniformLocation()
+         * @param value Uniform value
+         */
+        virtual void setMatrix4(int location, const Matrix4 &value) = 0;
+
         /**
          * @brief Gets the shader name
          * @return Shader name
          */
         const std::string &getName() const { return name; }
 
+        /**
+         * @brief Gets the ID used to group draws by shader
+         * @return Sort ID, unique per shader
+         */
+        uint32_t getSortId() const { return sortId; }
+
+        /**
+         * @brief Sets the variant of this shader that reads per-instance data
+         * @param variant Instanced shader, or nullptr to always draw one object at a time
+         *
+         * The variant takes the model matrix and colour from instance
+         * attributes instead of uniforms and must accept the same material
+         * parameters.
+         */
+        void setInstancedVariant(Shader *variant) { instancedVariant = variant; }
+
+        /**
+         * @brief Gets the variant of this shader that reads per-instance data
+         * @return Instanced shader, or nullptr if there is none
+         */
+        Shader *getInstancedVariant() const { return instancedVariant; }
+
+        /**
+         * @brief Sets the variant of this shader used by GPU-driven draws
+         * @param variant Shader that reads each object from the ObjectData storage buffer, or nullptr
+         *
+         * The renderer culls objects on the GPU and draws the survivors with
+         * multi-draw indirect through this variant. It takes the index of
+         * its object from an instance attribute and must accept the same
+         * material parameters.
+         */
+        void setIndirectVariant(Shader *variant) { indirectVariant = variant; }
+
+        /**
+         * @brief Gets the variant of this shader used by GPU-driven draws
+         * @return Indirect shader, or nullptr if there is none
+         */
+        Shader *getIndirectVariant() const { return indirectVariant; }
+
+        /**
+         * @brief Checks if the shader reads camera and light data from the FrameData block
+         * @return True if the shader declares the FrameData block
+         */
+        bool usesFrameUniforms() const { return frameUniforms; }
+
+        /**
+         * @brief Gets the layout of the MaterialData block
+         * @return Block layout, empty if the shader takes material parameters as plain uniforms
+         */
+        const UniformBlockLayout &getMaterialLayout() const { return materialLayout; }
+
+        /**
+         * @brief Gets the number of times the shader was compiled successfully
+         * @return Revision, 0 while the shader has not been compiled
+         *
+         * Uniform locations resolved for an older revision are stale.
+         */
+        uint32_t getRevision() const { return revision; }
+
+        /**
+         * @brief Records which material values the program's uniforms hold
+         * @param materialId Sort ID of the material whose parameters were set, or 0 to forget
+         * @param version Parameter version of the material at that time
+         */
+        void setAppliedMaterial(uint32_t materialId, uint32_t version)
+        {
+            appliedMaterial = materialId;
+            appliedMaterialVersion = version;
+        }
+
+        /**
+         * @brief Checks if the program's uniforms still hold a material's values
+         * @param materialId Sort ID of the material to check
+         * @param version Current parameter version of the material
+         * @return True if setting the material's plain uniforms again would change nothing
+         *
+         * Only holds while all material uniforms are set through Material.
+         */
+        bool hasAppliedMaterial(uint32_t materialId, uint32_t version) const
+        {
+            return appliedMaterial == materialId && appliedMaterialVersion == version;
+        }
+
     protected:
         /**
          * @brief Shader name
          */
         std::string name;
+
+        /**
+         * @brief ID used to group draws by shader
+         */
+        uint32_t sortId;
+
+        /**
+         * @brief Variant of this shader that reads per-instance data
+         */
+        Shader *instancedVariant;
+
+        /**
+         * @brief Variant of this shader used by GPU-driven draws
+         */
+        Shader *indirectVariant;
+
+        /**
+         * @brief Flag that indicates if the shader declares the FrameData block
+         */
+        bool frameUniforms;
+
+        /**
+         * @brief Layout of the MaterialData block
+         */
+        UniformBlockLayout materialLayout;
+
+        /**
+         * @brief Number of successful compilations
+         */
+        uint32_t revision;
+
+        /**
+         * @brief Sort ID of the material whose values the program's uniforms hold
+         */
+        uint32_t appliedMaterial;
+
+        /**
+         * @brief Parameter version of the applied material
+         */
+        uint32_t appliedMaterialVersion;
     };
 
 } // namespace Engine
\ No newline at end of file
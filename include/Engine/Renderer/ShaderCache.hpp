@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Persistent cache of linked shader program binaries
+     *
+     * Entries are keyed by a hash of the shader sources and of the driver
+     * that produced them, one file per program in the cache directory, so a
+     * driver update or a different GPU simply misses and recompiles. Each file
+     * carries a header that is checked again on load, and a corrupt or
+     * rejected entry is removed. The cache does no GL calls itself; it is used
+     * from the thread that owns the GL context.
+     */
+    class ShaderCache
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        ShaderCache();
+
+        /**
+         * @brief Opens the cache directory, creating it if needed
+         * @param directory Directory the binaries are stored in
+         * @param driver String identifying the driver, such as vendor, renderer and version
+         * @return True if the cache can be used, false otherwise
+         */
+        bool initialize(const std::string &directory, const std::string &driver);
+
+        /**
+         * @brief Disables the cache
+         */
+        void shutdown();
+
+        /**
+         * @brief Checks if the cache is open
+         * @return True if load() and store() use the cache directory
+         */
+        bool isEnabled() const { return enabled; }
+
+        /**
+         * @brief Hashes the sources of a program
+         * @param vertexSource Vertex shader source code
+         * @param fragmentSource Fragment shader source code
+         * @return Key of the program in the cache
+         */
+        static uint64_t hashSources(const std::string &vertexSource, const std::string &fragmentSource);
+
+        /**
+         * @brief Loads a program binary
+         * @param sourceHash Key from hashSources()
+         * @param format Receives the driver's binary format
+         * @param binary Receives the binary
+         * @return True on a hit, false if there is no valid entry
+         */
+        bool load(uint64_t sourceHash, uint32_t &format, std::vector<unsigned char> &binary);
+
+        /**
+         * @brief Stores a program binary, replacing any older entry
+         * @param sourceHash Key from hashSources()
+         * @param format Driver's binary format
+         * @param data Binary
+         * @param size Size of the binary in bytes
+         * @return True if the entry was written
+         */
+        bool store(uint64_t sourceHash, uint32_t format, const void *data, size_t size);
+
+        /**
+         * @brief Removes an entry, for example after the driver rejected it
+         * @param sourceHash Key from hashSources()
+         */
+        void remove(uint64_t sourceHash);
+
+        /**
+         * @brief Gets the number of programs loaded from the cache
+         * @return Hit count
+         */
+        uint32_t getHitCount() const { return hits; }
+
+        /**
+         * @brief Gets the number of programs that were not in the cache
+         * @return Miss count
+         */
+        uint32_t getMissCount() const { return misses; }
+
+    private:
+        /**
+         * @brief Gets the file of an entry
+         * @param sourceHash Key from hashSources()
+         * @return Path of the entry
+         */
+        std::string getEntryPath(uint64_t sourceHash) const;
+
+        /**
+         * @brief Directory the binaries are stored in
+         */
+        std::string directory;
+
+        /**
+         * @brief Hash of the driver string
+         */
+        uint64_t driverHash;
+
+        /**
+         * @brief Flag that indicates if the cache is open
+         */
+        bool enabled;
+
+        /**
+         * @brief Number of programs loaded from the cache
+         */
+        uint32_t hits;
+
+        /**
+         * @brief Number of programs that were not in the cache
+         */
+        uint32_t misses;
+    };
+
+} // namespace Engine
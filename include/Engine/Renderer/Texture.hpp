@@ -29,14 +29,52 @@ namespace Engine
 
     /**
      * @brief Texture format
+     *
+     * The block compressed formats are uploaded as is, with their
+     * precomputed mip levels. BC formats need S3TC or BPTC support on
+     * desktop GPUs, ETC2 and ASTC are mostly found on mobile GPUs.
      */
     enum class TextureFormat
     {
         RGB,
         RGBA,
-        Depth
+        Depth,
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC7,
+        ETC2RGB,
+        ETC2RGBA,
+        ASTC4x4,
+        ASTC6x6,
+        ASTC8x8
     };
 
+    /**
+     * @brief Checks if a format is block compressed
+     * @param format Texture format
+     * @return True for the BC, ETC2, and ASTC formats
+     */
+    bool isCompressedFormat(TextureFormat format);
+
+    /**
+     * @brief Gets the size of one mip level
+     * @param format Texture format
+     * @param width Width of the level
+     * @param height Height of the level
+     * @return Size of the level in bytes, rounded up to whole blocks
+     */
+    size_t getTextureLevelSize(TextureFormat format, int width, int height);
+
+    /**
+     * @brief Gets the number of levels in a full mip chain
+     * @param width Width of the base level
+     * @param height Height of the base level
+     * @return Number of levels down to 1x1
+     */
+    int getMipLevelCount(int width, int height);
+
     /**
      * @brief Texture class
      *
@@ -103,6 +141,45 @@ namespace Engine
          */
         virtual void generateMipmaps() = 0;
 
+        /**
+         * @brief Allocates a texture whose mip levels are uploaded one by one
+         * @param width Width of the base level
+         * @param height Height of the base level
+         * @param format Texture format
+         * @param mipCount Number of mip levels
+         * @return True if the format is supported and allocation succeeded, false otherwise
+         *
+         * No level is resident afterwards. Upload levels with uploadMip(),
+         * coarsest first: the texture samples from the finest level that
+         * is resident.
+         */
+        virtual bool allocate(int width, int height, TextureFormat format, int mipCount) = 0;
+
+        /**
+         * @brief Uploads one mip level
+         * @param level Level to upload, one finer than the finest resident level
+         * @param data Pixels or blocks of the level
+         * @param size Size of the data in bytes
+         * @return True if the upload succeeded, false otherwise
+         */
+        virtual bool uploadMip(int level, const unsigned char *data, size_t size) = 0;
+
+        /**
+         * @brief Frees the levels finer than a level
+         * @param level New finest resident level
+         */
+        virtual void dropMips(int level) = 0;
+
+        /**
+         * @brief Exchanges the GPU storage and size with another texture
+         * @param other Texture created by the same renderer
+         *
+         * Used to replace a texture in place when its file is reloaded, so
+         * any pointer to it stays valid. Must run on the thread that owns
+         * the graphics context.
+         */
+        virtual void swapContents(Texture &other);
+
         /**
          * @brief Gets the texture width
          * @return Texture width
@@ -121,6 +198,24 @@ namespace Engine
          */
         TextureFormat getFormat() const { return format; }
 
+        /**
+         * @brief Gets the number of mip levels
+         * @return Number of levels, resident or not
+         */
+        int getMipCount() const { return mipCount; }
+
+        /**
+         * @brief Gets the finest resident mip level
+         * @return Level index, getMipCount() if no level is resident
+         */
+        int getResidentMip() const { return residentMip; }
+
+        /**
+         * @brief Gets the GPU memory used by the texture
+         * @return Size of the resident mip levels in bytes
+         */
+        size_t getMemorySize() const;
+
     protected:
         /**
          * @brief Texture width
@@ -136,6 +231,16 @@ namespace Engine
          * @brief Texture format
          */
         TextureFormat format;
+
+        /**
+         * @brief Number of mip levels
+         */
+        int mipCount;
+
+        /**
+         * @brief Finest resident mip level
+         */
+        int residentMip;
     };
 
 } // namespace Engine
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Engine
+{
+
+    /**
+     * @brief Binding points shared by the renderer and all shaders
+     */
+    enum class UniformBinding : uint32_t
+    {
+        Frame = 0,
+        Material = 1
+    };
+
+    /**
+     * @brief Per-frame shader data, laid out like the std140 FrameData block
+     *
+     * Shaders declare the matching block as
+     * @code
+     * layout (std140) uniform FrameData
+     * {
+     *     mat4 view;
+     *     mat4 projection;
+     *     mat4 viewProjection;
+     *     vec4 cameraPosition;
+     *     vec4 lightPosition;
+     *     vec4 lightColor;
+     * };
+     * @endcode
+     */
+    struct FrameUniforms
+    {
+        /**
+         * @brief View matrix
+         */
+        float view[16];
+
+        /**
+         * @brief Projection matrix
+         */
+        float projection[16];
+
+        /**
+         * @brief Projection matrix times view matrix
+         */
+        float viewProjection[16];
+
+        /**
+         * @brief Camera position in world space (w unused)
+         */
+        float cameraPosition[4];
+
+        /**
+         * @brief Light position in world space (w unused)
+         */
+        float lightPosition[4];
+
+        /**
+         * @brief Light colour scaled by intensity (w unused)
+         */
+        float lightColor[4];
+    };
+
+    /**
+     * @brief Layout of a uniform block as reported by the shader compiler
+     */
+    struct UniformBlockLayout
+    {
+        /**
+         * @brief Size of the block in bytes, or 0 if the shader has no such block
+         */
+        uint32_t size = 0;
+
+        /**
+         * @brief Byte offset of every block member by name
+         */
+        std::unordered_map<std::string, uint32_t> offsets;
+
+        /**
+         * @brief Checks if the block exists
+         * @return True if the shader has no such block
+         */
+        bool empty() const { return size == 0; }
+    };
+
+    /**
+     * @brief Abstract uniform buffer interface
+     *
+     * A uniform buffer holds shader constants in GPU memory so that they can
+     * be shared by many draws and programs and bound with a single call.
+     */
+    class UniformBuffer
+    {
+    public:
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~UniformBuffer() = default;
+
+        /**
+         * @brief Allocates the buffer storage
+         * @param size Size in bytes
+         * @return True if creation succeeded, false otherwise
+         */
+        virtual bool create(size_t size) = 0;
+
+        /**
+         * @brief Uploads data into the buffer
+         * @param data Data to upload
+         * @param size Number of bytes to upload
+         * @param offset Byte offset in the buffer
+         */
+        virtual void setData(const void *data, size_t size, size_t offset = 0) = 0;
+
+        /**
+         * @brief Binds the buffer to a binding point
+         * @param binding Binding point
+         */
+        virtual void bind(UniformBinding binding) const = 0;
+
+        /**
+         * @brief Gets the buffer size
+         * @return Size in bytes
+         */
+        size_t getSize() const { return size; }
+
+    protected:
+        /**
+         * @brief Buffer size in bytes
+         */
+        size_t size = 0;
+    };
+
+} // namespace Engine
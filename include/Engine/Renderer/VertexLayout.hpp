@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine
+{
+
+    struct Vertex;
+
+    /**
+     * @brief Vertex attribute, its value is the shader attribute location
+     */
+    enum class VertexAttribute : uint8_t
+    {
+        Position = 0,
+        Normal = 1,
+        TexCoord = 2,
+        Tangent = 3,
+        Bitangent = 4
+    };
+
+    /**
+     * @brief Number of vertex attributes
+     */
+    const uint32_t VertexAttributeCount = 5;
+
+    /**
+     * @brief Storage format of a vertex attribute
+     */
+    enum class VertexFormat : uint8_t
+    {
+        None = 0,        // Attribute is not stored
+        Float2 = 1,      // Two 32-bit floats
+        Float3 = 2,      // Three 32-bit floats
+        Half2 = 3,       // Two 16-bit floats
+        SNorm1010102 = 4 // Signed normalized x, y, z with 10 bits each and w with 2 bits
+    };
+
+    /**
+     * @brief Size of the indices of a mesh
+     */
+    enum class IndexType : uint8_t
+    {
+        UInt16,
+        UInt32
+    };
+
+    /**
+     * @brief Describes how the attributes of a vertex are stored in a vertex buffer
+     *
+     * Attributes are stored in the order of VertexAttribute and packed without
+     * gaps; every format is a multiple of 4 bytes, so every attribute stays
+     * aligned. standard() matches the Vertex struct; compact() stores normals
+     * and tangents as 10:10:10:2 and texture coordinates as half floats, and
+     * drops the bitangent, which shaders rebuild as
+     * cross(normal, tangent.xyz) * tangent.w. Positions are always Float3 so
+     * the bounds can be read from any layout.
+     */
+    class VertexLayout
+    {
+    public:
+        /**
+         * @brief Constructor, creates a layout without attributes
+         */
+        VertexLayout();
+
+        /**
+         * @brief Gets the layout of the Vertex struct
+         * @return Full float layout with all attributes
+         */
+        static VertexLayout standard();
+
+        /**
+         * @brief Gets the quantized layout
+         * @param tangents Flag indicating if the tangent frame is kept for normal mapping
+         * @return 20 byte layout, or 24 bytes with tangents
+         */
+        static VertexLayout compact(bool tangents);
+
+        /**
+         * @brief Sets the format of an attribute
+         * @param attribute Attribute to change
+         * @param format New format, VertexFormat::None to remove the attribute
+         */
+        void set(VertexAttribute attribute, VertexFormat format);
+
+        /**
+         * @brief Gets the format of an attribute
+         * @param attribute Attribute to look up
+         * @return Format, VertexFormat::None if the attribute is not stored
+         */
+        VertexFormat getFormat(VertexAttribute attribute) const { return formats[static_cast<uint32_t>(attribute)]; }
+
+        /**
+         * @brief Gets the offset of an attribute in a vertex
+         * @param attribute Attribute to look up
+         * @return Byte offset
+         */
+        uint32_t getOffset(VertexAttribute attribute) const { return offsets[static_cast<uint32_t>(attribute)]; }
+
+        /**
+         * @brief Gets the size of a vertex
+         * @return Distance between two vertices in bytes
+         */
+        uint32_t getStride() const { return stride; }
+
+        /**
+         * @brief Checks if the layout can be drawn
+         * @return True if the positions are stored as Float3
+         */
+        bool isValid() const { return getFormat(VertexAttribute::Position) == VertexFormat::Float3; }
+
+        /**
+         * @brief Packs the layout into an integer, 4 bits per attribute
+         * @return Packed layout, as stored in cooked mesh files
+         */
+        uint32_t pack() const;
+
+        /**
+         * @brief Unpacks a layout made by pack()
+         * @param packed Packed layout
+         * @param layout Receives the layout
+         * @return True if every format is known, false otherwise
+         */
+        static bool unpack(uint32_t packed, VertexLayout &layout);
+
+        /**
+         * @brief Converts vertices to the layout
+         * @param vertices Vertices to convert
+         * @param count Number of vertices
+         * @param output Receives count * getStride() bytes
+         */
+        void quantize(const Vertex *vertices, size_t count, void *output) const;
+
+        /**
+         * @brief Gets the size of a format
+         * @param format Format to look up
+         * @return Size in bytes, 0 for VertexFormat::None
+         */
+        static uint32_t getFormatSize(VertexFormat format);
+
+        /**
+         * @brief Converts a float to a half float, rounding to nearest even
+         * @param value Value to convert
+         * @return IEEE 754 binary16 bits
+         */
+        static uint16_t toHalf(float value);
+
+        /**
+         * @brief Packs a vector into the 10:10:10:2 format
+         * @param x, y, z Components in [-1, 1]
+         * @param w Last component, -1, 0, or 1
+         * @return Packed value, x in the lowest bits
+         */
+        static uint32_t packSNorm1010102(float x, float y, float z, float w);
+
+        /**
+         * @brief Chooses the smallest index type for a vertex count
+         * @param vertexCount Number of vertices the indices refer to
+         * @return IndexType::UInt16 if every index fits 16 bits
+         */
+        static IndexType selectIndexType(size_t vertexCount) { return vertexCount <= 65536 ? IndexType::UInt16 : IndexType::UInt32; }
+
+        /**
+         * @brief Compares two layouts
+         * @param other Layout to compare with
+         * @return True if every attribute has the same format
+         */
+        bool operator==(const VertexLayout &other) const;
+        bool operator!=(const VertexLayout &other) const { return !(*this == other); }
+
+    private:
+        /**
+         * @brief Format of every attribute
+         */
+        VertexFormat formats[VertexAttributeCount];
+
+        /**
+         * @brief Byte offset of every attribute
+         */
+        uint32_t offsets[VertexAttributeCount];
+
+        /**
+         * @brief Size of a vertex in bytes
+         */
+        uint32_t stride;
+    };
+
+    /**
+     * @brief Gets the size of an index type
+     * @param type Index type
+     * @return Size of one index in bytes
+     */
+    inline size_t getIndexSize(IndexType type)
+    {
+        return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
+} // namespace Engine
@@ -4,6 +4,8 @@
 #include <string>
 #include <functional>
 
+#include "Engine/Input/InputEvent.hpp"
+
 namespace Engine
 {
     /**
@@ -48,6 +50,19 @@ namespace Engine
          */
         virtual void swapBuffers() = 0;
 
+        /**
+         * @brief Makes the window's graphics context current on the calling thread
+         */
+        virtual void makeContextCurrent() = 0;
+
+        /**
+         * @brief Detaches the window's graphics context from the calling thread
+         *
+         * A context can only be current on one thread at a time, so it has to
+         * be released before another thread makes it current.
+         */
+        virtual void releaseContext() = 0;
+
         /**
          * @brief Checks if the window should close
          * @return True if the window should close, false otherwise
@@ -84,7 +99,43 @@ namespace Engine
          */
         virtual void *getNativeHandle() const = 0;
 
+        /**
+         * @brief Sets the queue input events are pushed to
+         * @param queue Event queue, or nullptr to stop reporting input
+         *
+         * Events are pushed from the thread that calls pollEvents().
+         */
+        void setInputEventQueue(InputEventQueue *queue) { inputEvents = queue; }
+
+        /**
+         * @brief Gets the number of input events dropped because the queue was full
+         * @return Dropped event count
+         */
+        uint64_t getDroppedInputEventCount() const { return droppedInputEvents; }
+
     protected:
+        /**
+         * @brief Pushes an input event to the queue, if one is set
+         * @param event Event to push
+         */
+        void pushInputEvent(InputEvent &&event)
+        {
+            if (inputEvents && !inputEvents->tryPush(std::move(event)))
+            {
+                ++droppedInputEvents;
+            }
+        }
+
+        /**
+         * @brief Queue input events are pushed to, may be nullptr
+         */
+        InputEventQueue *inputEvents = nullptr;
+
+        /**
+         * @brief Number of input events dropped because the queue was full
+         */
+        uint64_t droppedInputEvents = 0;
+
         /**
          * @brief Window width
          */
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Engine/Resources/AssetData.hpp"
+#include "Engine/Resources/MappedFile.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Header at the start of an asset archive
+     *
+     * The header is followed by the index, one AssetArchiveEntry per asset
+     * sorted by hash, and then the asset bytes, each starting at an
+     * AssetArchiveAlignment aligned offset. Every value is little-endian.
+     */
+    struct AssetArchiveHeader
+    {
+        /**
+         * @brief File identifier, AssetArchiveMagic
+         */
+        uint32_t magic;
+
+        /**
+         * @brief Format version, AssetArchiveVersion
+         */
+        uint32_t version;
+
+        /**
+         * @brief Number of index entries
+         */
+        uint32_t entryCount;
+
+        /**
+         * @brief Unused, keeps the offsets aligned
+         */
+        uint32_t reserved;
+
+        /**
+         * @brief File offset of the index
+         */
+        uint64_t indexOffset;
+    };
+
+    /**
+     * @brief How an archive entry is stored
+     */
+    enum class AssetCompression : uint32_t
+    {
+        None = 0,
+        LZ4 = 1
+    };
+
+    /**
+     * @brief Index entry of an asset archive
+     */
+    struct AssetArchiveEntry
+    {
+        /**
+         * @brief Hash of the normalized asset path
+         */
+        uint64_t hash;
+
+        /**
+         * @brief File offset of the stored bytes
+         */
+        uint64_t offset;
+
+        /**
+         * @brief Number of stored bytes
+         */
+        uint64_t storedSize;
+
+        /**
+         * @brief Number of bytes after decompression
+         */
+        uint64_t size;
+
+        /**
+         * @brief AssetCompression of the stored bytes
+         */
+        uint32_t compression;
+
+        /**
+         * @brief Unused, keeps the entries aligned
+         */
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief "PACK" in file byte order
+     */
+    const uint32_t AssetArchiveMagic = 0x4B434150;
+
+    /**
+     * @brief Current format version
+     */
+    const uint32_t AssetArchiveVersion = 1;
+
+    /**
+     * @brief Alignment of the asset bytes in an archive
+     */
+    const uint64_t AssetArchiveAlignment = 16;
+
+    /**
+     * @brief Read-only, memory-mapped asset archive
+     *
+     * Assets are found by binary search over the hashes of their paths, so a
+     * lookup touches neither the file system nor any strings. Uncompressed
+     * assets are returned as views into the mapping; LZ4 compressed ones are
+     * decompressed into a buffer. Lookups are safe from any thread.
+     */
+    class AssetArchive
+    {
+    public:
+        /**
+         * @brief Maps and validates an archive
+         * @param filepath Path to the archive
+         * @return True if the archive is valid, false otherwise
+         */
+        bool open(const std::string &filepath);
+
+        /**
+         * @brief Unmaps the archive
+         */
+        void close();
+
+        /**
+         * @brief Checks if an archive is open
+         * @return True if a valid archive is mapped
+         */
+        bool isOpen() const { return index != nullptr; }
+
+        /**
+         * @brief Finds an asset
+         * @param path Asset path relative to the resources directory
+         * @return Index entry, or nullptr if the archive does not contain the asset
+         */
+        const AssetArchiveEntry *find(const std::string &path) const;
+
+        /**
+         * @brief Reads an asset
+         * @param entry Entry returned by find()
+         * @param data Receives the asset bytes
+         * @return True if reading succeeded, false otherwise
+         */
+        bool read(const AssetArchiveEntry &entry, AssetData &data) const;
+
+        /**
+         * @brief Reads the stored bytes of an asset ahead of use
+         * @param entry Entry returned by find()
+         */
+        void prefetch(const AssetArchiveEntry &entry) const;
+
+        /**
+         * @brief Gets the number of assets
+         * @return Number of index entries
+         */
+        uint32_t getEntryCount() const { return entryCount; }
+
+        /**
+         * @brief Hashes an asset path the way the index does
+         * @param path Asset path; backslashes match slashes and a leading "./" is ignored
+         * @return 64-bit FNV-1a hash of the normalized path
+         */
+        static uint64_t hashPath(const std::string &path);
+
+    private:
+        /**
+         * @brief Mapped archive
+         */
+        MappedFile file;
+
+        /**
+         * @brief Index inside the mapping
+         */
+        const AssetArchiveEntry *index = nullptr;
+
+        /**
+         * @brief Number of index entries
+         */
+        uint32_t entryCount = 0;
+
+        /**
+         * @brief Archive path, for error messages
+         */
+        std::string path;
+    };
+
+} // namespace Engine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Builds asset archives read by AssetArchive
+     *
+     * Meant for offline tools: collect the assets with add(), then write()
+     * sorts the index, compresses entries, and lays out the file.
+     */
+    class AssetArchiveWriter
+    {
+    public:
+        /**
+         * @brief Adds an asset
+         * @param path Asset path relative to the resources directory
+         * @param data Bytes of the asset
+         * @param compress Flag indicating if the asset may be stored LZ4 compressed
+         */
+        void add(const std::string &path, std::vector<unsigned char> data, bool compress);
+
+        /**
+         * @brief Writes the archive
+         * @param filepath Path to the output file
+         * @return True if writing succeeded, false otherwise
+         *
+         * Fails if two paths hash to the same value.
+         */
+        bool write(const std::string &filepath) const;
+
+        /**
+         * @brief Gets the number of added assets
+         * @return Number of assets
+         */
+        size_t getAssetCount() const { return assets.size(); }
+
+    private:
+        /**
+         * @brief Asset waiting to be written
+         */
+        struct Asset
+        {
+            /**
+             * @brief Asset path
+             */
+            std::string path;
+
+            /**
+             * @brief Hash of the path
+             */
+            uint64_t hash;
+
+            /**
+             * @brief Bytes of the asset
+             */
+            std::vector<unsigned char> data;
+
+            /**
+             * @brief Flag indicating if the asset may be compressed
+             */
+            bool compress;
+        };
+
+        /**
+         * @brief Assets in the order they were added
+         */
+        std::vector<Asset> assets;
+    };
+
+} // namespace Engine
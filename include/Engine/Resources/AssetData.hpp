@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Engine/Resources/MappedFile.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Bytes of one asset
+     *
+     * The bytes either point into a mounted archive, live in a mapping of a
+     * loose file, or are owned by the object after decompression. Either way
+     * they stay valid, and at least 16 byte aligned, for the lifetime of the
+     * object.
+     */
+    class AssetData
+    {
+    public:
+        /**
+         * @brief Constructs empty data
+         */
+        AssetData() = default;
+
+        AssetData(AssetData &&) = default;
+        AssetData &operator=(AssetData &&) = default;
+
+        /**
+         * @brief Refers to memory owned by someone else
+         * @param bytes Start of the asset
+         * @param length Size of the asset in bytes
+         */
+        void view(const unsigned char *bytes, size_t length)
+        {
+            reset();
+            data = bytes;
+            size = length;
+        }
+
+        /**
+         * @brief Takes ownership of a buffer
+         * @param buffer Bytes of the asset
+         */
+        void assign(std::vector<unsigned char> buffer)
+        {
+            reset();
+            storage = std::move(buffer);
+            data = storage.data();
+            size = storage.size();
+        }
+
+        /**
+         * @brief Maps a loose file
+         * @param filepath Path to the file
+         * @return True if mapping succeeded, false otherwise
+         */
+        bool mapFile(const std::string &filepath)
+        {
+            reset();
+            if (!file.open(filepath))
+            {
+                return false;
+            }
+            data = file.getData();
+            size = file.getSize();
+            return true;
+        }
+
+        /**
+         * @brief Releases the bytes
+         */
+        void reset()
+        {
+            data = nullptr;
+            size = 0;
+            std::vector<unsigned char>().swap(storage);
+            file.close();
+        }
+
+        /**
+         * @brief Reads every page of the asset ahead of use
+         */
+        void prefetch() const { prefetchMemory(data, size); }
+
+        /**
+         * @brief Gets the bytes
+         * @return Start of the asset, or nullptr if empty
+         */
+        const unsigned char *getData() const { return data; }
+
+        /**
+         * @brief Gets the size
+         * @return Size of the asset in bytes
+         */
+        size_t getSize() const { return size; }
+
+        /**
+         * @brief Checks if there are any bytes
+         * @return True if the asset is empty
+         */
+        bool isEmpty() const { return size == 0; }
+
+    private:
+        /**
+         * @brief Start of the asset
+         */
+        const unsigned char *data = nullptr;
+
+        /**
+         * @brief Size of the asset in bytes
+         */
+        size_t size = 0;
+
+        /**
+         * @brief Owned bytes, for decompressed assets
+         */
+        std::vector<unsigned char> storage;
+
+        /**
+         * @brief Mapping, for loose files
+         */
+        MappedFile file;
+    };
+
+} // namespace Engine
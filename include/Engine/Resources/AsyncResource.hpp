@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "Engine/Resources/ResourceHandle.hpp"
+
+namespace Engine
+{
+    class ResourceManager;
+
+    /**
+     * @brief Progress of an asynchronous resource load
+     */
+    enum class LoadState
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    /**
+     * @brief Handle to a resource that is loaded in the background
+     *
+     * Copies of a handle share the same load. While the load is pending, and
+     * after it failed, get() returns the placeholder for the resource type, so
+     * the handle can be used for rendering right away; once the load is ready
+     * it returns the loaded resource, which the resource manager owns.
+     *
+     * Pass getHandle() to ResourceManager::acquire() to keep the loaded
+     * resource from being evicted when a memory budget is set.
+     */
+    template <typename T>
+    class AsyncResource
+    {
+    public:
+        /**
+         * @brief Constructs an empty handle
+         */
+        AsyncResource() = default;
+
+        /**
+         * @brief Checks if the handle refers to a load
+         * @return True if the handle was returned by the resource manager
+         */
+        bool isValid() const { return state != nullptr; }
+
+        /**
+         * @brief Gets the progress of the load
+         * @return Load state, Failed for empty handles
+         */
+        LoadState getState() const
+        {
+            return state ? state->state.load(std::memory_order_acquire) : LoadState::Failed;
+        }
+
+        /**
+         * @brief Checks if the resource is loaded
+         * @return True if get() returns the loaded resource
+         */
+        bool isReady() const { return getState() == LoadState::Ready; }
+
+        /**
+         * @brief Checks if the load finished, successfully or not
+         * @return True if the load is no longer pending
+         */
+        bool isDone() const { return getState() != LoadState::Pending; }
+
+        /**
+         * @brief Gets the resource
+         * @return Loaded resource when ready, otherwise the placeholder (may be nullptr)
+         */
+        T *get() const { return state ? state->resource.load(std::memory_order_acquire) : nullptr; }
+
+        /**
+         * @brief Gets the handle of the loaded resource
+         * @return Resource handle when ready, otherwise an invalid handle
+         */
+        ResourceHandle<T> getHandle() const
+        {
+            return ResourceHandle<T>(state ? state->handle.load(std::memory_order_acquire) : ResourceHandle<T>::InvalidValue);
+        }
+
+    private:
+        friend class ResourceManager;
+
+        /**
+         * @brief State shared by all copies of a handle
+         */
+        struct State
+        {
+            /**
+             * @brief Progress of the load
+             */
+            std::atomic<LoadState> state{LoadState::Pending};
+
+            /**
+             * @brief Loaded resource, or the placeholder until then
+             */
+            std::atomic<T *> resource{nullptr};
+
+            /**
+             * @brief Packed handle of the loaded resource
+             */
+            std::atomic<uint32_t> handle{ResourceHandle<T>::InvalidValue};
+        };
+
+        /**
+         * @brief Constructs a handle to a load
+         * @param state Shared load state
+         */
+        explicit AsyncResource(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+        /**
+         * @brief Shared load state
+         */
+        std::shared_ptr<State> state;
+    };
+
+} // namespace Engine
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Resources/AssetData.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Header at the start of a cooked mesh file
+     *
+     * A cooked mesh file is the header followed by the vertices, the indices,
+     * the sub-meshes, and the levels of detail, each section starting at a
+     * 16 byte aligned offset. The index section holds every level.
+     * Vertices are stored in the VertexLayout named by the header, either
+     * the in-memory layout of Vertex or a quantized one, indices are 16 or
+     * 32 bits, and every value is little-endian, so the sections can be
+     * uploaded in place.
+     */
+    struct CookedMeshHeader
+    {
+        /**
+         * @brief File identifier, CookedMeshMagic
+         */
+        uint32_t magic;
+
+        /**
+         * @brief Format version, CookedMeshVersion
+         */
+        uint32_t version;
+
+        /**
+         * @brief Size of one vertex in bytes, the stride of the vertex layout
+         */
+        uint32_t vertexSize;
+
+        /**
+         * @brief Number of sub-meshes
+         */
+        uint32_t subMeshCount;
+
+        /**
+         * @brief Vertex layout, as packed by VertexLayout::pack()
+         */
+        uint32_t vertexLayout;
+
+        /**
+         * @brief Size of one index in bytes, 2 or 4
+         */
+        uint32_t indexSize;
+
+        /**
+         * @brief Number of levels of detail, 0 for a mesh with a single level
+         */
+        uint32_t lodCount;
+
+        /**
+         * @brief Unused, keeps the counts aligned
+         */
+        uint32_t reserved;
+
+        /**
+         * @brief Number of vertices
+         */
+        uint64_t vertexCount;
+
+        /**
+         * @brief Number of indices, counting every level of detail
+         */
+        uint64_t indexCount;
+
+        /**
+         * @brief File offsets of the vertex, index, sub-mesh, and level of detail sections
+         */
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t subMeshOffset;
+        uint64_t lodOffset;
+
+        /**
+         * @brief Bounding box of all vertices
+         */
+        float boundsMin[3];
+        float boundsMax[3];
+
+        /**
+         * @brief Bounding sphere of all vertices
+         */
+        float sphereCenter[3];
+        float sphereRadius;
+    };
+
+    /**
+     * @brief Sub-mesh record in a cooked mesh file
+     */
+    struct CookedSubMesh
+    {
+        /**
+         * @brief First index of the range
+         */
+        uint32_t indexOffset;
+
+        /**
+         * @brief Number of indices in the range
+         */
+        uint32_t indexCount;
+
+        /**
+         * @brief Material slot of the range
+         */
+        uint32_t materialIndex;
+
+        /**
+         * @brief Unused, keeps the bounds aligned
+         */
+        uint32_t reserved;
+
+        /**
+         * @brief Bounding box of the range
+         */
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    /**
+     * @brief Level of detail record in a cooked mesh file
+     */
+    struct CookedLod
+    {
+        /**
+         * @brief First index of the level
+         */
+        uint32_t indexOffset;
+
+        /**
+         * @brief Number of indices of the level
+         */
+        uint32_t indexCount;
+
+        /**
+         * @brief Projected size below which the next level takes over
+         */
+        float screenSize;
+
+        /**
+         * @brief Unused, keeps records 16 bytes
+         */
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief "MESH" in file byte order
+     */
+    const uint32_t CookedMeshMagic = 0x4853454D;
+
+    /**
+     * @brief Current format version; bump it whenever the header or a vertex format changes
+     */
+    const uint32_t CookedMeshVersion = 3;
+
+    /**
+     * @brief Alignment of the sections in a cooked mesh file
+     */
+    const uint64_t CookedMeshAlignment = 16;
+
+    /**
+     * @brief Memory-mapped cooked mesh file
+     *
+     * Maps the file written by MeshCooker, or takes its bytes from an asset
+     * archive, and validates its header; the vertex and index data are handed
+     * to Mesh::build() straight from that memory, without being copied or
+     * parsed. The data stays valid until the file is closed.
+     */
+    class CookedMesh
+    {
+    public:
+        /**
+         * @brief Maps and validates a cooked mesh file
+         * @param filepath Path to the file
+         * @return True if the file is a valid cooked mesh, false otherwise
+         */
+        bool open(const std::string &filepath);
+
+        /**
+         * @brief Validates a cooked mesh that is already in memory
+         * @param data Bytes of the cooked mesh, kept until close()
+         * @param name Name used in error messages
+         * @return True if the data is a valid cooked mesh, false otherwise
+         */
+        bool open(AssetData data, const std::string &name);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void close();
+
+        /**
+         * @brief Reads the whole file into memory ahead of use
+         */
+        void prefetch() const { asset.prefetch(); }
+
+        /**
+         * @brief Checks if a file is open
+         * @return True if a valid file is mapped
+         */
+        bool isOpen() const { return header != nullptr; }
+
+        /**
+         * @brief Gets the mesh data for Mesh::build()
+         * @return Vertices, indices, and bounds pointing into the mapping
+         */
+        MeshData getData() const;
+
+        /**
+         * @brief Gets the sub-meshes
+         * @return Index ranges with their materials and bounds
+         */
+        std::vector<SubMesh> getSubMeshes() const;
+
+        /**
+         * @brief Gets the levels of detail
+         * @return Index ranges for Mesh::setLods(), empty for a mesh with a single level
+         */
+        std::vector<MeshLod> getLods() const;
+
+    private:
+        /**
+         * @brief Layout of the vertices, valid while a file is open
+         */
+        VertexLayout layout;
+
+        /**
+         * @brief Bytes of the file
+         */
+        AssetData asset;
+
+        /**
+         * @brief Header at the start of the mapping
+         */
+        const CookedMeshHeader *header = nullptr;
+    };
+
+} // namespace Engine
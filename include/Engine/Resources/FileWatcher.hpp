@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Reports files that changed under a directory
+     *
+     * Uses inotify on Linux and ReadDirectoryChangesW on Windows, and falls
+     * back to comparing modification times elsewhere. poll() never blocks,
+     * so the watcher can be checked once per frame. Editors often write a
+     * file in several steps, so the same path may be reported more than
+     * once; callers debounce as needed.
+     */
+    class FileWatcher
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        FileWatcher();
+
+        /**
+         * @brief Destructor
+         */
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        /**
+         * @brief Starts watching a directory and all directories below it
+         * @param directory Directory to watch
+         * @return True if watching started, false otherwise
+         */
+        bool start(const std::string &directory);
+
+        /**
+         * @brief Stops watching
+         */
+        void stop();
+
+        /**
+         * @brief Checks if a directory is being watched
+         * @return True between a successful start() and stop()
+         */
+        bool isWatching() const { return state != nullptr; }
+
+        /**
+         * @brief Collects the files that changed since the last call
+         * @param changedPaths Receives paths relative to the watched directory, with '/' separators
+         */
+        void poll(std::vector<std::string> &changedPaths);
+
+    private:
+        /**
+         * @brief Platform state of the watch
+         */
+        struct State;
+
+        /**
+         * @brief Platform state, nullptr when not watching
+         */
+        std::unique_ptr<State> state;
+    };
+
+} // namespace Engine
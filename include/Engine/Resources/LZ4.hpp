@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Engine
+{
+
+    /**
+     * @brief Codec for the LZ4 block format
+     *
+     * Produces and reads raw LZ4 blocks as defined by the reference
+     * implementation (no frame header or checksums), so data compressed by
+     * the lz4 tools with the block API can be read back and vice versa.
+     * Decompression is bounds checked and rejects malformed input.
+     */
+    namespace LZ4
+    {
+        /**
+         * @brief Gets the largest possible compressed size
+         * @param size Size of the input in bytes
+         * @return Upper bound of the compressed size
+         */
+        size_t compressBound(size_t size);
+
+        /**
+         * @brief Compresses a block
+         * @param source Input bytes
+         * @param size Size of the input in bytes
+         * @param output Receives the compressed block
+         */
+        void compress(const unsigned char *source, size_t size, std::vector<unsigned char> &output);
+
+        /**
+         * @brief Decompresses a block
+         * @param source Compressed block
+         * @param size Size of the compressed block in bytes
+         * @param output Buffer for the decompressed bytes
+         * @param outputSize Exact size of the decompressed data
+         * @return True if the block was valid and decompressed to exactly outputSize bytes
+         */
+        bool decompress(const unsigned char *source, size_t size, unsigned char *output, size_t outputSize);
+    }
+
+} // namespace Engine
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Engine
+{
+
+    /**
+     * @brief Reads one byte of every page in a range of memory
+     * @param data Start of the range
+     * @param size Size of the range in bytes
+     *
+     * Faults mapped memory in on the calling thread, so that later reads,
+     * such as a GPU upload on the render thread, do not have to wait for
+     * the disk.
+     */
+    void prefetchMemory(const unsigned char *data, size_t size);
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * The operating system pages the file in on first access, so opening is
+     * cheap and the contents are never copied into process memory.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        MappedFile();
+
+        /**
+         * @brief Destructor
+         */
+        ~MappedFile();
+
+        /**
+         * @brief Move constructor
+         * @param other Mapping to take over
+         */
+        MappedFile(MappedFile &&other) noexcept;
+
+        /**
+         * @brief Move assignment
+         * @param other Mapping to take over
+         * @return This mapping
+         */
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief Maps a file, replacing the current mapping
+         * @param filepath Path to the file
+         * @return True if mapping succeeded, false otherwise
+         */
+        bool open(const std::string &filepath);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void close();
+
+        /**
+         * @brief Reads every page of the mapping ahead of use
+         */
+        void prefetch() const { prefetchMemory(data, size); }
+
+        /**
+         * @brief Checks if a file is mapped
+         * @return True if a file is mapped
+         */
+        bool isOpen() const { return data != nullptr; }
+
+        /**
+         * @brief Gets the mapped bytes
+         * @return Start of the file, aligned to the page size, or nullptr if nothing is mapped
+         */
+        const unsigned char *getData() const { return data; }
+
+        /**
+         * @brief Gets the size of the mapping
+         * @return File size in bytes
+         */
+        size_t getSize() const { return size; }
+
+    private:
+        /**
+         * @brief Mapped bytes
+         */
+        const unsigned char *data;
+
+        /**
+         * @brief File size in bytes
+         */
+        size_t size;
+
+        /**
+         * @brief Platform mapping handle (Windows only)
+         */
+        void *mapping;
+    };
+
+} // namespace Engine
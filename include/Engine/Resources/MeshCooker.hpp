@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Renderer/Mesh.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Writes meshes in the cooked format read by CookedMesh
+     *
+     * Meant for offline tools: it computes the bounds of the mesh and of
+     * every sub-mesh once, quantizes the vertices to the requested layout,
+     * and stores 16-bit indices when the vertex count allows, so loading
+     * only has to map the file. Levels of detail come from
+     * MeshSimplifier::generateLods().
+     */
+    class MeshCooker
+    {
+    public:
+        /**
+         * @brief Writes a cooked mesh file
+         * @param filepath Path to the output file
+         * @param vertices Vertices of the mesh
+         * @param indices Triangle list indices into the vertices, holding every level of detail
+         * @param subMeshes Index ranges with their materials; their bounds are computed here
+         * @param layout Layout the vertices are stored in, must be valid
+         * @param lods Index ranges of the levels of detail, empty for a single level
+         * @return True if writing succeeded, false otherwise
+         */
+        static bool cook(const std::string &filepath, const std::vector<Vertex> &vertices,
+                         const std::vector<uint32_t> &indices, const std::vector<SubMesh> &subMeshes = {},
+                         const VertexLayout &layout = VertexLayout::standard(),
+                         const std::vector<MeshLod> &lods = {});
+    };
+
+} // namespace Engine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Renderer/Mesh.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Builds coarser levels of detail of a triangle mesh
+     *
+     * Collapses edges in the order of their quadric error (Garland and
+     * Heckbert), always moving one end onto the other, so the simplified
+     * triangles index a subset of the original vertices and every level can
+     * share one vertex buffer. Border edges never move: this keeps open
+     * boundaries in place, and since vertices are split along texture and
+     * normal seams, it keeps those seams intact as well.
+     *
+     * Meant for offline tools and cooking; it is not fast enough to run
+     * while a frame is being built.
+     */
+    class MeshSimplifier
+    {
+    public:
+        /**
+         * @brief Simplifies a triangle list
+         * @param vertices Vertices of the mesh
+         * @param indices Triangle list indices into the vertices
+         * @param targetIndexCount Index count to stop at
+         * @param maxError Largest error a collapse may add, in model units
+         * @param resultError Receives the largest error of the collapses made, may be nullptr
+         * @return Simplified triangle list, indexing the same vertices
+         *
+         * Stops early when no collapse is left below maxError or every
+         * remaining one would flip a triangle.
+         */
+        static std::vector<uint32_t> simplify(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
+                                              size_t targetIndexCount, float maxError, float *resultError = nullptr);
+
+        /**
+         * @brief Appends a chain of levels of detail to an index buffer
+         * @param vertices Vertices of the mesh
+         * @param indices Triangle list of the full-detail mesh, receives the coarser levels after it
+         * @param maxLevels Largest number of levels, counting full detail
+         * @param reduction Fraction of the triangles of a level its next level aims for
+         * @param screenError Error a level may show, as a fraction of the screen height
+         * @return Levels for Mesh::setLods(), empty if no coarser level could be built
+         *
+         * Each level is simplified from the one before it, and hands over to
+         * the next once the next level's error, projected, stays below
+         * screenError. The chain ends early when a level saves less than a
+         * tenth of the triangles.
+         */
+        static std::vector<MeshLod> generateLods(const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                                                 uint32_t maxLevels, float reduction = 0.5f, float screenError = 0.001f);
+    };
+
+} // namespace Engine
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+
+    /**
+     * @brief Generational handle to a resource of type T
+     *
+     * Packs a slot index and a generation counter into 32 bits, like
+     * EntityHandle. The generation is bumped every time a slot is recycled,
+     * so a handle to an evicted resource resolves to nullptr instead of to
+     * the resource that later reuses its slot. The type parameter keeps
+     * texture and mesh handles from being mixed up.
+     */
+    template <typename T>
+    struct ResourceHandle
+    {
+        /**
+         * @brief Number of bits used for the slot index
+         */
+        static constexpr uint32_t IndexBits = 20;
+
+        /**
+         * @brief Number of bits used for the generation
+         */
+        static constexpr uint32_t GenerationBits = 32 - IndexBits;
+
+        /**
+         * @brief Mask for the slot index
+         */
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+
+        /**
+         * @brief Mask for the generation
+         */
+        static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+
+        /**
+         * @brief Value of an invalid handle
+         */
+        static constexpr uint32_t InvalidValue = 0xFFFFFFFFu;
+
+        /**
+         * @brief Packed handle value
+         */
+        uint32_t value = InvalidValue;
+
+        /**
+         * @brief Default constructor (invalid handle)
+         */
+        constexpr ResourceHandle() = default;
+
+        /**
+         * @brief Constructor from a packed value
+         * @param value Packed handle value
+         */
+        constexpr explicit ResourceHandle(uint32_t value) : value(value) {}
+
+        /**
+         * @brief Creates a handle from an index and a generation
+         * @param index Slot index
+         * @param generation Slot generation
+         * @return Packed handle
+         */
+        static constexpr ResourceHandle make(uint32_t index, uint32_t generation)
+        {
+            return ResourceHandle(((generation & GenerationMask) << IndexBits) | (index & IndexMask));
+        }
+
+        /**
+         * @brief Gets the slot index
+         * @return Slot index
+         */
+        constexpr uint32_t index() const { return value & IndexMask; }
+
+        /**
+         * @brief Gets the generation
+         * @return Generation
+         */
+        constexpr uint32_t generation() const { return (value >> IndexBits) & GenerationMask; }
+
+        /**
+         * @brief Checks if the handle is valid
+         * @return True if the handle is not the invalid handle
+         */
+        constexpr bool isValid() const { return value != InvalidValue; }
+
+        /**
+         * @brief Equality operator
+         * @param other Handle to compare with
+         * @return True if the handles are equal
+         */
+        constexpr bool operator==(const ResourceHandle &other) const { return value == other.value; }
+
+        /**
+         * @brief Inequality operator
+         * @param other Handle to compare with
+         * @return True if the handles are not equal
+         */
+        constexpr bool operator!=(const ResourceHandle &other) const { return value != other.value; }
+    };
+
+} // namespace Engine
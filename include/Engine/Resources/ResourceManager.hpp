@@ -3,6 +3,18 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Resources/AssetData.hpp"
+#include "Engine/Resources/AsyncResource.hpp"
+#include "Engine/Resources/ResourcePool.hpp"
+#include "Engine/Resources/ResourceRef.hpp"
 
 namespace Engine
 {
@@ -10,12 +22,54 @@ namespace Engine
     class Mesh;
     class Shader;
     class Material;
+    class AssetArchive;
+    class TextureFile;
+    class FileWatcher;
+
+    /**
+     * @brief Handles to resources owned by the resource manager
+     */
+    using TextureHandle = ResourceHandle<Texture>;
+    using MeshHandle = ResourceHandle<Mesh>;
+    using ShaderHandle = ResourceHandle<Shader>;
+    using MaterialHandle = ResourceHandle<Material>;
 
     /**
      * @brief Resource manager class
      *
      * The resource manager is responsible for loading and managing resources like
      * textures, meshes, shaders, and materials.
+     *
+     * The async load functions read and decode files on the job system and
+     * leave only the GPU upload to the thread that owns the graphics context,
+     * which calls processUploads() once per frame with a time budget.
+     * Finished loads are registered by update() on the main thread, so the
+     * resource maps are only ever touched by the main thread.
+     *
+     * Asset paths are looked up in the mounted archives first, newest mount
+     * first, and fall back to loose files under the resources directory
+     * unless loose files are disabled.
+     *
+     * Resources are kept in pools addressed by generational handles. Find a
+     * handle by name once and resolve it every frame without hashing the
+     * name again. Textures and meshes can be given memory budgets: update()
+     * then evicts the least recently used ones that nobody holds a reference
+     * to. Acquire a handle for every resource you keep a pointer to, since
+     * an evicted resource is freed by a later processUploads(), as soon as
+     * no frame in flight can draw it any more. Without a budget nothing is
+     * evicted.
+     *
+     * Textures loaded from KTX2 or DDS files are streamed: the coarse mip
+     * levels are uploaded with the texture, and update() queues one finer
+     * level per frame until the requested level is resident, as long as the
+     * texture budget allows it.
+     *
+     * With auto reload enabled, update() watches the resources directory
+     * and rebuilds the textures, meshes, and shaders whose loose files
+     * changed. A reload goes through the same pipeline as an async load and
+     * swaps the result into the existing object, so handles and pointers
+     * stay valid and the old version is drawn until the new one is ready.
+     * Materials pick up the uniforms of a reloaded shader on their next use.
      */
     class ResourceManager
     {
@@ -28,13 +82,24 @@ namespace Engine
         /**
          * @brief Destructor
          */
-        ~ResourceManager();
+        virtual ~ResourceManager();
 
         /**
          * @brief Initializes the resource manager
+         * @param jobSystem Job system that reads and decodes async loads, or nullptr to decode on the calling thread
          * @return True if initialization succeeded, false otherwise
          */
-        bool initialize();
+        bool initialize(JobSystem *jobSystem = nullptr);
+
+        /**
+         * @brief Creates the placeholders that async loads return while pending
+         * @param shader Shader returned for pending shader loads (not owned, may be nullptr)
+         * @return True if creation succeeded, false otherwise
+         *
+         * Needs the graphics context. The placeholder texture is a single
+         * white texel and the placeholder mesh is a unit cube.
+         */
+        bool createPlaceholders(Shader *shader);
 
         /**
          * @brief Shuts down the resource manager
@@ -54,6 +119,42 @@ namespace Engine
          */
         std::string getResourcePath(const std::string &relativePath) const;
 
+        /**
+         * @brief Mounts an asset archive
+         * @param filepath Path to the archive file
+         * @return True if the archive was mounted, false otherwise
+         *
+         * Archives mounted later are searched first, so patch archives can
+         * override earlier ones.
+         */
+        bool mountArchive(const std::string &filepath);
+
+        /**
+         * @brief Enables or disables loading loose files
+         * @param enabled Flag indicating if assets missing from the archives are read from the resources directory
+         */
+        void setLooseFilesEnabled(bool enabled) { looseFiles = enabled; }
+
+        /**
+         * @brief Opens the bytes of an asset
+         * @param relativePath Asset path relative to the resources directory
+         * @param data Asset data to fill
+         * @return True if the asset was found, false otherwise
+         *
+         * Safe to call from any thread. Uncompressed archive entries and
+         * loose files are returned as mappings, without a copy.
+         */
+        bool openAsset(const std::string &relativePath, AssetData &data) const;
+
+        /**
+         * @brief Reads assets into memory ahead of use
+         * @param relativePaths Asset paths relative to the resources directory
+         *
+         * Spreads the reads over the job system and returns without waiting,
+         * so a level can warm the page cache while it is still loading.
+         */
+        void prefetch(const std::vector<std::string> &relativePaths);
+
         /**
          * @brief Gets a texture by name
          * @param name Texture name
@@ -82,19 +183,227 @@ namespace Engine
          */
         Material *getMaterial(const std::string &name);
 
+        /**
+         * @brief Finds a texture by name
+         * @param name Texture name
+         * @return Handle to the texture, or an invalid handle if it is not loaded
+         */
+        TextureHandle findTexture(const std::string &name) const { return textures.find(name); }
+
+        /**
+         * @brief Finds a mesh by name
+         * @param name Mesh name
+         * @return Handle to the mesh, or an invalid handle if it is not loaded
+         */
+        MeshHandle findMesh(const std::string &name) const { return meshes.find(name); }
+
+        /**
+         * @brief Finds a shader by name
+         * @param name Shader name
+         * @return Handle to the shader, or an invalid handle if it is not loaded
+         */
+        ShaderHandle findShader(const std::string &name) const { return shaders.find(name); }
+
+        /**
+         * @brief Finds a material by name
+         * @param name Material name
+         * @return Handle to the material, or an invalid handle if it does not exist
+         */
+        MaterialHandle findMaterial(const std::string &name) const { return materials.find(name); }
+
+        /**
+         * @brief Gets a texture by handle and marks it as recently used
+         * @param handle Texture handle
+         * @return Pointer to the texture, or nullptr if it was evicted
+         */
+        Texture *getTexture(TextureHandle handle) { return textures.get(handle); }
+
+        /**
+         * @brief Gets a mesh by handle and marks it as recently used
+         * @param handle Mesh handle
+         * @return Pointer to the mesh, or nullptr if it was evicted
+         */
+        Mesh *getMesh(MeshHandle handle) { return meshes.get(handle); }
+
+        /**
+         * @brief Gets a shader by handle
+         * @param handle Shader handle
+         * @return Pointer to the shader, or nullptr if it is not loaded
+         */
+        Shader *getShader(ShaderHandle handle) { return shaders.get(handle); }
+
+        /**
+         * @brief Gets a material by handle
+         * @param handle Material handle
+         * @return Pointer to the material, or nullptr if it does not exist
+         */
+        Material *getMaterial(MaterialHandle handle) { return materials.get(handle); }
+
+        /**
+         * @brief Adds a reference to a texture, which keeps it from being evicted
+         * @param handle Texture handle
+         * @return True if the texture is loaded, false otherwise
+         */
+        bool acquire(TextureHandle handle) { return textures.acquire(handle); }
+
+        /**
+         * @brief Adds a reference to a mesh, which keeps it from being evicted
+         * @param handle Mesh handle
+         * @return True if the mesh is loaded, false otherwise
+         */
+        bool acquire(MeshHandle handle) { return meshes.acquire(handle); }
+
+        /**
+         * @brief Adds a reference to a shader
+         * @param handle Shader handle
+         * @return True if the shader is loaded, false otherwise
+         */
+        bool acquire(ShaderHandle handle) { return shaders.acquire(handle); }
+
+        /**
+         * @brief Adds a reference to a material
+         * @param handle Material handle
+         * @return True if the material exists, false otherwise
+         */
+        bool acquire(MaterialHandle handle) { return materials.acquire(handle); }
+
+        /**
+         * @brief Removes a reference added by acquire()
+         * @param handle Texture handle
+         */
+        void release(TextureHandle handle) { textures.release(handle); }
+
+        /**
+         * @brief Removes a reference added by acquire()
+         * @param handle Mesh handle
+         */
+        void release(MeshHandle handle) { meshes.release(handle); }
+
+        /**
+         * @brief Removes a reference added by acquire()
+         * @param handle Shader handle
+         */
+        void release(ShaderHandle handle) { shaders.release(handle); }
+
+        /**
+         * @brief Removes a reference added by acquire()
+         * @param handle Material handle
+         */
+        void release(MaterialHandle handle) { materials.release(handle); }
+
+        /**
+         * @brief Gets a counted reference to a texture
+         * @param handle Texture handle
+         * @return Reference that keeps the texture from being evicted, empty if it is not loaded
+         */
+        TextureRef getTextureRef(TextureHandle handle) { return TextureRef(textures, handle); }
+
+        /**
+         * @brief Gets a counted reference to a texture
+         * @param name Texture name
+         * @return Reference that keeps the texture from being evicted, empty if it is not loaded
+         */
+        TextureRef getTextureRef(const std::string &name) { return TextureRef(textures, textures.find(name)); }
+
+        /**
+         * @brief Gets a counted reference to a mesh
+         * @param handle Mesh handle
+         * @return Reference that keeps the mesh from being evicted, empty if it is not loaded
+         */
+        MeshRef getMeshRef(MeshHandle handle) { return MeshRef(meshes, handle); }
+
+        /**
+         * @brief Gets a counted reference to a mesh
+         * @param name Mesh name
+         * @return Reference that keeps the mesh from being evicted, empty if it is not loaded
+         */
+        MeshRef getMeshRef(const std::string &name) { return MeshRef(meshes, meshes.find(name)); }
+
+        /**
+         * @brief Gets a counted reference to a material
+         * @param handle Material handle
+         * @return Reference to the material, empty if it does not exist
+         */
+        MaterialRef getMaterialRef(MaterialHandle handle) { return MaterialRef(materials, handle); }
+
+        /**
+         * @brief Gets a counted reference to a material
+         * @param name Material name
+         * @return Reference to the material, empty if it does not exist
+         */
+        MaterialRef getMaterialRef(const std::string &name) { return MaterialRef(materials, materials.find(name)); }
+
+        /**
+         * @brief Sets the texture memory budget
+         * @param bytes Budget in bytes, 0 for unlimited
+         */
+        void setTextureBudget(size_t bytes) { textures.setBudget(bytes); }
+
+        /**
+         * @brief Sets the mesh memory budget
+         * @param bytes Budget in bytes, 0 for unlimited
+         */
+        void setMeshBudget(size_t bytes) { meshes.setBudget(bytes); }
+
+        /**
+         * @brief Sets how many frames the renderer may still draw after update()
+         * @param frames Number of snapshots in flight, 0 if every frame is drawn before the next update()
+         *
+         * Set by the engine when it starts the frame pipeline. Submitted
+         * snapshots hold raw resource pointers, so a resource that update()
+         * evicts is only handed to processUploads() for destruction after
+         * that many further update() calls, when every snapshot submitted
+         * before the eviction has been drawn.
+         */
+        void setFramesInFlight(int frames) { framesInFlight = frames > 0 ? static_cast<uint64_t>(frames) : 0; }
+
+        /**
+         * @brief Gets the texture memory statistics
+         * @return Resident bytes, budget, and counts of the textures
+         */
+        const ResourceStats &getTextureStats() const { return textures.getStats(); }
+
+        /**
+         * @brief Gets the mesh memory statistics
+         * @return Resident bytes, budget, and counts of the meshes
+         */
+        const ResourceStats &getMeshStats() const { return meshes.getStats(); }
+
+        /**
+         * @brief Sets the finest mip level a streamed texture needs
+         * @param handle Texture handle
+         * @param level Finest level to keep resident, 0 for full resolution
+         *
+         * Requesting a coarser level than is resident frees the finer
+         * levels. Textures that are not streamed ignore the request.
+         */
+        void requestTextureMip(TextureHandle handle, int level);
+
+        /**
+         * @brief Sets how much of a streamed texture is uploaded when it is loaded
+         * @param pixels Largest dimension of the finest level uploaded with the texture, 0 to upload every level
+         */
+        void setTextureStreamingStartSize(int pixels) { streamingStartSize = pixels; }
+
         /**
          * @brief Loads a texture from file
          * @param name Texture name
          * @param filepath Path to the texture file
          * @return Pointer to the loaded texture, or nullptr if loading failed
+         *
+         * The pointer holds no reference; the texture can be evicted by the
+         * next update() unless something keeps a TextureRef to it.
          */
         Texture *loadTexture(const std::string &name, const std::string &filepath);
 
         /**
-         * @brief Loads a mesh from file
+         * @brief Loads a mesh from a cooked mesh file
          * @param name Mesh name
-         * @param filepath Path to the mesh file
+         * @param filepath Path to the mesh file, written by MeshCooker
          * @return Pointer to the loaded mesh, or nullptr if loading failed
+         *
+         * The pointer holds no reference; the mesh can be evicted by the
+         * next update() unless something keeps a MeshRef to it.
          */
         Mesh *loadMesh(const std::string &name, const std::string &filepath);
 
@@ -115,62 +424,479 @@ namespace Engine
          */
         Material *createMaterial(const std::string &name, Shader *shader);
 
-    private:
+        /**
+         * @brief Loads a texture in the background
+         * @param name Texture name
+         * @param filepath Path to the texture file
+         * @param onLoaded Called on the main thread with the texture, or nullptr if loading failed
+         * @return Handle that yields the placeholder texture until the load completes
+         *
+         * Requesting a name that is already loaded or loading returns a
+         * handle to the existing texture or load.
+         */
+        AsyncResource<Texture> loadTextureAsync(const std::string &name, const std::string &filepath,
+                                                std::function<void(Texture *)> onLoaded = nullptr);
+
+        /**
+         * @brief Loads a mesh in the background
+         * @param name Mesh name
+         * @param filepath Path to the mesh file
+         * @param onLoaded Called on the main thread with the mesh, or nullptr if loading failed
+         * @return Handle that yields the placeholder mesh until the load completes
+         */
+        AsyncResource<Mesh> loadMeshAsync(const std::string &name, const std::string &filepath,
+                                          std::function<void(Mesh *)> onLoaded = nullptr);
+
+        /**
+         * @brief Loads a shader in the background
+         * @param name Shader name
+         * @param vertexPath Path to the vertex shader file
+         * @param fragmentPath Path to the fragment shader file
+         * @param onLoaded Called on the main thread with the shader, or nullptr if loading failed
+         * @return Handle that yields the placeholder shader until the load completes
+         */
+        AsyncResource<Shader> loadShaderAsync(const std::string &name, const std::string &vertexPath,
+                                              const std::string &fragmentPath,
+                                              std::function<void(Shader *)> onLoaded = nullptr);
+
+        /**
+         * @brief Uploads decoded resources to the GPU
+         * @param budgetMilliseconds Time after which no further upload is started
+         *
+         * Must be called on the thread that owns the graphics context. At
+         * least one upload is done per call, so loads always make progress.
+         */
+        void processUploads(float budgetMilliseconds);
+
+        /**
+         * @brief Checks if decoded resources are waiting for processUploads()
+         * @return True if there are pending uploads
+         */
+        bool hasPendingUploads() const;
+
+        /**
+         * @brief Enables or disables reloading resources whose files changed
+         * @param enabled Flag indicating if the resources directory is watched
+         *
+         * Call after setResourcesPath(). Only loose files are watched;
+         * assets found in a mounted archive reload from the archive.
+         */
+        void setAutoReload(bool enabled);
+
+        /**
+         * @brief Checks if resources are reloaded when their files change
+         * @return True if the resources directory is watched
+         */
+        bool isAutoReloadEnabled() const { return fileWatcher != nullptr; }
+
+        /**
+         * @brief Reloads the resources loaded from a file
+         * @param relativePath Asset path relative to the resources directory
+         * @return True if a loaded resource uses the file, false otherwise
+         *
+         * Returns right away; the resources are swapped by a later update().
+         * A reload requested while one is running starts again once it
+         * finished, so the last version of the file always wins.
+         */
+        bool reloadAsset(const std::string &relativePath);
+
+        /**
+         * @brief Registers finished loads, runs their callbacks, and enforces the budgets
+         *
+         * Must be called on the main thread, once per frame. Evicted
+         * resources are destroyed by a processUploads() after the frames in
+         * flight, see setFramesInFlight().
+         */
+        void update();
+
+        /**
+         * @brief Gets the number of async loads that have not finished yet
+         * @return Number of pending loads
+         */
+        size_t getPendingLoadCount() const;
+
+        /**
+         * @brief Gets the placeholder texture
+         * @return Pointer to the placeholder, or nullptr before createPlaceholders()
+         */
+        Texture *getPlaceholderTexture() const { return placeholderTexture.get(); }
+
+        /**
+         * @brief Gets the placeholder mesh
+         * @return Pointer to the placeholder, or nullptr before createPlaceholders()
+         */
+        Mesh *getPlaceholderMesh() const { return placeholderMesh.get(); }
+
+    protected:
         /**
          * @brief Creates a texture
          * @return Unique pointer to the created texture
+         *
+         * Overridden to load resources without a graphics context, such as
+         * in benchmarks and tools.
          */
-        std::unique_ptr<Texture> createTexture();
+        virtual std::unique_ptr<Texture> createTexture();
 
         /**
          * @brief Creates a mesh
          * @param name Mesh name
          * @return Unique pointer to the created mesh
          */
-        std::unique_ptr<Mesh> createMesh(const std::string &name);
+        virtual std::unique_ptr<Mesh> createMesh(const std::string &name);
 
         /**
          * @brief Creates a shader
          * @param name Shader name
          * @return Unique pointer to the created shader
          */
-        std::unique_ptr<Shader> createShader(const std::string &name);
+        virtual std::unique_ptr<Shader> createShader(const std::string &name);
 
+    private:
         /**
-         * @brief Loads a mesh from file
-         * @param mesh Mesh to load into
-         * @param filepath Path to the mesh file
-         * @return True if loading succeeded, false otherwise
+         * @brief Async load moving from the job system to the GPU to the main thread
+         */
+        struct PendingLoad
+        {
+            /**
+             * @brief Virtual destructor
+             */
+            virtual ~PendingLoad() = default;
+
+            /**
+             * @brief Reads and decodes the files, on a worker thread
+             * @param manager Resource manager that owns the load
+             * @return True if decoding succeeded, false otherwise
+             */
+            virtual bool decode(ResourceManager &manager) = 0;
+
+            /**
+             * @brief Creates the GPU resource, on the graphics thread
+             * @param manager Resource manager that owns the load
+             * @return True if the upload succeeded, false otherwise
+             */
+            virtual bool upload(ResourceManager &manager) = 0;
+
+            /**
+             * @brief Registers the resource and notifies the callbacks, on the main thread
+             * @param manager Resource manager that owns the load
+             */
+            virtual void finish(ResourceManager &manager) = 0;
+
+            /**
+             * @brief Resource name
+             */
+            std::string name;
+
+            /**
+             * @brief Flag indicating if every stage so far succeeded
+             */
+            bool succeeded = true;
+        };
+
+        struct TextureLoad;
+        struct MeshLoad;
+        struct ShaderLoad;
+        struct TextureReload;
+        struct MeshReload;
+        struct ShaderReload;
+
+        /**
+         * @brief Decodes a load on the job system and queues it for upload
+         * @param load Load to start
+         */
+        void startLoad(std::shared_ptr<PendingLoad> load);
+
+        /**
+         * @brief Adds a loaded texture to the pool and starts streaming it
+         * @param name Texture name
+         * @param load Finished load that holds the texture
+         * @return Handle to the texture
+         */
+        TextureHandle addTexture(const std::string &name, TextureLoad &load);
+
+        /**
+         * @brief Queues mip level uploads and drops within the texture budget
+         */
+        void updateStreaming();
+
+        /**
+         * @brief Reloads the assets whose files stopped changing
+         */
+        void updateAutoReload();
+
+        /**
+         * @brief Starts reloading a texture from its file
+         * @param name Texture name
+         * @return True if the texture is loaded, false otherwise
          */
-        bool loadMeshFromFile(Mesh *mesh, const std::string &filepath);
+        bool reloadTexture(const std::string &name);
 
         /**
-         * @brief Loads a file to a string
-         * @param filepath Path to the file
+         * @brief Starts reloading a mesh from its file
+         * @param name Mesh name
+         * @return True if the mesh is loaded, false otherwise
+         */
+        bool reloadMesh(const std::string &name);
+
+        /**
+         * @brief Starts recompiling a shader from its files
+         * @param name Shader name
+         * @return True if the shader is loaded, false otherwise
+         */
+        bool reloadShader(const std::string &name);
+
+        /**
+         * @brief Marks a reload as running
+         * @param key Kind and name of the resource
+         * @return True if the reload can start, false if one is running and was asked to run again
+         */
+        bool beginReload(const std::string &key);
+
+        /**
+         * @brief Marks a reload as finished
+         * @param key Kind and name of the resource
+         * @return True if the resource was asked to reload again while the reload was running
+         */
+        bool endReload(const std::string &key);
+
+        /**
+         * @brief Loads an asset to a string
+         * @param relativePath Asset path relative to the resources directory
          * @param output String to load into
          * @return True if loading succeeded, false otherwise
          */
-        bool loadFileToString(const std::string &filepath, std::string &output);
+        bool loadAssetToString(const std::string &relativePath, std::string &output) const;
+
+        /**
+         * @brief Pool of textures
+         */
+        ResourcePool<Texture> textures;
+
+        /**
+         * @brief Pool of meshes
+         */
+        ResourcePool<Mesh> meshes;
+
+        /**
+         * @brief Pool of shaders
+         */
+        ResourcePool<Shader> shaders;
+
+        /**
+         * @brief Pool of materials, declared last because materials hold texture references
+         */
+        ResourcePool<Material> materials;
+
+        /**
+         * @brief Texture loads in flight by name
+         */
+        std::unordered_map<std::string, std::shared_ptr<TextureLoad>> pendingTextures;
+
+        /**
+         * @brief Mesh loads in flight by name
+         */
+        std::unordered_map<std::string, std::shared_ptr<MeshLoad>> pendingMeshes;
+
+        /**
+         * @brief Shader loads in flight by name
+         */
+        std::unordered_map<std::string, std::shared_ptr<ShaderLoad>> pendingShaders;
+
+        /**
+         * @brief Mutex protecting the upload queues
+         */
+        mutable std::mutex queueMutex;
+
+        /**
+         * @brief Decoded loads waiting for processUploads()
+         */
+        std::deque<std::shared_ptr<PendingLoad>> decodedLoads;
+
+        /**
+         * @brief Uploaded loads waiting for update()
+         */
+        std::deque<std::shared_ptr<PendingLoad>> uploadedLoads;
+
+        /**
+         * @brief Evicted resources waiting to be destroyed on the graphics thread
+         */
+        std::vector<std::unique_ptr<Texture>> evictedTextures;
+        std::vector<std::unique_ptr<Mesh>> evictedMeshes;
+
+        /**
+         * @brief Resources retired by one update(), which snapshots in flight may still draw
+         */
+        struct RetiredResources
+        {
+            /**
+             * @brief Index of the update() that retired the resources
+             */
+            uint64_t frame = 0;
+
+            /**
+             * @brief Retired textures
+             */
+            std::vector<std::unique_ptr<Texture>> textures;
+
+            /**
+             * @brief Retired meshes
+             */
+            std::vector<std::unique_ptr<Mesh>> meshes;
+        };
+
+        /**
+         * @brief Gets the resources retired by the current update()
+         * @return Resources retired in this frame, on the main thread
+         */
+        RetiredResources &getRetiredResources();
+
+        /**
+         * @brief Retired resources in frame order, on the main thread
+         */
+        std::deque<RetiredResources> retiredResources;
+
+        /**
+         * @brief Number of update() calls so far
+         */
+        uint64_t frameIndex = 0;
+
+        /**
+         * @brief Number of frames the renderer may draw after update()
+         */
+        uint64_t framesInFlight = 0;
+
+        /**
+         * @brief Texture loaded from a file with mip levels, on the main thread
+         */
+        struct StreamedTexture
+        {
+            /**
+             * @brief Handle of the texture
+             */
+            TextureHandle handle;
+
+            /**
+             * @brief Texture, owned by the texture pool
+             */
+            Texture *texture = nullptr;
+
+            /**
+             * @brief File the levels are uploaded from
+             */
+            std::shared_ptr<TextureFile> file;
+
+            /**
+             * @brief Finest level requested by requestTextureMip()
+             */
+            int requestedMip = 0;
+
+            /**
+             * @brief Finest level that is resident or queued for upload
+             */
+            int targetMip = 0;
+        };
+
+        /**
+         * @brief Mip level change waiting for processUploads()
+         */
+        struct MipUpload
+        {
+            /**
+             * @brief Texture to change
+             */
+            Texture *texture = nullptr;
+
+            /**
+             * @brief File to upload the level from, nullptr to drop the finer levels
+             */
+            std::shared_ptr<TextureFile> file;
+
+            /**
+             * @brief Level to upload, or new finest level when dropping
+             */
+            int level = 0;
+        };
+
+        /**
+         * @brief Streamed textures by packed handle
+         */
+        std::unordered_map<uint32_t, StreamedTexture> streamedTextures;
+
+        /**
+         * @brief Mip level changes waiting for processUploads()
+         */
+        std::deque<MipUpload> mipUploads;
+
+        /**
+         * @brief Largest dimension of the finest level uploaded with a streamed texture
+         */
+        int streamingStartSize = 64;
+
+        /**
+         * @brief Asset paths of the loaded textures and meshes by name
+         */
+        std::unordered_map<std::string, std::string> texturePaths;
+        std::unordered_map<std::string, std::string> meshPaths;
+
+        /**
+         * @brief Asset paths of the vertex and fragment shader files of the loaded shaders by name
+         */
+        std::unordered_map<std::string, std::pair<std::string, std::string>> shaderPaths;
+
+        /**
+         * @brief Running reloads by kind and name, with a flag to run them again
+         */
+        std::unordered_map<std::string, bool> activeReloads;
+
+        /**
+         * @brief Changed asset paths with the time of their last change, in nanoseconds
+         */
+        std::unordered_map<std::string, uint64_t> changedAssets;
+
+        /**
+         * @brief Watcher of the resources directory, nullptr unless auto reload is enabled
+         */
+        std::unique_ptr<FileWatcher> fileWatcher;
+
+        /**
+         * @brief Job system that decodes async loads
+         */
+        JobSystem *jobSystem = nullptr;
+
+        /**
+         * @brief Counter of decode jobs that have not finished yet
+         */
+        JobCounter decodeCounter;
+
+        /**
+         * @brief Mounted archives in mount order
+         */
+        std::vector<std::unique_ptr<AssetArchive>> archives;
+
+        /**
+         * @brief Mutex protecting the archive list, shared by asset lookups
+         */
+        mutable std::shared_mutex archiveMutex;
 
         /**
-         * @brief Map of textures
+         * @brief Flag indicating if loose files are loaded
          */
-        std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
+        bool looseFiles = true;
 
         /**
-         * @brief Map of meshes
+         * @brief Texture returned by pending texture loads
          */
-        std::unordered_map<std::string, std::unique_ptr<Mesh>> meshes;
+        std::unique_ptr<Texture> placeholderTexture;
 
         /**
-         * @brief Map of shaders
+         * @brief Mesh returned by pending mesh loads
          */
-        std::unordered_map<std::string, std::unique_ptr<Shader>> shaders;
+        std::unique_ptr<Mesh> placeholderMesh;
 
         /**
-         * @brief Map of materials
+         * @brief Shader returned by pending shader loads (not owned)
          */
-        std::unordered_map<std::string, std::unique_ptr<Material>> materials;
+        Shader *placeholderShader = nullptr;
 
         /**
          * @brief Path to the resources directory
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/Resources/ResourceHandle.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Memory statistics of one resource type
+     */
+    struct ResourceStats
+    {
+        /**
+         * @brief Bytes used by the resident resources
+         */
+        size_t residentBytes = 0;
+
+        /**
+         * @brief Memory budget in bytes, 0 if unlimited
+         */
+        size_t budget = 0;
+
+        /**
+         * @brief Number of resident resources
+         */
+        size_t residentCount = 0;
+
+        /**
+         * @brief Number of resident resources without references
+         */
+        size_t unusedCount = 0;
+
+        /**
+         * @brief Number of resources evicted so far
+         */
+        size_t evictionCount = 0;
+    };
+
+    /**
+     * @brief Reference counted resources addressed by generational handles
+     *
+     * Resources live in a slot array, so resolving a handle is an index and a
+     * generation compare instead of a string hash. Every resource has a
+     * reference count; resources without references are kept in least
+     * recently used order and are the only ones evict() may remove, oldest
+     * first, until the pool fits its budget again.
+     *
+     * @tparam T Resource type
+     */
+    template <typename T>
+    class ResourcePool
+    {
+    public:
+        /**
+         * @brief Handle type of the pool
+         */
+        using Handle = ResourceHandle<T>;
+
+        /**
+         * @brief Adds a resource without references
+         * @param name Resource name, which must not be in the pool yet
+         * @param resource Resource to take ownership of
+         * @param bytes Memory used by the resource, counted against the budget
+         * @return Handle to the resource
+         */
+        Handle add(const std::string &name, std::unique_ptr<T> resource, size_t bytes = 0)
+        {
+            uint32_t index;
+            if (!freeSlots.empty())
+            {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(slots.size());
+                slots.emplace_back();
+            }
+
+            Slot &slot = slots[index];
+            slot.resource = std::move(resource);
+            slot.name = name;
+            slot.bytes = bytes;
+            slot.refCount = 0;
+            linkUnused(index);
+
+            names[name] = index;
+            stats.residentBytes += bytes;
+            ++stats.residentCount;
+            return Handle::make(index, slot.generation);
+        }
+
+        /**
+         * @brief Finds a resource by name
+         * @param name Resource name
+         * @return Handle to the resource, or an invalid handle if it is not resident
+         */
+        Handle find(const std::string &name) const
+        {
+            auto it = names.find(name);
+            if (it == names.end())
+            {
+                return Handle();
+            }
+            return Handle::make(it->second, slots[it->second].generation);
+        }
+
+        /**
+         * @brief Gets a resource and marks it as recently used
+         * @param handle Handle to the resource
+         * @return Pointer to the resource, or nullptr if it was evicted or removed
+         */
+        T *get(Handle handle)
+        {
+            Slot *slot = resolve(handle);
+            if (!slot)
+            {
+                return nullptr;
+            }
+
+            // Move unused resources to the back of the eviction order
+            if (slot->refCount == 0)
+            {
+                unlinkUnused(handle.index());
+                linkUnused(handle.index());
+            }
+            return slot->resource.get();
+        }
+
+        /**
+         * @brief Checks if a handle refers to a resident resource
+         * @param handle Handle to check
+         * @return True if the resource is resident
+         */
+        bool contains(Handle handle) const { return resolve(handle) != nullptr; }
+
+        /**
+         * @brief Adds a reference, which keeps the resource from being evicted
+         * @param handle Handle to the resource
+         * @return True if the resource is resident, false otherwise
+         */
+        bool acquire(Handle handle)
+        {
+            Slot *slot = resolve(handle);
+            if (!slot)
+            {
+                return false;
+            }
+
+            if (slot->refCount++ == 0)
+            {
+                unlinkUnused(handle.index());
+            }
+            return true;
+        }
+
+        /**
+         * @brief Removes a reference added by acquire()
+         * @param handle Handle to the resource
+         */
+        void release(Handle handle)
+        {
+            Slot *slot = resolve(handle);
+            if (!slot || slot->refCount == 0)
+            {
+                return;
+            }
+
+            if (--slot->refCount == 0)
+            {
+                linkUnused(handle.index());
+            }
+        }
+
+        /**
+         * @brief Gets the reference count of a resource
+         * @param handle Handle to the resource
+         * @return Number of references, 0 if the resource is not resident
+         */
+        uint32_t getRefCount(Handle handle) const
+        {
+            const Slot *slot = resolve(handle);
+            return slot ? slot->refCount : 0;
+        }
+
+        /**
+         * @brief Changes the memory counted for a resource
+         * @param handle Handle to the resource
+         * @param bytes New size in bytes
+         */
+        void resize(Handle handle, size_t bytes)
+        {
+            Slot *slot = resolve(handle);
+            if (!slot)
+            {
+                return;
+            }
+
+            stats.residentBytes = stats.residentBytes - slot->bytes + bytes;
+            slot->bytes = bytes;
+        }
+
+        /**
+         * @brief Gets the memory counted for a resource
+         * @param handle Handle to the resource
+         * @return Size in bytes, 0 if the resource is not resident
+         */
+        size_t getSize(Handle handle) const
+        {
+            const Slot *slot = resolve(handle);
+            return slot ? slot->bytes : 0;
+        }
+
+        /**
+         * @brief Removes a resource regardless of its references
+         * @param handle Handle to the resource
+         * @return The removed resource, or nullptr if it was not resident
+         */
+        std::unique_ptr<T> remove(Handle handle)
+        {
+            if (!resolve(handle))
+            {
+                return nullptr;
+            }
+            return removeSlot(handle.index());
+        }
+
+        /**
+         * @brief Evicts unused resources until the pool fits its budget
+         * @param evicted Receives the evicted resources, so the caller can destroy them on the right thread
+         * @return Number of evicted resources
+         */
+        size_t evict(std::vector<std::unique_ptr<T>> &evicted)
+        {
+            size_t count = 0;
+            while (stats.budget != 0 && stats.residentBytes > stats.budget && unusedHead != InvalidIndex)
+            {
+                evicted.push_back(removeSlot(unusedHead));
+                ++count;
+            }
+            stats.evictionCount += count;
+            return count;
+        }
+
+        /**
+         * @brief Removes every resource and invalidates all handles
+         */
+        void clear()
+        {
+            freeSlots.clear();
+            for (uint32_t index = static_cast<uint32_t>(slots.size()); index-- > 0;)
+            {
+                Slot &slot = slots[index];
+                if (slot.resource)
+                {
+                    slot.resource.reset();
+                    slot.name.clear();
+                    slot.generation = (slot.generation + 1) & Handle::GenerationMask;
+                }
+                slot.bytes = 0;
+                slot.refCount = 0;
+                slot.previous = slot.next = InvalidIndex;
+                freeSlots.push_back(index);
+            }
+
+            names.clear();
+            unusedHead = unusedTail = InvalidIndex;
+            stats.residentBytes = 0;
+            stats.residentCount = 0;
+            stats.unusedCount = 0;
+        }
+
+        /**
+         * @brief Sets the memory budget
+         * @param bytes Budget in bytes, 0 for unlimited
+         *
+         * The budget is enforced by the next evict().
+         */
+        void setBudget(size_t bytes) { stats.budget = bytes; }
+
+        /**
+         * @brief Gets the memory statistics
+         * @return Resident bytes, budget, and counts
+         */
+        const ResourceStats &getStats() const { return stats; }
+
+    private:
+        /**
+         * @brief Index marking the end of the unused list
+         */
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        /**
+         * @brief Slot holding one resource
+         */
+        struct Slot
+        {
+            /**
+             * @brief Resource, nullptr if the slot is free
+             */
+            std::unique_ptr<T> resource;
+
+            /**
+             * @brief Resource name
+             */
+            std::string name;
+
+            /**
+             * @brief Memory used by the resource
+             */
+            size_t bytes = 0;
+
+            /**
+             * @brief Generation of the slot, bumped when the resource is removed
+             */
+            uint32_t generation = 0;
+
+            /**
+             * @brief Number of references
+             */
+            uint32_t refCount = 0;
+
+            /**
+             * @brief Neighbors in the unused list while the resource has no references
+             */
+            uint32_t previous = InvalidIndex;
+            uint32_t next = InvalidIndex;
+        };
+
+        /**
+         * @brief Resolves a handle to its slot
+         * @param handle Handle to resolve
+         * @return Slot of the resource, or nullptr if the handle is stale
+         */
+        Slot *resolve(Handle handle)
+        {
+            return const_cast<Slot *>(static_cast<const ResourcePool *>(this)->resolve(handle));
+        }
+
+        /**
+         * @brief Resolves a handle to its slot
+         * @param handle Handle to resolve
+         * @return Slot of the resource, or nullptr if the handle is stale
+         */
+        const Slot *resolve(Handle handle) const
+        {
+            uint32_t index = handle.index();
+            if (!handle.isValid() || index >= slots.size())
+            {
+                return nullptr;
+            }
+
+            const Slot &slot = slots[index];
+            return slot.resource && slot.generation == handle.generation() ? &slot : nullptr;
+        }
+
+        /**
+         * @brief Appends a slot to the unused list as the most recently used one
+         * @param index Slot index
+         */
+        void linkUnused(uint32_t index)
+        {
+            Slot &slot = slots[index];
+            slot.previous = unusedTail;
+            slot.next = InvalidIndex;
+            (unusedTail != InvalidIndex ? slots[unusedTail].next : unusedHead) = index;
+            unusedTail = index;
+            ++stats.unusedCount;
+        }
+
+        /**
+         * @brief Unlinks a slot from the unused list
+         * @param index Slot index
+         */
+        void unlinkUnused(uint32_t index)
+        {
+            Slot &slot = slots[index];
+            (slot.previous != InvalidIndex ? slots[slot.previous].next : unusedHead) = slot.next;
+            (slot.next != InvalidIndex ? slots[slot.next].previous : unusedTail) = slot.previous;
+            slot.previous = slot.next = InvalidIndex;
+            --stats.unusedCount;
+        }
+
+        /**
+         * @brief Frees a resident slot
+         * @param index Slot index
+         * @return The resource the slot held
+         */
+        std::unique_ptr<T> removeSlot(uint32_t index)
+        {
+            Slot &slot = slots[index];
+            if (slot.refCount == 0)
+            {
+                unlinkUnused(index);
+            }
+
+            names.erase(slot.name);
+            stats.residentBytes -= slot.bytes;
+            --stats.residentCount;
+
+            std::unique_ptr<T> resource = std::move(slot.resource);
+            slot.name.clear();
+            slot.bytes = 0;
+            slot.refCount = 0;
+            slot.generation = (slot.generation + 1) & Handle::GenerationMask;
+            freeSlots.push_back(index);
+            return resource;
+        }
+
+        /**
+         * @brief Resource slots
+         */
+        std::vector<Slot> slots;
+
+        /**
+         * @brief Indices of free slots
+         */
+        std::vector<uint32_t> freeSlots;
+
+        /**
+         * @brief Slot index of every resident resource by name
+         */
+        std::unordered_map<std::string, uint32_t> names;
+
+        /**
+         * @brief Least and most recently used resources without references
+         */
+        uint32_t unusedHead = InvalidIndex;
+        uint32_t unusedTail = InvalidIndex;
+
+        /**
+         * @brief Memory statistics
+         */
+        ResourceStats stats;
+    };
+
+} // namespace Engine
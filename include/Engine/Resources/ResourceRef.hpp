@@ -0,0 +1,182 @@
+#pragma once
+
+#include <utility>
+
+#include "Engine/Resources/ResourcePool.hpp"
+
+namespace Engine
+{
+
+    class Texture;
+    class Mesh;
+    class Material;
+
+    /**
+     * @brief Counted reference to a resource
+     *
+     * Holds a reference in the resource's pool for as long as it exists, so
+     * the pool cannot evict a resource that a material or a mesh renderer
+     * still draws with. Copies add a reference of their own and moves hand
+     * theirs over. A reference can also wrap a resource that no pool owns,
+     * such as a mesh built at runtime, which the caller keeps alive.
+     *
+     * @tparam T Resource type
+     */
+    template <typename T>
+    class ResourceRef
+    {
+    public:
+        /**
+         * @brief Default constructor (empty reference)
+         */
+        ResourceRef() = default;
+
+        /**
+         * @brief Wraps a resource that no pool owns
+         * @param resource Resource, which must outlive the reference
+         */
+        explicit ResourceRef(T *resource) : resource(resource) {}
+
+        /**
+         * @brief Adds a reference to a pooled resource
+         * @param pool Pool owning the resource, which must outlive the reference
+         * @param handle Handle to the resource
+         *
+         * The reference is empty if the resource is not resident.
+         */
+        ResourceRef(ResourcePool<T> &pool, ResourceHandle<T> handle)
+        {
+            if (pool.acquire(handle))
+            {
+                this->pool = &pool;
+                this->handle = handle;
+                resource = pool.get(handle);
+            }
+        }
+
+        /**
+         * @brief Copy constructor, adds a reference
+         * @param other Reference to copy
+         */
+        ResourceRef(const ResourceRef &other) : pool(other.pool), handle(other.handle), resource(other.resource)
+        {
+            if (pool)
+            {
+                pool->acquire(handle);
+            }
+        }
+
+        /**
+         * @brief Move constructor, takes over the reference
+         * @param other Reference to move from, empty afterwards
+         */
+        ResourceRef(ResourceRef &&other) noexcept : pool(other.pool), handle(other.handle), resource(other.resource)
+        {
+            other.pool = nullptr;
+            other.handle = ResourceHandle<T>();
+            other.resource = nullptr;
+        }
+
+        /**
+         * @brief Destructor, removes the reference
+         */
+        ~ResourceRef() { reset(); }
+
+        /**
+         * @brief Copy assignment, adds a reference to the new resource
+         * @param other Reference to copy
+         * @return Reference to this
+         */
+        ResourceRef &operator=(const ResourceRef &other)
+        {
+            if (this != &other)
+            {
+                ResourceRef copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment, takes over the reference
+         * @param other Reference to move from, empty afterwards
+         * @return Reference to this
+         */
+        ResourceRef &operator=(ResourceRef &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                pool = other.pool;
+                handle = other.handle;
+                resource = other.resource;
+                other.pool = nullptr;
+                other.handle = ResourceHandle<T>();
+                other.resource = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Removes the reference and empties this
+         */
+        void reset()
+        {
+            if (pool)
+            {
+                pool->release(handle);
+            }
+            pool = nullptr;
+            handle = ResourceHandle<T>();
+            resource = nullptr;
+        }
+
+        /**
+         * @brief Gets the resource
+         * @return Pointer to the resource, or nullptr if the reference is empty
+         */
+        T *get() const { return resource; }
+
+        /**
+         * @brief Accesses the resource
+         * @return Pointer to the resource, which must not be empty
+         */
+        T *operator->() const { return resource; }
+
+        /**
+         * @brief Gets the handle of a pooled resource
+         * @return Handle, or an invalid handle if the resource has no pool
+         */
+        ResourceHandle<T> getHandle() const { return handle; }
+
+        /**
+         * @brief Checks if the reference holds a resource
+         * @return True if the reference is not empty
+         */
+        explicit operator bool() const { return resource != nullptr; }
+
+    private:
+        /**
+         * @brief Pool holding the reference, nullptr for resources without a pool
+         */
+        ResourcePool<T> *pool = nullptr;
+
+        /**
+         * @brief Handle of the pooled resource
+         */
+        ResourceHandle<T> handle;
+
+        /**
+         * @brief Referenced resource, stable while the reference is held
+         */
+        T *resource = nullptr;
+    };
+
+    /**
+     * @brief References to resources owned by the resource manager
+     */
+    using TextureRef = ResourceRef<Texture>;
+    using MeshRef = ResourceRef<Mesh>;
+    using MaterialRef = ResourceRef<Material>;
+
+} // namespace Engine
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Resources/AssetData.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Texture container with precomputed mip levels
+     *
+     * Reads KTX2 and DDS files holding a single 2D image in one of the
+     * formats of TextureFormat. The mip levels are handed to the texture
+     * straight from the file data, without being copied or decoded. KTX2
+     * files must not be supercompressed. sRGB variants of a format are read
+     * as the format itself.
+     */
+    class TextureFile
+    {
+    public:
+        /**
+         * @brief Checks if data starts like a KTX2 or DDS file
+         * @param data Start of the file
+         * @param size Size of the file in bytes
+         * @return True if the data should be opened with open()
+         */
+        static bool isContainer(const unsigned char *data, size_t size);
+
+        /**
+         * @brief Validates a KTX2 or DDS file that is already in memory
+         * @param data Bytes of the file, kept until close()
+         * @param name Name used in error messages
+         * @return True if the file holds a supported texture, false otherwise
+         */
+        bool open(AssetData data, const std::string &name);
+
+        /**
+         * @brief Releases the file data
+         */
+        void close();
+
+        /**
+         * @brief Checks if a file is open
+         * @return True if a valid file is open
+         */
+        bool isOpen() const { return !levels.empty(); }
+
+        /**
+         * @brief Gets the width of the base level
+         * @return Width in pixels
+         */
+        int getWidth() const { return width; }
+
+        /**
+         * @brief Gets the height of the base level
+         * @return Height in pixels
+         */
+        int getHeight() const { return height; }
+
+        /**
+         * @brief Gets the texture format
+         * @return Texture format
+         */
+        TextureFormat getFormat() const { return format; }
+
+        /**
+         * @brief Gets the number of mip levels in the file
+         * @return Number of levels, the base level first
+         */
+        int getMipCount() const { return static_cast<int>(levels.size()); }
+
+        /**
+         * @brief Gets the data of a mip level
+         * @param level Level index
+         * @return Pixels or blocks of the level
+         */
+        const unsigned char *getMipData(int level) const { return asset.getData() + levels[level].offset; }
+
+        /**
+         * @brief Gets the size of a mip level
+         * @param level Level index
+         * @return Size of the level in bytes
+         */
+        size_t getMipSize(int level) const { return levels[level].size; }
+
+    private:
+        /**
+         * @brief Location of a mip level in the file
+         */
+        struct Level
+        {
+            /**
+             * @brief Offset of the level data
+             */
+            uint64_t offset;
+
+            /**
+             * @brief Size of the level data
+             */
+            uint64_t size;
+        };
+
+        /**
+         * @brief Parses a KTX2 file
+         * @return Error message, or nullptr if the file is valid
+         */
+        const char *parseKTX2();
+
+        /**
+         * @brief Parses a DDS file
+         * @return Error message, or nullptr if the file is valid
+         */
+        const char *parseDDS();
+
+        /**
+         * @brief Bytes of the file
+         */
+        AssetData asset;
+
+        /**
+         * @brief Size of the base level
+         */
+        int width = 0;
+        int height = 0;
+
+        /**
+         * @brief Texture format
+         */
+        TextureFormat format = TextureFormat::RGBA;
+
+        /**
+         * @brief Mip levels, the base level first
+         */
+        std::vector<Level> levels;
+    };
+
+} // namespace Engine
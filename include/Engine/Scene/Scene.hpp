@@ -5,14 +5,16 @@
 #include <memory>
 #include <unordered_map>
 
-#include "Engine/ECS/Entity.hpp"
-#include "Engine/ECS/System.hpp"
+#include "Engine/ECS/EntityManager.hpp"
+#include "Engine/Math/Bounds.hpp"
+#include "Engine/Renderer/RenderSnapshot.hpp"
+#include "Engine/Scene/SpatialIndex.hpp"
 
 namespace Engine
 {
 
-    class EntityManager;
     class Engine;
+    class Mesh;
 
     /**
      * @brief Scene class
@@ -47,10 +49,26 @@ namespace Engine
          */
         void update(float deltaTime);
 
+        /**
+         * @brief Runs one fixed simulation step of the scene
+         * @param fixedDeltaTime Fixed timestep in seconds
+         */
+        void fixedUpdate(float fixedDeltaTime);
+
         /**
          * @brief Renders the scene
+         * @param alpha Interpolation factor between the last two fixed steps
+         *
+         * Draws the current state immediately; used when the frame is not pipelined.
+         */
+        void render(float alpha = 1.0f);
+
+        /**
+         * @brief Captures everything needed to draw the scene
+         * @param snapshot Snapshot to fill (expected to be cleared)
+         * @param alpha Interpolation factor between the last two fixed steps
          */
-        void render();
+        void buildRenderSnapshot(RenderSnapshot &snapshot, float alpha = 1.0f);
 
         /**
          * @brief Creates an entity
@@ -65,6 +83,21 @@ namespace Engine
          */
         Entity *createEntity(const std::string &name);
 
+        /**
+         * @brief Creates a batch of unnamed entities
+         * @param count Number of entities to create
+         * @param created Receives the created entities, appended in creation order
+         * @return Number of entities created, less than count only if the entity limit was reached
+         */
+        size_t createEntities(size_t count, std::vector<Entity *> &created);
+
+        /**
+         * @brief Names an entity so getEntityByName() finds it
+         * @param entity Entity of this scene
+         * @param name Entity name
+         */
+        void setEntityName(Entity *entity, const std::string &name);
+
         /**
          * @brief Destroys an entity
          * @param entity Pointer to the entity to destroy
@@ -85,6 +118,40 @@ namespace Engine
          */
         Entity *getEntityByName(const std::string &name);
 
+        /**
+         * @brief Brings the spatial index up to date with the entities
+         *
+         * Indexes every active entity with a built mesh by the world-space
+         * box of the mesh; the user data of each proxy is the entity ID.
+         * Only entities whose transform, parent, or mesh changed are
+         * touched. Runs after every update() and fixedUpdate(); call it
+         * directly to query positions changed since then.
+         */
+        void updateSpatialIndex();
+
+        /**
+         * @brief Gets the spatial index of the scene
+         * @return Spatial index for proximity, picking, and culling queries
+         */
+        const SpatialIndex &getSpatialIndex() const { return spatialIndex; }
+
+        /**
+         * @brief Gets the cached view over all entities with the given components
+         * @tparam Ts Component types
+         * @return Reference to the view, valid for the lifetime of the scene
+         */
+        template <typename... Ts>
+        View<Ts...> &view()
+        {
+            return entityManager->view<Ts...>();
+        }
+
+        /**
+         * @brief Gets the entity manager of the scene
+         * @return Reference to the entity manager
+         */
+        EntityManager &getEntityManager() { return *entityManager; }
+
         /**
          * @brief Adds a system to the scene
          * @tparam T System type
@@ -97,42 +164,28 @@ namespace Engine
         {
             static_assert(std::is_base_of<System, T>::value, "T must derive from System");
 
-            // Create system
-            auto system = std::make_unique<T>(engine, std::forward<Args>(args)...);
-            T &systemRef = *system;
-
-            // Initialize system
-            if (!system->initialize())
-            {
-                throw std::runtime_error("Failed to initialize system");
-            }
-
-            // Add system to the map
-            systems[typeid(T)] = std::move(system);
-
-            return systemRef;
+            // The entity manager owns and schedules the system
+            return entityManager->addSystem<T>(std::forward<Args>(args)...);
         }
 
         /**
          * @brief Gets a system by type
-         * @tparam T System type
+         * @tparam T System type, as passed to addSystem()
          * @return Pointer to the system, or nullptr if not found
          */
         template <typename T>
         T *getSystem()
         {
-            static_assert(std::is_base_of<System, T>::value, "T must derive from System");
-
-            auto it = systems.find(typeid(T));
-            if (it == systems.end())
-            {
-                return nullptr;
-            }
-
-            return static_cast<T *>(it->second.get());
+            return entityManager->getSystem<T>();
         }
 
     private:
+        /**
+         * @brief Drops the spatial index entry and name of an entity about to be destroyed
+         * @param entity Entity being destroyed, directly or by a command buffer
+         */
+        void onEntityDestroyed(Entity *entity);
+
         /**
          * @brief Scene name
          */
@@ -149,14 +202,57 @@ namespace Engine
         std::unique_ptr<EntityManager> entityManager;
 
         /**
-         * @brief Map of systems
+         * @brief Map of entity names
          */
-        std::unordered_map<std::type_index, std::unique_ptr<System>> systems;
+        std::unordered_map<std::string, Entity *> entityNames;
 
         /**
-         * @brief Map of entity names
+         * @brief Snapshot reused by render() when the frame is not pipelined
          */
-        std::unordered_map<std::string, Entity *> entityNames;
+        RenderSnapshot immediateSnapshot;
+
+        /**
+         * @brief World-space bounds of the captured meshes, reused every frame
+         */
+        BoundingSphereBatch cullSpheres;
+
+        /**
+         * @brief Culling result per captured mesh, reused every frame
+         */
+        std::vector<uint8_t> cullResults;
+
+        /**
+         * @brief Indexed state of an entity
+         */
+        struct SpatialEntry
+        {
+            int32_t proxy = SpatialIndex::NullProxy;
+            uint64_t transformVersion = 0;
+            const Mesh *mesh = nullptr;
+            BoundingBox meshBounds;
+            Vector3 center;
+            uint64_t lastSeen = 0;
+        };
+
+        /**
+         * @brief Spatial index over entities with meshes
+         */
+        SpatialIndex spatialIndex;
+
+        /**
+         * @brief Indexed entities by entity ID
+         */
+        std::unordered_map<uint32_t, SpatialEntry> spatialEntries;
+
+        /**
+         * @brief Number of updateSpatialIndex() calls, used to find entities that left the index
+         */
+        uint64_t spatialFrame;
+
+        /**
+         * @brief Entities returned by the culling query, reused every frame
+         */
+        std::vector<uint32_t> cullCandidates;
     };
 
 } // namespace Engine
\ No newline at end of file
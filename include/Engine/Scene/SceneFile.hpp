@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Engine/Core/Span.hpp"
+#include "Engine/Resources/AssetData.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Header at the start of a scene file
+     *
+     * A scene file is the header followed by the entity records, the
+     * transform records, the component block table, the entity indices and
+     * records of every block, and the string table, each section starting at
+     * a 16 byte aligned offset. Entities are stored parents first, so every
+     * parent index is smaller than the index of its child. Every value is
+     * little-endian, so the sections are read in place.
+     */
+    struct SceneFileHeader
+    {
+        /**
+         * @brief File identifier, SceneFileMagic
+         */
+        uint32_t magic;
+
+        /**
+         * @brief Format version, SceneFileVersion
+         */
+        uint32_t version;
+
+        /**
+         * @brief Number of entities
+         */
+        uint32_t entityCount;
+
+        /**
+         * @brief Number of component blocks
+         */
+        uint32_t blockCount;
+
+        /**
+         * @brief Size of the string table in bytes
+         */
+        uint64_t stringSize;
+
+        /**
+         * @brief File offsets of the entity, transform, block table, and string sections
+         */
+        uint64_t entityOffset;
+        uint64_t transformOffset;
+        uint64_t blockOffset;
+        uint64_t stringOffset;
+    };
+
+    /**
+     * @brief Range of the string table, not terminated
+     */
+    struct SceneString
+    {
+        /**
+         * @brief Offset in the string table
+         */
+        uint32_t offset;
+
+        /**
+         * @brief Length in bytes
+         */
+        uint32_t length;
+    };
+
+    /**
+     * @brief Entity record in a scene file
+     */
+    struct SceneEntityRecord
+    {
+        /**
+         * @brief Entity name, empty for unnamed entities
+         */
+        SceneString name;
+
+        /**
+         * @brief Index of the parent entity, SceneNoParent for roots
+         */
+        uint32_t parent;
+
+        /**
+         * @brief Entity state bits, such as SceneEntityActive
+         */
+        uint32_t flags;
+    };
+
+    /**
+     * @brief Local transform record in a scene file, one per entity
+     */
+    struct SceneTransformRecord
+    {
+        /**
+         * @brief Local position, Euler rotation, and scale, as set on Transform
+         */
+        float position[3];
+        float rotation[3];
+        float scale[3];
+    };
+
+    /**
+     * @brief All components of one registered type in a scene file
+     *
+     * The block holds one entity index and one record per component, sorted
+     * by entity index, so loading fills the component pool in entity order.
+     */
+    struct SceneComponentBlock
+    {
+        /**
+         * @brief Hash of the name the type was registered under
+         */
+        uint64_t typeId;
+
+        /**
+         * @brief Size of one record in bytes
+         */
+        uint32_t recordSize;
+
+        /**
+         * @brief Number of components
+         */
+        uint32_t count;
+
+        /**
+         * @brief File offsets of the entity indices and of the records
+         */
+        uint64_t entityOffset;
+        uint64_t dataOffset;
+    };
+
+    /**
+     * @brief Bit of SceneEntityRecord::flags set for active entities
+     */
+    const uint32_t SceneEntityActive = 1 << 0;
+
+    /**
+     * @brief "SCNE" in file byte order
+     */
+    const uint32_t SceneFileMagic = 0x454E4353;
+
+    /**
+     * @brief Current format version; bump it whenever a record layout changes
+     */
+    const uint32_t SceneFileVersion = 1;
+
+    /**
+     * @brief Alignment of the sections in a scene file
+     */
+    const uint64_t SceneFileAlignment = 16;
+
+    /**
+     * @brief Parent index of root entities
+     */
+    const uint32_t SceneNoParent = 0xFFFFFFFFu;
+
+    /**
+     * @brief Memory-mapped scene file
+     *
+     * Maps a file written by SceneSerializer, or takes its bytes from an asset
+     * archive, and validates every section and index once, so loading can
+     * read the records straight from that memory without checks. The data
+     * stays valid until the file is closed.
+     */
+    class SceneFile
+    {
+    public:
+        /**
+         * @brief Maps and validates a scene file
+         * @param filepath Path to the file
+         * @return True if the file is a valid scene, false otherwise
+         */
+        bool open(const std::string &filepath);
+
+        /**
+         * @brief Validates a scene file that is already in memory
+         * @param data Bytes of the scene file, kept until close()
+         * @param name Name used in error messages
+         * @return True if the data is a valid scene, false otherwise
+         */
+        bool open(AssetData data, const std::string &name);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void close();
+
+        /**
+         * @brief Reads the whole file into memory ahead of use
+         */
+        void prefetch() const { asset.prefetch(); }
+
+        /**
+         * @brief Checks if a file is open
+         * @return True if a valid file is mapped
+         */
+        bool isOpen() const { return header != nullptr; }
+
+        /**
+         * @brief Gets the size of the file
+         * @return Size in bytes, 0 if no file is open
+         */
+        size_t getSize() const { return header ? asset.getSize() : 0; }
+
+        /**
+         * @brief Gets the entity records
+         * @return Entity records, parents first
+         */
+        Span<const SceneEntityRecord> getEntities() const;
+
+        /**
+         * @brief Gets the transform records
+         * @return Local transform of every entity, in entity order
+         */
+        Span<const SceneTransformRecord> getTransforms() const;
+
+        /**
+         * @brief Gets the component block table
+         * @return One block per stored component type
+         */
+        Span<const SceneComponentBlock> getBlocks() const;
+
+        /**
+         * @brief Gets the entity indices of a block
+         * @param block Block of this file
+         * @return Index of the owning entity of every record
+         */
+        Span<const uint32_t> getBlockEntities(const SceneComponentBlock &block) const;
+
+        /**
+         * @brief Gets the records of a block
+         * @param block Block of this file
+         * @return First record, followed by the others at recordSize strides
+         */
+        const unsigned char *getBlockData(const SceneComponentBlock &block) const;
+
+        /**
+         * @brief Gets a string of the string table
+         * @param string Range written by SceneWriter::addString()
+         * @return Copy of the string, empty if the range is out of bounds
+         */
+        std::string getString(SceneString string) const;
+
+    private:
+        /**
+         * @brief Bytes of the file
+         */
+        AssetData asset;
+
+        /**
+         * @brief Header at the start of the mapping
+         */
+        const SceneFileHeader *header = nullptr;
+    };
+
+} // namespace Engine
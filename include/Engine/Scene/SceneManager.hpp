@@ -8,7 +8,9 @@ namespace Engine
 {
 
     class Scene;
+    class SceneSerializer;
     class Engine;
+    struct RenderSnapshot;
 
     /**
      * @brief Scene manager class
@@ -41,10 +43,24 @@ namespace Engine
          */
         void update(float deltaTime);
 
+        /**
+         * @brief Runs one fixed simulation step of the active scene
+         * @param fixedDeltaTime Fixed timestep in seconds
+         */
+        void fixedUpdate(float fixedDeltaTime);
+
         /**
          * @brief Renders the active scene
+         * @param alpha Interpolation factor between the last two fixed steps
+         */
+        void render(float alpha = 1.0f);
+
+        /**
+         * @brief Captures the active scene into a render snapshot
+         * @param snapshot Snapshot to fill (expected to be cleared)
+         * @param alpha Interpolation factor between the last two fixed steps
          */
-        void render();
+        void buildRenderSnapshot(RenderSnapshot &snapshot, float alpha = 1.0f);
 
         /**
          * @brief Shuts down the scene manager
@@ -58,6 +74,31 @@ namespace Engine
          */
         Scene *createScene(const std::string &name);
 
+        /**
+         * @brief Creates a scene from a scene file
+         * @param name Scene name
+         * @param filepath Path to a file written by saveScene()
+         * @return Pointer to the created scene, or nullptr if the file could not be loaded
+         *
+         * The file is memory-mapped and its entities are created in one batch.
+         * Meshes and materials it refers to have to be loaded first.
+         */
+        Scene *loadScene(const std::string &name, const std::string &filepath);
+
+        /**
+         * @brief Saves a scene to a scene file
+         * @param scene Scene to save
+         * @param filepath Path to the file
+         * @return True if the file was written, false otherwise
+         */
+        bool saveScene(Scene &scene, const std::string &filepath);
+
+        /**
+         * @brief Gets the serializer used by loadScene() and saveScene()
+         * @return Reference to the serializer, to register component types with
+         */
+        SceneSerializer &getSerializer() { return *serializer; }
+
         /**
          * @brief Gets a scene by name
          * @param name Scene name
@@ -90,6 +131,11 @@ namespace Engine
          */
         Engine &engine;
 
+        /**
+         * @brief Saves and loads scene files
+         */
+        std::unique_ptr<SceneSerializer> serializer;
+
         /**
          * @brief Map of scenes
          */
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ECS/EntityManager.hpp"
+#include "Engine/Scene/SceneFile.hpp"
+
+namespace Engine
+{
+
+    class Engine;
+    class Scene;
+
+    /**
+     * @brief String table of a scene file being saved
+     *
+     * Component records refer to names, such as the mesh of a
+     * MeshRendererComponent, through the table instead of storing them
+     * inline, so records keep a fixed size. Equal strings are stored once.
+     */
+    class SceneWriter
+    {
+    public:
+        /**
+         * @brief Adds a string to the table
+         * @param string String to store
+         * @return Range to keep in the record, read back with SceneFile::getString()
+         */
+        SceneString addString(const std::string &string);
+
+        /**
+         * @brief Gets the table
+         * @return Bytes of every string added so far
+         */
+        const std::string &getStrings() const { return strings; }
+
+    private:
+        /**
+         * @brief Bytes of the table
+         */
+        std::string strings;
+
+        /**
+         * @brief Range of every string added so far
+         */
+        std::unordered_map<std::string, SceneString> ranges;
+    };
+
+    /**
+     * @brief Progress of a scene file being added to a scene over several calls
+     *
+     * Start with a default-constructed object and pass it to every
+     * SceneSerializer::load() call for the same file.
+     */
+    struct SceneLoadProgress
+    {
+        /**
+         * @brief Entities created so far, in file order
+         */
+        std::vector<Entity *> entities;
+
+        /**
+         * @brief Component block being loaded
+         */
+        size_t block = 0;
+
+        /**
+         * @brief Next record of that block
+         */
+        size_t record = 0;
+
+        /**
+         * @brief Set once every entity and component was added
+         */
+        bool finished = false;
+    };
+
+    /**
+     * @brief Saves scenes to scene files and loads them back
+     *
+     * Writes the entities of a scene, their names, local transforms, and
+     * parents, and every component of a registered type, each type as one
+     * contiguous block of fixed-size records. Loading reserves room for all
+     * entities once, creates them in batches with
+     * EntityManager::createEntities(), and fills each component pool with
+     * one reserve() and a pass over its block, read straight from the mapped
+     * file. A load can be done at once or spread over several calls.
+     *
+     * Types are registered under a name, whose hash identifies their block
+     * in the file, with a trivially copyable record and two functions
+     * converting between the component and its record. The built-in
+     * MeshRendererComponent, LightComponent, and CameraComponent are
+     * registered on construction; meshes and materials are stored by name
+     * and looked up in the resource manager on load, so they have to be
+     * loaded first.
+     */
+    class SceneSerializer
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param engine Reference to the engine
+         */
+        explicit SceneSerializer(Engine &engine);
+
+        /**
+         * @brief Registers a component type
+         * @tparam T Component type, default constructible
+         * @tparam Record Trivially copyable record stored per component
+         * @param name Name identifying the type in files, stable across builds
+         * @param save Fills a zeroed record from a component
+         * @param load Sets up a default-constructed component from a record
+         * @return True if the type was registered, false if the type or name is already taken
+         *
+         * The record layout is part of the file format: files whose records
+         * of the type have a different size skip them with a warning.
+         */
+        template <typename T, typename Record>
+        bool registerComponent(const std::string &name, std::function<void(const T &, Record &, SceneWriter &)> save,
+                               std::function<void(T &, const Record &, const SceneFile &)> load)
+        {
+            static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+            static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+            static_assert(std::is_trivially_copyable<Record>::value, "Record must be trivially copyable");
+            static_assert(alignof(Record) <= SceneFileAlignment, "Record must fit the section alignment");
+
+            auto saveBlock = [save](EntityManager &manager, const uint32_t *entityIndices, size_t count,
+                                    unsigned char *records, SceneWriter &writer)
+            {
+                ComponentPool<T> &pool = manager.getPool<T>();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    // Padding is zeroed as well, so equal scenes give equal files
+                    Record record;
+                    std::memset(&record, 0, sizeof(Record));
+                    save(*pool.get(entityIndices[i]), record, writer);
+                    std::memcpy(records + i * sizeof(Record), &record, sizeof(Record));
+                }
+            };
+
+            auto reserveBlock = [](EntityManager &manager, size_t count)
+            {
+                ComponentPool<T> &pool = manager.getPool<T>();
+                pool.reserve(pool.size() + count);
+            };
+
+            auto loadBlock = [load](EntityManager &manager, const uint32_t *entityIndices, size_t count,
+                                    const unsigned char *records, const SceneFile &file)
+            {
+                ComponentPool<T> &pool = manager.getPool<T>();
+                const Record *typed = reinterpret_cast<const Record *>(records);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (pool.contains(entityIndices[i]))
+                    {
+                        continue;
+                    }
+
+                    T &component = pool.emplace(entityIndices[i]);
+                    component.setOwner(manager.getEntityByIndex(entityIndices[i]));
+                    load(component, typed[i], file);
+                }
+            };
+
+            return addType({name, 0, getComponentTypeId<T>(), sizeof(Record), saveBlock, reserveBlock, loadBlock});
+        }
+
+        /**
+         * @brief Saves the entities of a scene
+         * @param scene Scene to save
+         * @param filepath Path to the file
+         * @return True if the file was written, false otherwise
+         *
+         * Components of unregistered types are left out. A parent transform
+         * that belongs to no entity of the scene is dropped, making its child
+         * a root.
+         */
+        bool save(Scene &scene, const std::string &filepath) const;
+
+        /**
+         * @brief Adds the entities of a scene file to a scene
+         * @param scene Scene to add to
+         * @param file Open scene file
+         * @return True if the entities were created, false otherwise
+         *
+         * Blocks of unregistered types, or with a different record size, are
+         * skipped with a warning.
+         */
+        bool load(Scene &scene, const SceneFile &file) const;
+
+        /**
+         * @brief Adds part of a scene file to a scene
+         * @param scene Scene to add to
+         * @param file Open scene file, kept open until the load finished
+         * @param progress Position reached by the previous calls, updated
+         * @param maxItems Largest number of entities and components to add
+         * @return True if the call made progress, false if the entities could not be created
+         *
+         * Spreads a large load over several frames. Entities are created
+         * first, then the components block by block, so until
+         * progress.finished is set entities may lack some of their
+         * components. On failure the caller destroys progress.entities.
+         */
+        bool load(Scene &scene, const SceneFile &file, SceneLoadProgress &progress, size_t maxItems) const;
+
+        /**
+         * @brief Maps a scene file and adds its entities to a scene
+         * @param scene Scene to add to
+         * @param filepath Path to the file
+         * @return True if the entities were created, false otherwise
+         */
+        bool load(Scene &scene, const std::string &filepath) const;
+
+    private:
+        /**
+         * @brief Registered component type
+         */
+        struct ComponentType
+        {
+            std::string name;
+            uint64_t id;
+            TypeId type;
+            uint32_t recordSize;
+            std::function<void(EntityManager &, const uint32_t *, size_t, unsigned char *, SceneWriter &)> save;
+            std::function<void(EntityManager &, size_t)> reserve;
+            std::function<void(EntityManager &, const uint32_t *, size_t, const unsigned char *, const SceneFile &)> load;
+        };
+
+        /**
+         * @brief Adds a type to the registry
+         * @param type Type to add, its id is computed from the name
+         * @return True if the type was added, false if the type or name is already taken
+         */
+        bool addType(ComponentType type);
+
+        /**
+         * @brief Registers the engine's own component types
+         */
+        void registerBuiltinComponents();
+
+        /**
+         * @brief Reference to the engine
+         */
+        Engine &engine;
+
+        /**
+         * @brief Registered types in registration order, which is the block order in files
+         */
+        std::vector<ComponentType> types;
+
+        /**
+         * @brief Position in types by type id
+         */
+        std::unordered_map<uint64_t, size_t> typeIds;
+    };
+
+} // namespace Engine
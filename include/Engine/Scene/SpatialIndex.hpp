@@ -0,0 +1,448 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Engine/Math/Bounds.hpp"
+#include "Engine/Math/Frustum.hpp"
+
+namespace Engine
+{
+
+    /**
+     * @brief Dynamic bounding volume hierarchy over axis-aligned boxes
+     *
+     * Every proxy stores a box enlarged by a margin and by its last
+     * displacement, so objects that move a little stay in their leaf and
+     * only objects that leave it are reinserted. The tree is kept balanced
+     * with rotations, so queries stay logarithmic while objects move.
+     *
+     * Queries report the user data of every proxy whose enlarged box passes
+     * the test; callers refine with exact bounds where it matters. Queries do
+     * not modify the tree and may run on several threads at once, as long as
+     * no thread inserts, moves, or removes proxies at the same time.
+     */
+    class SpatialIndex
+    {
+    public:
+        /**
+         * @brief Identifier of a proxy that does not exist
+         */
+        static constexpr int32_t NullProxy = -1;
+
+        /**
+         * @brief Constructor
+         * @param margin Distance every proxy box is enlarged by
+         */
+        explicit SpatialIndex(float margin = 0.1f);
+
+        /**
+         * @brief Adds a proxy
+         * @param box Bounds of the object
+         * @param userData Value reported by queries, such as an entity ID
+         * @return Proxy ID
+         */
+        int32_t insert(const BoundingBox &box, uint32_t userData);
+
+        /**
+         * @brief Removes a proxy
+         * @param proxy Proxy ID returned by insert()
+         */
+        void remove(int32_t proxy);
+
+        /**
+         * @brief Updates the bounds of a proxy
+         * @param proxy Proxy ID returned by insert()
+         * @param box New bounds of the object
+         * @param displacement Movement since the last update, used to enlarge the box
+         * @return True if the proxy had to be reinserted
+         */
+        bool move(int32_t proxy, const BoundingBox &box, const Vector3 &displacement);
+
+        /**
+         * @brief Removes all proxies
+         */
+        void clear();
+
+        /**
+         * @brief Gets the user data of a proxy
+         * @param proxy Proxy ID
+         * @return User data given to insert()
+         */
+        uint32_t getUserData(int32_t proxy) const { return nodes[proxy].userData; }
+
+        /**
+         * @brief Gets the enlarged box of a proxy
+         * @param proxy Proxy ID
+         * @return Box the tree stores for the proxy
+         */
+        const BoundingBox &getFatBounds(int32_t proxy) const { return nodes[proxy].box; }
+
+        /**
+         * @brief Gets the number of proxies
+         * @return Number of proxies
+         */
+        size_t size() const { return proxyCount; }
+
+        /**
+         * @brief Gets the height of the tree
+         * @return Height, 0 for an empty tree or a single proxy
+         */
+        int32_t getHeight() const { return root == NullProxy ? 0 : nodes[root].height; }
+
+        /**
+         * @brief Visits every proxy overlapping a box
+         * @param box Box to test
+         * @param callback Called with the user data, returns false to stop
+         */
+        template <typename Callback>
+        void query(const BoundingBox &box, Callback &&callback) const
+        {
+            traverse([&box](const BoundingBox &node)
+                     { return node.intersects(box); },
+                     [this, &callback](int32_t leaf)
+                     { return callback(nodes[leaf].userData); });
+        }
+
+        /**
+         * @brief Visits every proxy overlapping a sphere
+         * @param sphere Sphere to test
+         * @param callback Called with the user data, returns false to stop
+         */
+        template <typename Callback>
+        void query(const BoundingSphere &sphere, Callback &&callback) const
+        {
+            traverse([&sphere](const BoundingBox &node)
+                     { return sphere.intersects(node); },
+                     [this, &callback](int32_t leaf)
+                     { return callback(nodes[leaf].userData); });
+        }
+
+        /**
+         * @brief Visits every proxy at least partly inside a frustum
+         * @param frustum Frustum to test
+         * @param callback Called with the user data, returns false to stop
+         *
+         * Subtrees fully inside the frustum are reported without further tests.
+         */
+        template <typename Callback>
+        void query(const Frustum &frustum, Callback &&callback) const;
+
+        /**
+         * @brief Visits every proxy a ray passes through
+         * @param ray Ray to cast
+         * @param maxDistance Ignore proxies further away than this
+         * @param callback Called with the user data and entry distance, returns false to stop
+         *
+         * Proxies are visited in tree order, not by distance.
+         */
+        template <typename Callback>
+        void raycast(const Ray &ray, float maxDistance, Callback &&callback) const;
+
+        /**
+         * @brief Collects every proxy at least partly inside a frustum
+         * @param frustum Frustum to test
+         * @param results Receives the user data; cleared first
+         */
+        void queryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const;
+
+        /**
+         * @brief Runs one box query per input box
+         * @param boxes Boxes to test
+         * @param results Receives (box index, user data) pairs; cleared first
+         */
+        void queryBoxes(const std::vector<BoundingBox> &boxes, std::vector<std::pair<uint32_t, uint32_t>> &results) const;
+
+        /**
+         * @brief Runs one sphere query per input sphere
+         * @param spheres Spheres to test
+         * @param results Receives (sphere index, user data) pairs; cleared first
+         */
+        void querySpheres(const std::vector<BoundingSphere> &spheres, std::vector<std::pair<uint32_t, uint32_t>> &results) const;
+
+        /**
+         * @brief Collects every pair of proxies whose boxes overlap
+         * @param results Receives (user data, user data) pairs, each pair once; cleared first
+         *
+         * Serves as the broadphase of a physics step.
+         */
+        void queryOverlappingPairs(std::vector<std::pair<uint32_t, uint32_t>> &results) const;
+
+    private:
+        /**
+         * @brief Tree node; leaves are proxies
+         */
+        struct Node
+        {
+            BoundingBox box;
+            uint32_t userData = 0;
+            int32_t parent = NullProxy;
+            int32_t child1 = NullProxy;
+            int32_t child2 = NullProxy;
+            int32_t height = 0;
+
+            bool isLeaf() const { return child1 == NullProxy; }
+        };
+
+        /**
+         * @brief Traversal depth kept on the call stack; the balanced tree never gets close
+         */
+        static constexpr int StackSize = 128;
+
+        /**
+         * @brief Nodes still to visit, on the call stack unless a traversal goes deeper than StackSize
+         */
+        class TraversalStack
+        {
+        public:
+            /**
+             * @brief Adds a node to visit
+             * @param index Node index
+             */
+            void push(int32_t index)
+            {
+                if (count < StackSize)
+                {
+                    fixed[count++] = index;
+                }
+                else
+                {
+                    overflow.push_back(index);
+                }
+            }
+
+            /**
+             * @brief Takes the node added last
+             * @return Node index
+             */
+            int32_t pop()
+            {
+                if (!overflow.empty())
+                {
+                    int32_t index = overflow.back();
+                    overflow.pop_back();
+                    return index;
+                }
+                return fixed[--count];
+            }
+
+            /**
+             * @brief Checks if every node was visited
+             * @return True if no node is left
+             */
+            bool isEmpty() const { return count == 0 && overflow.empty(); }
+
+        private:
+            /**
+             * @brief First StackSize nodes
+             */
+            int32_t fixed[StackSize];
+
+            /**
+             * @brief Number of nodes in fixed
+             */
+            int count = 0;
+
+            /**
+             * @brief Nodes added while fixed was full, only allocated by degenerate trees
+             */
+            std::vector<int32_t> overflow;
+        };
+
+        /**
+         * @brief Visits the leaves of every subtree whose box passes a test
+         * @param test Called with a node box, returns true to descend
+         * @param callback Called with the node index of accepted leaves, returns false to stop
+         * @param start Subtree to visit, or NullProxy for the whole tree
+         * @return False if the callback stopped the traversal
+         */
+        template <typename Test, typename Callback>
+        bool traverse(Test &&test, Callback &&callback, int32_t start = NullProxy) const;
+
+        /**
+         * @brief Takes a node from the free list, growing the pool if needed
+         * @return Node index
+         */
+        int32_t allocateNode();
+
+        /**
+         * @brief Returns a node to the free list
+         * @param index Node index
+         */
+        void freeNode(int32_t index);
+
+        /**
+         * @brief Links a leaf into the tree next to the sibling that grows the least
+         * @param leaf Node index of the leaf
+         */
+        void insertLeaf(int32_t leaf);
+
+        /**
+         * @brief Unlinks a leaf from the tree
+         * @param leaf Node index of the leaf
+         */
+        void removeLeaf(int32_t leaf);
+
+        /**
+         * @brief Recomputes boxes and heights from a node up to the root, rebalancing on the way
+         * @param index Node to start at
+         */
+        void refit(int32_t index);
+
+        /**
+         * @brief Rotates a subtree if its children's heights differ by more than one
+         * @param index Root of the subtree
+         * @return Index of the new subtree root
+         */
+        int32_t balance(int32_t index);
+
+        /**
+         * @brief Node pool; free nodes are chained through parent
+         */
+        std::vector<Node> nodes;
+
+        /**
+         * @brief Root node, or NullProxy if the tree is empty
+         */
+        int32_t root;
+
+        /**
+         * @brief First free node, or NullProxy
+         */
+        int32_t freeList;
+
+        /**
+         * @brief Number of leaves
+         */
+        size_t proxyCount;
+
+        /**
+         * @brief Distance every proxy box is enlarged by
+         */
+        float margin;
+    };
+
+    template <typename Test, typename Callback>
+    bool SpatialIndex::traverse(Test &&test, Callback &&callback, int32_t start) const
+    {
+        TraversalStack stack;
+        stack.push(start == NullProxy ? root : start);
+
+        while (!stack.isEmpty())
+        {
+            int32_t index = stack.pop();
+            if (index == NullProxy)
+            {
+                continue;
+            }
+
+            const Node &node = nodes[index];
+            if (!test(node.box))
+            {
+                continue;
+            }
+
+            if (node.isLeaf())
+            {
+                if (!callback(index))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename Callback>
+    void SpatialIndex::query(const Frustum &frustum, Callback &&callback) const
+    {
+        TraversalStack stack;
+        stack.push(root);
+
+        auto acceptAll = [](const BoundingBox &)
+        { return true; };
+
+        while (!stack.isEmpty())
+        {
+            int32_t index = stack.pop();
+            if (index == NullProxy)
+            {
+                continue;
+            }
+
+            const Node &node = nodes[index];
+            Frustum::Containment containment = frustum.classify(node.box);
+            if (containment == Frustum::Containment::Outside)
+            {
+                continue;
+            }
+
+            if (node.isLeaf())
+            {
+                if (!callback(node.userData))
+                {
+                    return;
+                }
+            }
+            else if (containment == Frustum::Containment::Inside)
+            {
+                // Everything below is visible; skip the plane tests
+                auto report = [this, &callback](int32_t leaf)
+                { return callback(nodes[leaf].userData); };
+                if (!traverse(acceptAll, report, index))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template <typename Callback>
+    void SpatialIndex::raycast(const Ray &ray, float maxDistance, Callback &&callback) const
+    {
+        TraversalStack stack;
+        stack.push(root);
+
+        while (!stack.isEmpty())
+        {
+            int32_t index = stack.pop();
+            if (index == NullProxy)
+            {
+                continue;
+            }
+
+            const Node &node = nodes[index];
+            float distance;
+            if (!ray.intersects(node.box, maxDistance, distance))
+            {
+                continue;
+            }
+
+            if (node.isLeaf())
+            {
+                if (!callback(node.userData, distance))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+} // namespace Engine
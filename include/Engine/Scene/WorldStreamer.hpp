@@ -0,0 +1,396 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/Vector.hpp"
+#include "Engine/Resources/AsyncResource.hpp"
+#include "Engine/Resources/ResourceHandle.hpp"
+#include "Engine/Scene/SceneFile.hpp"
+#include "Engine/Scene/SceneSerializer.hpp"
+
+namespace Engine
+{
+
+    class Engine;
+    class Mesh;
+    class Scene;
+
+    /**
+     * @brief Contents of one cell of a streamed world
+     */
+    struct WorldCellDesc
+    {
+        /**
+         * @brief Asset path of the cell's scene file, looked up like any other asset
+         */
+        std::string scenePath;
+
+        /**
+         * @brief Asset archive mounted before the cell loads, empty for none
+         */
+        std::string archivePath;
+
+        /**
+         * @brief Name and asset path of every mesh the cell's entities refer to
+         */
+        std::vector<std::pair<std::string, std::string>> meshes;
+    };
+
+    /**
+     * @brief Streaming state of a world cell
+     */
+    enum class WorldCellState
+    {
+        Unloaded,   ///< Not in the scene
+        Loading,    ///< Scene file and meshes are being read in the background
+        Loaded,     ///< Waiting for its turn to be added to the scene
+        Activating, ///< Being added to the scene, a part every frame
+        Active,     ///< Fully in the scene
+        Unloading,  ///< Being removed from the scene, a part every frame
+        Failed      ///< The scene file could not be read; the cell is not tried again
+    };
+
+    /**
+     * @brief Memory and timing of a world cell
+     */
+    struct WorldCellStats
+    {
+        /**
+         * @brief Current state
+         */
+        WorldCellState state = WorldCellState::Unloaded;
+
+        /**
+         * @brief Number of entities the cell has in the scene
+         */
+        size_t entityCount = 0;
+
+        /**
+         * @brief Size of the cell's scene file, kept mapped until the cell is active
+         */
+        size_t fileBytes = 0;
+
+        /**
+         * @brief GPU memory of the cell's meshes, including meshes shared with other cells
+         */
+        size_t meshBytes = 0;
+
+        /**
+         * @brief Time from the load request until the file and meshes were ready
+         */
+        float loadMilliseconds = 0.0f;
+
+        /**
+         * @brief Main thread time spent adding the cell to the scene
+         */
+        float activationMilliseconds = 0.0f;
+
+        /**
+         * @brief Number of frames the activation was spread over
+         */
+        uint32_t activationFrames = 0;
+
+        /**
+         * @brief Number of times the cell was loaded
+         */
+        uint32_t loadCount = 0;
+    };
+
+    /**
+     * @brief Totals over all cells of a streamed world
+     */
+    struct WorldStreamerStats
+    {
+        /**
+         * @brief Number of registered cells
+         */
+        size_t cellCount = 0;
+
+        /**
+         * @brief Number of cells loading, waiting, or activating
+         */
+        size_t pendingCells = 0;
+
+        /**
+         * @brief Number of active cells
+         */
+        size_t activeCells = 0;
+
+        /**
+         * @brief Entities of all cells in the scene
+         */
+        size_t entityCount = 0;
+
+        /**
+         * @brief Scene file bytes held mapped
+         */
+        size_t fileBytes = 0;
+
+        /**
+         * @brief GPU memory of the meshes of all loaded cells, shared meshes counted per cell
+         */
+        size_t meshBytes = 0;
+
+        /**
+         * @brief Main thread time of the last update()
+         */
+        float updateMilliseconds = 0.0f;
+    };
+
+    /**
+     * @brief Settings of a WorldStreamer
+     */
+    struct WorldStreamerConfig
+    {
+        /**
+         * @brief Edge length of a cell on the XZ plane
+         */
+        float cellSize = 128.0f;
+
+        /**
+         * @brief Distance from the focus to a cell's area within which it is loaded
+         */
+        float loadDistance = 256.0f;
+
+        /**
+         * @brief Distance beyond which a cell is unloaded, at least loadDistance
+         *
+         * The gap to loadDistance keeps a focus moving back and forth across
+         * a border from loading and unloading the same cell every frame.
+         */
+        float unloadDistance = 320.0f;
+
+        /**
+         * @brief Main thread time per update() after which no further work is started
+         */
+        float budgetMilliseconds = 2.0f;
+
+        /**
+         * @brief Number of cells read in the background at the same time
+         */
+        uint32_t maxConcurrentLoads = 4;
+
+        /**
+         * @brief Entities or components added or removed between two checks of the budget
+         */
+        size_t batchSize = 256;
+    };
+
+    /**
+     * @brief Streams the cells of a large world into a scene around a focus
+     *
+     * The world is a grid of square cells on the XZ plane, each with its own
+     * scene file and meshes. Cells that come within loadDistance of the
+     * focus, usually the camera, are read on the job system: the scene file
+     * is mapped, validated, and prefetched, and the meshes load through
+     * ResourceManager::loadMeshAsync(). Loaded cells are then added to the
+     * scene nearest first, in batches, until the frame's time budget is
+     * spent; an activation that does not fit continues in the next frame.
+     * Cells beyond unloadDistance have their entities destroyed the same
+     * way, and release the meshes they hold so the mesh budget can evict
+     * them.
+     *
+     * Entities are saved in world space, so the streamer moves nothing.
+     * Entities of a cell belong to the cell: destroying one that is still
+     * activating is not allowed, and entities added to a cell's area by
+     * gameplay stay when the cell unloads.
+     */
+    class WorldStreamer
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param engine Reference to the engine
+         * @param scene Scene the cells are added to, outlives the streamer
+         * @param config Grid and budget settings
+         */
+        WorldStreamer(Engine &engine, Scene &scene, const WorldStreamerConfig &config = WorldStreamerConfig());
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for background reads. Entities of the cells stay in the scene.
+         */
+        ~WorldStreamer();
+
+        WorldStreamer(const WorldStreamer &) = delete;
+        WorldStreamer &operator=(const WorldStreamer &) = delete;
+
+        /**
+         * @brief Registers a cell
+         * @param x Cell column, covering x * cellSize to (x + 1) * cellSize
+         * @param z Cell row, covering z * cellSize to (z + 1) * cellSize
+         * @param desc Scene file and resources of the cell
+         * @return True if the cell was added, false if it already exists
+         */
+        bool addCell(int32_t x, int32_t z, WorldCellDesc desc);
+
+        /**
+         * @brief Streams cells around the active camera
+         *
+         * Does nothing until the renderer has a camera attached to an entity.
+         */
+        void update();
+
+        /**
+         * @brief Streams cells around a position
+         * @param focus World position, usually the camera's
+         *
+         * Call once per frame on the main thread.
+         */
+        void update(const Vector3 &focus);
+
+        /**
+         * @brief Gets the memory and timing of a cell
+         * @param x Cell column
+         * @param z Cell row
+         * @return Pointer to the statistics, or nullptr if the cell does not exist
+         */
+        const WorldCellStats *getCellStats(int32_t x, int32_t z) const;
+
+        /**
+         * @brief Gets the totals over all cells
+         * @return Statistics as of the last update()
+         */
+        const WorldStreamerStats &getStats() const { return stats; }
+
+        /**
+         * @brief Gets the settings
+         * @return Grid and budget settings
+         */
+        const WorldStreamerConfig &getConfig() const { return config; }
+
+    private:
+        /**
+         * @brief Scene file read by a background job
+         */
+        struct PendingFile
+        {
+            SceneFile file;
+            bool opened = false;
+            std::atomic<bool> done{false};
+        };
+
+        /**
+         * @brief Registered cell
+         */
+        struct Cell
+        {
+            int32_t x;
+            int32_t z;
+            WorldCellDesc desc;
+            WorldCellStats stats;
+            float distance = 0.0f;
+            std::shared_ptr<PendingFile> pending;
+            std::vector<AsyncResource<Mesh>> meshLoads;
+            std::vector<ResourceHandle<Mesh>> meshes;
+            SceneLoadProgress progress;
+            std::vector<uint32_t> entityIds;
+            size_t unloadCursor = 0;
+            std::chrono::steady_clock::time_point requestTime;
+        };
+
+        /**
+         * @brief Packs cell coordinates into a map key
+         * @param x Cell column
+         * @param z Cell row
+         * @return Key of the cell
+         */
+        static uint64_t makeKey(int32_t x, int32_t z)
+        {
+            return (uint64_t(uint32_t(x)) << 32) | uint32_t(z);
+        }
+
+        /**
+         * @brief Starts reading a cell in the background
+         * @param cell Unloaded cell
+         */
+        void requestCell(Cell &cell);
+
+        /**
+         * @brief Moves a loading cell on once its file and meshes are ready
+         * @param cell Loading cell
+         */
+        void pollCell(Cell &cell);
+
+        /**
+         * @brief Adds one batch of a cell to the scene
+         * @param cell Loaded or activating cell
+         */
+        void activateBatch(Cell &cell);
+
+        /**
+         * @brief Removes one batch of a cell from the scene
+         * @param cell Unloading cell
+         */
+        void unloadBatch(Cell &cell);
+
+        /**
+         * @brief Starts removing a cell, or drops it right away if nothing of it is in the scene yet
+         * @param cell Cell that left the unload distance
+         */
+        void beginUnload(Cell &cell);
+
+        /**
+         * @brief Releases the cell's file and meshes and marks it unloaded
+         * @param cell Cell whose entities are gone
+         */
+        void finishUnload(Cell &cell);
+
+        /**
+         * @brief Reference to the engine
+         */
+        Engine &engine;
+
+        /**
+         * @brief Scene the cells are added to
+         */
+        Scene &scene;
+
+        /**
+         * @brief Grid and budget settings
+         */
+        WorldStreamerConfig config;
+
+        /**
+         * @brief Registered cells
+         */
+        std::vector<Cell> cells;
+
+        /**
+         * @brief Position in cells by cell key
+         */
+        std::unordered_map<uint64_t, size_t> cellIndices;
+
+        /**
+         * @brief Archives mounted for cells so far
+         */
+        std::unordered_set<std::string> mountedArchives;
+
+        /**
+         * @brief Cells ordered by work priority, reused every update
+         */
+        std::vector<Cell *> queue;
+
+        /**
+         * @brief Counts the background reads still running
+         */
+        JobCounter jobs;
+
+        /**
+         * @brief Totals as of the last update()
+         */
+        WorldStreamerStats stats;
+    };
+
+} // namespace Engine
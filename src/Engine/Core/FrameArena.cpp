@@ -0,0 +1,179 @@
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    FrameArena::FrameArena(size_t capacity, MemoryTag tag)
+        : offset(0),
+          used(0),
+          capacity(0),
+          peak(0),
+          tag(tag)
+    {
+        if (capacity > 0)
+        {
+            grow(capacity, alignof(std::max_align_t));
+        }
+    }
+
+    FrameArena::~FrameArena()
+    {
+        release();
+    }
+
+    void *FrameArena::allocate(size_t size, size_t alignment)
+    {
+        if (!blocks.empty())
+        {
+            const Block &block = blocks.back();
+            uintptr_t address = reinterpret_cast<uintptr_t>(block.data) + offset;
+            size_t padding = (alignment - address % alignment) % alignment;
+            if (offset + padding + size <= block.size)
+            {
+                void *pointer = block.data + offset + padding;
+                offset += padding + size;
+                used += padding + size;
+                return pointer;
+            }
+        }
+
+        // The new block starts aligned to max_align_t; larger alignments need padding room
+        if (!grow(size, alignment))
+        {
+            return nullptr;
+        }
+
+        const Block &block = blocks.back();
+        uintptr_t address = reinterpret_cast<uintptr_t>(block.data);
+        size_t padding = (alignment - address % alignment) % alignment;
+        offset = padding + size;
+        used += padding + size;
+        return block.data + padding;
+    }
+
+    void FrameArena::reset()
+    {
+        peak = std::max(peak, used);
+
+        // A frame that overflowed gets one block sized for all of it next time
+        if (blocks.size() > 1)
+        {
+            size_t merged = capacity;
+            release();
+            grow(merged, alignof(std::max_align_t));
+        }
+
+        offset = 0;
+        used = 0;
+    }
+
+    bool FrameArena::grow(size_t size, size_t alignment)
+    {
+        // Grow at least geometrically so a frame never needs many blocks
+        size_t blockSize = std::max(size + alignment, blocks.empty() ? size_t(0) : blocks.back().size * 2);
+
+        void *data = Memory::allocate(blockSize, alignof(std::max_align_t), tag);
+        if (!data)
+        {
+            Logger::error("Failed to allocate a frame arena block of {} bytes", blockSize);
+            return false;
+        }
+
+        blocks.push_back({static_cast<unsigned char *>(data), blockSize});
+        capacity += blockSize;
+        offset = 0;
+        return true;
+    }
+
+    void FrameArena::release()
+    {
+        for (const Block &block : blocks)
+        {
+            Memory::deallocate(block.data, tag);
+        }
+
+        blocks.clear();
+        capacity = 0;
+        offset = 0;
+    }
+
+    FrameAllocator::FrameAllocator()
+        : jobs(nullptr)
+    {
+    }
+
+    bool FrameAllocator::initialize(JobSystem *jobSystem, size_t capacityPerThread)
+    {
+        jobs = jobSystem;
+        owner = std::this_thread::get_id();
+
+        uint32_t workerCount = jobs ? jobs->getWorkerCount() : 0;
+        arenas.clear();
+        for (uint32_t i = 0; i <= workerCount; ++i)
+        {
+            arenas.push_back(std::make_unique<FrameArena>(capacityPerThread));
+            if (capacityPerThread > 0 && arenas.back()->getCapacity() == 0)
+            {
+                Logger::error("Failed to create frame arenas");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void FrameAllocator::shutdown()
+    {
+        arenas.clear();
+        jobs = nullptr;
+    }
+
+    void FrameAllocator::reset()
+    {
+        for (auto &arena : arenas)
+        {
+            arena->reset();
+        }
+    }
+
+    FrameArena *FrameAllocator::getThreadArena()
+    {
+        if (arenas.empty())
+        {
+            return nullptr;
+        }
+
+        int worker = jobs ? jobs->currentWorker() : -1;
+        if (worker >= 0 && static_cast<size_t>(worker) + 1 < arenas.size())
+        {
+            return arenas[worker + 1].get();
+        }
+
+        return std::this_thread::get_id() == owner ? arenas[0].get() : nullptr;
+    }
+
+    size_t FrameAllocator::getUsed() const
+    {
+        size_t total = 0;
+        for (const auto &arena : arenas)
+        {
+            total += arena->getUsed();
+        }
+        return total;
+    }
+
+    size_t FrameAllocator::getCapacity() const
+    {
+        size_t total = 0;
+        for (const auto &arena : arenas)
+        {
+            total += arena->getCapacity();
+        }
+        return total;
+    }
+
+} // namespace Engine
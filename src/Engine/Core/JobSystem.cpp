@@ -0,0 +1,295 @@
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Pool the calling thread works for, if any
+         */
+        thread_local const JobSystem *currentPool = nullptr;
+
+        /**
+         * @brief Worker index of the calling thread in currentPool
+         */
+        thread_local int currentIndex = -1;
+    }
+
+    JobSystem::JobSystem()
+        : queuedCount(0),
+          running(false)
+    {
+    }
+
+    JobSystem::~JobSystem()
+    {
+        shutdown();
+    }
+
+    bool JobSystem::initialize(uint32_t workerCount)
+    {
+        if (running)
+        {
+            Logger::warning("Job system already initialized");
+            return true;
+        }
+
+        running = true;
+
+        workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        // Start threads only after every deque exists so workers can steal safely
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+        }
+
+        Logger::info("Job system initialized with " + std::to_string(workerCount) + " worker threads");
+        return true;
+    }
+
+    void JobSystem::shutdown()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            running = false;
+        }
+        wakeCondition.notify_all();
+
+        for (auto &worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+
+        // Run whatever is left so that no counter is left waiting forever
+        Task task;
+        while (takeTask(task))
+        {
+            execute(task);
+        }
+
+        workers.clear();
+    }
+
+    void JobSystem::submit(Job job, JobCounter *counter)
+    {
+        if (counter)
+        {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        enqueue(Task{std::move(job), counter});
+    }
+
+    void JobSystem::submitAfter(JobCounter &dependency, Job job, JobCounter *counter)
+    {
+        if (counter)
+        {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            // Checked under the lock so a concurrent release cannot miss the job
+            std::lock_guard<std::mutex> lock(dependency.mutex);
+            if (dependency.value.load(std::memory_order_acquire) != 0)
+            {
+                dependency.continuations.push_back({std::move(job), counter});
+                return;
+            }
+        }
+
+        enqueue(Task{std::move(job), counter});
+    }
+
+    void JobSystem::enqueue(Task task)
+    {
+        // Without workers there is nobody to hand the job to
+        if (workers.empty())
+        {
+            execute(task);
+            return;
+        }
+
+        int index = currentWorker();
+        if (index >= 0)
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            workers[index]->tasks.push_back(std::move(task));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            injected.push_back(std::move(task));
+        }
+
+        queuedCount.fetch_add(1, std::memory_order_release);
+
+        {
+            // Taking the lock orders this notify after a worker's predicate check
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeCondition.notify_one();
+    }
+
+    void JobSystem::wait(const JobCounter &counter)
+    {
+        while (!counter.isDone())
+        {
+            if (!runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    uint32_t JobSystem::getDefaultWorkerCount()
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void JobSystem::workerLoop(uint32_t index)
+    {
+        currentPool = this;
+        currentIndex = static_cast<int>(index);
+        Profiler::setThreadName("Worker " + std::to_string(index));
+
+        while (running)
+        {
+            if (runOne())
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeCondition.wait(lock, [this]()
+                               { return !running || queuedCount.load(std::memory_order_acquire) > 0; });
+        }
+
+        currentPool = nullptr;
+        currentIndex = -1;
+    }
+
+    bool JobSystem::runOne()
+    {
+        Task task;
+        if (!takeTask(task))
+        {
+            return false;
+        }
+
+        execute(task);
+        return true;
+    }
+
+    bool JobSystem::takeTask(Task &task)
+    {
+        int self = currentWorker();
+
+        // Newest job of our own deque first, it is most likely still in cache
+        if (self >= 0)
+        {
+            Worker &worker = *workers[self];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.empty())
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                queuedCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(injectMutex);
+            if (!injected.empty())
+            {
+                task = std::move(injected.front());
+                injected.pop_front();
+                queuedCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Steal the oldest job of another worker
+        size_t count = workers.size();
+        size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t victim = (start + i) % count;
+            if (static_cast<int>(victim) == self)
+            {
+                continue;
+            }
+
+            Worker &worker = *workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.empty())
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+                queuedCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::execute(Task &task)
+    {
+        {
+            ENGINE_PROFILE_SCOPE("Job");
+            task.job();
+        }
+
+        if (task.counter)
+        {
+            release(*task.counter);
+        }
+    }
+
+    void JobSystem::release(JobCounter &counter)
+    {
+        // Waiters also wait for releasing to drop, which is the last access to
+        // the counter here
+        counter.releasing.fetch_add(1, std::memory_order_seq_cst);
+
+        std::vector<JobCounter::Continuation> ready;
+        {
+            std::lock_guard<std::mutex> lock(counter.mutex);
+            if (counter.value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                ready.swap(counter.continuations);
+            }
+        }
+
+        counter.releasing.fetch_sub(1, std::memory_order_release);
+
+        for (auto &continuation : ready)
+        {
+            enqueue(Task{std::move(continuation.job), continuation.counter});
+        }
+    }
+
+    int JobSystem::currentWorker() const
+    {
+        return currentPool == this ? currentIndex : -1;
+    }
+
+} // namespace Engine
@@ -0,0 +1,165 @@
+#include "Engine/Core/LogFormat.hpp"
+
+#include <charconv>
+#include <cstdio>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Reads a fixed size value from the encoded arguments
+         * @param arguments Encoded arguments
+         * @param offset Read position, advanced past the value
+         * @param value Receives the value
+         * @return True if the value was complete
+         */
+        template <typename T>
+        bool readScalar(const std::string &arguments, size_t &offset, T &value)
+        {
+            if (arguments.size() - offset < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, arguments.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        /**
+         * @brief Decodes the next argument and appends it as text
+         * @param out Message to append to
+         * @param arguments Encoded arguments
+         * @param offset Read position, advanced past the argument
+         * @return True if the argument was valid
+         */
+        bool appendArgument(std::string &out, const std::string &arguments, size_t &offset)
+        {
+            uint8_t type;
+            if (!readScalar(arguments, offset, type))
+            {
+                return false;
+            }
+
+            char buffer[32];
+            switch (static_cast<LogArgumentType>(type))
+            {
+            case LogArgumentType::Bool:
+            {
+                uint8_t value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                out += value ? "true" : "false";
+                return true;
+            }
+            case LogArgumentType::Char:
+            {
+                char value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                out += value;
+                return true;
+            }
+            case LogArgumentType::Int:
+            {
+                int64_t value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                return true;
+            }
+            case LogArgumentType::UInt:
+            {
+                uint64_t value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+                return true;
+            }
+            case LogArgumentType::Float:
+            {
+                double value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+                out.append(buffer, static_cast<size_t>(length));
+                return true;
+            }
+            case LogArgumentType::String:
+            {
+                uint32_t length;
+                if (!readScalar(arguments, offset, length) || arguments.size() - offset < length)
+                {
+                    return false;
+                }
+                out.append(arguments, offset, length);
+                offset += length;
+                return true;
+            }
+            case LogArgumentType::Pointer:
+            {
+                uint64_t value;
+                if (!readScalar(arguments, offset, value))
+                {
+                    return false;
+                }
+                int length = std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+                out.append(buffer, static_cast<size_t>(length));
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool LogFormat::format(std::string &out, const char *format, const std::string &arguments)
+    {
+        size_t offset = 0;
+        bool valid = true;
+        for (const char *p = format; *p; ++p)
+        {
+            if (p[0] == '{' && p[1] == '{')
+            {
+                out += '{';
+                ++p;
+            }
+            else if (p[0] == '}' && p[1] == '}')
+            {
+                out += '}';
+                ++p;
+            }
+            else if (p[0] == '{' && p[1] == '}')
+            {
+                // Keep the placeholder once the arguments run out or stop making sense
+                bool appended = false;
+                if (valid && offset < arguments.size())
+                {
+                    appended = valid = appendArgument(out, arguments, offset);
+                }
+                if (!appended)
+                {
+                    out += "{}";
+                }
+                ++p;
+            }
+            else
+            {
+                out += *p;
+            }
+        }
+        return valid;
+    }
+
+} // namespace Engine
@@ -1,17 +1,44 @@
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Memory.hpp"
 #include <iostream>
-#include <iomanip>
 #include <ctime>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 
 namespace Engine
 {
 
     // Initialize static members
-    LogLevel Logger::minLevel = LogLevel::Info;
+    std::atomic<LogLevel> Logger::minLevel(LogLevel::Info);
     std::vector<std::unique_ptr<LogSink>> Logger::sinks;
     std::mutex Logger::mutex;
-    bool Logger::initialized = false;
+    std::mutex Logger::stateMutex;
+    std::atomic<bool> Logger::initialized(false);
+    std::atomic<bool> Logger::asyncEnabled(false);
+    LogOverflowPolicy Logger::overflowPolicy = LogOverflowPolicy::Block;
+    std::unique_ptr<MPSCQueue<Logger::Record>> Logger::queue;
+    std::thread Logger::writerThread;
+    std::atomic<bool> Logger::writerRunning(false);
+    std::atomic<bool> Logger::writerSleeping(false);
+    std::mutex Logger::wakeMutex;
+    std::condition_variable Logger::wakeCondition;
+    std::condition_variable Logger::flushCondition;
+    uint64_t Logger::writtenCount = 0;
+    std::atomic<uint64_t> Logger::droppedCount(0);
+
+    namespace
+    {
+        /**
+         * @brief Stops the writer thread at exit if the logger was never shut down
+         *
+         * Defined after the static members, so it is destroyed before them.
+         */
+        struct ShutdownAtExit
+        {
+            ~ShutdownAtExit() { Logger::shutdown(); }
+        } shutdownAtExit;
+    }
 
     // Console sink implementation
     ConsoleSink::ConsoleSink() {}
@@ -50,7 +77,12 @@ namespace Engine
 
         // Output format: [TIMESTAMP] [LEVEL] MESSAGE
         std::cout << color << "[" << timestamp << "] [" << Logger::levelToString(level) << "] "
-                  << message << resetColor << std::endl;
+                  << message << resetColor << '\n';
+    }
+
+    void ConsoleSink::flush()
+    {
+        std::cout.flush();
     }
 
     // File sink implementation
@@ -78,142 +110,453 @@ namespace Engine
         {
             // Output format: [TIMESTAMP] [LEVEL] MESSAGE
             file << "[" << timestamp << "] [" << Logger::levelToString(level) << "] "
-                 << message << std::endl;
+                 << message << '\n';
         }
     }
 
-    // Logger implementation
-    void Logger::init(LogLevel level)
+    void FileSink::flush()
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        if (file.is_open())
+        {
+            file.flush();
+        }
+    }
 
-        if (initialized)
+    // Binary file sink implementation
+    namespace
+    {
+        /**
+         * @brief Writes a little-endian value to a binary log
+         * @param file Log file
+         * @param value Value to write
+         */
+        template <typename T>
+        void writeValue(std::ofstream &file, T value)
         {
+            file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+    }
+
+    BinaryFileSink::BinaryFileSink(const std::string &filePath)
+    {
+        file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open log file: " << filePath << std::endl;
             return;
         }
 
-        minLevel = level;
+        writeValue(file, LogFileMagic);
+        writeValue(file, LogFileVersion);
+    }
 
-        // Add console sink by default
-        sinks.push_back(std::make_unique<ConsoleSink>());
+    void BinaryFileSink::write(LogLevel level, const std::string &message, const std::string &)
+    {
+        static const char PlainFormat[] = "{}";
+        std::string arguments;
+        LogFormat::encode(arguments, message);
+        writeStructured(level, std::chrono::system_clock::now(), PlainFormat, arguments);
+    }
 
-        initialized = true;
+    void BinaryFileSink::writeStructured(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                                         const std::string &arguments)
+    {
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        // Format strings are written once and referenced by id afterwards
+        auto it = formatIds.find(format);
+        if (it == formatIds.end())
+        {
+            uint32_t id = static_cast<uint32_t>(formatIds.size());
+            it = formatIds.emplace(format, id).first;
+
+            uint32_t length = static_cast<uint32_t>(std::strlen(format));
+            writeValue(file, static_cast<uint8_t>(LogRecordKind::Format));
+            writeValue(file, id);
+            writeValue(file, length);
+            file.write(format, length);
+        }
+
+        int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+        writeValue(file, static_cast<uint8_t>(LogRecordKind::Message));
+        writeValue(file, static_cast<uint8_t>(level));
+        writeValue(file, microseconds);
+        writeValue(file, it->second);
+        writeValue(file, static_cast<uint32_t>(arguments.size()));
+        file.write(arguments.data(), static_cast<std::streamsize>(arguments.size()));
+    }
+
+    void BinaryFileSink::flush()
+    {
+        if (file.is_open())
+        {
+            file.flush();
+        }
+    }
+
+    // Logger implementation
+    void Logger::init(LogLevel level)
+    {
+        LoggerConfig config;
+        config.level = level;
+        init(config);
     }
 
     void Logger::init(const LoggerConfig &config)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> stateLock(stateMutex);
 
-        if (initialized)
+        if (initialized.load(std::memory_order_relaxed))
         {
             return;
         }
 
-        minLevel = config.level;
-
-        // Add sinks based on configuration
-        if (config.logToConsole)
         {
-            sinks.push_back(std::make_unique<ConsoleSink>());
+            std::lock_guard<std::mutex> lock(mutex);
+            minLevel.store(config.level, std::memory_order_relaxed);
+
+            // Add sinks based on configuration
+            if (config.logToConsole)
+            {
+                sinks.push_back(std::make_unique<ConsoleSink>());
+            }
+
+            if (config.logToFile)
+            {
+                sinks.push_back(std::make_unique<FileSink>(config.logFilePath));
+            }
+
+            if (config.logToBinaryFile)
+            {
+                sinks.push_back(std::make_unique<BinaryFileSink>(config.binaryLogFilePath));
+            }
         }
 
-        if (config.logToFile)
+        if (config.async)
         {
-            sinks.push_back(std::make_unique<FileSink>(config.logFilePath));
+            // The queue of an earlier init is reused unless it is too small
+            if (!queue || queue->getCapacity() < config.queueCapacity)
+            {
+                queue = std::make_unique<MPSCQueue<Record>>(config.queueCapacity);
+                writtenCount = 0;
+            }
+
+            overflowPolicy = config.overflowPolicy;
+            writerRunning.store(true, std::memory_order_release);
+            writerThread = std::thread(&Logger::writerMain);
+            asyncEnabled.store(true, std::memory_order_release);
         }
 
-        initialized = true;
+        initialized.store(true, std::memory_order_release);
     }
 
     void Logger::shutdown()
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> stateLock(stateMutex);
 
-        if (!initialized)
+        if (!initialized.load(std::memory_order_relaxed))
         {
             return;
         }
 
-        // Clear all sinks
+        if (writerThread.joinable())
+        {
+            // Messages logged from here on are written directly, the writer drains the queue before it exits
+            asyncEnabled.store(false, std::memory_order_release);
+            writerRunning.store(false, std::memory_order_release);
+            wakeWriter();
+            writerThread.join();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Write records whose push finished after the writer thread stopped
+        if (queue)
+        {
+            uint64_t count = 0;
+            Record record;
+            while (queue->tryPop(record))
+            {
+                writeToSinks(record.level, record.time, record.format, record.message);
+                ++count;
+            }
+
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                writtenCount += count;
+            }
+            flushCondition.notify_all();
+        }
+        reportDropped();
+
+        // Flush and clear all sinks
+        flushSinks();
         sinks.clear();
 
-        initialized = false;
+        initialized.store(false, std::memory_order_release);
+    }
+
+    void Logger::flush()
+    {
+        if (!asyncEnabled.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushSinks();
+            return;
+        }
+
+        // The writer flushes the sinks after every batch, so waiting for the records pushed so far is enough
+        uint64_t target = queue->getPushCount();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+        flushCondition.wait(lock, [target]
+                            { return writtenCount >= target || !writerRunning.load(std::memory_order_acquire); });
     }
 
     void Logger::setLevel(LogLevel level)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        minLevel = level;
+        minLevel.store(level, std::memory_order_relaxed);
     }
 
     LogLevel Logger::getLevel()
     {
-        return minLevel;
+        return minLevel.load(std::memory_order_relaxed);
     }
 
     void Logger::addSink(std::unique_ptr<LogSink> sink)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-
-        if (!initialized)
+        if (!initialized.load(std::memory_order_acquire))
         {
             init();
         }
 
+        std::lock_guard<std::mutex> lock(mutex);
         sinks.push_back(std::move(sink));
     }
 
-    void Logger::trace(const std::string &message)
+    void Logger::log(LogLevel level, const std::string &message)
     {
-        log(LogLevel::Trace, message);
+        if (!isCompiledIn(level) || level < minLevel.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        dispatch(level, nullptr, message);
     }
 
-    void Logger::debug(const std::string &message)
+    std::string &Logger::getArgumentBuffer()
     {
-        log(LogLevel::Debug, message);
+        thread_local std::string buffer;
+        return buffer;
     }
 
-    void Logger::info(const std::string &message)
+    void Logger::logStructured(LogLevel level, const char *format, const std::string &arguments)
     {
-        log(LogLevel::Info, message);
+        dispatch(level, format, arguments);
     }
 
-    void Logger::warning(const std::string &message)
+    void Logger::dispatch(LogLevel level, const char *format, const std::string &message)
     {
-        log(LogLevel::Warning, message);
+        MemoryScope memoryScope(MemoryTag::Logger);
+
+        if (!initialized.load(std::memory_order_acquire))
+        {
+            init();
+
+            // The level was checked against the default before the logger was initialized
+            if (level < minLevel.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+
+        auto time = std::chrono::system_clock::now();
+        if (asyncEnabled.load(std::memory_order_acquire))
+        {
+            enqueue(level, time, format, message);
+            if (level == LogLevel::Fatal)
+            {
+                flush();
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        writeToSinks(level, time, format, message);
+
+        // Lines are not flushed one by one, but errors must survive a crash
+        if (level >= LogLevel::Error)
+        {
+            flushSinks();
+        }
     }
 
-    void Logger::error(const std::string &message)
+    void Logger::enqueue(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                         const std::string &message)
     {
-        log(LogLevel::Error, message);
+        // Assign into the cell's record, so its string keeps the capacity of earlier messages
+        auto fill = [&](Record &record)
+        {
+            record.level = level;
+            record.time = time;
+            record.format = format;
+            record.message.assign(message);
+        };
+
+        if (!queue->tryPushWith(fill))
+        {
+            if (overflowPolicy == LogOverflowPolicy::Drop)
+            {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                // Let the writer thread make room, unless it is stopping and never will
+                do
+                {
+                    if (!writerRunning.load(std::memory_order_acquire))
+                    {
+                        droppedCount.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (writerSleeping.load(std::memory_order_relaxed))
+                    {
+                        wakeWriter();
+                    }
+                    std::this_thread::yield();
+                } while (!queue->tryPushWith(fill));
+            }
+        }
+
+        // Pairs with the fence in writerMain: either the writer sees the record or this thread sees it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerSleeping.load(std::memory_order_relaxed))
+        {
+            wakeWriter();
+        }
     }
 
-    void Logger::fatal(const std::string &message)
+    void Logger::writeToSinks(LogLevel level, std::chrono::system_clock::time_point time, const char *format,
+                              const std::string &message)
     {
-        log(LogLevel::Fatal, message);
+        // Only called with the mutex held, so the buffers can be shared
+        static const char PlainFormat[] = "{}";
+        static std::string text;
+        static std::string plainArguments;
+
+        std::string timestamp;
+        bool formatted = false;
+        for (const auto &sink : sinks)
+        {
+            if (sink->isStructured())
+            {
+                if (format)
+                {
+                    sink->writeStructured(level, time, format, message);
+                }
+                else
+                {
+                    plainArguments.clear();
+                    LogFormat::encode(plainArguments, message);
+                    sink->writeStructured(level, time, PlainFormat, plainArguments);
+                }
+                continue;
+            }
+
+            // Format once for all text sinks, and not at all without one
+            if (!formatted)
+            {
+                timestamp = formatTimestamp(time);
+                if (format)
+                {
+                    text.clear();
+                    LogFormat::format(text, format, message);
+                }
+                formatted = true;
+            }
+            sink->write(level, format ? text : message, timestamp);
+        }
     }
 
-    void Logger::log(LogLevel level, const std::string &message)
+    void Logger::flushSinks()
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &sink : sinks)
+        {
+            sink->flush();
+        }
+    }
 
-        if (!initialized)
+    void Logger::reportDropped()
+    {
+        uint64_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
         {
-            init();
+            writeToSinks(LogLevel::Warning, std::chrono::system_clock::now(), nullptr,
+                         "Log queue full, dropped " + std::to_string(dropped) + " messages");
         }
+    }
 
-        if (level < minLevel)
+    void Logger::wakeWriter()
+    {
         {
-            return;
+            std::lock_guard<std::mutex> lock(wakeMutex);
         }
+        wakeCondition.notify_one();
+    }
+
+    void Logger::writerMain()
+    {
+        MemoryScope memoryScope(MemoryTag::Logger);
 
-        // Get timestamp
-        std::string timestamp = getTimestamp();
+        // Popping swaps these records with the queued ones, so message buffers circulate instead of being reallocated
+        std::vector<Record> batch(BatchSize);
 
-        // Write to all sinks
-        for (const auto &sink : sinks)
+        for (;;)
         {
-            sink->write(level, message, timestamp);
+            size_t count = 0;
+            while (count < BatchSize && queue->tryPop(batch[count]))
+            {
+                ++count;
+            }
+
+            if (count > 0)
+            {
+                // One lock and one flush per batch instead of per message
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        writeToSinks(batch[i].level, batch[i].time, batch[i].format, batch[i].message);
+                    }
+                    reportDropped();
+                    flushSinks();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                    writtenCount += count;
+                }
+                flushCondition.notify_all();
+                continue;
+            }
+
+            if (!writerRunning.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            // Sleep until a producer wakes us; the timeout covers a push that was claimed but not yet published
+            writerSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wakeCondition.wait_for(lock, std::chrono::milliseconds(10), []
+                                       { return !queue->isEmpty() || !writerRunning.load(std::memory_order_acquire); });
+            }
+            writerSleeping.store(false, std::memory_order_relaxed);
         }
     }
 
@@ -238,21 +581,27 @@ namespace Engine
         }
     }
 
-    std::string Logger::getTimestamp()
+    std::string Logger::formatTimestamp(std::chrono::system_clock::time_point time)
     {
-        // Get current time
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
+        // Messages come in bursts, so the date and time of the last second are reused
+        static std::time_t cachedSeconds = -1;
+        static char cachedPrefix[32] = {};
+
+        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      now.time_since_epoch()) %
+                      time.time_since_epoch()) %
                   1000;
 
         // Format: YYYY-MM-DD HH:MM:SS.mmm
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-        ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+        if (seconds != cachedSeconds)
+        {
+            std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+            cachedSeconds = seconds;
+        }
 
-        return ss.str();
+        char buffer[40];
+        std::snprintf(buffer, sizeof(buffer), "%s.%03d", cachedPrefix, static_cast<int>(ms.count()));
+        return buffer;
     }
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "Engine/Core/Memory.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Tag of the innermost MemoryScope of the calling thread
+         */
+        thread_local MemoryTag currentTag = MemoryTag::General;
+
+        /**
+         * @brief Display names, in MemoryTag order
+         */
+        const char *const TagNames[] = {"General", "Frame", "ECS", "Scene", "Renderer",
+                                        "Resources", "Physics", "Audio", "Input", "Logger"};
+
+        static_assert(sizeof(TagNames) / sizeof(TagNames[0]) == static_cast<size_t>(MemoryTag::Count),
+                      "Every memory tag needs a name");
+    }
+
+    Memory::Counters Memory::counters[static_cast<size_t>(MemoryTag::Count)];
+    MemoryTagStats Memory::frameStart[static_cast<size_t>(MemoryTag::Count)];
+
+    void *Memory::allocate(size_t size, size_t alignment, MemoryTag tag)
+    {
+        // Over-allocate and keep the start of the block just below the aligned
+        // pointer, so any alignment works without platform specific calls
+        if (alignment < alignof(void *))
+        {
+            alignment = alignof(void *);
+        }
+
+        void *block = std::malloc(size + alignment + sizeof(void *));
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(block) + sizeof(void *);
+        address = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        void *pointer = reinterpret_cast<void *>(address);
+        std::memcpy(static_cast<unsigned char *>(pointer) - sizeof(void *), &block, sizeof(void *));
+
+        recordAllocation(tag, size);
+        return pointer;
+    }
+
+    void Memory::deallocate(void *pointer, MemoryTag tag)
+    {
+        if (!pointer)
+        {
+            return;
+        }
+
+        void *block;
+        std::memcpy(&block, static_cast<unsigned char *>(pointer) - sizeof(void *), sizeof(void *));
+        std::free(block);
+
+        recordFree(tag);
+    }
+
+    void Memory::recordAllocation(MemoryTag tag, size_t size)
+    {
+        Counters &tagCounters = counters[static_cast<size_t>(tag)];
+        tagCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+        tagCounters.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void Memory::recordFree(MemoryTag tag)
+    {
+        counters[static_cast<size_t>(tag)].frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MemoryTagStats Memory::getStats(MemoryTag tag)
+    {
+        const Counters &tagCounters = counters[static_cast<size_t>(tag)];
+
+        MemoryTagStats stats;
+        stats.allocations = tagCounters.allocations.load(std::memory_order_relaxed);
+        stats.frees = tagCounters.frees.load(std::memory_order_relaxed);
+        stats.bytes = tagCounters.bytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    MemoryTagStats Memory::getFrameStats(MemoryTag tag)
+    {
+        MemoryTagStats stats = getStats(tag);
+        const MemoryTagStats &start = frameStart[static_cast<size_t>(tag)];
+        stats.allocations -= start.allocations;
+        stats.frees -= start.frees;
+        stats.bytes -= start.bytes;
+        return stats;
+    }
+
+    uint64_t Memory::getFrameAllocationCount()
+    {
+        uint64_t count = 0;
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+        {
+            count += getFrameStats(static_cast<MemoryTag>(i)).allocations;
+        }
+        return count;
+    }
+
+    void Memory::beginFrame()
+    {
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+        {
+            frameStart[i] = getStats(static_cast<MemoryTag>(i));
+        }
+    }
+
+    MemoryTag Memory::getCurrentTag()
+    {
+        return currentTag;
+    }
+
+    MemoryTag Memory::setCurrentTag(MemoryTag tag)
+    {
+        MemoryTag previous = currentTag;
+        currentTag = tag;
+        return previous;
+    }
+
+    bool Memory::isTrackingHeap()
+    {
+#ifdef ENGINE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const char *Memory::getTagName(MemoryTag tag)
+    {
+        size_t index = static_cast<size_t>(tag);
+        return index < static_cast<size_t>(MemoryTag::Count) ? TagNames[index] : "Unknown";
+    }
+
+} // namespace Engine
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+// Replacements of the global allocation functions that count every call against
+// the current tag. The over-aligned forms are left to the standard library and
+// are not counted.
+
+namespace
+{
+    void *countedAllocate(std::size_t size)
+    {
+        if (size == 0)
+        {
+            size = 1;
+        }
+
+        for (;;)
+        {
+            if (void *pointer = std::malloc(size))
+            {
+                Engine::Memory::recordAllocation(Engine::Memory::getCurrentTag(), size);
+                return pointer;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void countedFree(void *pointer) noexcept
+    {
+        if (pointer)
+        {
+            Engine::Memory::recordFree(Engine::Memory::getCurrentTag());
+            std::free(pointer);
+        }
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return countedAllocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return countedAllocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *pointer) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+    countedFree(pointer);
+}
+
+#endif
@@ -0,0 +1,340 @@
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Recorded zone
+         */
+        struct ProfileEvent
+        {
+            /**
+             * @brief Zone name
+             */
+            const char *name;
+
+            /**
+             * @brief Start and end time in nanoseconds
+             */
+            uint64_t start;
+            uint64_t end;
+
+            /**
+             * @brief Nesting depth, 0 for zones without a parent
+             */
+            uint32_t depth;
+        };
+
+        /**
+         * @brief Writes a string as a JSON string literal
+         * @param file Output file
+         * @param text String to write
+         */
+        void writeJsonString(std::FILE *file, const char *text)
+        {
+            std::fputc('"', file);
+            for (const char *p = text; *p; ++p)
+            {
+                unsigned char c = static_cast<unsigned char>(*p);
+                if (c == '"' || c == '\\')
+                {
+                    std::fputc('\\', file);
+                    std::fputc(c, file);
+                }
+                else if (c < 0x20)
+                {
+                    std::fprintf(file, "\\u%04x", c);
+                }
+                else
+                {
+                    std::fputc(c, file);
+                }
+            }
+            std::fputc('"', file);
+        }
+    }
+
+    struct Profiler::ThreadBuffer
+    {
+        /**
+         * @brief Events per chunk
+         */
+        static constexpr size_t ChunkSize = 4096;
+
+        /**
+         * @brief Maximum number of chunks, later events are dropped
+         */
+        static constexpr size_t MaxChunks = 256;
+
+        /**
+         * @brief Event chunks, allocated by the owning thread as it needs them and kept between captures
+         */
+        std::atomic<ProfileEvent *> chunks[MaxChunks] = {};
+
+        /**
+         * @brief Number of published events
+         */
+        std::atomic<size_t> count{0};
+
+        /**
+         * @brief Capture the events belong to, published after the buffer was reset for it
+         */
+        std::atomic<uint32_t> generation{0};
+
+        /**
+         * @brief Depth of the next zone, only touched by the owner
+         */
+        uint32_t depth = 0;
+
+        /**
+         * @brief Number of events dropped because the buffer was full
+         */
+        std::atomic<size_t> dropped{0};
+
+        /**
+         * @brief Thread id in exported traces
+         */
+        uint32_t threadId = 0;
+
+        /**
+         * @brief Thread name, guarded by the profiler mutex
+         */
+        std::string name;
+
+        /**
+         * @brief Destructor
+         */
+        ~ThreadBuffer()
+        {
+            for (auto &chunk : chunks)
+            {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Initialize static members
+    std::atomic<bool> Profiler::recording(false);
+    std::atomic<uint32_t> Profiler::generation(0);
+    std::atomic<uint64_t> Profiler::startTime(0);
+    std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::buffers;
+    std::unordered_set<std::string> Profiler::names;
+    std::unordered_map<std::string, Profiler::ThreadBuffer *> Profiler::tracks;
+    std::mutex Profiler::mutex;
+
+    void Profiler::start()
+    {
+        // Buffers notice the new generation and reset themselves on their next zone
+        startTime.store(now(), std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_acq_rel);
+        recording.store(true, std::memory_order_release);
+    }
+
+    void Profiler::stop()
+    {
+        recording.store(false, std::memory_order_release);
+    }
+
+    void Profiler::setThreadName(const std::string &name)
+    {
+        ThreadBuffer &buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer.name = name;
+    }
+
+    const char *Profiler::intern(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return names.insert(name).first->c_str();
+    }
+
+    Profiler::ThreadBuffer &Profiler::getThreadBuffer()
+    {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers.back().get();
+            buffer->threadId = static_cast<uint32_t>(buffers.size());
+            buffer->name = "Thread " + std::to_string(buffer->threadId);
+        }
+        return *buffer;
+    }
+
+    uint64_t Profiler::now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    size_t Profiler::getEventCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t current = generation.load(std::memory_order_acquire);
+        size_t total = 0;
+        for (const auto &buffer : buffers)
+        {
+            if (buffer->generation.load(std::memory_order_acquire) == current)
+            {
+                total += buffer->count.load(std::memory_order_acquire);
+            }
+        }
+        return total;
+    }
+
+    bool Profiler::writeChromeTrace(const std::string &filepath)
+    {
+        std::FILE *file = std::fopen(filepath.c_str(), "wb");
+        if (!file)
+        {
+            Logger::error("Failed to open profile output: {}", filepath);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t current = generation.load(std::memory_order_acquire);
+        uint64_t origin = startTime.load(std::memory_order_relaxed);
+
+        std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+        bool first = true;
+        size_t eventCount = 0;
+        size_t droppedCount = 0;
+        for (const auto &buffer : buffers)
+        {
+            // Buffers that recorded nothing in this capture still hold an older one
+            if (buffer->generation.load(std::memory_order_acquire) != current)
+            {
+                continue;
+            }
+
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         first ? "" : ",\n", buffer->threadId);
+            writeJsonString(file, buffer->name.c_str());
+            std::fputs("}}", file);
+            first = false;
+
+            // Events below the published count are complete, even if the thread is still recording
+            size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const ProfileEvent &event =
+                    buffer->chunks[i / ThreadBuffer::ChunkSize].load(std::memory_order_acquire)[i % ThreadBuffer::ChunkSize];
+                std::fputs(",\n{\"name\":", file);
+                writeJsonString(file, event.name);
+                std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}",
+                             buffer->threadId, static_cast<double>(event.start - origin) / 1000.0,
+                             static_cast<double>(event.end - event.start) / 1000.0, event.depth);
+            }
+            eventCount += count;
+            droppedCount += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        std::fputs("\n]}\n", file);
+
+        bool written = std::ferror(file) == 0;
+        written = std::fclose(file) == 0 && written;
+        if (!written)
+        {
+            Logger::error("Failed to write profile output: {}", filepath);
+            return false;
+        }
+
+        Logger::info("Wrote {} profiler events to {}", eventCount, filepath);
+        if (droppedCount > 0)
+        {
+            Logger::warning("Profiler buffers were full, {} events were dropped", droppedCount);
+        }
+        return true;
+    }
+
+    void Profiler::recordZone(const char *track, const char *name, uint64_t start, uint64_t end)
+    {
+        if (!isRecording())
+        {
+            return;
+        }
+
+        ThreadBuffer *buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ThreadBuffer *&slot = tracks[track];
+            if (!slot)
+            {
+                buffers.push_back(std::make_unique<ThreadBuffer>());
+                slot = buffers.back().get();
+                slot->threadId = static_cast<uint32_t>(buffers.size());
+                slot->name = track;
+            }
+            buffer = slot;
+        }
+
+        prepareBuffer(*buffer, generation.load(std::memory_order_acquire));
+        append(*buffer, name, start, end, 0);
+    }
+
+    void Profiler::prepareBuffer(ThreadBuffer &buffer, uint32_t current)
+    {
+        if (buffer.generation.load(std::memory_order_relaxed) != current)
+        {
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.dropped.store(0, std::memory_order_relaxed);
+            buffer.depth = 0;
+            buffer.generation.store(current, std::memory_order_release);
+        }
+    }
+
+    void Profiler::append(ThreadBuffer &buffer, const char *name, uint64_t start, uint64_t end, uint32_t depth)
+    {
+        size_t index = buffer.count.load(std::memory_order_relaxed);
+        size_t chunkIndex = index / ThreadBuffer::ChunkSize;
+        if (chunkIndex >= ThreadBuffer::MaxChunks)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ProfileEvent *chunk = buffer.chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (!chunk)
+        {
+            chunk = new ProfileEvent[ThreadBuffer::ChunkSize];
+            buffer.chunks[chunkIndex].store(chunk, std::memory_order_release);
+        }
+
+        chunk[index % ThreadBuffer::ChunkSize] = ProfileEvent{name, start, end, depth};
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+    void ProfileScope::begin()
+    {
+        buffer = &Profiler::getThreadBuffer();
+
+        // The first zone of a thread in a new capture resets its buffer
+        generation = Profiler::generation.load(std::memory_order_acquire);
+        Profiler::prepareBuffer(*buffer, generation);
+
+        depth = buffer->depth++;
+        startTime = Profiler::now();
+    }
+
+    void ProfileScope::end()
+    {
+        uint64_t endTime = Profiler::now();
+        buffer->depth = depth;
+
+        // Zones that straddle the start of a capture belong to neither
+        if (buffer->generation.load(std::memory_order_relaxed) != generation)
+        {
+            return;
+        }
+
+        Profiler::append(*buffer, name, startTime, endTime, depth);
+    }
+
+} // namespace Engine
@@ -1,6 +1,10 @@
 #include "Engine/Core/Time.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/Logger.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Engine
 {
 
@@ -11,7 +15,14 @@ namespace Engine
           fps(0.0f),
           fpsAccumulator(0.0f),
           fpsFrameAccumulator(0),
-          nextTimerId(1)
+          fixedTimestep(1.0f / 60.0f),
+          fixedAccumulator(0.0f),
+          maxFixedSteps(10),
+          fixedStepCount(0),
+          timerTime(0.0),
+          timerSequence(0),
+          activeTimerCount(0),
+          jobs(nullptr)
     {
         reset();
     }
@@ -19,7 +30,8 @@ namespace Engine
     Time::~Time()
     {
         // Clear timers
-        timers.clear();
+        timerHeap.clear();
+        timerSlots.clear();
     }
 
     void Time::reset()
@@ -32,6 +44,8 @@ namespace Engine
         fps = 0.0f;
         fpsAccumulator = 0.0f;
         fpsFrameAccumulator = 0;
+        fixedAccumulator = 0.0f;
+        fixedStepCount = 0;
     }
 
     void Time::update()
@@ -69,6 +83,22 @@ namespace Engine
             fpsFrameAccumulator = 0;
         }
 
+        // Consume the frame time in whole fixed steps and keep the remainder
+        // for the next frame
+        fixedAccumulator += deltaTime;
+        fixedStepCount = static_cast<int>(fixedAccumulator / fixedTimestep);
+        if (fixedStepCount > maxFixedSteps)
+        {
+            // Drop the backlog rather than spiralling into ever longer frames
+            fixedStepCount = maxFixedSteps;
+            fixedAccumulator = 0.0f;
+        }
+        else
+        {
+            fixedAccumulator -= static_cast<float>(fixedStepCount) * fixedTimestep;
+            fixedAccumulator = fixedAccumulator > 0.0f ? fixedAccumulator : 0.0f;
+        }
+
         // Update timers
         updateTimers(deltaTime);
 
@@ -76,77 +106,199 @@ namespace Engine
         lastUpdateTime = currentTime;
     }
 
-    uint32_t Time::createTimer(std::function<void()> callback, float delay, bool repeat)
+    void Time::setFixedTimestep(float step)
     {
-        Timer timer;
-        timer.id = nextTimerId++;
-        timer.delay = delay;
-        timer.timeLeft = delay;
-        timer.repeat = repeat;
-        timer.callback = callback;
-
-        timers.push_back(timer);
-        return timer.id;
+        if (step <= 0.0f)
+        {
+            Logger::warning("Ignoring non-positive fixed timestep");
+            return;
+        }
+
+        fixedTimestep = step;
     }
 
-    bool Time::cancelTimer(uint32_t id)
+    TimerId Time::createTimer(TimerCallback callback, float delay, bool repeat, bool parallel)
     {
-        for (auto it = timers.begin(); it != timers.end(); ++it)
+        if (!callback)
         {
-            if (it->id == id)
-            {
-                timers.erase(it);
-                return true;
-            }
+            Logger::warning("Ignoring timer without a callback");
+            return 0;
         }
 
-        return false;
+        uint32_t index;
+        if (!freeTimerSlots.empty())
+        {
+            index = freeTimerSlots.back();
+            freeTimerSlots.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(timerSlots.size());
+            timerSlots.emplace_back();
+        }
+
+        TimerSlot &slot = timerSlots[index];
+        slot.callback = std::move(callback);
+        slot.interval = delay;
+        slot.active = true;
+        slot.repeat = repeat;
+        slot.parallel = parallel;
+        ++activeTimerCount;
+
+        scheduleTimer(index, timerTime + delay);
+        return (static_cast<TimerId>(slot.generation) << 32) | index;
+    }
+
+    bool Time::cancelTimer(TimerId id)
+    {
+        uint32_t index = static_cast<uint32_t>(id);
+        if (!isCurrent(index, static_cast<uint32_t>(id >> 32)))
+        {
+            return false;
+        }
+
+        // The heap entry goes stale and is skipped when it reaches the top
+        releaseTimer(index);
+
+        // Drop stale entries once they make up most of the heap
+        if (timerHeap.size() > 64 && timerHeap.size() > activeTimerCount * 2)
+        {
+            timerHeap.erase(std::remove_if(timerHeap.begin(), timerHeap.end(),
+                                           [this](const TimerEntry &entry)
+                                           { return !isCurrent(entry.slot, entry.generation); }),
+                            timerHeap.end());
+            std::make_heap(timerHeap.begin(), timerHeap.end(), expiresLater);
+        }
+
+        return true;
+    }
+
+    bool Time::isTimerActive(TimerId id) const
+    {
+        return isCurrent(static_cast<uint32_t>(id), static_cast<uint32_t>(id >> 32));
     }
 
     void Time::updateTimers(float deltaTime)
     {
-        // Iterate through all timers
-        for (auto it = timers.begin(); it != timers.end();)
+        timerTime += deltaTime;
+
+        // Take every expired timer off the heap first, so that timers created
+        // or rescheduled by the callbacks wait for the next update
+        bool useJobs = jobs && jobs->getWorkerCount() > 0;
+        while (!timerHeap.empty() && timerHeap.front().expiry <= timerTime)
+        {
+            std::pop_heap(timerHeap.begin(), timerHeap.end(), expiresLater);
+            TimerEntry entry = timerHeap.back();
+            timerHeap.pop_back();
+
+            if (!isCurrent(entry.slot, entry.generation))
+            {
+                continue;
+            }
+
+            TimerSlot &slot = timerSlots[entry.slot];
+            std::vector<DueTimer> &due = slot.parallel && useJobs ? dueParallelTimers : dueTimers;
+            due.push_back({std::move(slot.callback), entry.expiry, entry.slot, entry.generation});
+        }
+
+        // Parallel callbacks never touch the timers, so they all run before
+        // the ones that may cancel or create timers
+        if (!dueParallelTimers.empty())
         {
-            // Reduce time left
-            it->timeLeft -= deltaTime;
+            jobs->parallelFor(dueParallelTimers.size(), [this](size_t begin, size_t end)
+                              {
+                                  for (size_t i = begin; i < end; ++i)
+                                  {
+                                      runTimer(dueParallelTimers[i]);
+                                  }
+                              });
 
-            // Check if timer expired
-            if (it->timeLeft <= 0.0f)
+            for (DueTimer &timer : dueParallelTimers)
             {
-                // Execute callback
-                try
-                {
-                    it->callback();
-                }
-                catch (const std::exception &e)
-                {
-                    Logger::error("Timer callback exception: " + std::string(e.what()));
-                }
-
-                // Handle repeat or removal
-                if (it->repeat)
-                {
-                    // Reset time left for repeating timers
-                    it->timeLeft += it->delay;
-                    // Handle case where deltaTime > delay
-                    while (it->timeLeft <= 0.0f)
-                    {
-                        it->timeLeft += it->delay;
-                    }
-                    ++it;
-                }
-                else
-                {
-                    // Remove non-repeating timers
-                    it = timers.erase(it);
-                }
+                finishTimer(timer);
             }
-            else
+            dueParallelTimers.clear();
+        }
+
+        // In expiry order; a callback may cancel timers that expired in the same update
+        for (DueTimer &timer : dueTimers)
+        {
+            if (isCurrent(timer.slot, timer.generation))
             {
-                ++it;
+                runTimer(timer);
+                finishTimer(timer);
             }
         }
+        dueTimers.clear();
+    }
+
+    void Time::scheduleTimer(uint32_t slot, double expiry)
+    {
+        timerHeap.push_back({expiry, timerSequence++, slot, timerSlots[slot].generation});
+        std::push_heap(timerHeap.begin(), timerHeap.end(), expiresLater);
+    }
+
+    void Time::runTimer(DueTimer &timer)
+    {
+        try
+        {
+            timer.callback();
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Timer callback exception: {}", e.what());
+        }
+    }
+
+    void Time::finishTimer(DueTimer &timer)
+    {
+        // Cancelled by its own callback or by an earlier one
+        if (!isCurrent(timer.slot, timer.generation))
+        {
+            return;
+        }
+
+        TimerSlot &slot = timerSlots[timer.slot];
+        if (!slot.repeat)
+        {
+            releaseTimer(timer.slot);
+            return;
+        }
+
+        // Keep the phase of the timer, skipping periods that passed within one update
+        double next = timer.expiry + slot.interval;
+        if (next <= timerTime)
+        {
+            next = slot.interval > 0.0
+                       ? timer.expiry + slot.interval * (std::floor((timerTime - timer.expiry) / slot.interval) + 1.0)
+                       : timerTime;
+        }
+
+        slot.callback = std::move(timer.callback);
+        scheduleTimer(timer.slot, next);
+    }
+
+    void Time::releaseTimer(uint32_t slot)
+    {
+        TimerSlot &timer = timerSlots[slot];
+        timer.callback.reset();
+        timer.active = false;
+
+        // Generation 0 would let a timer ID be 0
+        timer.generation = timer.generation == UINT32_MAX ? 1 : timer.generation + 1;
+
+        freeTimerSlots.push_back(slot);
+        --activeTimerCount;
+    }
+
+    bool Time::isCurrent(uint32_t slot, uint32_t generation) const
+    {
+        return slot < timerSlots.size() && timerSlots[slot].active && timerSlots[slot].generation == generation;
+    }
+
+    bool Time::expiresLater(const TimerEntry &a, const TimerEntry &b)
+    {
+        return a.expiry > b.expiry || (a.expiry == b.expiry && a.sequence > b.sequence);
     }
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "Engine/ECS/Entity.hpp"
+#include "Engine/ECS/EntityManager.hpp"
+
+namespace Engine
+{
+
+    Entity::Entity(EntityManager *manager, uint32_t id)
+        : manager(manager), id(id), active(true)
+    {
+    }
+
+    Entity::~Entity()
+    {
+        // Components are owned by the entity manager's pools
+    }
+
+    bool Entity::hasComponent(TypeId type) const
+    {
+        ComponentPoolBase *pool = manager->findPool(type);
+        return pool && pool->contains(getIndex());
+    }
+
+} // namespace Engine
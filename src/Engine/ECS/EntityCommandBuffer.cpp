@@ -0,0 +1,38 @@
+#include "Engine/ECS/EntityCommandBuffer.hpp"
+
+namespace Engine
+{
+
+    PendingEntity EntityCommandBuffer::createEntity(uint32_t sortKey)
+    {
+        createKeys.push_back(sortKey);
+        ++commandCount;
+        return PendingEntity{static_cast<uint32_t>(createKeys.size() - 1)};
+    }
+
+    void EntityCommandBuffer::destroyEntity(Entity *entity)
+    {
+        if (!entity)
+        {
+            return;
+        }
+
+        destroyTargets.push_back(Target{entity->getId(), false});
+        ++commandCount;
+    }
+
+    void EntityCommandBuffer::clear()
+    {
+        createKeys.clear();
+        destroyTargets.clear();
+        for (auto &list : lists)
+        {
+            if (list)
+            {
+                list->clear();
+            }
+        }
+        commandCount = 0;
+    }
+
+} // namespace Engine
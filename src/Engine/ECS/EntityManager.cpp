@@ -0,0 +1,357 @@
+#include "Engine/ECS/EntityManager.hpp"
+#include "Engine/ECS/EntityCommandBuffer.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Engine.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    EntityManager::EntityManager(Engine &engine)
+        : engine(engine), entityPool(MemoryTag::ECS), entityCount(0)
+    {
+    }
+
+    EntityManager::~EntityManager()
+    {
+        shutdown();
+    }
+
+    bool EntityManager::initialize()
+    {
+        // One command buffer per thread that may run systems
+        ownerThread = std::this_thread::get_id();
+        commandBuffers.clear();
+        for (uint32_t i = 0; i <= engine.getJobSystem().getWorkerCount(); ++i)
+        {
+            commandBuffers.push_back(std::make_unique<EntityCommandBuffer>());
+        }
+
+        return scheduler.initialize(&engine.getJobSystem());
+    }
+
+    void EntityManager::update(float deltaTime)
+    {
+        scheduler.run(deltaTime);
+        playbackCommands();
+        transformHierarchy.update(&engine.getJobSystem());
+    }
+
+    void EntityManager::fixedUpdate(float fixedDeltaTime)
+    {
+        for (auto &entity : entities)
+        {
+            if (entity)
+            {
+                entity->getTransform().storePreviousState();
+            }
+        }
+
+        scheduler.run(fixedDeltaTime, SystemPhase::FixedUpdate);
+        playbackCommands();
+        transformHierarchy.update(&engine.getJobSystem());
+    }
+
+    void EntityManager::shutdown()
+    {
+        scheduler.shutdown();
+
+        // Shut down systems in reverse order of creation
+        for (auto it = systems.rbegin(); it != systems.rend(); ++it)
+        {
+            (*it)->shutdown();
+        }
+        systems.clear();
+        systemsByType.clear();
+        for (auto &buffer : commandBuffers)
+        {
+            buffer->clear();
+        }
+
+        // Destroy views before the pools they listen to, and components
+        // before the entities that own them
+        views.clear();
+        componentPools.clear();
+        transformHierarchy.clear();
+        for (Entity *entity : entities)
+        {
+            entityPool.destroy(entity);
+        }
+        entities.clear();
+        entityPool.clear();
+        generations.clear();
+        freeIds = std::queue<uint32_t>();
+        entityCount = 0;
+    }
+
+    Entity *EntityManager::createEntity()
+    {
+        uint32_t index;
+        if (!freeIds.empty())
+        {
+            index = freeIds.front();
+            freeIds.pop();
+        }
+        else
+        {
+            // The last index is never used: with the largest generation its
+            // handle would equal the invalid handle
+            index = static_cast<uint32_t>(entities.size());
+            if (index >= EntityHandle::IndexMask)
+            {
+                Logger::error("Cannot create entity: Entity limit reached");
+                return nullptr;
+            }
+
+            entities.emplace_back();
+            generations.push_back(0);
+        }
+
+        EntityHandle handle = EntityHandle::make(index, generations[index]);
+        Entity *entity = entityPool.create(this, handle.value);
+        if (!entity)
+        {
+            Logger::error("Cannot create entity: Out of memory");
+            freeIds.push(index);
+            return nullptr;
+        }
+
+        entities[index] = entity;
+        transformHierarchy.add(&entity->getTransform());
+        ++entityCount;
+
+        return entity;
+    }
+
+    size_t EntityManager::createEntities(size_t count, std::vector<Entity *> &created)
+    {
+        reserve(entityCount + count);
+        created.reserve(created.size() + count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Entity *entity = createEntity();
+            if (!entity)
+            {
+                return i;
+            }
+            created.push_back(entity);
+        }
+
+        return count;
+    }
+
+    void EntityManager::reserve(size_t count)
+    {
+        // Free slots are reused first, the rest is appended
+        size_t reusable = entityCount + freeIds.size();
+        size_t appended = count > reusable ? count - reusable : 0;
+        entities.reserve(entities.size() + appended);
+        generations.reserve(generations.size() + appended);
+        transformHierarchy.reserve(count);
+    }
+
+    void EntityManager::destroyEntity(Entity *entity)
+    {
+        if (!entity || getEntity(entity->getId()) != entity)
+        {
+            return;
+        }
+
+        if (destroyCallback)
+        {
+            destroyCallback(entity);
+        }
+
+        uint32_t index = entity->getIndex();
+
+        // Remove the entity from every system and every pool
+        for (auto &system : systems)
+        {
+            system->removeEntity(entity);
+        }
+
+        for (auto &pool : componentPools)
+        {
+            if (pool)
+            {
+                pool->remove(index);
+            }
+        }
+
+        transformHierarchy.remove(&entity->getTransform());
+
+        // Invalidate outstanding handles and recycle the slot
+        entityPool.destroy(entity);
+        entities[index] = nullptr;
+        generations[index] = (generations[index] + 1) & EntityHandle::GenerationMask;
+        freeIds.push(index);
+        --entityCount;
+    }
+
+    Entity *EntityManager::getEntity(uint32_t id)
+    {
+        EntityHandle handle(id);
+        uint32_t index = handle.index();
+
+        if (index >= entities.size() || generations[index] != handle.generation())
+        {
+            return nullptr;
+        }
+
+        return entities[index];
+    }
+
+    EntityCommandBuffer *EntityManager::getCommandBuffer()
+    {
+        if (commandBuffers.empty())
+        {
+            return nullptr;
+        }
+
+        int worker = engine.getJobSystem().currentWorker();
+        if (worker >= 0 && static_cast<size_t>(worker) + 1 < commandBuffers.size())
+        {
+            return commandBuffers[worker + 1].get();
+        }
+
+        return std::this_thread::get_id() == ownerThread ? commandBuffers[0].get() : nullptr;
+    }
+
+    void EntityManager::playbackCommands()
+    {
+        using Target = EntityCommandBuffer::Target;
+
+        size_t commandCount = 0;
+        for (const auto &buffer : commandBuffers)
+        {
+            commandCount += buffer->getCommandCount();
+        }
+        if (commandCount == 0)
+        {
+            return;
+        }
+
+        // Creations, by sort key and then by buffer
+        struct Creation
+        {
+            uint32_t key;
+            uint32_t buffer;
+            uint32_t index;
+        };
+        std::vector<Creation> creations;
+        std::vector<std::vector<Entity *>> created(commandBuffers.size());
+        for (uint32_t b = 0; b < commandBuffers.size(); ++b)
+        {
+            const std::vector<uint32_t> &keys = commandBuffers[b]->createKeys;
+            created[b].assign(keys.size(), nullptr);
+            for (uint32_t i = 0; i < keys.size(); ++i)
+            {
+                creations.push_back(Creation{keys[i], b, i});
+            }
+        }
+        std::stable_sort(creations.begin(), creations.end(), [](const Creation &a, const Creation &b)
+                         { return a.key < b.key; });
+
+        std::vector<Entity *> batch;
+        createEntities(creations.size(), batch);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            created[creations[i].buffer][creations[i].index] = batch[i];
+        }
+
+        auto resolve = [this, &created](uint32_t buffer, Target target) -> Entity *
+        {
+            return target.pending ? created[buffer][target.id] : getEntity(target.id);
+        };
+
+        // Component types in id order, each handled across all buffers at once
+        size_t typeCount = 0;
+        for (const auto &buffer : commandBuffers)
+        {
+            typeCount = std::max(typeCount, buffer->lists.size());
+        }
+
+        struct ResolvedChange
+        {
+            Entity *entity;
+            EntityCommandBuffer::CommandList *list;
+            uint32_t item;
+        };
+        std::vector<ResolvedChange> changes;
+        for (TypeId type = 0; type < typeCount; ++type)
+        {
+            changes.clear();
+            size_t additionCount = 0;
+            for (uint32_t b = 0; b < commandBuffers.size(); ++b)
+            {
+                EntityCommandBuffer::CommandList *list = commandBuffers[b]->findList(type);
+                if (!list)
+                {
+                    continue;
+                }
+
+                for (const EntityCommandBuffer::Change &change : list->changes)
+                {
+                    if (Entity *entity = resolve(b, change.target))
+                    {
+                        changes.push_back(ResolvedChange{entity, list, change.item});
+                        additionCount += change.item != EntityCommandBuffer::Change::Removal;
+                    }
+                }
+            }
+            if (changes.empty())
+            {
+                continue;
+            }
+
+            // Sorted by entity, so the pool is appended to in slot order; the
+            // stable sort keeps the changes to one entity in recording order
+            std::stable_sort(changes.begin(), changes.end(), [](const ResolvedChange &a, const ResolvedChange &b)
+                             { return a.entity->getIndex() < b.entity->getIndex(); });
+            if (additionCount > 0)
+            {
+                changes.front().list->reserve(*this, additionCount);
+            }
+
+            ComponentPoolBase *pool = findPool(type);
+            for (const ResolvedChange &change : changes)
+            {
+                if (change.item != EntityCommandBuffer::Change::Removal)
+                {
+                    change.list->add(*this, change.item, change.entity);
+                }
+                else if (pool)
+                {
+                    pool->remove(change.entity->getIndex());
+                }
+            }
+        }
+
+        // Destructions last, by slot index; duplicates and stale entities resolve to nothing
+        std::vector<uint32_t> destroyed;
+        for (uint32_t b = 0; b < commandBuffers.size(); ++b)
+        {
+            for (const Target &target : commandBuffers[b]->destroyTargets)
+            {
+                if (Entity *entity = resolve(b, target))
+                {
+                    destroyed.push_back(entity->getId());
+                }
+            }
+        }
+        std::sort(destroyed.begin(), destroyed.end(), [](uint32_t a, uint32_t b)
+                  { return EntityHandle(a).index() < EntityHandle(b).index(); });
+        for (uint32_t id : destroyed)
+        {
+            destroyEntity(getEntity(id));
+        }
+
+        for (auto &buffer : commandBuffers)
+        {
+            buffer->clear();
+        }
+    }
+
+} // namespace Engine
@@ -0,0 +1,57 @@
+#include "Engine/ECS/System.hpp"
+#include "Engine/ECS/Entity.hpp"
+#include "Engine/ECS/EntityManager.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    System::System(Engine &engine)
+        : engine(engine), entityManager(nullptr), name("System"), typeId(TypeIds<System>::Invalid)
+    {
+    }
+
+    void System::addEntity(Entity *entity)
+    {
+        if (!entity || !hasRequiredComponents(entity))
+        {
+            return;
+        }
+
+        if (std::find(entities.begin(), entities.end(), entity) == entities.end())
+        {
+            entities.push_back(entity);
+        }
+    }
+
+    void System::removeEntity(Entity *entity)
+    {
+        auto it = std::find(entities.begin(), entities.end(), entity);
+        if (it != entities.end())
+        {
+            // Order is not significant, so swap with the last entity
+            *it = entities.back();
+            entities.pop_back();
+        }
+    }
+
+    EntityCommandBuffer *System::commands()
+    {
+        return entityManager ? entityManager->getCommandBuffer() : nullptr;
+    }
+
+    bool System::hasRequiredComponents(Entity *entity) const
+    {
+        for (const auto &type : requiredComponents)
+        {
+            if (!entity->hasComponent(type))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+} // namespace Engine
@@ -0,0 +1,333 @@
+#include "Engine/ECS/SystemScheduler.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Checks if two type lists share a type
+         */
+        bool intersects(const std::vector<TypeId> &a, const std::vector<TypeId> &b)
+        {
+            for (const auto &type : a)
+            {
+                if (std::find(b.begin(), b.end(), type) != b.end())
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    SystemScheduler::SystemScheduler()
+        : dirty(true),
+          cyclic(false),
+          mode(ScheduleMode::Parallel),
+          chunkSize(256),
+          jobs(nullptr)
+    {
+    }
+
+    SystemScheduler::~SystemScheduler()
+    {
+        shutdown();
+    }
+
+    bool SystemScheduler::initialize(JobSystem *jobSystem)
+    {
+        jobs = jobSystem;
+        return true;
+    }
+
+    void SystemScheduler::shutdown()
+    {
+        clear();
+        jobs = nullptr;
+    }
+
+    void SystemScheduler::addSystem(System *system)
+    {
+        if (!system)
+        {
+            return;
+        }
+
+        systems.push_back(system);
+        dirty = true;
+    }
+
+    void SystemScheduler::clear()
+    {
+        systems.clear();
+        nodes.clear();
+        executionOrder.clear();
+        remaining.reset();
+        dirty = true;
+    }
+
+    const std::vector<System *> &SystemScheduler::getExecutionOrder()
+    {
+        buildGraph();
+        return executionOrder;
+    }
+
+    void SystemScheduler::run(float deltaTime, SystemPhase phase)
+    {
+        buildGraph();
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        // Without workers, or with a broken graph, run the order on this thread
+        if (mode == ScheduleMode::SingleThreaded || cyclic || !jobs || jobs->getWorkerCount() == 0)
+        {
+            for (System *system : executionOrder)
+            {
+                runSystem(*system, deltaTime, phase, false);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            remaining[i].store(nodes[i].predecessorCount, std::memory_order_relaxed);
+        }
+
+        JobCounter counter;
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i].predecessorCount == 0)
+            {
+                submitNode(i, deltaTime, phase, counter);
+            }
+        }
+
+        jobs->wait(counter);
+    }
+
+    void SystemScheduler::buildGraph()
+    {
+        if (!dirty)
+        {
+            return;
+        }
+
+        dirty = false;
+        cyclic = false;
+
+        size_t count = systems.size();
+        nodes.assign(count, Node());
+        remaining.reset(new std::atomic<uint32_t>[count]);
+        executionOrder.clear();
+
+        // Node of the first system of every type, for the ordering constraints
+        std::vector<uint32_t> indexByType(TypeIds<System>::count(), TypeIds<System>::Invalid);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            nodes[i].system = systems[i];
+            TypeId type = systems[i]->getTypeId();
+            if (type < indexByType.size() && indexByType[type] == TypeIds<System>::Invalid)
+            {
+                indexByType[type] = i;
+            }
+        }
+
+        auto findNode = [&indexByType](TypeId type)
+        {
+            return type < indexByType.size() ? indexByType[type] : TypeIds<System>::Invalid;
+        };
+
+        // Edges as an adjacency matrix, plus its transitive closure so that
+        // conflicting systems can be oriented without creating cycles
+        std::vector<std::vector<bool>> edges(count, std::vector<bool>(count, false));
+        std::vector<std::vector<bool>> reaches(count, std::vector<bool>(count, false));
+
+        auto addEdge = [&](uint32_t from, uint32_t to)
+        {
+            if (edges[from][to])
+            {
+                return;
+            }
+
+            edges[from][to] = true;
+            for (uint32_t x = 0; x < count; ++x)
+            {
+                if (x != from && !reaches[x][from])
+                {
+                    continue;
+                }
+
+                reaches[x][to] = true;
+                for (uint32_t y = 0; y < count; ++y)
+                {
+                    if (reaches[to][y])
+                    {
+                        reaches[x][y] = true;
+                    }
+                }
+            }
+        };
+
+        // Explicit ordering constraints come first
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            for (TypeId type : systems[i]->getRunAfter())
+            {
+                uint32_t other = findNode(type);
+                if (other != TypeIds<System>::Invalid && other != i)
+                {
+                    addEdge(other, i);
+                }
+            }
+
+            for (TypeId type : systems[i]->getRunBefore())
+            {
+                uint32_t other = findNode(type);
+                if (other != TypeIds<System>::Invalid && other != i)
+                {
+                    addEdge(i, other);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (reaches[i][i])
+            {
+                cyclic = true;
+                break;
+            }
+        }
+
+        if (cyclic)
+        {
+            Logger::error("System ordering constraints form a cycle; running systems in insertion order");
+            nodes.assign(count, Node());
+            executionOrder = systems;
+            return;
+        }
+
+        // Conflicting systems run in the order they were added, unless the
+        // constraints already require the opposite order
+        for (uint32_t j = 0; j < count; ++j)
+        {
+            for (uint32_t i = 0; i < j; ++i)
+            {
+                if (conflicts(*systems[i], *systems[j]))
+                {
+                    if (reaches[j][i])
+                    {
+                        addEdge(j, i);
+                    }
+                    else
+                    {
+                        addEdge(i, j);
+                    }
+                }
+            }
+        }
+
+        for (uint32_t from = 0; from < count; ++from)
+        {
+            for (uint32_t to = 0; to < count; ++to)
+            {
+                if (edges[from][to])
+                {
+                    nodes[from].successors.push_back(to);
+                    ++nodes[to].predecessorCount;
+                }
+            }
+        }
+
+        // Kahn's algorithm, always taking the earliest added ready system so
+        // that the order is deterministic
+        std::vector<uint32_t> pending(count);
+        std::vector<bool> placed(count, false);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            pending[i] = nodes[i].predecessorCount;
+        }
+
+        for (size_t step = 0; step < count; ++step)
+        {
+            uint32_t next = 0;
+            while (placed[next] || pending[next] != 0)
+            {
+                ++next;
+            }
+
+            placed[next] = true;
+            executionOrder.push_back(systems[next]);
+            for (uint32_t successor : nodes[next].successors)
+            {
+                --pending[successor];
+            }
+        }
+    }
+
+    bool SystemScheduler::conflicts(const System &a, const System &b)
+    {
+        if (a.isExclusive() || b.isExclusive())
+        {
+            return true;
+        }
+
+        return intersects(a.getWrites(), b.getWrites()) ||
+               intersects(a.getWrites(), b.getReads()) ||
+               intersects(a.getReads(), b.getWrites());
+    }
+
+    void SystemScheduler::runSystem(System &system, float deltaTime, SystemPhase phase, bool parallel)
+    {
+        ENGINE_PROFILE_SCOPE(system.getName());
+
+        if (phase == SystemPhase::FixedUpdate)
+        {
+            system.fixedUpdate(deltaTime);
+            return;
+        }
+
+        size_t workSize = system.getParallelWorkSize();
+        if (workSize == 0)
+        {
+            system.update(deltaTime);
+            return;
+        }
+
+        if (!parallel)
+        {
+            system.updateRange(deltaTime, 0, workSize);
+            return;
+        }
+
+        jobs->parallelFor(workSize, chunkSize, [&system, deltaTime](size_t begin, size_t end)
+                         { system.updateRange(deltaTime, begin, end); });
+    }
+
+    void SystemScheduler::submitNode(uint32_t index, float deltaTime, SystemPhase phase, JobCounter &counter)
+    {
+        jobs->submit([this, index, deltaTime, phase, &counter]()
+                    {
+                        runSystem(*nodes[index].system, deltaTime, phase, true);
+
+                        // Release successors whose last predecessor just finished
+                        for (uint32_t successor : nodes[index].successors)
+                        {
+                            if (remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            {
+                                submitNode(successor, deltaTime, phase, counter);
+                            }
+                        }
+                    },
+                    &counter);
+    }
+
+} // namespace Engine
@@ -0,0 +1,346 @@
+#include "Engine/Input/InputManager.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Renderer/Window.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine
+{
+
+    InputManager::InputManager()
+        : window(nullptr),
+          events(EventQueueCapacity),
+          gamepadAxes{},
+          gamepadAxisTimestamps{},
+          hasMousePosition(false),
+          nextCallbackId(1),
+          dispatching(false),
+          hasRemovedCallbacks(false)
+    {
+    }
+
+    InputManager::~InputManager()
+    {
+        shutdown();
+    }
+
+    bool InputManager::initialize(Window *window)
+    {
+        if (!window)
+        {
+            Logger::error("Cannot initialize input without a window");
+            return false;
+        }
+
+        this->window = window;
+        window->setInputEventQueue(&events);
+
+        Logger::info("Input manager initialized");
+        return true;
+    }
+
+    void InputManager::update()
+    {
+        keys.beginFrame();
+        mouseButtons.beginFrame();
+        gamepadButtons.beginFrame();
+        prevMousePosition = mousePosition;
+        mouseScroll = Vector2();
+
+        // The window's callbacks run inside pollEvents() and fill the queue
+        if (window)
+        {
+            window->pollEvents();
+        }
+
+        InputEvent event;
+        while (events.tryPop(event))
+        {
+            applyEvent(event);
+        }
+
+        mouseMovement = mousePosition - prevMousePosition;
+
+        // Apply the registrations made by callbacks
+        if (hasRemovedCallbacks)
+        {
+            for (auto &callbacks : keyCallbacks)
+            {
+                callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(), [](const KeyCallbackEntry &entry)
+                                               { return entry.id == 0; }),
+                                callbacks.end());
+            }
+            hasRemovedCallbacks = false;
+        }
+        for (KeyCallbackEntry &entry : pendingKeyCallbacks)
+        {
+            keyCallbacks[static_cast<size_t>(entry.key)].push_back(std::move(entry));
+        }
+        pendingKeyCallbacks.clear();
+
+        updateActions();
+    }
+
+    void InputManager::shutdown()
+    {
+        if (window)
+        {
+            window->setInputEventQueue(nullptr);
+            window = nullptr;
+        }
+
+        for (auto &callbacks : keyCallbacks)
+        {
+            callbacks.clear();
+        }
+        pendingKeyCallbacks.clear();
+    }
+
+    bool InputManager::isKeyPressed(Key key) const
+    {
+        size_t index = static_cast<size_t>(key);
+        return index < keys.down.size() && keys.down[index];
+    }
+
+    bool InputManager::isKeyJustPressed(Key key) const
+    {
+        size_t index = static_cast<size_t>(key);
+        return index < keys.pressed.size() && keys.pressed[index];
+    }
+
+    bool InputManager::isKeyJustReleased(Key key) const
+    {
+        size_t index = static_cast<size_t>(key);
+        return index < keys.released.size() && keys.released[index];
+    }
+
+    bool InputManager::isMouseButtonPressed(MouseButton button) const
+    {
+        size_t index = static_cast<size_t>(button);
+        return index < mouseButtons.down.size() && mouseButtons.down[index];
+    }
+
+    bool InputManager::isMouseButtonJustPressed(MouseButton button) const
+    {
+        size_t index = static_cast<size_t>(button);
+        return index < mouseButtons.pressed.size() && mouseButtons.pressed[index];
+    }
+
+    bool InputManager::isMouseButtonJustReleased(MouseButton button) const
+    {
+        size_t index = static_cast<size_t>(button);
+        return index < mouseButtons.released.size() && mouseButtons.released[index];
+    }
+
+    bool InputManager::isGamepadButtonPressed(GamepadButton button) const
+    {
+        size_t index = static_cast<size_t>(button);
+        return index < gamepadButtons.down.size() && gamepadButtons.down[index];
+    }
+
+    float InputManager::getGamepadAxis(GamepadAxis axis) const
+    {
+        size_t index = static_cast<size_t>(axis);
+        return index < gamepadAxes.size() ? gamepadAxes[index] : 0.0f;
+    }
+
+    uint32_t InputManager::registerKeyCallback(Key key, KeyState state, KeyCallback callback)
+    {
+        if (static_cast<size_t>(key) >= keyCallbacks.size())
+        {
+            Logger::error("Cannot register a callback for an invalid key");
+            return 0;
+        }
+
+        KeyCallbackEntry entry;
+        entry.id = nextCallbackId++;
+        entry.key = key;
+        entry.onPress = state == KeyState::Pressed || state == KeyState::JustPressed;
+        entry.callback = std::move(callback);
+
+        // Growing the list would move the callback that is running
+        uint32_t id = entry.id;
+        if (dispatching)
+        {
+            pendingKeyCallbacks.push_back(std::move(entry));
+        }
+        else
+        {
+            keyCallbacks[static_cast<size_t>(key)].push_back(std::move(entry));
+        }
+        return id;
+    }
+
+    bool InputManager::unregisterKeyCallback(uint32_t id)
+    {
+        if (id == 0)
+        {
+            return false;
+        }
+
+        for (auto it = pendingKeyCallbacks.begin(); it != pendingKeyCallbacks.end(); ++it)
+        {
+            if (it->id == id)
+            {
+                pendingKeyCallbacks.erase(it);
+                return true;
+            }
+        }
+
+        for (auto &callbacks : keyCallbacks)
+        {
+            for (auto it = callbacks.begin(); it != callbacks.end(); ++it)
+            {
+                if (it->id != id)
+                {
+                    continue;
+                }
+
+                // A running callback may unregister itself, so only mark it until dispatch is done
+                if (dispatching)
+                {
+                    it->id = 0;
+                    hasRemovedCallbacks = true;
+                }
+                else
+                {
+                    callbacks.erase(it);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void InputManager::applyEvent(const InputEvent &event)
+    {
+        switch (event.type)
+        {
+        case InputEventType::Key:
+            if (keys.apply(static_cast<size_t>(event.key), event.pressed, event.timestamp))
+            {
+                dispatchKeyCallbacks(event.key, event.pressed);
+            }
+            break;
+
+        case InputEventType::MouseButton:
+            mouseButtons.apply(static_cast<size_t>(event.mouseButton), event.pressed, event.timestamp);
+            break;
+
+        case InputEventType::MouseMove:
+            // The first position is not a movement
+            if (!hasMousePosition)
+            {
+                prevMousePosition = Vector2(event.x, event.y);
+                hasMousePosition = true;
+            }
+            mousePosition = Vector2(event.x, event.y);
+            break;
+
+        case InputEventType::MouseScroll:
+            mouseScroll.x += event.x;
+            mouseScroll.y += event.y;
+            break;
+
+        case InputEventType::GamepadButton:
+            gamepadButtons.apply(static_cast<size_t>(event.gamepadButton), event.pressed, event.timestamp);
+            break;
+
+        case InputEventType::GamepadAxis:
+        {
+            size_t index = static_cast<size_t>(event.gamepadAxis);
+            if (index < gamepadAxes.size())
+            {
+                gamepadAxes[index] = event.x;
+                gamepadAxisTimestamps[index] = event.timestamp;
+            }
+            break;
+        }
+        }
+    }
+
+    void InputManager::dispatchKeyCallbacks(Key key, bool pressed)
+    {
+        // Registrations made by callbacks are deferred, so the list keeps its size
+        const auto &callbacks = keyCallbacks[static_cast<size_t>(key)];
+        dispatching = true;
+        for (size_t i = 0; i < callbacks.size(); ++i)
+        {
+            const KeyCallbackEntry &entry = callbacks[i];
+            if (entry.id != 0 && entry.onPress == pressed)
+            {
+                entry.callback();
+            }
+        }
+        dispatching = false;
+    }
+
+    void InputManager::updateActions()
+    {
+        const std::vector<InputAction> &actions = mapping.getActions();
+        actionStates.resize(actions.size());
+
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            ActionState &state = actionStates[i];
+            bool wasDown = state.down;
+            bool down = false;
+            bool pressed = false;
+            float value = 0.0f;
+            uint64_t timestamp = state.timestamp;
+
+            // Keeps the input with the largest magnitude, so opposite axes don't cancel
+            auto contribute = [&value](float input)
+            {
+                if (std::fabs(input) > std::fabs(value))
+                {
+                    value = input;
+                }
+            };
+
+            auto readButton = [&](const auto &buttons, size_t index)
+            {
+                if (index == 0 || index >= buttons.down.size())
+                {
+                    return;
+                }
+
+                if (buttons.down[index])
+                {
+                    down = true;
+                    contribute(1.0f);
+                }
+                pressed = pressed || buttons.pressed[index];
+                timestamp = std::max(timestamp, buttons.timestamps[index]);
+            };
+
+            for (const InputBinding &binding : actions[i].bindings)
+            {
+                readButton(keys, static_cast<size_t>(binding.key));
+                readButton(mouseButtons, static_cast<size_t>(binding.mouseButton));
+                readButton(gamepadButtons, static_cast<size_t>(binding.gamepadButton));
+
+                size_t axis = static_cast<size_t>(binding.gamepadAxis);
+                if (axis != 0 && axis < gamepadAxes.size())
+                {
+                    float axisValue = gamepadAxes[axis];
+                    if (std::fabs(axisValue) > binding.axisDeadZone)
+                    {
+                        down = true;
+                        contribute(axisValue * binding.axisScale);
+                    }
+                    timestamp = std::max(timestamp, gamepadAxisTimestamps[axis]);
+                }
+            }
+
+            // A press and release between two updates still reports both transitions
+            state.down = down;
+            state.value = down ? value : 0.0f;
+            state.justPressed = !wasDown && (down || pressed);
+            state.justReleased = wasDown ? !down : (pressed && !down);
+            state.timestamp = timestamp;
+        }
+    }
+
+} // namespace Engine
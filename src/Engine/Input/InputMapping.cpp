@@ -0,0 +1,155 @@
+#include "Engine/Input/InputMapping.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    InputMapping::InputMapping()
+    {
+    }
+
+    InputMapping::~InputMapping()
+    {
+    }
+
+    InputAction *InputMapping::findAction(const std::string &name)
+    {
+        auto it = actionIds.find(name);
+        return it != actionIds.end() ? &actions[it->second] : nullptr;
+    }
+
+    bool InputMapping::addBinding(const std::string &actionName, const InputBinding &binding)
+    {
+        InputAction *action = findAction(actionName);
+        if (!action)
+        {
+            Logger::error("Cannot bind input to unknown action: {}", actionName);
+            return false;
+        }
+
+        action->bindings.push_back(binding);
+        return true;
+    }
+
+    template <typename Match>
+    bool InputMapping::removeBindings(const std::string &actionName, Match match)
+    {
+        InputAction *action = findAction(actionName);
+        if (!action)
+        {
+            return false;
+        }
+
+        auto &bindings = action->bindings;
+        auto end = std::remove_if(bindings.begin(), bindings.end(), match);
+        bool removed = end != bindings.end();
+        bindings.erase(end, bindings.end());
+        return removed;
+    }
+
+    ActionId InputMapping::registerAction(const std::string &name, bool continuous)
+    {
+        if (actionIds.find(name) != actionIds.end())
+        {
+            Logger::warning("Input action already registered: {}", name);
+            return InvalidAction;
+        }
+
+        // IDs are never reused, so a stale ID can't alias a newer action
+        ActionId id = static_cast<ActionId>(actions.size());
+        InputAction action;
+        action.name = name;
+        action.continuous = continuous;
+        action.registered = true;
+        actions.push_back(std::move(action));
+        actionIds.emplace(name, id);
+        return id;
+    }
+
+    bool InputMapping::unregisterAction(const std::string &name)
+    {
+        auto it = actionIds.find(name);
+        if (it == actionIds.end())
+        {
+            return false;
+        }
+
+        InputAction &action = actions[it->second];
+        action.registered = false;
+        action.bindings.clear();
+        actionIds.erase(it);
+        return true;
+    }
+
+    ActionId InputMapping::getActionId(const std::string &name) const
+    {
+        auto it = actionIds.find(name);
+        return it != actionIds.end() ? it->second : InvalidAction;
+    }
+
+    const InputAction *InputMapping::getAction(ActionId id) const
+    {
+        if (id >= actions.size() || !actions[id].registered)
+        {
+            return nullptr;
+        }
+        return &actions[id];
+    }
+
+    bool InputMapping::bindKey(const std::string &actionName, Key key)
+    {
+        InputBinding binding;
+        binding.key = key;
+        return addBinding(actionName, binding);
+    }
+
+    bool InputMapping::unbindKey(const std::string &actionName, Key key)
+    {
+        return removeBindings(actionName, [key](const InputBinding &binding)
+                              { return binding.key == key; });
+    }
+
+    bool InputMapping::bindMouseButton(const std::string &actionName, MouseButton button)
+    {
+        InputBinding binding;
+        binding.mouseButton = button;
+        return addBinding(actionName, binding);
+    }
+
+    bool InputMapping::unbindMouseButton(const std::string &actionName, MouseButton button)
+    {
+        return removeBindings(actionName, [button](const InputBinding &binding)
+                              { return binding.mouseButton == button; });
+    }
+
+    bool InputMapping::bindGamepadButton(const std::string &actionName, GamepadButton button)
+    {
+        InputBinding binding;
+        binding.gamepadButton = button;
+        return addBinding(actionName, binding);
+    }
+
+    bool InputMapping::unbindGamepadButton(const std::string &actionName, GamepadButton button)
+    {
+        return removeBindings(actionName, [button](const InputBinding &binding)
+                              { return binding.gamepadButton == button; });
+    }
+
+    bool InputMapping::bindGamepadAxis(const std::string &actionName, GamepadAxis axis, float deadZone, float scale)
+    {
+        InputBinding binding;
+        binding.gamepadAxis = axis;
+        binding.axisDeadZone = deadZone;
+        binding.axisScale = scale;
+        return addBinding(actionName, binding);
+    }
+
+    bool InputMapping::unbindGamepadAxis(const std::string &actionName, GamepadAxis axis)
+    {
+        return removeBindings(actionName, [axis](const InputBinding &binding)
+                              { return binding.gamepadAxis == axis; });
+    }
+
+} // namespace Engine
@@ -0,0 +1,176 @@
+#include "Engine/Math/Bounds.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace Engine
+{
+
+    BoundingBox::BoundingBox()
+        : min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+    {
+    }
+
+    BoundingBox::BoundingBox(const Vector3 &min, const Vector3 &max)
+        : min(min), max(max)
+    {
+    }
+
+    void BoundingBox::expand(const Vector3 &point)
+    {
+        min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+        max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+    }
+
+    Vector3 BoundingBox::getCenter() const
+    {
+        return Vector3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+    }
+
+    Vector3 BoundingBox::getExtents() const
+    {
+        return Vector3((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f);
+    }
+
+    BoundingBox BoundingBox::transformed(const Matrix4 &transform) const
+    {
+        if (isEmpty())
+        {
+            return *this;
+        }
+
+        // Transform the center and project the extents onto each world axis
+        Vector3 center = getCenter();
+        Vector3 extents = getExtents();
+        float c[3] = {center.x, center.y, center.z};
+        float e[3] = {extents.x, extents.y, extents.z};
+        float newCenter[3];
+        float newExtents[3];
+        for (int row = 0; row < 3; ++row)
+        {
+            newCenter[row] = transform.get(row, 3);
+            newExtents[row] = 0.0f;
+            for (int col = 0; col < 3; ++col)
+            {
+                newCenter[row] += transform.get(row, col) * c[col];
+                newExtents[row] += std::fabs(transform.get(row, col)) * e[col];
+            }
+        }
+
+        return BoundingBox(Vector3(newCenter[0] - newExtents[0], newCenter[1] - newExtents[1], newCenter[2] - newExtents[2]),
+                           Vector3(newCenter[0] + newExtents[0], newCenter[1] + newExtents[1], newCenter[2] + newExtents[2]));
+    }
+
+    BoundingBox BoundingBox::expanded(float amount) const
+    {
+        return BoundingBox(Vector3(min.x - amount, min.y - amount, min.z - amount),
+                           Vector3(max.x + amount, max.y + amount, max.z + amount));
+    }
+
+    bool BoundingBox::contains(const BoundingBox &other) const
+    {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    bool BoundingBox::intersects(const BoundingBox &other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    float BoundingBox::getSurfaceArea() const
+    {
+        float dx = max.x - min.x;
+        float dy = max.y - min.y;
+        float dz = max.z - min.z;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    BoundingBox BoundingBox::merge(const BoundingBox &a, const BoundingBox &b)
+    {
+        return BoundingBox(Vector3(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+                           Vector3(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)));
+    }
+
+    BoundingSphere BoundingSphere::transformed(const Matrix4 &transform) const
+    {
+        if (isEmpty())
+        {
+            return *this;
+        }
+
+        BoundingSphere result;
+        result.center = Vector3(
+            transform.get(0, 0) * center.x + transform.get(0, 1) * center.y + transform.get(0, 2) * center.z + transform.get(0, 3),
+            transform.get(1, 0) * center.x + transform.get(1, 1) * center.y + transform.get(1, 2) * center.z + transform.get(1, 3),
+            transform.get(2, 0) * center.x + transform.get(2, 1) * center.y + transform.get(2, 2) * center.z + transform.get(2, 3));
+
+        // The longest basis vector is the largest scale along any axis
+        float maxScaleSquared = 0.0f;
+        for (int col = 0; col < 3; ++col)
+        {
+            float lengthSquared = transform.get(0, col) * transform.get(0, col) +
+                                  transform.get(1, col) * transform.get(1, col) +
+                                  transform.get(2, col) * transform.get(2, col);
+            maxScaleSquared = std::max(maxScaleSquared, lengthSquared);
+        }
+
+        result.radius = radius * std::sqrt(maxScaleSquared);
+        return result;
+    }
+
+    bool BoundingSphere::intersects(const BoundingBox &box) const
+    {
+        // Distance from the center to the closest point of the box
+        float dx = std::max(box.min.x - center.x, std::max(0.0f, center.x - box.max.x));
+        float dy = std::max(box.min.y - center.y, std::max(0.0f, center.y - box.max.y));
+        float dz = std::max(box.min.z - center.z, std::max(0.0f, center.z - box.max.z));
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+    bool Ray::intersects(const BoundingBox &box, float maxDistance, float &distance) const
+    {
+        // Slab test; infinities from zero direction components compare correctly
+        float o[3] = {origin.x, origin.y, origin.z};
+        float d[3] = {direction.x, direction.y, direction.z};
+        float lo[3] = {box.min.x, box.min.y, box.min.z};
+        float hi[3] = {box.max.x, box.max.y, box.max.z};
+
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (d[axis] == 0.0f)
+            {
+                if (o[axis] < lo[axis] || o[axis] > hi[axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            float inverse = 1.0f / d[axis];
+            float t1 = (lo[axis] - o[axis]) * inverse;
+            float t2 = (hi[axis] - o[axis]) * inverse;
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+
+        distance = tMin;
+        return true;
+    }
+
+} // namespace Engine
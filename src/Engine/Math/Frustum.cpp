@@ -0,0 +1,183 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathKernels.hpp"
+
+#include <cmath>
+
+#if defined(ENGINE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+namespace Engine
+{
+
+    Frustum::Frustum()
+    {
+        // Planes with a zero normal and positive distance accept every point
+        for (Plane &plane : planes)
+        {
+            plane.normal = Vector3::Zero;
+            plane.distance = 1.0f;
+        }
+    }
+
+    Frustum Frustum::fromMatrix(const Matrix4 &viewProjection)
+    {
+        // Each plane is the sum or difference of the last row and another
+        // row of the clip matrix (Gribb and Hartmann)
+        auto row = [&viewProjection](int r, float out[4])
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                out[c] = viewProjection.get(r, c);
+            }
+        };
+
+        float r0[4], r1[4], r2[4], r3[4];
+        row(0, r0);
+        row(1, r1);
+        row(2, r2);
+        row(3, r3);
+
+        const float *rows[3] = {r0, r1, r2};
+        Frustum frustum;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int side = 0; side < 2; ++side)
+            {
+                float sign = side == 0 ? 1.0f : -1.0f;
+                float a = r3[0] + sign * rows[i][0];
+                float b = r3[1] + sign * rows[i][1];
+                float c = r3[2] + sign * rows[i][2];
+                float d = r3[3] + sign * rows[i][3];
+
+                float length = std::sqrt(a * a + b * b + c * c);
+                float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+
+                Plane &plane = frustum.planes[i * 2 + side];
+                plane.normal = Vector3(a * inverse, b * inverse, c * inverse);
+                plane.distance = d * inverse;
+            }
+        }
+
+        return frustum;
+    }
+
+    bool Frustum::intersects(const BoundingSphere &sphere) const
+    {
+        for (const Plane &plane : planes)
+        {
+            if (plane.distanceTo(sphere.center) < -sphere.radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const BoundingBox &box) const
+    {
+        if (box.isEmpty())
+        {
+            return false;
+        }
+
+        // Test the corner that lies furthest along each plane normal
+        for (const Plane &plane : planes)
+        {
+            Vector3 corner(plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                           plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                           plane.normal.z >= 0.0f ? box.max.z : box.min.z);
+            if (plane.distanceTo(corner) < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Frustum::Containment Frustum::classify(const BoundingBox &box) const
+    {
+        if (box.isEmpty())
+        {
+            return Containment::Outside;
+        }
+
+        Containment result = Containment::Inside;
+        for (const Plane &plane : planes)
+        {
+            // Furthest corner along the normal decides outside, nearest decides inside
+            Vector3 positive(plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                             plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                             plane.normal.z >= 0.0f ? box.max.z : box.min.z);
+            if (plane.distanceTo(positive) < 0.0f)
+            {
+                return Containment::Outside;
+            }
+
+            Vector3 negative(plane.normal.x >= 0.0f ? box.min.x : box.max.x,
+                             plane.normal.y >= 0.0f ? box.min.y : box.max.y,
+                             plane.normal.z >= 0.0f ? box.min.z : box.max.z);
+            if (plane.distanceTo(negative) < 0.0f)
+            {
+                result = Containment::Intersecting;
+            }
+        }
+        return result;
+    }
+
+    void Frustum::cullSpheres(const BoundingSphereBatch &spheres, std::vector<uint8_t> &visible) const
+    {
+        size_t count = spheres.size();
+        visible.resize(count);
+
+        const float *xs = spheres.x.data();
+        const float *ys = spheres.y.data();
+        const float *zs = spheres.z.data();
+        const float *radii = spheres.radius.data();
+
+        size_t i = 0;
+#if defined(ENGINE_SIMD_SSE)
+        __m128 planeX[PlaneCount], planeY[PlaneCount], planeZ[PlaneCount], planeD[PlaneCount];
+        for (int p = 0; p < PlaneCount; ++p)
+        {
+            planeX[p] = _mm_set1_ps(planes[p].normal.x);
+            planeY[p] = _mm_set1_ps(planes[p].normal.y);
+            planeZ[p] = _mm_set1_ps(planes[p].normal.z);
+            planeD[p] = _mm_set1_ps(planes[p].distance);
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 z = _mm_loadu_ps(zs + i);
+            __m128 r = _mm_loadu_ps(radii + i);
+
+            // A sphere is outside once it lies entirely behind any plane
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+            for (int p = 0; p < PlaneCount; ++p)
+            {
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+                                             _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeD[p]));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, r), zero));
+            }
+
+            int mask = _mm_movemask_ps(inside);
+            visible[i] = static_cast<uint8_t>(mask & 1);
+            visible[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+            visible[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+            visible[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            BoundingSphere sphere;
+            sphere.center = Vector3(xs[i], ys[i], zs[i]);
+            sphere.radius = radii[i];
+            visible[i] = intersects(sphere) ? 1 : 0;
+        }
+    }
+
+} // namespace Engine
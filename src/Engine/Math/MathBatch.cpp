@@ -0,0 +1,332 @@
+#include "Engine/Math/MathBatch.hpp"
+#include "Engine/Math/MathKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(ENGINE_SIMD_SSE)
+#include <emmintrin.h>
+#endif
+
+namespace Engine
+{
+    namespace MathBatch
+    {
+
+        namespace
+        {
+            /**
+             * @brief Length below which quaternions count as degenerate
+             */
+            const float EPSILON = 1e-6f;
+
+            /**
+             * @brief Number of terms of the slerp weight polynomial
+             */
+            const int SLERP_TERMS = 12;
+
+            /**
+             * @brief Coefficients 1 / (i * (2i + 1)) of the slerp weight series
+             *
+             * The series of sin(t * angle) / sin(angle) in (cos(angle) - 1) is
+             * cut after SLERP_TERMS terms; scaling the last coefficient makes
+             * up for most of the dropped tail (see D. Eberly, "A Fast and
+             * Accurate Algorithm for Computing SLERP").
+             */
+            const float SLERP_COEFFICIENTS[SLERP_TERMS] = {
+                1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+                1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), 1.0f / (8 * 17),
+                1.0f / (9 * 19), 1.0f / (10 * 21), 1.0f / (11 * 23), 1.894f / (12 * 25)};
+
+            size_t clampEnd(size_t end, size_t size)
+            {
+                return std::min(end, size);
+            }
+
+            float clamp01(float t)
+            {
+                return (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+            }
+
+            /**
+             * @brief Computes sin(t * angle) / sin(angle) from cos(angle) - 1
+             */
+            float slerpWeight(float t, float cosMinusOne)
+            {
+                float t2 = t * t;
+                float sum = 1.0f;
+                for (int i = SLERP_TERMS; i >= 1; --i)
+                {
+                    sum = 1.0f + SLERP_COEFFICIENTS[i - 1] * (t2 - float(i * i)) * cosMinusOne * sum;
+                }
+                return t * sum;
+            }
+
+#if defined(ENGINE_SIMD_SSE)
+            inline __m128 clamp01(__m128 t)
+            {
+                return _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            }
+
+            inline __m128 slerpWeight(__m128 t, __m128 cosMinusOne)
+            {
+                __m128 t2 = _mm_mul_ps(t, t);
+                __m128 one = _mm_set1_ps(1.0f);
+                __m128 sum = one;
+                for (int i = SLERP_TERMS; i >= 1; --i)
+                {
+                    __m128 term = _mm_mul_ps(_mm_set1_ps(SLERP_COEFFICIENTS[i - 1]), _mm_sub_ps(t2, _mm_set1_ps(float(i * i))));
+                    sum = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(term, cosMinusOne), sum));
+                }
+                return _mm_mul_ps(t, sum);
+            }
+#endif
+
+            /**
+             * @brief Interpolates quaternions with factors read at t[i * tStride]
+             */
+            void interpolate(const QuaternionBatch &from, const QuaternionBatch &to, const float *t, size_t tStride,
+                             bool spherical, QuaternionBatch &out, size_t begin, size_t end)
+            {
+                end = clampEnd(end, std::min(from.size(), to.size()));
+                size_t i = begin;
+
+#if defined(ENGINE_SIMD_SSE)
+                const __m128 signMask = _mm_set1_ps(-0.0f);
+                for (; i + 4 <= end; i += 4)
+                {
+                    __m128 ax = _mm_loadu_ps(&from.x[i]), ay = _mm_loadu_ps(&from.y[i]);
+                    __m128 az = _mm_loadu_ps(&from.z[i]), aw = _mm_loadu_ps(&from.w[i]);
+                    __m128 bx = _mm_loadu_ps(&to.x[i]), by = _mm_loadu_ps(&to.y[i]);
+                    __m128 bz = _mm_loadu_ps(&to.z[i]), bw = _mm_loadu_ps(&to.w[i]);
+                    __m128 factor = clamp01(tStride ? _mm_loadu_ps(t + i) : _mm_set1_ps(t[0]));
+
+                    // Flip the target where needed to take the shortest path
+                    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                            _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+                    __m128 sign = _mm_and_ps(dot, signMask);
+                    bx = _mm_xor_ps(bx, sign);
+                    by = _mm_xor_ps(by, sign);
+                    bz = _mm_xor_ps(bz, sign);
+                    bw = _mm_xor_ps(bw, sign);
+
+                    __m128 weightA, weightB;
+                    if (spherical)
+                    {
+                        __m128 cosAngle = _mm_min_ps(_mm_andnot_ps(signMask, dot), _mm_set1_ps(1.0f));
+                        __m128 cosMinusOne = _mm_sub_ps(cosAngle, _mm_set1_ps(1.0f));
+                        weightA = slerpWeight(_mm_sub_ps(_mm_set1_ps(1.0f), factor), cosMinusOne);
+                        weightB = slerpWeight(factor, cosMinusOne);
+                    }
+                    else
+                    {
+                        weightA = _mm_sub_ps(_mm_set1_ps(1.0f), factor);
+                        weightB = factor;
+                    }
+
+                    __m128 rx = _mm_add_ps(_mm_mul_ps(ax, weightA), _mm_mul_ps(bx, weightB));
+                    __m128 ry = _mm_add_ps(_mm_mul_ps(ay, weightA), _mm_mul_ps(by, weightB));
+                    __m128 rz = _mm_add_ps(_mm_mul_ps(az, weightA), _mm_mul_ps(bz, weightB));
+                    __m128 rw = _mm_add_ps(_mm_mul_ps(aw, weightA), _mm_mul_ps(bw, weightB));
+
+                    // Lerp needs renormalizing; slerp of unit quaternions is already unit length
+                    if (!spherical)
+                    {
+                        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                                               _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw))));
+                        __m128 valid = _mm_cmpge_ps(length, _mm_set1_ps(EPSILON));
+                        __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(length, _mm_set1_ps(EPSILON)));
+                        rx = _mm_and_ps(_mm_mul_ps(rx, inverse), valid);
+                        ry = _mm_and_ps(_mm_mul_ps(ry, inverse), valid);
+                        rz = _mm_and_ps(_mm_mul_ps(rz, inverse), valid);
+                        rw = _mm_or_ps(_mm_and_ps(_mm_mul_ps(rw, inverse), valid), _mm_andnot_ps(valid, _mm_set1_ps(1.0f)));
+                    }
+
+                    _mm_storeu_ps(&out.x[i], rx);
+                    _mm_storeu_ps(&out.y[i], ry);
+                    _mm_storeu_ps(&out.z[i], rz);
+                    _mm_storeu_ps(&out.w[i], rw);
+                }
+#endif
+
+                for (; i < end; ++i)
+                {
+                    float factor = clamp01(t[i * tStride]);
+                    float bx = to.x[i], by = to.y[i], bz = to.z[i], bw = to.w[i];
+                    float dot = from.x[i] * bx + from.y[i] * by + from.z[i] * bz + from.w[i] * bw;
+                    if (dot < 0.0f)
+                    {
+                        bx = -bx, by = -by, bz = -bz, bw = -bw;
+                        dot = -dot;
+                    }
+
+                    float weightA = 1.0f - factor;
+                    float weightB = factor;
+                    if (spherical)
+                    {
+                        float cosMinusOne = std::min(dot, 1.0f) - 1.0f;
+                        weightA = slerpWeight(1.0f - factor, cosMinusOne);
+                        weightB = slerpWeight(factor, cosMinusOne);
+                    }
+
+                    float rx = from.x[i] * weightA + bx * weightB;
+                    float ry = from.y[i] * weightA + by * weightB;
+                    float rz = from.z[i] * weightA + bz * weightB;
+                    float rw = from.w[i] * weightA + bw * weightB;
+
+                    if (!spherical)
+                    {
+                        float length = std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+                        if (length < EPSILON)
+                        {
+                            rx = ry = rz = 0.0f;
+                            rw = length = 1.0f;
+                        }
+                        float inverse = 1.0f / length;
+                        rx *= inverse, ry *= inverse, rz *= inverse, rw *= inverse;
+                    }
+
+                    out.x[i] = rx;
+                    out.y[i] = ry;
+                    out.z[i] = rz;
+                    out.w[i] = rw;
+                }
+            }
+        }
+
+        void normalize(Vector3Batch &vectors, size_t begin, size_t end)
+        {
+            end = clampEnd(end, vectors.size());
+            float *xs = vectors.x.data();
+            float *ys = vectors.y.data();
+            float *zs = vectors.z.data();
+            size_t i = begin;
+
+#if defined(ENGINE_SIMD_SSE)
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+                __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+                // Zero vectors would divide by zero; mask them back to zero
+                __m128 valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+                __m128 inverse = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), length), valid);
+                _mm_storeu_ps(xs + i, _mm_mul_ps(x, inverse));
+                _mm_storeu_ps(ys + i, _mm_mul_ps(y, inverse));
+                _mm_storeu_ps(zs + i, _mm_mul_ps(z, inverse));
+            }
+#endif
+
+            for (; i < end; ++i)
+            {
+                float length = std::sqrt(xs[i] * xs[i] + ys[i] * ys[i] + zs[i] * zs[i]);
+                float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+                xs[i] *= inverse;
+                ys[i] *= inverse;
+                zs[i] *= inverse;
+            }
+        }
+
+        void normalize(QuaternionBatch &quaternions, size_t begin, size_t end)
+        {
+            // Interpolating with factor 0 and itself is a plain normalization
+            float zero = 0.0f;
+            interpolate(quaternions, quaternions, &zero, 0, false, quaternions, begin, end);
+        }
+
+        void nlerp(const QuaternionBatch &from, const QuaternionBatch &to, float t, QuaternionBatch &out,
+                   size_t begin, size_t end)
+        {
+            interpolate(from, to, &t, 0, false, out, begin, end);
+        }
+
+        void nlerp(const QuaternionBatch &from, const QuaternionBatch &to, const float *t, QuaternionBatch &out,
+                   size_t begin, size_t end)
+        {
+            interpolate(from, to, t, 1, false, out, begin, end);
+        }
+
+        void slerp(const QuaternionBatch &from, const QuaternionBatch &to, float t, QuaternionBatch &out,
+                   size_t begin, size_t end)
+        {
+            interpolate(from, to, &t, 0, true, out, begin, end);
+        }
+
+        void slerp(const QuaternionBatch &from, const QuaternionBatch &to, const float *t, QuaternionBatch &out,
+                   size_t begin, size_t end)
+        {
+            interpolate(from, to, t, 1, true, out, begin, end);
+        }
+
+        void composeTRS(const Vector3Batch &translations, const QuaternionBatch &rotations, const Vector3Batch &scales,
+                        Matrix4 *out, size_t begin, size_t end)
+        {
+            end = clampEnd(end, std::min(translations.size(), std::min(rotations.size(), scales.size())));
+            size_t i = begin;
+
+#if defined(ENGINE_SIMD_SSE)
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 two = _mm_set1_ps(2.0f);
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 qx = _mm_loadu_ps(&rotations.x[i]), qy = _mm_loadu_ps(&rotations.y[i]);
+                __m128 qz = _mm_loadu_ps(&rotations.z[i]), qw = _mm_loadu_ps(&rotations.w[i]);
+                __m128 sx = _mm_loadu_ps(&scales.x[i]), sy = _mm_loadu_ps(&scales.y[i]), sz = _mm_loadu_ps(&scales.z[i]);
+
+                __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+                __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+                __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+                // Rotation columns scaled by the scale factors, one lane per element
+                __m128 rows[3][4] = {
+                    {_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                     _mm_loadu_ps(&translations.x[i])},
+                    {_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                     _mm_loadu_ps(&translations.y[i])},
+                    {_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                     _mm_loadu_ps(&translations.z[i])}};
+
+                // Transpose each row from lanes into the four matrices
+                for (int row = 0; row < 3; ++row)
+                {
+                    __m128 e0 = rows[row][0], e1 = rows[row][1], e2 = rows[row][2], e3 = rows[row][3];
+                    _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+                    _mm_storeu_ps(out[i].getData() + row * 4, e0);
+                    _mm_storeu_ps(out[i + 1].getData() + row * 4, e1);
+                    _mm_storeu_ps(out[i + 2].getData() + row * 4, e2);
+                    _mm_storeu_ps(out[i + 3].getData() + row * 4, e3);
+                }
+
+                __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    _mm_storeu_ps(out[i + k].getData() + 12, lastRow);
+                }
+            }
+#endif
+
+            for (; i < end; ++i)
+            {
+                float qx = rotations.x[i], qy = rotations.y[i], qz = rotations.z[i], qw = rotations.w[i];
+                float sx = scales.x[i], sy = scales.y[i], sz = scales.z[i];
+
+                float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+                float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+                float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+                out[i] = Matrix4(
+                    (1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy - wz) * sy, 2.0f * (xz + wy) * sz, translations.x[i],
+                    2.0f * (xy + wz) * sx, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz - wx) * sz, translations.y[i],
+                    2.0f * (xz - wy) * sx, 2.0f * (yz + wx) * sy, (1.0f - 2.0f * (xx + yy)) * sz, translations.z[i],
+                    0.0f, 0.0f, 0.0f, 1.0f);
+            }
+        }
+
+    } // namespace MathBatch
+} // namespace Engine
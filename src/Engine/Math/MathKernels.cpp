@@ -0,0 +1,636 @@
+#include "Engine/Math/MathKernels.hpp"
+
+#include <cmath>
+
+#if defined(ENGINE_SIMD_SSE)
+#include <emmintrin.h>
+#if defined(ENGINE_SIMD_AVX)
+#include <immintrin.h>
+#endif
+#elif defined(ENGINE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Engine
+{
+    namespace MathKernels
+    {
+
+        namespace
+        {
+            /**
+             * @brief Determinant below which matrices count as singular
+             */
+            const float EPSILON = 1e-6f;
+
+            /**
+             * @brief Quaternion dot product above which slerp falls back to lerp
+             */
+            const float SLERP_THRESHOLD = 0.9995f;
+
+#if defined(ENGINE_SIMD_SSE)
+            /**
+             * @brief Sums the four lanes of a vector into every lane
+             */
+            inline __m128 horizontalSum(__m128 v)
+            {
+                __m128 pairs = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+            }
+
+            /**
+             * @brief Cross product of the xyz lanes; the w lane becomes 0
+             */
+            inline __m128 cross3(__m128 a, __m128 b)
+            {
+                __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+                __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+                __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+                return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+            }
+
+            /**
+             * @brief Multiplies two 2x2 matrices stored as (m00, m01, m10, m11)
+             */
+            inline __m128 mat2Mul(__m128 a, __m128 b)
+            {
+                return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                                  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+            }
+
+            /**
+             * @brief Computes adjugate(a) * b for 2x2 matrices
+             */
+            inline __m128 mat2AdjMul(__m128 a, __m128 b)
+            {
+                return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                                  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+            }
+
+            /**
+             * @brief Computes a * adjugate(b) for 2x2 matrices
+             */
+            inline __m128 mat2MulAdj(__m128 a, __m128 b)
+            {
+                return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                                  _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+            }
+#endif
+        }
+
+        const char *getInstructionSet()
+        {
+#if defined(ENGINE_SIMD_AVX)
+            return "AVX";
+#elif defined(ENGINE_SIMD_SSE)
+            return "SSE2";
+#elif defined(ENGINE_SIMD_NEON)
+            return "NEON";
+#else
+            return "Scalar";
+#endif
+        }
+
+        //-----------------------------------------------------------------------------------
+        // Matrix multiplication
+        //-----------------------------------------------------------------------------------
+
+        void multiplyMatrix4Scalar(const float *a, const float *b, float *out)
+        {
+            float result[16];
+            for (int row = 0; row < 4; ++row)
+            {
+                const float *r = a + row * 4;
+                for (int col = 0; col < 4; ++col)
+                {
+                    result[row * 4 + col] = r[0] * b[col] + r[1] * b[4 + col] + r[2] * b[8 + col] + r[3] * b[12 + col];
+                }
+            }
+
+            for (int i = 0; i < 16; ++i)
+            {
+                out[i] = result[i];
+            }
+        }
+
+        void multiplyMatrix4(const float *a, const float *b, float *out)
+        {
+#if defined(ENGINE_SIMD_AVX)
+            // Each result row is a combination of the rows of b; do two rows per register
+            __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+            __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+            __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+            __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+            __m256 a01 = _mm256_loadu_ps(a);
+            __m256 a23 = _mm256_loadu_ps(a + 8);
+
+            __m256 r01 = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0), _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2), _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3)));
+            __m256 r23 = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0), _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2), _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3)));
+
+            _mm256_storeu_ps(out, r01);
+            _mm256_storeu_ps(out + 8, r23);
+#elif defined(ENGINE_SIMD_SSE)
+            // Each result row is a combination of the rows of b
+            __m128 b0 = _mm_loadu_ps(b);
+            __m128 b1 = _mm_loadu_ps(b + 4);
+            __m128 b2 = _mm_loadu_ps(b + 8);
+            __m128 b3 = _mm_loadu_ps(b + 12);
+
+            __m128 rows[4];
+            for (int row = 0; row < 4; ++row)
+            {
+                const float *r = a + row * 4;
+                rows[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(r[0]), b0), _mm_mul_ps(_mm_set1_ps(r[1]), b1)),
+                                       _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r[2]), b2), _mm_mul_ps(_mm_set1_ps(r[3]), b3)));
+            }
+
+            for (int row = 0; row < 4; ++row)
+            {
+                _mm_storeu_ps(out + row * 4, rows[row]);
+            }
+#elif defined(ENGINE_SIMD_NEON)
+            float32x4_t b0 = vld1q_f32(b);
+            float32x4_t b1 = vld1q_f32(b + 4);
+            float32x4_t b2 = vld1q_f32(b + 8);
+            float32x4_t b3 = vld1q_f32(b + 12);
+
+            float32x4_t rows[4];
+            for (int row = 0; row < 4; ++row)
+            {
+                const float *r = a + row * 4;
+                float32x4_t sum = vmulq_n_f32(b0, r[0]);
+                sum = vmlaq_n_f32(sum, b1, r[1]);
+                sum = vmlaq_n_f32(sum, b2, r[2]);
+                rows[row] = vmlaq_n_f32(sum, b3, r[3]);
+            }
+
+            for (int row = 0; row < 4; ++row)
+            {
+                vst1q_f32(out + row * 4, rows[row]);
+            }
+#else
+            multiplyMatrix4Scalar(a, b, out);
+#endif
+        }
+
+        //-----------------------------------------------------------------------------------
+        // Vector transformation
+        //-----------------------------------------------------------------------------------
+
+        void transformVector4Scalar(const float *m, const float *v, float *out)
+        {
+            float x = v[0], y = v[1], z = v[2], w = v[3];
+            for (int row = 0; row < 4; ++row)
+            {
+                const float *r = m + row * 4;
+                out[row] = r[0] * x + r[1] * y + r[2] * z + r[3] * w;
+            }
+        }
+
+        void transformVector4(const float *m, const float *v, float *out)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            // Multiply every row by v, then transpose so one add sums each row
+            __m128 vec = _mm_loadu_ps(v);
+            __m128 p0 = _mm_mul_ps(_mm_loadu_ps(m), vec);
+            __m128 p1 = _mm_mul_ps(_mm_loadu_ps(m + 4), vec);
+            __m128 p2 = _mm_mul_ps(_mm_loadu_ps(m + 8), vec);
+            __m128 p3 = _mm_mul_ps(_mm_loadu_ps(m + 12), vec);
+            _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+            _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+#elif defined(ENGINE_SIMD_NEON)
+            // Deinterleaving load yields the columns
+            float32x4x4_t columns = vld4q_f32(m);
+            float32x4_t sum = vmulq_n_f32(columns.val[0], v[0]);
+            sum = vmlaq_n_f32(sum, columns.val[1], v[1]);
+            sum = vmlaq_n_f32(sum, columns.val[2], v[2]);
+            vst1q_f32(out, vmlaq_n_f32(sum, columns.val[3], v[3]));
+#else
+            transformVector4Scalar(m, v, out);
+#endif
+        }
+
+        void transformPointsScalar(const float *m, const float *points, float *out, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float *p = points + i * 3;
+                float x = p[0], y = p[1], z = p[2];
+                float *o = out + i * 3;
+                o[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+                o[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+                o[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+            }
+        }
+
+        void transformPoints(const float *m, const float *points, float *out, size_t count)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            // Columns of the upper 3x4 part, so every point costs three multiply-adds
+            __m128 c0 = _mm_setr_ps(m[0], m[4], m[8], 0.0f);
+            __m128 c1 = _mm_setr_ps(m[1], m[5], m[9], 0.0f);
+            __m128 c2 = _mm_setr_ps(m[2], m[6], m[10], 0.0f);
+            __m128 c3 = _mm_setr_ps(m[3], m[7], m[11], 0.0f);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float *p = points + i * 3;
+                __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+                                      _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+
+                // Store three lanes without writing past the point
+                float *o = out + i * 3;
+                _mm_storel_pi(reinterpret_cast<__m64 *>(o), r);
+                _mm_store_ss(o + 2, _mm_movehl_ps(r, r));
+            }
+#elif defined(ENGINE_SIMD_NEON)
+            float32x4x4_t columns = vld4q_f32(m);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float *p = points + i * 3;
+                float32x4_t r = vmlaq_n_f32(columns.val[3], columns.val[0], p[0]);
+                r = vmlaq_n_f32(r, columns.val[1], p[1]);
+                r = vmlaq_n_f32(r, columns.val[2], p[2]);
+
+                float *o = out + i * 3;
+                vst1_f32(o, vget_low_f32(r));
+                vst1q_lane_f32(o + 2, r, 2);
+            }
+#else
+            transformPointsScalar(m, points, out, count);
+#endif
+        }
+
+        //-----------------------------------------------------------------------------------
+        // Inversion
+        //-----------------------------------------------------------------------------------
+
+        bool inverseMatrix4Scalar(const float *m, float *out)
+        {
+            // Laplace expansion over the 2x2 minors of the upper and lower row pairs
+            float s0 = m[0] * m[5] - m[4] * m[1];
+            float s1 = m[0] * m[6] - m[4] * m[2];
+            float s2 = m[0] * m[7] - m[4] * m[3];
+            float s3 = m[1] * m[6] - m[5] * m[2];
+            float s4 = m[1] * m[7] - m[5] * m[3];
+            float s5 = m[2] * m[7] - m[6] * m[3];
+
+            float c5 = m[10] * m[15] - m[14] * m[11];
+            float c4 = m[9] * m[15] - m[13] * m[11];
+            float c3 = m[9] * m[14] - m[13] * m[10];
+            float c2 = m[8] * m[15] - m[12] * m[11];
+            float c1 = m[8] * m[14] - m[12] * m[10];
+            float c0 = m[8] * m[13] - m[12] * m[9];
+
+            float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if (std::abs(det) < EPSILON)
+            {
+                return false;
+            }
+
+            float inv = 1.0f / det;
+            float result[16] = {
+                (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv,
+                (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv,
+                (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv,
+                (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv,
+
+                (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv,
+                (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv,
+                (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv,
+                (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv,
+
+                (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv,
+                (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv,
+                (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv,
+                (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv,
+
+                (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv,
+                (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv,
+                (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv,
+                (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv};
+
+            for (int i = 0; i < 16; ++i)
+            {
+                out[i] = result[i];
+            }
+            return true;
+        }
+
+        bool inverseMatrix4(const float *m, float *out)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            // Block inversion over the four 2x2 sub-matrices
+            //     | A B |
+            // M = | C D |
+            __m128 row0 = _mm_loadu_ps(m);
+            __m128 row1 = _mm_loadu_ps(m + 4);
+            __m128 row2 = _mm_loadu_ps(m + 8);
+            __m128 row3 = _mm_loadu_ps(m + 12);
+
+            __m128 a = _mm_movelh_ps(row0, row1);
+            __m128 b = _mm_movehl_ps(row1, row0);
+            __m128 c = _mm_movelh_ps(row2, row3);
+            __m128 d = _mm_movehl_ps(row3, row2);
+
+            // Determinants of the sub-matrices as (|A|, |B|, |C|, |D|)
+            __m128 detSub = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+            __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128 dc = mat2AdjMul(d, c);
+            __m128 ab = mat2AdjMul(a, b);
+
+            // Adjugates of the inverse's blocks
+            __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+            __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+            __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+            __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+            // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+            __m128 trace = horizontalSum(_mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0))));
+            __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+            float det = _mm_cvtss_f32(detM);
+            if (std::abs(det) < EPSILON)
+            {
+                return false;
+            }
+
+            __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+            x = _mm_mul_ps(x, scale);
+            y = _mm_mul_ps(y, scale);
+            z = _mm_mul_ps(z, scale);
+            w = _mm_mul_ps(w, scale);
+
+            // Apply the final adjugate while storing
+            _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+            return true;
+#else
+            return inverseMatrix4Scalar(m, out);
+#endif
+        }
+
+        bool inverseAffineScalar(const float *m, float *out)
+        {
+            // Rows of the inverse 3x3 part are cross products of its columns
+            float i00 = m[5] * m[10] - m[9] * m[6];
+            float i01 = m[9] * m[2] - m[1] * m[10];
+            float i02 = m[1] * m[6] - m[5] * m[2];
+            float i10 = m[8] * m[6] - m[4] * m[10];
+            float i11 = m[0] * m[10] - m[8] * m[2];
+            float i12 = m[4] * m[2] - m[0] * m[6];
+            float i20 = m[4] * m[9] - m[8] * m[5];
+            float i21 = m[8] * m[1] - m[0] * m[9];
+            float i22 = m[0] * m[5] - m[4] * m[1];
+
+            float det = m[0] * i00 + m[4] * i01 + m[8] * i02;
+            if (std::abs(det) < EPSILON)
+            {
+                return false;
+            }
+
+            float inv = 1.0f / det;
+            i00 *= inv, i01 *= inv, i02 *= inv;
+            i10 *= inv, i11 *= inv, i12 *= inv;
+            i20 *= inv, i21 *= inv, i22 *= inv;
+
+            float tx = m[3], ty = m[7], tz = m[11];
+            float result[16] = {
+                i00, i01, i02, -(i00 * tx + i01 * ty + i02 * tz),
+                i10, i11, i12, -(i10 * tx + i11 * ty + i12 * tz),
+                i20, i21, i22, -(i20 * tx + i21 * ty + i22 * tz),
+                0.0f, 0.0f, 0.0f, 1.0f};
+
+            for (int i = 0; i < 16; ++i)
+            {
+                out[i] = result[i];
+            }
+            return true;
+        }
+
+        bool inverseAffine(const float *m, float *out)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            // Transposing the rows gives the columns of the 3x3 part and the translation
+            __m128 c0 = _mm_loadu_ps(m);
+            __m128 c1 = _mm_loadu_ps(m + 4);
+            __m128 c2 = _mm_loadu_ps(m + 8);
+            __m128 t = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+
+            // Rows of the inverse 3x3 part, w lanes are 0
+            __m128 i0 = cross3(c1, c2);
+            __m128 i1 = cross3(c2, c0);
+            __m128 i2 = cross3(c0, c1);
+
+            float det = _mm_cvtss_f32(horizontalSum(_mm_mul_ps(c0, i0)));
+            if (std::abs(det) < EPSILON)
+            {
+                return false;
+            }
+
+            __m128 inv = _mm_set1_ps(1.0f / det);
+            i0 = _mm_mul_ps(i0, inv);
+            i1 = _mm_mul_ps(i1, inv);
+            i2 = _mm_mul_ps(i2, inv);
+
+            // New translation is -R^-1 * t; the w lane of t is 1 but meets a 0
+            __m128 p0 = _mm_mul_ps(i0, t);
+            __m128 p1 = _mm_mul_ps(i1, t);
+            __m128 p2 = _mm_mul_ps(i2, t);
+            __m128 p3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+            __m128 translation = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+
+            float translated[4];
+            _mm_storeu_ps(translated, translation);
+
+            _mm_storeu_ps(out, i0);
+            _mm_storeu_ps(out + 4, i1);
+            _mm_storeu_ps(out + 8, i2);
+            _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+            out[3] = translated[0];
+            out[7] = translated[1];
+            out[11] = translated[2];
+            return true;
+#else
+            return inverseAffineScalar(m, out);
+#endif
+        }
+
+        //-----------------------------------------------------------------------------------
+        // Quaternions
+        //-----------------------------------------------------------------------------------
+
+        void multiplyQuaternionScalar(const float *a, const float *b, float *out)
+        {
+            float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+            float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+            float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+            float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+            out[3] = w;
+        }
+
+        void multiplyQuaternion(const float *a, const float *b, float *out)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            // aw * b + ax * (bw, -bz, by, -bx) + ay * (bz, bw, -bx, -by) + az * (-by, bx, bw, -bz)
+            __m128 qb = _mm_loadu_ps(b);
+            __m128 termW = _mm_mul_ps(_mm_set1_ps(a[3]), qb);
+            __m128 termX = _mm_mul_ps(_mm_set1_ps(a[0]), _mm_mul_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)));
+            __m128 termY = _mm_mul_ps(_mm_set1_ps(a[1]), _mm_mul_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)));
+            __m128 termZ = _mm_mul_ps(_mm_set1_ps(a[2]), _mm_mul_ps(_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)));
+            _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(termW, termX), _mm_add_ps(termY, termZ)));
+#elif defined(ENGINE_SIMD_NEON)
+            static const float signX[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+            static const float signY[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+            static const float signZ[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+
+            float32x4_t qb = vld1q_f32(b);
+            float32x4_t swapped = vrev64q_f32(qb);                // (by, bx, bw, bz)
+            float32x4_t reversed = vextq_f32(swapped, swapped, 2); // (bw, bz, by, bx)
+            float32x4_t rotated = vextq_f32(qb, qb, 2);            // (bz, bw, bx, by)
+
+            float32x4_t sum = vmulq_n_f32(qb, a[3]);
+            sum = vmlaq_n_f32(sum, vmulq_f32(reversed, vld1q_f32(signX)), a[0]);
+            sum = vmlaq_n_f32(sum, vmulq_f32(rotated, vld1q_f32(signY)), a[1]);
+            sum = vmlaq_n_f32(sum, vmulq_f32(swapped, vld1q_f32(signZ)), a[2]);
+            vst1q_f32(out, sum);
+#else
+            multiplyQuaternionScalar(a, b, out);
+#endif
+        }
+
+        void slerpQuaternionScalar(const float *a, const float *b, float t, float *out)
+        {
+            t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+
+            // Normalize both inputs; degenerate quaternions become the identity
+            float qa[4] = {a[0], a[1], a[2], a[3]};
+            float qb[4] = {b[0], b[1], b[2], b[3]};
+            float *inputs[2] = {qa, qb};
+            for (float *q : inputs)
+            {
+                float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                if (length < EPSILON)
+                {
+                    q[0] = q[1] = q[2] = 0.0f;
+                    q[3] = 1.0f;
+                    continue;
+                }
+                for (int i = 0; i < 4; ++i)
+                {
+                    q[i] /= length;
+                }
+            }
+
+            // Take the shortest path
+            float dot = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+            if (dot < 0.0f)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    qb[i] = -qb[i];
+                }
+                dot = -dot;
+            }
+
+            float factorA = 1.0f - t;
+            float factorB = t;
+            if (dot <= SLERP_THRESHOLD)
+            {
+                float angle = std::acos(dot);
+                float sinAngle = std::sin(angle);
+                factorA = std::sin((1.0f - t) * angle) / sinAngle;
+                factorB = std::sin(t * angle) / sinAngle;
+            }
+
+            float result[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                result[i] = qa[i] * factorA + qb[i] * factorB;
+            }
+
+            // Lerp needs renormalizing; slerp of unit quaternions is already unit length
+            float inv = 1.0f;
+            if (dot > SLERP_THRESHOLD)
+            {
+                float length = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2] + result[3] * result[3]);
+                if (length < EPSILON)
+                {
+                    result[0] = result[1] = result[2] = 0.0f;
+                    result[3] = 1.0f;
+                    length = 1.0f;
+                }
+                inv = 1.0f / length;
+            }
+
+            for (int i = 0; i < 4; ++i)
+            {
+                out[i] = result[i] * inv;
+            }
+        }
+
+        void slerpQuaternion(const float *a, const float *b, float t, float *out)
+        {
+#if defined(ENGINE_SIMD_SSE)
+            t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+
+            __m128 identity = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+            auto normalize = [&identity](__m128 q)
+            {
+                __m128 lengthSquared = horizontalSum(_mm_mul_ps(q, q));
+                float length = std::sqrt(_mm_cvtss_f32(lengthSquared));
+                return length < EPSILON ? identity : _mm_div_ps(q, _mm_set1_ps(length));
+            };
+
+            __m128 qa = normalize(_mm_loadu_ps(a));
+            __m128 qb = normalize(_mm_loadu_ps(b));
+
+            // Take the shortest path
+            float dot = _mm_cvtss_f32(horizontalSum(_mm_mul_ps(qa, qb)));
+            if (dot < 0.0f)
+            {
+                qb = _mm_sub_ps(_mm_setzero_ps(), qb);
+                dot = -dot;
+            }
+
+            // The trigonometry stays scalar; only the blend is vectorized
+            float factorA = 1.0f - t;
+            float factorB = t;
+            if (dot <= SLERP_THRESHOLD)
+            {
+                float angle = std::acos(dot);
+                float sinAngle = std::sin(angle);
+                factorA = std::sin((1.0f - t) * angle) / sinAngle;
+                factorB = std::sin(t * angle) / sinAngle;
+            }
+
+            __m128 result = _mm_add_ps(_mm_mul_ps(qa, _mm_set1_ps(factorA)), _mm_mul_ps(qb, _mm_set1_ps(factorB)));
+            if (dot > SLERP_THRESHOLD)
+            {
+                result = normalize(result);
+            }
+            _mm_storeu_ps(out, result);
+#else
+            slerpQuaternionScalar(a, b, t, out);
+#endif
+        }
+
+    } // namespace MathKernels
+} // namespace Engine
@@ -1,5 +1,6 @@
 #include "Engine/Math/Matrix.hpp"
 #include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/MathKernels.hpp"
 #include <cmath>
 
 namespace Engine
@@ -426,30 +427,39 @@ namespace Engine
     Matrix4 Matrix4::operator*(const Matrix4 &other) const
     {
         Matrix4 result;
-
-        for (int row = 0; row < 4; ++row)
-        {
-            for (int col = 0; col < 4; ++col)
-            {
-                float sum = 0.0f;
-                for (int i = 0; i < 4; ++i)
-                {
-                    sum += get(row, i) * other.get(i, col);
-                }
-                result.set(row, col, sum);
-            }
-        }
-
+        MathKernels::multiplyMatrix4(data.data(), other.data.data(), result.data.data());
         return result;
     }
 
     Vector4 Matrix4::operator*(const Vector4 &vec) const
     {
-        return Vector4(
-            get(0, 0) * vec.x + get(0, 1) * vec.y + get(0, 2) * vec.z + get(0, 3) * vec.w,
-            get(1, 0) * vec.x + get(1, 1) * vec.y + get(1, 2) * vec.z + get(1, 3) * vec.w,
-            get(2, 0) * vec.x + get(2, 1) * vec.y + get(2, 2) * vec.z + get(2, 3) * vec.w,
-            get(3, 0) * vec.x + get(3, 1) * vec.y + get(3, 2) * vec.z + get(3, 3) * vec.w);
+        float in[4] = {vec.x, vec.y, vec.z, vec.w};
+        float out[4];
+        MathKernels::transformVector4(data.data(), in, out);
+        return Vector4(out[0], out[1], out[2], out[3]);
+    }
+
+    Vector3 Matrix4::transformPoint(const Vector3 &point) const
+    {
+        return Vector3(
+            get(0, 0) * point.x + get(0, 1) * point.y + get(0, 2) * point.z + get(0, 3),
+            get(1, 0) * point.x + get(1, 1) * point.y + get(1, 2) * point.z + get(1, 3),
+            get(2, 0) * point.x + get(2, 1) * point.y + get(2, 2) * point.z + get(2, 3));
+    }
+
+    Vector3 Matrix4::transformDirection(const Vector3 &direction) const
+    {
+        return Vector3(
+            get(0, 0) * direction.x + get(0, 1) * direction.y + get(0, 2) * direction.z,
+            get(1, 0) * direction.x + get(1, 1) * direction.y + get(1, 2) * direction.z,
+            get(2, 0) * direction.x + get(2, 1) * direction.y + get(2, 2) * direction.z);
+    }
+
+    void Matrix4::transformPoints(const Vector3 *points, Vector3 *out, size_t count) const
+    {
+        // Vector3 is three packed floats, so the kernel can walk the arrays directly
+        static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats");
+        MathKernels::transformPoints(data.data(), &points->x, &out->x, count);
     }
 
     Matrix4 Matrix4::operator*(float scalar) const
@@ -560,45 +570,21 @@ namespace Engine
 
     Matrix4 Matrix4::inverse() const
     {
-        // Calculate determinant
-        float det = determinant();
-
-        // Check if matrix is invertible
-        if (std::abs(det) < EPSILON)
+        Matrix4 result;
+        if (!MathKernels::inverseMatrix4(data.data(), result.data.data()))
         {
             return Matrix4::identity(); // Return identity if not invertible
         }
 
-        float invDet = 1.0f / det;
+        return result;
+    }
 
+    Matrix4 Matrix4::inverseAffine() const
+    {
         Matrix4 result;
-
-        // Calculate cofactors and adjugate
-        for (int row = 0; row < 4; ++row)
+        if (!MathKernels::inverseAffine(data.data(), result.data.data()))
         {
-            for (int col = 0; col < 4; ++col)
-            {
-                // Calculate minor
-                float minor = 0.0f;
-
-                int r1 = (row + 1) % 4;
-                int r2 = (row + 2) % 4;
-                int r3 = (row + 3) % 4;
-
-                int c1 = (col + 1) % 4;
-                int c2 = (col + 2) % 4;
-                int c3 = (col + 3) % 4;
-
-                minor = get(r1, c1) * (get(r2, c2) * get(r3, c3) - get(r2, c3) * get(r3, c2)) -
-                        get(r1, c2) * (get(r2, c1) * get(r3, c3) - get(r2, c3) * get(r3, c1)) +
-                        get(r1, c3) * (get(r2, c1) * get(r3, c2) - get(r2, c2) * get(r3, c1));
-
-                // Calculate cofactor (apply sign)
-                float cofactor = ((row + col) % 2 == 0) ? minor : -minor;
-
-                // Set value in adjugate (transposed cofactor matrix)
-                result.set(col, row, cofactor * invDet);
-            }
+            return Matrix4::identity(); // Return identity if not invertible
         }
 
         return result;
@@ -628,9 +614,9 @@ namespace Engine
             0.0f, 0.0f, 0.0f, 1.0f);
     }
 
-    Matrix4 Matrix4::translation(const Vector3 &translation)
+    Matrix4 Matrix4::translation(const Vector3 &offset)
     {
-        return translation(translation.x, translation.y, translation.z);
+        return translation(offset.x, offset.y, offset.z);
     }
 
     Matrix4 Matrix4::translation(float x, float y, float z)
@@ -1,5 +1,6 @@
 #include "Engine/Math/Quaternion.hpp"
 #include "Engine/Math/Matrix.hpp"
+#include "Engine/Math/MathKernels.hpp"
 #include <cmath>
 
 namespace Engine
@@ -38,11 +39,11 @@ namespace Engine
     Quaternion Quaternion::operator*(const Quaternion &other) const
     {
         // Hamilton product
-        return Quaternion(
-            w * other.x + x * other.w + y * other.z - z * other.y,
-            w * other.y - x * other.z + y * other.w + z * other.x,
-            w * other.z + x * other.y - y * other.x + z * other.w,
-            w * other.w - x * other.x - y * other.y - z * other.z);
+        float a[4] = {x, y, z, w};
+        float b[4] = {other.x, other.y, other.z, other.w};
+        float out[4];
+        MathKernels::multiplyQuaternion(a, b, out);
+        return Quaternion(out[0], out[1], out[2], out[3]);
     }
 
     Quaternion Quaternion::operator*(float scalar) const
@@ -81,17 +82,7 @@ namespace Engine
 
     Quaternion &Quaternion::operator*=(const Quaternion &other)
     {
-        // Hamilton product
-        float newX = w * other.x + x * other.w + y * other.z - z * other.y;
-        float newY = w * other.y - x * other.z + y * other.w + z * other.x;
-        float newZ = w * other.z + x * other.y - y * other.x + z * other.w;
-        float newW = w * other.w - x * other.x - y * other.y - z * other.z;
-
-        x = newX;
-        y = newY;
-        z = newZ;
-        w = newW;
-
+        *this = (*this) * other;
         return *this;
     }
 
@@ -454,43 +445,12 @@ namespace Engine
 
     Quaternion Quaternion::slerp(const Quaternion &a, const Quaternion &b, float t)
     {
-        // Clamp t between 0 and 1
-        t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
-
-        // Normalized quaternions
-        Quaternion qa = a.normalized();
-        Quaternion qb = b.normalized();
-
-        // Calculate dot product
-        float dot = qa.dot(qb);
-
-        // If dot is negative, invert one quaternion to take the shortest path
-        if (dot < 0.0f)
-        {
-            qb = -qb;
-            dot = -dot;
-        }
-
-        // If quaternions are very close, use linear interpolation
-        if (dot > 0.9995f)
-        {
-            return Quaternion::lerp(qa, qb, t).normalized();
-        }
-
-        // Calculate angle and sin
-        float angle = std::acos(dot);
-        float sinAngle = std::sin(angle);
-
-        // Calculate factors
-        float factorA = std::sin((1.0f - t) * angle) / sinAngle;
-        float factorB = std::sin(t * angle) / sinAngle;
-
-        // Interpolate
-        return Quaternion(
-            qa.x * factorA + qb.x * factorB,
-            qa.y * factorA + qb.y * factorB,
-            qa.z * factorA + qb.z * factorB,
-            qa.w * factorA + qb.w * factorB);
+        // Normalizes, takes the shortest path, and falls back to lerp for close inputs
+        float qa[4] = {a.x, a.y, a.z, a.w};
+        float qb[4] = {b.x, b.y, b.z, b.w};
+        float out[4];
+        MathKernels::slerpQuaternion(qa, qb, t, out);
+        return Quaternion(out[0], out[1], out[2], out[3]);
     }
 
     Quaternion Quaternion::lerp(const Quaternion &a, const Quaternion &b, float t)
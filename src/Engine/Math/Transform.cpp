@@ -1,34 +1,88 @@
 #include "Engine/Math/Transform.hpp"
+#include "Engine/Math/TransformHierarchy.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Source of the versions of all transforms
+         */
+        std::atomic<uint64_t> versionCounter(1);
+
+        /**
+         * @brief Takes the next version
+         * @return Version larger than every version handed out before
+         */
+        uint64_t nextVersion()
+        {
+            return versionCounter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
     Transform::Transform()
         : position(Vector3::Zero),
           rotation(Vector3::Zero),
-          scale(Vector3::One),
+          localScale(Vector3::One),
+          previousPosition(Vector3::Zero),
+          previousRotation(Vector3::Zero),
+          previousScale(Vector3::One),
+          interpolated(true),
+          version(0),
           parent(nullptr),
           dirtyLocalMatrix(true),
-          dirtyWorldMatrix(true)
+          dirtyWorldMatrix(true),
+          worldVersion(0)
     {
     }
 
     Transform::Transform(const Vector3 &position, const Vector3 &rotation, const Vector3 &scale)
         : position(position),
           rotation(rotation),
-          scale(scale),
+          localScale(scale),
+          previousPosition(position),
+          previousRotation(rotation),
+          previousScale(scale),
+          interpolated(true),
+          version(0),
           parent(nullptr),
           dirtyLocalMatrix(true),
-          dirtyWorldMatrix(true)
+          dirtyWorldMatrix(true),
+          worldVersion(0)
     {
     }
 
+    Transform &Transform::operator=(const Transform &other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        position = other.position;
+        rotation = other.rotation;
+        localScale = other.localScale;
+        previousPosition = other.previousPosition;
+        previousRotation = other.previousRotation;
+        previousScale = other.previousScale;
+        interpolated = other.interpolated;
+        version = nextVersion();
+        dirtyLocalMatrix = true;
+        dirtyWorldMatrix = true;
+        setParent(other.parent);
+        return *this;
+    }
+
     void Transform::setPosition(const Vector3 &position)
     {
         this->position = position;
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::setPosition(float x, float y, float z)
@@ -41,6 +95,7 @@ namespace Engine
         this->rotation = rotation;
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::setRotation(float x, float y, float z)
@@ -54,6 +109,7 @@ namespace Engine
         rotation = quaternion.toEulerAnglesDegrees();
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     Quaternion Transform::getRotationQuaternion() const
@@ -64,9 +120,10 @@ namespace Engine
 
     void Transform::setScale(const Vector3 &scale)
     {
-        this->scale = scale;
+        localScale = scale;
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::setScale(float x, float y, float z)
@@ -84,6 +141,7 @@ namespace Engine
         position += translation;
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::translate(float x, float y, float z)
@@ -96,6 +154,7 @@ namespace Engine
         this->rotation += rotation;
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::rotate(float x, float y, float z)
@@ -105,12 +164,13 @@ namespace Engine
 
     void Transform::scale(const Vector3 &scaling)
     {
-        this->scale = Vector3(
-            this->scale.x * scaling.x,
-            this->scale.y * scaling.y,
-            this->scale.z * scaling.z);
+        localScale = Vector3(
+            localScale.x * scaling.x,
+            localScale.y * scaling.y,
+            localScale.z * scaling.z);
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     void Transform::scale(float x, float y, float z)
@@ -164,7 +224,7 @@ namespace Engine
                 rotation.z * 0.01745329252f);
 
             // Create scale matrix
-            Matrix4 scaleMatrix = Matrix4::scaling(scale);
+            Matrix4 scaleMatrix = Matrix4::scaling(localScale);
 
             // Combine matrices: translation * rotation * scale
             localMatrix = translationMatrix * rotationMatrix * scaleMatrix;
@@ -177,7 +237,10 @@ namespace Engine
 
     Matrix4 Transform::getWorldMatrix() const
     {
-        if (dirtyWorldMatrix)
+        // Parents don't know their children, so compare versions to notice
+        // that an ancestor moved
+        uint64_t currentVersion = getWorldVersion();
+        if (dirtyWorldMatrix || worldVersion != currentVersion)
         {
             if (parent)
             {
@@ -190,12 +253,20 @@ namespace Engine
                 worldMatrix = getLocalMatrix();
             }
 
+            worldVersion = currentVersion;
             dirtyWorldMatrix = false;
         }
 
         return worldMatrix;
     }
 
+    void Transform::storeWorldMatrix(const Matrix4 &matrix, uint64_t matrixVersion) const
+    {
+        worldMatrix = matrix;
+        worldVersion = matrixVersion;
+        dirtyWorldMatrix = false;
+    }
+
     void Transform::setParent(Transform *parent)
     {
         // Skip if parent is already set
@@ -206,16 +277,24 @@ namespace Engine
 
         this->parent = parent;
         dirtyWorldMatrix = true;
+        version = nextVersion();
+
+        if (link.hierarchy)
+        {
+            link.hierarchy->onParentChanged(this);
+        }
     }
 
     void Transform::reset()
     {
         position = Vector3::Zero;
         rotation = Vector3::Zero;
-        scale = Vector3::One;
-        parent = nullptr;
+        localScale = Vector3::One;
+        storePreviousState();
+        setParent(nullptr);
         dirtyLocalMatrix = true;
         dirtyWorldMatrix = true;
+        version = nextVersion();
     }
 
     Transform Transform::lerp(const Transform &other, float t) const
@@ -233,9 +312,65 @@ namespace Engine
         Vector3 newRotation = newRotationQuat.toEulerAnglesDegrees();
 
         // Interpolate scale
-        Vector3 newScale = scale.lerp(other.scale, t);
+        Vector3 newScale = localScale.lerp(other.localScale, t);
 
         return Transform(newPosition, newRotation, newScale);
     }
 
+    void Transform::storePreviousState()
+    {
+        previousPosition = position;
+        previousRotation = rotation;
+        previousScale = localScale;
+    }
+
+    uint64_t Transform::getWorldVersion() const
+    {
+        // Every change takes a version larger than all others, so the largest
+        // one in the chain grows whenever anything in the chain changes
+        uint64_t latest = version;
+        for (const Transform *ancestor = parent; ancestor; ancestor = ancestor->parent)
+        {
+            latest = std::max(latest, ancestor->version);
+        }
+        return latest;
+    }
+
+    Matrix4 Transform::getInterpolatedLocalMatrix(float alpha) const
+    {
+        // Most transforms do not move, so reuse the cached matrix for them
+        if (!interpolated || alpha >= 1.0f || isAtPreviousState())
+        {
+            return getLocalMatrix();
+        }
+
+        alpha = alpha < 0.0f ? 0.0f : alpha;
+
+        // Interpolate through quaternions to avoid Euler angle wrap-around;
+        // Matrix4::rotation uses the same Z * Y * X order as the quaternion
+        Quaternion q1 = Quaternion::fromEulerAnglesDegrees(previousRotation);
+        Quaternion q2 = getRotationQuaternion();
+
+        return Matrix4::translation(previousPosition.lerp(position, alpha)) *
+               Matrix4::rotation(Quaternion::slerp(q1, q2, alpha)) *
+               Matrix4::scaling(previousScale.lerp(localScale, alpha));
+    }
+
+    Matrix4 Transform::getInterpolatedWorldMatrix(float alpha) const
+    {
+        if (parent)
+        {
+            return parent->getInterpolatedWorldMatrix(alpha) * getInterpolatedLocalMatrix(alpha);
+        }
+
+        return getInterpolatedLocalMatrix(alpha);
+    }
+
+    bool Transform::isAtPreviousState() const
+    {
+        return position.x == previousPosition.x && position.y == previousPosition.y && position.z == previousPosition.z &&
+               rotation.x == previousRotation.x && rotation.y == previousRotation.y && rotation.z == previousRotation.z &&
+               localScale.x == previousScale.x && localScale.y == previousScale.y && localScale.z == previousScale.z;
+    }
+
 } // namespace Engine
\ No newline at end of file
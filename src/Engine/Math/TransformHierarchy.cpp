@@ -0,0 +1,437 @@
+#include "Engine/Math/TransformHierarchy.hpp"
+#include "Engine/Math/Transform.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+
+namespace Engine
+{
+
+    TransformHierarchy::TransformHierarchy()
+        : nodeCount(0), orderDirty(false), updatedCount(0)
+    {
+    }
+
+    void TransformHierarchy::add(Transform *transform)
+    {
+        if (!transform || transform->link.hierarchy == this)
+        {
+            return;
+        }
+        if (transform->link.hierarchy)
+        {
+            Logger::error("TransformHierarchy: transform is already registered in another hierarchy");
+            return;
+        }
+
+        uint32_t node;
+        if (!freeNodes.empty())
+        {
+            node = freeNodes.back();
+            freeNodes.pop_back();
+            nodes[node] = Node();
+        }
+        else
+        {
+            node = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        nodes[node].transform = transform;
+        transform->link.hierarchy = this;
+        transform->link.node = node;
+        ++nodeCount;
+        attach(node);
+
+        // Children registered before their parent become its children now
+        bool adopted = false;
+        for (size_t i = 0; i < externalChildren.size();)
+        {
+            uint32_t child = externalChildren[i];
+            if (nodes[child].transform->getParent() != transform)
+            {
+                ++i;
+                continue;
+            }
+
+            externalChildren[i] = externalChildren.back();
+            externalChildren.pop_back();
+            nodes[child].external = false;
+            attachChild(child, node);
+            adopted = true;
+        }
+
+        // Transforms usually start without a parent, so append them as a new
+        // root instead of rebuilding the order
+        if (orderDirty || adopted || transform->getParent())
+        {
+            orderDirty = true;
+            return;
+        }
+
+        uint32_t index = static_cast<uint32_t>(transforms.size());
+        uint64_t version = transform->getVersion();
+        nodes[node].order = static_cast<int32_t>(index);
+        transforms.push_back(transform);
+        parents.push_back(-1);
+        subtreeEnds.push_back(index + 1);
+        localVersions.push_back(version);
+        worldVersions.push_back(version);
+        parentVersions.push_back(0);
+        changed.push_back(1);
+        localMatrices.push_back(transform->getLocalMatrix());
+        worldMatrices.push_back(localMatrices.back());
+        roots.push_back(index);
+
+        transform->storeWorldMatrix(worldMatrices.back(), version);
+    }
+
+    void TransformHierarchy::remove(Transform *transform)
+    {
+        if (!transform || transform->link.hierarchy != this)
+        {
+            return;
+        }
+
+        // Detach the children before the parent goes away, each of which
+        // unlinks itself through onParentChanged()
+        uint32_t node = transform->link.node;
+        while (nodes[node].firstChild != -1)
+        {
+            nodes[nodes[node].firstChild].transform->setParent(nullptr);
+        }
+
+        detach(node);
+        nodes[node] = Node();
+        freeNodes.push_back(node);
+        --nodeCount;
+        transform->link.hierarchy = nullptr;
+        transform->link.node = 0;
+
+        orderDirty = true;
+    }
+
+    void TransformHierarchy::reserve(size_t count)
+    {
+        nodes.reserve(count);
+        transforms.reserve(count);
+        parents.reserve(count);
+        subtreeEnds.reserve(count);
+        localVersions.reserve(count);
+        worldVersions.reserve(count);
+        parentVersions.reserve(count);
+        changed.reserve(count);
+        localMatrices.reserve(count);
+        worldMatrices.reserve(count);
+    }
+
+    void TransformHierarchy::clear()
+    {
+        for (const Node &node : nodes)
+        {
+            if (node.transform)
+            {
+                node.transform->link.hierarchy = nullptr;
+                node.transform->link.node = 0;
+            }
+        }
+
+        nodes.clear();
+        freeNodes.clear();
+        nodeCount = 0;
+        externalChildren.clear();
+        transforms.clear();
+        parents.clear();
+        subtreeEnds.clear();
+        localVersions.clear();
+        worldVersions.clear();
+        parentVersions.clear();
+        changed.clear();
+        localMatrices.clear();
+        worldMatrices.clear();
+        externalRoots.clear();
+        roots.clear();
+        orderDirty = false;
+        updatedCount = 0;
+    }
+
+    void TransformHierarchy::update(JobSystem *jobSystem)
+    {
+        if (orderDirty)
+        {
+            rebuildOrder();
+        }
+
+        // Root subtrees are contiguous and never touch each other
+        updatedCount = 0;
+        if (jobSystem && transforms.size() >= ParallelThreshold && roots.size() > 1)
+        {
+            std::atomic<size_t> updated(0);
+            jobSystem->parallelFor(roots.size(), [this, &updated](size_t begin, size_t end)
+                                   {
+                size_t count = 0;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    count += updateRange(roots[i], subtreeEnds[roots[i]]);
+                }
+                updated.fetch_add(count, std::memory_order_relaxed); });
+            updatedCount = updated.load();
+        }
+        else
+        {
+            for (uint32_t root : roots)
+            {
+                updatedCount += updateRange(root, subtreeEnds[root]);
+            }
+        }
+
+        // Parents outside the hierarchy update lazily, which is not thread safe
+        for (uint32_t root : externalRoots)
+        {
+            updatedCount += updateRange(root, subtreeEnds[root]);
+        }
+    }
+
+    void TransformHierarchy::onParentChanged(Transform *transform)
+    {
+        uint32_t node = transform->link.node;
+        detach(node);
+        attach(node);
+        orderDirty = true;
+    }
+
+    void TransformHierarchy::attach(uint32_t node)
+    {
+        Transform *parent = nodes[node].transform->getParent();
+        if (!parent)
+        {
+            return;
+        }
+
+        if (parent->link.hierarchy == this)
+        {
+            attachChild(node, parent->link.node);
+        }
+        else
+        {
+            nodes[node].external = true;
+            externalChildren.push_back(node);
+        }
+    }
+
+    void TransformHierarchy::attachChild(uint32_t node, uint32_t parent)
+    {
+        Node &child = nodes[node];
+        child.parent = static_cast<int32_t>(parent);
+        child.previousSibling = -1;
+        child.nextSibling = nodes[parent].firstChild;
+        if (child.nextSibling != -1)
+        {
+            nodes[child.nextSibling].previousSibling = static_cast<int32_t>(node);
+        }
+        nodes[parent].firstChild = static_cast<int32_t>(node);
+    }
+
+    void TransformHierarchy::detach(uint32_t node)
+    {
+        Node &child = nodes[node];
+        if (child.external)
+        {
+            auto it = std::find(externalChildren.begin(), externalChildren.end(), node);
+            if (it != externalChildren.end())
+            {
+                *it = externalChildren.back();
+                externalChildren.pop_back();
+            }
+            child.external = false;
+            return;
+        }
+
+        if (child.parent == -1)
+        {
+            return;
+        }
+
+        if (child.previousSibling != -1)
+        {
+            nodes[child.previousSibling].nextSibling = child.nextSibling;
+        }
+        else
+        {
+            nodes[child.parent].firstChild = child.nextSibling;
+        }
+        if (child.nextSibling != -1)
+        {
+            nodes[child.nextSibling].previousSibling = child.previousSibling;
+        }
+
+        child.parent = -1;
+        child.nextSibling = -1;
+        child.previousSibling = -1;
+    }
+
+    void TransformHierarchy::rebuildOrder()
+    {
+        // Depth-first order, so that every subtree is one contiguous range
+        std::vector<uint32_t> order;
+        std::vector<int32_t> orderParents;
+        std::vector<std::pair<uint32_t, int32_t>> stack;
+        order.reserve(nodeCount);
+        orderParents.reserve(nodeCount);
+        roots.clear();
+        externalRoots.clear();
+        for (uint32_t root = 0; root < nodes.size(); ++root)
+        {
+            if (!nodes[root].transform || nodes[root].parent != -1)
+            {
+                continue;
+            }
+
+            (nodes[root].external ? externalRoots : roots).push_back(static_cast<uint32_t>(order.size()));
+
+            stack.emplace_back(root, -1);
+            while (!stack.empty())
+            {
+                std::pair<uint32_t, int32_t> entry = stack.back();
+                stack.pop_back();
+
+                int32_t index = static_cast<int32_t>(order.size());
+                order.push_back(entry.first);
+                orderParents.push_back(entry.second);
+
+                for (int32_t child = nodes[entry.first].firstChild; child != -1; child = nodes[child].nextSibling)
+                {
+                    stack.emplace_back(static_cast<uint32_t>(child), index);
+                }
+            }
+        }
+
+        if (order.size() != nodeCount)
+        {
+            Logger::error("TransformHierarchy: " + std::to_string(nodeCount - order.size()) +
+                          " transforms are part of a parent cycle and were skipped");
+        }
+
+        // Carry the caches over to the new positions, so that only the
+        // transforms that changed are recomputed
+        size_t ordered = order.size();
+        std::vector<Transform *> orderedTransforms(ordered);
+        std::vector<uint64_t> orderedLocalVersions(ordered, NotComputed);
+        std::vector<uint64_t> orderedWorldVersions(ordered, 0);
+        std::vector<uint64_t> orderedParentVersions(ordered, 0);
+        std::vector<Matrix4> orderedLocalMatrices(ordered);
+        std::vector<Matrix4> orderedWorldMatrices(ordered);
+        for (size_t i = 0; i < ordered; ++i)
+        {
+            const Node &node = nodes[order[i]];
+            orderedTransforms[i] = node.transform;
+            if (node.order >= 0)
+            {
+                orderedLocalVersions[i] = localVersions[node.order];
+                orderedWorldVersions[i] = worldVersions[node.order];
+                orderedParentVersions[i] = parentVersions[node.order];
+                orderedLocalMatrices[i] = localMatrices[node.order];
+                orderedWorldMatrices[i] = worldMatrices[node.order];
+            }
+        }
+
+        // Transforms in a parent cycle have no position until it is broken
+        for (Node &node : nodes)
+        {
+            node.order = -1;
+        }
+        for (size_t i = 0; i < ordered; ++i)
+        {
+            nodes[order[i]].order = static_cast<int32_t>(i);
+        }
+
+        transforms = std::move(orderedTransforms);
+        parents = std::move(orderParents);
+        localVersions = std::move(orderedLocalVersions);
+        worldVersions = std::move(orderedWorldVersions);
+        parentVersions = std::move(orderedParentVersions);
+        localMatrices = std::move(orderedLocalMatrices);
+        worldMatrices = std::move(orderedWorldMatrices);
+        changed.assign(ordered, 0);
+
+        // Every subtree ends where the last subtree of its children ends
+        subtreeEnds.resize(ordered);
+        for (size_t i = 0; i < ordered; ++i)
+        {
+            subtreeEnds[i] = static_cast<uint32_t>(i + 1);
+        }
+        for (size_t i = ordered; i-- > 0;)
+        {
+            if (parents[i] >= 0)
+            {
+                subtreeEnds[parents[i]] = std::max(subtreeEnds[parents[i]], subtreeEnds[i]);
+            }
+        }
+
+        orderDirty = false;
+    }
+
+    size_t TransformHierarchy::updateRange(size_t begin, size_t end)
+    {
+        size_t updated = 0;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            Transform *transform = transforms[i];
+            int32_t parent = parents[i];
+            const Transform *externalParent = parent < 0 ? transform->getParent() : nullptr;
+            uint64_t version = transform->getVersion();
+
+            // Parents come first, so their change flags are already final
+            uint64_t parentVersion = 0;
+            bool parentChanged = false;
+            if (parent >= 0)
+            {
+                parentVersion = worldVersions[parent];
+                parentChanged = changed[parent] != 0;
+            }
+            else if (externalParent)
+            {
+                parentVersion = externalParent->getWorldVersion();
+                parentChanged = parentVersions[i] != parentVersion;
+            }
+
+            bool localChanged = version != localVersions[i];
+            changed[i] = localChanged || parentChanged;
+            if (!changed[i])
+            {
+                continue;
+            }
+
+            if (localChanged)
+            {
+                localMatrices[i] = transform->getLocalMatrix();
+                localVersions[i] = version;
+            }
+
+            if (parent >= 0)
+            {
+                worldMatrices[i] = worldMatrices[parent] * localMatrices[i];
+            }
+            else if (externalParent)
+            {
+                worldMatrices[i] = externalParent->getWorldMatrix() * localMatrices[i];
+            }
+            else
+            {
+                worldMatrices[i] = localMatrices[i];
+            }
+
+            worldVersions[i] = std::max(version, parentVersion);
+            parentVersions[i] = parentVersion;
+            transform->storeWorldMatrix(worldMatrices[i], worldVersions[i]);
+            ++updated;
+        }
+
+        return updated;
+    }
+
+} // namespace Engine
@@ -0,0 +1,206 @@
+#include "Engine/Renderer/FramePipeline.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Window.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Engine
+{
+
+    FramePipeline::FramePipeline(Renderer &renderer)
+        : renderer(renderer),
+          writeSlot(-1),
+          running(false),
+          frameCounter(0),
+          lastWaitTime(0.0f)
+    {
+    }
+
+    FramePipeline::~FramePipeline()
+    {
+        shutdown();
+    }
+
+    bool FramePipeline::initialize(int framesInFlight)
+    {
+        if (running)
+        {
+            Logger::warning("Frame pipeline already initialized");
+            return true;
+        }
+
+        Window *window = renderer.getWindow();
+        if (!window)
+        {
+            Logger::error("Cannot start frame pipeline: Renderer has no window");
+            return false;
+        }
+
+        int count = std::max(2, std::min(framesInFlight, 3));
+        snapshots.clear();
+        freeSlots.clear();
+        readySlots.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            snapshots.push_back(std::make_unique<RenderSnapshot>());
+            freeSlots.push_back(static_cast<size_t>(i));
+        }
+
+        // The render thread takes over the graphics context
+        window->releaseContext();
+        running = true;
+        thread = std::thread(&FramePipeline::renderLoop, this);
+
+        Logger::info("Frame pipeline started with " + std::to_string(count) + " frames in flight");
+        return true;
+    }
+
+    void FramePipeline::shutdown()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        readyCondition.notify_one();
+
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+
+        // Work queued after the render thread stopped still needs the context
+        Window *window = renderer.getWindow();
+        if (window)
+        {
+            window->makeContextCurrent();
+        }
+        runCommands(commands);
+
+        freeSlots.clear();
+        readySlots.clear();
+        snapshots.clear();
+        writeSlot = -1;
+
+        Logger::info("Frame pipeline stopped");
+    }
+
+    RenderSnapshot &FramePipeline::beginSnapshot()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        freeCondition.wait(lock, [this]()
+                           { return !freeSlots.empty(); });
+
+        writeSlot = static_cast<int>(freeSlots.front());
+        freeSlots.pop_front();
+        lock.unlock();
+
+        lastWaitTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+
+        RenderSnapshot &snapshot = *snapshots[writeSlot];
+        snapshot.clear();
+        snapshot.frameIndex = frameCounter++;
+        return snapshot;
+    }
+
+    void FramePipeline::submitSnapshot()
+    {
+        if (writeSlot < 0)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            readySlots.push_back(static_cast<size_t>(writeSlot));
+            writeSlot = -1;
+        }
+        readyCondition.notify_one();
+    }
+
+    void FramePipeline::runOnRenderThread(std::function<void()> command)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            commands.push_back(std::move(command));
+        }
+        readyCondition.notify_one();
+    }
+
+    void FramePipeline::renderLoop()
+    {
+        Window *window = renderer.getWindow();
+        window->makeContextCurrent();
+        Profiler::setThreadName("Render");
+
+        std::vector<std::function<void()>> pending;
+        while (true)
+        {
+            size_t slot;
+            bool hasFrame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                readyCondition.wait(lock, [this]()
+                                    { return !running || !readySlots.empty() || !commands.empty(); });
+
+                // Keep drawing submitted frames after a stop request so that
+                // every in-flight frame is finished
+                if (!running && readySlots.empty())
+                {
+                    break;
+                }
+
+                pending.swap(commands);
+                hasFrame = !readySlots.empty();
+                slot = hasFrame ? readySlots.front() : 0;
+                if (hasFrame)
+                {
+                    readySlots.pop_front();
+                }
+            }
+
+            runCommands(pending);
+
+            if (hasFrame)
+            {
+                ENGINE_PROFILE_SCOPE("Render frame");
+                renderer.beginFrame();
+                renderer.renderSnapshot(*snapshots[slot]);
+                renderer.endFrame();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    freeSlots.push_back(slot);
+                }
+                freeCondition.notify_one();
+            }
+        }
+
+        window->releaseContext();
+    }
+
+    void FramePipeline::runCommands(std::vector<std::function<void()>> &commands)
+    {
+        if (commands.empty())
+        {
+            return;
+        }
+
+        ENGINE_PROFILE_SCOPE("Render commands");
+        for (auto &command : commands)
+        {
+            command();
+        }
+        commands.clear();
+    }
+
+} // namespace Engine
@@ -1,22 +1,55 @@
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/UniformBuffer.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <utility>
 
 namespace Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Next material sort ID
+         */
+        std::atomic<uint32_t> nextSortId(1);
+    }
+
     Material::Material(const std::string &name, Shader *shader)
-        : name(name), shader(shader)
+        : name(name),
+          shader(nullptr),
+          sortId(nextSortId.fetch_add(1, std::memory_order_relaxed)),
+          version(1),
+          packedLayout(nullptr),
+          packedVersion(0)
     {
+        setShader(shader);
     }
 
     Material::~Material()
     {
     }
 
+    void Material::setShader(Shader *shader)
+    {
+        this->shader = shader;
+
+        // Resolve names now if the shader is ready; otherwise on first use
+        if (shader && shader->getRevision() != 0)
+        {
+            getBindings(*shader);
+        }
+    }
+
     void Material::bind()
     {
+        ENGINE_PROFILE_SCOPE("Material::bind");
+
         if (!shader)
         {
             Logger::error("Material '" + name + "' has no shader");
@@ -26,55 +59,210 @@ namespace Engine
         // Bind shader
         shader->bind();
 
-        // Set float parameters
-        for (const auto &param : floatParams)
+        applyParameters();
+    }
+
+    void Material::applyParameters()
+    {
+        if (shader)
         {
-            shader->setFloat(param.first, param.second);
+            applyParameters(*shader);
         }
+    }
 
-        // Set int parameters
-        for (const auto &param : intParams)
+    uint32_t Material::applyParameters(Shader &target)
+    {
+        const ShaderBindings &resolved = getBindings(target);
+        if (resolved.useBlock)
         {
-            shader->setInt(param.first, param.second);
+            updateUniformBuffer(resolved, target.getMaterialLayout());
+            uniformBuffer->bind(UniformBinding::Material);
         }
 
-        // Set Vector2 parameters
-        for (const auto &param : vec2Params)
+        // Texture units are shared by all programs, so always rebind them
+        uint32_t textureBinds = 0;
+        for (const auto &param : textures)
         {
-            shader->setVector2(param.first, param.second);
+            if (param.texture)
+            {
+                param.texture->bind(param.unit);
+                ++textureBinds;
+            }
         }
 
-        // Set Vector3 parameters
-        for (const auto &param : vec3Params)
+        // The program still holds these values from the last time
+        if (target.hasAppliedMaterial(sortId, version))
         {
-            shader->setVector3(param.first, param.second);
+            return textureBinds;
+        }
+
+        // Set the parameters the block does not cover
+        for (const auto &binding : resolved.parameters)
+        {
+            if (binding.location < 0)
+            {
+                continue;
+            }
+
+            const Parameter &param = parameters[binding.parameter];
+            const float *v = reinterpret_cast<const float *>(values.data() + param.offset);
+            switch (param.type)
+            {
+            case ParameterType::Float:
+                target.setFloat(binding.location, v[0]);
+                break;
+            case ParameterType::Int:
+                target.setInt(binding.location, *reinterpret_cast<const int *>(v));
+                break;
+            case ParameterType::Vector2:
+                target.setVector2(binding.location, Vector2(v[0], v[1]));
+                break;
+            case ParameterType::Vector3:
+                target.setVector3(binding.location, Vector3(v[0], v[1], v[2]));
+                break;
+            case ParameterType::Vector4:
+                target.setVector4(binding.location, Vector4(v[0], v[1], v[2], v[3]));
+                break;
+            }
         }
 
-        // Set Vector4 parameters
-        for (const auto &param : vec4Params)
+        // Point the samplers at their units; samplers cannot live in a uniform block
+        for (size_t i = 0; i < textures.size(); ++i)
         {
-            shader->setVector4(param.first, param.second);
+            if (textures[i].texture && resolved.textureLocations[i] >= 0)
+            {
+                target.setInt(resolved.textureLocations[i], textures[i].unit);
+            }
         }
 
-        // Bind textures
-        for (const auto &param : textureParams)
+        target.setAppliedMaterial(sortId, version);
+        return textureBinds;
+    }
+
+    void Material::setUniformBuffer(std::unique_ptr<UniformBuffer> buffer)
+    {
+        uniformBuffer = std::move(buffer);
+        packedLayout = nullptr;
+
+        // Parameters move between plain uniforms and the block
+        bindings.clear();
+    }
+
+    const Material::ShaderBindings &Material::getBindings(Shader &target)
+    {
+        for (auto &resolved : bindings)
         {
-            if (param.second.texture)
+            if (resolved.shader == &target)
             {
-                param.second.texture->bind(param.second.unit);
-                shader->setInt(param.first, param.second.unit);
+                if (resolved.revision != target.getRevision())
+                {
+                    resolveBindings(target, resolved);
+                }
+                return resolved;
             }
         }
+
+        bindings.emplace_back();
+        resolveBindings(target, bindings.back());
+        return bindings.back();
+    }
+
+    void Material::resolveBindings(Shader &target, ShaderBindings &resolved)
+    {
+        const UniformBlockLayout &layout = target.getMaterialLayout();
+
+        resolved.shader = &target;
+        resolved.revision = target.getRevision();
+        resolved.useBlock = uniformBuffer && !layout.empty();
+        resolved.parameters.clear();
+        resolved.textureLocations.clear();
+
+        for (uint32_t i = 0; i < parameters.size(); ++i)
+        {
+            ParameterBinding binding = {i, -1, -1};
+
+            auto it = resolved.useBlock ? layout.offsets.find(parameters[i].name) : layout.offsets.end();
+            if (it != layout.offsets.end())
+            {
+                binding.blockOffset = static_cast<int32_t>(it->second);
+            }
+            else
+            {
+                binding.location = target.getUniformLocation(parameters[i].name);
+            }
+
+            resolved.parameters.push_back(binding);
+        }
+
+        for (const auto &param : textures)
+        {
+            resolved.textureLocations.push_back(target.getUniformLocation(param.name));
+        }
+
+        // Locations may differ from what the program last received, and a
+        // recompiled program may keep its layout object with new offsets
+        target.setAppliedMaterial(0, 0);
+        packedLayout = nullptr;
+    }
+
+    void Material::updateUniformBuffer(const ShaderBindings &resolved, const UniformBlockLayout &layout)
+    {
+        if (packedLayout == &layout && packedVersion == version)
+        {
+            return;
+        }
+
+        // std140 stores scalars and ints in 4 bytes and vectors tightly packed,
+        // the same way the values are stored here
+        uniformData.assign(layout.size, 0);
+        for (const auto &binding : resolved.parameters)
+        {
+            if (binding.blockOffset < 0)
+            {
+                continue;
+            }
+
+            const Parameter &param = parameters[binding.parameter];
+            uint32_t size = getParameterSize(param.type);
+            if (binding.blockOffset + size <= uniformData.size())
+            {
+                std::memcpy(uniformData.data() + binding.blockOffset, values.data() + param.offset, size);
+            }
+        }
+
+        if (uniformBuffer->getSize() != uniformData.size())
+        {
+            uniformBuffer->create(uniformData.size());
+        }
+        uniformBuffer->setData(uniformData.data(), uniformData.size());
+
+        packedLayout = &layout;
+        packedVersion = version;
+    }
+
+    uint32_t Material::getParameterSize(ParameterType type)
+    {
+        switch (type)
+        {
+        case ParameterType::Vector2:
+            return 2 * sizeof(float);
+        case ParameterType::Vector3:
+            return 3 * sizeof(float);
+        case ParameterType::Vector4:
+            return 4 * sizeof(float);
+        default:
+            return 4;
+        }
     }
 
     void Material::unbind()
     {
-        // Unbind textures in reverse order
-        for (auto it = textureParams.rbegin(); it != textureParams.rend(); ++it)
+        // Unbind textures
+        for (const auto &param : textures)
         {
-            if (it->second.texture)
+            if (param.texture)
             {
-                it->second.texture->unbind(it->second.unit);
+                param.texture->unbind(param.unit);
             }
         }
 
@@ -85,34 +273,77 @@ namespace Engine
         }
     }
 
+    void Material::setParameter(const std::string &name, ParameterType type, const void *value)
+    {
+        uint32_t size = getParameterSize(type);
+        for (const auto &param : parameters)
+        {
+            if (param.name == name)
+            {
+                if (param.type != type)
+                {
+                    Logger::error("Parameter '" + name + "' of material '" + this->name + "' was set with a different type");
+                    return;
+                }
+
+                std::memcpy(values.data() + param.offset, value, size);
+                ++version;
+                return;
+            }
+        }
+
+        // A new parameter needs to be resolved against the shaders again
+        uint32_t offset = static_cast<uint32_t>(values.size());
+        values.resize(offset + size);
+        std::memcpy(values.data() + offset, value, size);
+        parameters.push_back({name, type, offset});
+        bindings.clear();
+        ++version;
+    }
+
     void Material::setFloat(const std::string &name, float value)
     {
-        floatParams[name] = value;
+        setParameter(name, ParameterType::Float, &value);
     }
 
     void Material::setInt(const std::string &name, int value)
     {
-        intParams[name] = value;
+        setParameter(name, ParameterType::Int, &value);
     }
 
     void Material::setVector2(const std::string &name, const Vector2 &value)
     {
-        vec2Params[name] = value;
+        float data[2] = {value.x, value.y};
+        setParameter(name, ParameterType::Vector2, data);
     }
 
     void Material::setVector3(const std::string &name, const Vector3 &value)
     {
-        vec3Params[name] = value;
+        float data[3] = {value.x, value.y, value.z};
+        setParameter(name, ParameterType::Vector3, data);
     }
 
     void Material::setVector4(const std::string &name, const Vector4 &value)
     {
-        vec4Params[name] = value;
+        float data[4] = {value.x, value.y, value.z, value.w};
+        setParameter(name, ParameterType::Vector4, data);
     }
 
-    void Material::setTexture(const std::string &name, Texture *texture, int unit)
+    void Material::setTexture(const std::string &name, TextureRef texture, int unit)
     {
-        textureParams[name] = {texture, unit};
+        ++version;
+        for (auto &param : textures)
+        {
+            if (param.name == name)
+            {
+                param.texture = std::move(texture);
+                param.unit = unit;
+                return;
+            }
+        }
+
+        textures.push_back({name, std::move(texture), unit});
+        bindings.clear();
     }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
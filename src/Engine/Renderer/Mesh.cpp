@@ -0,0 +1,179 @@
+#include "Engine/Renderer/Mesh.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace Engine
+{
+
+    static_assert(offsetof(Vertex, position) == 0 && sizeof(Vertex) == 56, "VertexLayout::standard() no longer matches Vertex");
+
+    namespace
+    {
+        /**
+         * @brief Next mesh sort ID
+         */
+        std::atomic<uint32_t> nextSortId(1);
+
+        /**
+         * @brief Reads the position of a packed vertex
+         * @param vertex First byte of the vertex
+         * @param offset Offset of the Float3 position
+         * @return Position
+         */
+        Vector3 readPosition(const unsigned char *vertex, uint32_t offset)
+        {
+            float position[3];
+            std::memcpy(position, vertex + offset, sizeof(position));
+            return Vector3(position[0], position[1], position[2]);
+        }
+    }
+
+    Mesh::Mesh(const std::string &name)
+        : name(name),
+          vertexCount(0),
+          indexCount(0),
+          sortId(nextSortId.fetch_add(1, std::memory_order_relaxed)),
+          vertexLayout(VertexLayout::standard()),
+          indexType(IndexType::UInt32),
+          dynamic(false)
+    {
+    }
+
+    void Mesh::swapBuffers(Mesh &other)
+    {
+        std::swap(vertexCount, other.vertexCount);
+        std::swap(indexCount, other.indexCount);
+        subMeshes.swap(other.subMeshes);
+        lods.swap(other.lods);
+        std::swap(vertexLayout, other.vertexLayout);
+        std::swap(indexType, other.indexType);
+        std::swap(dynamic, other.dynamic);
+    }
+
+    void Mesh::swapBounds(Mesh &other)
+    {
+        std::swap(bounds, other.bounds);
+        std::swap(boundingSphere, other.boundingSphere);
+        lodScreenSizes.swap(other.lodScreenSizes);
+    }
+
+    void Mesh::setLods(std::vector<MeshLod> lods)
+    {
+        lodScreenSizes.clear();
+        for (const MeshLod &lod : lods)
+        {
+            lodScreenSizes.push_back(lod.screenSize);
+        }
+        this->lods = std::move(lods);
+    }
+
+    MeshLod Mesh::getLod(uint32_t lod) const
+    {
+        if (lods.empty())
+        {
+            MeshLod whole;
+            whole.indexCount = static_cast<uint32_t>(indexCount);
+            return whole;
+        }
+        return lods[std::min<size_t>(lod, lods.size() - 1)];
+    }
+
+    uint32_t Mesh::selectLod(float screenSize, uint32_t current, float hysteresis) const
+    {
+        uint32_t count = static_cast<uint32_t>(lodScreenSizes.size());
+        if (count <= 1)
+        {
+            return 0;
+        }
+
+        // Switch sizes shrink from level to level, so walk from the current
+        // level towards the one the size calls for
+        uint32_t lod = std::min(current, count - 1);
+        while (lod + 1 < count && screenSize < lodScreenSizes[lod] * (1.0f - hysteresis))
+        {
+            ++lod;
+        }
+        while (lod > 0 && screenSize >= lodScreenSizes[lod - 1] * (1.0f + hysteresis))
+        {
+            --lod;
+        }
+        return lod;
+    }
+
+    float Mesh::getScreenSize(const BoundingSphere &sphere, const Matrix4 &view, const Matrix4 &projection)
+    {
+        if (sphere.isEmpty())
+        {
+            return 0.0f;
+        }
+
+        // Clip w of the center is its depth for a perspective projection and 1
+        // for an orthographic one; the vertical scale maps a world height at
+        // that depth to half the screen height
+        float viewZ = view.get(2, 0) * sphere.center.x + view.get(2, 1) * sphere.center.y +
+                      view.get(2, 2) * sphere.center.z + view.get(2, 3);
+        float w = projection.get(3, 2) * viewZ + projection.get(3, 3);
+        if (w <= 1e-6f)
+        {
+            // The camera is inside or in front of the sphere's center
+            return 1.0f;
+        }
+        return sphere.radius * std::fabs(projection.get(1, 1)) / w;
+    }
+
+    void Mesh::setBounds(const BoundingBox &bounds)
+    {
+        this->bounds = bounds;
+        boundingSphere = BoundingSphere();
+        if (!bounds.isEmpty())
+        {
+            Vector3 extents = bounds.getExtents();
+            boundingSphere.center = bounds.getCenter();
+            boundingSphere.radius = std::sqrt(extents.x * extents.x + extents.y * extents.y + extents.z * extents.z);
+        }
+    }
+
+    void Mesh::computeBounds(const Vertex *vertices, size_t count)
+    {
+        computeBounds(vertices, VertexLayout::standard(), count);
+    }
+
+    void Mesh::computeBounds(const void *vertices, const VertexLayout &layout, size_t count)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(vertices);
+        uint32_t stride = layout.getStride();
+        uint32_t offset = layout.getOffset(VertexAttribute::Position);
+
+        bounds = BoundingBox();
+        for (size_t i = 0; i < count; ++i)
+        {
+            bounds.expand(readPosition(bytes + i * stride, offset));
+        }
+
+        // Center the sphere on the box and grow it to the furthest vertex;
+        // tighter than the box's own circumsphere for most meshes
+        boundingSphere = BoundingSphere();
+        if (bounds.isEmpty())
+        {
+            return;
+        }
+
+        boundingSphere.center = bounds.getCenter();
+        float maxDistanceSquared = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector3 position = readPosition(bytes + i * stride, offset);
+            float dx = position.x - boundingSphere.center.x;
+            float dy = position.y - boundingSphere.center.y;
+            float dz = position.z - boundingSphere.center.z;
+            maxDistanceSquared = std::max(maxDistanceSquared, dx * dx + dy * dy + dz * dz);
+        }
+        boundingSphere.radius = std::sqrt(maxDistanceSquared);
+    }
+
+} // namespace Engine
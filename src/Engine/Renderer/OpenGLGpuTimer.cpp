@@ -0,0 +1,129 @@
+#include "Engine/Renderer/OpenGLGpuTimer.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+// Timer queries are core since OpenGL 3.3, but older loaders may not define them
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace Engine
+{
+
+    OpenGLGpuTimer::OpenGLGpuTimer()
+        : currentFrame(FrameLatency - 1),
+          passActive(false)
+    {
+    }
+
+    OpenGLGpuTimer::~OpenGLGpuTimer()
+    {
+        shutdown();
+    }
+
+    void OpenGLGpuTimer::shutdown()
+    {
+        if (passActive)
+        {
+            endPass();
+        }
+
+        for (FrameQueries &frame : frames)
+        {
+            if (!frame.queries.empty())
+            {
+                glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            }
+            frame.queries.clear();
+            frame.passes.clear();
+        }
+        timings.clear();
+    }
+
+    void OpenGLGpuTimer::beginFrame()
+    {
+        if (passActive)
+        {
+            endPass();
+        }
+
+        // The slot was last used FrameLatency frames ago
+        currentFrame = (currentFrame + 1) % FrameLatency;
+        FrameQueries &frame = frames[currentFrame];
+        readResults(frame);
+        frame.passes.clear();
+    }
+
+    void OpenGLGpuTimer::beginPass(const char *name)
+    {
+        if (passActive)
+        {
+            endPass();
+        }
+
+        // Slots keep their queries, so steady state frames create none
+        FrameQueries &frame = frames[currentFrame];
+        size_t index = frame.passes.size();
+        if (index == frame.queries.size())
+        {
+            uint32_t query = 0;
+            glGenQueries(1, &query);
+            frame.queries.push_back(query);
+        }
+
+        uint32_t query = frame.queries[index];
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        frame.passes.push_back({name, query, Profiler::now()});
+        passActive = true;
+    }
+
+    void OpenGLGpuTimer::endPass()
+    {
+        if (!passActive)
+        {
+            return;
+        }
+
+        glEndQuery(GL_TIME_ELAPSED);
+        passActive = false;
+    }
+
+    bool OpenGLGpuTimer::readResults(FrameQueries &frame)
+    {
+        if (frame.passes.empty())
+        {
+            return false;
+        }
+
+        // Waiting for a pending result would stall until the GPU catches up
+        for (const Pass &pass : frame.passes)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(pass.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                return false;
+            }
+        }
+
+        timings.clear();
+        uint64_t previousEnd = 0;
+        for (const Pass &pass : frame.passes)
+        {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(pass.query, GL_QUERY_RESULT, &elapsed);
+            timings.push_back({pass.name, static_cast<double>(elapsed) / 1000000.0});
+
+            // Only durations are measured: place each pass at its submission,
+            // or after the previous pass, since the GPU runs them in order
+            uint64_t start = std::max(pass.submitTime, previousEnd);
+            previousEnd = start + static_cast<uint64_t>(elapsed);
+            Profiler::recordZone("GPU", pass.name, start, previousEnd);
+        }
+        return true;
+    }
+
+} // namespace Engine
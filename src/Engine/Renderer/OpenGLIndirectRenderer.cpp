@@ -0,0 +1,450 @@
+#include "Engine/Renderer/OpenGLIndirectRenderer.hpp"
+#include "Engine/Renderer/OpenGLMesh.hpp"
+#include "Engine/Renderer/OpenGLUniformBuffer.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <glad/glad.h>
+
+namespace Engine
+{
+
+    namespace
+    {
+        typedef void(APIENTRY *DispatchComputeFunction)(GLuint, GLuint, GLuint);
+        typedef void(APIENTRY *MemoryBarrierFunction)(GLbitfield);
+        typedef void(APIENTRY *MultiDrawElementsIndirectFunction)(GLenum, GLenum, const void *, GLsizei, GLsizei);
+
+        // Core in GL 4.3, not in the 3.3 loader
+        const GLenum SHADER_STORAGE_BUFFER = 0x90D2;
+        const GLenum DRAW_INDIRECT_BUFFER = 0x8F3F;
+        const GLenum COMPUTE_SHADER = 0x91B9;
+        const GLbitfield VERTEX_ATTRIB_ARRAY_BARRIER_BIT = 0x0001;
+        const GLbitfield COMMAND_BARRIER_BIT = 0x0040;
+        const GLbitfield SHADER_STORAGE_BARRIER_BIT = 0x2000;
+
+        /**
+         * @brief Objects culled by one compute work group
+         */
+        const GLuint CULL_GROUP_SIZE = 64;
+
+        /**
+         * @brief GL 4.3 entry points, loaded by OpenGLIndirectRenderer::initialize()
+         */
+        DispatchComputeFunction dispatchCompute = nullptr;
+        MemoryBarrierFunction memoryBarrier = nullptr;
+        MultiDrawElementsIndirectFunction multiDrawElementsIndirect = nullptr;
+
+        /**
+         * @brief Culls every object against the frustum planes
+         *
+         * Each visible object takes the next instance of its mesh's command and
+         * stores its index where that instance reads its object index from.
+         */
+        const char *CULL_SHADER_SOURCE = R"(
+            #version 430 core
+            layout (local_size_x = 64) in;
+
+            struct ObjectData
+            {
+                mat4 transform;
+                vec4 color;
+                vec4 boundingSphere;
+                uvec4 command;
+            };
+
+            struct DrawCommand
+            {
+                uint count;
+                uint instanceCount;
+                uint firstIndex;
+                int baseVertex;
+                uint baseInstance;
+            };
+
+            layout (std430, binding = 0) readonly buffer Objects { ObjectData objects[]; };
+            layout (std430, binding = 1) buffer Commands { DrawCommand commands[]; };
+            layout (std430, binding = 2) writeonly buffer Visible { uint visible[]; };
+
+            uniform vec4 frustumPlanes[6];
+            uniform uint objectCount;
+
+            void main()
+            {
+                uint index = gl_GlobalInvocationID.x;
+                if (index >= objectCount)
+                {
+                    return;
+                }
+
+                // Non-uniform scaling grows the radius by the largest axis scale
+                ObjectData object = objects[index];
+                vec3 center = (object.transform * vec4(object.boundingSphere.xyz, 1.0)).xyz;
+                float scale = max(length(object.transform[0].xyz),
+                                  max(length(object.transform[1].xyz), length(object.transform[2].xyz)));
+                float radius = object.boundingSphere.w * scale;
+
+                for (int i = 0; i < 6; ++i)
+                {
+                    if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+                    {
+                        return;
+                    }
+                }
+
+                uint command = object.command.x;
+                uint slot = atomicAdd(commands[command].instanceCount, 1u);
+                visible[commands[command].baseInstance + slot] = index;
+            }
+        )";
+
+        /**
+         * @brief Compiles and links the culling program
+         * @return Program name, or 0 on failure
+         */
+        GLuint createCullProgram()
+        {
+            GLuint shader = glCreateShader(COMPUTE_SHADER);
+            glShaderSource(shader, 1, &CULL_SHADER_SOURCE, nullptr);
+            glCompileShader(shader);
+
+            GLint success = 0;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success)
+            {
+                char infoLog[512];
+                glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+                Logger::error("Culling shader compilation failed: {}", infoLog);
+                glDeleteShader(shader);
+                return 0;
+            }
+
+            GLuint program = glCreateProgram();
+            glAttachShader(program, shader);
+            glLinkProgram(program);
+            glDeleteShader(shader);
+
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                char infoLog[512];
+                glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+                Logger::error("Culling program linking failed: {}", infoLog);
+                glDeleteProgram(program);
+                return 0;
+            }
+
+            return program;
+        }
+    }
+
+    static_assert(sizeof(IndirectObjectData) == 112, "IndirectObjectData must match the std430 ObjectData struct");
+
+    OpenGLIndirectRenderer::OpenGLIndirectRenderer()
+        : cullProgram(0),
+          frustumLocation(-1),
+          objectCountLocation(-1),
+          objectBuffer(0),
+          commandBuffer(0),
+          visibleBuffer(0),
+          visibleCapacity(0),
+          frame(0)
+    {
+    }
+
+    OpenGLIndirectRenderer::~OpenGLIndirectRenderer()
+    {
+        shutdown();
+    }
+
+    bool OpenGLIndirectRenderer::initialize(void *(*loader)(const char *))
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major < 4 || (major == 4 && minor < 3))
+        {
+            Logger::info("GPU-driven rendering needs OpenGL 4.3, the context has {}.{}", major, minor);
+            return false;
+        }
+
+        dispatchCompute = reinterpret_cast<DispatchComputeFunction>(loader("glDispatchCompute"));
+        memoryBarrier = reinterpret_cast<MemoryBarrierFunction>(loader("glMemoryBarrier"));
+        multiDrawElementsIndirect =
+            reinterpret_cast<MultiDrawElementsIndirectFunction>(loader("glMultiDrawElementsIndirect"));
+        if (!dispatchCompute || !memoryBarrier || !multiDrawElementsIndirect)
+        {
+            Logger::warning("OpenGL 4.3 context is missing compute or multi-draw indirect entry points");
+            return false;
+        }
+
+        cullProgram = createCullProgram();
+        if (!cullProgram)
+        {
+            return false;
+        }
+        frustumLocation = glGetUniformLocation(cullProgram, "frustumPlanes");
+        objectCountLocation = glGetUniformLocation(cullProgram, "objectCount");
+
+        glGenBuffers(1, &objectBuffer);
+        glGenBuffers(1, &commandBuffer);
+        glGenBuffers(1, &visibleBuffer);
+
+        Logger::info("Static meshes use GPU culling and multi-draw indirect");
+        return true;
+    }
+
+    void OpenGLIndirectRenderer::shutdown()
+    {
+        // Pools hold the vertex arrays that read the visible buffer
+        pools.clear();
+        submissions.clear();
+
+        if (cullProgram)
+        {
+            glDeleteProgram(cullProgram);
+            cullProgram = 0;
+        }
+        if (objectBuffer)
+        {
+            glDeleteBuffers(1, &objectBuffer);
+            glDeleteBuffers(1, &commandBuffer);
+            glDeleteBuffers(1, &visibleBuffer);
+            objectBuffer = 0;
+            commandBuffer = 0;
+            visibleBuffer = 0;
+        }
+        visibleCapacity = 0;
+    }
+
+    OpenGLMeshPool *OpenGLIndirectRenderer::getPool(const Mesh &mesh, uint32_t &index)
+    {
+        for (size_t i = 0; i < pools.size(); ++i)
+        {
+            if (pools[i]->accepts(mesh))
+            {
+                index = static_cast<uint32_t>(i);
+                return pools[i].get();
+            }
+        }
+
+        index = static_cast<uint32_t>(pools.size());
+        pools.push_back(std::make_unique<OpenGLMeshPool>(mesh.getVertexLayout(), mesh.getIndexType(), visibleBuffer,
+                                                         ObjectIndexLocation));
+        return pools.back().get();
+    }
+
+    bool OpenGLIndirectRenderer::submit(Mesh *mesh, Material *material, const Matrix4 &transform,
+                                        const Vector4 &color, uint32_t lod)
+    {
+        if (!cullProgram || !mesh || !material || !material->getShader() ||
+            !material->getShader()->getIndirectVariant() || mesh->isDynamic() || mesh->getIndexCount() == 0 ||
+            mesh->getBoundingSphere().isEmpty())
+        {
+            return false;
+        }
+
+        // Copy the mesh now, so a full pool sends the object back to the CPU path
+        uint32_t poolIndex = 0;
+        OpenGLMeshPool *pool = getPool(*mesh, poolIndex);
+        if (!pool->acquire(*static_cast<OpenGLMesh *>(mesh), frame))
+        {
+            return false;
+        }
+
+        lod = std::min(lod, mesh->getLodCount() - 1);
+        submissions.push_back({mesh, material, pool, poolIndex, lod, transform, color});
+        return true;
+    }
+
+    void OpenGLIndirectRenderer::flush(const Matrix4 &view, const Matrix4 &projection, RenderStats &stats)
+    {
+        if (submissions.empty())
+        {
+            return;
+        }
+
+        // Group objects by shader, material, pool, mesh, and level, so every
+        // level of a mesh gets one command and every material one draw per pool
+        keys.clear();
+        for (uint32_t i = 0; i < submissions.size(); ++i)
+        {
+            const Submission &submission = submissions[i];
+            uint64_t key = (static_cast<uint64_t>(submission.material->getShader()->getSortId() & 0xFFFF) << 48) |
+                           (static_cast<uint64_t>(submission.material->getSortId() & 0xFFFF) << 32) |
+                           (static_cast<uint64_t>(submission.poolIndex & 0xFF) << 24) |
+                           (static_cast<uint64_t>(submission.mesh->getSortId() & 0xFFFFF) << 4) |
+                           static_cast<uint64_t>(std::min(submission.lod, 15u));
+            keys.emplace_back(key, i);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        objects.clear();
+        commands.clear();
+        buckets.clear();
+        const Mesh *commandMesh = nullptr;
+        uint32_t commandLod = 0;
+        for (const auto &key : keys)
+        {
+            const Submission &submission = submissions[key.second];
+            Shader *shader = submission.material->getShader()->getIndirectVariant();
+            if (buckets.empty() || buckets.back().material != submission.material ||
+                buckets.back().pool != submission.pool || buckets.back().shader != shader)
+            {
+                buckets.push_back({submission.pool, submission.material, shader,
+                                   static_cast<uint32_t>(commands.size()), 0});
+                commandMesh = nullptr;
+            }
+
+            if (submission.mesh != commandMesh || submission.lod != commandLod)
+            {
+                // Allocations move when a pool grows, so look them up only now
+                const OpenGLMeshPool::Allocation *allocation =
+                    submission.pool->acquire(*static_cast<OpenGLMesh *>(submission.mesh), frame);
+                MeshLod range = submission.mesh->getLod(submission.lod);
+                commands.push_back({range.indexCount, 0, allocation->firstIndex + range.indexOffset,
+                                    allocation->baseVertex, static_cast<uint32_t>(objects.size())});
+                ++buckets.back().commandCount;
+                commandMesh = submission.mesh;
+                commandLod = submission.lod;
+            }
+
+            // Counted before culling, as the GPU keeps the survivors to itself
+            if (submission.lod > 0)
+            {
+                uint32_t fullIndices = submission.mesh->getLod(0).indexCount;
+                uint32_t indices = submission.mesh->getLod(submission.lod).indexCount;
+                stats.trianglesSavedByLod += (fullIndices - std::min(fullIndices, indices)) / 3;
+            }
+
+            IndirectObjectData object;
+            std::memcpy(object.transform, submission.transform.getData(), sizeof(object.transform));
+            object.color[0] = submission.color.x;
+            object.color[1] = submission.color.y;
+            object.color[2] = submission.color.z;
+            object.color[3] = submission.color.w;
+            const BoundingSphere &sphere = submission.mesh->getBoundingSphere();
+            object.boundingSphere[0] = sphere.center.x;
+            object.boundingSphere[1] = sphere.center.y;
+            object.boundingSphere[2] = sphere.center.z;
+            object.boundingSphere[3] = sphere.radius;
+            object.command[0] = static_cast<uint32_t>(commands.size() - 1);
+            object.command[1] = 0;
+            object.command[2] = 0;
+            object.command[3] = 0;
+            objects.push_back(object);
+        }
+
+        // Respecify the stores every frame, as the instance buffer of the CPU path does
+        glBindBuffer(SHADER_STORAGE_BUFFER, objectBuffer);
+        glBufferData(SHADER_STORAGE_BUFFER, objects.size() * sizeof(IndirectObjectData), objects.data(), GL_STREAM_DRAW);
+        glBindBuffer(SHADER_STORAGE_BUFFER, commandBuffer);
+        glBufferData(SHADER_STORAGE_BUFFER, commands.size() * sizeof(DrawCommand), commands.data(), GL_STREAM_DRAW);
+        if (objects.size() > visibleCapacity)
+        {
+            visibleCapacity = std::max(objects.size(), visibleCapacity * 2);
+            glBindBuffer(SHADER_STORAGE_BUFFER, visibleBuffer);
+            glBufferData(SHADER_STORAGE_BUFFER, visibleCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+        }
+        glBindBuffer(SHADER_STORAGE_BUFFER, 0);
+        stats.bufferUploadBytes += objects.size() * sizeof(IndirectObjectData) + commands.size() * sizeof(DrawCommand);
+
+        {
+            ENGINE_PROFILE_SCOPE("GPU culling");
+
+            Frustum frustum = Frustum::fromMatrix(projection * view);
+            float planes[Frustum::PlaneCount * 4];
+            for (int i = 0; i < Frustum::PlaneCount; ++i)
+            {
+                const Plane &plane = frustum.getPlane(static_cast<Frustum::PlaneIndex>(i));
+                planes[i * 4 + 0] = plane.normal.x;
+                planes[i * 4 + 1] = plane.normal.y;
+                planes[i * 4 + 2] = plane.normal.z;
+                planes[i * 4 + 3] = plane.distance;
+            }
+
+            glUseProgram(cullProgram);
+            glUniform4fv(frustumLocation, Frustum::PlaneCount, planes);
+            glUniform1ui(objectCountLocation, static_cast<GLuint>(objects.size()));
+            glBindBufferBase(SHADER_STORAGE_BUFFER, ObjectBinding, objectBuffer);
+            glBindBufferBase(SHADER_STORAGE_BUFFER, 1, commandBuffer);
+            glBindBufferBase(SHADER_STORAGE_BUFFER, 2, visibleBuffer);
+            dispatchCompute(static_cast<GLuint>((objects.size() + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE), 1, 1);
+            glUseProgram(0);
+
+            // The draws read the instance counts as commands and the visible indices as attributes
+            memoryBarrier(COMMAND_BARRIER_BIT | VERTEX_ATTRIB_ARRAY_BARRIER_BIT | SHADER_STORAGE_BARRIER_BIT);
+        }
+
+        // The ObjectData buffer stays bound for the vertex shaders
+        glBindBuffer(DRAW_INDIRECT_BUFFER, commandBuffer);
+
+        Shader *boundShader = nullptr;
+        Material *boundMaterial = nullptr;
+        OpenGLMeshPool *boundPool = nullptr;
+        for (const Bucket &bucket : buckets)
+        {
+            if (bucket.shader != boundShader)
+            {
+                bucket.shader->bind();
+                if (!bucket.shader->usesFrameUniforms())
+                {
+                    bucket.shader->setMatrix4("view", view);
+                    bucket.shader->setMatrix4("projection", projection);
+                }
+                boundShader = bucket.shader;
+                boundMaterial = nullptr;
+                ++stats.shaderChanges;
+            }
+
+            if (bucket.material != boundMaterial)
+            {
+                if (!bucket.material->getUniformBuffer() && !bucket.shader->getMaterialLayout().empty())
+                {
+                    bucket.material->setUniformBuffer(std::make_unique<OpenGLUniformBuffer>());
+                }
+
+                stats.textureBinds += bucket.material->applyParameters(*bucket.shader);
+                boundMaterial = bucket.material;
+                ++stats.materialChanges;
+            }
+
+            if (bucket.pool != boundPool)
+            {
+                bucket.pool->bind();
+                boundPool = bucket.pool;
+                ++stats.meshChanges;
+            }
+
+            const void *offset = reinterpret_cast<const void *>(bucket.firstCommand * sizeof(DrawCommand));
+            multiDrawElementsIndirect(GL_TRIANGLES, bucket.pool->getIndexFormat(), offset,
+                                      static_cast<GLsizei>(bucket.commandCount), 0);
+            ++stats.drawCalls;
+            ++stats.indirectDrawCalls;
+        }
+        stats.gpuCullObjects += static_cast<uint32_t>(objects.size());
+
+        // Leave the pipeline in the unbound state other code expects
+        glBindVertexArray(0);
+        glBindBuffer(DRAW_INDIRECT_BUFFER, 0);
+        if (boundMaterial)
+        {
+            boundMaterial->unbind();
+        }
+        if (boundShader)
+        {
+            boundShader->unbind();
+        }
+
+        submissions.clear();
+        ++frame;
+    }
+
+} // namespace Engine
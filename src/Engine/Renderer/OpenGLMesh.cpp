@@ -0,0 +1,649 @@
+#include "Engine/Renderer/OpenGLMesh.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <glad/glad.h>
+
+namespace Engine
+{
+
+    namespace
+    {
+        typedef void(APIENTRY *BufferStorageFunction)(GLenum, GLsizeiptr, const void *, GLbitfield);
+
+        // Core in GL 4.4 and GL_ARB_buffer_storage, not in the 3.3 loader
+        const GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+        const GLbitfield MAP_COHERENT_BIT = 0x0080;
+
+        /**
+         * @brief glBufferStorage, loaded by OpenGLMesh::initializeExtensions(), or nullptr
+         */
+        BufferStorageFunction bufferStorage = nullptr;
+
+        /**
+         * @brief Next buffer revision
+         */
+        std::atomic<uint32_t> nextRevision(1);
+
+        /**
+         * @brief Checks if the current context reports an extension
+         * @param name Extension name
+         * @return True if the extension is supported
+         */
+        bool hasExtension(const char *name)
+        {
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count; ++i)
+            {
+                const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if (extension && std::strcmp(extension, name) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    void OpenGLMesh::DirtyRange::add(size_t first, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (begin == end)
+        {
+            begin = first;
+            end = first + count;
+        }
+        else
+        {
+            begin = std::min(begin, first);
+            end = std::max(end, first + count);
+        }
+    }
+
+    OpenGLMesh::OpenGLMesh(const std::string &name)
+        : Mesh(name),
+          mappedVertices(nullptr),
+          mappedIndices(nullptr),
+          vertexCapacity(0),
+          indexCapacity(0),
+          currentRegion(0),
+          regionDrawn(false),
+          revision(0),
+          vao(0),
+          vbo(0),
+          ebo(0),
+          instanceBufferId(0),
+          instanceOffset(0)
+    {
+    }
+
+    OpenGLMesh::~OpenGLMesh()
+    {
+        releaseDynamic();
+        if (ebo)
+        {
+            glDeleteBuffers(1, &ebo);
+        }
+        if (vbo)
+        {
+            glDeleteBuffers(1, &vbo);
+        }
+        if (vao)
+        {
+            glDeleteVertexArrays(1, &vao);
+        }
+    }
+
+    void OpenGLMesh::setVertices(const std::vector<Vertex> &vertices)
+    {
+        setVertices(Span<const Vertex>(vertices));
+    }
+
+    void OpenGLMesh::setIndices(const std::vector<uint32_t> &indices)
+    {
+        setIndices(Span<const uint32_t>(indices));
+    }
+
+    void OpenGLMesh::setVertices(Span<const Vertex> data)
+    {
+        vertices.assign(data.begin(), data.end());
+
+        // A dynamic mesh keeps drawing its current contents until build()
+        if (!dynamic)
+        {
+            vertexCount = vertices.size();
+        }
+    }
+
+    void OpenGLMesh::setIndices(Span<const uint32_t> data)
+    {
+        indices.assign(data.begin(), data.end());
+        if (!dynamic)
+        {
+            indexCount = indices.size();
+        }
+    }
+
+    bool OpenGLMesh::build()
+    {
+        MeshData data;
+        data.vertices = vertices.data();
+        data.vertexCount = vertices.size();
+        data.indices = indices.data();
+        data.indexCount = indices.size();
+        return build(data);
+    }
+
+    bool OpenGLMesh::build(const MeshData &data)
+    {
+        if ((!data.vertices && !data.packedVertices) || data.vertexCount == 0)
+        {
+            Logger::error("Cannot build mesh '" + name + "': No vertices");
+            return false;
+        }
+        if (data.packedVertices && !data.packedLayout.isValid())
+        {
+            Logger::error("Cannot build mesh '{}': Packed vertices need Float3 positions", name);
+            return false;
+        }
+
+        // Cooked meshes come with their bounds
+        if (data.bounds.isEmpty())
+        {
+            if (data.packedVertices)
+            {
+                computeBounds(data.packedVertices, data.packedLayout, data.vertexCount);
+            }
+            else
+            {
+                computeBounds(data.vertices, data.vertexCount);
+            }
+        }
+        else
+        {
+            bounds = data.bounds;
+            boundingSphere = data.boundingSphere;
+        }
+
+        // Dynamic meshes write into their ring, growing it if the data does not fit
+        if (dynamic)
+        {
+            if (data.packedVertices || data.shortIndices)
+            {
+                Logger::error("Cannot build dynamic mesh '{}': Dynamic meshes take Vertex data and 32-bit indices", name);
+                return false;
+            }
+
+            size_t dataIndexCount = data.indices ? data.indexCount : 0;
+            if (data.vertexCount > vertexCapacity || dataIndexCount > indexCapacity)
+            {
+                if (!createDynamic(std::max(data.vertexCount, vertexCapacity * 2),
+                                   dataIndexCount > indexCapacity ? std::max(dataIndexCount, indexCapacity * 2) : indexCapacity))
+                {
+                    return false;
+                }
+            }
+
+            updateVertices(Span<const Vertex>(data.vertices, data.vertexCount));
+            updateIndices(Span<const uint32_t>(data.indices, dataIndexCount));
+            return setDrawCount(data.vertexCount, dataIndexCount);
+        }
+
+        // Vertex data is converted to the mesh's layout, packed data brings its own
+        const void *vertexData = data.packedVertices;
+        std::vector<unsigned char> quantized;
+        if (vertexData)
+        {
+            vertexLayout = data.packedLayout;
+        }
+        else if (vertexLayout == VertexLayout::standard())
+        {
+            vertexData = data.vertices;
+        }
+        else
+        {
+            ENGINE_PROFILE_SCOPE("Quantize vertices");
+            quantized.resize(data.vertexCount * vertexLayout.getStride());
+            vertexLayout.quantize(data.vertices, data.vertexCount, quantized.data());
+            vertexData = quantized.data();
+        }
+
+        // 16-bit indices halve the index buffer whenever every vertex is in reach
+        const void *indexData = data.shortIndices;
+        std::vector<uint16_t> shortIndices;
+        indexType = IndexType::UInt16;
+        if (!indexData && data.indices)
+        {
+            if (VertexLayout::selectIndexType(data.vertexCount) == IndexType::UInt16)
+            {
+                shortIndices.assign(data.indices, data.indices + data.indexCount);
+                indexData = shortIndices.data();
+            }
+            else
+            {
+                indexData = data.indices;
+                indexType = IndexType::UInt32;
+            }
+        }
+
+        vertexCount = data.vertexCount;
+        indexCount = indexData ? data.indexCount : 0;
+
+        // Create buffers on first build
+        if (!vao)
+        {
+            glGenVertexArrays(1, &vao);
+            glGenBuffers(1, &vbo);
+            glGenBuffers(1, &ebo);
+        }
+
+        glBindVertexArray(vao);
+
+        // Upload vertices
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexCount * vertexLayout.getStride(), vertexData, GL_STATIC_DRAW);
+
+        // Upload indices
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * getIndexSize(indexType), indexData, GL_STATIC_DRAW);
+
+        setupVertexAttributes(vertexLayout);
+        glBindVertexArray(0);
+
+        // Instance attributes have to be set up again for the new array
+        instanceBufferId = 0;
+        revision = nextRevision.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool OpenGLMesh::createDynamic(size_t vertexCapacity, size_t indexCapacity)
+    {
+        if (vertexCapacity == 0)
+        {
+            Logger::error("Cannot create dynamic mesh '{}': No vertices", name);
+            return false;
+        }
+
+        // Storage made by glBufferStorage can't be resized, so start from new buffer objects
+        releaseDynamic();
+        if (!vao)
+        {
+            glGenVertexArrays(1, &vao);
+        }
+        else
+        {
+            glDeleteBuffers(1, &vbo);
+            glDeleteBuffers(1, &ebo);
+        }
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ebo);
+
+        size_t vertexBytes = DynamicRegionCount * vertexCapacity * sizeof(Vertex);
+        size_t indexBytes = DynamicRegionCount * std::max<size_t>(indexCapacity, 1) * sizeof(uint32_t);
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        if (bufferStorage)
+        {
+            // Coherent mappings make plain writes visible to later draws without a flush
+            GLbitfield flags = GL_MAP_WRITE_BIT | MAP_PERSISTENT_BIT | MAP_COHERENT_BIT;
+            bufferStorage(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexBytes), nullptr, flags);
+            bufferStorage(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), nullptr, flags);
+            mappedVertices = static_cast<unsigned char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(vertexBytes), flags));
+            mappedIndices = static_cast<unsigned char *>(glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(indexBytes), flags));
+            if (!mappedVertices || !mappedIndices)
+            {
+                Logger::error("Cannot create dynamic mesh '{}': Mapping the buffers failed", name);
+                mappedVertices = nullptr;
+                mappedIndices = nullptr;
+                glBindVertexArray(0);
+                return false;
+            }
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexBytes), nullptr, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), nullptr, GL_STREAM_DRAW);
+        }
+
+        // The ring is written with Vertex structs and 32-bit indices
+        vertexLayout = VertexLayout::standard();
+        indexType = IndexType::UInt32;
+        setupVertexAttributes(vertexLayout);
+        glBindVertexArray(0);
+
+        this->vertexCapacity = vertexCapacity;
+        this->indexCapacity = indexCapacity;
+        dynamicVertices.assign(vertexCapacity, Vertex());
+        dynamicIndices.assign(indexCapacity, 0);
+        vertexCount = 0;
+        indexCount = 0;
+        currentRegion = 0;
+        regionDrawn = false;
+        dynamic = true;
+        setLods({});
+
+        instanceBufferId = 0;
+        revision = nextRevision.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool OpenGLMesh::updateVertices(Span<const Vertex> data, size_t first)
+    {
+        if (!dynamic)
+        {
+            Logger::error("Cannot update mesh '{}': Not a dynamic mesh", name);
+            return false;
+        }
+        if (first > vertexCapacity || data.size() > vertexCapacity - first)
+        {
+            Logger::error("Cannot update mesh '{}': {} vertices at {} exceed the capacity of {}", name, data.size(), first,
+                          vertexCapacity);
+            return false;
+        }
+        if (data.empty())
+        {
+            return true;
+        }
+
+        beginWrite();
+        std::copy(data.begin(), data.end(), dynamicVertices.begin() + first);
+        writeBuffer(vbo, mappedVertices, (currentRegion * vertexCapacity + first) * sizeof(Vertex), data.data(),
+                    data.size() * sizeof(Vertex));
+
+        // The other regions pick the range up when they are written next
+        for (uint32_t region = 0; region < DynamicRegionCount; ++region)
+        {
+            if (region != currentRegion)
+            {
+                regions[region].vertices.add(first, data.size());
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLMesh::updateIndices(Span<const uint32_t> data, size_t first)
+    {
+        if (!dynamic)
+        {
+            Logger::error("Cannot update mesh '{}': Not a dynamic mesh", name);
+            return false;
+        }
+        if (first > indexCapacity || data.size() > indexCapacity - first)
+        {
+            Logger::error("Cannot update mesh '{}': {} indices at {} exceed the capacity of {}", name, data.size(), first,
+                          indexCapacity);
+            return false;
+        }
+        if (data.empty())
+        {
+            return true;
+        }
+
+        beginWrite();
+        std::copy(data.begin(), data.end(), dynamicIndices.begin() + first);
+        writeBuffer(ebo, mappedIndices, (currentRegion * indexCapacity + first) * sizeof(uint32_t), data.data(),
+                    data.size() * sizeof(uint32_t));
+
+        for (uint32_t region = 0; region < DynamicRegionCount; ++region)
+        {
+            if (region != currentRegion)
+            {
+                regions[region].indices.add(first, data.size());
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLMesh::setDrawCount(size_t vertexCount, size_t indexCount)
+    {
+        if (!dynamic)
+        {
+            Logger::error("Cannot set the draw count of mesh '{}': Not a dynamic mesh", name);
+            return false;
+        }
+        if (vertexCount > vertexCapacity || indexCount > indexCapacity)
+        {
+            Logger::error("Cannot set the draw count of mesh '{}': {} vertices and {} indices exceed the capacity", name,
+                          vertexCount, indexCount);
+            return false;
+        }
+
+        this->vertexCount = vertexCount;
+        this->indexCount = indexCount;
+        return true;
+    }
+
+    void OpenGLMesh::initializeExtensions(void *(*loader)(const char *))
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+        bool supported = major > 4 || (major == 4 && minor >= 4) || hasExtension("GL_ARB_buffer_storage");
+        bufferStorage = supported ? reinterpret_cast<BufferStorageFunction>(loader("glBufferStorage")) : nullptr;
+        Logger::info(bufferStorage ? "Dynamic meshes use persistently mapped buffers"
+                                   : "Dynamic meshes use glBufferSubData, persistent mapping is unavailable");
+    }
+
+    void OpenGLMesh::setupVertexAttributes(const VertexLayout &layout)
+    {
+        GLsizei stride = static_cast<GLsizei>(layout.getStride());
+        for (uint32_t location = 0; location < VertexAttributeCount; ++location)
+        {
+            VertexAttribute attribute = static_cast<VertexAttribute>(location);
+            void *offset = (void *)static_cast<uintptr_t>(layout.getOffset(attribute));
+            switch (layout.getFormat(attribute))
+            {
+            case VertexFormat::None:
+                // A rebuilt vertex array may still have the attribute enabled
+                glDisableVertexAttribArray(location);
+                continue;
+            case VertexFormat::Float2:
+                glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, stride, offset);
+                break;
+            case VertexFormat::Float3:
+                glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, offset);
+                break;
+            case VertexFormat::Half2:
+                glVertexAttribPointer(location, 2, GL_HALF_FLOAT, GL_FALSE, stride, offset);
+                break;
+            case VertexFormat::SNorm1010102:
+                glVertexAttribPointer(location, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, offset);
+                break;
+            }
+            glEnableVertexAttribArray(location);
+        }
+    }
+
+    void OpenGLMesh::beginWrite()
+    {
+        // Writes between two draws all go to the same region
+        if (!regionDrawn)
+        {
+            return;
+        }
+
+        // The fence follows every draw that read the region being left
+        regions[currentRegion].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        currentRegion = (currentRegion + 1) % DynamicRegionCount;
+        regionDrawn = false;
+
+        DynamicRegion &region = regions[currentRegion];
+        if (region.fence)
+        {
+            // Only blocks when the GPU is more than DynamicRegionCount - 1 frames behind
+            GLsync fence = static_cast<GLsync>(region.fence);
+            if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+            {
+                ENGINE_PROFILE_SCOPE("Wait for dynamic mesh");
+                while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+                {
+                }
+            }
+            glDeleteSync(fence);
+            region.fence = nullptr;
+        }
+
+        // Catch up on what the other regions received while this one was in flight
+        if (region.vertices.end > region.vertices.begin)
+        {
+            writeBuffer(vbo, mappedVertices, (currentRegion * vertexCapacity + region.vertices.begin) * sizeof(Vertex),
+                        &dynamicVertices[region.vertices.begin], (region.vertices.end - region.vertices.begin) * sizeof(Vertex));
+        }
+        if (region.indices.end > region.indices.begin)
+        {
+            writeBuffer(ebo, mappedIndices, (currentRegion * indexCapacity + region.indices.begin) * sizeof(uint32_t),
+                        &dynamicIndices[region.indices.begin], (region.indices.end - region.indices.begin) * sizeof(uint32_t));
+        }
+        region.vertices = DirtyRange();
+        region.indices = DirtyRange();
+    }
+
+    void OpenGLMesh::writeBuffer(uint32_t buffer, unsigned char *mapped, size_t offset, const void *data, size_t size)
+    {
+        if (mapped)
+        {
+            std::memcpy(mapped + offset, data, size);
+            return;
+        }
+
+        // The copy target leaves the element buffer of the bound vertex array alone
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    void OpenGLMesh::releaseDynamic()
+    {
+        for (DynamicRegion &region : regions)
+        {
+            if (region.fence)
+            {
+                glDeleteSync(static_cast<GLsync>(region.fence));
+            }
+            region = DynamicRegion();
+        }
+
+        // Deleting the buffers unmaps them
+        mappedVertices = nullptr;
+        mappedIndices = nullptr;
+    }
+
+    void OpenGLMesh::bind() const
+    {
+        glBindVertexArray(vao);
+    }
+
+    void OpenGLMesh::unbind() const
+    {
+        glBindVertexArray(0);
+    }
+
+    uint32_t OpenGLMesh::getIndexFormat() const
+    {
+        return indexType == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    void OpenGLMesh::draw(uint32_t lod) const
+    {
+        // Dynamic meshes draw from their current region, static ones from offset 0
+        regionDrawn = true;
+        GLint baseVertex = static_cast<GLint>(currentRegion * vertexCapacity);
+        if (indexCount > 0)
+        {
+            MeshLod range = getLod(lod);
+            size_t firstIndex = currentRegion * indexCapacity + range.indexOffset;
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), getIndexFormat(),
+                                     (void *)(firstIndex * getIndexSize(indexType)), baseVertex);
+        }
+        else
+        {
+            glDrawArrays(GL_TRIANGLES, baseVertex, static_cast<GLsizei>(vertexCount));
+        }
+    }
+
+    void OpenGLMesh::drawInstanced(uint32_t instanceCount, uint32_t lod) const
+    {
+        regionDrawn = true;
+        GLint baseVertex = static_cast<GLint>(currentRegion * vertexCapacity);
+        if (indexCount > 0)
+        {
+            MeshLod range = getLod(lod);
+            size_t firstIndex = currentRegion * indexCapacity + range.indexOffset;
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), getIndexFormat(),
+                                              (void *)(firstIndex * getIndexSize(indexType)),
+                                              static_cast<GLsizei>(instanceCount), baseVertex);
+        }
+        else
+        {
+            glDrawArraysInstanced(GL_TRIANGLES, baseVertex, static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount));
+        }
+    }
+
+    void OpenGLMesh::swapBuffers(Mesh &other)
+    {
+        // Both meshes come from the same renderer
+        OpenGLMesh &mesh = static_cast<OpenGLMesh &>(other);
+        vertices.swap(mesh.vertices);
+        indices.swap(mesh.indices);
+        std::swap(vao, mesh.vao);
+        std::swap(vbo, mesh.vbo);
+        std::swap(ebo, mesh.ebo);
+        std::swap(instanceBufferId, mesh.instanceBufferId);
+        std::swap(instanceOffset, mesh.instanceOffset);
+        dynamicVertices.swap(mesh.dynamicVertices);
+        dynamicIndices.swap(mesh.dynamicIndices);
+        std::swap(regions, mesh.regions);
+        std::swap(mappedVertices, mesh.mappedVertices);
+        std::swap(mappedIndices, mesh.mappedIndices);
+        std::swap(vertexCapacity, mesh.vertexCapacity);
+        std::swap(indexCapacity, mesh.indexCapacity);
+        std::swap(currentRegion, mesh.currentRegion);
+        std::swap(regionDrawn, mesh.regionDrawn);
+        std::swap(revision, mesh.revision);
+        Mesh::swapBuffers(other);
+    }
+
+    void OpenGLMesh::setInstanceBuffer(uint32_t bufferId, size_t offset)
+    {
+        if (bufferId == instanceBufferId && offset == instanceOffset)
+        {
+            return;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+
+        // A mat4 attribute takes four consecutive vec4 locations
+        for (uint32_t column = 0; column < 4; ++column)
+        {
+            uint32_t location = InstanceTransformLocation + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                  (void *)(offset + offsetof(InstanceData, transform) + column * 4 * sizeof(float)));
+            glVertexAttribDivisor(location, 1);
+        }
+
+        glEnableVertexAttribArray(InstanceColorLocation);
+        glVertexAttribPointer(InstanceColorLocation, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void *)(offset + offsetof(InstanceData, color)));
+        glVertexAttribDivisor(InstanceColorLocation, 1);
+
+        instanceBufferId = bufferId;
+        instanceOffset = offset;
+    }
+
+} // namespace Engine
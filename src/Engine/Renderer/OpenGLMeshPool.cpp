@@ -0,0 +1,248 @@
+#include "Engine/Renderer/OpenGLMeshPool.hpp"
+#include "Engine/Renderer/OpenGLMesh.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <glad/glad.h>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Smallest capacities of the shared buffers
+         */
+        const size_t MIN_VERTEX_CAPACITY = 1 << 16;
+        const size_t MIN_INDEX_CAPACITY = 1 << 18;
+
+        /**
+         * @brief Creates a buffer without contents
+         * @param size Size in bytes
+         * @return Buffer name
+         */
+        GLuint createBuffer(size_t size)
+        {
+            // The copy target leaves the array and element bindings alone
+            GLuint buffer = 0;
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STATIC_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            return buffer;
+        }
+
+        /**
+         * @brief Copies bytes between two buffers on the GPU
+         * @param source Buffer to read
+         * @param sourceOffset Byte offset in the source
+         * @param target Buffer to write
+         * @param targetOffset Byte offset in the target
+         * @param size Number of bytes
+         */
+        void copyBuffer(GLuint source, size_t sourceOffset, GLuint target, size_t targetOffset, size_t size)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, source);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(sourceOffset),
+                                static_cast<GLintptr>(targetOffset), static_cast<GLsizeiptr>(size));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+    }
+
+    OpenGLMeshPool::OpenGLMeshPool(const VertexLayout &layout, IndexType indexType, uint32_t objectIndexBuffer,
+                                   uint32_t objectIndexLocation)
+        : layout(layout),
+          indexType(indexType),
+          objectIndexBuffer(objectIndexBuffer),
+          objectIndexLocation(objectIndexLocation),
+          vao(0),
+          vbo(0),
+          ebo(0),
+          vertexCapacity(0),
+          indexCapacity(0),
+          vertexUsed(0),
+          indexUsed(0)
+    {
+    }
+
+    OpenGLMeshPool::~OpenGLMeshPool()
+    {
+        if (ebo)
+        {
+            glDeleteBuffers(1, &ebo);
+        }
+        if (vbo)
+        {
+            glDeleteBuffers(1, &vbo);
+        }
+        if (vao)
+        {
+            glDeleteVertexArrays(1, &vao);
+        }
+    }
+
+    bool OpenGLMeshPool::accepts(const Mesh &mesh) const
+    {
+        return !mesh.isDynamic() && mesh.getIndexCount() > 0 && mesh.getIndexType() == indexType &&
+               mesh.getVertexLayout() == layout;
+    }
+
+    const OpenGLMeshPool::Allocation *OpenGLMeshPool::acquire(const OpenGLMesh &mesh, uint64_t frame)
+    {
+        auto it = entries.find(&mesh);
+        if (it != entries.end() && it->second.revision == mesh.getRevision())
+        {
+            it->second.lastUsed = frame;
+            return &it->second.allocation;
+        }
+
+        // A stale copy keeps its space until the next grow
+        if (it != entries.end())
+        {
+            entries.erase(it);
+        }
+
+        size_t vertexCount = mesh.getVertexCount();
+        size_t indexCount = mesh.getIndexCount();
+        if (!mesh.getVertexBufferId() || vertexCount == 0 || indexCount == 0)
+        {
+            return nullptr;
+        }
+
+        if (vertexUsed + vertexCount > vertexCapacity || indexUsed + indexCount > indexCapacity)
+        {
+            grow(vertexCount, indexCount, frame);
+        }
+
+        // Draw commands address the buffers with 32-bit offsets
+        if (vertexUsed + vertexCount > vertexCapacity || indexUsed + indexCount > indexCapacity ||
+            vertexUsed + vertexCount > static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+            indexUsed + indexCount > std::numeric_limits<uint32_t>::max())
+        {
+            Logger::warning("Mesh pool is full, '{}' is drawn one object at a time", mesh.getName());
+            return nullptr;
+        }
+
+        size_t stride = layout.getStride();
+        size_t indexSize = getIndexSize(indexType);
+        copyBuffer(mesh.getVertexBufferId(), 0, vbo, vertexUsed * stride, vertexCount * stride);
+        copyBuffer(mesh.getIndexBufferId(), 0, ebo, indexUsed * indexSize, indexCount * indexSize);
+
+        Entry &entry = entries[&mesh];
+        entry.revision = mesh.getRevision();
+        entry.vertexCount = vertexCount;
+        entry.allocation.firstIndex = static_cast<uint32_t>(indexUsed);
+        entry.allocation.indexCount = static_cast<uint32_t>(indexCount);
+        entry.allocation.baseVertex = static_cast<int32_t>(vertexUsed);
+        entry.lastUsed = frame;
+
+        vertexUsed += vertexCount;
+        indexUsed += indexCount;
+        return &entry.allocation;
+    }
+
+    void OpenGLMeshPool::grow(size_t vertexCount, size_t indexCount, uint64_t frame)
+    {
+        ENGINE_PROFILE_SCOPE("Grow mesh pool");
+
+        // Only meshes drawn recently move along, the rest is dropped and copied again if it comes back
+        size_t liveVertices = vertexCount;
+        size_t liveIndices = indexCount;
+        for (const auto &entry : entries)
+        {
+            if (frame - entry.second.lastUsed <= RetainFrames)
+            {
+                liveVertices += entry.second.vertexCount;
+                liveIndices += entry.second.allocation.indexCount;
+            }
+        }
+
+        size_t stride = layout.getStride();
+        size_t indexSize = getIndexSize(indexType);
+        size_t newVertexCapacity = std::max(liveVertices * 2, MIN_VERTEX_CAPACITY);
+        size_t newIndexCapacity = std::max(liveIndices * 2, MIN_INDEX_CAPACITY);
+        GLuint newVbo = createBuffer(newVertexCapacity * stride);
+        GLuint newEbo = createBuffer(newIndexCapacity * indexSize);
+
+        size_t newVertexUsed = 0;
+        size_t newIndexUsed = 0;
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            Entry &entry = it->second;
+            if (frame - entry.lastUsed > RetainFrames)
+            {
+                it = entries.erase(it);
+                continue;
+            }
+
+            Allocation &allocation = entry.allocation;
+            copyBuffer(vbo, static_cast<size_t>(allocation.baseVertex) * stride, newVbo, newVertexUsed * stride,
+                       entry.vertexCount * stride);
+            copyBuffer(ebo, static_cast<size_t>(allocation.firstIndex) * indexSize, newEbo, newIndexUsed * indexSize,
+                       allocation.indexCount * indexSize);
+            allocation.baseVertex = static_cast<int32_t>(newVertexUsed);
+            allocation.firstIndex = static_cast<uint32_t>(newIndexUsed);
+            newVertexUsed += entry.vertexCount;
+            newIndexUsed += allocation.indexCount;
+            ++it;
+        }
+
+        if (vbo)
+        {
+            glDeleteBuffers(1, &vbo);
+            glDeleteBuffers(1, &ebo);
+        }
+        vbo = newVbo;
+        ebo = newEbo;
+        vertexCapacity = newVertexCapacity;
+        indexCapacity = newIndexCapacity;
+        vertexUsed = newVertexUsed;
+        indexUsed = newIndexUsed;
+        setupVertexArray();
+
+        Logger::info("Mesh pool ({} byte vertices) grown to {} vertices and {} indices", stride, vertexCapacity,
+                     indexCapacity);
+    }
+
+    void OpenGLMeshPool::setupVertexArray()
+    {
+        if (!vao)
+        {
+            glGenVertexArrays(1, &vao);
+        }
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        OpenGLMesh::setupVertexAttributes(layout);
+
+        // Every instance reads the index of its object, offset by the command's base instance
+        glBindBuffer(GL_ARRAY_BUFFER, objectIndexBuffer);
+        glEnableVertexAttribArray(objectIndexLocation);
+        glVertexAttribIPointer(objectIndexLocation, 1, GL_UNSIGNED_INT, 0, nullptr);
+        glVertexAttribDivisor(objectIndexLocation, 1);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void OpenGLMeshPool::bind() const
+    {
+        glBindVertexArray(vao);
+    }
+
+    uint32_t OpenGLMeshPool::getIndexFormat() const
+    {
+        return indexType == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    size_t OpenGLMeshPool::getMemorySize() const
+    {
+        return vertexUsed * layout.getStride() + indexUsed * getIndexSize(indexType);
+    }
+
+} // namespace Engine
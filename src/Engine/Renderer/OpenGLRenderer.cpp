@@ -1,16 +1,32 @@
 #include "Engine/Renderer/OpenGLRenderer.hpp"
 #include "Engine/Renderer/OpenGLWindow.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/RenderSnapshot.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/OpenGLShader.hpp"
+#include "Engine/Renderer/OpenGLMesh.hpp"
+#include "Engine/Math/Frustum.hpp"
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace Engine
 {
 
     OpenGLRenderer::OpenGLRenderer(const RendererConfig &config)
-        : Renderer(config), window(nullptr), activeCamera(nullptr), currentFrameBuffer(0)
+        : Renderer(config),
+          window(nullptr),
+          activeCamera(nullptr),
+          currentFrameBuffer(0),
+          lightPosition(0.0f, 10.0f, 0.0f),
+          lightColor(Vector3::One),
+          instanceBuffer(0)
     {
     }
 
@@ -61,6 +77,33 @@ namespace Engine
         Logger::info("OpenGL Version: " + std::string((const char *)glGetString(GL_VERSION)));
         Logger::info("GLSL Version: " + std::string((const char *)glGetString(GL_SHADING_LANGUAGE_VERSION)));
 
+        // Dynamic meshes map their buffers persistently where the driver allows it
+        OpenGLMesh::initializeExtensions((void *(*)(const char *))glfwGetProcAddress);
+
+        // Programs linked by this driver on an earlier launch are loaded instead of compiled
+        OpenGLShader::initializeExtensions((void *(*)(const char *))glfwGetProcAddress, config.parallelShaderCompile);
+        if (config.shaderBinaryCache && !config.shaderCachePath.empty())
+        {
+            std::string driver = std::string((const char *)glGetString(GL_VENDOR)) + "|" +
+                                 std::string((const char *)glGetString(GL_RENDERER)) + "|" +
+                                 std::string((const char *)glGetString(GL_VERSION));
+            if (shaderCache.initialize(config.shaderCachePath, driver))
+            {
+                OpenGLShader::setBinaryCache(&shaderCache);
+            }
+        }
+
+        // Static meshes are culled and drawn on the GPU where the context allows it
+        if (config.gpuDriven)
+        {
+            indirectRenderer = std::make_unique<OpenGLIndirectRenderer>();
+            if (!indirectRenderer->initialize((void *(*)(const char *))glfwGetProcAddress))
+            {
+                Logger::info("Drawing every object from the CPU");
+                indirectRenderer.reset();
+            }
+        }
+
         // Compile default shaders
         if (!compileDefaultShaders())
         {
@@ -68,6 +111,13 @@ namespace Engine
             return false;
         }
 
+        // Create the buffer that streams instance data
+        glGenBuffers(1, &instanceBuffer);
+
+        // Create the buffer shared by every shader that declares FrameData
+        frameUniformBuffer = std::make_unique<OpenGLUniformBuffer>();
+        frameUniformBuffer->create(sizeof(FrameUniforms));
+
         // Set default viewport
         glViewport(0, 0, width, height);
 
@@ -79,6 +129,19 @@ namespace Engine
     {
         // Clear default shaders
         defaultShaders.clear();
+        indirectRenderer.reset();
+
+        OpenGLShader::setBinaryCache(nullptr);
+        shaderCache.shutdown();
+
+        frameUniformBuffer.reset();
+        gpuTimer.shutdown();
+
+        if (instanceBuffer)
+        {
+            glDeleteBuffers(1, &instanceBuffer);
+            instanceBuffer = 0;
+        }
 
         // Shutdown window
         if (window)
@@ -90,55 +153,358 @@ namespace Engine
 
     void OpenGLRenderer::beginFrame()
     {
+        ENGINE_PROFILE_SCOPE("Begin frame");
+        frameStats.reset();
+
+        // Collects the timings of an earlier frame, so it must come before any pass
+        gpuTimer.beginFrame();
+
+        // Camera and light data stay bound for the whole frame
+        frameUniformBuffer->bind(UniformBinding::Frame);
+
         // Clear the color and depth buffers
+        gpuTimer.beginPass("Clear");
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gpuTimer.endPass();
     }
 
     void OpenGLRenderer::endFrame()
     {
+        ENGINE_PROFILE_SCOPE("End frame");
+
+        // Draw everything queued through drawMesh()
+        if (!renderQueue.empty() && activeCamera)
+        {
+            flushQueue(activeCamera->getViewMatrix(), activeCamera->getProjectionMatrix(), "Immediate");
+        }
+        renderQueue.clear();
+
+        lastFrameStats = frameStats;
+
         // Swap buffers
+        ENGINE_PROFILE_SCOPE("Swap buffers");
         window->swapBuffers();
     }
 
     void OpenGLRenderer::drawMesh(Mesh *mesh, Material *material, const Matrix4 &transform)
     {
-        if (!mesh || !material || !activeCamera)
+        if (!activeCamera)
+        {
+            return;
+        }
+
+        // Immediate draws have no history, so their level is picked without hysteresis
+        uint32_t lod = 0;
+        if (mesh)
+        {
+            float screenSize = Mesh::getScreenSize(mesh->getBoundingSphere().transformed(transform),
+                                                   activeCamera->getViewMatrix(), activeCamera->getProjectionMatrix());
+            lod = mesh->selectLod(screenSize * config.lodBias, 0, 0.0f);
+        }
+
+        queueMesh(mesh, material, transform, activeCamera->getViewMatrix(), Vector4::One, lod);
+    }
+
+    void OpenGLRenderer::renderSnapshot(const RenderSnapshot &snapshot)
+    {
+        if (!snapshot.hasCamera)
+        {
+            return;
+        }
+
+        frameStats.objectsCulled += snapshot.culledCount;
+
+        if (snapshot.hasLight)
         {
+            lightPosition = snapshot.lightPosition;
+            lightColor = snapshot.lightColor;
+        }
+
+        // Draws queued through drawMesh() belong to the active camera
+        if (!renderQueue.empty() && activeCamera)
+        {
+            flushQueue(activeCamera->getViewMatrix(), activeCamera->getProjectionMatrix(), "Immediate");
+        }
+        renderQueue.clear();
+
+        if (!indirectRenderer)
+        {
+            frameStats.objectsVisible += static_cast<uint32_t>(snapshot.items.size());
+            for (const RenderItem &item : snapshot.items)
+            {
+                queueMesh(item.mesh, item.material, item.transform, snapshot.view, item.color, item.lod);
+            }
+
+            flushQueue(snapshot.view, snapshot.projection, "Scene");
             return;
         }
 
-        // Bind shader from material
-        material->bind();
+        // The scene leaves the exact sphere test to the renderer; the GPU
+        // does it for what it draws, the rest is tested here
+        cpuItems.clear();
+        cpuSpheres.clear();
+        for (const RenderItem &item : snapshot.items)
+        {
+            if (!indirectRenderer->submit(item.mesh, item.material, item.transform, item.color, item.lod))
+            {
+                cpuItems.push_back(&item);
+                cpuSpheres.add(item.mesh->getBoundingSphere().transformed(item.transform));
+            }
+        }
+
+        Frustum frustum = Frustum::fromMatrix(snapshot.projection * snapshot.view);
+        frustum.cullSpheres(cpuSpheres, cpuCullResults);
+        for (size_t i = 0; i < cpuItems.size(); ++i)
+        {
+            if (cpuCullResults[i])
+            {
+                const RenderItem &item = *cpuItems[i];
+                queueMesh(item.mesh, item.material, item.transform, snapshot.view, item.color, item.lod);
+                ++frameStats.objectsVisible;
+            }
+            else
+            {
+                ++frameStats.objectsCulled;
+            }
+        }
+
+        // Uploads the FrameData buffer the indirect draws read as well
+        flushQueue(snapshot.view, snapshot.projection, "Scene");
+
+        if (!indirectRenderer->empty())
+        {
+            ENGINE_PROFILE_SCOPE("Scene (GPU-driven)");
+            gpuTimer.beginPass("Scene (GPU-driven)");
+            indirectRenderer->flush(snapshot.view, snapshot.projection, frameStats);
+            gpuTimer.endPass();
+        }
+    }
+
+    void OpenGLRenderer::queueMesh(Mesh *mesh, Material *material, const Matrix4 &transform, const Matrix4 &view,
+                                   const Vector4 &color, uint32_t lod)
+    {
+        if (!mesh || !material || !material->getShader())
+        {
+            return;
+        }
+
+        // View space looks down -Z, so the depth is the negated view Z of the origin
+        float depth = -(view.get(2, 0) * transform.get(0, 3) +
+                        view.get(2, 1) * transform.get(1, 3) +
+                        view.get(2, 2) * transform.get(2, 3) +
+                        view.get(2, 3));
+
+        renderQueue.submit(mesh, material, transform, depth, color, lod);
+    }
+
+    void OpenGLRenderer::uploadFrameUniforms(const Matrix4 &view, const Matrix4 &projection)
+    {
+        FrameUniforms frame;
+        std::memcpy(frame.view, view.getData(), sizeof(frame.view));
+        std::memcpy(frame.projection, projection.getData(), sizeof(frame.projection));
+        std::memcpy(frame.viewProjection, (projection * view).getData(), sizeof(frame.viewProjection));
+
+        // The camera sits at -R^T * t for a view matrix [R | t]
+        for (int i = 0; i < 3; ++i)
+        {
+            frame.cameraPosition[i] = -(view.get(0, i) * view.get(0, 3) +
+                                        view.get(1, i) * view.get(1, 3) +
+                                        view.get(2, i) * view.get(2, 3));
+        }
+        frame.cameraPosition[3] = 1.0f;
+
+        frame.lightPosition[0] = lightPosition.x;
+        frame.lightPosition[1] = lightPosition.y;
+        frame.lightPosition[2] = lightPosition.z;
+        frame.lightPosition[3] = 1.0f;
+        frame.lightColor[0] = lightColor.x;
+        frame.lightColor[1] = lightColor.y;
+        frame.lightColor[2] = lightColor.z;
+        frame.lightColor[3] = 1.0f;
+
+        frameUniformBuffer->setData(&frame, sizeof(frame));
+        frameStats.bufferUploadBytes += sizeof(frame);
+    }
+
+    void OpenGLRenderer::flushQueue(const Matrix4 &view, const Matrix4 &projection, const char *pass)
+    {
+        ENGINE_PROFILE_SCOPE(pass);
+        gpuTimer.beginPass(pass);
+
+        renderQueue.sort();
+        uploadFrameUniforms(view, projection);
+
+        // Split the sorted draws into runs of the same mesh, material, and
+        // level of detail; runs whose shader has an instanced variant become
+        // one draw call
+        instanceData.clear();
+        batches.clear();
+        size_t count = renderQueue.size();
+        for (size_t i = 0; i < count;)
+        {
+            const RenderCommand &first = renderQueue.getSorted(i);
+            if (!first.material->getShader()->getInstancedVariant())
+            {
+                batches.push_back({i, 1, 0, false});
+                ++i;
+                continue;
+            }
+
+            size_t end = i + 1;
+            while (end < count && renderQueue.getSorted(end).mesh == first.mesh &&
+                   renderQueue.getSorted(end).material == first.material && renderQueue.getSorted(end).lod == first.lod)
+            {
+                ++end;
+            }
+
+            batches.push_back({i, static_cast<uint32_t>(end - i), instanceData.size(), true});
+            for (; i < end; ++i)
+            {
+                const RenderCommand &command = renderQueue.getSorted(i);
+                InstanceData instance;
+                std::memcpy(instance.transform, command.transform.getData(), sizeof(instance.transform));
+                instance.color[0] = command.color.x;
+                instance.color[1] = command.color.y;
+                instance.color[2] = command.color.z;
+                instance.color[3] = command.color.w;
+                instanceData.push_back(instance);
+            }
+        }
+
+        // Upload the instances of the whole flush at once; respecifying the
+        // store lets the driver hand out fresh memory instead of waiting for
+        // draws of the previous frame that still read the buffer
+        if (!instanceData.empty())
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+            glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(InstanceData), instanceData.data(), GL_STREAM_DRAW);
+            frameStats.bufferUploadBytes += instanceData.size() * sizeof(InstanceData);
+        }
+
+        Shader *boundShader = nullptr;
+        Material *boundMaterial = nullptr;
+        Mesh *boundMesh = nullptr;
+        int modelLocation = -1;
+
+        for (const DrawBatch &batch : batches)
+        {
+            const RenderCommand &command = renderQueue.getSorted(batch.first);
+            Shader *shader = batch.instanced ? command.material->getShader()->getInstancedVariant()
+                                             : command.material->getShader();
+
+            if (shader != boundShader)
+            {
+                shader->bind();
+
+                // Shaders without the FrameData block take the camera as plain uniforms
+                if (!shader->usesFrameUniforms())
+                {
+                    shader->setMatrix4("view", view);
+                    shader->setMatrix4("projection", projection);
+                }
+
+                // Instanced variants read the model matrix from attributes
+                modelLocation = batch.instanced ? -1 : shader->getUniformLocation("model");
+
+                boundShader = shader;
+                boundMaterial = nullptr;
+                ++frameStats.shaderChanges;
+            }
+            else
+            {
+                ++frameStats.stateChangesAvoided;
+            }
+
+            if (command.material != boundMaterial)
+            {
+                // Give materials a MaterialData buffer the first time a
+                // shader that declares the block draws them
+                if (!command.material->getUniformBuffer() && !shader->getMaterialLayout().empty())
+                {
+                    command.material->setUniformBuffer(std::make_unique<OpenGLUniformBuffer>());
+                }
+
+                frameStats.textureBinds += command.material->applyParameters(*shader);
+                boundMaterial = command.material;
+                ++frameStats.materialChanges;
+            }
+            else
+            {
+                ++frameStats.stateChangesAvoided;
+            }
 
-        // Set common uniforms
-        material->getShader()->setMatrix4("model", transform);
-        material->getShader()->setMatrix4("view", activeCamera->getViewMatrix());
-        material->getShader()->setMatrix4("projection", activeCamera->getProjectionMatrix());
+            if (command.mesh != boundMesh)
+            {
+                command.mesh->bind();
+                boundMesh = command.mesh;
+                ++frameStats.meshChanges;
+            }
+            else
+            {
+                ++frameStats.stateChangesAvoided;
+            }
 
-        // Bind mesh
-        mesh->bind();
+            if (batch.instanced)
+            {
+                // Meshes drawn by this renderer are always OpenGL meshes
+                static_cast<OpenGLMesh *>(command.mesh)->setInstanceBuffer(instanceBuffer, batch.instanceOffset * sizeof(InstanceData));
+                command.mesh->drawInstanced(batch.count, command.lod);
+                ++frameStats.instancedDrawCalls;
+                frameStats.instances += batch.count;
+            }
+            else
+            {
+                shader->setMatrix4(modelLocation, command.transform);
+                command.mesh->draw(command.lod);
+            }
+            ++frameStats.drawCalls;
 
-        // Draw mesh
-        mesh->draw();
+            // Unindexed meshes draw their vertices as a plain triangle list
+            size_t indices = command.mesh->getIndexCount() > 0 ? command.mesh->getLod(command.lod).indexCount : command.mesh->getVertexCount();
+            frameStats.vertices += static_cast<uint64_t>(command.mesh->getVertexCount()) * batch.count;
+            frameStats.triangles += static_cast<uint64_t>(indices / 3) * batch.count;
+            if (command.lod > 0 && command.mesh->getIndexCount() > 0)
+            {
+                size_t fullIndices = command.mesh->getLod(0).indexCount;
+                frameStats.trianglesSavedByLod += static_cast<uint64_t>((fullIndices - std::min(fullIndices, indices)) / 3) * batch.count;
+            }
+        }
 
-        // Unbind mesh
-        mesh->unbind();
+        // Leave the pipeline in the unbound state other code expects
+        if (boundMesh)
+        {
+            boundMesh->unbind();
+        }
+        if (boundMaterial)
+        {
+            boundMaterial->unbind();
+        }
+        if (boundShader)
+        {
+            boundShader->unbind();
+        }
 
-        // Unbind shader
-        material->unbind();
+        renderQueue.clear();
+        gpuTimer.endPass();
     }
 
-    void OpenGLRenderer::setCamera(Camera *camera)
+    void OpenGLRenderer::setCamera(CameraComponent *camera)
     {
         activeCamera = camera;
     }
 
-    Camera *OpenGLRenderer::getCamera() const
+    CameraComponent *OpenGLRenderer::getCamera() const
     {
         return activeCamera;
     }
 
+    Shader *OpenGLRenderer::getDefaultShader(const std::string &name) const
+    {
+        auto it = defaultShaders.find(name);
+        return it != defaultShaders.end() ? it->second.get() : nullptr;
+    }
+
     Window *OpenGLRenderer::getWindow() const
     {
         return window.get();
@@ -159,8 +525,16 @@ namespace Engine
             layout (location = 2) in vec2 aTexCoord;
             
             uniform mat4 model;
-            uniform mat4 view;
-            uniform mat4 projection;
+            
+            layout (std140) uniform FrameData
+            {
+                mat4 view;
+                mat4 projection;
+                mat4 viewProjection;
+                vec4 cameraPosition;
+                vec4 lightPosition;
+                vec4 lightColor;
+            };
             
             out vec3 FragPos;
             out vec3 Normal;
@@ -171,7 +545,7 @@ namespace Engine
                 FragPos = vec3(model * vec4(aPos, 1.0));
                 Normal = mat3(transpose(inverse(model))) * aNormal;
                 TexCoord = aTexCoord;
-                gl_Position = projection * view * vec4(FragPos, 1.0);
+                gl_Position = viewProjection * vec4(FragPos, 1.0);
             }
         )";
 
@@ -184,32 +558,43 @@ namespace Engine
             in vec3 Normal;
             in vec2 TexCoord;
             
-            uniform vec3 viewPos;
-            uniform vec3 lightPos;
-            uniform vec3 lightColor;
-            uniform vec3 objectColor;
-            uniform float ambientStrength;
-            uniform float specularStrength;
-            uniform float shininess;
+            layout (std140) uniform FrameData
+            {
+                mat4 view;
+                mat4 projection;
+                mat4 viewProjection;
+                vec4 cameraPosition;
+                vec4 lightPosition;
+                vec4 lightColor;
+            };
+            
+            layout (std140) uniform MaterialData
+            {
+                vec3 objectColor;
+                float ambientStrength;
+                float specularStrength;
+                float shininess;
+                bool hasTexture;
+            };
+            
             uniform sampler2D diffuseTexture;
-            uniform bool hasTexture;
             
             void main()
             {
                 // Ambient
-                vec3 ambient = ambientStrength * lightColor;
+                vec3 ambient = ambientStrength * lightColor.rgb;
                 
                 // Diffuse
                 vec3 norm = normalize(Normal);
-                vec3 lightDir = normalize(lightPos - FragPos);
+                vec3 lightDir = normalize(lightPosition.xyz - FragPos);
                 float diff = max(dot(norm, lightDir), 0.0);
-                vec3 diffuse = diff * lightColor;
+                vec3 diffuse = diff * lightColor.rgb;
                 
                 // Specular
-                vec3 viewDir = normalize(viewPos - FragPos);
+                vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
                 vec3 reflectDir = reflect(-lightDir, norm);
                 float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
-                vec3 specular = specularStrength * spec * lightColor;
+                vec3 specular = specularStrength * spec * lightColor.rgb;
                 
                 // Combine
                 vec3 baseColor = hasTexture ? texture(diffuseTexture, TexCoord).rgb : objectColor;
@@ -218,16 +603,192 @@ namespace Engine
             }
         )";
 
-        // Create Phong shader
+        // Start the Phong shader; with parallel compilation the driver works on it while the next one starts
         auto phongShader = std::make_unique<OpenGLShader>("Phong");
-        if (!phongShader->compile(phongVertexShader, phongFragmentShader))
+        phongShader->beginCompile(phongVertexShader, phongFragmentShader);
+
+        // Define instanced vertex shader source; the model matrix and the
+        // colour come from the instance buffer instead of uniforms
+        const std::string phongInstancedVertexShader = R"(
+            #version 330 core
+            layout (location = 0) in vec3 aPos;
+            layout (location = 1) in vec3 aNormal;
+            layout (location = 2) in vec2 aTexCoord;
+            layout (location = 8) in mat4 aInstanceModel;
+            layout (location = 12) in vec4 aInstanceColor;
+            
+            layout (std140) uniform FrameData
+            {
+                mat4 view;
+                mat4 projection;
+                mat4 viewProjection;
+                vec4 cameraPosition;
+                vec4 lightPosition;
+                vec4 lightColor;
+            };
+            
+            out vec3 FragPos;
+            out vec3 Normal;
+            out vec2 TexCoord;
+            out vec4 InstanceColor;
+            
+            void main()
+            {
+                FragPos = vec3(aInstanceModel * vec4(aPos, 1.0));
+                Normal = mat3(transpose(inverse(aInstanceModel))) * aNormal;
+                TexCoord = aTexCoord;
+                InstanceColor = aInstanceColor;
+                gl_Position = viewProjection * vec4(FragPos, 1.0);
+            }
+        )";
+
+        // Define instanced fragment shader source
+        const std::string phongInstancedFragmentShader = R"(
+            #version 330 core
+            out vec4 FragColor;
+            
+            in vec3 FragPos;
+            in vec3 Normal;
+            in vec2 TexCoord;
+            in vec4 InstanceColor;
+            
+            layout (std140) uniform FrameData
+            {
+                mat4 view;
+                mat4 projection;
+                mat4 viewProjection;
+                vec4 cameraPosition;
+                vec4 lightPosition;
+                vec4 lightColor;
+            };
+            
+            layout (std140) uniform MaterialData
+            {
+                vec3 objectColor;
+                float ambientStrength;
+                float specularStrength;
+                float shininess;
+                bool hasTexture;
+            };
+            
+            uniform sampler2D diffuseTexture;
+            
+            void main()
+            {
+                // Ambient
+                vec3 ambient = ambientStrength * lightColor.rgb;
+                
+                // Diffuse
+                vec3 norm = normalize(Normal);
+                vec3 lightDir = normalize(lightPosition.xyz - FragPos);
+                float diff = max(dot(norm, lightDir), 0.0);
+                vec3 diffuse = diff * lightColor.rgb;
+                
+                // Specular
+                vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+                vec3 reflectDir = reflect(-lightDir, norm);
+                float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+                vec3 specular = specularStrength * spec * lightColor.rgb;
+                
+                // Combine
+                vec3 baseColor = (hasTexture ? texture(diffuseTexture, TexCoord).rgb : objectColor) * InstanceColor.rgb;
+                vec3 result = (ambient + diffuse + specular) * baseColor;
+                FragColor = vec4(result, InstanceColor.a);
+            }
+        )";
+
+        // Start the instanced Phong shader
+        auto phongInstancedShader = std::make_unique<OpenGLShader>("PhongInstanced");
+        phongInstancedShader->beginCompile(phongInstancedVertexShader, phongInstancedFragmentShader);
+
+        // Define the indirect vertex shader source; every instance reads its
+        // object from the ObjectData buffer, at the index the culling pass
+        // stored for it in the attribute at OpenGLIndirectRenderer::ObjectIndexLocation
+        const std::string phongIndirectVertexShader = R"(
+            #version 430 core
+            layout (location = 0) in vec3 aPos;
+            layout (location = 1) in vec3 aNormal;
+            layout (location = 2) in vec2 aTexCoord;
+            layout (location = 13) in uint aObjectIndex;
+            
+            struct ObjectData
+            {
+                mat4 transform;
+                vec4 color;
+                vec4 boundingSphere;
+                uvec4 command;
+            };
+            
+            layout (std430, binding = 0) readonly buffer Objects
+            {
+                ObjectData objects[];
+            };
+            
+            layout (std140) uniform FrameData
+            {
+                mat4 view;
+                mat4 projection;
+                mat4 viewProjection;
+                vec4 cameraPosition;
+                vec4 lightPosition;
+                vec4 lightColor;
+            };
+            
+            out vec3 FragPos;
+            out vec3 Normal;
+            out vec2 TexCoord;
+            out vec4 InstanceColor;
+            
+            void main()
+            {
+                mat4 model = objects[aObjectIndex].transform;
+                FragPos = vec3(model * vec4(aPos, 1.0));
+                Normal = mat3(transpose(inverse(model))) * aNormal;
+                TexCoord = aTexCoord;
+                InstanceColor = objects[aObjectIndex].color;
+                gl_Position = viewProjection * vec4(FragPos, 1.0);
+            }
+        )";
+
+        // Start the indirect Phong shader, which shares the instanced fragment shader
+        std::unique_ptr<OpenGLShader> phongIndirectShader;
+        if (indirectRenderer)
+        {
+            phongIndirectShader = std::make_unique<OpenGLShader>("PhongIndirect");
+            phongIndirectShader->beginCompile(phongIndirectVertexShader, phongInstancedFragmentShader);
+        }
+
+        if (!phongShader->finishCompile())
         {
             Logger::error("Failed to compile Phong shader");
             return false;
         }
 
+        if (!phongInstancedShader->finishCompile())
+        {
+            Logger::error("Failed to compile instanced Phong shader");
+            return false;
+        }
+
+        // Materials using Phong are drawn through the instanced variant
+        phongShader->setInstancedVariant(phongInstancedShader.get());
+
+        // A driver that cannot build the indirect shader still draws everything from the CPU
+        if (phongIndirectShader && !phongIndirectShader->finishCompile())
+        {
+            Logger::warning("Failed to compile indirect Phong shader, drawing every object from the CPU");
+            phongIndirectShader.reset();
+            indirectRenderer.reset();
+        }
+        if (phongIndirectShader)
+        {
+            phongShader->setIndirectVariant(phongIndirectShader.get());
+            defaultShaders["PhongIndirect"] = std::move(phongIndirectShader);
+        }
+
         // Add to default shaders
         defaultShaders["Phong"] = std::move(phongShader);
+        defaultShaders["PhongInstanced"] = std::move(phongInstancedShader);
 
         return true;
     }
@@ -1,78 +1,272 @@
 #include "Engine/Renderer/OpenGLShader.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Renderer/ShaderCache.hpp"
 
 #include <glad/glad.h>
 
+#include <cstring>
+#include <vector>
+
 namespace Engine
 {
 
+    namespace
+    {
+        typedef void(APIENTRY *GetProgramBinaryFunction)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+        typedef void(APIENTRY *ProgramBinaryFunction)(GLuint, GLenum, const void *, GLsizei);
+        typedef void(APIENTRY *ProgramParameteriFunction)(GLuint, GLenum, GLint);
+        typedef void(APIENTRY *MaxShaderCompilerThreadsFunction)(GLuint);
+
+        // Core in GL 4.1 and GL_ARB_get_program_binary, not in the 3.3 loader
+        const GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+        const GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+        const GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+        // Same value in GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile
+        const GLenum COMPLETION_STATUS = 0x91B1;
+
+        /**
+         * @brief Optional entry points, loaded by OpenGLShader::initializeExtensions()
+         */
+        struct ShaderExtensions
+        {
+            GetProgramBinaryFunction getProgramBinary = nullptr;
+            ProgramBinaryFunction programBinary = nullptr;
+            ProgramParameteriFunction programParameteri = nullptr;
+
+            /**
+             * @brief Flag that indicates if the driver compiles on its own threads
+             */
+            bool parallelCompile = false;
+        };
+
+        ShaderExtensions extensions;
+
+        /**
+         * @brief Cache set by OpenGLShader::setBinaryCache()
+         */
+        ShaderCache *binaryCache = nullptr;
+
+        /**
+         * @brief Checks if the current context reports an extension
+         * @param name Extension name
+         * @return True if the extension is supported
+         */
+        bool hasExtension(const char *name)
+        {
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count; ++i)
+            {
+                const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if (extension && std::strcmp(extension, name) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks the compile status of a shader and logs its errors
+         * @param shader Shader object
+         * @param stage Stage name for the log
+         * @return True if the shader compiled
+         */
+        bool checkCompileStatus(uint32_t shader, const char *stage)
+        {
+            int success = 0;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success)
+            {
+                char infoLog[512];
+                glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+                Logger::error(std::string(stage) + " shader compilation failed: " + std::string(infoLog));
+                return false;
+            }
+            return true;
+        }
+    }
+
     OpenGLShader::OpenGLShader(const std::string &name)
-        : Shader(name), programId(0)
+        : Shader(name),
+          programId(0),
+          pendingProgram(0),
+          pendingVertexShader(0),
+          pendingFragmentShader(0),
+          pendingSourceHash(0),
+          pendingFromCache(false),
+          fromBinaryCache(false)
     {
     }
 
     OpenGLShader::~OpenGLShader()
     {
+        discardPending();
         if (programId)
         {
             glDeleteProgram(programId);
         }
     }
 
+    void OpenGLShader::initializeExtensions(void *(*loader)(const char *), bool parallelCompile)
+    {
+        extensions = ShaderExtensions();
+
+        // Some drivers expose the entry points but no binary format
+        GLint formats = 0;
+        glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+        if (formats > 0 && hasExtension("GL_ARB_get_program_binary"))
+        {
+            extensions.getProgramBinary = reinterpret_cast<GetProgramBinaryFunction>(loader("glGetProgramBinary"));
+            extensions.programBinary = reinterpret_cast<ProgramBinaryFunction>(loader("glProgramBinary"));
+            extensions.programParameteri = reinterpret_cast<ProgramParameteriFunction>(loader("glProgramParameteri"));
+            if (!extensions.getProgramBinary || !extensions.programBinary || !extensions.programParameteri)
+            {
+                extensions.getProgramBinary = nullptr;
+                extensions.programBinary = nullptr;
+                extensions.programParameteri = nullptr;
+            }
+        }
+
+        if (parallelCompile)
+        {
+            MaxShaderCompilerThreadsFunction maxThreads = nullptr;
+            if (hasExtension("GL_KHR_parallel_shader_compile"))
+            {
+                maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(loader("glMaxShaderCompilerThreadsKHR"));
+            }
+            else if (hasExtension("GL_ARB_parallel_shader_compile"))
+            {
+                maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(loader("glMaxShaderCompilerThreadsARB"));
+            }
+
+            // Let the driver pick the number of threads
+            if (maxThreads)
+            {
+                maxThreads(0xFFFFFFFFu);
+                extensions.parallelCompile = true;
+            }
+        }
+
+        Logger::info("Program binaries {}, parallel shader compilation {}",
+                     extensions.programBinary ? "supported" : "unsupported",
+                     extensions.parallelCompile ? "enabled" : "disabled");
+    }
+
+    void OpenGLShader::setBinaryCache(ShaderCache *cache)
+    {
+        binaryCache = cache;
+    }
+
     bool OpenGLShader::compile(const std::string &vertexSource, const std::string &fragmentSource)
     {
-        // Create vertex shader
-        uint32_t vertexShader = glCreateShader(GL_VERTEX_SHADER);
-        const char *vertexSourcePtr = vertexSource.c_str();
-        glShaderSource(vertexShader, 1, &vertexSourcePtr, nullptr);
-        glCompileShader(vertexShader);
+        beginCompile(vertexSource, fragmentSource);
+        return finishCompile();
+    }
 
-        // Check vertex shader compilation errors
-        int success;
-        char infoLog[512];
-        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-        if (!success)
+    void OpenGLShader::beginCompile(const std::string &vertexSource, const std::string &fragmentSource)
+    {
+        discardPending();
+        pendingSourceHash = ShaderCache::hashSources(vertexSource, fragmentSource);
+        pendingProgram = glCreateProgram();
+
+        pendingFromCache = loadBinary();
+        if (pendingFromCache)
         {
-            glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-            Logger::error("Vertex shader compilation failed: " + std::string(infoLog));
-            return false;
+            return;
         }
 
-        // Create fragment shader
-        uint32_t fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        // Compile both stages and link without checking, so the driver is never waited on here
+        pendingVertexShader = glCreateShader(GL_VERTEX_SHADER);
+        const char *vertexSourcePtr = vertexSource.c_str();
+        glShaderSource(pendingVertexShader, 1, &vertexSourcePtr, nullptr);
+        glCompileShader(pendingVertexShader);
+
+        pendingFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
         const char *fragmentSourcePtr = fragmentSource.c_str();
-        glShaderSource(fragmentShader, 1, &fragmentSourcePtr, nullptr);
-        glCompileShader(fragmentShader);
+        glShaderSource(pendingFragmentShader, 1, &fragmentSourcePtr, nullptr);
+        glCompileShader(pendingFragmentShader);
 
-        // Check fragment shader compilation errors
-        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-        if (!success)
+        glAttachShader(pendingProgram, pendingVertexShader);
+        glAttachShader(pendingProgram, pendingFragmentShader);
+        if (extensions.programParameteri && binaryCache && binaryCache->isEnabled())
+        {
+            extensions.programParameteri(pendingProgram, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(pendingProgram);
+    }
+
+    bool OpenGLShader::isCompileComplete() const
+    {
+        if (!pendingProgram || pendingFromCache || !extensions.parallelCompile)
         {
-            glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-            Logger::error("Fragment shader compilation failed: " + std::string(infoLog));
+            return true;
+        }
+
+        GLint complete = GL_FALSE;
+        glGetProgramiv(pendingProgram, COMPLETION_STATUS, &complete);
+        return complete == GL_TRUE;
+    }
+
+    bool OpenGLShader::finishCompile()
+    {
+        if (!pendingProgram)
+        {
+            Logger::error("Shader '" + name + "' has no compile in progress");
             return false;
         }
 
-        // Create and link shader program
-        programId = glCreateProgram();
-        glAttachShader(programId, vertexShader);
-        glAttachShader(programId, fragmentShader);
-        glLinkProgram(programId);
+        // Check compilation errors
+        if (!pendingFromCache && (!checkCompileStatus(pendingVertexShader, "Vertex") ||
+                                  !checkCompileStatus(pendingFragmentShader, "Fragment")))
+        {
+            discardPending();
+            return false;
+        }
 
         // Check linking errors
-        glGetProgramiv(programId, GL_LINK_STATUS, &success);
+        int success;
+        glGetProgramiv(pendingProgram, GL_LINK_STATUS, &success);
         if (!success)
         {
-            glGetProgramInfoLog(programId, 512, nullptr, infoLog);
+            char infoLog[512];
+            glGetProgramInfoLog(pendingProgram, 512, nullptr, infoLog);
             Logger::error("Shader program linking failed: " + std::string(infoLog));
+            discardPending();
             return false;
         }
 
+        if (!pendingFromCache)
+        {
+            storeBinary();
+        }
+
         // Delete shaders
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        if (pendingVertexShader)
+        {
+            glDeleteShader(pendingVertexShader);
+            glDeleteShader(pendingFragmentShader);
+            pendingVertexShader = 0;
+            pendingFragmentShader = 0;
+        }
 
-        Logger::info("Shader '" + name + "' compiled successfully");
+        if (programId)
+        {
+            glDeleteProgram(programId);
+        }
+        programId = pendingProgram;
+        pendingProgram = 0;
+        fromBinaryCache = pendingFromCache;
+
+        reflectUniformBlocks();
+
+        // Locations and uniform values of an older program no longer apply
+        uniformLocationCache.clear();
+        appliedMaterial = 0;
+        ++revision;
+
+        Logger::info("Shader '" + name + (fromBinaryCache ? "' loaded from the binary cache" : "' compiled successfully"));
         return true;
     }
 
@@ -88,37 +282,72 @@ namespace Engine
 
     void OpenGLShader::setInt(const std::string &name, int value)
     {
-        glUniform1i(getUniformLocation(name), value);
+        setInt(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setFloat(const std::string &name, float value)
     {
-        glUniform1f(getUniformLocation(name), value);
+        setFloat(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setVector2(const std::string &name, const Vector2 &value)
     {
-        glUniform2f(getUniformLocation(name), value.x, value.y);
+        setVector2(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setVector3(const std::string &name, const Vector3 &value)
     {
-        glUniform3f(getUniformLocation(name), value.x, value.y, value.z);
+        setVector3(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setVector4(const std::string &name, const Vector4 &value)
     {
-        glUniform4f(getUniformLocation(name), value.x, value.y, value.z, value.w);
+        setVector4(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setMatrix3(const std::string &name, const Matrix3 &value)
     {
-        glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE, value.getData());
+        setMatrix3(getUniformLocation(name), value);
     }
 
     void OpenGLShader::setMatrix4(const std::string &name, const Matrix4 &value)
     {
-        glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, value.getData());
+        setMatrix4(getUniformLocation(name), value);
+    }
+
+    void OpenGLShader::setInt(int location, int value)
+    {
+        glUniform1i(location, value);
+    }
+
+    void OpenGLShader::setFloat(int location, float value)
+    {
+        glUniform1f(location, value);
+    }
+
+    void OpenGLShader::setVector2(int location, const Vector2 &value)
+    {
+        glUniform2f(location, value.x, value.y);
+    }
+
+    void OpenGLShader::setVector3(int location, const Vector3 &value)
+    {
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+
+    void OpenGLShader::setVector4(int location, const Vector4 &value)
+    {
+        glUniform4f(location, value.x, value.y, value.z, value.w);
+    }
+
+    void OpenGLShader::setMatrix3(int location, const Matrix3 &value)
+    {
+        glUniformMatrix3fv(location, 1, GL_FALSE, value.getData());
+    }
+
+    void OpenGLShader::setMatrix4(int location, const Matrix4 &value)
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, value.getData());
     }
 
     int OpenGLShader::getUniformLocation(const std::string &name)
@@ -142,4 +371,122 @@ namespace Engine
         return location;
     }
 
+    void OpenGLShader::reflectUniformBlocks()
+    {
+        // GLSL 3.30 cannot declare binding points, so assign them here
+        uint32_t frameIndex = glGetUniformBlockIndex(programId, "FrameData");
+        frameUniforms = frameIndex != GL_INVALID_INDEX;
+        if (frameUniforms)
+        {
+            glUniformBlockBinding(programId, frameIndex, static_cast<GLuint>(UniformBinding::Frame));
+        }
+
+        materialLayout = UniformBlockLayout();
+        uint32_t materialIndex = glGetUniformBlockIndex(programId, "MaterialData");
+        if (materialIndex == GL_INVALID_INDEX)
+        {
+            return;
+        }
+
+        glUniformBlockBinding(programId, materialIndex, static_cast<GLuint>(UniformBinding::Material));
+
+        GLint size = 0;
+        GLint count = 0;
+        glGetActiveUniformBlockiv(programId, materialIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+        glGetActiveUniformBlockiv(programId, materialIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &count);
+
+        std::vector<GLint> indices(count);
+        glGetActiveUniformBlockiv(programId, materialIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+
+        std::vector<GLuint> uniformIndices(indices.begin(), indices.end());
+        std::vector<GLint> offsets(count);
+        glGetActiveUniformsiv(programId, count, uniformIndices.data(), GL_UNIFORM_OFFSET, offsets.data());
+
+        // Members are addressed by the same names Material uses for its parameters
+        for (GLint i = 0; i < count; ++i)
+        {
+            char uniformName[128];
+            GLsizei length = 0;
+            glGetActiveUniformName(programId, uniformIndices[i], sizeof(uniformName), &length, uniformName);
+            materialLayout.offsets[std::string(uniformName, length)] = static_cast<uint32_t>(offsets[i]);
+        }
+
+        materialLayout.size = static_cast<uint32_t>(size);
+    }
+
+    bool OpenGLShader::loadBinary()
+    {
+        if (!extensions.programBinary || !binaryCache)
+        {
+            return false;
+        }
+
+        uint32_t format = 0;
+        std::vector<unsigned char> binary;
+        if (!binaryCache->load(pendingSourceHash, format, binary))
+        {
+            return false;
+        }
+
+        extensions.programBinary(pendingProgram, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        int success = 0;
+        glGetProgramiv(pendingProgram, GL_LINK_STATUS, &success);
+        if (success)
+        {
+            return true;
+        }
+
+        // Drivers may reject binaries of an older build that reports the same version
+        Logger::info("Cached binary of shader '" + name + "' was rejected, compiling from source");
+        binaryCache->remove(pendingSourceHash);
+        glDeleteProgram(pendingProgram);
+        pendingProgram = glCreateProgram();
+        return false;
+    }
+
+    void OpenGLShader::storeBinary()
+    {
+        if (!extensions.getProgramBinary || !binaryCache || !binaryCache->isEnabled())
+        {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(pendingProgram, PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        std::vector<unsigned char> binary(static_cast<size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        extensions.getProgramBinary(pendingProgram, length, &written, &format, binary.data());
+        if (written > 0)
+        {
+            binaryCache->store(pendingSourceHash, format, binary.data(), static_cast<size_t>(written));
+        }
+    }
+
+    void OpenGLShader::discardPending()
+    {
+        if (pendingVertexShader)
+        {
+            glDeleteShader(pendingVertexShader);
+            pendingVertexShader = 0;
+        }
+        if (pendingFragmentShader)
+        {
+            glDeleteShader(pendingFragmentShader);
+            pendingFragmentShader = 0;
+        }
+        if (pendingProgram)
+        {
+            glDeleteProgram(pendingProgram);
+            pendingProgram = 0;
+        }
+        pendingFromCache = false;
+    }
+
 } // namespace Engine
\ No newline at end of file
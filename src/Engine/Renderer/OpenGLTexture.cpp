@@ -1,13 +1,106 @@
 // src/Engine/Renderer/OpenGLTexture.cpp
 #include "Engine/Renderer/OpenGLTexture.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Resources/TextureFile.hpp"
 
 #include <glad/glad.h>
 #include <stb_image.h>
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// Compressed formats from extensions that the GL loader may not define
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_6x6_KHR
+#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR 0x93B4
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_8x8_KHR
+#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR 0x93B7
+#endif
+
 namespace Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Compressed format families the context can sample
+         */
+        struct CompressionSupport
+        {
+            bool s3tc = false;
+            bool rgtc = false;
+            bool bptc = false;
+            bool etc2 = false;
+            bool astc = false;
+        };
+
+        /**
+         * @brief Queries the compressed formats of the current context
+         * @return Supported format families
+         */
+        CompressionSupport queryCompressionSupport()
+        {
+            GLint major = 0;
+            GLint minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+            int version = major * 10 + minor;
+
+            CompressionSupport support;
+            support.rgtc = version >= 30;
+            support.bptc = version >= 42;
+            support.etc2 = version >= 43;
+
+            GLint extensionCount = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+            for (GLint i = 0; i < extensionCount; ++i)
+            {
+                const char *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if (!name)
+                {
+                    continue;
+                }
+                if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+                {
+                    support.s3tc = true;
+                }
+                else if (std::strcmp(name, "GL_ARB_texture_compression_bptc") == 0)
+                {
+                    support.bptc = true;
+                }
+                else if (std::strcmp(name, "GL_ARB_ES3_compatibility") == 0)
+                {
+                    support.etc2 = true;
+                }
+                else if (std::strcmp(name, "GL_KHR_texture_compression_astc_ldr") == 0)
+                {
+                    support.astc = true;
+                }
+            }
+
+            return support;
+        }
+    }
+
     OpenGLTexture::OpenGLTexture()
         : textureId(0)
     {
@@ -25,9 +118,35 @@ namespace Engine
 
     bool OpenGLTexture::load(const std::string &filepath)
     {
+        AssetData file;
+        if (!file.mapFile(filepath))
+        {
+            return false;
+        }
+
+        // Containers already hold every mip level, so upload them as they are
+        if (TextureFile::isContainer(file.getData(), file.getSize()))
+        {
+            TextureFile texture;
+            if (!texture.open(std::move(file), filepath) ||
+                !allocate(texture.getWidth(), texture.getHeight(), texture.getFormat(), texture.getMipCount()))
+            {
+                return false;
+            }
+            for (int level = texture.getMipCount() - 1; level >= 0; --level)
+            {
+                if (!uploadMip(level, texture.getMipData(level), texture.getMipSize(level)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         // Load image
         int channels;
-        unsigned char *data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+        unsigned char *data = stbi_load_from_memory(file.getData(), static_cast<int>(file.getSize()),
+                                                    &width, &height, &channels, 0);
         if (!data)
         {
             Logger::error("Failed to load texture: " + filepath);
@@ -64,6 +183,8 @@ namespace Engine
         this->width = width;
         this->height = height;
         this->format = format;
+        this->mipCount = getMipLevelCount(width, height);
+        this->residentMip = 0;
 
         // Bind texture
         glBindTexture(GL_TEXTURE_2D, textureId);
@@ -136,6 +257,140 @@ namespace Engine
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
+    bool OpenGLTexture::allocate(int width, int height, TextureFormat format, int mipCount)
+    {
+        if (!isFormatSupported(format))
+        {
+            Logger::error("Texture format not supported by this GPU");
+            return false;
+        }
+
+        this->width = width;
+        this->height = height;
+        this->format = format;
+        this->mipCount = std::max(1, std::min(mipCount, getMipLevelCount(width, height)));
+        this->residentMip = this->mipCount;
+
+        // Sampling is clamped to the resident levels through the base level
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, this->mipCount - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, this->mipCount - 1);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        setFilter(this->mipCount > 1 ? TextureFilter::LinearMipmap : TextureFilter::Linear, TextureFilter::Linear);
+        setWrap(TextureWrap::Repeat, TextureWrap::Repeat);
+
+        return true;
+    }
+
+    bool OpenGLTexture::uploadMip(int level, const unsigned char *data, size_t size)
+    {
+        if (level != residentMip - 1)
+        {
+            Logger::error("Mip levels must be uploaded coarsest first");
+            return false;
+        }
+
+        int levelWidth = std::max(1, width >> level);
+        int levelHeight = std::max(1, height >> level);
+        size_t levelSize = getTextureLevelSize(format, levelWidth, levelHeight);
+        if (size < levelSize)
+        {
+            Logger::error("Mip level data too small");
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, textureId);
+
+        unsigned int glInternalFormat = getGLFormat(format, true);
+        if (isCompressedFormat(format))
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, glInternalFormat, levelWidth, levelHeight, 0,
+                                   static_cast<GLsizei>(levelSize), data);
+        }
+        else
+        {
+            // Rows of the small levels are not 4 byte aligned
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(GL_TEXTURE_2D, level, glInternalFormat, levelWidth, levelHeight, 0, getGLFormat(format),
+                         GL_UNSIGNED_BYTE, data);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+        // Start sampling from the new level
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        residentMip = level;
+        return true;
+    }
+
+    void OpenGLTexture::dropMips(int level)
+    {
+        level = std::min(level, mipCount - 1);
+        if (level <= residentMip)
+        {
+            return;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, textureId);
+
+        // Stop sampling the levels before freeing them
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+
+        // Redefining a level as empty releases its storage
+        unsigned int glInternalFormat = getGLFormat(format, true);
+        for (int dropped = residentMip; dropped < level; ++dropped)
+        {
+            if (isCompressedFormat(format))
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, dropped, glInternalFormat, 0, 0, 0, 0, nullptr);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, dropped, glInternalFormat, 0, 0, 0, getGLFormat(format), GL_UNSIGNED_BYTE, nullptr);
+            }
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        residentMip = level;
+    }
+
+    void OpenGLTexture::swapContents(Texture &other)
+    {
+        // Both textures come from the same renderer
+        std::swap(textureId, static_cast<OpenGLTexture &>(other).textureId);
+        Texture::swapContents(other);
+    }
+
+    bool OpenGLTexture::isFormatSupported(TextureFormat format)
+    {
+        // The answer does not change for the lifetime of the context
+        static const CompressionSupport support = queryCompressionSupport();
+
+        switch (format)
+        {
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+            return support.s3tc;
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+            return support.rgtc;
+        case TextureFormat::BC7:
+            return support.bptc;
+        case TextureFormat::ETC2RGB:
+        case TextureFormat::ETC2RGBA:
+            return support.etc2;
+        case TextureFormat::ASTC4x4:
+        case TextureFormat::ASTC6x6:
+        case TextureFormat::ASTC8x8:
+            return support.astc;
+        default:
+            return true;
+        }
+    }
+
     unsigned int OpenGLTexture::getGLFilter(TextureFilter filter, bool mipmap) const
     {
         switch (filter)
@@ -180,6 +435,26 @@ namespace Engine
             return internal ? GL_RGBA8 : GL_RGBA;
         case TextureFormat::Depth:
             return internal ? GL_DEPTH_COMPONENT24 : GL_DEPTH_COMPONENT;
+        case TextureFormat::BC1:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case TextureFormat::BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC4:
+            return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::BC5:
+            return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case TextureFormat::ETC2RGB:
+            return GL_COMPRESSED_RGB8_ETC2;
+        case TextureFormat::ETC2RGBA:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case TextureFormat::ASTC4x4:
+            return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case TextureFormat::ASTC6x6:
+            return GL_COMPRESSED_RGBA_ASTC_6x6_KHR;
+        case TextureFormat::ASTC8x8:
+            return GL_COMPRESSED_RGBA_ASTC_8x8_KHR;
         default:
             return GL_RGBA;
         }
@@ -205,10 +480,3 @@ std::unique_ptr<Mesh> ResourceManager::createMesh(const std::string &name)
     return std::make_unique<OpenGLMesh>(name);
 }
 
-bool ResourceManager::loadMeshFromFile(Mesh *mesh, const std::string &filepath)
-{
-    // This would typically use a model loading library like Assimp
-    // For now, just a placeholder
-    Logger::warning("Mesh loading from file not implemented yet: " + filepath);
-    return false;
-}
\ No newline at end of file
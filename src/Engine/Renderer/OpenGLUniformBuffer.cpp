@@ -0,0 +1,55 @@
+#include "Engine/Renderer/OpenGLUniformBuffer.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <glad/glad.h>
+
+namespace Engine
+{
+
+    OpenGLUniformBuffer::OpenGLUniformBuffer()
+        : bufferId(0)
+    {
+    }
+
+    OpenGLUniformBuffer::~OpenGLUniformBuffer()
+    {
+        if (bufferId)
+        {
+            glDeleteBuffers(1, &bufferId);
+        }
+    }
+
+    bool OpenGLUniformBuffer::create(size_t size)
+    {
+        if (!bufferId)
+        {
+            glGenBuffers(1, &bufferId);
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER, bufferId);
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        this->size = size;
+        return true;
+    }
+
+    void OpenGLUniformBuffer::setData(const void *data, size_t size, size_t offset)
+    {
+        if (offset + size > this->size)
+        {
+            Logger::error("Uniform buffer update out of range");
+            return;
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER, bufferId);
+        glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void OpenGLUniformBuffer::bind(UniformBinding binding) const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), bufferId);
+    }
+
+} // namespace Engine
@@ -0,0 +1,49 @@
+#include "Engine/Renderer/RenderQueue.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/Shader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine
+{
+
+    void RenderQueue::submit(Mesh *mesh, Material *material, const Matrix4 &transform, float depth, const Vector4 &color,
+                             uint32_t lod)
+    {
+        uint64_t key = makeSortKey(material->getShader()->getSortId(), material->getSortId(), mesh->getSortId(), depth);
+        keys.emplace_back(key, static_cast<uint32_t>(commands.size()));
+        commands.push_back({mesh, material, transform, color, lod});
+    }
+
+    void RenderQueue::sort()
+    {
+        // Sort the small key/index pairs instead of the commands themselves;
+        // the index breaks ties so equal keys keep their submission order
+        std::sort(keys.begin(), keys.end());
+    }
+
+    void RenderQueue::clear()
+    {
+        commands.clear();
+        keys.clear();
+    }
+
+    uint64_t RenderQueue::makeSortKey(uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth)
+    {
+        // The bit pattern of a non-negative float grows with its value, so
+        // its top 16 bits are a coarse but monotonic depth
+        uint32_t depthBits = 0;
+        if (depth > 0.0f)
+        {
+            std::memcpy(&depthBits, &depth, sizeof(depthBits));
+        }
+
+        return (static_cast<uint64_t>(shaderId & 0xFFFF) << 48) |
+               (static_cast<uint64_t>(materialId & 0xFFFF) << 32) |
+               (static_cast<uint64_t>(meshId & 0xFFFF) << 16) |
+               static_cast<uint64_t>(depthBits >> 16);
+    }
+
+} // namespace Engine
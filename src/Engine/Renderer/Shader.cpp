@@ -0,0 +1,28 @@
+#include "Engine/Renderer/Shader.hpp"
+
+#include <atomic>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Next shader sort ID
+         */
+        std::atomic<uint32_t> nextSortId(1);
+    }
+
+    Shader::Shader(const std::string &name)
+        : name(name),
+          sortId(nextSortId.fetch_add(1, std::memory_order_relaxed)),
+          instancedVariant(nullptr),
+          indirectVariant(nullptr),
+          frameUniforms(false),
+          revision(0),
+          appliedMaterial(0),
+          appliedMaterialVersion(0)
+    {
+    }
+
+} // namespace Engine
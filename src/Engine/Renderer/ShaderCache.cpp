@@ -0,0 +1,199 @@
+#include "Engine/Renderer/ShaderCache.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Identifies a cache entry ("ESPB")
+         */
+        const uint32_t ENTRY_MAGIC = 0x42505345u;
+
+        /**
+         * @brief Version of the entry layout
+         */
+        const uint32_t ENTRY_VERSION = 1;
+
+        /**
+         * @brief Header at the start of every entry file
+         */
+        struct EntryHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t driverHash;
+            uint64_t sourceHash;
+            uint32_t format;
+            uint32_t size;
+            uint64_t checksum;
+        };
+
+        /**
+         * @brief 64-bit FNV-1a hash
+         * @param data Bytes to hash
+         * @param size Number of bytes
+         * @param hash Hash to continue from
+         * @return Hash
+         */
+        uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ull)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }
+
+    ShaderCache::ShaderCache()
+        : driverHash(0),
+          enabled(false),
+          hits(0),
+          misses(0)
+    {
+    }
+
+    bool ShaderCache::initialize(const std::string &directory, const std::string &driver)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error)
+        {
+            Logger::warning("Shader cache disabled, cannot create {}: {}", directory, error.message());
+            enabled = false;
+            return false;
+        }
+
+        this->directory = directory;
+        driverHash = hashBytes(driver.data(), driver.size());
+        enabled = true;
+
+        Logger::info("Shader cache: {}", directory);
+        return true;
+    }
+
+    void ShaderCache::shutdown()
+    {
+        if (enabled)
+        {
+            Logger::info("Shader cache: {} hits, {} misses", hits, misses);
+        }
+        enabled = false;
+    }
+
+    uint64_t ShaderCache::hashSources(const std::string &vertexSource, const std::string &fragmentSource)
+    {
+        // The separator keeps moving text between the two stages from giving the same key
+        const unsigned char separator = 0;
+        uint64_t hash = hashBytes(vertexSource.data(), vertexSource.size());
+        hash = hashBytes(&separator, 1, hash);
+        return hashBytes(fragmentSource.data(), fragmentSource.size(), hash);
+    }
+
+    bool ShaderCache::load(uint64_t sourceHash, uint32_t &format, std::vector<unsigned char> &binary)
+    {
+        if (!enabled)
+        {
+            return false;
+        }
+
+        std::ifstream file(getEntryPath(sourceHash), std::ios::binary);
+        if (!file)
+        {
+            ++misses;
+            return false;
+        }
+
+        // A different driver hashing to the same file name still fails here
+        EntryHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != ENTRY_MAGIC ||
+            header.version != ENTRY_VERSION || header.driverHash != driverHash || header.sourceHash != sourceHash)
+        {
+            ++misses;
+            return false;
+        }
+
+        binary.resize(header.size);
+        if (!file.read(reinterpret_cast<char *>(binary.data()), header.size) ||
+            hashBytes(binary.data(), binary.size()) != header.checksum)
+        {
+            Logger::warning("Removing corrupt shader cache entry {}", getEntryPath(sourceHash));
+            file.close();
+            remove(sourceHash);
+            binary.clear();
+            ++misses;
+            return false;
+        }
+
+        format = header.format;
+        ++hits;
+        return true;
+    }
+
+    bool ShaderCache::store(uint64_t sourceHash, uint32_t format, const void *data, size_t size)
+    {
+        if (!enabled || size > UINT32_MAX)
+        {
+            return false;
+        }
+
+        EntryHeader header;
+        header.magic = ENTRY_MAGIC;
+        header.version = ENTRY_VERSION;
+        header.driverHash = driverHash;
+        header.sourceHash = sourceHash;
+        header.format = format;
+        header.size = static_cast<uint32_t>(size);
+        header.checksum = hashBytes(data, size);
+
+        // Write next to the entry and rename, so a crash never leaves a torn file behind
+        std::string path = getEntryPath(sourceHash);
+        std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+            if (!file)
+            {
+                Logger::warning("Failed to write shader cache entry {}", temporaryPath);
+                std::remove(temporaryPath.c_str());
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error)
+        {
+            Logger::warning("Failed to write shader cache entry {}: {}", path, error.message());
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void ShaderCache::remove(uint64_t sourceHash)
+    {
+        std::error_code error;
+        std::filesystem::remove(getEntryPath(sourceHash), error);
+    }
+
+    std::string ShaderCache::getEntryPath(uint64_t sourceHash) const
+    {
+        uint64_t key = hashBytes(&driverHash, sizeof(driverHash), sourceHash);
+
+        char name[24];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return directory + "/" + name;
+    }
+
+} // namespace Engine
@@ -0,0 +1,93 @@
+#include "Engine/Renderer/Texture.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Gets the block size of a compressed format
+         * @param format Texture format
+         * @param blockWidth Receives the block width in pixels
+         * @param blockHeight Receives the block height in pixels
+         * @return Size of one block in bytes
+         */
+        size_t getBlockSize(TextureFormat format, int &blockWidth, int &blockHeight)
+        {
+            blockWidth = 4;
+            blockHeight = 4;
+            switch (format)
+            {
+            case TextureFormat::BC1:
+            case TextureFormat::BC4:
+            case TextureFormat::ETC2RGB:
+                return 8;
+            case TextureFormat::ASTC6x6:
+                blockWidth = blockHeight = 6;
+                return 16;
+            case TextureFormat::ASTC8x8:
+                blockWidth = blockHeight = 8;
+                return 16;
+            default:
+                return 16;
+            }
+        }
+    }
+
+    bool isCompressedFormat(TextureFormat format)
+    {
+        return format != TextureFormat::RGB && format != TextureFormat::RGBA && format != TextureFormat::Depth;
+    }
+
+    size_t getTextureLevelSize(TextureFormat format, int width, int height)
+    {
+        if (!isCompressedFormat(format))
+        {
+            return static_cast<size_t>(width) * height * (format == TextureFormat::RGB ? 3 : 4);
+        }
+
+        int blockWidth, blockHeight;
+        size_t blockSize = getBlockSize(format, blockWidth, blockHeight);
+        size_t blocksX = (static_cast<size_t>(width) + blockWidth - 1) / blockWidth;
+        size_t blocksY = (static_cast<size_t>(height) + blockHeight - 1) / blockHeight;
+        return blocksX * blocksY * blockSize;
+    }
+
+    int getMipLevelCount(int width, int height)
+    {
+        int count = 1;
+        for (int size = std::max(width, height); size > 1; size /= 2)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    Texture::Texture()
+        : width(0), height(0), format(TextureFormat::RGBA), mipCount(0), residentMip(0)
+    {
+    }
+
+    void Texture::swapContents(Texture &other)
+    {
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(format, other.format);
+        std::swap(mipCount, other.mipCount);
+        std::swap(residentMip, other.residentMip);
+    }
+
+    size_t Texture::getMemorySize() const
+    {
+        size_t bytes = 0;
+        for (int level = residentMip; level < mipCount; ++level)
+        {
+            bytes += getTextureLevelSize(format, std::max(1, width >> level), std::max(1, height >> level));
+        }
+        return bytes;
+    }
+
+} // namespace Engine
@@ -0,0 +1,265 @@
+#include "Engine/Renderer/VertexLayout.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Reads an attribute of a vertex
+         * @param vertex Vertex to read
+         * @param attribute Attribute to read
+         * @param value Receives x, y, z, and w; unused components are 0
+         */
+        void readAttribute(const Vertex &vertex, VertexAttribute attribute, float *value)
+        {
+            const Vector3 *vector = nullptr;
+            value[2] = 0.0f;
+            value[3] = 0.0f;
+            switch (attribute)
+            {
+            case VertexAttribute::Position:
+                vector = &vertex.position;
+                break;
+            case VertexAttribute::Normal:
+                vector = &vertex.normal;
+                break;
+            case VertexAttribute::TexCoord:
+                value[0] = vertex.texCoord.x;
+                value[1] = vertex.texCoord.y;
+                return;
+            case VertexAttribute::Tangent:
+            {
+                // w keeps the handedness, so the bitangent can be rebuilt from the normal
+                Vector3 bitangent = vertex.normal.cross(vertex.tangent);
+                float handedness = bitangent.x * vertex.bitangent.x + bitangent.y * vertex.bitangent.y +
+                                   bitangent.z * vertex.bitangent.z;
+                value[3] = handedness < 0.0f ? -1.0f : 1.0f;
+                vector = &vertex.tangent;
+                break;
+            }
+            case VertexAttribute::Bitangent:
+                vector = &vertex.bitangent;
+                break;
+            }
+
+            value[0] = vector->x;
+            value[1] = vector->y;
+            value[2] = vector->z;
+        }
+
+        /**
+         * @brief Converts one component to a signed normalized integer
+         * @param value Component, clamped to [-1, 1]
+         * @param bits Number of bits of the integer
+         * @return Integer in the low bits, two's complement
+         */
+        uint32_t toSNorm(float value, uint32_t bits)
+        {
+            float scale = static_cast<float>((1u << (bits - 1)) - 1);
+            int32_t integer = static_cast<int32_t>(std::lround(std::max(-1.0f, std::min(1.0f, value)) * scale));
+            return static_cast<uint32_t>(integer) & ((1u << bits) - 1);
+        }
+
+        /**
+         * @brief Stores an attribute in a format
+         * @param format Format to store
+         * @param value x, y, z, and w of the attribute
+         * @param output Receives VertexLayout::getFormatSize() bytes
+         */
+        void writeAttribute(VertexFormat format, const float *value, unsigned char *output)
+        {
+            switch (format)
+            {
+            case VertexFormat::None:
+                break;
+            case VertexFormat::Float2:
+                std::memcpy(output, value, 2 * sizeof(float));
+                break;
+            case VertexFormat::Float3:
+                std::memcpy(output, value, 3 * sizeof(float));
+                break;
+            case VertexFormat::Half2:
+            {
+                uint16_t halves[2] = {VertexLayout::toHalf(value[0]), VertexLayout::toHalf(value[1])};
+                std::memcpy(output, halves, sizeof(halves));
+                break;
+            }
+            case VertexFormat::SNorm1010102:
+            {
+                uint32_t packed = VertexLayout::packSNorm1010102(value[0], value[1], value[2], value[3]);
+                std::memcpy(output, &packed, sizeof(packed));
+                break;
+            }
+            }
+        }
+    }
+
+    VertexLayout::VertexLayout()
+        : stride(0)
+    {
+        std::fill(formats, formats + VertexAttributeCount, VertexFormat::None);
+        std::fill(offsets, offsets + VertexAttributeCount, 0u);
+    }
+
+    VertexLayout VertexLayout::standard()
+    {
+        VertexLayout layout;
+        layout.set(VertexAttribute::Position, VertexFormat::Float3);
+        layout.set(VertexAttribute::Normal, VertexFormat::Float3);
+        layout.set(VertexAttribute::TexCoord, VertexFormat::Float2);
+        layout.set(VertexAttribute::Tangent, VertexFormat::Float3);
+        layout.set(VertexAttribute::Bitangent, VertexFormat::Float3);
+        return layout;
+    }
+
+    VertexLayout VertexLayout::compact(bool tangents)
+    {
+        VertexLayout layout;
+        layout.set(VertexAttribute::Position, VertexFormat::Float3);
+        layout.set(VertexAttribute::Normal, VertexFormat::SNorm1010102);
+        layout.set(VertexAttribute::TexCoord, VertexFormat::Half2);
+        if (tangents)
+        {
+            layout.set(VertexAttribute::Tangent, VertexFormat::SNorm1010102);
+        }
+        return layout;
+    }
+
+    void VertexLayout::set(VertexAttribute attribute, VertexFormat format)
+    {
+        formats[static_cast<uint32_t>(attribute)] = format;
+
+        // Attributes keep their order, so the offsets follow from the formats
+        stride = 0;
+        for (uint32_t i = 0; i < VertexAttributeCount; ++i)
+        {
+            offsets[i] = stride;
+            stride += getFormatSize(formats[i]);
+        }
+    }
+
+    uint32_t VertexLayout::pack() const
+    {
+        uint32_t packed = 0;
+        for (uint32_t i = 0; i < VertexAttributeCount; ++i)
+        {
+            packed |= static_cast<uint32_t>(formats[i]) << (i * 4);
+        }
+        return packed;
+    }
+
+    bool VertexLayout::unpack(uint32_t packed, VertexLayout &layout)
+    {
+        if (packed >> (VertexAttributeCount * 4))
+        {
+            return false;
+        }
+
+        VertexLayout result;
+        for (uint32_t i = 0; i < VertexAttributeCount; ++i)
+        {
+            uint32_t format = (packed >> (i * 4)) & 0xF;
+            if (format > static_cast<uint32_t>(VertexFormat::SNorm1010102))
+            {
+                return false;
+            }
+            result.set(static_cast<VertexAttribute>(i), static_cast<VertexFormat>(format));
+        }
+        layout = result;
+        return true;
+    }
+
+    void VertexLayout::quantize(const Vertex *vertices, size_t count, void *output) const
+    {
+        unsigned char *bytes = static_cast<unsigned char *>(output);
+        for (size_t i = 0; i < count; ++i, bytes += stride)
+        {
+            for (uint32_t attribute = 0; attribute < VertexAttributeCount; ++attribute)
+            {
+                if (formats[attribute] == VertexFormat::None)
+                {
+                    continue;
+                }
+
+                float value[4];
+                readAttribute(vertices[i], static_cast<VertexAttribute>(attribute), value);
+                writeAttribute(formats[attribute], value, bytes + offsets[attribute]);
+            }
+        }
+    }
+
+    uint32_t VertexLayout::getFormatSize(VertexFormat format)
+    {
+        switch (format)
+        {
+        case VertexFormat::Float2:
+            return 2 * sizeof(float);
+        case VertexFormat::Float3:
+            return 3 * sizeof(float);
+        case VertexFormat::Half2:
+            return 2 * sizeof(uint16_t);
+        case VertexFormat::SNorm1010102:
+            return sizeof(uint32_t);
+        default:
+            return 0;
+        }
+    }
+
+    uint16_t VertexLayout::toHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+        // NaN stays NaN, and anything that rounds past 65504 becomes infinity
+        if (magnitude > 0x7F800000u)
+        {
+            return static_cast<uint16_t>(sign | 0x7E00u);
+        }
+        if (magnitude >= 0x477FF000u)
+        {
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+
+        // Below 2^-14 the result is subnormal, shift the mantissa with its implicit bit into place
+        if (magnitude < 0x38800000u)
+        {
+            if (magnitude < 0x33000000u)
+            {
+                return static_cast<uint16_t>(sign);
+            }
+            uint32_t shift = 126 - (magnitude >> 23);
+            uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+            uint32_t result = mantissa >> shift;
+            uint32_t remainder = mantissa & ((1u << shift) - 1);
+            uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (result & 1)))
+            {
+                ++result;
+            }
+            return static_cast<uint16_t>(sign | result);
+        }
+
+        // Rebias the exponent from 127 to 15 and round the mantissa to 10 bits
+        uint32_t rebiased = magnitude - 0x38000000u;
+        return static_cast<uint16_t>(sign | ((rebiased + 0xFFFu + ((rebiased >> 13) & 1)) >> 13));
+    }
+
+    uint32_t VertexLayout::packSNorm1010102(float x, float y, float z, float w)
+    {
+        return toSNorm(x, 10) | (toSNorm(y, 10) << 10) | (toSNorm(z, 10) << 20) | (toSNorm(w, 2) << 30);
+    }
+
+    bool VertexLayout::operator==(const VertexLayout &other) const
+    {
+        return std::equal(formats, formats + VertexAttributeCount, other.formats);
+    }
+
+} // namespace Engine
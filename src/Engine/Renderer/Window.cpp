@@ -13,12 +13,94 @@ namespace Engine
 // src/Engine/Renderer/OpenGLWindow.cpp
 #include "Engine/Renderer/OpenGLWindow.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
 
 #include <GLFW/glfw3.h>
 
 namespace Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Maps a GLFW key code to an engine key
+         */
+        Key translateKey(int key)
+        {
+            if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z)
+            {
+                return static_cast<Key>(static_cast<int>(Key::A) + key - GLFW_KEY_A);
+            }
+            if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9)
+            {
+                return static_cast<Key>(static_cast<int>(Key::Num0) + key - GLFW_KEY_0);
+            }
+            if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F12)
+            {
+                return static_cast<Key>(static_cast<int>(Key::F1) + key - GLFW_KEY_F1);
+            }
+
+            switch (key)
+            {
+            case GLFW_KEY_ESCAPE:
+                return Key::Escape;
+            case GLFW_KEY_TAB:
+                return Key::Tab;
+            case GLFW_KEY_CAPS_LOCK:
+                return Key::CapsLock;
+            case GLFW_KEY_LEFT_SHIFT:
+            case GLFW_KEY_RIGHT_SHIFT:
+                return Key::Shift;
+            case GLFW_KEY_LEFT_CONTROL:
+            case GLFW_KEY_RIGHT_CONTROL:
+                return Key::Control;
+            case GLFW_KEY_LEFT_ALT:
+            case GLFW_KEY_RIGHT_ALT:
+                return Key::Alt;
+            case GLFW_KEY_SPACE:
+                return Key::Space;
+            case GLFW_KEY_ENTER:
+                return Key::Enter;
+            case GLFW_KEY_BACKSPACE:
+                return Key::Backspace;
+            case GLFW_KEY_DELETE:
+                return Key::Delete;
+            case GLFW_KEY_UP:
+                return Key::Up;
+            case GLFW_KEY_DOWN:
+                return Key::Down;
+            case GLFW_KEY_LEFT:
+                return Key::Left;
+            case GLFW_KEY_RIGHT:
+                return Key::Right;
+            default:
+                return Key::Unknown;
+            }
+        }
+
+        /**
+         * @brief Maps a GLFW mouse button to an engine mouse button
+         */
+        MouseButton translateMouseButton(int button)
+        {
+            switch (button)
+            {
+            case GLFW_MOUSE_BUTTON_LEFT:
+                return MouseButton::Left;
+            case GLFW_MOUSE_BUTTON_RIGHT:
+                return MouseButton::Right;
+            case GLFW_MOUSE_BUTTON_MIDDLE:
+                return MouseButton::Middle;
+            case GLFW_MOUSE_BUTTON_4:
+                return MouseButton::Button4;
+            case GLFW_MOUSE_BUTTON_5:
+                return MouseButton::Button5;
+            default:
+                return MouseButton::Unknown;
+            }
+        }
+    }
+
     // Initialize static member
     bool OpenGLWindow::glfwInitialized = false;
 
@@ -83,6 +165,12 @@ namespace Engine
         // Set user pointer to this instance
         glfwSetWindowUserPointer(window, this);
 
+        // Report input as events, pushed while pollEvents() runs
+        glfwSetKeyCallback(window, &OpenGLWindow::onKey);
+        glfwSetMouseButtonCallback(window, &OpenGLWindow::onMouseButton);
+        glfwSetCursorPosCallback(window, &OpenGLWindow::onCursorPosition);
+        glfwSetScrollCallback(window, &OpenGLWindow::onScroll);
+
         // Enable vsync
         glfwSwapInterval(1);
 
@@ -117,6 +205,126 @@ namespace Engine
     void OpenGLWindow::pollEvents()
     {
         glfwPollEvents();
+        if (inputEvents)
+        {
+            pollGamepad();
+        }
+    }
+
+    void OpenGLWindow::onKey(GLFWwindow *window, int key, int scancode, int action, int mods)
+    {
+        (void)scancode;
+        (void)mods;
+
+        // Repeats carry no new state
+        OpenGLWindow *openglWindow = static_cast<OpenGLWindow *>(glfwGetWindowUserPointer(window));
+        Key engineKey = translateKey(key);
+        if (!openglWindow || engineKey == Key::Unknown || action == GLFW_REPEAT)
+        {
+            return;
+        }
+
+        InputEvent event;
+        event.type = InputEventType::Key;
+        event.key = engineKey;
+        event.pressed = action == GLFW_PRESS;
+        event.timestamp = Profiler::now();
+        openglWindow->pushInputEvent(std::move(event));
+    }
+
+    void OpenGLWindow::onMouseButton(GLFWwindow *window, int button, int action, int mods)
+    {
+        (void)mods;
+
+        OpenGLWindow *openglWindow = static_cast<OpenGLWindow *>(glfwGetWindowUserPointer(window));
+        MouseButton engineButton = translateMouseButton(button);
+        if (!openglWindow || engineButton == MouseButton::Unknown)
+        {
+            return;
+        }
+
+        InputEvent event;
+        event.type = InputEventType::MouseButton;
+        event.mouseButton = engineButton;
+        event.pressed = action == GLFW_PRESS;
+        event.timestamp = Profiler::now();
+        openglWindow->pushInputEvent(std::move(event));
+    }
+
+    void OpenGLWindow::onCursorPosition(GLFWwindow *window, double x, double y)
+    {
+        OpenGLWindow *openglWindow = static_cast<OpenGLWindow *>(glfwGetWindowUserPointer(window));
+        if (!openglWindow)
+        {
+            return;
+        }
+
+        InputEvent event;
+        event.type = InputEventType::MouseMove;
+        event.x = static_cast<float>(x);
+        event.y = static_cast<float>(y);
+        event.timestamp = Profiler::now();
+        openglWindow->pushInputEvent(std::move(event));
+    }
+
+    void OpenGLWindow::onScroll(GLFWwindow *window, double x, double y)
+    {
+        OpenGLWindow *openglWindow = static_cast<OpenGLWindow *>(glfwGetWindowUserPointer(window));
+        if (!openglWindow)
+        {
+            return;
+        }
+
+        InputEvent event;
+        event.type = InputEventType::MouseScroll;
+        event.x = static_cast<float>(x);
+        event.y = static_cast<float>(y);
+        event.timestamp = Profiler::now();
+        openglWindow->pushInputEvent(std::move(event));
+    }
+
+    void OpenGLWindow::pollGamepad()
+    {
+        GLFWgamepadstate state;
+        if (!glfwJoystickIsGamepad(GLFW_JOYSTICK_1) || !glfwGetGamepadState(GLFW_JOYSTICK_1, &state))
+        {
+            return;
+        }
+
+        uint64_t timestamp = Profiler::now();
+
+        // The GLFW button and axis order matches the engine enums after Unknown
+        for (int button = 0; button <= GLFW_GAMEPAD_BUTTON_LAST; ++button)
+        {
+            bool pressed = state.buttons[button] == GLFW_PRESS;
+            if (pressed != gamepadButtons[button + 1])
+            {
+                gamepadButtons[button + 1] = pressed;
+
+                InputEvent event;
+                event.type = InputEventType::GamepadButton;
+                event.gamepadButton = static_cast<GamepadButton>(button + 1);
+                event.pressed = pressed;
+                event.timestamp = timestamp;
+                pushInputEvent(std::move(event));
+            }
+        }
+
+        for (int axis = 0; axis <= GLFW_GAMEPAD_AXIS_LAST; ++axis)
+        {
+            float value = state.axes[axis];
+            if (value != gamepadAxes[axis + 1])
+            {
+                gamepadAxes[axis + 1] = value;
+
+                InputEvent event;
+                event.type = InputEventType::GamepadAxis;
+                event.gamepadAxis = static_cast<GamepadAxis>(axis + 1);
+                event.x = value;
+                event.timestamp = timestamp;
+                pushInputEvent(std::move(event));
+            }
+        }
     }
 
     void OpenGLWindow::swapBuffers()
@@ -124,6 +332,19 @@ namespace Engine
         glfwSwapBuffers(window);
     }
 
+    void OpenGLWindow::makeContextCurrent()
+    {
+        glfwMakeContextCurrent(window);
+    }
+
+    void OpenGLWindow::releaseContext()
+    {
+        if (glfwGetCurrentContext() == window)
+        {
+            glfwMakeContextCurrent(nullptr);
+        }
+    }
+
     bool OpenGLWindow::shouldClose() const
     {
         return glfwWindowShouldClose(window);
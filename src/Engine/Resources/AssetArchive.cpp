@@ -0,0 +1,143 @@
+#include "Engine/Resources/AssetArchive.hpp"
+#include "Engine/Resources/LZ4.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+
+    static_assert(sizeof(AssetArchiveHeader) == 24, "Asset archive header layout changed");
+    static_assert(sizeof(AssetArchiveEntry) == 40, "Asset archive entry layout changed");
+
+    bool AssetArchive::open(const std::string &filepath)
+    {
+        close();
+
+        if (!file.open(filepath))
+        {
+            return false;
+        }
+
+        const AssetArchiveHeader *header = reinterpret_cast<const AssetArchiveHeader *>(file.getData());
+        uint64_t fileSize = file.getSize();
+        const char *error = nullptr;
+        if (fileSize < sizeof(AssetArchiveHeader) || header->magic != AssetArchiveMagic)
+        {
+            error = "not an asset archive";
+        }
+        else if (header->version != AssetArchiveVersion)
+        {
+            error = "unsupported version";
+        }
+        else if (header->indexOffset % alignof(AssetArchiveEntry) != 0 || header->indexOffset > fileSize ||
+                 header->entryCount > (fileSize - header->indexOffset) / sizeof(AssetArchiveEntry))
+        {
+            error = "truncated index";
+        }
+        else
+        {
+            // Check every entry once, so lookups can trust the index
+            const AssetArchiveEntry *entries = reinterpret_cast<const AssetArchiveEntry *>(file.getData() + header->indexOffset);
+            for (uint32_t i = 0; i < header->entryCount && !error; ++i)
+            {
+                const AssetArchiveEntry &entry = entries[i];
+                if (i > 0 && entries[i - 1].hash >= entry.hash)
+                {
+                    error = "index not sorted";
+                }
+                else if (entry.offset % AssetArchiveAlignment != 0 || entry.offset > fileSize ||
+                         entry.storedSize > fileSize - entry.offset)
+                {
+                    error = "entry out of range";
+                }
+                else if (entry.compression == static_cast<uint32_t>(AssetCompression::None) ? entry.storedSize != entry.size
+                                                                                                : entry.size / 255 > entry.storedSize)
+                {
+                    // LZ4 cannot expand data by more than a factor of 255
+                    error = "entry size mismatch";
+                }
+                else if (entry.compression > static_cast<uint32_t>(AssetCompression::LZ4))
+                {
+                    error = "unknown compression";
+                }
+            }
+        }
+
+        if (error)
+        {
+            Logger::error("Invalid asset archive '" + filepath + "': " + error);
+            file.close();
+            return false;
+        }
+
+        index = reinterpret_cast<const AssetArchiveEntry *>(file.getData() + header->indexOffset);
+        entryCount = header->entryCount;
+        path = filepath;
+        return true;
+    }
+
+    void AssetArchive::close()
+    {
+        index = nullptr;
+        entryCount = 0;
+        path.clear();
+        file.close();
+    }
+
+    const AssetArchiveEntry *AssetArchive::find(const std::string &assetPath) const
+    {
+        if (!index)
+        {
+            return nullptr;
+        }
+
+        uint64_t hash = hashPath(assetPath);
+        const AssetArchiveEntry *end = index + entryCount;
+        const AssetArchiveEntry *it = std::lower_bound(index, end, hash, [](const AssetArchiveEntry &entry, uint64_t value)
+                                                       { return entry.hash < value; });
+        return it != end && it->hash == hash ? it : nullptr;
+    }
+
+    bool AssetArchive::read(const AssetArchiveEntry &entry, AssetData &data) const
+    {
+        const unsigned char *stored = file.getData() + entry.offset;
+        if (entry.compression == static_cast<uint32_t>(AssetCompression::None))
+        {
+            data.view(stored, static_cast<size_t>(entry.size));
+            return true;
+        }
+
+        std::vector<unsigned char> buffer(static_cast<size_t>(entry.size));
+        if (!LZ4::decompress(stored, static_cast<size_t>(entry.storedSize), buffer.data(), buffer.size()))
+        {
+            Logger::error("Corrupt entry in asset archive: " + path);
+            return false;
+        }
+
+        data.assign(std::move(buffer));
+        return true;
+    }
+
+    void AssetArchive::prefetch(const AssetArchiveEntry &entry) const
+    {
+        prefetchMemory(file.getData() + entry.offset, static_cast<size_t>(entry.storedSize));
+    }
+
+    uint64_t AssetArchive::hashPath(const std::string &assetPath)
+    {
+        size_t start = assetPath.compare(0, 2, "./") == 0 || assetPath.compare(0, 2, ".\\") == 0 ? 2 : 0;
+
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = start; i < assetPath.size(); ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(assetPath[i] == '\\' ? '/' : assetPath[i]);
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+} // namespace Engine
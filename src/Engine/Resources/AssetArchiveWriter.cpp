@@ -0,0 +1,106 @@
+#include "Engine/Resources/AssetArchiveWriter.hpp"
+#include "Engine/Resources/AssetArchive.hpp"
+#include "Engine/Resources/LZ4.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace Engine
+{
+
+    void AssetArchiveWriter::add(const std::string &path, std::vector<unsigned char> data, bool compress)
+    {
+        assets.push_back(Asset{path, AssetArchive::hashPath(path), std::move(data), compress});
+    }
+
+    bool AssetArchiveWriter::write(const std::string &filepath) const
+    {
+        // Sort by hash and reject collisions, which lookups cannot tell apart
+        std::vector<const Asset *> sorted;
+        sorted.reserve(assets.size());
+        for (const Asset &asset : assets)
+        {
+            sorted.push_back(&asset);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Asset *a, const Asset *b)
+                  { return a->hash < b->hash; });
+        for (size_t i = 1; i < sorted.size(); ++i)
+        {
+            if (sorted[i - 1]->hash == sorted[i]->hash)
+            {
+                Logger::error("Cannot write asset archive: '" + sorted[i - 1]->path + "' and '" + sorted[i]->path +
+                              "' have the same hash");
+                return false;
+            }
+        }
+
+        AssetArchiveHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = AssetArchiveMagic;
+        header.version = AssetArchiveVersion;
+        header.entryCount = static_cast<uint32_t>(sorted.size());
+        header.indexOffset = sizeof(AssetArchiveHeader);
+
+        // Lay the entries out after the index, keeping compressed bytes only
+        // where they save space
+        std::vector<AssetArchiveEntry> entries(sorted.size());
+        std::vector<std::vector<unsigned char>> compressed(sorted.size());
+        uint64_t offset = header.indexOffset + entries.size() * sizeof(AssetArchiveEntry);
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            const Asset &asset = *sorted[i];
+            if (asset.compress && !asset.data.empty())
+            {
+                LZ4::compress(asset.data.data(), asset.data.size(), compressed[i]);
+                if (compressed[i].size() >= asset.data.size())
+                {
+                    compressed[i].clear();
+                }
+            }
+
+            offset = (offset + AssetArchiveAlignment - 1) / AssetArchiveAlignment * AssetArchiveAlignment;
+
+            AssetArchiveEntry &entry = entries[i];
+            std::memset(&entry, 0, sizeof(entry));
+            entry.hash = asset.hash;
+            entry.offset = offset;
+            entry.size = asset.data.size();
+            entry.storedSize = compressed[i].empty() ? asset.data.size() : compressed[i].size();
+            entry.compression = static_cast<uint32_t>(compressed[i].empty() ? AssetCompression::None : AssetCompression::LZ4);
+            offset += entry.storedSize;
+        }
+
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(entries.data()),
+                   static_cast<std::streamsize>(entries.size() * sizeof(AssetArchiveEntry)));
+
+        static const char zeros[AssetArchiveAlignment] = {};
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            uint64_t position = static_cast<uint64_t>(file.tellp());
+            file.write(zeros, static_cast<std::streamsize>(entries[i].offset - position));
+
+            const std::vector<unsigned char> &bytes = compressed[i].empty() ? sorted[i]->data : compressed[i];
+            file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        if (!file)
+        {
+            Logger::error("Failed to write asset archive: " + filepath);
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace Engine
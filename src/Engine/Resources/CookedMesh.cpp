@@ -0,0 +1,197 @@
+#include "Engine/Resources/CookedMesh.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <utility>
+
+namespace Engine
+{
+
+    static_assert(sizeof(CookedMeshHeader) == 120, "Cooked mesh header layout changed");
+    static_assert(sizeof(CookedSubMesh) == 40, "Cooked sub-mesh layout changed");
+    static_assert(sizeof(CookedLod) == 16, "Cooked level of detail layout changed");
+
+    namespace
+    {
+        /**
+         * @brief Checks that a section lies inside the file and is aligned
+         * @param offset Section offset
+         * @param count Number of elements
+         * @param elementSize Size of one element
+         * @param fileSize Size of the file
+         * @return True if the section is valid
+         */
+        bool isValidSection(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+        {
+            if (offset % CookedMeshAlignment != 0 || offset > fileSize)
+            {
+                return false;
+            }
+            return count <= (fileSize - offset) / elementSize;
+        }
+    }
+
+    bool CookedMesh::open(const std::string &filepath)
+    {
+        AssetData data;
+        if (!data.mapFile(filepath))
+        {
+            close();
+            return false;
+        }
+        return open(std::move(data), filepath);
+    }
+
+    bool CookedMesh::open(AssetData data, const std::string &name)
+    {
+        close();
+        asset = std::move(data);
+
+        const CookedMeshHeader *candidate = reinterpret_cast<const CookedMeshHeader *>(asset.getData());
+        uint64_t fileSize = asset.getSize();
+        const char *error = nullptr;
+        VertexLayout fileLayout;
+        if (fileSize < sizeof(CookedMeshHeader) || candidate->magic != CookedMeshMagic)
+        {
+            error = "not a cooked mesh";
+        }
+        else if (candidate->version != CookedMeshVersion)
+        {
+            error = "cooked by a different version, cook it again";
+        }
+        else if (!VertexLayout::unpack(candidate->vertexLayout, fileLayout) || !fileLayout.isValid() ||
+                 candidate->vertexSize != fileLayout.getStride() ||
+                 (candidate->indexSize != sizeof(uint16_t) && candidate->indexSize != sizeof(uint32_t)))
+        {
+            error = "unknown vertex layout or index size";
+        }
+        else if (candidate->vertexCount == 0 ||
+                 !isValidSection(candidate->vertexOffset, candidate->vertexCount, candidate->vertexSize, fileSize) ||
+                 !isValidSection(candidate->indexOffset, candidate->indexCount, candidate->indexSize, fileSize) ||
+                 !isValidSection(candidate->subMeshOffset, candidate->subMeshCount, sizeof(CookedSubMesh), fileSize) ||
+                 !isValidSection(candidate->lodOffset, candidate->lodCount, sizeof(CookedLod), fileSize))
+        {
+            error = "truncated or corrupt";
+        }
+        else
+        {
+            const CookedSubMesh *subMeshes =
+                reinterpret_cast<const CookedSubMesh *>(asset.getData() + candidate->subMeshOffset);
+            for (uint32_t i = 0; i < candidate->subMeshCount; ++i)
+            {
+                uint64_t end = uint64_t(subMeshes[i].indexOffset) + subMeshes[i].indexCount;
+                if (end > candidate->indexCount)
+                {
+                    error = "sub-mesh out of range";
+                    break;
+                }
+            }
+
+            const CookedLod *lods = reinterpret_cast<const CookedLod *>(asset.getData() + candidate->lodOffset);
+            for (uint32_t i = 0; i < candidate->lodCount && !error; ++i)
+            {
+                uint64_t end = uint64_t(lods[i].indexOffset) + lods[i].indexCount;
+                if (end > candidate->indexCount || lods[i].indexCount % 3 != 0)
+                {
+                    error = "level of detail out of range";
+                }
+            }
+        }
+
+        if (error)
+        {
+            Logger::error("Invalid mesh file '" + name + "': " + error);
+            asset.reset();
+            return false;
+        }
+
+        header = candidate;
+        layout = fileLayout;
+        return true;
+    }
+
+    void CookedMesh::close()
+    {
+        header = nullptr;
+        asset.reset();
+    }
+
+    MeshData CookedMesh::getData() const
+    {
+        MeshData data;
+        if (!header)
+        {
+            return data;
+        }
+
+        // Standard vertices go through the Vertex path, so build() still applies the mesh's own layout
+        const unsigned char *vertices = asset.getData() + header->vertexOffset;
+        if (layout == VertexLayout::standard())
+        {
+            data.vertices = reinterpret_cast<const Vertex *>(vertices);
+        }
+        else
+        {
+            data.packedVertices = vertices;
+            data.packedLayout = layout;
+        }
+        data.vertexCount = static_cast<size_t>(header->vertexCount);
+
+        const unsigned char *indices = header->indexCount ? asset.getData() + header->indexOffset : nullptr;
+        if (header->indexSize == sizeof(uint16_t))
+        {
+            data.shortIndices = reinterpret_cast<const uint16_t *>(indices);
+        }
+        else
+        {
+            data.indices = reinterpret_cast<const uint32_t *>(indices);
+        }
+        data.indexCount = static_cast<size_t>(header->indexCount);
+        data.bounds = BoundingBox(Vector3(header->boundsMin[0], header->boundsMin[1], header->boundsMin[2]),
+                                  Vector3(header->boundsMax[0], header->boundsMax[1], header->boundsMax[2]));
+        data.boundingSphere.center = Vector3(header->sphereCenter[0], header->sphereCenter[1], header->sphereCenter[2]);
+        data.boundingSphere.radius = header->sphereRadius;
+        return data;
+    }
+
+    std::vector<SubMesh> CookedMesh::getSubMeshes() const
+    {
+        std::vector<SubMesh> result;
+        if (!header)
+        {
+            return result;
+        }
+
+        const CookedSubMesh *subMeshes = reinterpret_cast<const CookedSubMesh *>(asset.getData() + header->subMeshOffset);
+        result.resize(header->subMeshCount);
+        for (uint32_t i = 0; i < header->subMeshCount; ++i)
+        {
+            const CookedSubMesh &cooked = subMeshes[i];
+            result[i].indexOffset = cooked.indexOffset;
+            result[i].indexCount = cooked.indexCount;
+            result[i].materialIndex = cooked.materialIndex;
+            result[i].bounds = BoundingBox(Vector3(cooked.boundsMin[0], cooked.boundsMin[1], cooked.boundsMin[2]),
+                                           Vector3(cooked.boundsMax[0], cooked.boundsMax[1], cooked.boundsMax[2]));
+        }
+        return result;
+    }
+
+    std::vector<MeshLod> CookedMesh::getLods() const
+    {
+        std::vector<MeshLod> result;
+        if (!header)
+        {
+            return result;
+        }
+
+        const CookedLod *lods = reinterpret_cast<const CookedLod *>(asset.getData() + header->lodOffset);
+        result.resize(header->lodCount);
+        for (uint32_t i = 0; i < header->lodCount; ++i)
+        {
+            result[i].indexOffset = lods[i].indexOffset;
+            result[i].indexCount = lods[i].indexCount;
+            result[i].screenSize = lods[i].screenSize;
+        }
+        return result;
+    }
+
+} // namespace Engine
@@ -0,0 +1,367 @@
+#include "Engine/Resources/FileWatcher.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+#else
+#include <chrono>
+#include <unordered_map>
+#endif
+
+namespace Engine
+{
+
+#ifdef _WIN32
+
+    struct FileWatcher::State
+    {
+        /**
+         * @brief Watched directory
+         */
+        HANDLE directory = INVALID_HANDLE_VALUE;
+
+        /**
+         * @brief Overlapped read of the change notifications
+         */
+        OVERLAPPED overlapped = {};
+
+        /**
+         * @brief Notifications filled in by the read
+         */
+        alignas(DWORD) unsigned char buffer[16384];
+
+        /**
+         * @brief Starts the next read
+         * @return True if the read was issued
+         */
+        bool read()
+        {
+            return ReadDirectoryChangesW(directory, buffer, sizeof(buffer), TRUE,
+                                         FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE, nullptr,
+                                         &overlapped, nullptr) != 0;
+        }
+    };
+
+#elif defined(__linux__)
+
+    struct FileWatcher::State
+    {
+        /**
+         * @brief Watched directory
+         */
+        std::string directory;
+
+        /**
+         * @brief inotify instance
+         */
+        int fd = -1;
+
+        /**
+         * @brief Directories relative to the watched one, by watch descriptor
+         */
+        std::unordered_map<int, std::string> watches;
+
+        /**
+         * @brief Watches a directory and the directories below it
+         * @param relativePath Directory relative to the watched one, empty for the watched one itself
+         * @param files Receives the files already in the directories, nullptr to skip them
+         */
+        void addWatches(const std::string &relativePath, std::vector<std::string> *files)
+        {
+            std::string path = relativePath.empty() ? directory : directory + "/" + relativePath;
+            int wd = inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+            if (wd < 0)
+            {
+                Logger::warning("Cannot watch directory {}", path);
+                return;
+            }
+            watches[wd] = relativePath;
+
+            std::error_code error;
+            for (std::filesystem::directory_iterator it(path, error), end; !error && it != end; it.increment(error))
+            {
+                std::string name = it->path().filename().string();
+                std::string child = relativePath.empty() ? name : relativePath + "/" + name;
+                if (it->is_directory(error))
+                {
+                    addWatches(child, files);
+                }
+                else if (files)
+                {
+                    files->push_back(child);
+                }
+            }
+        }
+    };
+
+#else
+
+    struct FileWatcher::State
+    {
+        /**
+         * @brief Watched directory
+         */
+        std::string directory;
+
+        /**
+         * @brief Modification times of the files seen by the last scan
+         */
+        std::unordered_map<std::string, std::filesystem::file_time_type> times;
+
+        /**
+         * @brief Earliest time of the next scan
+         */
+        std::chrono::steady_clock::time_point nextScan;
+
+        /**
+         * @brief Compares the modification times against the last scan
+         * @param changedPaths Receives the files that are new or were modified, nullptr to only record the times
+         */
+        void scan(std::vector<std::string> *changedPaths)
+        {
+            std::error_code error;
+            auto options = std::filesystem::directory_options::skip_permission_denied;
+            for (std::filesystem::recursive_directory_iterator it(directory, options, error), end;
+                 !error && it != end; it.increment(error))
+            {
+                if (!it->is_regular_file(error))
+                {
+                    continue;
+                }
+
+                auto time = it->last_write_time(error);
+                std::string path = std::filesystem::relative(it->path(), directory, error).generic_string();
+                auto known = times.find(path);
+                if (known == times.end() || known->second != time)
+                {
+                    times[path] = time;
+                    if (changedPaths)
+                    {
+                        changedPaths->push_back(path);
+                    }
+                }
+            }
+        }
+    };
+
+#endif
+
+    FileWatcher::FileWatcher()
+    {
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        stop();
+    }
+
+    bool FileWatcher::start(const std::string &directory)
+    {
+        stop();
+
+        auto watch = std::make_unique<State>();
+
+#ifdef _WIN32
+        watch->directory = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY,
+                                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                       FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (watch->directory == INVALID_HANDLE_VALUE)
+        {
+            Logger::error("Cannot watch directory {}", directory);
+            return false;
+        }
+
+        watch->overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        if (!watch->overlapped.hEvent || !watch->read())
+        {
+            Logger::error("Cannot watch directory {}", directory);
+            if (watch->overlapped.hEvent)
+            {
+                CloseHandle(watch->overlapped.hEvent);
+            }
+            CloseHandle(watch->directory);
+            return false;
+        }
+#elif defined(__linux__)
+        watch->directory = directory;
+        watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watch->fd < 0)
+        {
+            Logger::error("Cannot watch directory {}: inotify is unavailable", directory);
+            return false;
+        }
+
+        watch->addWatches("", nullptr);
+        if (watch->watches.empty())
+        {
+            close(watch->fd);
+            return false;
+        }
+#else
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error))
+        {
+            Logger::error("Cannot watch directory {}", directory);
+            return false;
+        }
+
+        // The first scan only records the current state
+        watch->directory = directory;
+        watch->scan(nullptr);
+        watch->nextScan = std::chrono::steady_clock::now();
+#endif
+
+        state = std::move(watch);
+        Logger::info("Watching {} for changes", directory);
+        return true;
+    }
+
+    void FileWatcher::stop()
+    {
+        if (!state)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        // The read writes into the buffer until the cancellation completes
+        DWORD bytes = 0;
+        CancelIo(state->directory);
+        GetOverlappedResult(state->directory, &state->overlapped, &bytes, TRUE);
+        CloseHandle(state->overlapped.hEvent);
+        CloseHandle(state->directory);
+#elif defined(__linux__)
+        close(state->fd);
+#endif
+
+        state.reset();
+    }
+
+    void FileWatcher::poll(std::vector<std::string> &changedPaths)
+    {
+        if (!state)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(state->directory, &state->overlapped, &bytes, FALSE))
+        {
+            if (GetLastError() == ERROR_IO_INCOMPLETE)
+            {
+                return;
+            }
+            bytes = 0;
+        }
+
+        // An empty result means the notifications did not fit the buffer
+        if (bytes == 0)
+        {
+            Logger::warning("File watcher overflowed, some changes were missed");
+        }
+
+        for (DWORD offset = 0; bytes > 0;)
+        {
+            const FILE_NOTIFY_INFORMATION *info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(state->buffer + offset);
+            if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+                info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+            {
+                int length = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+                int size = WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, nullptr, 0, nullptr, nullptr);
+                std::string path(static_cast<size_t>(size), '\0');
+                WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, &path[0], size, nullptr, nullptr);
+                for (char &c : path)
+                {
+                    c = c == '\\' ? '/' : c;
+                }
+                changedPaths.push_back(std::move(path));
+            }
+
+            if (info->NextEntryOffset == 0)
+            {
+                break;
+            }
+            offset += info->NextEntryOffset;
+        }
+
+        if (!state->read())
+        {
+            Logger::error("File watcher stopped: cannot read directory changes");
+            stop();
+        }
+#elif defined(__linux__)
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            ssize_t length = read(state->fd, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                if (length < 0 && errno != EAGAIN && errno != EINTR)
+                {
+                    Logger::warning("File watcher read failed");
+                }
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    Logger::warning("File watcher overflowed, some changes were missed");
+                    continue;
+                }
+
+                auto watch = state->watches.find(event->wd);
+                if (watch == state->watches.end())
+                {
+                    continue;
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    state->watches.erase(watch);
+                    continue;
+                }
+
+                std::string name = event->len > 0 ? event->name : "";
+                std::string path = watch->second.empty() ? name : watch->second + "/" + name;
+                if (event->mask & IN_ISDIR)
+                {
+                    // Files can land in a new directory before its watch exists
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        state->addWatches(path, &changedPaths);
+                    }
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    changedPaths.push_back(std::move(path));
+                }
+            }
+        }
+#else
+        // Walking the tree is slow, so only do it a few times per second
+        auto now = std::chrono::steady_clock::now();
+        if (now < state->nextScan)
+        {
+            return;
+        }
+        state->nextScan = now + std::chrono::milliseconds(500);
+        state->scan(&changedPaths);
+#endif
+    }
+
+} // namespace Engine
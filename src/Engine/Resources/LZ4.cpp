@@ -0,0 +1,241 @@
+#include "Engine/Resources/LZ4.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Engine
+{
+    namespace LZ4
+    {
+        namespace
+        {
+            /**
+             * @brief Shortest match the format can encode
+             */
+            const size_t MinMatch = 4;
+
+            /**
+             * @brief Number of bytes at the end of a block that are always literals
+             */
+            const size_t LastLiterals = 5;
+
+            /**
+             * @brief Distance from the end of a block within which no match may start
+             */
+            const size_t MatchStartLimit = 12;
+
+            /**
+             * @brief Largest match offset
+             */
+            const size_t MaxOffset = 65535;
+
+            /**
+             * @brief Number of bits of the match finder hash
+             */
+            const int HashBits = 16;
+
+            uint32_t read32(const unsigned char *p)
+            {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+
+            uint32_t hash(uint32_t sequence)
+            {
+                return (sequence * 2654435761u) >> (32 - HashBits);
+            }
+
+            /**
+             * @brief Appends a length that did not fit in its token nibble
+             * @param output Compressed block
+             * @param length Remaining length, at least 0
+             */
+            void writeLength(std::vector<unsigned char> &output, size_t length)
+            {
+                while (length >= 255)
+                {
+                    output.push_back(255);
+                    length -= 255;
+                }
+                output.push_back(static_cast<unsigned char>(length));
+            }
+
+            /**
+             * @brief Appends literals followed by an optional match
+             * @param output Compressed block
+             * @param literals First literal byte
+             * @param literalCount Number of literals
+             * @param offset Match offset, ignored for the last sequence
+             * @param matchLength Match length, 0 for the last sequence
+             */
+            void writeSequence(std::vector<unsigned char> &output, const unsigned char *literals, size_t literalCount,
+                               size_t offset, size_t matchLength)
+            {
+                size_t matchCode = matchLength ? matchLength - MinMatch : 0;
+                unsigned char token = static_cast<unsigned char>(((literalCount < 15 ? literalCount : 15) << 4) |
+                                                                 (matchCode < 15 ? matchCode : 15));
+                output.push_back(token);
+                if (literalCount >= 15)
+                {
+                    writeLength(output, literalCount - 15);
+                }
+                output.insert(output.end(), literals, literals + literalCount);
+
+                if (matchLength)
+                {
+                    output.push_back(static_cast<unsigned char>(offset & 0xFF));
+                    output.push_back(static_cast<unsigned char>(offset >> 8));
+                    if (matchCode >= 15)
+                    {
+                        writeLength(output, matchCode - 15);
+                    }
+                }
+            }
+
+            /**
+             * @brief Reads a length continued past its token nibble
+             * @param ip Read position, advanced past the length bytes
+             * @param end End of the compressed block
+             * @param length Length so far, extended in place
+             * @return True if the length was complete
+             */
+            bool readLength(const unsigned char *&ip, const unsigned char *end, size_t &length)
+            {
+                unsigned char byte;
+                do
+                {
+                    if (ip >= end)
+                    {
+                        return false;
+                    }
+                    byte = *ip++;
+                    length += byte;
+                } while (byte == 255);
+                return true;
+            }
+        }
+
+        size_t compressBound(size_t size)
+        {
+            return size + size / 255 + 16;
+        }
+
+        void compress(const unsigned char *source, size_t size, std::vector<unsigned char> &output)
+        {
+            output.clear();
+            output.reserve(compressBound(size));
+
+            // Blocks too short to hold a match are stored as literals
+            if (size < MatchStartLimit + 1)
+            {
+                writeSequence(output, source, size, 0, 0);
+                return;
+            }
+
+            // Greedy match finder with one candidate per hash; positions are
+            // stored plus one so that zero means empty
+            std::vector<uint32_t> table(size_t(1) << HashBits, 0);
+            size_t matchEnd = size - LastLiterals;
+            size_t anchor = 0;
+            size_t position = 0;
+
+            while (position + MatchStartLimit <= size)
+            {
+                uint32_t sequence = read32(source + position);
+                uint32_t &slot = table[hash(sequence)];
+                size_t candidate = slot;
+                slot = static_cast<uint32_t>(position + 1);
+
+                if (candidate == 0 || position - (candidate - 1) > MaxOffset || read32(source + candidate - 1) != sequence)
+                {
+                    ++position;
+                    continue;
+                }
+
+                candidate -= 1;
+                size_t length = MinMatch;
+                while (position + length < matchEnd && source[candidate + length] == source[position + length])
+                {
+                    ++length;
+                }
+
+                writeSequence(output, source + anchor, position - anchor, position - candidate, length);
+                position += length;
+                anchor = position;
+            }
+
+            writeSequence(output, source + anchor, size - anchor, 0, 0);
+        }
+
+        bool decompress(const unsigned char *source, size_t size, unsigned char *output, size_t outputSize)
+        {
+            const unsigned char *ip = source;
+            const unsigned char *end = source + size;
+            unsigned char *op = output;
+            unsigned char *outputEnd = output + outputSize;
+
+            while (ip < end)
+            {
+                unsigned char token = *ip++;
+
+                // Literals
+                size_t literalCount = token >> 4;
+                if (literalCount == 15 && !readLength(ip, end, literalCount))
+                {
+                    return false;
+                }
+                if (literalCount > size_t(end - ip) || literalCount > size_t(outputEnd - op))
+                {
+                    return false;
+                }
+                if (literalCount > 0)
+                {
+                    std::memcpy(op, ip, literalCount);
+                }
+                ip += literalCount;
+                op += literalCount;
+
+                // The last sequence has no match
+                if (ip == end)
+                {
+                    break;
+                }
+
+                // Match
+                if (end - ip < 2)
+                {
+                    return false;
+                }
+                size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+                ip += 2;
+                if (offset == 0 || offset > size_t(op - output))
+                {
+                    return false;
+                }
+
+                size_t length = token & 0x0F;
+                if (length == 15 && !readLength(ip, end, length))
+                {
+                    return false;
+                }
+                length += MinMatch;
+                if (length > size_t(outputEnd - op))
+                {
+                    return false;
+                }
+
+                // Matches may overlap their own output, so copy forward byte by byte
+                const unsigned char *match = op - offset;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    op[i] = match[i];
+                }
+                op += length;
+            }
+
+            return op == outputEnd;
+        }
+    }
+
+} // namespace Engine
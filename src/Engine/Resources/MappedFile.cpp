@@ -0,0 +1,172 @@
+#include "Engine/Resources/MappedFile.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Engine
+{
+
+    void prefetchMemory(const unsigned char *data, size_t size)
+    {
+        // Touch one byte per page; the sum keeps the reads from being removed
+        const size_t pageSize = 4096;
+        unsigned int sum = 0;
+        for (size_t offset = 0; offset < size; offset += pageSize)
+        {
+            sum += data[offset];
+        }
+        volatile unsigned int sink = sum;
+        (void)sink;
+    }
+
+    MappedFile::MappedFile()
+        : data(nullptr), size(0), mapping(nullptr)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : data(std::exchange(other.data, nullptr)),
+          size(std::exchange(other.size, 0)),
+          mapping(std::exchange(other.mapping, nullptr))
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+            mapping = std::exchange(other.mapping, nullptr);
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(const std::string &filepath)
+    {
+        close();
+
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Logger::error("Cannot map empty file: " + filepath);
+            CloseHandle(file);
+            return false;
+        }
+
+        // The mapping keeps the file open, so the file handle can go
+        HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!fileMapping)
+        {
+            Logger::error("Failed to map file: " + filepath);
+            return false;
+        }
+
+        void *view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            Logger::error("Failed to map file: " + filepath);
+            CloseHandle(fileMapping);
+            return false;
+        }
+
+        data = static_cast<const unsigned char *>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        mapping = fileMapping;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data)
+        {
+            UnmapViewOfFile(data);
+            CloseHandle(static_cast<HANDLE>(mapping));
+        }
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+    }
+
+#else
+
+    bool MappedFile::open(const std::string &filepath)
+    {
+        close();
+
+        int file = ::open(filepath.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            Logger::error("Cannot map empty file: " + filepath);
+            ::close(file);
+            return false;
+        }
+
+        // The mapping keeps the file open, so the descriptor can go
+        size_t fileSize = static_cast<size_t>(info.st_size);
+        void *view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (view == MAP_FAILED)
+        {
+            Logger::error("Failed to map file: " + filepath);
+            return false;
+        }
+
+        // Loads read the whole file front to back
+        madvise(view, fileSize, MADV_SEQUENTIAL);
+
+        data = static_cast<const unsigned char *>(view);
+        size = fileSize;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data)
+        {
+            munmap(const_cast<unsigned char *>(data), size);
+        }
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+    }
+
+#endif
+
+} // namespace Engine
@@ -0,0 +1,195 @@
+#include "Engine/Resources/MeshCooker.hpp"
+#include "Engine/Resources/CookedMesh.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Rounds an offset up to the section alignment
+         * @param offset Offset to align
+         * @return Aligned offset
+         */
+        uint64_t alignOffset(uint64_t offset)
+        {
+            return (offset + CookedMeshAlignment - 1) / CookedMeshAlignment * CookedMeshAlignment;
+        }
+
+        /**
+         * @brief Copies a box into the min and max arrays of a file record
+         * @param box Box to store
+         * @param min Receives the minimum corner
+         * @param max Receives the maximum corner
+         */
+        void storeBox(const BoundingBox &box, float *min, float *max)
+        {
+            min[0] = box.min.x, min[1] = box.min.y, min[2] = box.min.z;
+            max[0] = box.max.x, max[1] = box.max.y, max[2] = box.max.z;
+        }
+
+        /**
+         * @brief Pads a file with zeros up to an offset
+         * @param file File to pad
+         * @param offset Offset to reach
+         */
+        void padTo(std::ofstream &file, uint64_t offset)
+        {
+            static const char zeros[CookedMeshAlignment] = {};
+            uint64_t position = static_cast<uint64_t>(file.tellp());
+            if (offset > position)
+            {
+                file.write(zeros, static_cast<std::streamsize>(offset - position));
+            }
+        }
+    }
+
+    bool MeshCooker::cook(const std::string &filepath, const std::vector<Vertex> &vertices,
+                          const std::vector<uint32_t> &indices, const std::vector<SubMesh> &subMeshes,
+                          const VertexLayout &layout, const std::vector<MeshLod> &lods)
+    {
+        if (vertices.empty())
+        {
+            Logger::error("Cannot cook mesh '" + filepath + "': No vertices");
+            return false;
+        }
+        if (!layout.isValid())
+        {
+            Logger::error("Cannot cook mesh '" + filepath + "': The vertex layout needs Float3 positions");
+            return false;
+        }
+
+        for (uint32_t index : indices)
+        {
+            if (index >= vertices.size())
+            {
+                Logger::error("Cannot cook mesh '" + filepath + "': Index out of range");
+                return false;
+            }
+        }
+
+        std::vector<CookedLod> cookedLods(lods.size());
+        for (size_t i = 0; i < lods.size(); ++i)
+        {
+            const MeshLod &lod = lods[i];
+            if (uint64_t(lod.indexOffset) + lod.indexCount > indices.size() || lod.indexCount % 3 != 0)
+            {
+                Logger::error("Cannot cook mesh '" + filepath + "': Level of detail out of range");
+                return false;
+            }
+
+            std::memset(&cookedLods[i], 0, sizeof(CookedLod));
+            cookedLods[i].indexOffset = lod.indexOffset;
+            cookedLods[i].indexCount = lod.indexCount;
+            cookedLods[i].screenSize = lod.screenSize;
+        }
+
+        std::vector<unsigned char> vertexData(vertices.size() * layout.getStride());
+        layout.quantize(vertices.data(), vertices.size(), vertexData.data());
+
+        // Halve the index section whenever every vertex is in reach of 16 bits
+        IndexType indexType = VertexLayout::selectIndexType(vertices.size());
+        std::vector<uint16_t> shortIndices;
+        if (indexType == IndexType::UInt16)
+        {
+            shortIndices.assign(indices.begin(), indices.end());
+        }
+        const void *indexData = indexType == IndexType::UInt16 ? static_cast<const void *>(shortIndices.data()) : indices.data();
+        uint64_t indexBytes = indices.size() * getIndexSize(indexType);
+
+        CookedMeshHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = CookedMeshMagic;
+        header.version = CookedMeshVersion;
+        header.vertexSize = layout.getStride();
+        header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+        header.vertexLayout = layout.pack();
+        header.indexSize = static_cast<uint32_t>(getIndexSize(indexType));
+        header.lodCount = static_cast<uint32_t>(lods.size());
+        header.vertexCount = vertices.size();
+        header.indexCount = indices.size();
+        header.vertexOffset = alignOffset(sizeof(CookedMeshHeader));
+        header.indexOffset = alignOffset(header.vertexOffset + vertexData.size());
+        header.subMeshOffset = alignOffset(header.indexOffset + indexBytes);
+        header.lodOffset = alignOffset(header.subMeshOffset + subMeshes.size() * sizeof(CookedSubMesh));
+
+        // Bounds the same way Mesh computes them, so loading can skip it
+        BoundingBox bounds;
+        for (const Vertex &vertex : vertices)
+        {
+            bounds.expand(vertex.position);
+        }
+        Vector3 center = bounds.getCenter();
+        float maxDistanceSquared = 0.0f;
+        for (const Vertex &vertex : vertices)
+        {
+            float dx = vertex.position.x - center.x;
+            float dy = vertex.position.y - center.y;
+            float dz = vertex.position.z - center.z;
+            maxDistanceSquared = std::max(maxDistanceSquared, dx * dx + dy * dy + dz * dz);
+        }
+        storeBox(bounds, header.boundsMin, header.boundsMax);
+        header.sphereCenter[0] = center.x;
+        header.sphereCenter[1] = center.y;
+        header.sphereCenter[2] = center.z;
+        header.sphereRadius = std::sqrt(maxDistanceSquared);
+
+        std::vector<CookedSubMesh> cookedSubMeshes(subMeshes.size());
+        for (size_t i = 0; i < subMeshes.size(); ++i)
+        {
+            const SubMesh &subMesh = subMeshes[i];
+            if (uint64_t(subMesh.indexOffset) + subMesh.indexCount > indices.size())
+            {
+                Logger::error("Cannot cook mesh '" + filepath + "': Sub-mesh out of range");
+                return false;
+            }
+
+            BoundingBox subBounds;
+            for (uint32_t j = 0; j < subMesh.indexCount; ++j)
+            {
+                subBounds.expand(vertices[indices[subMesh.indexOffset + j]].position);
+            }
+
+            CookedSubMesh &cooked = cookedSubMeshes[i];
+            std::memset(&cooked, 0, sizeof(cooked));
+            cooked.indexOffset = subMesh.indexOffset;
+            cooked.indexCount = subMesh.indexCount;
+            cooked.materialIndex = subMesh.materialIndex;
+            storeBox(subBounds, cooked.boundsMin, cooked.boundsMax);
+        }
+
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        padTo(file, header.vertexOffset);
+        file.write(reinterpret_cast<const char *>(vertexData.data()), static_cast<std::streamsize>(vertexData.size()));
+        padTo(file, header.indexOffset);
+        file.write(static_cast<const char *>(indexData), static_cast<std::streamsize>(indexBytes));
+        padTo(file, header.subMeshOffset);
+        file.write(reinterpret_cast<const char *>(cookedSubMeshes.data()),
+                   static_cast<std::streamsize>(cookedSubMeshes.size() * sizeof(CookedSubMesh)));
+        padTo(file, header.lodOffset);
+        file.write(reinterpret_cast<const char *>(cookedLods.data()),
+                   static_cast<std::streamsize>(cookedLods.size() * sizeof(CookedLod)));
+
+        if (!file)
+        {
+            Logger::error("Failed to write mesh file: " + filepath);
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace Engine
@@ -0,0 +1,407 @@
+#include "Engine/Resources/MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Sum of squared distances to a set of weighted planes
+         *
+         * Stores the upper half of the symmetric 4x4 matrix of the planes.
+         */
+        struct Quadric
+        {
+            double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+            double b2 = 0.0, bc = 0.0, bd = 0.0;
+            double c2 = 0.0, cd = 0.0;
+            double d2 = 0.0;
+
+            /**
+             * @brief Total weight of the planes
+             */
+            double weight = 0.0;
+
+            /**
+             * @brief Adds the plane ax + by + cz + d = 0 with a unit normal
+             */
+            void addPlane(double a, double b, double c, double d, double w)
+            {
+                a2 += w * a * a, ab += w * a * b, ac += w * a * c, ad += w * a * d;
+                b2 += w * b * b, bc += w * b * c, bd += w * b * d;
+                c2 += w * c * c, cd += w * c * d;
+                d2 += w * d * d;
+                weight += w;
+            }
+
+            /**
+             * @brief Adds the planes of another quadric
+             */
+            void add(const Quadric &other)
+            {
+                a2 += other.a2, ab += other.ab, ac += other.ac, ad += other.ad;
+                b2 += other.b2, bc += other.bc, bd += other.bd;
+                c2 += other.c2, cd += other.cd;
+                d2 += other.d2;
+                weight += other.weight;
+            }
+
+            /**
+             * @brief Gets the weighted sum of squared distances of a point
+             */
+            double evaluate(const Vector3 &p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+                       b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+                       c2 * z * z + 2.0 * cd * z + d2;
+            }
+        };
+
+        /**
+         * @brief Candidate move of one vertex onto another
+         */
+        struct Collapse
+        {
+            float cost;
+            uint32_t from;
+            uint32_t to;
+
+            bool operator>(const Collapse &other) const { return cost > other.cost; }
+        };
+
+        /**
+         * @brief Gets the key of an undirected edge
+         */
+        uint64_t edgeKey(uint32_t a, uint32_t b)
+        {
+            return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+        }
+
+        /**
+         * @brief Gets the normal of a triangle, scaled by twice its area
+         */
+        Vector3 triangleNormal(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2)
+        {
+            Vector3 edge1(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+            Vector3 edge2(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+            return edge1.cross(edge2);
+        }
+
+        /**
+         * @brief Gets the dot product of two vectors in double precision
+         */
+        double dot(const Vector3 &a, const Vector3 &b)
+        {
+            return double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z;
+        }
+    }
+
+    std::vector<uint32_t> MeshSimplifier::simplify(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
+                                                   size_t targetIndexCount, float maxError, float *resultError)
+    {
+        if (resultError)
+        {
+            *resultError = 0.0f;
+        }
+
+        size_t triangleCount = indices.size() / 3;
+        std::vector<uint32_t> triangles(indices.begin(), indices.begin() + triangleCount * 3);
+        if (triangles.size() <= targetIndexCount)
+        {
+            return triangles;
+        }
+
+        // Edges of one triangle are borders and edges of more than two are
+        // not manifold; their vertices stay where they are
+        size_t vertexCount = vertices.size();
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        edgeUses.reserve(triangles.size());
+        for (size_t i = 0; i < triangles.size(); i += 3)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                ++edgeUses[edgeKey(triangles[i + k], triangles[i + (k + 1) % 3])];
+            }
+        }
+
+        std::vector<uint8_t> locked(vertexCount, 0);
+        for (const auto &edge : edgeUses)
+        {
+            if (edge.second != 2)
+            {
+                locked[edge.first >> 32] = 1;
+                locked[edge.first & 0xFFFFFFFFu] = 1;
+            }
+        }
+
+        // Every vertex starts with the planes of its triangles, weighted by area
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            const uint32_t *triangle = &triangles[t * 3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                vertexTriangles[triangle[k]].push_back(t);
+            }
+
+            const Vector3 &p0 = vertices[triangle[0]].position;
+            Vector3 normal = triangleNormal(p0, vertices[triangle[1]].position, vertices[triangle[2]].position);
+            double length = std::sqrt(dot(normal, normal));
+            if (length <= 0.0)
+            {
+                continue;
+            }
+
+            double a = normal.x / length, b = normal.y / length, c = normal.z / length;
+            double d = -(a * p0.x + b * p0.y + c * p0.z);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                quadrics[triangle[k]].addPlane(a, b, c, d, length * 0.5);
+            }
+        }
+
+        // The cost is the mean squared distance of the target to the planes of both vertices
+        auto cost = [&](uint32_t from, uint32_t to)
+        {
+            Quadric quadric = quadrics[from];
+            quadric.add(quadrics[to]);
+            double error = quadric.weight > 0.0 ? quadric.evaluate(vertices[to].position) / quadric.weight : 0.0;
+            return static_cast<float>(std::max(0.0, error));
+        };
+
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+        auto pushEdges = [&](uint32_t t)
+        {
+            const uint32_t *triangle = &triangles[t * 3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint32_t a = triangle[k];
+                uint32_t b = triangle[(k + 1) % 3];
+                if (!locked[a])
+                {
+                    queue.push({cost(a, b), a, b});
+                }
+                if (!locked[b])
+                {
+                    queue.push({cost(b, a), b, a});
+                }
+            }
+        };
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            pushEdges(t);
+        }
+
+        std::vector<uint8_t> triangleRemoved(triangleCount, 0);
+        std::vector<uint8_t> vertexRemoved(vertexCount, 0);
+        double maxErrorSquared = double(maxError) * maxError;
+        float worstError = 0.0f;
+        size_t remaining = triangles.size();
+        while (remaining > targetIndexCount && !queue.empty())
+        {
+            Collapse collapse = queue.top();
+            queue.pop();
+            uint32_t from = collapse.from;
+            uint32_t to = collapse.to;
+            if (vertexRemoved[from] || vertexRemoved[to])
+            {
+                continue;
+            }
+
+            // Costs go stale as quadrics merge; entries that got more expensive go back in line
+            float current = cost(from, to);
+            if (current > collapse.cost * 1.0001f + 1e-12f)
+            {
+                queue.push({current, from, to});
+                continue;
+            }
+            if (current > maxErrorSquared)
+            {
+                break;
+            }
+
+            // The vertices must still share an edge, and no other triangle may flip
+            bool connected = false;
+            bool valid = true;
+            for (uint32_t t : vertexTriangles[from])
+            {
+                if (triangleRemoved[t])
+                {
+                    continue;
+                }
+
+                const uint32_t *triangle = &triangles[t * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    connected = true;
+                    continue;
+                }
+
+                Vector3 points[3];
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    points[k] = vertices[triangle[k]].position;
+                }
+                Vector3 before = triangleNormal(points[0], points[1], points[2]);
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    if (triangle[k] == from)
+                    {
+                        points[k] = vertices[to].position;
+                    }
+                }
+                Vector3 after = triangleNormal(points[0], points[1], points[2]);
+
+                double lengths = std::sqrt(dot(before, before) * dot(after, after));
+                if (lengths > 0.0 && dot(before, after) < 0.2 * lengths)
+                {
+                    valid = false;
+                    break;
+                }
+            }
+            if (!connected || !valid)
+            {
+                continue;
+            }
+
+            // Triangles on the edge vanish, the others move their corner onto the target
+            for (uint32_t t : vertexTriangles[from])
+            {
+                if (triangleRemoved[t])
+                {
+                    continue;
+                }
+
+                uint32_t *triangle = &triangles[t * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    triangleRemoved[t] = 1;
+                    remaining -= 3;
+                    continue;
+                }
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    if (triangle[k] == from)
+                    {
+                        triangle[k] = to;
+                    }
+                }
+                vertexTriangles[to].push_back(t);
+            }
+
+            std::vector<uint32_t>().swap(vertexTriangles[from]);
+            vertexRemoved[from] = 1;
+            quadrics[to].add(quadrics[from]);
+            worstError = std::max(worstError, current);
+
+            std::vector<uint32_t> &around = vertexTriangles[to];
+            around.erase(std::remove_if(around.begin(), around.end(), [&](uint32_t t) { return triangleRemoved[t] != 0; }),
+                         around.end());
+            for (uint32_t t : around)
+            {
+                pushEdges(t);
+            }
+        }
+
+        std::vector<uint32_t> result;
+        result.reserve(remaining);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (!triangleRemoved[t])
+            {
+                result.insert(result.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+            }
+        }
+
+        if (resultError)
+        {
+            *resultError = std::sqrt(worstError);
+        }
+        return result;
+    }
+
+    std::vector<MeshLod> MeshSimplifier::generateLods(const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                                                      uint32_t maxLevels, float reduction, float screenError)
+    {
+        std::vector<MeshLod> lods;
+        if (maxLevels < 2 || indices.size() < 3 || vertices.empty())
+        {
+            return lods;
+        }
+
+        // Errors are measured against the bounding sphere the way Mesh computes it
+        BoundingBox bounds;
+        for (const Vertex &vertex : vertices)
+        {
+            bounds.expand(vertex.position);
+        }
+        Vector3 center = bounds.getCenter();
+        float maxDistanceSquared = 0.0f;
+        for (const Vertex &vertex : vertices)
+        {
+            float dx = vertex.position.x - center.x;
+            float dy = vertex.position.y - center.y;
+            float dz = vertex.position.z - center.z;
+            maxDistanceSquared = std::max(maxDistanceSquared, dx * dx + dy * dy + dz * dz);
+        }
+        float radius = std::sqrt(maxDistanceSquared);
+        if (radius <= 0.0f)
+        {
+            return lods;
+        }
+
+        MeshLod full;
+        full.indexCount = static_cast<uint32_t>(indices.size());
+        lods.push_back(full);
+
+        std::vector<uint32_t> source(indices);
+        float totalError = 0.0f;
+        for (uint32_t level = 1; level < maxLevels; ++level)
+        {
+            size_t target = static_cast<size_t>(static_cast<float>(source.size() / 3) * reduction) * 3;
+            float error = 0.0f;
+            std::vector<uint32_t> simplified =
+                simplify(vertices, source, target, std::numeric_limits<float>::max(), &error);
+            if (simplified.empty() || simplified.size() * 10 > source.size() * 9)
+            {
+                break;
+            }
+
+            // Every level starts from the one before it, so the errors add
+            // up. A level's error is error / (2 * radius) of the object's
+            // height; projected, it stays below screenError while the object
+            // covers less of the screen than this
+            totalError += error;
+            float screenSize = totalError > 0.0f ? screenError * 2.0f * radius / totalError
+                                                 : std::numeric_limits<float>::max();
+            if (lods.size() > 1)
+            {
+                screenSize = std::min(screenSize, lods[lods.size() - 2].screenSize);
+            }
+            lods.back().screenSize = screenSize;
+
+            MeshLod lod;
+            lod.indexOffset = static_cast<uint32_t>(indices.size());
+            lod.indexCount = static_cast<uint32_t>(simplified.size());
+            indices.insert(indices.end(), simplified.begin(), simplified.end());
+            lods.push_back(lod);
+            source.swap(simplified);
+        }
+
+        if (lods.size() < 2)
+        {
+            lods.clear();
+        }
+        return lods;
+    }
+
+} // namespace Engine
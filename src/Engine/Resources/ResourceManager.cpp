@@ -1,17 +1,596 @@
 #include "Engine/Resources/ResourceManager.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/Mesh.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/Material.hpp"
+#include "Engine/Resources/AssetArchive.hpp"
+#include "Engine/Resources/CookedMesh.hpp"
+#include "Engine/Resources/FileWatcher.hpp"
+#include "Engine/Resources/TextureFile.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
+#include <iterator>
+
+#include <stb_image.h>
 
 namespace Engine
 {
 
+    namespace
+    {
+        /**
+         * @brief Builds the vertices of a unit cube centered on the origin
+         * @param vertices Receives four vertices per face
+         * @param indices Receives two counter-clockwise triangles per face
+         */
+        void buildCube(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+        {
+            // Normal and tangent of every face; the bitangent completes a
+            // right-handed frame, so the corners wind counter-clockwise
+            static const float faces[6][6] = {
+                {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f},
+                {-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f},
+                {0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f},
+                {0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f},
+                {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+                {0.0f, 0.0f, -1.0f, -1.0f, 0.0f, 0.0f}};
+            static const float corners[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+            for (const auto &face : faces)
+            {
+                Vector3 normal(face[0], face[1], face[2]);
+                Vector3 tangent(face[3], face[4], face[5]);
+                Vector3 bitangent = normal.cross(tangent);
+
+                uint32_t first = static_cast<uint32_t>(vertices.size());
+                for (const auto &corner : corners)
+                {
+                    Vertex vertex;
+                    vertex.position = Vector3(0.5f * (normal.x + corner[0] * tangent.x + corner[1] * bitangent.x),
+                                              0.5f * (normal.y + corner[0] * tangent.y + corner[1] * bitangent.y),
+                                              0.5f * (normal.z + corner[0] * tangent.z + corner[1] * bitangent.z));
+                    vertex.normal = normal;
+                    vertex.texCoord = Vector2(0.5f * (corner[0] + 1.0f), 0.5f * (corner[1] + 1.0f));
+                    vertex.tangent = tangent;
+                    vertex.bitangent = bitangent;
+                    vertices.push_back(vertex);
+                }
+
+                indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+            }
+        }
+
+        /**
+         * @brief Gets the GPU memory of one level of a texture file
+         * @param file Texture file
+         * @param level Level index
+         * @return Size of the level in bytes, as counted by Texture::getMemorySize()
+         */
+        size_t getLevelSize(const TextureFile &file, int level)
+        {
+            return getTextureLevelSize(file.getFormat(), std::max(1, file.getWidth() >> level),
+                                       std::max(1, file.getHeight() >> level));
+        }
+
+        /**
+         * @brief Time a changed file has to stay unchanged before it is reloaded, in nanoseconds
+         */
+        const uint64_t RELOAD_DELAY = 200000000ull;
+
+        /**
+         * @brief Brings an asset path to the form the file watcher reports
+         * @param path Asset path relative to the resources directory
+         * @return Path with '/' separators and without leading "./"
+         */
+        std::string normalizeAssetPath(const std::string &path)
+        {
+            std::string result = path;
+            std::replace(result.begin(), result.end(), '\\', '/');
+            while (result.compare(0, 2, "./") == 0)
+            {
+                result.erase(0, 2);
+            }
+            return result;
+        }
+    }
+
+    struct ResourceManager::TextureLoad : ResourceManager::PendingLoad
+    {
+        /**
+         * @brief Asset path of the texture file
+         */
+        std::string path;
+
+        /**
+         * @brief Decoded image size and format
+         */
+        int width = 0;
+        int height = 0;
+        TextureFormat format = TextureFormat::RGBA;
+
+        /**
+         * @brief Decoded pixels, released after the upload
+         */
+        std::vector<unsigned char> pixels;
+
+        /**
+         * @brief KTX2 or DDS file, kept for streaming the finer levels
+         */
+        std::shared_ptr<TextureFile> file;
+
+        /**
+         * @brief Uploaded texture, until it is registered
+         */
+        std::unique_ptr<Texture> texture;
+
+        /**
+         * @brief State shared with the handles
+         */
+        std::shared_ptr<AsyncResource<Texture>::State> state;
+
+        /**
+         * @brief Callbacks to run once the load finished
+         */
+        std::vector<std::function<void(Texture *)>> callbacks;
+
+        bool decode(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Decode texture");
+
+            AssetData asset;
+            if (!manager.openAsset(path, asset))
+            {
+                return false;
+            }
+
+            // Containers are uploaded as they are, level by level
+            if (TextureFile::isContainer(asset.getData(), asset.getSize()))
+            {
+                file = std::make_shared<TextureFile>();
+                return file->open(std::move(asset), path);
+            }
+
+            int channels;
+            unsigned char *data = stbi_load_from_memory(asset.getData(), static_cast<int>(asset.getSize()),
+                                                        &width, &height, &channels, 0);
+            if (!data)
+            {
+                Logger::error("Failed to load texture: {}", path);
+                return false;
+            }
+
+            bool supported = channels == 3 || channels == 4;
+            if (supported)
+            {
+                format = channels == 3 ? TextureFormat::RGB : TextureFormat::RGBA;
+                pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+            }
+            else
+            {
+                Logger::error("Unsupported texture format: {} channels", channels);
+            }
+
+            stbi_image_free(data);
+            return supported;
+        }
+
+        bool upload(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Upload texture");
+
+            texture = manager.createTexture();
+            if (file)
+            {
+                return uploadLevels(manager.streamingStartSize);
+            }
+
+            bool result = texture->create(width, height, pixels.data(), format);
+            std::vector<unsigned char>().swap(pixels);
+            return result;
+        }
+
+        /**
+         * @brief Uploads the coarse levels of a KTX2 or DDS file
+         * @param startSize Largest dimension of the finest level to upload, 0 for every level
+         * @return True if the upload succeeded, false otherwise
+         */
+        bool uploadLevels(int startSize)
+        {
+            int mipCount = file->getMipCount();
+            if (!texture->allocate(file->getWidth(), file->getHeight(), file->getFormat(), mipCount))
+            {
+                Logger::error("Failed to create texture: {}", path);
+                return false;
+            }
+
+            // Coarsest first, so the texture can be sampled after every level
+            for (int level = mipCount - 1; level >= 0; --level)
+            {
+                bool small = std::max(file->getWidth() >> level, file->getHeight() >> level) <= startSize;
+                if (startSize > 0 && !small && level < mipCount - 1)
+                {
+                    break;
+                }
+                if (!texture->uploadMip(level, file->getMipData(level), file->getMipSize(level)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            manager.pendingTextures.erase(name);
+
+            Texture *result = nullptr;
+            if (succeeded)
+            {
+                // A synchronous load of the same name may have won the race
+                TextureHandle handle = manager.textures.find(name);
+                if (!handle.isValid())
+                {
+                    handle = manager.addTexture(name, *this);
+                    manager.texturePaths[name] = normalizeAssetPath(path);
+                    Logger::info("Loaded texture: {}", name);
+                }
+                result = manager.textures.get(handle);
+                state->handle.store(handle.value, std::memory_order_relaxed);
+                state->resource.store(result, std::memory_order_release);
+                state->state.store(LoadState::Ready, std::memory_order_release);
+            }
+            else
+            {
+                Logger::error("Failed to load texture: {}", name);
+                state->state.store(LoadState::Failed, std::memory_order_release);
+            }
+
+            for (auto &callback : callbacks)
+            {
+                callback(result);
+            }
+        }
+    };
+
+    struct ResourceManager::MeshLoad : ResourceManager::PendingLoad
+    {
+        /**
+         * @brief Asset path of the mesh file
+         */
+        std::string path;
+
+        /**
+         * @brief Mapped mesh file, closed after the upload
+         */
+        CookedMesh cooked;
+
+        /**
+         * @brief Uploaded mesh, until it is registered
+         */
+        std::unique_ptr<Mesh> mesh;
+
+        /**
+         * @brief State shared with the handles
+         */
+        std::shared_ptr<AsyncResource<Mesh>::State> state;
+
+        /**
+         * @brief Callbacks to run once the load finished
+         */
+        std::vector<std::function<void(Mesh *)>> callbacks;
+
+        bool decode(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Decode mesh");
+
+            // Page the file in here, so the upload does not wait for the disk
+            AssetData file;
+            if (!manager.openAsset(path, file) || !cooked.open(std::move(file), path))
+            {
+                return false;
+            }
+            cooked.prefetch();
+            return true;
+        }
+
+        bool upload(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Upload mesh");
+
+            mesh = manager.createMesh(name);
+            mesh->setSubMeshes(cooked.getSubMeshes());
+            mesh->setLods(cooked.getLods());
+            bool result = mesh->build(cooked.getData());
+            cooked.close();
+            return result;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            manager.pendingMeshes.erase(name);
+
+            Mesh *result = nullptr;
+            if (succeeded)
+            {
+                MeshHandle handle = manager.meshes.find(name);
+                if (!handle.isValid())
+                {
+                    size_t bytes = mesh->getMemorySize();
+                    handle = manager.meshes.add(name, std::move(mesh), bytes);
+                    manager.meshPaths[name] = normalizeAssetPath(path);
+                    Logger::info("Loaded mesh: {}", name);
+                }
+                result = manager.meshes.get(handle);
+                state->handle.store(handle.value, std::memory_order_relaxed);
+                state->resource.store(result, std::memory_order_release);
+                state->state.store(LoadState::Ready, std::memory_order_release);
+            }
+            else
+            {
+                Logger::error("Failed to load mesh: {}", name);
+                state->state.store(LoadState::Failed, std::memory_order_release);
+            }
+
+            for (auto &callback : callbacks)
+            {
+                callback(result);
+            }
+        }
+    };
+
+    struct ResourceManager::ShaderLoad : ResourceManager::PendingLoad
+    {
+        /**
+         * @brief Asset paths of the vertex and fragment shader files
+         */
+        std::string vertexPath;
+        std::string fragmentPath;
+
+        /**
+         * @brief Shader sources, released after the upload
+         */
+        std::string vertexSource;
+        std::string fragmentSource;
+
+        /**
+         * @brief Compiled shader, until it is registered
+         */
+        std::unique_ptr<Shader> shader;
+
+        /**
+         * @brief State shared with the handles
+         */
+        std::shared_ptr<AsyncResource<Shader>::State> state;
+
+        /**
+         * @brief Callbacks to run once the load finished
+         */
+        std::vector<std::function<void(Shader *)>> callbacks;
+
+        bool decode(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Load shader source");
+
+            return manager.loadAssetToString(vertexPath, vertexSource) &&
+                   manager.loadAssetToString(fragmentPath, fragmentSource);
+        }
+
+        bool upload(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Compile shader");
+
+            shader = manager.createShader(name);
+            bool result = shader->compile(vertexSource, fragmentSource);
+            std::string().swap(vertexSource);
+            std::string().swap(fragmentSource);
+            if (!result)
+            {
+                Logger::error("Failed to compile shader: {}", name);
+            }
+            return result;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            manager.pendingShaders.erase(name);
+
+            Shader *result = nullptr;
+            if (succeeded)
+            {
+                ShaderHandle handle = manager.shaders.find(name);
+                if (!handle.isValid())
+                {
+                    handle = manager.shaders.add(name, std::move(shader));
+                    manager.shaderPaths[name] = {normalizeAssetPath(vertexPath), normalizeAssetPath(fragmentPath)};
+                    Logger::info("Loaded shader: {}", name);
+                }
+                result = manager.shaders.get(handle);
+                state->handle.store(handle.value, std::memory_order_relaxed);
+                state->resource.store(result, std::memory_order_release);
+                state->state.store(LoadState::Ready, std::memory_order_release);
+            }
+            else
+            {
+                Logger::error("Failed to load shader: {}", name);
+                state->state.store(LoadState::Failed, std::memory_order_release);
+            }
+
+            for (auto &callback : callbacks)
+            {
+                callback(result);
+            }
+        }
+    };
+
+    struct ResourceManager::TextureReload : ResourceManager::TextureLoad
+    {
+        /**
+         * @brief Handle of the texture being replaced, acquired until the reload finished
+         */
+        TextureHandle handle;
+
+        /**
+         * @brief Texture being replaced, owned by the texture pool
+         */
+        Texture *target = nullptr;
+
+        /**
+         * @brief File the texture streamed from before the reload
+         */
+        std::shared_ptr<TextureFile> previousFile;
+
+        /**
+         * @brief Finest level requested before the reload
+         */
+        int requestedMip = 0;
+
+        bool upload(ResourceManager &manager) override
+        {
+            // The new texture is built on the side, so the old one is drawn until the swap
+            if (!TextureLoad::upload(manager))
+            {
+                return false;
+            }
+            target->swapContents(*texture);
+            return true;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            if (succeeded)
+            {
+                Logger::info("Reloaded texture: {}", name);
+            }
+            else
+            {
+                Logger::error("Failed to reload texture: {}", name);
+            }
+
+            // Mip levels queued before the reload were dropped, so count what is resident
+            manager.textures.resize(handle, target->getMemorySize());
+            std::shared_ptr<TextureFile> streamedFile = succeeded ? std::move(file) : std::move(previousFile);
+            if (streamedFile)
+            {
+                StreamedTexture &streamed = manager.streamedTextures[handle.value];
+                streamed.handle = handle;
+                streamed.texture = target;
+                streamed.requestedMip = std::max(0, std::min(requestedMip, streamedFile->getMipCount() - 1));
+                streamed.targetMip = target->getResidentMip();
+                streamed.file = std::move(streamedFile);
+            }
+
+            // After a swap this holds the old storage, which frames in flight may still draw
+            if (texture)
+            {
+                manager.getRetiredResources().textures.push_back(std::move(texture));
+            }
+
+            manager.textures.release(handle);
+            if (manager.endReload("texture:" + name))
+            {
+                manager.reloadTexture(name);
+            }
+        }
+    };
+
+    struct ResourceManager::MeshReload : ResourceManager::MeshLoad
+    {
+        /**
+         * @brief Handle of the mesh being replaced, acquired until the reload finished
+         */
+        MeshHandle handle;
+
+        /**
+         * @brief Mesh being replaced, owned by the mesh pool
+         */
+        Mesh *target = nullptr;
+
+        bool upload(ResourceManager &manager) override
+        {
+            if (!MeshLoad::upload(manager))
+            {
+                return false;
+            }
+            target->swapBuffers(*mesh);
+            return true;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            if (succeeded)
+            {
+                // Culling reads the bounds on the main thread, so they follow the buffers here
+                target->swapBounds(*mesh);
+                manager.meshes.resize(handle, target->getMemorySize());
+                Logger::info("Reloaded mesh: {}", name);
+            }
+            else
+            {
+                Logger::error("Failed to reload mesh: {}", name);
+            }
+
+            // The replaced buffers, which frames in flight may still draw
+            if (mesh)
+            {
+                manager.getRetiredResources().meshes.push_back(std::move(mesh));
+            }
+
+            manager.meshes.release(handle);
+            if (manager.endReload("mesh:" + name))
+            {
+                manager.reloadMesh(name);
+            }
+        }
+    };
+
+    struct ResourceManager::ShaderReload : ResourceManager::ShaderLoad
+    {
+        /**
+         * @brief Handle of the shader being recompiled, acquired until the reload finished
+         */
+        ShaderHandle handle;
+
+        /**
+         * @brief Shader being recompiled, owned by the shader pool
+         */
+        Shader *target = nullptr;
+
+        bool upload(ResourceManager &manager) override
+        {
+            ENGINE_PROFILE_SCOPE("Recompile shader");
+            (void)manager;
+
+            // A program that fails to compile or link leaves the old one in use
+            bool result = target->compile(vertexSource, fragmentSource);
+            std::string().swap(vertexSource);
+            std::string().swap(fragmentSource);
+            return result;
+        }
+
+        void finish(ResourceManager &manager) override
+        {
+            // Materials re-resolve their uniforms when they see the new revision
+            if (succeeded)
+            {
+                Logger::info("Reloaded shader: {}", name);
+            }
+            else
+            {
+                Logger::error("Failed to reload shader, keeping the previous version: {}", name);
+            }
+
+            manager.shaders.release(handle);
+            if (manager.endReload("shader:" + name))
+            {
+                manager.reloadShader(name);
+            }
+        }
+    };
+
     ResourceManager::ResourceManager()
     {
     }
@@ -24,30 +603,110 @@ namespace Engine
         }
     }
 
-    bool ResourceManager::initialize()
+    bool ResourceManager::initialize(JobSystem *jobSystem)
     {
         Logger::info("Initializing resource manager...");
+        this->jobSystem = jobSystem;
         initialized = true;
         return true;
     }
 
+    bool ResourceManager::createPlaceholders(Shader *shader)
+    {
+        placeholderShader = shader;
+
+        // Single white texel, which leaves material colors unchanged
+        unsigned char white[4] = {255, 255, 255, 255};
+        placeholderTexture = createTexture();
+        if (!placeholderTexture->create(1, 1, white, TextureFormat::RGBA))
+        {
+            Logger::error("Failed to create placeholder texture");
+            placeholderTexture.reset();
+            return false;
+        }
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        buildCube(vertices, indices);
+        placeholderMesh = createMesh("Placeholder");
+        placeholderMesh->setVertices(vertices);
+        placeholderMesh->setIndices(indices);
+        if (!placeholderMesh->build())
+        {
+            Logger::error("Failed to create placeholder mesh");
+            placeholderMesh.reset();
+            return false;
+        }
+
+        return true;
+    }
+
     void ResourceManager::shutdown()
     {
         Logger::info("Shutting down resource manager...");
 
+        setAutoReload(false);
+
+        // Let running decode jobs finish before the loads go away
+        if (jobSystem)
+        {
+            jobSystem->wait(decodeCounter);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            decodedLoads.clear();
+            uploadedLoads.clear();
+            evictedTextures.clear();
+            evictedMeshes.clear();
+            mipUploads.clear();
+        }
+        retiredResources.clear();
+        streamedTextures.clear();
+
+        // Loads that never finished fail, so their handles stop waiting
+        for (auto &pair : pendingTextures)
+        {
+            pair.second->state->state.store(LoadState::Failed, std::memory_order_release);
+        }
+        for (auto &pair : pendingMeshes)
+        {
+            pair.second->state->state.store(LoadState::Failed, std::memory_order_release);
+        }
+        for (auto &pair : pendingShaders)
+        {
+            pair.second->state->state.store(LoadState::Failed, std::memory_order_release);
+        }
+        pendingTextures.clear();
+        pendingMeshes.clear();
+        pendingShaders.clear();
+        activeReloads.clear();
+        texturePaths.clear();
+        meshPaths.clear();
+        shaderPaths.clear();
+
         // Clear all resources
+        placeholderTexture.reset();
+        placeholderMesh.reset();
+        placeholderShader = nullptr;
         textures.clear();
         meshes.clear();
         shaders.clear();
         materials.clear();
 
+        // Nothing reads from the archives any more
+        {
+            std::unique_lock<std::shared_mutex> lock(archiveMutex);
+            archives.clear();
+        }
+
         initialized = false;
     }
 
     void ResourceManager::setResourcesPath(const std::string &path)
     {
         resourcesPath = path;
-        Logger::info("Resources path set to: " + resourcesPath);
+        Logger::info("Resources path set to: {}", resourcesPath);
     }
 
     std::string ResourceManager::getResourcePath(const std::string &relativePath) const
@@ -55,114 +714,199 @@ namespace Engine
         return resourcesPath + "/" + relativePath;
     }
 
-    Texture *ResourceManager::getTexture(const std::string &name)
+    bool ResourceManager::mountArchive(const std::string &filepath)
     {
-        auto it = textures.find(name);
-        if (it != textures.end())
+        auto archive = std::make_unique<AssetArchive>();
+        if (!archive->open(filepath))
         {
-            return it->second.get();
+            Logger::error("Failed to mount asset archive: {}", filepath);
+            return false;
         }
-        return nullptr;
+
+        Logger::info("Mounted asset archive: {} ({} assets)", filepath, archive->getEntryCount());
+
+        std::unique_lock<std::shared_mutex> lock(archiveMutex);
+        archives.push_back(std::move(archive));
+        return true;
     }
 
-    Mesh *ResourceManager::getMesh(const std::string &name)
+    bool ResourceManager::openAsset(const std::string &relativePath, AssetData &data) const
     {
-        auto it = meshes.find(name);
-        if (it != meshes.end())
         {
-            return it->second.get();
+            std::shared_lock<std::shared_mutex> lock(archiveMutex);
+            for (auto it = archives.rbegin(); it != archives.rend(); ++it)
+            {
+                const AssetArchiveEntry *entry = (*it)->find(relativePath);
+                if (entry)
+                {
+                    return (*it)->read(*entry, data);
+                }
+            }
         }
-        return nullptr;
+
+        if (!looseFiles)
+        {
+            Logger::error("Asset not found in any archive: {}", relativePath);
+            return false;
+        }
+
+        return data.mapFile(getResourcePath(relativePath));
     }
 
-    Shader *ResourceManager::getShader(const std::string &name)
+    void ResourceManager::prefetch(const std::vector<std::string> &relativePaths)
     {
-        auto it = shaders.find(name);
-        if (it != shaders.end())
+        // Large enough batches that the job overhead does not dominate small files
+        const size_t batchSize = 16;
+
+        for (size_t first = 0; first < relativePaths.size(); first += batchSize)
         {
-            return it->second.get();
+            size_t last = std::min(first + batchSize, relativePaths.size());
+            std::vector<std::string> batch(relativePaths.begin() + first, relativePaths.begin() + last);
+
+            auto job = [this, batch = std::move(batch)]()
+            {
+                for (const std::string &relativePath : batch)
+                {
+                    {
+                        std::shared_lock<std::shared_mutex> lock(archiveMutex);
+                        const AssetArchiveEntry *entry = nullptr;
+                        for (auto it = archives.rbegin(); it != archives.rend() && !entry; ++it)
+                        {
+                            entry = (*it)->find(relativePath);
+                            if (entry)
+                            {
+                                (*it)->prefetch(*entry);
+                            }
+                        }
+                        if (entry)
+                        {
+                            continue;
+                        }
+                    }
+
+                    // Loose files only warm the page cache; the mapping goes away
+                    // again, but the pages it touched stay resident
+                    std::error_code error;
+                    std::string path = getResourcePath(relativePath);
+                    if (looseFiles && std::filesystem::exists(path, error))
+                    {
+                        AssetData data;
+                        if (data.mapFile(path))
+                        {
+                            data.prefetch();
+                        }
+                    }
+                }
+            };
+
+            if (jobSystem)
+            {
+                jobSystem->submit(job, &decodeCounter);
+            }
+            else
+            {
+                job();
+            }
         }
-        return nullptr;
+    }
+
+    Texture *ResourceManager::getTexture(const std::string &name)
+    {
+        return textures.get(textures.find(name));
+    }
+
+    Mesh *ResourceManager::getMesh(const std::string &name)
+    {
+        return meshes.get(meshes.find(name));
+    }
+
+    Shader *ResourceManager::getShader(const std::string &name)
+    {
+        return shaders.get(shaders.find(name));
     }
 
     Material *ResourceManager::getMaterial(const std::string &name)
     {
-        auto it = materials.find(name);
-        if (it != materials.end())
-        {
-            return it->second.get();
-        }
-        return nullptr;
+        return materials.get(materials.find(name));
     }
 
     Texture *ResourceManager::loadTexture(const std::string &name, const std::string &filepath)
     {
         // Check if texture already exists
-        if (textures.find(name) != textures.end())
+        TextureHandle existing = textures.find(name);
+        if (existing.isValid())
         {
-            Logger::warning("Texture '" + name + "' already exists");
-            return textures[name].get();
+            Logger::warning("Texture '{}' already exists", name);
+            return textures.get(existing);
         }
 
-        // Create texture
-        auto texture = createTexture();
-        if (!texture->load(getResourcePath(filepath)))
+        // Decode and create the texture the same way async loads do
+        TextureLoad load;
+        load.path = filepath;
+        if (!load.decode(*this) || !load.upload(*this))
         {
-            Logger::error("Failed to load texture: " + filepath);
+            Logger::error("Failed to load texture: {}", filepath);
             return nullptr;
         }
 
-        // Add to map
-        textures[name] = std::move(texture);
-        Logger::info("Loaded texture: " + name);
-        return textures[name].get();
+        // Add to pool
+        Texture *texture = textures.get(addTexture(name, load));
+        texturePaths[name] = normalizeAssetPath(filepath);
+        Logger::info("Loaded texture: {}", name);
+        return texture;
     }
 
     Mesh *ResourceManager::loadMesh(const std::string &name, const std::string &filepath)
     {
         // Check if mesh already exists
-        if (meshes.find(name) != meshes.end())
+        MeshHandle existing = meshes.find(name);
+        if (existing.isValid())
         {
-            Logger::warning("Mesh '" + name + "' already exists");
-            return meshes[name].get();
+            Logger::warning("Mesh '{}' already exists", name);
+            return meshes.get(existing);
         }
 
-        // Create mesh
-        auto mesh = createMesh(name);
-        if (!loadMeshFromFile(mesh.get(), getResourcePath(filepath)))
+        // Map and build the mesh the same way async loads do
+        MeshLoad load;
+        load.name = name;
+        load.path = filepath;
+        if (!load.decode(*this) || !load.upload(*this))
         {
-            Logger::error("Failed to load mesh: " + filepath);
+            Logger::error("Failed to load mesh: {}", filepath);
             return nullptr;
         }
 
-        // Add to map
-        meshes[name] = std::move(mesh);
-        Logger::info("Loaded mesh: " + name);
-        return meshes[name].get();
+        // Add to pool
+        size_t bytes = load.mesh->getMemorySize();
+        Mesh *mesh = meshes.get(meshes.add(name, std::move(load.mesh), bytes));
+        meshPaths[name] = normalizeAssetPath(filepath);
+        Logger::info("Loaded mesh: {}", name);
+        return mesh;
     }
 
     Shader *ResourceManager::loadShader(const std::string &name, const std::string &vertexPath, const std::string &fragmentPath)
     {
         // Check if shader already exists
-        if (shaders.find(name) != shaders.end())
+        ShaderHandle existing = shaders.find(name);
+        if (existing.isValid())
         {
-            Logger::warning("Shader '" + name + "' already exists");
-            return shaders[name].get();
+            Logger::warning("Shader '{}' already exists", name);
+            return shaders.get(existing);
         }
 
         // Load shader sources
         std::string vertexSource;
         std::string fragmentSource;
 
-        if (!loadFileToString(getResourcePath(vertexPath), vertexSource))
+        if (!loadAssetToString(vertexPath, vertexSource))
         {
-            Logger::error("Failed to load vertex shader: " + vertexPath);
+            Logger::error("Failed to load vertex shader: {}", vertexPath);
             return nullptr;
         }
 
-        if (!loadFileToString(getResourcePath(fragmentPath), fragmentSource))
+        if (!loadAssetToString(fragmentPath, fragmentSource))
         {
-            Logger::error("Failed to load fragment shader: " + fragmentPath);
+            Logger::error("Failed to load fragment shader: {}", fragmentPath);
             return nullptr;
         }
 
@@ -170,46 +914,643 @@ namespace Engine
         auto shader = createShader(name);
         if (!shader->compile(vertexSource, fragmentSource))
         {
-            Logger::error("Failed to compile shader: " + name);
+            Logger::error("Failed to compile shader: {}", name);
             return nullptr;
         }
 
-        // Add to map
-        shaders[name] = std::move(shader);
-        Logger::info("Loaded shader: " + name);
-        return shaders[name].get();
+        // Add to pool
+        Shader *result = shaders.get(shaders.add(name, std::move(shader)));
+        shaderPaths[name] = {normalizeAssetPath(vertexPath), normalizeAssetPath(fragmentPath)};
+        Logger::info("Loaded shader: {}", name);
+        return result;
     }
 
     Material *ResourceManager::createMaterial(const std::string &name, Shader *shader)
     {
         // Check if material already exists
-        if (materials.find(name) != materials.end())
+        MaterialHandle existing = materials.find(name);
+        if (existing.isValid())
         {
-            Logger::warning("Material '" + name + "' already exists");
-            return materials[name].get();
+            Logger::warning("Material '{}' already exists", name);
+            return materials.get(existing);
         }
 
         // Create material
         auto material = std::make_unique<Material>(name, shader);
 
-        // Add to map
-        materials[name] = std::move(material);
-        Logger::info("Created material: " + name);
-        return materials[name].get();
+        // Add to pool
+        Material *result = materials.get(materials.add(name, std::move(material)));
+        Logger::info("Created material: {}", name);
+        return result;
     }
 
-    bool ResourceManager::loadFileToString(const std::string &filepath, std::string &output)
+    AsyncResource<Texture> ResourceManager::loadTextureAsync(const std::string &name, const std::string &filepath,
+                                                             std::function<void(Texture *)> onLoaded)
     {
-        std::ifstream file(filepath);
-        if (!file)
+        using State = AsyncResource<Texture>::State;
+
+        // Already loaded
+        TextureHandle handle = textures.find(name);
+        if (handle.isValid())
+        {
+            Texture *texture = textures.get(handle);
+            auto state = std::make_shared<State>();
+            state->handle.store(handle.value, std::memory_order_relaxed);
+            state->resource.store(texture, std::memory_order_relaxed);
+            state->state.store(LoadState::Ready, std::memory_order_release);
+            if (onLoaded)
+            {
+                onLoaded(texture);
+            }
+            return AsyncResource<Texture>(state);
+        }
+
+        // Already loading
+        auto pending = pendingTextures.find(name);
+        if (pending != pendingTextures.end())
+        {
+            if (onLoaded)
+            {
+                pending->second->callbacks.push_back(std::move(onLoaded));
+            }
+            return AsyncResource<Texture>(pending->second->state);
+        }
+
+        auto load = std::make_shared<TextureLoad>();
+        load->name = name;
+        load->path = filepath;
+        load->state = std::make_shared<State>();
+        load->state->resource.store(placeholderTexture.get(), std::memory_order_relaxed);
+        if (onLoaded)
+        {
+            load->callbacks.push_back(std::move(onLoaded));
+        }
+
+        pendingTextures[name] = load;
+        startLoad(load);
+        return AsyncResource<Texture>(load->state);
+    }
+
+    AsyncResource<Mesh> ResourceManager::loadMeshAsync(const std::string &name, const std::string &filepath,
+                                                       std::function<void(Mesh *)> onLoaded)
+    {
+        using State = AsyncResource<Mesh>::State;
+
+        // Already loaded
+        MeshHandle handle = meshes.find(name);
+        if (handle.isValid())
+        {
+            Mesh *mesh = meshes.get(handle);
+            auto state = std::make_shared<State>();
+            state->handle.store(handle.value, std::memory_order_relaxed);
+            state->resource.store(mesh, std::memory_order_relaxed);
+            state->state.store(LoadState::Ready, std::memory_order_release);
+            if (onLoaded)
+            {
+                onLoaded(mesh);
+            }
+            return AsyncResource<Mesh>(state);
+        }
+
+        // Already loading
+        auto pending = pendingMeshes.find(name);
+        if (pending != pendingMeshes.end())
+        {
+            if (onLoaded)
+            {
+                pending->second->callbacks.push_back(std::move(onLoaded));
+            }
+            return AsyncResource<Mesh>(pending->second->state);
+        }
+
+        auto load = std::make_shared<MeshLoad>();
+        load->name = name;
+        load->path = filepath;
+        load->state = std::make_shared<State>();
+        load->state->resource.store(placeholderMesh.get(), std::memory_order_relaxed);
+        if (onLoaded)
+        {
+            load->callbacks.push_back(std::move(onLoaded));
+        }
+
+        pendingMeshes[name] = load;
+        startLoad(load);
+        return AsyncResource<Mesh>(load->state);
+    }
+
+    AsyncResource<Shader> ResourceManager::loadShaderAsync(const std::string &name, const std::string &vertexPath,
+                                                           const std::string &fragmentPath,
+                                                           std::function<void(Shader *)> onLoaded)
+    {
+        using State = AsyncResource<Shader>::State;
+
+        // Already loaded
+        ShaderHandle handle = shaders.find(name);
+        if (handle.isValid())
+        {
+            Shader *shader = shaders.get(handle);
+            auto state = std::make_shared<State>();
+            state->handle.store(handle.value, std::memory_order_relaxed);
+            state->resource.store(shader, std::memory_order_relaxed);
+            state->state.store(LoadState::Ready, std::memory_order_release);
+            if (onLoaded)
+            {
+                onLoaded(shader);
+            }
+            return AsyncResource<Shader>(state);
+        }
+
+        // Already loading
+        auto pending = pendingShaders.find(name);
+        if (pending != pendingShaders.end())
+        {
+            if (onLoaded)
+            {
+                pending->second->callbacks.push_back(std::move(onLoaded));
+            }
+            return AsyncResource<Shader>(pending->second->state);
+        }
+
+        auto load = std::make_shared<ShaderLoad>();
+        load->name = name;
+        load->vertexPath = vertexPath;
+        load->fragmentPath = fragmentPath;
+        load->state = std::make_shared<State>();
+        load->state->resource.store(placeholderShader, std::memory_order_relaxed);
+        if (onLoaded)
+        {
+            load->callbacks.push_back(std::move(onLoaded));
+        }
+
+        pendingShaders[name] = load;
+        startLoad(load);
+        return AsyncResource<Shader>(load->state);
+    }
+
+    void ResourceManager::startLoad(std::shared_ptr<PendingLoad> load)
+    {
+        auto job = [this, load]()
+        {
+            load->succeeded = load->decode(*this);
+
+            // Failed loads skip the upload but still go through the queue,
+            // so that update() reports them on the main thread
+            std::lock_guard<std::mutex> lock(queueMutex);
+            (load->succeeded ? decodedLoads : uploadedLoads).push_back(load);
+        };
+
+        if (jobSystem)
+        {
+            jobSystem->submit(job, &decodeCounter);
+        }
+        else
+        {
+            job();
+        }
+    }
+
+    void ResourceManager::processUploads(float budgetMilliseconds)
+    {
+        ENGINE_PROFILE_SCOPE("ResourceManager::processUploads");
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Free the GPU memory of evicted resources here, on the graphics
+        // thread. update() only queues them once no frame in flight can
+        // still draw them
+        std::vector<std::unique_ptr<Texture>> texturesToDestroy;
+        std::vector<std::unique_ptr<Mesh>> meshesToDestroy;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            texturesToDestroy.swap(evictedTextures);
+            meshesToDestroy.swap(evictedMeshes);
+        }
+        texturesToDestroy.clear();
+        meshesToDestroy.clear();
+
+        while (true)
+        {
+            std::shared_ptr<PendingLoad> load;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (decodedLoads.empty())
+                {
+                    break;
+                }
+                load = std::move(decodedLoads.front());
+                decodedLoads.pop_front();
+            }
+
+            load->succeeded = load->upload(*this);
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                uploadedLoads.push_back(std::move(load));
+            }
+
+            // A single large upload may overrun the budget, but no further
+            // upload is started once it is spent
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetMilliseconds)
+            {
+                return;
+            }
+        }
+
+        // Stream mip levels with the time that is left
+        while (true)
+        {
+            MipUpload upload;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (mipUploads.empty())
+                {
+                    break;
+                }
+                upload = std::move(mipUploads.front());
+                mipUploads.pop_front();
+            }
+
+            if (!upload.file)
+            {
+                upload.texture->dropMips(upload.level);
+            }
+            else if (!upload.texture->uploadMip(upload.level, upload.file->getMipData(upload.level),
+                                                upload.file->getMipSize(upload.level)))
+            {
+                Logger::error("Failed to stream texture mip level {}", upload.level);
+            }
+
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetMilliseconds)
+            {
+                break;
+            }
+        }
+    }
+
+    bool ResourceManager::hasPendingUploads() const
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return !decodedLoads.empty() || !mipUploads.empty() || !evictedTextures.empty() || !evictedMeshes.empty();
+    }
+
+    void ResourceManager::update()
+    {
+        ++frameIndex;
+
+        std::deque<std::shared_ptr<PendingLoad>> finished;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            finished.swap(uploadedLoads);
+        }
+
+        for (auto &load : finished)
+        {
+            load->finish(*this);
+        }
+
+        // Evict after registering, so new loads count against the budgets
+        std::vector<std::unique_ptr<Texture>> unusedTextures;
+        std::vector<std::unique_ptr<Mesh>> unusedMeshes;
+        size_t evictedCount = textures.evict(unusedTextures) + meshes.evict(unusedMeshes);
+        if (evictedCount > 0)
+        {
+            Logger::debug("Evicted {} textures and {} meshes", unusedTextures.size(), unusedMeshes.size());
+
+            // Queued mip levels of evicted textures are never uploaded
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                for (const auto &texture : unusedTextures)
+                {
+                    mipUploads.erase(std::remove_if(mipUploads.begin(), mipUploads.end(), [&](const MipUpload &upload)
+                                                    { return upload.texture == texture.get(); }),
+                                     mipUploads.end());
+                }
+            }
+
+            RetiredResources &retired = getRetiredResources();
+            std::move(unusedTextures.begin(), unusedTextures.end(), std::back_inserter(retired.textures));
+            std::move(unusedMeshes.begin(), unusedMeshes.end(), std::back_inserter(retired.meshes));
+        }
+
+        // Snapshots submitted before a resource was retired may still draw
+        // it until framesInFlight further frames have begun, since the
+        // frame pipeline only hands out a snapshot once the one that many
+        // frames older has been drawn
+        while (!retiredResources.empty() && retiredResources.front().frame + framesInFlight <= frameIndex)
+        {
+            RetiredResources &retired = retiredResources.front();
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                std::move(retired.textures.begin(), retired.textures.end(), std::back_inserter(evictedTextures));
+                std::move(retired.meshes.begin(), retired.meshes.end(), std::back_inserter(evictedMeshes));
+            }
+            retiredResources.pop_front();
+        }
+
+        updateStreaming();
+
+        if (fileWatcher)
+        {
+            updateAutoReload();
+        }
+    }
+
+    ResourceManager::RetiredResources &ResourceManager::getRetiredResources()
+    {
+        if (retiredResources.empty() || retiredResources.back().frame != frameIndex)
+        {
+            retiredResources.emplace_back();
+            retiredResources.back().frame = frameIndex;
+        }
+        return retiredResources.back();
+    }
+
+    void ResourceManager::setAutoReload(bool enabled)
+    {
+        if (!enabled)
+        {
+            fileWatcher.reset();
+            changedAssets.clear();
+            return;
+        }
+
+        if (!fileWatcher)
+        {
+            fileWatcher = std::make_unique<FileWatcher>();
+        }
+        if (!fileWatcher->start(resourcesPath))
+        {
+            Logger::warning("Automatic resource reloading is disabled");
+            fileWatcher.reset();
+        }
+    }
+
+    bool ResourceManager::reloadAsset(const std::string &relativePath)
+    {
+        std::string path = normalizeAssetPath(relativePath);
+        bool found = false;
+
+        for (const auto &pair : texturePaths)
+        {
+            if (pair.second == path)
+            {
+                found = reloadTexture(pair.first) || found;
+            }
+        }
+        for (const auto &pair : meshPaths)
+        {
+            if (pair.second == path)
+            {
+                found = reloadMesh(pair.first) || found;
+            }
+        }
+
+        // Both stages are recompiled when either file changed
+        for (const auto &pair : shaderPaths)
+        {
+            if (pair.second.first == path || pair.second.second == path)
+            {
+                found = reloadShader(pair.first) || found;
+            }
+        }
+        return found;
+    }
+
+    void ResourceManager::updateAutoReload()
+    {
+        ENGINE_PROFILE_SCOPE("ResourceManager::updateAutoReload");
+
+        std::vector<std::string> paths;
+        fileWatcher->poll(paths);
+
+        uint64_t now = Profiler::now();
+        for (std::string &path : paths)
+        {
+            changedAssets[std::move(path)] = now;
+        }
+
+        // Editors save in several writes, so wait until a file is quiet before reading it
+        for (auto it = changedAssets.begin(); it != changedAssets.end();)
+        {
+            if (now - it->second < RELOAD_DELAY)
+            {
+                ++it;
+                continue;
+            }
+
+            if (reloadAsset(it->first))
+            {
+                Logger::debug("Asset changed: {}", it->first);
+            }
+            it = changedAssets.erase(it);
+        }
+    }
+
+    bool ResourceManager::reloadTexture(const std::string &name)
+    {
+        TextureHandle handle = textures.find(name);
+        auto path = texturePaths.find(name);
+        if (!handle.isValid() || path == texturePaths.end())
+        {
+            return false;
+        }
+        if (!beginReload("texture:" + name))
+        {
+            return true;
+        }
+
+        auto load = std::make_shared<TextureReload>();
+        load->name = name;
+        load->path = path->second;
+        load->handle = handle;
+        load->target = textures.get(handle);
+        textures.acquire(handle);
+
+        // The reload uploads its own levels, so stop streaming the old file
+        auto streamed = streamedTextures.find(handle.value);
+        if (streamed != streamedTextures.end())
+        {
+            load->previousFile = std::move(streamed->second.file);
+            load->requestedMip = streamed->second.requestedMip;
+            streamedTextures.erase(streamed);
+
+            Texture *target = load->target;
+            std::lock_guard<std::mutex> lock(queueMutex);
+            mipUploads.erase(std::remove_if(mipUploads.begin(), mipUploads.end(), [target](const MipUpload &upload)
+                                            { return upload.texture == target; }),
+                             mipUploads.end());
+        }
+
+        startLoad(load);
+        return true;
+    }
+
+    bool ResourceManager::reloadMesh(const std::string &name)
+    {
+        MeshHandle handle = meshes.find(name);
+        auto path = meshPaths.find(name);
+        if (!handle.isValid() || path == meshPaths.end())
+        {
+            return false;
+        }
+        if (!beginReload("mesh:" + name))
+        {
+            return true;
+        }
+
+        auto load = std::make_shared<MeshReload>();
+        load->name = name;
+        load->path = path->second;
+        load->handle = handle;
+        load->target = meshes.get(handle);
+        meshes.acquire(handle);
+
+        startLoad(load);
+        return true;
+    }
+
+    bool ResourceManager::reloadShader(const std::string &name)
+    {
+        ShaderHandle handle = shaders.find(name);
+        auto paths = shaderPaths.find(name);
+        if (!handle.isValid() || paths == shaderPaths.end())
+        {
+            return false;
+        }
+        if (!beginReload("shader:" + name))
+        {
+            return true;
+        }
+
+        auto load = std::make_shared<ShaderReload>();
+        load->name = name;
+        load->vertexPath = paths->second.first;
+        load->fragmentPath = paths->second.second;
+        load->handle = handle;
+        load->target = shaders.get(handle);
+        shaders.acquire(handle);
+
+        startLoad(load);
+        return true;
+    }
+
+    bool ResourceManager::beginReload(const std::string &key)
+    {
+        auto result = activeReloads.emplace(key, false);
+        if (!result.second)
+        {
+            result.first->second = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool ResourceManager::endReload(const std::string &key)
+    {
+        auto it = activeReloads.find(key);
+        if (it == activeReloads.end())
         {
-            Logger::error("Failed to open file: " + filepath);
             return false;
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        output = buffer.str();
+        bool again = it->second;
+        activeReloads.erase(it);
+        return again;
+    }
+
+    void ResourceManager::requestTextureMip(TextureHandle handle, int level)
+    {
+        auto it = streamedTextures.find(handle.value);
+        if (it != streamedTextures.end() && textures.contains(handle))
+        {
+            it->second.requestedMip = std::max(0, std::min(level, it->second.file->getMipCount() - 1));
+        }
+    }
+
+    TextureHandle ResourceManager::addTexture(const std::string &name, TextureLoad &load)
+    {
+        Texture *texture = load.texture.get();
+        TextureHandle handle = textures.add(name, std::move(load.texture), texture->getMemorySize());
+
+        // Keep the file of textures with levels left to stream
+        if (load.file)
+        {
+            StreamedTexture &streamed = streamedTextures[handle.value];
+            streamed.handle = handle;
+            streamed.texture = texture;
+            streamed.file = std::move(load.file);
+            streamed.targetMip = texture->getResidentMip();
+        }
+        return handle;
+    }
+
+    void ResourceManager::updateStreaming()
+    {
+        ENGINE_PROFILE_SCOPE("ResourceManager::updateStreaming");
+
+        for (auto it = streamedTextures.begin(); it != streamedTextures.end();)
+        {
+            StreamedTexture &streamed = it->second;
+            if (!textures.contains(streamed.handle))
+            {
+                it = streamedTextures.erase(it);
+                continue;
+            }
+
+            // Coarser requests free the finer levels right away
+            const TextureFile &file = *streamed.file;
+            if (streamed.requestedMip > streamed.targetMip)
+            {
+                size_t freed = 0;
+                for (int level = streamed.targetMip; level < streamed.requestedMip; ++level)
+                {
+                    freed += getLevelSize(file, level);
+                }
+                textures.resize(streamed.handle, textures.getSize(streamed.handle) - freed);
+                streamed.targetMip = streamed.requestedMip;
+
+                std::lock_guard<std::mutex> lock(queueMutex);
+                mipUploads.push_back(MipUpload{streamed.texture, nullptr, streamed.targetMip});
+            }
+
+            // Finer requests get one level per frame while the budget allows
+            else if (streamed.requestedMip < streamed.targetMip)
+            {
+                const ResourceStats &stats = textures.getStats();
+                int level = streamed.targetMip - 1;
+                size_t size = getLevelSize(file, level);
+                if (stats.budget == 0 || stats.residentBytes + size <= stats.budget)
+                {
+                    textures.resize(streamed.handle, textures.getSize(streamed.handle) + size);
+                    streamed.targetMip = level;
+
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    mipUploads.push_back(MipUpload{streamed.texture, streamed.file, level});
+                }
+            }
+
+            ++it;
+        }
+    }
+
+    size_t ResourceManager::getPendingLoadCount() const
+    {
+        return pendingTextures.size() + pendingMeshes.size() + pendingShaders.size();
+    }
+
+    bool ResourceManager::loadAssetToString(const std::string &relativePath, std::string &output) const
+    {
+        AssetData data;
+        if (!openAsset(relativePath, data))
+        {
+            Logger::error("Failed to open file: {}", relativePath);
+            return false;
+        }
 
+        output.assign(reinterpret_cast<const char *>(data.getData()), data.getSize());
         return true;
-    }
\ No newline at end of file
+    }
+
+} // namespace Engine
@@ -0,0 +1,362 @@
+#include "Engine/Resources/TextureFile.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Identifier at the start of a KTX2 file
+         */
+        const unsigned char KTX2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+        /**
+         * @brief Size of the KTX2 header up to the level index
+         */
+        const size_t KTX2HeaderSize = 80;
+
+        /**
+         * @brief Size of the DDS magic and header
+         */
+        const size_t DDSHeaderSize = 128;
+
+        /**
+         * @brief Size of the DDS DX10 header extension
+         */
+        const size_t DDSHeaderDX10Size = 20;
+
+        /**
+         * @brief Builds a DDS four character code
+         */
+        constexpr uint32_t fourCC(char a, char b, char c, char d)
+        {
+            return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+        }
+
+        /**
+         * @brief Reads a little-endian value from the file
+         * @param data File data
+         * @param offset Offset of the value
+         * @return Value
+         */
+        template <typename T>
+        T read(const unsigned char *data, size_t offset)
+        {
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Maps a Vulkan format to a texture format
+         * @param vkFormat VkFormat value stored in a KTX2 file
+         * @param format Receives the texture format
+         * @return True if the format is supported
+         */
+        bool fromVulkanFormat(uint32_t vkFormat, TextureFormat &format)
+        {
+            switch (vkFormat)
+            {
+            case 23: // R8G8B8_UNORM
+            case 29: // R8G8B8_SRGB
+                format = TextureFormat::RGB;
+                return true;
+            case 37: // R8G8B8A8_UNORM
+            case 43: // R8G8B8A8_SRGB
+                format = TextureFormat::RGBA;
+                return true;
+            case 131: // BC1_RGB_UNORM_BLOCK
+            case 132:
+            case 133:
+            case 134:
+                format = TextureFormat::BC1;
+                return true;
+            case 137: // BC3_UNORM_BLOCK
+            case 138:
+                format = TextureFormat::BC3;
+                return true;
+            case 139: // BC4_UNORM_BLOCK
+                format = TextureFormat::BC4;
+                return true;
+            case 141: // BC5_UNORM_BLOCK
+                format = TextureFormat::BC5;
+                return true;
+            case 145: // BC7_UNORM_BLOCK
+            case 146:
+                format = TextureFormat::BC7;
+                return true;
+            case 147: // ETC2_R8G8B8_UNORM_BLOCK
+            case 148:
+                format = TextureFormat::ETC2RGB;
+                return true;
+            case 151: // ETC2_R8G8B8A8_UNORM_BLOCK
+            case 152:
+                format = TextureFormat::ETC2RGBA;
+                return true;
+            case 157: // ASTC_4x4_UNORM_BLOCK
+            case 158:
+                format = TextureFormat::ASTC4x4;
+                return true;
+            case 165: // ASTC_6x6_UNORM_BLOCK
+            case 166:
+                format = TextureFormat::ASTC6x6;
+                return true;
+            case 171: // ASTC_8x8_UNORM_BLOCK
+            case 172:
+                format = TextureFormat::ASTC8x8;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * @brief Maps a DXGI format to a texture format
+         * @param dxgiFormat DXGI_FORMAT value stored in a DDS DX10 header
+         * @param format Receives the texture format
+         * @return True if the format is supported
+         */
+        bool fromDXGIFormat(uint32_t dxgiFormat, TextureFormat &format)
+        {
+            switch (dxgiFormat)
+            {
+            case 28: // R8G8B8A8_UNORM
+            case 29:
+                format = TextureFormat::RGBA;
+                return true;
+            case 71: // BC1_UNORM
+            case 72:
+                format = TextureFormat::BC1;
+                return true;
+            case 77: // BC3_UNORM
+            case 78:
+                format = TextureFormat::BC3;
+                return true;
+            case 80: // BC4_UNORM
+                format = TextureFormat::BC4;
+                return true;
+            case 83: // BC5_UNORM
+                format = TextureFormat::BC5;
+                return true;
+            case 98: // BC7_UNORM
+            case 99:
+                format = TextureFormat::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool TextureFile::isContainer(const unsigned char *data, size_t size)
+    {
+        return (size >= sizeof(KTX2Identifier) && std::memcmp(data, KTX2Identifier, sizeof(KTX2Identifier)) == 0) ||
+               (size >= 4 && read<uint32_t>(data, 0) == fourCC('D', 'D', 'S', ' '));
+    }
+
+    bool TextureFile::open(AssetData data, const std::string &name)
+    {
+        close();
+        asset = std::move(data);
+
+        const char *error = nullptr;
+        if (asset.getSize() >= sizeof(KTX2Identifier) &&
+            std::memcmp(asset.getData(), KTX2Identifier, sizeof(KTX2Identifier)) == 0)
+        {
+            error = parseKTX2();
+        }
+        else if (asset.getSize() >= 4 && read<uint32_t>(asset.getData(), 0) == fourCC('D', 'D', 'S', ' '))
+        {
+            error = parseDDS();
+        }
+        else
+        {
+            error = "not a KTX2 or DDS file";
+        }
+
+        if (error)
+        {
+            Logger::error("Invalid texture file '" + name + "': " + error);
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void TextureFile::close()
+    {
+        levels.clear();
+        width = 0;
+        height = 0;
+        asset.reset();
+    }
+
+    const char *TextureFile::parseKTX2()
+    {
+        const unsigned char *data = asset.getData();
+        uint64_t fileSize = asset.getSize();
+        if (fileSize < KTX2HeaderSize)
+        {
+            return "truncated header";
+        }
+
+        uint32_t vkFormat = read<uint32_t>(data, 12);
+        uint32_t pixelWidth = read<uint32_t>(data, 20);
+        uint32_t pixelHeight = read<uint32_t>(data, 24);
+        uint32_t pixelDepth = read<uint32_t>(data, 28);
+        uint32_t layerCount = read<uint32_t>(data, 32);
+        uint32_t faceCount = read<uint32_t>(data, 36);
+        uint32_t levelCount = std::max(read<uint32_t>(data, 40), 1u);
+        uint32_t supercompression = read<uint32_t>(data, 44);
+
+        if (!fromVulkanFormat(vkFormat, format))
+        {
+            return "unsupported format";
+        }
+        if (pixelWidth == 0 || pixelHeight == 0 || pixelWidth > 65536 || pixelHeight > 65536)
+        {
+            return "invalid size";
+        }
+        if (pixelDepth > 1 || layerCount > 1 || faceCount != 1)
+        {
+            return "only single 2D images are supported";
+        }
+        if (supercompression != 0)
+        {
+            return "supercompressed files are not supported";
+        }
+
+        width = static_cast<int>(pixelWidth);
+        height = static_cast<int>(pixelHeight);
+        if (levelCount > static_cast<uint32_t>(getMipLevelCount(width, height)) ||
+            levelCount > (fileSize - KTX2HeaderSize) / 24)
+        {
+            return "truncated level index";
+        }
+
+        levels.resize(levelCount);
+        for (uint32_t level = 0; level < levelCount; ++level)
+        {
+            uint64_t offset = read<uint64_t>(data, KTX2HeaderSize + level * 24);
+            uint64_t size = read<uint64_t>(data, KTX2HeaderSize + level * 24 + 8);
+            size_t expected = getTextureLevelSize(format, std::max(1, width >> level), std::max(1, height >> level));
+            if (offset > fileSize || size > fileSize - offset || size < expected)
+            {
+                return "level out of range";
+            }
+            levels[level] = Level{offset, size};
+        }
+
+        return nullptr;
+    }
+
+    const char *TextureFile::parseDDS()
+    {
+        const unsigned char *data = asset.getData();
+        uint64_t fileSize = asset.getSize();
+        if (fileSize < DDSHeaderSize || read<uint32_t>(data, 4) != 124)
+        {
+            return "truncated header";
+        }
+
+        uint32_t flags = read<uint32_t>(data, 8);
+        uint32_t pixelHeight = read<uint32_t>(data, 12);
+        uint32_t pixelWidth = read<uint32_t>(data, 16);
+        uint32_t mipMapCount = (flags & 0x20000) ? std::max(read<uint32_t>(data, 28), 1u) : 1u;
+        uint32_t pixelFlags = read<uint32_t>(data, 80);
+        uint32_t code = read<uint32_t>(data, 84);
+        uint32_t caps2 = read<uint32_t>(data, 112);
+
+        if (pixelWidth == 0 || pixelHeight == 0 || pixelWidth > 65536 || pixelHeight > 65536)
+        {
+            return "invalid size";
+        }
+        if (caps2 & (0x200 | 0x200000))
+        {
+            return "only single 2D images are supported";
+        }
+
+        uint64_t offset = DDSHeaderSize;
+        if ((pixelFlags & 0x4) && code == fourCC('D', 'X', '1', '0'))
+        {
+            if (fileSize < DDSHeaderSize + DDSHeaderDX10Size)
+            {
+                return "truncated header";
+            }
+            uint32_t dimension = read<uint32_t>(data, DDSHeaderSize + 4);
+            uint32_t miscFlags = read<uint32_t>(data, DDSHeaderSize + 8);
+            uint32_t arraySize = read<uint32_t>(data, DDSHeaderSize + 12);
+            if (!fromDXGIFormat(read<uint32_t>(data, DDSHeaderSize), format))
+            {
+                return "unsupported format";
+            }
+            if (dimension != 3 || (miscFlags & 0x4) || arraySize > 1)
+            {
+                return "only single 2D images are supported";
+            }
+            offset += DDSHeaderDX10Size;
+        }
+        else if (pixelFlags & 0x4)
+        {
+            if (code == fourCC('D', 'X', 'T', '1'))
+            {
+                format = TextureFormat::BC1;
+            }
+            else if (code == fourCC('D', 'X', 'T', '5'))
+            {
+                format = TextureFormat::BC3;
+            }
+            else if (code == fourCC('A', 'T', 'I', '1') || code == fourCC('B', 'C', '4', 'U'))
+            {
+                format = TextureFormat::BC4;
+            }
+            else if (code == fourCC('A', 'T', 'I', '2') || code == fourCC('B', 'C', '5', 'U'))
+            {
+                format = TextureFormat::BC5;
+            }
+            else
+            {
+                return "unsupported format";
+            }
+        }
+        else if ((pixelFlags & 0x40) && read<uint32_t>(data, 88) == 32 && read<uint32_t>(data, 92) == 0x000000FF &&
+                 read<uint32_t>(data, 96) == 0x0000FF00 && read<uint32_t>(data, 100) == 0x00FF0000 &&
+                 (!(pixelFlags & 0x1) || read<uint32_t>(data, 104) == 0xFF000000))
+        {
+            format = TextureFormat::RGBA;
+        }
+        else
+        {
+            return "unsupported format";
+        }
+
+        width = static_cast<int>(pixelWidth);
+        height = static_cast<int>(pixelHeight);
+        if (mipMapCount > static_cast<uint32_t>(getMipLevelCount(width, height)))
+        {
+            return "too many mip levels";
+        }
+
+        // DDS levels follow each other without an index
+        levels.resize(mipMapCount);
+        for (uint32_t level = 0; level < mipMapCount; ++level)
+        {
+            uint64_t size = getTextureLevelSize(format, std::max(1, width >> level), std::max(1, height >> level));
+            if (size > fileSize - offset)
+            {
+                return "truncated level data";
+            }
+            levels[level] = Level{offset, size};
+            offset += size;
+        }
+
+        return nullptr;
+    }
+
+} // namespace Engine
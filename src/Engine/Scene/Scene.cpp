@@ -2,53 +2,224 @@
 #include "Engine/Core/Logger.hpp"
 #include "Engine/Core/Engine.hpp"
 #include "Engine/ECS/EntityManager.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Engine/Renderer/MeshRenderer.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Math/Frustum.hpp"
+
 
 namespace Engine
 {
 
     Scene::Scene(const std::string &name, Engine &engine)
-        : name(name), engine(engine)
+        : name(name), engine(engine), spatialFrame(0)
     {
         // Create entity manager
         entityManager = std::make_unique<EntityManager>(engine);
         if (!entityManager->initialize())
         {
-            Logger::error("Failed to initialize entity manager for scene: " + name);
+            Logger::error("Failed to initialize entity manager for scene: {}", name);
         }
+        entityManager->setDestroyCallback([this](Entity *entity)
+                                          { onEntityDestroyed(entity); });
 
-        Logger::info("Scene created: " + name);
+        Logger::info("Scene created: {}", name);
     }
 
     Scene::~Scene()
     {
-        // Clear systems
-        systems.clear();
-
-        // Shutdown entity manager
+        // Shutdown entity manager (this also shuts down all systems)
         if (entityManager)
         {
             entityManager->shutdown();
         }
 
-        Logger::info("Scene destroyed: " + name);
+        Logger::info("Scene destroyed: {}", name);
     }
 
     void Scene::update(float deltaTime)
     {
-        // Update entity manager
+        // Update entity manager (this runs all systems)
         entityManager->update(deltaTime);
+        updateSpatialIndex();
+    }
+
+    void Scene::fixedUpdate(float fixedDeltaTime)
+    {
+        entityManager->fixedUpdate(fixedDeltaTime);
+        updateSpatialIndex();
+    }
 
-        // Update systems
-        for (auto &pair : systems)
+    void Scene::render(float alpha)
+    {
+        immediateSnapshot.clear();
+        buildRenderSnapshot(immediateSnapshot, alpha);
+        engine.getRenderer().renderSnapshot(immediateSnapshot);
+    }
+
+    void Scene::buildRenderSnapshot(RenderSnapshot &snapshot, float alpha)
+    {
+        // Capture the camera matrices so later camera changes don't affect this frame
+        CameraComponent *camera = engine.getRenderer().getCamera();
+        if (camera)
         {
-            pair.second->update(deltaTime);
+            snapshot.hasCamera = true;
+            snapshot.view = camera->getViewMatrix();
+            snapshot.projection = camera->getProjectionMatrix();
         }
+
+        // Capture the first active light
+        entityManager->view<LightComponent>().each([&snapshot, alpha](Entity &entity, LightComponent &light)
+                                                   {
+            if (snapshot.hasLight || !entity.isActive())
+            {
+                return;
+            }
+
+            Matrix4 world = entity.getTransform().getInterpolatedWorldMatrix(alpha);
+            snapshot.hasLight = true;
+            snapshot.lightPosition = Vector3(world.get(0, 3), world.get(1, 3), world.get(2, 3));
+            snapshot.lightColor = light.getColor() * light.getIntensity(); });
+
+        if (!snapshot.hasCamera)
+        {
+            return;
+        }
+
+        // Let the spatial index reject whole regions outside the frustum
+        Frustum frustum = Frustum::fromMatrix(snapshot.projection * snapshot.view);
+        spatialIndex.queryFrustum(frustum, cullCandidates);
+
+        // A renderer that culls on the GPU tests the exact spheres itself
+        const Renderer &renderer = engine.getRenderer();
+        bool exactCulling = !renderer.isGpuCullingEnabled();
+        float lodBias = renderer.getConfig().lodBias;
+        float lodHysteresis = renderer.getConfig().lodHysteresis;
+
+        // Capture every candidate with its world transform between the last
+        // two simulation steps
+        snapshot.items.reserve(cullCandidates.size());
+        cullSpheres.clear();
+        for (uint32_t id : cullCandidates)
+        {
+            Entity *entity = entityManager->getEntity(id);
+            if (!entity || !entity->isActive() || !entity->hasComponent<MeshRendererComponent>())
+            {
+                continue;
+            }
+
+            MeshRendererComponent &meshRenderer = entity->getComponent<MeshRendererComponent>();
+            if (!meshRenderer.isVisible() || !meshRenderer.getMesh() || !meshRenderer.getMaterial())
+            {
+                continue;
+            }
+
+            Mesh *mesh = meshRenderer.getMesh();
+            Matrix4 world = entity->getTransform().getInterpolatedWorldMatrix(alpha);
+            BoundingSphere sphere = mesh->getBoundingSphere().transformed(world);
+
+            // The component remembers its level, so the hysteresis can hold it near a switch size
+            float screenSize = Mesh::getScreenSize(sphere, snapshot.view, snapshot.projection) * lodBias;
+            uint32_t lod = mesh->selectLod(screenSize, meshRenderer.getLod(), lodHysteresis);
+            meshRenderer.setLod(lod);
+
+            snapshot.items.push_back({mesh, meshRenderer.getMaterial(), world, meshRenderer.getColor(), lod});
+            if (exactCulling)
+            {
+                cullSpheres.add(sphere);
+            }
+        }
+
+        if (!exactCulling)
+        {
+            snapshot.culledCount = static_cast<uint32_t>(spatialIndex.size() - snapshot.items.size());
+            return;
+        }
+
+        // The index stores enlarged boxes, so test the exact spheres as well
+        frustum.cullSpheres(cullSpheres, cullResults);
+
+        size_t visibleCount = 0;
+        for (size_t i = 0; i < snapshot.items.size(); ++i)
+        {
+            if (cullResults[i])
+            {
+                if (visibleCount != i)
+                {
+                    snapshot.items[visibleCount] = snapshot.items[i];
+                }
+                ++visibleCount;
+            }
+        }
+
+        snapshot.culledCount = static_cast<uint32_t>(spatialIndex.size() - visibleCount);
+        snapshot.items.resize(visibleCount);
     }
 
-    void Scene::render()
+    void Scene::updateSpatialIndex()
     {
-        // Nothing to do here; rendering is handled by the renderer
-        // Systems can register with the renderer to render their entities
+        ++spatialFrame;
+        size_t seen = 0;
+
+        entityManager->view<MeshRendererComponent>().each([this, &seen](Entity &entity, MeshRendererComponent &meshRenderer)
+                                                          {
+            const Mesh *mesh = meshRenderer.getMesh();
+            if (!entity.isActive() || !mesh || mesh->getBounds().isEmpty())
+            {
+                return;
+            }
+
+            SpatialEntry &entry = spatialEntries[entity.getId()];
+            entry.lastSeen = spatialFrame;
+            ++seen;
+
+            const Transform &transform = entity.getTransform();
+            const BoundingBox &meshBounds = mesh->getBounds();
+            uint64_t version = transform.getWorldVersion();
+            bool sameBounds = entry.mesh == mesh &&
+                              entry.meshBounds.min.x == meshBounds.min.x && entry.meshBounds.min.y == meshBounds.min.y &&
+                              entry.meshBounds.min.z == meshBounds.min.z && entry.meshBounds.max.x == meshBounds.max.x &&
+                              entry.meshBounds.max.y == meshBounds.max.y && entry.meshBounds.max.z == meshBounds.max.z;
+            if (entry.proxy != SpatialIndex::NullProxy && entry.transformVersion == version && sameBounds)
+            {
+                return;
+            }
+
+            BoundingBox box = meshBounds.transformed(transform.getWorldMatrix());
+            Vector3 center = box.getCenter();
+            if (entry.proxy == SpatialIndex::NullProxy)
+            {
+                entry.proxy = spatialIndex.insert(box, entity.getId());
+            }
+            else
+            {
+                spatialIndex.move(entry.proxy, box, Vector3(center.x - entry.center.x, center.y - entry.center.y, center.z - entry.center.z));
+            }
+
+            entry.transformVersion = version;
+            entry.mesh = mesh;
+            entry.meshBounds = meshBounds;
+            entry.center = center; });
+
+        // Drop entities that were destroyed, deactivated, or lost their mesh
+        if (seen == spatialEntries.size())
+        {
+            return;
+        }
+
+        for (auto it = spatialEntries.begin(); it != spatialEntries.end();)
+        {
+            if (it->second.lastSeen != spatialFrame)
+            {
+                spatialIndex.remove(it->second.proxy);
+                it = spatialEntries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
 
     Entity *Scene::createEntity()
@@ -65,20 +236,49 @@ namespace Engine
             return nullptr;
         }
 
+        setEntityName(entity, name);
+        return entity;
+    }
+
+    size_t Scene::createEntities(size_t count, std::vector<Entity *> &created)
+    {
+        return entityManager->createEntities(count, created);
+    }
+
+    void Scene::setEntityName(Entity *entity, const std::string &name)
+    {
+        if (!entity)
+        {
+            return;
+        }
+
+        // Forget the old name if it still refers to this entity
+        auto it = entityNames.find(entity->getName());
+        if (it != entityNames.end() && it->second == entity)
+        {
+            entityNames.erase(it);
+        }
+
         // Set name
         entity->setName(name);
 
         // Add to name map
         entityNames[name] = entity;
-
-        return entity;
     }
 
     void Scene::destroyEntity(Entity *entity)
     {
-        if (!entity)
+        entityManager->destroyEntity(entity);
+    }
+
+    void Scene::onEntityDestroyed(Entity *entity)
+    {
+        // Remove from the spatial index
+        auto entry = spatialEntries.find(entity->getId());
+        if (entry != spatialEntries.end())
         {
-            return;
+            spatialIndex.remove(entry->second.proxy);
+            spatialEntries.erase(entry);
         }
 
         // Remove from name map
@@ -87,9 +287,6 @@ namespace Engine
         {
             entityNames.erase(it);
         }
-
-        // Destroy entity
-        entityManager->destroyEntity(entity);
     }
 
     Entity *Scene::getEntity(uint32_t id)
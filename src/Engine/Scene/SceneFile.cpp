@@ -0,0 +1,184 @@
+#include "Engine/Scene/SceneFile.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <utility>
+
+namespace Engine
+{
+
+    static_assert(sizeof(SceneFileHeader) == 56, "Scene file header layout changed");
+    static_assert(sizeof(SceneEntityRecord) == 16, "Scene entity record layout changed");
+    static_assert(sizeof(SceneTransformRecord) == 36, "Scene transform record layout changed");
+    static_assert(sizeof(SceneComponentBlock) == 32, "Scene component block layout changed");
+
+    namespace
+    {
+        /**
+         * @brief Checks that a section lies inside the file and is aligned
+         * @param offset Section offset
+         * @param count Number of elements
+         * @param elementSize Size of one element
+         * @param fileSize Size of the file
+         * @return True if the section is valid
+         */
+        bool isValidSection(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+        {
+            if (offset % SceneFileAlignment != 0 || offset > fileSize)
+            {
+                return false;
+            }
+            return elementSize == 0 || count <= (fileSize - offset) / elementSize;
+        }
+
+        /**
+         * @brief Checks that a string lies inside the string table
+         * @param string String range
+         * @param stringSize Size of the string table
+         * @return True if the range is valid
+         */
+        bool isValidString(SceneString string, uint64_t stringSize)
+        {
+            return uint64_t(string.offset) + string.length <= stringSize;
+        }
+    }
+
+    bool SceneFile::open(const std::string &filepath)
+    {
+        AssetData data;
+        if (!data.mapFile(filepath))
+        {
+            close();
+            return false;
+        }
+        return open(std::move(data), filepath);
+    }
+
+    bool SceneFile::open(AssetData data, const std::string &name)
+    {
+        close();
+        asset = std::move(data);
+
+        const unsigned char *bytes = asset.getData();
+        const SceneFileHeader *candidate = reinterpret_cast<const SceneFileHeader *>(bytes);
+        uint64_t fileSize = asset.getSize();
+        const char *error = nullptr;
+        if (fileSize < sizeof(SceneFileHeader) || candidate->magic != SceneFileMagic)
+        {
+            error = "not a scene file";
+        }
+        else if (candidate->version != SceneFileVersion)
+        {
+            error = "saved by a different version, save it again";
+        }
+        else if (!isValidSection(candidate->entityOffset, candidate->entityCount, sizeof(SceneEntityRecord), fileSize) ||
+                 !isValidSection(candidate->transformOffset, candidate->entityCount, sizeof(SceneTransformRecord), fileSize) ||
+                 !isValidSection(candidate->blockOffset, candidate->blockCount, sizeof(SceneComponentBlock), fileSize) ||
+                 !isValidSection(candidate->stringOffset, candidate->stringSize, 1, fileSize))
+        {
+            error = "truncated or corrupt";
+        }
+        else
+        {
+            // Parents come first, which also rules out cycles
+            const SceneEntityRecord *entities = reinterpret_cast<const SceneEntityRecord *>(bytes + candidate->entityOffset);
+            for (uint32_t i = 0; i < candidate->entityCount && !error; ++i)
+            {
+                if ((entities[i].parent != SceneNoParent && entities[i].parent >= i) ||
+                    !isValidString(entities[i].name, candidate->stringSize))
+                {
+                    error = "entity out of range";
+                }
+            }
+
+            const SceneComponentBlock *blocks = reinterpret_cast<const SceneComponentBlock *>(bytes + candidate->blockOffset);
+            for (uint32_t i = 0; i < candidate->blockCount && !error; ++i)
+            {
+                const SceneComponentBlock &block = blocks[i];
+                if (block.recordSize == 0 ||
+                    !isValidSection(block.entityOffset, block.count, sizeof(uint32_t), fileSize) ||
+                    !isValidSection(block.dataOffset, block.count, block.recordSize, fileSize))
+                {
+                    error = "truncated or corrupt";
+                    break;
+                }
+
+                const uint32_t *owners = reinterpret_cast<const uint32_t *>(bytes + block.entityOffset);
+                for (uint32_t j = 0; j < block.count; ++j)
+                {
+                    if (owners[j] >= candidate->entityCount || (j > 0 && owners[j] <= owners[j - 1]))
+                    {
+                        error = "component out of range";
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (error)
+        {
+            Logger::error("Invalid scene file '" + name + "': " + error);
+            asset.reset();
+            return false;
+        }
+
+        header = candidate;
+        return true;
+    }
+
+    void SceneFile::close()
+    {
+        header = nullptr;
+        asset.reset();
+    }
+
+    Span<const SceneEntityRecord> SceneFile::getEntities() const
+    {
+        if (!header)
+        {
+            return Span<const SceneEntityRecord>();
+        }
+        return Span<const SceneEntityRecord>(
+            reinterpret_cast<const SceneEntityRecord *>(asset.getData() + header->entityOffset), header->entityCount);
+    }
+
+    Span<const SceneTransformRecord> SceneFile::getTransforms() const
+    {
+        if (!header)
+        {
+            return Span<const SceneTransformRecord>();
+        }
+        return Span<const SceneTransformRecord>(
+            reinterpret_cast<const SceneTransformRecord *>(asset.getData() + header->transformOffset), header->entityCount);
+    }
+
+    Span<const SceneComponentBlock> SceneFile::getBlocks() const
+    {
+        if (!header)
+        {
+            return Span<const SceneComponentBlock>();
+        }
+        return Span<const SceneComponentBlock>(
+            reinterpret_cast<const SceneComponentBlock *>(asset.getData() + header->blockOffset), header->blockCount);
+    }
+
+    Span<const uint32_t> SceneFile::getBlockEntities(const SceneComponentBlock &block) const
+    {
+        return Span<const uint32_t>(reinterpret_cast<const uint32_t *>(asset.getData() + block.entityOffset), block.count);
+    }
+
+    const unsigned char *SceneFile::getBlockData(const SceneComponentBlock &block) const
+    {
+        return asset.getData() + block.dataOffset;
+    }
+
+    std::string SceneFile::getString(SceneString string) const
+    {
+        if (!header || !isValidString(string, header->stringSize))
+        {
+            return std::string();
+        }
+        return std::string(reinterpret_cast<const char *>(asset.getData() + header->stringOffset) + string.offset,
+                           string.length);
+    }
+
+} // namespace Engine
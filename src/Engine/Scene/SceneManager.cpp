@@ -1,12 +1,13 @@
 #include "Engine/Scene/SceneManager.hpp"
 #include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneSerializer.hpp"
 #include "Engine/Core/Logger.hpp"
 
 namespace Engine
 {
 
     SceneManager::SceneManager(Engine &engine)
-        : engine(engine), activeScene(nullptr)
+        : engine(engine), serializer(std::make_unique<SceneSerializer>(engine)), activeScene(nullptr)
     {
     }
 
@@ -33,12 +34,30 @@ namespace Engine
         }
     }
 
-    void SceneManager::render()
+    void SceneManager::fixedUpdate(float fixedDeltaTime)
+    {
+        // Step active scene
+        if (activeScene)
+        {
+            activeScene->fixedUpdate(fixedDeltaTime);
+        }
+    }
+
+    void SceneManager::render(float alpha)
     {
         // Render active scene
         if (activeScene)
         {
-            activeScene->render();
+            activeScene->render(alpha);
+        }
+    }
+
+    void SceneManager::buildRenderSnapshot(RenderSnapshot &snapshot, float alpha)
+    {
+        // Capture active scene
+        if (activeScene)
+        {
+            activeScene->buildRenderSnapshot(snapshot, alpha);
         }
     }
 
@@ -58,7 +77,7 @@ namespace Engine
         // Check if scene already exists
         if (scenes.find(name) != scenes.end())
         {
-            Logger::warning("Scene already exists: " + name);
+            Logger::warning("Scene already exists: {}", name);
             return scenes[name].get();
         }
 
@@ -68,11 +87,34 @@ namespace Engine
 
         // Add to map
         scenes[name] = std::move(scene);
-        Logger::info("Scene created: " + name);
+        Logger::info("Scene created: {}", name);
 
         return scenePtr;
     }
 
+    Scene *SceneManager::loadScene(const std::string &name, const std::string &filepath)
+    {
+        if (scenes.find(name) != scenes.end())
+        {
+            Logger::error("Cannot load scene: Scene already exists: {}", name);
+            return nullptr;
+        }
+
+        Scene *scene = createScene(name);
+        if (!serializer->load(*scene, filepath))
+        {
+            destroyScene(name);
+            return nullptr;
+        }
+
+        return scene;
+    }
+
+    bool SceneManager::saveScene(Scene &scene, const std::string &filepath)
+    {
+        return serializer->save(scene, filepath);
+    }
+
     Scene *SceneManager::getScene(const std::string &name)
     {
         auto it = scenes.find(name);
@@ -99,7 +141,7 @@ namespace Engine
 
         // Remove from map
         scenes.erase(it);
-        Logger::info("Scene destroyed: " + name);
+        Logger::info("Scene destroyed: {}", name);
 
         return true;
     }
@@ -119,7 +161,7 @@ namespace Engine
             if (pair.second.get() == scene)
             {
                 activeScene = scene;
-                Logger::info("Active scene set to: " + scene->getName());
+                Logger::info("Active scene set to: {}", scene->getName());
                 return;
             }
         }
@@ -0,0 +1,577 @@
+#include "Engine/Scene/SceneSerializer.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Core/Engine.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/MeshRenderer.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Record of a MeshRendererComponent
+         */
+        struct MeshRendererRecord
+        {
+            SceneString mesh;
+            SceneString material;
+            float color[4];
+            uint32_t visible;
+            uint32_t reserved[3];
+        };
+
+        /**
+         * @brief Record of a LightComponent
+         */
+        struct LightRecord
+        {
+            float color[3];
+            float intensity;
+        };
+
+        /**
+         * @brief Record of a CameraComponent
+         */
+        struct CameraRecord
+        {
+            uint32_t projectionType;
+            float fov;
+            float aspectRatio;
+            float nearPlane;
+            float farPlane;
+            float orthographicSize;
+            uint32_t reserved[2];
+        };
+
+        static_assert(sizeof(MeshRendererRecord) == 48, "Mesh renderer record layout changed");
+        static_assert(sizeof(LightRecord) == 16, "Light record layout changed");
+        static_assert(sizeof(CameraRecord) == 32, "Camera record layout changed");
+
+        /**
+         * @brief 64-bit FNV-1a hash
+         * @param string String to hash
+         * @return Hash of the string
+         */
+        uint64_t hashString(const std::string &string)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : string)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Rounds an offset up to the section alignment
+         * @param offset Offset to align
+         * @return Aligned offset
+         */
+        uint64_t alignOffset(uint64_t offset)
+        {
+            return (offset + SceneFileAlignment - 1) / SceneFileAlignment * SceneFileAlignment;
+        }
+
+        /**
+         * @brief Pads a file with zeros up to an offset
+         * @param file File to pad
+         * @param offset Offset to reach
+         */
+        void padTo(std::ofstream &file, uint64_t offset)
+        {
+            static const char zeros[SceneFileAlignment] = {};
+            uint64_t position = static_cast<uint64_t>(file.tellp());
+            if (offset > position)
+            {
+                file.write(zeros, static_cast<std::streamsize>(offset - position));
+            }
+        }
+
+        /**
+         * @brief Writes a range of bytes to a file
+         * @param file File to write
+         * @param data First byte
+         * @param size Number of bytes
+         */
+        void writeBytes(std::ofstream &file, const void *data, uint64_t size)
+        {
+            file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        }
+    }
+
+    SceneString SceneWriter::addString(const std::string &string)
+    {
+        auto it = ranges.find(string);
+        if (it != ranges.end())
+        {
+            return it->second;
+        }
+
+        SceneString range = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(string.size())};
+        strings += string;
+        ranges.emplace(string, range);
+        return range;
+    }
+
+    SceneSerializer::SceneSerializer(Engine &engine)
+        : engine(engine)
+    {
+        registerBuiltinComponents();
+    }
+
+    bool SceneSerializer::addType(ComponentType type)
+    {
+        type.id = hashString(type.name);
+        for (const ComponentType &existing : types)
+        {
+            if (existing.type == type.type || existing.id == type.id)
+            {
+                Logger::error("Cannot register scene component '{}': The type or name is already registered", type.name);
+                return false;
+            }
+        }
+
+        typeIds[type.id] = types.size();
+        types.push_back(std::move(type));
+        return true;
+    }
+
+    void SceneSerializer::registerBuiltinComponents()
+    {
+        registerComponent<MeshRendererComponent, MeshRendererRecord>(
+            "MeshRenderer",
+            [](const MeshRendererComponent &component, MeshRendererRecord &record, SceneWriter &writer)
+            {
+                if (component.getMesh())
+                {
+                    record.mesh = writer.addString(component.getMesh()->getName());
+                }
+                if (component.getMaterial())
+                {
+                    record.material = writer.addString(component.getMaterial()->getName());
+                }
+
+                const Vector4 &color = component.getColor();
+                record.color[0] = color.x, record.color[1] = color.y, record.color[2] = color.z, record.color[3] = color.w;
+                record.visible = component.isVisible() ? 1 : 0;
+            },
+            [this](MeshRendererComponent &component, const MeshRendererRecord &record, const SceneFile &file)
+            {
+                ResourceManager &resources = engine.getResourceManager();
+                if (record.mesh.length > 0)
+                {
+                    std::string name = file.getString(record.mesh);
+                    component.setMesh(resources.getMeshRef(name));
+                    if (!component.getMesh())
+                    {
+                        Logger::warning("Scene refers to mesh '{}', which is not loaded", name);
+                    }
+                }
+                if (record.material.length > 0)
+                {
+                    std::string name = file.getString(record.material);
+                    component.setMaterial(resources.getMaterialRef(name));
+                    if (!component.getMaterial())
+                    {
+                        Logger::warning("Scene refers to material '{}', which is not loaded", name);
+                    }
+                }
+
+                component.setColor(Vector4(record.color[0], record.color[1], record.color[2], record.color[3]));
+                component.setVisible(record.visible != 0);
+            });
+
+        registerComponent<LightComponent, LightRecord>(
+            "Light",
+            [](const LightComponent &component, LightRecord &record, SceneWriter &writer)
+            {
+                (void)writer;
+                const Vector3 &color = component.getColor();
+                record.color[0] = color.x, record.color[1] = color.y, record.color[2] = color.z;
+                record.intensity = component.getIntensity();
+            },
+            [](LightComponent &component, const LightRecord &record, const SceneFile &file)
+            {
+                (void)file;
+                component.setColor(Vector3(record.color[0], record.color[1], record.color[2]));
+                component.setIntensity(record.intensity);
+            });
+
+        registerComponent<CameraComponent, CameraRecord>(
+            "Camera",
+            [](const CameraComponent &component, CameraRecord &record, SceneWriter &writer)
+            {
+                (void)writer;
+                record.projectionType = component.getProjectionType() == CameraComponent::ProjectionType::Orthographic ? 1 : 0;
+                record.fov = component.getFov();
+                record.aspectRatio = component.getAspectRatio();
+                record.nearPlane = component.getNearPlane();
+                record.farPlane = component.getFarPlane();
+                record.orthographicSize = component.getOrthographicSize();
+            },
+            [](CameraComponent &component, const CameraRecord &record, const SceneFile &file)
+            {
+                (void)file;
+                component.setFov(record.fov);
+                component.setAspectRatio(record.aspectRatio);
+                component.setNearPlane(record.nearPlane);
+                component.setFarPlane(record.farPlane);
+                component.setOrthographicSize(record.orthographicSize);
+                component.setProjectionType(record.projectionType == 1 ? CameraComponent::ProjectionType::Orthographic
+                                                                        : CameraComponent::ProjectionType::Perspective);
+            });
+    }
+
+    bool SceneSerializer::save(Scene &scene, const std::string &filepath) const
+    {
+        ENGINE_PROFILE_SCOPE("Save scene");
+
+        EntityManager &manager = scene.getEntityManager();
+        const std::vector<Entity *> &slots = manager.getEntities();
+
+        // Resolve every parent transform to the slot of its entity
+        std::unordered_map<const Transform *, uint32_t> transformSlots;
+        transformSlots.reserve(manager.getEntityCount());
+        for (uint32_t slot = 0; slot < slots.size(); ++slot)
+        {
+            if (slots[slot])
+            {
+                transformSlots[&slots[slot]->getTransform()] = slot;
+            }
+        }
+
+        std::vector<uint32_t> parentSlots(slots.size(), SceneNoParent);
+        for (uint32_t slot = 0; slot < slots.size(); ++slot)
+        {
+            if (!slots[slot] || !slots[slot]->getTransform().getParent())
+            {
+                continue;
+            }
+
+            auto it = transformSlots.find(slots[slot]->getTransform().getParent());
+            if (it != transformSlots.end())
+            {
+                parentSlots[slot] = it->second;
+            }
+        }
+
+        // Store parents before their children, so loading can attach each
+        // entity to one that already exists; a chain longer than the number
+        // of entities is a cycle, which is cut where it was found
+        auto depthOf = [&parentSlots, &slots](uint32_t slot)
+        {
+            size_t depth = 0;
+            for (uint32_t parent = parentSlots[slot]; parent != SceneNoParent; parent = parentSlots[parent])
+            {
+                if (++depth > slots.size())
+                {
+                    return SIZE_MAX;
+                }
+            }
+            return depth;
+        };
+
+        std::vector<std::pair<size_t, uint32_t>> order;
+        order.reserve(manager.getEntityCount());
+        for (uint32_t slot = 0; slot < slots.size(); ++slot)
+        {
+            if (slots[slot] && depthOf(slot) == SIZE_MAX)
+            {
+                Logger::warning("Entity '{}' is its own ancestor, saving it as a root", slots[slot]->getName());
+                parentSlots[slot] = SceneNoParent;
+            }
+        }
+        for (uint32_t slot = 0; slot < slots.size(); ++slot)
+        {
+            if (slots[slot])
+            {
+                order.emplace_back(depthOf(slot), slot);
+            }
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<uint32_t> fileIndices(slots.size(), SceneNoParent);
+        for (uint32_t i = 0; i < order.size(); ++i)
+        {
+            fileIndices[order[i].second] = i;
+        }
+
+        SceneWriter writer;
+        std::vector<SceneEntityRecord> entityRecords(order.size());
+        std::vector<SceneTransformRecord> transformRecords(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            uint32_t slot = order[i].second;
+            const Entity &entity = *slots[slot];
+
+            SceneEntityRecord &record = entityRecords[i];
+            record.name = entity.getName().empty() ? SceneString{0, 0} : writer.addString(entity.getName());
+            record.parent = parentSlots[slot] == SceneNoParent ? SceneNoParent : fileIndices[parentSlots[slot]];
+            record.flags = entity.isActive() ? SceneEntityActive : 0;
+
+            const Transform &transform = entity.getTransform();
+            SceneTransformRecord &transformRecord = transformRecords[i];
+            const Vector3 &position = transform.getPosition();
+            const Vector3 &rotation = transform.getRotation();
+            const Vector3 &scale = transform.getScale();
+            transformRecord.position[0] = position.x, transformRecord.position[1] = position.y, transformRecord.position[2] = position.z;
+            transformRecord.rotation[0] = rotation.x, transformRecord.rotation[1] = rotation.y, transformRecord.rotation[2] = rotation.z;
+            transformRecord.scale[0] = scale.x, transformRecord.scale[1] = scale.y, transformRecord.scale[2] = scale.z;
+        }
+
+        // One block per registered type, in entity order
+        std::vector<SceneComponentBlock> blocks;
+        std::vector<std::vector<uint32_t>> blockOwners;
+        std::vector<std::vector<unsigned char>> blockData;
+        std::vector<std::pair<uint32_t, uint32_t>> members;
+        std::vector<uint32_t> memberSlots;
+        for (const ComponentType &type : types)
+        {
+            ComponentPoolBase *pool = manager.findPool(type.type);
+            if (!pool || pool->size() == 0)
+            {
+                continue;
+            }
+
+            members.clear();
+            for (uint32_t slot : pool->getEntities())
+            {
+                members.emplace_back(fileIndices[slot], slot);
+            }
+            std::sort(members.begin(), members.end());
+
+            std::vector<uint32_t> owners(members.size());
+            memberSlots.resize(members.size());
+            for (size_t i = 0; i < members.size(); ++i)
+            {
+                owners[i] = members[i].first;
+                memberSlots[i] = members[i].second;
+            }
+
+            std::vector<unsigned char> data(members.size() * type.recordSize);
+            type.save(manager, memberSlots.data(), memberSlots.size(), data.data(), writer);
+
+            SceneComponentBlock block;
+            std::memset(&block, 0, sizeof(block));
+            block.typeId = type.id;
+            block.recordSize = type.recordSize;
+            block.count = static_cast<uint32_t>(members.size());
+            blocks.push_back(block);
+            blockOwners.push_back(std::move(owners));
+            blockData.push_back(std::move(data));
+        }
+
+        const std::string &strings = writer.getStrings();
+        if (strings.size() > UINT32_MAX)
+        {
+            Logger::error("Cannot save scene '" + scene.getName() + "': The string table is too large");
+            return false;
+        }
+
+        SceneFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = SceneFileMagic;
+        header.version = SceneFileVersion;
+        header.entityCount = static_cast<uint32_t>(entityRecords.size());
+        header.blockCount = static_cast<uint32_t>(blocks.size());
+        header.stringSize = strings.size();
+        header.entityOffset = alignOffset(sizeof(SceneFileHeader));
+        header.transformOffset = alignOffset(header.entityOffset + entityRecords.size() * sizeof(SceneEntityRecord));
+        header.blockOffset = alignOffset(header.transformOffset + transformRecords.size() * sizeof(SceneTransformRecord));
+
+        uint64_t offset = header.blockOffset + blocks.size() * sizeof(SceneComponentBlock);
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            blocks[i].entityOffset = alignOffset(offset);
+            blocks[i].dataOffset = alignOffset(blocks[i].entityOffset + blockOwners[i].size() * sizeof(uint32_t));
+            offset = blocks[i].dataOffset + blockData[i].size();
+        }
+        header.stringOffset = alignOffset(offset);
+
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        writeBytes(file, &header, sizeof(header));
+        padTo(file, header.entityOffset);
+        writeBytes(file, entityRecords.data(), entityRecords.size() * sizeof(SceneEntityRecord));
+        padTo(file, header.transformOffset);
+        writeBytes(file, transformRecords.data(), transformRecords.size() * sizeof(SceneTransformRecord));
+        padTo(file, header.blockOffset);
+        writeBytes(file, blocks.data(), blocks.size() * sizeof(SceneComponentBlock));
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            padTo(file, blocks[i].entityOffset);
+            writeBytes(file, blockOwners[i].data(), blockOwners[i].size() * sizeof(uint32_t));
+            padTo(file, blocks[i].dataOffset);
+            writeBytes(file, blockData[i].data(), blockData[i].size());
+        }
+        padTo(file, header.stringOffset);
+        writeBytes(file, strings.data(), strings.size());
+
+        if (!file)
+        {
+            Logger::error("Failed to write scene file: " + filepath);
+            return false;
+        }
+
+        Logger::info("Saved {} entities of scene '{}' to {}", entityRecords.size(), scene.getName(), filepath);
+        return true;
+    }
+
+    bool SceneSerializer::load(Scene &scene, const std::string &filepath) const
+    {
+        SceneFile file;
+        if (!file.open(filepath))
+        {
+            Logger::error("Failed to open scene file: " + filepath);
+            return false;
+        }
+
+        // Fault the whole file in with sequential reads rather than page by page
+        file.prefetch();
+        return load(scene, file);
+    }
+
+    bool SceneSerializer::load(Scene &scene, const SceneFile &file) const
+    {
+        SceneLoadProgress progress;
+        if (!load(scene, file, progress, SIZE_MAX))
+        {
+            for (Entity *entity : progress.entities)
+            {
+                scene.destroyEntity(entity);
+            }
+            return false;
+        }
+
+        Logger::info("Loaded {} entities into scene '{}'", progress.entities.size(), scene.getName());
+        return true;
+    }
+
+    bool SceneSerializer::load(Scene &scene, const SceneFile &file, SceneLoadProgress &progress, size_t maxItems) const
+    {
+        ENGINE_PROFILE_SCOPE("Load scene");
+
+        if (!file.isOpen())
+        {
+            Logger::error("Cannot load scene '" + scene.getName() + "': The scene file is not open");
+            return false;
+        }
+
+        Span<const SceneEntityRecord> records = file.getEntities();
+        Span<const SceneTransformRecord> transforms = file.getTransforms();
+        EntityManager &manager = scene.getEntityManager();
+        size_t budget = std::max<size_t>(maxItems, 1);
+
+        // Grow the arrays for the whole file on the first call, not once per batch
+        size_t first = progress.entities.size();
+        if (first == 0 && progress.block == 0 && !progress.finished)
+        {
+            manager.reserve(manager.getEntityCount() + records.size());
+            progress.entities.reserve(records.size());
+        }
+
+        if (first < records.size())
+        {
+            size_t count = std::min(budget, records.size() - first);
+            if (scene.createEntities(count, progress.entities) != count)
+            {
+                Logger::error("Cannot load scene '" + scene.getName() + "': Entity limit reached");
+                return false;
+            }
+            budget -= count;
+
+            for (size_t i = first; i < first + count; ++i)
+            {
+                Entity *entity = progress.entities[i];
+                const SceneEntityRecord &record = records[i];
+                if (record.name.length > 0)
+                {
+                    scene.setEntityName(entity, file.getString(record.name));
+                }
+                entity->setActive((record.flags & SceneEntityActive) != 0);
+
+                // Parents were created before their children
+                const SceneTransformRecord &local = transforms[i];
+                Transform &transform = entity->getTransform();
+                transform.setPosition(local.position[0], local.position[1], local.position[2]);
+                transform.setRotation(local.rotation[0], local.rotation[1], local.rotation[2]);
+                transform.setScale(local.scale[0], local.scale[1], local.scale[2]);
+                if (record.parent != SceneNoParent)
+                {
+                    transform.setParent(&progress.entities[record.parent]->getTransform());
+                }
+                transform.storePreviousState();
+            }
+        }
+
+        Span<const SceneComponentBlock> blocks = file.getBlocks();
+        std::vector<uint32_t> entityIndices;
+        while (budget > 0 && progress.block < blocks.size())
+        {
+            const SceneComponentBlock &block = blocks[progress.block];
+            auto it = typeIds.find(block.typeId);
+            const ComponentType *type = it != typeIds.end() ? &types[it->second] : nullptr;
+            if (!type || block.recordSize != type->recordSize)
+            {
+                if (!type)
+                {
+                    Logger::warning("Scene '{}' has {} components of an unregistered type, skipping them",
+                                    scene.getName(), block.count);
+                }
+                else
+                {
+                    Logger::warning("Scene '{}' has {} components '{}' with a different record size, skipping them",
+                                    scene.getName(), block.count, type->name);
+                }
+                ++progress.block;
+                progress.record = 0;
+                continue;
+            }
+
+            if (progress.record == 0)
+            {
+                type->reserve(manager, block.count);
+            }
+
+            size_t count = std::min<size_t>(budget, block.count - progress.record);
+            Span<const uint32_t> owners = file.getBlockEntities(block).subspan(progress.record, count);
+            entityIndices.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                entityIndices[i] = progress.entities[owners[i]]->getIndex();
+            }
+
+            type->load(manager, entityIndices.data(), count,
+                       file.getBlockData(block) + progress.record * block.recordSize, file);
+            progress.record += count;
+            budget -= count;
+
+            if (progress.record == block.count)
+            {
+                ++progress.block;
+                progress.record = 0;
+            }
+        }
+
+        progress.finished = progress.entities.size() == records.size() && progress.block == blocks.size();
+        return true;
+    }
+
+} // namespace Engine
@@ -0,0 +1,401 @@
+#include "Engine/Scene/SpatialIndex.hpp"
+
+#include <algorithm>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief How far ahead of its motion a moved proxy's box is extended
+         */
+        constexpr float DisplacementMultiplier = 2.0f;
+    }
+
+    SpatialIndex::SpatialIndex(float margin)
+        : root(NullProxy), freeList(NullProxy), proxyCount(0), margin(margin)
+    {
+    }
+
+    int32_t SpatialIndex::insert(const BoundingBox &box, uint32_t userData)
+    {
+        int32_t proxy = allocateNode();
+        nodes[proxy].box = box.expanded(margin);
+        nodes[proxy].userData = userData;
+        nodes[proxy].height = 0;
+
+        insertLeaf(proxy);
+        ++proxyCount;
+        return proxy;
+    }
+
+    void SpatialIndex::remove(int32_t proxy)
+    {
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --proxyCount;
+    }
+
+    bool SpatialIndex::move(int32_t proxy, const BoundingBox &box, const Vector3 &displacement)
+    {
+        BoundingBox fatBox = box.expanded(margin);
+
+        // Extend the box in the direction of motion so the proxy stays put
+        // for the next few updates
+        Vector3 d(displacement.x * DisplacementMultiplier, displacement.y * DisplacementMultiplier, displacement.z * DisplacementMultiplier);
+        (d.x < 0.0f ? fatBox.min.x : fatBox.max.x) += d.x;
+        (d.y < 0.0f ? fatBox.min.y : fatBox.max.y) += d.y;
+        (d.z < 0.0f ? fatBox.min.z : fatBox.max.z) += d.z;
+
+        const BoundingBox &treeBox = nodes[proxy].box;
+        if (treeBox.contains(box))
+        {
+            // Keep the leaf unless it has become much larger than needed,
+            // such as after a fast object came to rest
+            BoundingBox hugeBox = fatBox.expanded(4.0f * margin);
+            if (hugeBox.contains(treeBox))
+            {
+                return false;
+            }
+        }
+
+        removeLeaf(proxy);
+        nodes[proxy].box = fatBox;
+        insertLeaf(proxy);
+        return true;
+    }
+
+    void SpatialIndex::clear()
+    {
+        nodes.clear();
+        root = NullProxy;
+        freeList = NullProxy;
+        proxyCount = 0;
+    }
+
+    void SpatialIndex::queryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const
+    {
+        results.clear();
+        query(frustum, [&results](uint32_t userData)
+              {
+            results.push_back(userData);
+            return true; });
+    }
+
+    void SpatialIndex::queryBoxes(const std::vector<BoundingBox> &boxes, std::vector<std::pair<uint32_t, uint32_t>> &results) const
+    {
+        results.clear();
+        for (uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            query(boxes[i], [&results, i](uint32_t userData)
+                  {
+                results.emplace_back(i, userData);
+                return true; });
+        }
+    }
+
+    void SpatialIndex::querySpheres(const std::vector<BoundingSphere> &spheres, std::vector<std::pair<uint32_t, uint32_t>> &results) const
+    {
+        results.clear();
+        for (uint32_t i = 0; i < spheres.size(); ++i)
+        {
+            query(spheres[i], [&results, i](uint32_t userData)
+                  {
+                results.emplace_back(i, userData);
+                return true; });
+        }
+    }
+
+    void SpatialIndex::queryOverlappingPairs(std::vector<std::pair<uint32_t, uint32_t>> &results) const
+    {
+        results.clear();
+        for (int32_t i = 0; i < static_cast<int32_t>(nodes.size()); ++i)
+        {
+            // Leaves have height 0, free nodes -1
+            const Node &node = nodes[i];
+            if (node.height != 0)
+            {
+                continue;
+            }
+
+            // Report each pair from the leaf with the lower index only
+            traverse([&node](const BoundingBox &box)
+                     { return box.intersects(node.box); },
+                     [this, &results, &node, i](int32_t other)
+                     {
+                         if (other > i)
+                         {
+                             results.emplace_back(node.userData, nodes[other].userData);
+                         }
+                         return true;
+                     });
+        }
+    }
+
+    int32_t SpatialIndex::allocateNode()
+    {
+        if (freeList == NullProxy)
+        {
+            nodes.emplace_back();
+            return static_cast<int32_t>(nodes.size() - 1);
+        }
+
+        int32_t index = freeList;
+        freeList = nodes[index].parent;
+        nodes[index] = Node();
+        return index;
+    }
+
+    void SpatialIndex::freeNode(int32_t index)
+    {
+        nodes[index] = Node();
+        nodes[index].height = -1;
+        nodes[index].parent = freeList;
+        freeList = index;
+    }
+
+    void SpatialIndex::insertLeaf(int32_t leaf)
+    {
+        if (root == NullProxy)
+        {
+            root = leaf;
+            nodes[root].parent = NullProxy;
+            return;
+        }
+
+        // Walk down to the sibling whose subtree grows the least, using the
+        // surface area heuristic
+        BoundingBox leafBox = nodes[leaf].box;
+        int32_t index = root;
+        while (!nodes[index].isLeaf())
+        {
+            const Node &node = nodes[index];
+            float area = node.box.getSurfaceArea();
+            float combinedArea = BoundingBox::merge(node.box, leafBox).getSurfaceArea();
+
+            // Cost of making a new parent for this node and the leaf
+            float cost = 2.0f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child)
+            {
+                const Node &childNode = nodes[child];
+                float merged = BoundingBox::merge(leafBox, childNode.box).getSurfaceArea();
+                return childNode.isLeaf() ? merged + inheritanceCost
+                                          : merged - childNode.box.getSurfaceArea() + inheritanceCost;
+            };
+
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32_t sibling = index;
+
+        // Create a new parent for the sibling and the leaf
+        int32_t oldParent = nodes[sibling].parent;
+        int32_t newParent = allocateNode();
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].box = BoundingBox::merge(leafBox, nodes[sibling].box);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].child1 = sibling;
+        nodes[newParent].child2 = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent == NullProxy)
+        {
+            root = newParent;
+        }
+        else if (nodes[oldParent].child1 == sibling)
+        {
+            nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            nodes[oldParent].child2 = newParent;
+        }
+
+        refit(nodes[leaf].parent);
+    }
+
+    void SpatialIndex::removeLeaf(int32_t leaf)
+    {
+        if (leaf == root)
+        {
+            root = NullProxy;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grandParent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        // The sibling takes the parent's place
+        if (grandParent == NullProxy)
+        {
+            root = sibling;
+            nodes[sibling].parent = NullProxy;
+            freeNode(parent);
+            return;
+        }
+
+        if (nodes[grandParent].child1 == parent)
+        {
+            nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            nodes[grandParent].child2 = sibling;
+        }
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refit(grandParent);
+    }
+
+    void SpatialIndex::refit(int32_t index)
+    {
+        while (index != NullProxy)
+        {
+            index = balance(index);
+
+            Node &node = nodes[index];
+            const Node &child1 = nodes[node.child1];
+            const Node &child2 = nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.box = BoundingBox::merge(child1.box, child2.box);
+
+            index = node.parent;
+        }
+    }
+
+    int32_t SpatialIndex::balance(int32_t indexA)
+    {
+        Node &a = nodes[indexA];
+        if (a.isLeaf() || a.height < 2)
+        {
+            return indexA;
+        }
+
+        int32_t indexB = a.child1;
+        int32_t indexC = a.child2;
+        Node &b = nodes[indexB];
+        Node &c = nodes[indexC];
+
+        int32_t difference = c.height - b.height;
+
+        // Rotate C up
+        if (difference > 1)
+        {
+            int32_t indexF = c.child1;
+            int32_t indexG = c.child2;
+            Node &f = nodes[indexF];
+            Node &g = nodes[indexG];
+
+            // Swap A and C
+            c.child1 = indexA;
+            c.parent = a.parent;
+            a.parent = indexC;
+
+            if (c.parent == NullProxy)
+            {
+                root = indexC;
+            }
+            else if (nodes[c.parent].child1 == indexA)
+            {
+                nodes[c.parent].child1 = indexC;
+            }
+            else
+            {
+                nodes[c.parent].child2 = indexC;
+            }
+
+            // Keep the taller grandchild under C
+            if (f.height > g.height)
+            {
+                c.child2 = indexF;
+                a.child2 = indexG;
+                g.parent = indexA;
+                a.box = BoundingBox::merge(b.box, g.box);
+                c.box = BoundingBox::merge(a.box, f.box);
+                a.height = 1 + std::max(b.height, g.height);
+                c.height = 1 + std::max(a.height, f.height);
+            }
+            else
+            {
+                c.child2 = indexG;
+                a.child2 = indexF;
+                f.parent = indexA;
+                a.box = BoundingBox::merge(b.box, f.box);
+                c.box = BoundingBox::merge(a.box, g.box);
+                a.height = 1 + std::max(b.height, f.height);
+                c.height = 1 + std::max(a.height, g.height);
+            }
+
+            return indexC;
+        }
+
+        // Rotate B up
+        if (difference < -1)
+        {
+            int32_t indexD = b.child1;
+            int32_t indexE = b.child2;
+            Node &d = nodes[indexD];
+            Node &e = nodes[indexE];
+
+            // Swap A and B
+            b.child1 = indexA;
+            b.parent = a.parent;
+            a.parent = indexB;
+
+            if (b.parent == NullProxy)
+            {
+                root = indexB;
+            }
+            else if (nodes[b.parent].child1 == indexA)
+            {
+                nodes[b.parent].child1 = indexB;
+            }
+            else
+            {
+                nodes[b.parent].child2 = indexB;
+            }
+
+            // Keep the taller grandchild under B
+            if (d.height > e.height)
+            {
+                b.child2 = indexD;
+                a.child1 = indexE;
+                e.parent = indexA;
+                a.box = BoundingBox::merge(c.box, e.box);
+                b.box = BoundingBox::merge(a.box, d.box);
+                a.height = 1 + std::max(c.height, e.height);
+                b.height = 1 + std::max(a.height, d.height);
+            }
+            else
+            {
+                b.child2 = indexE;
+                a.child1 = indexD;
+                d.parent = indexA;
+                a.box = BoundingBox::merge(c.box, d.box);
+                b.box = BoundingBox::merge(a.box, e.box);
+                a.height = 1 + std::max(c.height, d.height);
+                b.height = 1 + std::max(a.height, e.height);
+            }
+
+            return indexB;
+        }
+
+        return indexA;
+    }
+
+} // namespace Engine
@@ -0,0 +1,425 @@
+#include "Engine/Scene/WorldStreamer.hpp"
+#include "Engine/Core/Engine.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Mesh.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Resources/ResourceManager.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine
+{
+
+    namespace
+    {
+        /**
+         * @brief Gets the milliseconds elapsed since a point in time
+         * @param start Start time
+         * @return Elapsed milliseconds
+         */
+        float millisecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    WorldStreamer::WorldStreamer(Engine &engine, Scene &scene, const WorldStreamerConfig &config)
+        : engine(engine), scene(scene), config(config)
+    {
+        if (this->config.cellSize <= 0.0f)
+        {
+            Logger::warning("World streamer cell size must be positive, using 128");
+            this->config.cellSize = 128.0f;
+        }
+        if (this->config.unloadDistance < this->config.loadDistance)
+        {
+            Logger::warning("World streamer unload distance is below the load distance, using the load distance");
+            this->config.unloadDistance = this->config.loadDistance;
+        }
+        this->config.maxConcurrentLoads = std::max<uint32_t>(this->config.maxConcurrentLoads, 1);
+        this->config.batchSize = std::max<size_t>(this->config.batchSize, 1);
+    }
+
+    WorldStreamer::~WorldStreamer()
+    {
+        engine.getJobSystem().wait(jobs);
+
+        // Only the mesh references are dropped; entities stay in the scene
+        ResourceManager &resources = engine.getResourceManager();
+        for (Cell &cell : cells)
+        {
+            for (MeshHandle handle : cell.meshes)
+            {
+                resources.release(handle);
+            }
+        }
+    }
+
+    bool WorldStreamer::addCell(int32_t x, int32_t z, WorldCellDesc desc)
+    {
+        uint64_t key = makeKey(x, z);
+        if (cellIndices.find(key) != cellIndices.end())
+        {
+            Logger::warning("World cell ({}, {}) already exists", x, z);
+            return false;
+        }
+
+        // Cells are referred to by pointer only within update(), so growing the vector is safe
+        Cell cell;
+        cell.x = x;
+        cell.z = z;
+        cell.desc = std::move(desc);
+        cellIndices[key] = cells.size();
+        cells.push_back(std::move(cell));
+        return true;
+    }
+
+    void WorldStreamer::update()
+    {
+        CameraComponent *camera = engine.getRenderer().getCamera();
+        if (!camera || !camera->getOwner())
+        {
+            return;
+        }
+        update(camera->getOwner()->getTransform().getWorldMatrix().getTranslation());
+    }
+
+    void WorldStreamer::update(const Vector3 &focus)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        // Distance on the XZ plane from the focus to the nearest point of each cell
+        uint32_t loading = 0;
+        for (Cell &cell : cells)
+        {
+            float minX = cell.x * config.cellSize;
+            float minZ = cell.z * config.cellSize;
+            float dx = std::max(std::max(minX - focus.x, focus.x - (minX + config.cellSize)), 0.0f);
+            float dz = std::max(std::max(minZ - focus.z, focus.z - (minZ + config.cellSize)), 0.0f);
+            cell.distance = std::sqrt(dx * dx + dz * dz);
+
+            WorldCellState state = cell.stats.state;
+            if (state != WorldCellState::Unloaded && state != WorldCellState::Unloading &&
+                state != WorldCellState::Failed && cell.distance > config.unloadDistance)
+            {
+                beginUnload(cell);
+            }
+            else if (state == WorldCellState::Loading)
+            {
+                pollCell(cell);
+            }
+
+            if (cell.stats.state == WorldCellState::Loading)
+            {
+                ++loading;
+            }
+        }
+
+        // Start new reads, nearest first
+        queue.clear();
+        for (Cell &cell : cells)
+        {
+            if (cell.stats.state == WorldCellState::Unloaded && cell.distance <= config.loadDistance)
+            {
+                queue.push_back(&cell);
+            }
+        }
+        std::sort(queue.begin(), queue.end(), [](const Cell *a, const Cell *b)
+                  { return a->distance < b->distance; });
+        for (size_t i = 0; i < queue.size() && loading < config.maxConcurrentLoads; ++i)
+        {
+            requestCell(*queue[i]);
+            ++loading;
+        }
+
+        // Removals go first so memory is freed before more is taken, then activations nearest first
+        queue.clear();
+        for (Cell &cell : cells)
+        {
+            WorldCellState state = cell.stats.state;
+            if (state == WorldCellState::Unloading || state == WorldCellState::Loaded ||
+                state == WorldCellState::Activating)
+            {
+                queue.push_back(&cell);
+            }
+        }
+        std::sort(queue.begin(), queue.end(), [](const Cell *a, const Cell *b)
+                  {
+                      bool aUnloading = a->stats.state == WorldCellState::Unloading;
+                      bool bUnloading = b->stats.state == WorldCellState::Unloading;
+                      if (aUnloading != bUnloading)
+                      {
+                          return aUnloading;
+                      }
+                      return a->distance < b->distance; });
+
+        // At least one batch per update, so a tiny budget still makes progress
+        size_t next = 0;
+        Cell *previous = nullptr;
+        bool first = true;
+        while (next < queue.size() && (first || millisecondsSince(start) < config.budgetMilliseconds))
+        {
+            first = false;
+            Cell &cell = *queue[next];
+            if (cell.stats.state == WorldCellState::Unloading)
+            {
+                unloadBatch(cell);
+            }
+            else
+            {
+                if (&cell != previous)
+                {
+                    ++cell.stats.activationFrames;
+                }
+                activateBatch(cell);
+            }
+            previous = &cell;
+
+            WorldCellState state = cell.stats.state;
+            if (state != WorldCellState::Unloading && state != WorldCellState::Activating)
+            {
+                ++next;
+            }
+        }
+
+        // Totals
+        WorldStreamerStats totals;
+        totals.cellCount = cells.size();
+        for (const Cell &cell : cells)
+        {
+            WorldCellState state = cell.stats.state;
+            if (state == WorldCellState::Loading || state == WorldCellState::Loaded ||
+                state == WorldCellState::Activating)
+            {
+                ++totals.pendingCells;
+            }
+            else if (state == WorldCellState::Active)
+            {
+                ++totals.activeCells;
+            }
+            totals.entityCount += cell.stats.entityCount;
+            totals.fileBytes += cell.stats.fileBytes;
+            totals.meshBytes += cell.stats.meshBytes;
+        }
+        totals.updateMilliseconds = millisecondsSince(start);
+        stats = totals;
+    }
+
+    const WorldCellStats *WorldStreamer::getCellStats(int32_t x, int32_t z) const
+    {
+        auto it = cellIndices.find(makeKey(x, z));
+        if (it == cellIndices.end())
+        {
+            return nullptr;
+        }
+        return &cells[it->second].stats;
+    }
+
+    void WorldStreamer::requestCell(Cell &cell)
+    {
+        ResourceManager &resources = engine.getResourceManager();
+
+        // Resource packs stay mounted, other cells may share them
+        if (!cell.desc.archivePath.empty() && mountedArchives.insert(cell.desc.archivePath).second)
+        {
+            if (!resources.mountArchive(cell.desc.archivePath))
+            {
+                Logger::warning("World cell ({}, {}): failed to mount '{}', reading loose files",
+                                cell.x, cell.z, cell.desc.archivePath);
+            }
+        }
+
+        cell.meshLoads.clear();
+        cell.meshLoads.reserve(cell.desc.meshes.size());
+        for (const auto &mesh : cell.desc.meshes)
+        {
+            cell.meshLoads.push_back(resources.loadMeshAsync(mesh.first, mesh.second));
+        }
+
+        // The job keeps the pending file alive even if the cell is dropped meanwhile
+        auto pending = std::make_shared<PendingFile>();
+        cell.pending = pending;
+        std::string path = cell.desc.scenePath;
+        engine.getJobSystem().submit([pending, path, &resources]()
+                                     {
+                                         AssetData data;
+                                         if (!resources.openAsset(path, data))
+                                         {
+                                             Logger::error("Failed to read world cell scene '" + path + "'");
+                                         }
+                                         else if (pending->file.open(std::move(data), path))
+                                         {
+                                             // Fault the pages in here rather than on the main thread
+                                             pending->file.prefetch();
+                                             pending->opened = true;
+                                         }
+                                         pending->done.store(true, std::memory_order_release); },
+                                     &jobs);
+
+        cell.requestTime = std::chrono::steady_clock::now();
+        cell.stats.state = WorldCellState::Loading;
+        ++cell.stats.loadCount;
+    }
+
+    void WorldStreamer::pollCell(Cell &cell)
+    {
+        if (!cell.pending->done.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        for (const AsyncResource<Mesh> &load : cell.meshLoads)
+        {
+            if (!load.isDone())
+            {
+                return;
+            }
+        }
+
+        if (!cell.pending->opened)
+        {
+            cell.pending.reset();
+            cell.meshLoads.clear();
+            cell.stats.state = WorldCellState::Failed;
+            return;
+        }
+
+        // Hold the meshes for as long as the cell is loaded
+        ResourceManager &resources = engine.getResourceManager();
+        cell.stats.meshBytes = 0;
+        for (size_t i = 0; i < cell.meshLoads.size(); ++i)
+        {
+            MeshHandle handle = cell.meshLoads[i].getHandle();
+            if (!cell.meshLoads[i].isReady() || !resources.acquire(handle))
+            {
+                Logger::warning("World cell ({}, {}): mesh '{}' failed to load", cell.x, cell.z,
+                                cell.desc.meshes[i].first);
+                continue;
+            }
+            cell.meshes.push_back(handle);
+            if (Mesh *mesh = resources.getMesh(handle))
+            {
+                cell.stats.meshBytes += mesh->getMemorySize();
+            }
+        }
+        cell.meshLoads.clear();
+
+        cell.stats.fileBytes = cell.pending->file.getSize();
+        cell.stats.loadMilliseconds = millisecondsSince(cell.requestTime);
+        cell.stats.activationMilliseconds = 0.0f;
+        cell.stats.activationFrames = 0;
+        cell.progress = SceneLoadProgress();
+        cell.stats.state = WorldCellState::Loaded;
+    }
+
+    void WorldStreamer::activateBatch(Cell &cell)
+    {
+        auto start = std::chrono::steady_clock::now();
+        cell.stats.state = WorldCellState::Activating;
+
+        const SceneSerializer &serializer = engine.getSceneManager().getSerializer();
+        bool ok = serializer.load(scene, cell.pending->file, cell.progress, config.batchSize);
+        cell.stats.entityCount = cell.progress.entities.size();
+        cell.stats.activationMilliseconds += millisecondsSince(start);
+
+        if (!ok)
+        {
+            Logger::error("Failed to activate world cell ({}, {})", cell.x, cell.z);
+            for (Entity *entity : cell.progress.entities)
+            {
+                scene.destroyEntity(entity);
+            }
+            cell.progress = SceneLoadProgress();
+            finishUnload(cell);
+            cell.stats.state = WorldCellState::Failed;
+            return;
+        }
+
+        if (cell.progress.finished)
+        {
+            // Keep ids rather than pointers, so entities destroyed by gameplay are skipped on unload
+            cell.entityIds.clear();
+            cell.entityIds.reserve(cell.progress.entities.size());
+            for (Entity *entity : cell.progress.entities)
+            {
+                cell.entityIds.push_back(entity->getId());
+            }
+            cell.progress = SceneLoadProgress();
+            cell.pending.reset();
+            cell.stats.fileBytes = 0;
+            cell.stats.state = WorldCellState::Active;
+        }
+    }
+
+    void WorldStreamer::unloadBatch(Cell &cell)
+    {
+        size_t end = std::min(cell.unloadCursor + config.batchSize, cell.entityIds.size());
+        for (; cell.unloadCursor < end; ++cell.unloadCursor)
+        {
+            // Children destroyed along with their parent are gone already
+            Entity *entity = scene.getEntity(cell.entityIds[cell.unloadCursor]);
+            if (entity)
+            {
+                scene.destroyEntity(entity);
+            }
+        }
+        cell.stats.entityCount = cell.entityIds.size() - cell.unloadCursor;
+
+        if (cell.unloadCursor >= cell.entityIds.size())
+        {
+            finishUnload(cell);
+        }
+    }
+
+    void WorldStreamer::beginUnload(Cell &cell)
+    {
+        switch (cell.stats.state)
+        {
+        case WorldCellState::Activating:
+            cell.entityIds.clear();
+            cell.entityIds.reserve(cell.progress.entities.size());
+            for (Entity *entity : cell.progress.entities)
+            {
+                cell.entityIds.push_back(entity->getId());
+            }
+            cell.progress = SceneLoadProgress();
+            cell.pending.reset();
+            cell.stats.fileBytes = 0;
+            cell.unloadCursor = 0;
+            cell.stats.state = WorldCellState::Unloading;
+            break;
+        case WorldCellState::Active:
+            cell.unloadCursor = 0;
+            cell.stats.state = WorldCellState::Unloading;
+            break;
+        default:
+            // Nothing in the scene yet; a running read finishes into the dropped pending file
+            finishUnload(cell);
+            break;
+        }
+    }
+
+    void WorldStreamer::finishUnload(Cell &cell)
+    {
+        ResourceManager &resources = engine.getResourceManager();
+        for (MeshHandle handle : cell.meshes)
+        {
+            resources.release(handle);
+        }
+        cell.meshes.clear();
+        cell.meshLoads.clear();
+        cell.pending.reset();
+        cell.progress = SceneLoadProgress();
+        cell.entityIds.clear();
+        cell.unloadCursor = 0;
+
+        cell.stats.entityCount = 0;
+        cell.stats.fileBytes = 0;
+        cell.stats.meshBytes = 0;
+        cell.stats.state = WorldCellState::Unloaded;
+    }
+
+} // namespace Engine
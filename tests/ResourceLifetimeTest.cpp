@@ -0,0 +1,339 @@
+#include "MockRenderer.hpp"
+
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Renderer/FramePipeline.hpp"
+#include "Engine/Renderer/MeshRenderer.hpp"
+#include "Engine/Renderer/Window.hpp"
+#include "Engine/Resources/MeshCooker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Engine;
+using namespace Benchmark;
+
+namespace
+{
+    // Size of the BC1 test textures
+    const int TEXTURE_SIZE = 64;
+
+    // Number of failed checks
+    int failures = 0;
+
+    // Reports a failed check without stopping the test
+    void check(bool condition, const char *description)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", description);
+            ++failures;
+        }
+    }
+
+    // Writes a DDS file with a full BC1 mip chain of zero blocks
+    bool writeDDS(const std::string &path, int size)
+    {
+        int levels = getMipLevelCount(size, size);
+        unsigned char header[128] = {};
+        auto write32 = [&header](size_t offset, uint32_t value)
+        { std::memcpy(header + offset, &value, sizeof(value)); };
+        std::memcpy(header, "DDS ", 4);
+        write32(4, 124);
+        write32(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+        write32(12, static_cast<uint32_t>(size));
+        write32(16, static_cast<uint32_t>(size));
+        write32(28, static_cast<uint32_t>(levels));
+        write32(76, 32);
+        write32(80, 0x4);
+        std::memcpy(header + 84, "DXT1", 4);
+        write32(108, 0x1000 | 0x400000 | 0x8);
+
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+        std::fwrite(header, 1, sizeof(header), file);
+        for (int level = 0; level < levels; ++level)
+        {
+            int levelSize = std::max(1, size >> level);
+            std::vector<unsigned char> blocks(getTextureLevelSize(TextureFormat::BC1, levelSize, levelSize));
+            std::fwrite(blocks.data(), 1, blocks.size(), file);
+        }
+        bool written = std::ferror(file) == 0;
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Cooks a single triangle
+    bool cookTriangle(const std::string &path)
+    {
+        std::vector<Vertex> vertices(3);
+        vertices[1].position = Vector3(1.0f, 0.0f, 0.0f);
+        vertices[2].position = Vector3(0.0f, 1.0f, 0.0f);
+        return MeshCooker::cook(path, vertices, {0, 1, 2});
+    }
+
+    // Meshes that were created and not destroyed yet, shared by both threads
+    std::mutex liveMeshMutex;
+    std::set<const Mesh *> liveMeshes;
+
+    // Checks if a mesh has not been destroyed yet
+    bool isLive(const Mesh *mesh)
+    {
+        std::lock_guard<std::mutex> lock(liveMeshMutex);
+        return liveMeshes.count(mesh) != 0;
+    }
+
+    // Mock mesh that reports its lifetime
+    class TrackedMesh : public MockMesh
+    {
+    public:
+        explicit TrackedMesh(const std::string &name) : MockMesh(name)
+        {
+            std::lock_guard<std::mutex> lock(liveMeshMutex);
+            liveMeshes.insert(this);
+        }
+
+        ~TrackedMesh() override
+        {
+            std::lock_guard<std::mutex> lock(liveMeshMutex);
+            liveMeshes.erase(this);
+        }
+    };
+
+    // Resource manager that creates tracked meshes
+    class TrackingResourceManager : public MockResourceManager
+    {
+    protected:
+        std::unique_ptr<Mesh> createMesh(const std::string &name) override { return std::make_unique<TrackedMesh>(name); }
+    };
+
+    // Window without a graphics context, so the frame pipeline runs headless
+    class MockWindow : public Window
+    {
+    public:
+        MockWindow() : Window(1, 1, "Test") {}
+
+        bool initialize() override { return true; }
+        void shutdown() override {}
+        void pollEvents() override {}
+        void swapBuffers() override {}
+        void makeContextCurrent() override {}
+        void releaseContext() override {}
+        bool shouldClose() const override { return false; }
+        void setTitle(const std::string &title) override { this->title = title; }
+        void *getNativeHandle() const override { return nullptr; }
+    };
+
+    // Renderer that can hold the render thread in a frame and counts draws of destroyed meshes
+    class PipelineRenderer : public MockRenderer
+    {
+    public:
+        Window *getWindow() const override { return &window; }
+
+        void renderSnapshot(const RenderSnapshot &snapshot) override
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                drawing = true;
+                condition.notify_all();
+                condition.wait(lock, [this]()
+                               { return !holding; });
+            }
+
+            for (const RenderItem &item : snapshot.items)
+            {
+                if (!isLive(item.mesh))
+                {
+                    ++destroyedDraws;
+                }
+            }
+        }
+
+        // Makes the next frame wait in renderSnapshot() until release()
+        void hold()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            holding = true;
+            drawing = false;
+        }
+
+        // Waits until the render thread is held in a frame
+        void waitUntilDrawing()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]()
+                           { return drawing; });
+        }
+
+        // Lets the held frame finish
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                holding = false;
+            }
+            condition.notify_all();
+        }
+
+        std::atomic<int> destroyedDraws{0};
+
+    private:
+        mutable MockWindow window;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool holding = false;
+        bool drawing = false;
+    };
+
+    // Runs one frame the way the engine does with the frame pipeline
+    void runFrame(ResourceManager &manager, FramePipeline &pipeline, Mesh *mesh)
+    {
+        manager.update();
+        if (manager.hasPendingUploads())
+        {
+            pipeline.runOnRenderThread([&manager]()
+                                       { manager.processUploads(1000.0f); });
+        }
+
+        RenderSnapshot &snapshot = pipeline.beginSnapshot();
+        if (mesh)
+        {
+            snapshot.items.push_back({mesh, nullptr, Matrix4(), Vector4::One, 0});
+        }
+        pipeline.submitSnapshot();
+    }
+
+    // A mesh evicted while a queued snapshot still draws it lives until that snapshot is drawn
+    void testPipelineKeepsEvictedMesh(const std::string &directory)
+    {
+        TrackingResourceManager manager;
+        manager.initialize(nullptr);
+        manager.setResourcesPath(directory);
+        manager.setMeshBudget(1);
+
+        PipelineRenderer renderer;
+        FramePipeline pipeline(renderer);
+        check(pipeline.initialize(3), "frame pipeline starts headless");
+        manager.setFramesInFlight(pipeline.getFramesInFlight());
+
+        Mesh *mesh = manager.loadMesh("Triangle", "triangle.mesh");
+        MeshRef ref = manager.getMeshRef("Triangle");
+
+        // Hold the render thread in the first frame, so the next one stays queued
+        renderer.hold();
+        runFrame(manager, pipeline, nullptr);
+        renderer.waitUntilDrawing();
+        runFrame(manager, pipeline, mesh);
+
+        // Nothing references the mesh any more; the next update() evicts it
+        // and queues the uploads ahead of the snapshot that draws it
+        ref.reset();
+        runFrame(manager, pipeline, nullptr);
+        check(!manager.findMesh("Triangle").isValid(), "unreferenced mesh is evicted");
+        renderer.release();
+
+        for (int frame = 0; frame < pipeline.getFramesInFlight() + 1; ++frame)
+        {
+            runFrame(manager, pipeline, nullptr);
+        }
+        pipeline.shutdown();
+
+        check(renderer.destroyedDraws == 0, "queued snapshots never draw a destroyed mesh");
+        check(!isLive(mesh), "evicted mesh is destroyed once the frames in flight are drawn");
+        manager.shutdown();
+    }
+
+    // A texture bound to a material survives a budget it does not fit, and is evicted once unbound
+    void testMaterialKeepsTexture(MockResourceManager &manager)
+    {
+        manager.setTextureBudget(1);
+        Texture *bound = manager.loadTexture("Bound", "bound.dds");
+        check(manager.loadTexture("Unbound", "unbound.dds") != nullptr, "unbound texture loads");
+
+        Material *material = manager.createMaterial("Material", nullptr);
+        material->setTexture("diffuseTexture", manager.getTextureRef("Bound"));
+        manager.update();
+
+        check(bound != nullptr && manager.getTexture("Bound") == bound, "bound texture survives update()");
+        check(!manager.findTexture("Unbound").isValid(), "unbound texture is evicted");
+
+        // Replacing the texture drops the material's reference
+        material->setTexture("diffuseTexture", TextureRef());
+        manager.update();
+        check(!manager.findTexture("Bound").isValid(), "texture is evicted once the material lets go");
+
+        manager.setTextureBudget(0);
+    }
+
+    // A mesh renderer keeps its mesh through copies and moves until the last one is gone
+    void testMeshRendererKeepsMesh(MockResourceManager &manager)
+    {
+        manager.setMeshBudget(1);
+        Mesh *mesh = manager.loadMesh("Triangle", "triangle.mesh");
+        MeshHandle handle = manager.findMesh("Triangle");
+
+        {
+            MeshRendererComponent renderer(manager.getMeshRef(handle));
+            MeshRendererComponent copy = renderer;
+            MeshRendererComponent moved = std::move(renderer);
+            check(renderer.getMesh() == nullptr, "moved-from mesh renderer is empty");
+
+            manager.update();
+            check(mesh != nullptr && manager.getMesh(handle) == mesh, "mesh of a mesh renderer survives update()");
+            check(moved.getMesh() == mesh && copy.getMesh() == mesh, "mesh renderers still point at the mesh");
+
+            // The copy holds a reference of its own
+            copy = MeshRendererComponent();
+            manager.update();
+            check(manager.getMesh(handle) == mesh, "mesh survives while one mesh renderer is left");
+        }
+
+        manager.update();
+        check(!manager.findMesh("Triangle").isValid(), "mesh is evicted once no mesh renderer uses it");
+
+        manager.setMeshBudget(0);
+    }
+}
+
+int main()
+{
+    Logger::init(LogLevel::Warning);
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "engine-tests";
+    std::filesystem::create_directories(directory);
+    if (!writeDDS((directory / "bound.dds").string(), TEXTURE_SIZE) ||
+        !writeDDS((directory / "unbound.dds").string(), TEXTURE_SIZE) ||
+        !cookTriangle((directory / "triangle.mesh").string()))
+    {
+        std::fprintf(stderr, "Failed to write the test files to %s\n", directory.string().c_str());
+        return 1;
+    }
+
+    MockResourceManager manager;
+    manager.initialize(nullptr);
+    manager.setResourcesPath(directory.string());
+
+    testMaterialKeepsTexture(manager);
+    testMeshRendererKeepsMesh(manager);
+
+    manager.shutdown();
+    testPipelineKeepsEvictedMesh(directory.string());
+    Logger::shutdown();
+
+    std::filesystem::remove_all(directory);
+    if (failures == 0)
+    {
+        std::printf("All checks passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
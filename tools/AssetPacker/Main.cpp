@@ -0,0 +1,88 @@
+#include "Engine/Resources/AssetArchiveWriter.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Reads a whole file into memory
+    bool readFile(const std::filesystem::path &path, std::vector<unsigned char> &data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Logger::init(LogLevel::Info);
+
+    bool compress = argc == 4 && std::string(argv[3]) == "--lz4";
+    if (argc != 3 && !compress)
+    {
+        std::fprintf(stderr, "Usage: %s <output.pack> <resources directory> [--lz4]\n", argv[0]);
+        return 1;
+    }
+
+    std::filesystem::path root(argv[2]);
+    std::error_code error;
+    if (!std::filesystem::is_directory(root, error))
+    {
+        std::fprintf(stderr, "Not a directory: %s\n", argv[2]);
+        return 1;
+    }
+
+    // Sort the files so the same directory always packs to the same archive
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(root, error))
+    {
+        if (entry.is_regular_file())
+        {
+            files.push_back(entry.path());
+        }
+    }
+    if (error)
+    {
+        std::fprintf(stderr, "Failed to list %s: %s\n", argv[2], error.message().c_str());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    // Assets are keyed by the path the engine asks for, relative to the
+    // resources directory and with forward slashes
+    AssetArchiveWriter writer;
+    size_t totalSize = 0;
+    for (const std::filesystem::path &file : files)
+    {
+        std::vector<unsigned char> data;
+        if (!readFile(file, data))
+        {
+            std::fprintf(stderr, "Failed to read %s\n", file.string().c_str());
+            return 1;
+        }
+
+        totalSize += data.size();
+        writer.add(file.lexically_relative(root).generic_string(), std::move(data), compress);
+    }
+
+    if (!writer.write(argv[1]))
+    {
+        return 1;
+    }
+
+    std::printf("Packed %zu assets (%zu bytes) into %s\n", writer.getAssetCount(), totalSize, argv[1]);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "Engine/Core/LogFormat.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+using namespace Engine;
+
+namespace
+{
+    // Reads a little-endian value, false at the end of the file
+    template <typename T>
+    bool readValue(std::ifstream &file, T &value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    // Reads a block of bytes of a known size
+    bool readBytes(std::ifstream &file, std::string &bytes, uint32_t size)
+    {
+        bytes.resize(size);
+        return size == 0 || static_cast<bool>(file.read(&bytes[0], size));
+    }
+
+    // Formats microseconds since the epoch like the text sinks do
+    std::string formatTimestamp(int64_t microseconds)
+    {
+        std::time_t seconds = static_cast<std::time_t>(microseconds / 1000000);
+        char prefix[32];
+        std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+
+        char buffer[40];
+        std::snprintf(buffer, sizeof(buffer), "%s.%03d", prefix, static_cast<int>(microseconds / 1000 % 1000));
+        return buffer;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "Usage: %s <log.binlog>\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!file || !readValue(file, magic) || !readValue(file, version) || magic != LogFileMagic)
+    {
+        std::fprintf(stderr, "Not a binary log: %s\n", argv[1]);
+        return 1;
+    }
+    if (version != LogFileVersion)
+    {
+        std::fprintf(stderr, "Unsupported binary log version %u: %s\n", version, argv[1]);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string> formats;
+    std::string arguments;
+    std::string message;
+    uint8_t kind;
+    while (readValue(file, kind))
+    {
+        if (kind == static_cast<uint8_t>(LogRecordKind::Format))
+        {
+            uint32_t id;
+            uint32_t length;
+            if (!readValue(file, id) || !readValue(file, length) || !readBytes(file, formats[id], length))
+            {
+                break;
+            }
+            continue;
+        }
+
+        uint8_t level;
+        int64_t microseconds;
+        uint32_t formatId;
+        uint32_t size;
+        if (kind != static_cast<uint8_t>(LogRecordKind::Message) || !readValue(file, level) ||
+            !readValue(file, microseconds) || !readValue(file, formatId) || !readValue(file, size) ||
+            !readBytes(file, arguments, size))
+        {
+            break;
+        }
+
+        auto it = formats.find(formatId);
+        message.clear();
+        if (it == formats.end() || !LogFormat::format(message, it->second.c_str(), arguments))
+        {
+            message += " <malformed record>";
+        }
+
+        // Output format: [TIMESTAMP] [LEVEL] MESSAGE
+        std::printf("[%s] [%s] %s\n", formatTimestamp(microseconds).c_str(),
+                    Logger::levelToString(static_cast<LogLevel>(level)).c_str(), message.c_str());
+    }
+
+    // A partial record at the end is a log cut short by a crash, anything else is corruption
+    if (!file.eof())
+    {
+        std::fprintf(stderr, "Truncated or corrupt record in %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
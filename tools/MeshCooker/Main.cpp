@@ -0,0 +1,362 @@
+#include "Engine/Resources/MeshCooker.hpp"
+#include "Engine/Resources/MeshSimplifier.hpp"
+#include "Engine/Core/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    // Vertex of an OBJ face: position, texture coordinate, and normal
+    // indices, -1 where missing
+    using FaceVertex = std::tuple<int, int, int>;
+
+    struct ObjData
+    {
+        std::vector<Vector3> positions;
+        std::vector<Vector2> texCoords;
+        std::vector<Vector3> normals;
+
+        // Triangles per material, in order of first use
+        std::vector<std::vector<FaceVertex>> triangles;
+    };
+
+    // Converts a 1-based or negative OBJ index to a 0-based one
+    int resolveIndex(const std::string &token, size_t count)
+    {
+        if (token.empty())
+        {
+            return -1;
+        }
+
+        int index = std::atoi(token.c_str());
+        if (index < 0)
+        {
+            index += static_cast<int>(count);
+        }
+        else
+        {
+            index -= 1;
+        }
+        return index >= 0 && static_cast<size_t>(index) < count ? index : -1;
+    }
+
+    bool parseObj(const std::string &filepath, ObjData &obj)
+    {
+        std::ifstream file(filepath);
+        if (!file)
+        {
+            Logger::error("Failed to open file: " + filepath);
+            return false;
+        }
+
+        std::unordered_map<std::string, size_t> materials;
+        size_t material = 0;
+        obj.triangles.emplace_back();
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+
+            if (keyword == "v")
+            {
+                Vector3 position;
+                stream >> position.x >> position.y >> position.z;
+                obj.positions.push_back(position);
+            }
+            else if (keyword == "vt")
+            {
+                Vector2 texCoord;
+                stream >> texCoord.x >> texCoord.y;
+                obj.texCoords.push_back(texCoord);
+            }
+            else if (keyword == "vn")
+            {
+                Vector3 normal;
+                stream >> normal.x >> normal.y >> normal.z;
+                obj.normals.push_back(normal);
+            }
+            else if (keyword == "usemtl")
+            {
+                std::string name;
+                stream >> name;
+
+                // Faces before the first usemtl keep slot 0
+                auto it = materials.find(name);
+                if (it == materials.end())
+                {
+                    bool firstUnused = materials.empty() && obj.triangles[0].empty();
+                    if (!firstUnused)
+                    {
+                        obj.triangles.emplace_back();
+                    }
+                    it = materials.emplace(name, obj.triangles.size() - 1).first;
+                }
+                material = it->second;
+            }
+            else if (keyword == "f")
+            {
+                std::vector<FaceVertex> face;
+                std::string token;
+                while (stream >> token)
+                {
+                    // v, v/vt, v//vn, or v/vt/vn
+                    std::string parts[3];
+                    size_t part = 0;
+                    for (char c : token)
+                    {
+                        if (c == '/')
+                        {
+                            part = std::min<size_t>(part + 1, 2);
+                        }
+                        else
+                        {
+                            parts[part] += c;
+                        }
+                    }
+
+                    int position = resolveIndex(parts[0], obj.positions.size());
+                    if (position < 0)
+                    {
+                        Logger::error("Invalid face in " + filepath + ": " + line);
+                        return false;
+                    }
+                    face.emplace_back(position, resolveIndex(parts[1], obj.texCoords.size()),
+                                      resolveIndex(parts[2], obj.normals.size()));
+                }
+
+                // Triangulate polygons as fans
+                for (size_t i = 2; i < face.size(); ++i)
+                {
+                    obj.triangles[material].push_back(face[0]);
+                    obj.triangles[material].push_back(face[i - 1]);
+                    obj.triangles[material].push_back(face[i]);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    Vector3 subtract(const Vector3 &a, const Vector3 &b)
+    {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    Vector3 normalize(const Vector3 &v, const Vector3 &fallback)
+    {
+        float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        return length > 1e-12f ? Vector3(v.x / length, v.y / length, v.z / length) : fallback;
+    }
+
+    void accumulate(Vector3 &target, const Vector3 &value)
+    {
+        target.x += value.x;
+        target.y += value.y;
+        target.z += value.z;
+    }
+
+    // Fills in missing normals and all tangent frames from the triangles
+    void computeTangentFrames(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
+                              const std::vector<bool> &hasNormal)
+    {
+        std::vector<Vector3> normals(vertices.size());
+        std::vector<Vector3> tangents(vertices.size());
+        std::vector<Vector3> bitangents(vertices.size());
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const Vertex &v0 = vertices[indices[i]];
+            const Vertex &v1 = vertices[indices[i + 1]];
+            const Vertex &v2 = vertices[indices[i + 2]];
+
+            Vector3 edge1 = subtract(v1.position, v0.position);
+            Vector3 edge2 = subtract(v2.position, v0.position);
+            Vector3 faceNormal = edge1.cross(edge2);
+
+            float du1 = v1.texCoord.x - v0.texCoord.x, dv1 = v1.texCoord.y - v0.texCoord.y;
+            float du2 = v2.texCoord.x - v0.texCoord.x, dv2 = v2.texCoord.y - v0.texCoord.y;
+            float determinant = du1 * dv2 - du2 * dv1;
+            float r = std::fabs(determinant) > 1e-12f ? 1.0f / determinant : 0.0f;
+            Vector3 tangent((edge1.x * dv2 - edge2.x * dv1) * r, (edge1.y * dv2 - edge2.y * dv1) * r,
+                            (edge1.z * dv2 - edge2.z * dv1) * r);
+            Vector3 bitangent((edge2.x * du1 - edge1.x * du2) * r, (edge2.y * du1 - edge1.y * du2) * r,
+                              (edge2.z * du1 - edge1.z * du2) * r);
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                uint32_t index = indices[i + k];
+                accumulate(normals[index], faceNormal);
+                accumulate(tangents[index], tangent);
+                accumulate(bitangents[index], bitangent);
+            }
+        }
+
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            Vertex &vertex = vertices[i];
+            if (!hasNormal[i])
+            {
+                vertex.normal = normalize(normals[i], Vector3(0.0f, 1.0f, 0.0f));
+            }
+
+            // Gram-Schmidt the tangent against the normal, then rebuild the
+            // bitangent with the handedness of the texture mapping
+            const Vector3 &n = vertex.normal;
+            const Vector3 &t = tangents[i];
+            float d = n.x * t.x + n.y * t.y + n.z * t.z;
+            Vector3 axis = std::fabs(n.x) < 0.9f ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+            float axisDot = n.x * axis.x + n.y * axis.y + n.z * axis.z;
+            Vector3 fallback = normalize(Vector3(axis.x - n.x * axisDot, axis.y - n.y * axisDot, axis.z - n.z * axisDot), axis);
+            vertex.tangent = normalize(Vector3(t.x - n.x * d, t.y - n.y * d, t.z - n.z * d), fallback);
+
+            Vector3 bitangent = n.cross(vertex.tangent);
+            const Vector3 &b = bitangents[i];
+            if (bitangent.x * b.x + bitangent.y * b.y + bitangent.z * b.z < 0.0f)
+            {
+                bitangent = Vector3(-bitangent.x, -bitangent.y, -bitangent.z);
+            }
+            vertex.bitangent = bitangent;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Logger::init(LogLevel::Info);
+
+    // --compact quantizes normals, tangents, and texture coordinates,
+    // --no-tangents drops the tangent frame for meshes without normal maps,
+    // and --lods <count> adds simplified levels of detail up to count levels
+    std::vector<std::string> paths;
+    bool compact = false;
+    bool tangents = true;
+    int lodLevels = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "--lods" && i + 1 < argc)
+        {
+            lodLevels = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (argument == "--compact")
+        {
+            compact = true;
+        }
+        else if (argument == "--no-tangents")
+        {
+            compact = true;
+            tangents = false;
+        }
+        else
+        {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2)
+    {
+        std::fprintf(stderr, "Usage: %s [--compact] [--no-tangents] [--lods <count>] <input.obj> <output.mesh>\n", argv[0]);
+        return 1;
+    }
+    const std::string &input = paths[0];
+    const std::string &output = paths[1];
+
+    ObjData obj;
+    if (!parseObj(input, obj))
+    {
+        return 1;
+    }
+
+    // Share vertices between faces that use the same attribute indices, and
+    // keep the triangles of every material contiguous
+    std::map<FaceVertex, uint32_t> vertexIndices;
+    std::vector<Vertex> vertices;
+    std::vector<bool> hasNormal;
+    std::vector<uint32_t> indices;
+    std::vector<SubMesh> subMeshes;
+
+    for (size_t material = 0; material < obj.triangles.size(); ++material)
+    {
+        const std::vector<FaceVertex> &triangles = obj.triangles[material];
+        if (triangles.empty())
+        {
+            continue;
+        }
+
+        SubMesh subMesh;
+        subMesh.indexOffset = static_cast<uint32_t>(indices.size());
+        subMesh.indexCount = static_cast<uint32_t>(triangles.size());
+        subMesh.materialIndex = static_cast<uint32_t>(material);
+        subMeshes.push_back(subMesh);
+
+        for (const FaceVertex &faceVertex : triangles)
+        {
+            auto it = vertexIndices.find(faceVertex);
+            if (it == vertexIndices.end())
+            {
+                Vertex vertex;
+                vertex.position = obj.positions[std::get<0>(faceVertex)];
+                if (std::get<1>(faceVertex) >= 0)
+                {
+                    vertex.texCoord = obj.texCoords[std::get<1>(faceVertex)];
+                }
+                if (std::get<2>(faceVertex) >= 0)
+                {
+                    vertex.normal = normalize(obj.normals[std::get<2>(faceVertex)], Vector3(0.0f, 1.0f, 0.0f));
+                }
+
+                it = vertexIndices.emplace(faceVertex, static_cast<uint32_t>(vertices.size())).first;
+                vertices.push_back(vertex);
+                hasNormal.push_back(std::get<2>(faceVertex) >= 0);
+            }
+            indices.push_back(it->second);
+        }
+    }
+
+    if (vertices.empty())
+    {
+        Logger::error("No faces in " + input);
+        return 1;
+    }
+
+    computeTangentFrames(vertices, indices, hasNormal);
+
+    // The coarser levels are appended to the indices and share the vertices
+    size_t fullTriangles = indices.size() / 3;
+    std::vector<MeshLod> lods = MeshSimplifier::generateLods(vertices, indices, static_cast<uint32_t>(lodLevels));
+    for (size_t i = 1; i < lods.size(); ++i)
+    {
+        Logger::info("Level " + std::to_string(i) + ": " + std::to_string(lods[i].indexCount / 3) +
+                     " triangles, used below " + std::to_string(lods[i - 1].screenSize) + " of the screen height");
+    }
+    if (lodLevels > 1 && lods.empty())
+    {
+        Logger::warning("Could not simplify " + input + ", cooking a single level");
+    }
+
+    VertexLayout layout = compact ? VertexLayout::compact(tangents) : VertexLayout::standard();
+    if (!MeshCooker::cook(output, vertices, indices, subMeshes, layout, lods))
+    {
+        return 1;
+    }
+
+    Logger::info("Cooked " + std::to_string(vertices.size()) + " vertices, " + std::to_string(fullTriangles) +
+                 " triangles, " + std::to_string(subMeshes.size()) + " sub-meshes into " + output + " (" +
+                 std::to_string(layout.getStride()) + " bytes per vertex)");
+    return 0;
+}